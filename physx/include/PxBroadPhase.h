@@ -70,6 +70,12 @@ namespace physx
 	performance bottleneck if there are a very large number of shapes roughly projecting to the same values
 	on a given axis. If the scene has a very large number of shapes in an actor, e.g. a humanoid, it is recommended
 	to use an aggregate to represent multi-shape or multi-body actors to minimize stress placed on the broad phase.
+
+	eHGRID is a hierarchical hashed grid. Objects are stored in the grid level matching their size, and cells are
+	hashed from double-precision coordinates, so it does not need world bounds or regions to be defined and
+	objects can be spread over very large worlds. Inserting, removing and updating objects are constant-time
+	operations, and pairs are found in parallel when lots of objects move. It is an alternative to eMBP for very
+	large and sparse worlds, but eABP and ePABP usually remain faster for dense scenes.
 	*/
 	struct PxBroadPhaseType
 	{
@@ -80,6 +86,7 @@ namespace physx
 			eABP,	//!< Automatic box pruning
 			ePABP,	//!< Parallel automatic box pruning
 			eGPU,	//!< GPU broad phase
+			eHGRID,	//!< Hierarchical hashed grid
 			eLAST
 		};
 	};
@@ -0,0 +1,211 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef PX_DIRECT_CPU_API_H
+#define PX_DIRECT_CPU_API_H
+
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxRigidDynamic;
+class PxArticulationReducedCoordinate;
+
+/**
+\brief This flag specifies the type of data to get when calling PxDirectCPUAPI::getRigidDynamicData().
+*/
+class PxRigidDynamicCPUAPIReadType
+{
+public:
+	enum Enum
+	{
+		eGLOBAL_POSE = 0,	//!< Get the global poses. Type: 1 PxTransform per PxRigidDynamic.
+		eLINEAR_VELOCITY,	//!< Get the linear velocities. Type: 1 PxVec3 per PxRigidDynamic.
+		eANGULAR_VELOCITY	//!< Get the angular velocities. Type: 1 PxVec3 per PxRigidDynamic.
+	};
+};
+
+/**
+\brief This flag specifies the type of data to set when calling PxDirectCPUAPI::setRigidDynamicData().
+*/
+class PxRigidDynamicCPUAPIWriteType
+{
+public:
+	enum Enum
+	{
+		eGLOBAL_POSE = 0,	//!< Set the global poses. Type: 1 PxTransform per PxRigidDynamic.
+		eLINEAR_VELOCITY,	//!< Set the linear velocities. Type: 1 PxVec3 per PxRigidDynamic.
+		eANGULAR_VELOCITY,	//!< Set the angular velocities. Type: 1 PxVec3 per PxRigidDynamic.
+		eFORCE,				//!< Set the forces. Will be applied at the center of gravity of the bodies. Type: 1 PxVec3 per PxRigidDynamic.
+		eTORQUE				//!< Set the torques. Will be applied at the center of gravity of the bodies. Type: 1 PxVec3 per PxRigidDynamic.
+	};
+};
+
+/**
+\brief This flag specifies the type of data to get when calling PxDirectCPUAPI::getArticulationData().
+*/
+class PxArticulationCPUAPIReadType
+{
+public:
+	enum Enum
+	{
+		eJOINT_POSITION = 0,	//!< The joint positions. 1 PxReal per dof.
+		eJOINT_VELOCITY,		//!< The joint velocities. 1 PxReal per dof.
+		eJOINT_ACCELERATION,	//!< The joint accelerations. 1 PxReal per dof.
+		eJOINT_FORCE,			//!< The joint forces or torques applied by the user. 1 PxReal per dof. Not updated by the simulation.
+		eJOINT_TARGET_POSITION,	//!< The position targets of the joint drives. 1 PxReal per dof. Not updated by the simulation.
+		eJOINT_TARGET_VELOCITY	//!< The velocity targets of the joint drives. 1 PxReal per dof. Not updated by the simulation.
+	};
+};
+
+/**
+\brief This flag specifies the type of data to set when calling PxDirectCPUAPI::setArticulationData().
+*/
+class PxArticulationCPUAPIWriteType
+{
+public:
+	enum Enum
+	{
+		eJOINT_POSITION = 0,	//!< The joint positions. 1 PxReal per dof.
+		eJOINT_VELOCITY,		//!< The joint velocities. 1 PxReal per dof.
+		eJOINT_FORCE,			//!< The applied joint forces or torques. 1 PxReal per dof.
+		eJOINT_TARGET_POSITION,	//!< The position targets for the joint drives. 1 PxReal per dof.
+		eJOINT_TARGET_VELOCITY	//!< The velocity targets for the joint drives. 1 PxReal per dof.
+	};
+};
+
+/**
+\brief PxDirectCPUAPI exposes bulk read and write access to the simulation state of CPU scenes.
+
+This is the CPU counterpart of #PxDirectGPUAPI. Instead of going through one API call per actor, the state of a list of
+actors is copied directly between the SDK and a user-provided, optionally strided, buffer. Element x of the data buffer
+corresponds to the object at position x in the object list.
+
+Read operations are split into batches that run in parallel on the scene's CPU dispatcher, with the calling thread
+participating. Write operations touch structures shared across the scene (scene-query pruners, island manager, wake
+lists) and are executed on the calling thread, but they validate the scene state once per call instead of once per object.
+
+\note These functions must not be called from a task running on the scene's CPU dispatcher, since the calling thread
+blocks until all the batches have been processed.
+
+\note Calls are serialized internally: concurrent calls from multiple threads are safe but will not overlap.
+
+\note It is illegal to use this API on a scene that has PxSceneFlag::eENABLE_DIRECT_GPU_API enabled. Use #PxDirectGPUAPI instead.
+
+\see PxScene::getDirectCPUAPI(), PxDirectGPUAPI
+*/
+class PxDirectCPUAPI
+{
+protected:
+				PxDirectCPUAPI()	{}
+	virtual		~PxDirectCPUAPI()	{}
+
+public:
+
+	/**
+	\brief Copies the simulation state for a set of PxRigidDynamic actors into a user-provided buffer.
+
+	\param[out] data User-provided buffer. The data for the actor at position x in the actors array is written at address data + x * stride.
+	\param[in] stride Distance in bytes between two consecutive elements in the data buffer. Must be a multiple of 4. Zero means tightly packed, i.e. the size of the type. For the types, see PxRigidDynamicCPUAPIReadType.
+	\param[in] actors The PxRigidDynamic actors that are part of this get operation. All of them must be in this scene.
+	\param[in] dataType The type of data to get. See #PxRigidDynamicCPUAPIReadType.
+	\param[in] nbElements The number of actors to copy data from.
+
+	\return Whether the operation was successful.
+
+	\note Not allowed while the simulation is running, except during PxScene::collide().
+	*/
+	virtual bool getRigidDynamicData(void* data, PxU32 stride, PxRigidDynamic* const* actors, PxRigidDynamicCPUAPIReadType::Enum dataType, PxU32 nbElements) const = 0;
+
+	/**
+	\brief Sets the simulation state for a set of PxRigidDynamic actors from a user-provided buffer.
+
+	This has the same effect as calling #PxRigidDynamic::setGlobalPose(), #PxRigidDynamic::setLinearVelocity(), #PxRigidDynamic::setAngularVelocity()
+	or #PxRigidDynamic::setForceAndTorque() for each actor. Forces and torques replace the ones accumulated so far, like in #PxDirectGPUAPI.
+
+	\param[in] data User-provided buffer. The data for the actor at position x in the actors array is read at address data + x * stride.
+	\param[in] stride Distance in bytes between two consecutive elements in the data buffer. Must be a multiple of 4. Zero means tightly packed, i.e. the size of the type. For the types, see PxRigidDynamicCPUAPIWriteType.
+	\param[in] actors The PxRigidDynamic actors that are part of this set operation. All of them must be in this scene.
+	\param[in] dataType The type of data to set. See #PxRigidDynamicCPUAPIWriteType.
+	\param[in] nbElements The number of actors to set data for.
+	\param[in] autowake Whether to wake up the actors, with the same rules as the corresponding per-actor functions.
+
+	\return Whether the operation was successful.
+
+	\note Velocities, forces and torques must not be set on kinematic actors or actors with PxActorFlag::eDISABLE_SIMULATION.
+
+	\note Not allowed while the simulation is running.
+	*/
+	virtual bool setRigidDynamicData(const void* data, PxU32 stride, PxRigidDynamic* const* actors, PxRigidDynamicCPUAPIWriteType::Enum dataType, PxU32 nbElements, bool autowake = true) = 0;
+
+	/**
+	\brief Copies the joint state for a set of articulations into a user-provided buffer.
+
+	Each articulation is given a block of PxReals in the data buffer, indexed by dof in the same way as PxArticulationCache.
+	Only the first PxArticulationReducedCoordinate::getDofs() entries of each block are written.
+
+	\param[out] data User-provided buffer. The block for the articulation at position x in the articulations array starts at address data + x * stride.
+	\param[in] stride Distance in bytes between two consecutive blocks in the data buffer. Must be a multiple of 4. Zero means sizeof(PxReal) times the largest dof count in the articulations array.
+	\param[in] articulations The articulations that are part of this get operation. All of them must be in this scene.
+	\param[in] dataType The type of data to get. See #PxArticulationCPUAPIReadType.
+	\param[in] nbElements The number of articulations to copy data from.
+
+	\return Whether the operation was successful.
+
+	\note Not allowed while the simulation is running, except during PxScene::collide().
+	*/
+	virtual bool getArticulationData(void* data, PxU32 stride, PxArticulationReducedCoordinate* const* articulations, PxArticulationCPUAPIReadType::Enum dataType, PxU32 nbElements) const = 0;
+
+	/**
+	\brief Sets the joint state for a set of articulations from a user-provided buffer.
+
+	This has the same effect as calling #PxArticulationReducedCoordinate::applyCache() for each articulation.
+
+	\param[in] data User-provided buffer. The block for the articulation at position x in the articulations array starts at address data + x * stride.
+	\param[in] stride Distance in bytes between two consecutive blocks in the data buffer. Must be a multiple of 4. Zero means sizeof(PxReal) times the largest dof count in the articulations array.
+	\param[in] articulations The articulations that are part of this set operation. All of them must be in this scene.
+	\param[in] dataType The type of data to set. See #PxArticulationCPUAPIWriteType.
+	\param[in] nbElements The number of articulations to set data for.
+	\param[in] autowake Whether to wake up the articulations, with the same rules as PxArticulationReducedCoordinate::applyCache().
+
+	\return Whether the operation was successful.
+
+	\note Not allowed while the simulation is running.
+	*/
+	virtual bool setArticulationData(const void* data, PxU32 stride, PxArticulationReducedCoordinate* const* articulations, PxArticulationCPUAPIWriteType::Enum dataType, PxU32 nbElements, bool autowake = true) = 0;
+};
+
+#if !PX_DOXYGEN
+}
+#endif
+
+#endif
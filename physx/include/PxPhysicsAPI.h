@@ -173,6 +173,7 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "PxPBDMaterial.h"
 #include "PxPhysics.h"
 #include "PxPhysXConfig.h"
+#include "PxPipelineStatistics.h"
 #include "PxQueryFiltering.h"
 #include "PxQueryReport.h"
 #include "PxRigidActor.h"
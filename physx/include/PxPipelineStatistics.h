@@ -0,0 +1,130 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_PIPELINE_STATISTICS_H
+#define PX_PIPELINE_STATISTICS_H
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Timings gathered for one stage of the scene simulation pipeline.
+
+A stage is one of the named tasks the scene runs for each simulation step (for example "ScScene.islandGen" or
+"ScScene.rigidBodySolver"). The work spawned by a stage in other tasks (e.g. the per-island solver tasks) is
+not included in the stage's own times, it shows up in the queue/dependency figures of the stage it feeds.
+
+All times are in seconds and summed over all executions of the stage during the step.
+
+\see PxPipelineStatistics
+*/
+struct PxPipelineStageStatistics
+{
+	const char*	name;			//!< Name of the stage task.
+	PxReal		wallTime;		//!< Elapsed time spent running the stage.
+	PxReal		cpuTime;		//!< CPU time consumed by the thread(s) running the stage. Lower than wallTime when workers were preempted.
+	PxReal		queueTime;		//!< Time between the stage becoming ready and a worker thread starting it.
+	PxU32		nbExecutions;	//!< Number of times the stage ran.
+	PxU32		nbDependencies;	//!< Number of tasks whose completion the stage waited for, i.e. the number of references removed from it.
+	bool		critical;		//!< True if the stage is on the critical path of the step.
+
+	PxPipelineStageStatistics() :
+		name			(NULL),
+		wallTime		(0.0f),
+		cpuTime			(0.0f),
+		queueTime		(0.0f),
+		nbExecutions	(0),
+		nbDependencies	(0),
+		critical		(false)
+	{
+	}
+};
+
+/**
+\brief Per-stage timings of the last simulation step, see PxScene::getPipelineStatistics().
+
+Only gathered when PxSceneFlag::eENABLE_PIPELINE_STATISTICS or PxSceneFlag::eENABLE_CRITICAL_PATH_SCHEDULING is raised.
+
+The critical path is the longest chain of dependent work from the simulate() (or collide()) call to the end of the
+simulation tasks, excluding the time tasks on that chain spent queued waiting for a free worker thread. It is
+the lower bound on the step's latency with an unlimited number of worker threads. When totalTime is much larger
+than criticalPathTime the step is throughput bound and more worker threads help; when they are close the step
+is latency bound.
+
+\see PxScene::getPipelineStatistics() PxSceneFlag::eENABLE_PIPELINE_STATISTICS PxPipelineStageStatistics
+*/
+class PxPipelineStatistics
+{
+public:
+	/**
+	\brief Stages that ran or were waited on during the step, in order of first registration.
+
+	The array is owned by the scene and stays valid until the next call to simulate() or collide().
+	*/
+	const PxPipelineStageStatistics*	stages;
+
+	/**
+	\brief Number of entries in the stages array.
+	*/
+	PxU32								nbStages;
+
+	/**
+	\brief Elapsed time in seconds from the simulate() (or collide()) call to the end of the simulation tasks.
+	*/
+	PxReal								simulationTime;
+
+	/**
+	\brief Elapsed time in seconds from the simulate() (or collide()) call to the end of fetchResults().
+	*/
+	PxReal								totalTime;
+
+	/**
+	\brief Length in seconds of the critical path of the simulation tasks.
+	*/
+	PxReal								criticalPathTime;
+
+	PxPipelineStatistics() :
+		stages				(NULL),
+		nbStages			(0),
+		simulationTime		(0.0f),
+		totalTime			(0.0f),
+		criticalPathTime	(0.0f)
+	{
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -31,10 +31,13 @@
 
 #include "PxActor.h"
 #include "PxDirectGPUAPI.h"
+#include "PxDirectCPUAPI.h"
+#include "PxSceneSnapshot.h"
 #include "PxSceneQuerySystem.h"
 #include "PxSceneDesc.h"
 #include "PxVisualizationParameter.h"
 #include "PxSimulationStatistics.h"
+#include "PxPipelineStatistics.h"
 #include "PxClient.h"
 #include "task/PxTask.h"
 #include "PxArticulationFlag.h"
@@ -1419,6 +1422,20 @@ class PxScene : public PxSceneSQSystem
 	\see PxSimulationStatistics
 	*/
 	virtual	void				getSimulationStatistics(PxSimulationStatistics& stats) const = 0;
+
+	/**
+	\brief Call this method to retrieve the per-stage pipeline timings of the last simulation step.
+
+	The timings are only gathered when PxSceneFlag::eENABLE_PIPELINE_STATISTICS or PxSceneFlag::eENABLE_CRITICAL_PATH_SCHEDULING
+	is raised. Otherwise the returned structure is empty.
+
+	\note Do not use this method while the simulation is running. Calls to this method while the simulation is running will be ignored.
+
+	\param[out] stats Used to retrieve the pipeline timings of the last simulation step.
+
+	\see PxPipelineStatistics PxSceneFlag::eENABLE_PIPELINE_STATISTICS
+	*/
+	virtual	void				getPipelineStatistics(PxPipelineStatistics& stats) const = 0;
 	
 	//\}
 	
@@ -1722,6 +1739,26 @@ class PxScene : public PxSceneSQSystem
 	Each object of PxDirectGPUAPI is directly associated with a PxScene, and there is only one PxDirectGPUAPI object per scene.
 	*/
 	virtual 	PxDirectGPUAPI&	  getDirectGPUAPI() = 0;
+
+	/**
+	\brief Get the direct-CPU API instance for this scene.
+
+	\see PxDirectCPUAPI for the supported bulk read and write operations.
+
+	Each object of PxDirectCPUAPI is directly associated with a PxScene, and there is only one PxDirectCPUAPI object per scene.
+	*/
+	virtual		PxDirectCPUAPI&		getDirectCPUAPI() = 0;
+
+	/**
+	\brief Creates an empty snapshot for this scene.
+
+	Call PxSceneSnapshot::capture() on the returned object to record the state of the scene, and PxSceneSnapshot::restore() to write it back.
+
+	\return The new snapshot, or NULL if snapshots are not supported for this scene.
+
+	\see PxSceneSnapshot
+	*/
+	virtual		PxSceneSnapshot*	createSnapshot() = 0;
 	
 	/**
 	\brief Provides a metric that describes how well the solver converged. The smaller the returned error, the more accurate the solution.
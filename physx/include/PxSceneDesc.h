@@ -370,7 +370,84 @@ struct PxSceneFlag
 		*/
 		eSOLVE_ARTICULATION_CONTACT_LAST = (1 << 20),
 
-		eMUTABLE_FLAGS = eENABLE_ACTIVE_ACTORS|eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS
+		/**
+		\brief Enables gathering of per-stage timings of the simulation pipeline.
+
+		When raised, the scene records the elapsed time, CPU time and queue time of each of its pipeline stages, as well
+		as the critical path of each simulation step. Retrieve them with PxScene::getPipelineStatistics().
+
+		\note The overhead is a few timer reads per stage, i.e. in the order of a hundred timer reads per step.
+
+		\note This flag is mutable and takes effect at the next call to simulate() or collide().
+
+		\see PxScene::getPipelineStatistics() PxPipelineStatistics
+
+		<b>Default</b> false
+		*/
+		eENABLE_PIPELINE_STATISTICS = (1 << 21),
+
+		/**
+		\brief Schedules the simulation pipeline stages found on the critical path of recent steps ahead of other work.
+
+		The scene records the critical path of each step as with eENABLE_PIPELINE_STATISTICS. The pipeline stages that
+		were on it in any of the last few steps (e.g. island generation or the solver) then report themselves as high
+		priority tasks (see PxBaseTask::isHighPriority()), which the CPU dispatcher runs before independent work that
+		became ready earlier (e.g. lost touch processing). This can reduce the latency of a step when there are more
+		worker threads than the critical path can keep busy.
+
+		\note The statistics gathered for the scheduling are available through PxScene::getPipelineStatistics().
+
+		\note The CPU dispatcher must honor PxBaseTask::isHighPriority() for this flag to have an effect. PxDefaultCpuDispatcher does.
+
+		\note This flag is mutable and takes effect at the next call to simulate() or collide().
+
+		\see PxScene::getPipelineStatistics() eENABLE_PIPELINE_STATISTICS
+
+		<b>Default</b> false
+		*/
+		eENABLE_CRITICAL_PATH_SCHEDULING = (1 << 22),
+
+		/**
+		\brief Reuses the contacts of resting pairs in the CPU discrete narrow phase.
+
+		The CPU narrow phase records the poses of both shapes each time it generates contacts for a pair. If in a later
+		frame neither pose has moved by more than a small fraction of PxTolerancesScale::length, the contacts generated
+		last time are reused as they are and the contact generation functions do not run at all. This targets scenes
+		where large numbers of bodies stay awake while barely moving, e.g. stacks of crates kept awake by a neighbor.
+
+		Contacts reused this way can be off by that small tolerance, so the simulation is not identical to the one
+		obtained without this flag. Pairs with contact modification enabled always generate new contacts.
+
+		\note The contacts of the previous frame are kept alive until the next narrow phase, which increases the memory
+		used for contacts (this is also what eENABLE_STABILIZATION does).
+
+		\note This flag has no effect on the GPU narrow phase.
+
+		\note This flag is not mutable, and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+		*/
+		eENABLE_RESTING_CONTACT_CACHE = (1 << 23),
+
+		/**
+		\brief Disables the AVX2 / AVX-512 batches of the CPU PGS solver.
+
+		By default, when the CPU supports AVX2 or AVX-512F, the PGS solver groups 2 or 4 batches of 4 contact or joint
+		constraints of the same partition into batches of 8 or 16 constraints, solved with 256- or 512-bit registers. The
+		grouped batches run exactly the same operations as the 4-wide batches, so the simulation is the same with or
+		without this flag. It can be used to compare performance, or to avoid the lower clock frequency of AVX-512 code
+		on some CPUs.
+
+		\note Wide batches are not used with PxSolverType::eTGS, with eENABLE_SOLVER_RESIDUAL_REPORTING, with
+		eENABLE_ENHANCED_DETERMINISM, or for constraints involving kinematic bodies.
+
+		\note This flag is not mutable, and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+		*/
+		eDISABLE_WIDE_SOLVER_BATCHES = (1 << 24),
+
+		eMUTABLE_FLAGS = eENABLE_ACTIVE_ACTORS|eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS|eENABLE_PIPELINE_STATISTICS|eENABLE_CRITICAL_PATH_SCHEDULING
 	};
 };
 
@@ -183,6 +183,49 @@ namespace physx
 								const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
 								const PxQueryCache* cache = NULL, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
 
+		/**
+		\brief Performs a set of raycasts against objects in the scene, returns results in one PxRaycastBuffer object per ray.
+
+		Results are the same as calling #raycast() for each ray with the same hit flags and filtering parameters. The built-in
+		scene query system processes the rays in small packets sharing a single traversal of the pruning structures, which makes
+		this function faster than individual raycasts for coherent rays (e.g. sensor fans, lidar sweeps, visibility grids). Rays
+		that diverge within the structures automatically fall back to single-ray traversals. Each ray of a packet still visits
+		the objects in the order it would with #raycast(), so PxQueryFlag::eANY_HIT results, hits at equal distances and the
+		touching hits kept when a touch buffer overflows are the same as well. Triangle meshes and other shapes are raycast
+		one ray at a time.
+
+		The default implementation simply calls #raycast() for each ray.
+
+		\note	Query caches are not supported by this function.
+
+		\param[in] nbRays		Number of rays.
+		\param[in] origins		Origins of the rays.
+		\param[in] unitDirs		Normalized directions of the rays.
+		\param[in] distances	Lengths of the rays. Each has to be in the (0, inf) range.
+		\param[out] hitBuffers	Raycast hit buffers, one per ray, used to report raycast hits.
+		\param[in] hitFlags		Specifies which properties per hit should be computed and returned via the hit buffers.
+		\param[in] filterData	Filtering data passed to the filter shader.
+		\param[in] filterCall	Custom filtering logic (optional). Only used if the corresponding #PxQueryFlag flags are set. If NULL, all hits are assumed to be blocking.
+		\param[in] queryFlags	Optional flags controlling the query.
+
+		\return Number of rays for which any touching or blocking hits were found.
+
+		\see raycast PxRaycastBuffer PxQueryFilterData PxQueryFilterCallback PxRaycastHit PxQueryFlag PxGeometryQueryFlag
+		*/
+		virtual PxU32	raycastPacket(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+										PxRaycastBuffer* hitBuffers, PxHitFlags hitFlags = PxHitFlag::eDEFAULT,
+										const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
+										PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const
+		{
+			PxU32 nbHitRays = 0;
+			for(PxU32 i=0; i<nbRays; i++)
+			{
+				if(raycast(origins[i], unitDirs[i], distances[i], hitBuffers[i], hitFlags, filterData, filterCall, NULL, queryFlags))
+					nbHitRays++;
+			}
+			return nbHitRays;
+		}
+
 		/**
 		\brief Performs a sweep test against objects in the scene, returns results in a PxSweepBuffer object
 		or via a custom user callback implementation inheriting from PxSweepCallback.
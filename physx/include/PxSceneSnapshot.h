@@ -0,0 +1,148 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef PX_SCENE_SNAPSHOT_H
+#define PX_SCENE_SNAPSHOT_H
+
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Snapshot of the dynamic state of a scene, used to roll a scene back to an earlier state.
+
+A snapshot records, for each PxRigidDynamic of the scene, the body pose, the velocities, the wake counter, the sleep state and
+the internal sleep and freeze filters. For each PxArticulationReducedCoordinate, it records the root link pose and velocities,
+the joint positions and velocities, the wake counter and the sleep state. Restoring a snapshot writes this state back to the scene.
+
+A snapshot is either a full snapshot, or a delta snapshot captured against a full base snapshot. A delta snapshot only stores the
+objects whose state differs bitwise from the base, which makes it much smaller than a full snapshot when most of the scene is
+sleeping or at rest.
+
+A snapshot only covers the objects that were in the scene when it was captured. Restoring a snapshot or capturing a delta fails
+if rigid dynamics, articulations or aggregates have been added to or removed from the scene since the full snapshot was captured.
+
+Contact caches (persistent contact manifolds and friction anchors), the island graph and the broad-phase pairs are not stored.
+They are rebuilt from the restored state during the next simulation steps. See #restore() for the determinism guarantees.
+
+\note Snapshots are not supported for scenes with PxSceneFlag::eENABLE_GPU_DYNAMICS or PxSceneFlag::eENABLE_DIRECT_GPU_API.
+
+\see PxScene::createSnapshot()
+*/
+class PxSceneSnapshot
+{
+protected:
+				PxSceneSnapshot()	{}
+	virtual		~PxSceneSnapshot()	{}
+
+public:
+
+	/**
+	\brief Captures the current state of the scene.
+
+	The previous content of the snapshot is discarded, and its memory is reused when possible.
+
+	\param[in] base Base snapshot for a delta capture, or NULL for a full capture. The base must be a full snapshot of the same scene.
+	It must not be released or captured again while this snapshot is in use.
+
+	\return Whether the operation was successful.
+
+	\note Not allowed while the simulation is running.
+	*/
+	virtual		bool					capture(const PxSceneSnapshot* base = NULL) = 0;
+
+	/**
+	\brief Restores the state recorded in the snapshot.
+
+	For a delta snapshot, the objects that are not stored in the delta are restored from the base snapshot.
+
+	When reproducible is false, only the objects whose current state differs bitwise from the recorded one are written back. Objects
+	that did not move keep their contact caches, but the simulation after the restore also depends on the state the scene was in
+	before the restore.
+
+	When reproducible is true, all the recorded objects are removed from the scene and added back before their state is written.
+	Aggregates are removed and added back as a whole. This discards the contact caches, the broad-phase pairs and the island graph
+	edges of the recorded objects, which otherwise depend on the history of the scene. The simulation after the restore then only
+	depends on the content of the snapshot: restoring the same snapshot and running the same simulation steps gives bit-identical
+	results when PxSceneFlag::eENABLE_ENHANCED_DETERMINISM is set. This is much more expensive than the default restore.
+	No lost touch events are reported for the discarded contact and trigger pairs. The pairs that are still touching are found again during
+	the next simulation step, and touch found events are reported for them.
+
+	\param[in] reproducible Whether to reinsert the recorded objects into the scene. See above.
+
+	\return Whether the operation was successful.
+
+	\note Not allowed while the simulation is running.
+	*/
+	virtual		bool					restore(bool reproducible = false) = 0;
+
+	/**
+	\brief Returns the base snapshot of a delta snapshot, or NULL for a full snapshot.
+	*/
+	virtual		const PxSceneSnapshot*	getBase()						const	= 0;
+
+	/**
+	\brief Returns the number of rigid dynamics covered by the snapshot.
+	*/
+	virtual		PxU32					getNbRigidDynamics()			const	= 0;
+
+	/**
+	\brief Returns the number of rigid dynamics whose state is stored in the snapshot. This is the number of changed bodies for a delta snapshot.
+	*/
+	virtual		PxU32					getNbStoredRigidDynamics()		const	= 0;
+
+	/**
+	\brief Returns the number of articulations covered by the snapshot.
+	*/
+	virtual		PxU32					getNbArticulations()			const	= 0;
+
+	/**
+	\brief Returns the number of articulations whose state is stored in the snapshot. This is the number of changed articulations for a delta snapshot.
+	*/
+	virtual		PxU32					getNbStoredArticulations()		const	= 0;
+
+	/**
+	\brief Returns the memory used by the snapshot, in bytes.
+	*/
+	virtual		PxU32					getMemoryUsage()				const	= 0;
+
+	/**
+	\brief Releases the snapshot. Snapshots must be released before their scene.
+	*/
+	virtual		void					release()	= 0;
+};
+
+#if !PX_DOXYGEN
+}
+#endif
+
+#endif
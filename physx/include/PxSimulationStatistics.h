@@ -306,6 +306,22 @@ public:
 	*/
 	PxU32	nbPartitions;
 
+	/**
+	\brief Number of CCD sweep tests (TOI estimates and exact TOI sweeps) performed this frame, over all CCD passes
+	\see PxSceneDesc.ccdMaxPasses
+	*/
+	PxU32	nbCCDSweeps;
+
+	/**
+	\brief Number of times of impact (TOI) resolved by CCD this frame, over all CCD passes
+	*/
+	PxU32	nbCCDToiHits;
+
+	/**
+	\brief Number of CCD passes performed this frame (<= PxSceneDesc.ccdMaxPasses)
+	*/
+	PxU32	nbCCDPasses;
+
 	/**
 	\brief GPU device memory in bytes allocated for particle state accessible through API
 	*/
@@ -436,6 +452,9 @@ public:
 		nbNewTouches							(0),
 		nbLostTouches							(0),
 		nbPartitions							(0),
+		nbCCDSweeps								(0),
+		nbCCDToiHits							(0),
+		nbCCDPasses								(0),
 		gpuMemParticles							(0),
 		gpuMemDeformableSurfaces				(0),
 		gpuMemDeformableVolumes					(0),
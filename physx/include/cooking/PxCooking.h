@@ -50,6 +50,7 @@ class PxInsertionCallback;
 class PxFoundation;
 class PxAllocatorCallback;
 class PxHeightFieldDesc;
+class PxCpuDispatcher;
 
 /**
 \brief Result from convex cooking.
@@ -357,6 +358,24 @@ struct PxCookingParams
 	*/
 	PxReal maxWeightRatioInTet;
 
+	/**
+	\brief Optional CPU dispatcher used to multi-thread triangle mesh and batched convex mesh cooking.
+
+	When set, PxCookTriangleMesh() and PxCreateTriangleMesh() split the mesh cleaning, the edge and adjacency computations,
+	and the BVH34 / BV32 tree builds into tasks submitted to this dispatcher. PxCookConvexMeshes() and PxCreateConvexMeshes()
+	cook the hulls of the batch concurrently on this dispatcher. The cooking call still
+	blocks until the mesh is cooked, and the calling thread takes part in the work, so it is safe to cook from a task
+	running on the same dispatcher. The cooked data is bit-identical to the data cooked without a dispatcher, whatever
+	the number of worker threads.
+
+	Small meshes are cooked on the calling thread, as splitting the work would not pay off.
+
+	<b>Default value:</b> NULL
+
+	\see PxCpuDispatcher
+	*/
+	PxCpuDispatcher* cpuDispatcher;
+
 	PxCookingParams(const PxTolerancesScale& sc):
 		areaTestEpsilon					(0.06f*sc.length*sc.length),
 		planeTolerance					(0.0007f),
@@ -370,7 +389,8 @@ struct PxCookingParams
 		meshAreaMinLimit				(0.0f),
 		meshEdgeLengthMaxLimit			(500.0f),
 		gaussMapLimit					(32),
-		maxWeightRatioInTet             (FLT_MAX)
+		maxWeightRatioInTet             (FLT_MAX),
+		cpuDispatcher					(NULL)
 	{
 	}
 };
@@ -545,6 +565,45 @@ PX_FORCE_INLINE	physx::PxConvexMesh* PxCreateConvexMesh(const physx::PxCookingPa
 	return PxCreateConvexMesh(params, desc, *PxGetStandaloneInsertionCallback());
 }
 
+/**
+\brief Cooks a batch of convex meshes. The results are written to the streams.
+
+This method does the same as calling PxCookConvexMesh() for each descriptor, but the meshes are cooked concurrently
+on PxCookingParams::cpuDispatcher when it is set, and the temporary memory needed by the hull computation is reused from
+one mesh to the next. This is meant for large sets of convexes such as the pieces of a fractured object.
+The cooked data is the same as the one produced by PxCookConvexMesh().
+
+\note The output streams must be distinct objects, as they can be written to from different threads.
+
+\param[in] params		The cooking parameters
+\param[in] nbMeshes		Number of meshes to cook.
+\param[in] descs		The convex mesh descriptors, nbMeshes entries.
+\param[in] streams		User streams to output the cooked data, nbMeshes entries.
+\param[out] conditions	Results from convex mesh cooking, nbMeshes entries. Can be NULL.
+\return true if all the meshes have been cooked successfully.
+
+\see PxCookConvexMesh() PxCookingParams::cpuDispatcher
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookConvexMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxConvexMeshDesc* descs, physx::PxOutputStream* const* streams, physx::PxConvexMeshCookingResult::Enum* conditions=NULL);
+
+/**
+\brief Cooks and creates a batch of convex meshes without going through streams.
+
+This method does the same as calling PxCreateConvexMesh() for each descriptor, but the meshes are cooked concurrently
+on PxCookingParams::cpuDispatcher when it is set. Meshes that failed to cook are set to NULL in the output array.
+
+\param[in] params				The cooking parameters
+\param[in] nbMeshes				Number of meshes to create.
+\param[in] descs				The convex mesh descriptors, nbMeshes entries.
+\param[in] insertionCallback	The insertion interface from PxPhysics.
+\param[out] meshes				The created meshes, nbMeshes entries.
+\param[out] conditions			Results from convex mesh cooking, nbMeshes entries. Can be NULL.
+\return true if all the meshes have been created successfully.
+
+\see PxCreateConvexMesh() PxCookConvexMeshes() PxCookingParams::cpuDispatcher
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCreateConvexMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxConvexMeshDesc* descs, physx::PxInsertionCallback& insertionCallback, physx::PxConvexMesh** meshes, physx::PxConvexMeshCookingResult::Enum* conditions=NULL);
+
 /**
 \brief Verifies if the convex mesh is valid. Prints an error message for each inconsistency found.
 
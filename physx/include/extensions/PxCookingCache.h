@@ -0,0 +1,191 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_COOKING_CACHE_H
+#define PX_COOKING_CACHE_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "cooking/PxCooking.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxPhysics;
+class PxConvexMesh;
+class PxTriangleMesh;
+
+/**
+\brief Statistics gathered by a PxCookingCache.
+
+\see PxCookingCache::getStats()
+*/
+struct PxCookingCacheStats
+{
+	PxU64	nbHits;			//!< Number of requests served from the cache, without cooking
+	PxU64	nbMisses;		//!< Number of requests that had to cook the mesh
+	PxU64	nbUncached;		//!< Number of requests that cannot be cached (e.g. meshes with an SDF) and were cooked directly
+	PxU64	nbStores;		//!< Number of cooked meshes written to the cache
+	PxU64	nbEvictions;	//!< Number of entries removed from the cache to stay within its size budget
+	PxU64	nbErrors;		//!< Number of failed reads or writes of cache entries, e.g. corrupted or truncated files
+	PxU32	nbEntries;		//!< Number of entries currently known to the cache
+	PxU64	sizeInBytes;	//!< Total size of the entries currently known to the cache
+};
+
+/**
+\brief Persistent cache for cooked convex and triangle meshes.
+
+Cooked meshes are stored on disk, one file per entry, keyed by a 128-bit hash of the mesh descriptor contents and of
+the cooking parameters that affect the cooked data. Cooking the same mesh with the same parameters again, in the same
+process or in a later one, then reads the cooked data back instead of cooking it.
+
+The key also includes the SDK version and the platform, so that a new SDK version never reads data cooked by a previous
+one. Stale entries are not read anymore and are eventually evicted: the cache keeps its total size under a budget by
+removing the least recently used entries.
+
+All functions are thread-safe. Lookups only lock the cache index for a short time, and cooking as well as file reads and
+writes happen outside of the lock, so several threads can cook and read entries concurrently. Several processes can share
+the same directory: entries written by one process are picked up by the others on their next lookup. Each flush merges
+the index with the one on disk under a file lock, so the entries of all the processes count toward the size budget.
+
+\see PxCreateCookingCache() PxCookConvexMesh() PxCookTriangleMesh()
+*/
+class PxCookingCache
+{
+public:
+	/**
+	\brief Same as PxCookConvexMesh(), but reads the cooked data from the cache when available.
+
+	Convex meshes with an SDF descriptor are not cached and always cooked.
+
+	\param[in] params		The cooking parameters
+	\param[in] desc			The convex mesh descriptor to read the mesh from
+	\param[in] stream		User stream to output the cooked data
+	\param[out] condition	Result from convex mesh cooking
+	\return true on success
+
+	\see PxCookConvexMesh()
+	*/
+	virtual	bool			cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition=NULL) = 0;
+
+	/**
+	\brief Same as cookConvexMesh(), but creates the convex mesh directly from the cooked data.
+
+	\param[in] params		The cooking parameters
+	\param[in] desc			The convex mesh descriptor to read the mesh from
+	\param[in] physics		The physics object used to create the mesh
+	\param[out] condition	Result from convex mesh cooking
+	\return The new convex mesh, or NULL on failure
+
+	\see cookConvexMesh() PxPhysics::createConvexMesh()
+	*/
+	virtual	PxConvexMesh*	createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxPhysics& physics, PxConvexMeshCookingResult::Enum* condition=NULL) = 0;
+
+	/**
+	\brief Same as PxCookTriangleMesh(), but reads the cooked data from the cache when available.
+
+	Triangle meshes with an SDF descriptor are not cached and always cooked. The cooking condition is stored with the entry,
+	so cache hits report the same condition as the original cooking.
+
+	\param[in] params		The cooking parameters
+	\param[in] desc			The triangle mesh descriptor to read the mesh from
+	\param[in] stream		User stream to output the cooked data
+	\param[out] condition	Result from triangle mesh cooking
+	\return true on success
+
+	\see PxCookTriangleMesh()
+	*/
+	virtual	bool			cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition=NULL) = 0;
+
+	/**
+	\brief Same as cookTriangleMesh(), but creates the triangle mesh directly from the cooked data.
+
+	\param[in] params		The cooking parameters
+	\param[in] desc			The triangle mesh descriptor to read the mesh from
+	\param[in] physics		The physics object used to create the mesh
+	\param[out] condition	Result from triangle mesh cooking
+	\return The new triangle mesh, or NULL on failure
+
+	\see cookTriangleMesh() PxPhysics::createTriangleMesh()
+	*/
+	virtual	PxTriangleMesh*	createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxPhysics& physics, PxTriangleMeshCookingResult::Enum* condition=NULL) = 0;
+
+	/**
+	\brief Retrieves the cache statistics.
+
+	\param[out] stats	The statistics gathered since the cache was created or since the last call to resetStats()
+	*/
+	virtual	void			getStats(PxCookingCacheStats& stats) const = 0;
+
+	/**
+	\brief Resets the hit, miss, store, eviction and error counters. The number of entries and their size are not affected.
+	*/
+	virtual	void			resetStats() = 0;
+
+	/**
+	\brief Writes the cache index to disk.
+
+	The index records the size and the last use of each entry, and drives the LRU eviction across sessions. It is also
+	written when the cache is released. Entries added or removed by other processes sharing the directory are merged
+	into the cache first, and the least recently used entries are evicted if the merged entries exceed the budget.
+
+	\return true on success
+	*/
+	virtual	bool			flush() = 0;
+
+	/**
+	\brief Removes all entries known to the cache from disk.
+	*/
+	virtual	void			clear() = 0;
+
+	/**
+	\brief Flushes the index and deletes the cache object. Cooked data stays on disk.
+	*/
+	virtual	void			release() = 0;
+
+protected:
+	virtual					~PxCookingCache()	{}
+};
+
+/**
+\brief Creates a persistent cooking cache.
+
+\param[in] directory		Existing directory where the cache entries and the cache index are stored. The directory is not created.
+\param[in] maxSizeInBytes	Size budget for the cooked data stored in the directory. The least recently used entries are removed when the budget is exceeded.
+\return The new cache, or NULL if the directory path is invalid.
+
+\see PxCookingCache
+*/
+PxCookingCache* PxCreateCookingCache(const char* directory, PxU64 maxSizeInBytes);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
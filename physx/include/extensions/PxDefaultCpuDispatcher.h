@@ -37,6 +37,8 @@ namespace physx
 {
 #endif
 
+struct PxThreadAffinityMask;
+
 /**
 \brief A default implementation for a CPU task dispatcher.
 
@@ -91,6 +93,33 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 };
 
 
+/**
+\brief Selects how the default CPU dispatcher distributes tasks among its worker threads.
+
+\see PxDefaultCpuDispatcherCreate()
+*/
+struct PxDefaultCpuDispatcherSchedulingMode
+{
+	enum Enum
+	{
+		/**
+		\brief Tasks submitted by a worker thread go to a list owned by that worker, all other tasks go to a list shared by all workers.
+		Idle workers scan the lists of all other workers in order.
+		*/
+		eSHARED_QUEUE,
+
+		/**
+		\brief Each worker thread owns a lock-free work-stealing deque. Tasks submitted by a worker are pushed to and popped from
+		the bottom of its own deque, idle workers steal from the top of randomly chosen victims. Tasks submitted from non-worker
+		threads and high priority tasks go to shared lists. In eWAIT_FOR_WORK mode, idle workers are parked and woken up individually
+		rather than through a single shared signal.
+
+		\note Recommended for machines with many cores, where contention on the shared list becomes noticeable.
+		*/
+		eWORK_STEALING
+	};
+};
+
 /**
 \brief Create default dispatcher, extensions SDK needs to be initialized first.
 
@@ -99,6 +128,7 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 \param[in] mode is the strategy employed when a busy-wait is encountered. 
 \param[in] yieldProcessorCount specifies the number of times a OS-specific yield processor command will be executed
 during each cycle of a busy-wait in the event that the specified mode is eYIELD_PROCESSOR
+\param[in] schedulingMode is the strategy used to distribute tasks among worker threads.
 
 \note numThreads may be zero in which case no worker thread are initialized and
 simulation tasks will be executed on the thread that calls PxScene::simulate()
@@ -110,7 +140,35 @@ It is left to users to keep threads inactive, if so desired, when no simulation
 
 \see PxDefaultCpuDispatcher
 */
-PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0);
+PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0,
+	PxDefaultCpuDispatcherSchedulingMode::Enum schedulingMode = PxDefaultCpuDispatcherSchedulingMode::eSHARED_QUEUE);
+
+/**
+\brief Create a default dispatcher whose worker threads are placed according to the CPU topology of the machine.
+
+The dispatcher uses PxDefaultCpuDispatcherSchedulingMode::eWORK_STEALING. Worker threads are grouped by NUMA node and
+by cluster of cores sharing a last-level (L3) cache. Clusters of the first NUMA node are filled first, with one worker per
+physical core, before moving to the next node. Only then are SMT threads used. Each worker is pinned to all logical
+processors of its cluster.
+
+Tasks submitted by a worker stay in the deque of that worker. Idle workers steal tasks from their own cluster first, then
+from their own NUMA node, then from the rest of the machine. A submit wakes a parked worker of the submitter's cluster first.
+
+\param[in] numThreads Number of worker threads the dispatcher should use.
+\param[in] affinityMasks Optional array with one affinity mask per thread. Unlike PxDefaultCpuDispatcherCreate(), these
+masks can address more than 32 logical processors. If defined, each worker is pinned to its mask instead of to its cluster,
+and is considered part of the cluster containing the first processor of the mask.
+\param[in] mode is the strategy employed when a busy-wait is encountered.
+\param[in] yieldProcessorCount specifies the number of times a OS-specific yield processor command will be executed
+during each cycle of a busy-wait in the event that the specified mode is eYIELD_PROCESSOR
+
+\note The topology is currently read from sysfs on Linux. On other platforms, or if it cannot be read, all processors are
+treated as a single unpinned cluster, and the dispatcher behaves like one created with eWORK_STEALING.
+
+\see PxDefaultCpuDispatcherCreate PxThreadAffinityMask
+*/
+PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreateTopologyAware(PxU32 numThreads, const PxThreadAffinityMask* affinityMasks = NULL,
+	PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0);
 
 #if !PX_DOXYGEN
 } // namespace physx
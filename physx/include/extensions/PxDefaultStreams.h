@@ -134,6 +134,54 @@ private:
 		PxU32			mLength;
 };
 
+/** 
+\brief Read-write view of a file mapped into memory
+
+The file is mapped copy-on-write. Pages are only loaded when first accessed and stay shared with other processes
+mapping the same file until they are written to. Modifications are private to the process and are never written
+back to the file.
+
+This allows a collection serialized with PxSerialization::serializeCollectionToBinary to be deserialized in place
+with PxSerialization::createCollectionFromBinary. The buffers of deserialized triangle meshes (including their BV4
+trees), convex meshes and height fields then point directly into the mapping, without being copied. Only the pages
+holding the object headers, which are patched during deserialization, become private to the process.
+
+Cooked meshes are loaded without copies by storing them as a binary serialized collection instead of cooked streams.
+A single file can hold several such collections, for example the tiles of a large terrain, each starting at an offset
+aligned to PX_SERIAL_FILE_ALIGN from getData(). The size of the file is only limited by the address space of the
+process, while each collection is limited to 4GB by the binary format.
+
+The mapping must stay alive as long as objects deserialized from it are in use. isValid() returns false on platforms
+without memory mapped file support.
+
+\see PxSerialization::createCollectionFromBinary
+*/
+
+class PxDefaultMemoryMappedFile
+{
+public:
+						PxDefaultMemoryMappedFile(const char* name);
+						~PxDefaultMemoryMappedFile();
+
+	/**
+	\brief Returns the start of the mapping, aligned to the page size of the platform.
+	*/
+				void*	getData()	const;
+
+	/**
+	\brief Returns the size of the mapped file in bytes.
+	*/
+				PxU64	getSize()	const;
+
+				bool	isValid()	const;
+private:
+						PxDefaultMemoryMappedFile(const PxDefaultMemoryMappedFile&);
+						PxDefaultMemoryMappedFile& operator=(const PxDefaultMemoryMappedFile&);
+
+				void*	mData;
+				PxU64	mSize;
+};
+
 #if !PX_DOXYGEN
 }
 #endif
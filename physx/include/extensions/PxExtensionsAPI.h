@@ -58,6 +58,7 @@
 #include "extensions/PxSceneQuerySystemExt.h"
 #include "extensions/PxCustomSceneQuerySystem.h"
 #include "extensions/PxConvexMeshExt.h"
+#include "extensions/PxCookingCache.h"
 #include "extensions/PxSamplingExt.h"
 #include "extensions/PxTetrahedronMeshExt.h"
 #include "extensions/PxCustomGeometryExt.h"
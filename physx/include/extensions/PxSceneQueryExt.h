@@ -435,8 +435,39 @@ public:
 		const PxQueryFilterData& filterData = PxQueryFilterData(),
 		const PxQueryCache* cache = NULL) = 0;
 		
+	/**
+	\brief Performs all queries issued since the last call to execute(), on the calling thread.
+
+	Raycasts are performed first, then sweeps, then overlaps. The touch buffers are handed out to the queries in that order.
+	*/
 	virtual void execute() = 0;
 
+	/**
+	\brief Performs all queries issued since the last call to execute(), using tasks.
+
+	The queries are split into chunks of at most maxNbQueriesPerTask queries of the same type, each executed by a task
+	submitted to the task manager of the continuation. A short serial task then assigns the ranges of the touch buffers
+	in query order, and the chunk tasks copy their results there. The results are identical to the ones produced by execute().
+
+	Each chunk writes the touches of its queries to a scratch buffer owned by the batch query object, so the execution
+	needs no synchronization between the chunks. The scratch buffers only hold the touches actually found and are kept
+	for subsequent calls. Queries that get less touch capacity than they ran with, because the touch buffer ran out, are
+	run again by the chunk tasks.
+
+	\note The results are only available once the continuation runs. The batch query object must not be used
+	(including release()) before then.
+
+	\note The query filter callback passed to PxCreateBatchQueryExt() is called concurrently from the worker threads
+	and must be thread-safe.
+
+	\param[in] continuation			Task to run once the results are available. It must have a task manager,
+									e.g. be a PxLightCpuTask whose continuation has been set. If NULL, this is the same as execute().
+	\param[in] maxNbQueriesPerTask	Maximum number of queries executed by a single task.
+
+	\see execute() PxLightCpuTask
+	*/
+	virtual void execute(PxBaseTask* continuation, PxU32 maxNbQueriesPerTask = 64) = 0;
+
 protected:
 
 	virtual ~PxBatchQueryExt() {}
@@ -49,6 +49,44 @@ namespace physx
 {
 #endif
 
+/**
+\brief Content hashes of the objects of a collection, used for delta binary serialization.
+
+A manifest stores one content hash per object with a valid PxSerialObjectId. The hash covers the binary
+serialized representation of the object, so the manifest can be used to find the objects which changed since
+the manifest was created or last updated.
+
+\note Content hashes include the addresses of referenced objects. They are only meaningful in the process
+which created the manifest and can not be persisted.
+
+\see PxSerialization::createSerializationManifest, PxSerialization::serializeCollectionDeltaToBinary
+*/
+class PxSerializationManifest
+{
+public:
+	/**
+	\brief Returns the number of objects tracked by the manifest.
+	*/
+	virtual	PxU32	getNbObjects()											const	= 0;
+
+	/**
+	\brief Retrieves the content hash stored for an object id.
+
+	\param[in] id The id of the object
+	\param[out] hash The content hash of the object
+	\return False if the manifest does not track an object with this id
+	*/
+	virtual	bool	getContentHash(PxSerialObjectId id, PxU64& hash)		const	= 0;
+
+	/**
+	\brief Releases the manifest.
+	*/
+	virtual	void	release()														= 0;
+
+protected:
+	virtual			~PxSerializationManifest()	{}
+};
+
 /**
 \brief Utility functions for serialization
 
@@ -178,11 +216,14 @@ public:
 	which is defined by "PX_PHYSICS_VERSION_MAJOR.PX_PHYSICS_VERSION_MINOR.PX_PHYSICS_VERSION_BUGFIX-PX_BINARY_SERIAL_VERSION".
 	For a list of compatible sdk releases refer to the documentation of PX_BINARY_SERIAL_VERSION.
 
+	The deserialized objects reference the memory block instead of copying their data out of it. A file mapped with
+	PxDefaultMemoryMappedFile can be passed directly, which shares the cooked mesh data of the file between processes.
+
 	\param[in] memBlock Pointer to memory block containing the serialized collection
 	\param[in] sr PxSerializationRegistry instance with information about registered classes.
 	\param[in] externalRefs Collection to resolve external dependencies
 
-	\see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION
+	\see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION, PxDefaultMemoryMappedFile
 	*/
 	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
 
@@ -232,6 +273,69 @@ public:
 	*/
 	static	bool			serializeCollectionToBinary(PxOutputStream& outputStream, PxCollection& collection, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL, bool exportNames = false );
 
+	/**
+	\brief Creates a manifest with the content hashes of the objects of a collection.
+
+	Only objects with a valid PxSerialObjectId are tracked. See #PxSerialization::createSerialObjectIds.
+
+	\param[in] collection Collection for which the content hashes are computed
+	\param[in] sr PxSerializationRegistry instance with information about registered classes.
+	\return The new manifest, or NULL if the collection contains objects without a registered serializer.
+
+	\see PxSerializationManifest, PxSerialization::serializeCollectionDeltaToBinary
+	*/
+	static PxSerializationManifest* createSerializationManifest(PxCollection& collection, PxSerializationRegistry& sr);
+
+	/**
+	\brief Serializes the objects of a collection which changed since a manifest was taken to a binary stream.
+
+	An object of the collection is written if its id is not tracked by the manifest, if its content hash differs
+	from the manifest, or if it requires or owns an object which is written. All other objects are referenced by
+	their ids, so the collection's serialized objects need to be resident in the base collection passed to
+	#PxSerialization::createCollectionFromBinaryDelta. Objects without a valid PxSerialObjectId are written
+	with every delta and created again by every apply, so shared resources such as meshes and materials should be
+	given ids, see #PxSerialization::createSerialObjectIds. Ids tracked by the manifest which are no longer part of the collection are recorded as
+	removed.
+
+	The collection needs to be complete, see #PxSerialization::complete.
+
+	\note Serialization of objects in a scene that is simultaneously being simulated is not supported and leads to undefined behavior. 
+
+	\param[out] outputStream into which the delta is serialized
+	\param[in] collection Collection to be serialized
+	\param[in] sr PxSerializationRegistry instance with information about registered classes.
+	\param[in,out] manifest Manifest the delta is computed against
+	\param[in] exportNames Specifies whether object names are serialized
+	\param[in] updateManifest Specifies whether the manifest is updated to the current state of the collection after a successful write
+	\return Whether serialization was successful
+
+	\see PxSerializationManifest, PxSerialization::createCollectionFromBinaryDelta
+	*/
+	static	bool			serializeCollectionDeltaToBinary(PxOutputStream& outputStream, PxCollection& collection, PxSerializationRegistry& sr, PxSerializationManifest& manifest, bool exportNames = false, bool updateManifest = true);
+
+	/**
+	\brief Deserializes a delta written by PxSerialization::serializeCollectionDeltaToBinary and patches it into a base collection.
+
+	Objects the delta does not contain are resolved against the base collection, so shared resources such as
+	meshes and materials are not created again. The deserialized objects with a valid PxSerialObjectId are added to
+	the base collection, objects without id are only part of the returned collection. Objects
+	of the base collection that are superseded by a deserialized object with the same id, or that were removed
+	since the manifest, are removed from the base collection and added to replacedObjects. The application is
+	responsible for removing them from their scenes and releasing them.
+
+	The memory block has the same requirements as the one passed to #PxSerialization::createCollectionFromBinary.
+	Deltas written by a different PhysX version are rejected.
+
+	\param[in] memBlock Pointer to memory block containing the serialized delta
+	\param[in] sr PxSerializationRegistry instance with information about registered classes.
+	\param[in,out] base Collection holding the resident objects the delta was serialized against
+	\param[out] replacedObjects Optional collection receiving the objects removed from the base collection
+	\return Collection of the deserialized objects, or NULL if deserialization failed.
+
+	\see PxSerialization::serializeCollectionDeltaToBinary, PxSerialization::createCollectionFromBinary
+	*/
+	static	PxCollection*	createCollectionFromBinaryDelta(void* memBlock, PxSerializationRegistry& sr, PxCollection& base, PxCollection* replacedObjects = NULL);
+
 	/**
 	\brief Creates an application managed registry for serialization.
 	
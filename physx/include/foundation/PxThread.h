@@ -60,6 +60,95 @@ struct PxThreadPriority
 	};
 };
 
+#define PX_MAX_NB_THREAD_AFFINITY_WORDS	16
+
+/**
+\brief Thread affinity mask that can address more logical processors than the 32-bit masks of PxThreadImpl::setAffinityMask().
+
+Bit i of mWords[w] represents logical processor 64*w + i, for up to 1024 logical processors.
+
+\see PxThreadImpl::setAffinityMask()
+*/
+struct PxThreadAffinityMask
+{
+	PxU64	mWords[PX_MAX_NB_THREAD_AFFINITY_WORDS];
+
+	PX_INLINE PxThreadAffinityMask()
+	{
+		clear();
+	}
+
+	PX_INLINE void clear()
+	{
+		for(PxU32 i=0; i<PX_MAX_NB_THREAD_AFFINITY_WORDS; i++)
+			mWords[i] = 0;
+	}
+
+	PX_INLINE void set(PxU32 index)
+	{
+		if(index < PX_MAX_NB_THREAD_AFFINITY_WORDS*64)
+			mWords[index>>6] |= PxU64(1)<<(index&63);
+	}
+
+	PX_INLINE bool test(PxU32 index) const
+	{
+		return index < PX_MAX_NB_THREAD_AFFINITY_WORDS*64 && (mWords[index>>6] & (PxU64(1)<<(index&63)));
+	}
+
+	PX_INLINE bool isEmpty() const
+	{
+		return getNbWords() == 0;
+	}
+
+	/**
+	\brief Number of words up to and including the last non-zero word.
+	*/
+	PX_INLINE PxU32 getNbWords() const
+	{
+		PxU32 nbWords = PX_MAX_NB_THREAD_AFFINITY_WORDS;
+		while(nbWords && !mWords[nbWords-1])
+			nbWords--;
+		return nbWords;
+	}
+
+	/**
+	\brief Index of the first logical processor in the mask, or 0xffffffff if the mask is empty.
+	*/
+	PX_INLINE PxU32 getFirst() const
+	{
+		for(PxU32 i=0; i<PX_MAX_NB_THREAD_AFFINITY_WORDS; i++)
+		{
+			const PxU64 w = mWords[i];
+			if(w)
+			{
+				PxU32 bit = 0;
+				while(!(w & (PxU64(1)<<bit)))
+					bit++;
+				return i*64 + bit;
+			}
+		}
+		return 0xffffffff;
+	}
+
+	/**
+	\brief Number of logical processors in the mask.
+	*/
+	PX_INLINE PxU32 getCount() const
+	{
+		PxU32 count = 0;
+		for(PxU32 i=0; i<PX_MAX_NB_THREAD_AFFINITY_WORDS; i++)
+		{
+			PxU64 w = mWords[i];
+			while(w)
+			{
+				w &= w - 1;
+				count++;
+			}
+		}
+		return count;
+	}
+};
+
 class PxRunnable
 {
   public:
@@ -159,6 +248,26 @@ class PX_FOUNDATION_API PxThreadImpl
 	*/
 	PxU32 setAffinityMask(PxU32 mask);
 
+	/**
+	Change the affinity mask for this thread, using a mask wide enough for machines
+	with more than 32 logical processors.
+
+	On Linux, each set mask bit represents the index of a logical processor that the
+	OS may schedule thread execution on.
+
+	On Windows, word w of the mask represents the logical processors of processor
+	group w. A thread can only run within a single processor group, so only the first
+	non-zero word is used.
+
+	On Apple platforms, this function has no effect.
+
+	If the thread has not yet been started then the mask is stored
+	and applied when the thread is started.
+
+	Returns true on success.
+	*/
+	bool setAffinityMask(const PxThreadAffinityMask& mask);
+
 	static PxThreadPriority::Enum getPriority(Id threadId);
 
 	/** Set thread priority. */
@@ -296,6 +405,11 @@ class PxThreadT : protected Alloc, public PxUserAllocated, public PxRunnable
 		return mImpl->setAffinityMask(mask);
 	}
 
+	bool setAffinityMask(const PxThreadAffinityMask& mask)
+	{
+		return mImpl->setAffinityMask(mask);
+	}
+
 	static PxThreadPriority::Enum getPriority(PxThreadImpl::Id threadId)
 	{
 		return PxThreadImpl::getPriority(threadId);
@@ -77,6 +77,10 @@ class PX_FOUNDATION_API PxTime
 		return getBootCounterFrequency().toTensOfNanos(ticks);
 	}
 
+	// CPU time consumed so far by the calling thread, i.e. excluding the time it spent
+	// preempted or blocked. Returns 0 on platforms without a per-thread CPU clock.
+	static PxU64 getCurrentThreadCpuTimeInTensOfNanoSeconds();
+
 	PxTime();
 	Second getElapsedSeconds();
 	Second peekElapsedSeconds();
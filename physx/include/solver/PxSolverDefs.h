@@ -100,7 +100,7 @@ PX_COMPILE_TIME_ASSERT(PX_OFFSET_OF(PxSolverBodyData, sqrtInvInertia)+sizeof(PxS
 struct PxConstraintBatchHeader
 {
 	PxU32	startIndex;			//!< Start index for this batch
-	PxU16	stride;				//!< Number of constraints in this batch (range: 1-4)
+	PxU16	stride;				//!< Number of constraints in this batch (range: 1-4, or 8 and 16 for the wide batches used internally by the CPU PGS solver)
 	PxU16	constraintType;		//!< The type of constraint this batch references
 };
 
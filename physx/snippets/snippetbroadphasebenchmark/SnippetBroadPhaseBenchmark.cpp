@@ -0,0 +1,250 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet compares the performance of the eSAP and ePABP broadphases on a
+// large scene (100k objects by default), using the standalone broadphase API.
+// Each frame a fraction of the objects move, and a few objects are removed and
+// re-added, so that all parts of the update (insertion, removal and sorting of
+// moving objects) are measured. Each broadphase is run single-threaded (no
+// continuation task) and then with 1 to N worker threads, and the average time
+// per update is printed along with the number of overlapping pairs, which must
+// be the same for all runs.
+//
+// Usage: SnippetBroadPhaseBenchmark [nbObjects] [maxNbThreads]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+#include "../snippetcommon/SnippetPrint.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+static const PxU32	gNbWarmupFrames		= 10;
+static const PxU32	gNbTimedFrames		= 60;
+static const PxU32	gRemovedPerFrame	= 100;	// objects removed and re-added every other frame
+
+namespace
+{
+	class WaitTask : public PxLightCpuTask
+	{
+	public:
+		WaitTask(SnippetUtils::Sync* syncHandle) : PxLightCpuTask(), mSyncHandle(syncHandle)	{}
+
+		virtual void run()	{}
+
+		PX_INLINE void release()
+		{
+			PxLightCpuTask::release();
+			SnippetUtils::syncSet(mSyncHandle);
+		}
+
+		virtual const char* getName() const { return "WaitTask"; }
+
+	private:
+		SnippetUtils::Sync* mSyncHandle;
+	};
+
+	struct Scene
+	{
+		PxArray<PxVec3>		mCenters;
+		PxArray<PxVec3>		mExtents;
+		PxArray<PxReal>		mPhases;
+		PxU32				mNbMoving;
+	};
+}
+
+static PxReal rand01()
+{
+	return PxReal(rand()) / PxReal(RAND_MAX);
+}
+
+static void createScene(Scene& scene, PxU32 nbObjects, PxReal movingFraction)
+{
+	srand(42);
+	// PT: objects are spread in a flat volume so that the density (and the number of pairs) stays reasonable
+	const PxReal size = PxSqrt(PxReal(nbObjects)) * 2.0f;
+	scene.mCenters.resize(nbObjects);
+	scene.mExtents.resize(nbObjects);
+	scene.mPhases.resize(nbObjects);
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		scene.mCenters[i] = PxVec3(rand01()*size, rand01()*20.0f, rand01()*size);
+		scene.mExtents[i] = PxVec3(0.5f + rand01(), 0.5f + rand01(), 0.5f + rand01());
+		scene.mPhases[i] = rand01() * PxTwoPi;
+	}
+	scene.mNbMoving = PxU32(PxReal(nbObjects) * movingFraction);
+}
+
+static PxBounds3 computeBounds(const Scene& scene, PxU32 i, PxU32 frame)
+{
+	PxVec3 center = scene.mCenters[i];
+	if(i<scene.mNbMoving)
+	{
+		const PxReal t = PxReal(frame) * 0.05f + scene.mPhases[i];
+		center += PxVec3(PxSin(t), PxCos(t*0.7f), PxSin(t*1.3f)) * 2.0f;
+	}
+	return PxBounds3::centerExtents(center, scene.mExtents[i]);
+}
+
+static void updateBroadPhase(PxAABBManager* manager, PxTaskManager* taskManager, SnippetUtils::Sync* sync, PxU32& nbPairs)
+{
+	if(taskManager)
+	{
+		SnippetUtils::syncReset(sync);
+
+		WaitTask waitTask(sync);
+		taskManager->resetDependencies();
+		taskManager->startSimulation();
+		waitTask.setContinuation(*taskManager, NULL);
+
+		manager->update(&waitTask);
+
+		waitTask.removeReference();
+		SnippetUtils::syncWait(sync);
+		taskManager->stopSimulation();
+	}
+	else
+	{
+		manager->update();
+	}
+
+	PxBroadPhaseResults results;
+	manager->fetchResults(results);
+	nbPairs += results.mNbCreatedPairs;
+	nbPairs -= results.mNbDeletedPairs;
+}
+
+// Returns the average time per update, in milliseconds. nbThreads is ignored when multiThreaded is false.
+static PxReal runBenchmark(const Scene& scene, PxBroadPhaseType::Enum type, bool multiThreaded, PxU32 nbThreads, PxU32& nbPairs)
+{
+	PxDefaultCpuDispatcher* dispatcher = NULL;
+	PxTaskManager* taskManager = NULL;
+	if(multiThreaded)
+	{
+		dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+		taskManager = PxTaskManager::createTaskManager(gErrorCallback, dispatcher);
+	}
+	SnippetUtils::Sync* sync = SnippetUtils::syncCreate();
+
+	PxBroadPhaseDesc bpDesc(type);
+	PxBroadPhase* bp = PxCreateBroadPhase(bpDesc);
+	PxAABBManager* manager = PxCreateAABBManager(*bp);
+
+	const PxU32 nbObjects = scene.mCenters.size();
+	for(PxU32 i=0;i<nbObjects;i++)
+		manager->addObject(i, computeBounds(scene, i, 0), PxGetBroadPhaseDynamicFilterGroup(i));
+
+	nbPairs = 0;
+	updateBroadPhase(manager, taskManager, sync, nbPairs);
+
+	PxU64 time = 0;
+	for(PxU32 frame=1; frame<=gNbWarmupFrames+gNbTimedFrames; frame++)
+	{
+		// Remove a few objects on odd frames, re-add them on even frames
+		const PxU32 first = (((frame+1)/2)*gRemovedPerFrame) % (nbObjects - gRemovedPerFrame);
+		const PxU32 last = first + gRemovedPerFrame;
+
+		for(PxU32 i=0;i<scene.mNbMoving;i++)
+		{
+			if(i>=first && i<last)
+				continue;
+			const PxBounds3 bounds = computeBounds(scene, i, frame);
+			manager->updateObject(i, &bounds);
+		}
+
+		for(PxU32 i=first; i<last; i++)
+		{
+			if(frame&1)
+				manager->removeObject(i);
+			else
+				manager->addObject(i, computeBounds(scene, i, frame), PxGetBroadPhaseDynamicFilterGroup(i));
+		}
+
+		const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		updateBroadPhase(manager, taskManager, sync, nbPairs);
+		if(frame>gNbWarmupFrames)
+			time += SnippetUtils::getCurrentTimeCounterValue() - startTime;
+	}
+
+	PX_RELEASE(manager);
+	PX_RELEASE(bp);
+	SnippetUtils::syncRelease(sync);
+	PX_RELEASE(taskManager);
+	PX_RELEASE(dispatcher);
+
+	return SnippetUtils::getElapsedTimeInMilliseconds(time) / PxReal(gNbTimedFrames);
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	PxU32 nbObjects = 100000;
+	PxU32 maxNbThreads = 8;
+	if(argc > 1)
+		nbObjects = PxU32(atoi(argv[1]));
+	if(argc > 2)
+		maxNbThreads = PxU32(atoi(argv[2]));
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	printf("%d objects, %d physical cores\n", nbObjects, SnippetUtils::getNbPhysicalCores());
+
+	const PxReal movingFractions[] = { 0.1f, 1.0f };
+	for(PxU32 m=0; m<2; m++)
+	{
+		Scene scene;
+		createScene(scene, nbObjects, movingFractions[m]);
+
+		printf("\n%d%% moving objects\n", PxU32(movingFractions[m]*100.0f));
+		printf("threads | SAP (ms/update) | PABP (ms/update) | pairs\n");
+
+		PxU32 sapPairs, pabpPairs;
+		PxReal sapTime = runBenchmark(scene, PxBroadPhaseType::eSAP, false, 0, sapPairs);
+		PxReal pabpTime = runBenchmark(scene, PxBroadPhaseType::ePABP, false, 0, pabpPairs);
+		printf("   none | %15.3f | %16.3f | %d / %d\n", double(sapTime), double(pabpTime), sapPairs, pabpPairs);
+
+		for(PxU32 nbThreads=1; nbThreads<=maxNbThreads; nbThreads*=2)
+		{
+			sapTime = runBenchmark(scene, PxBroadPhaseType::eSAP, true, nbThreads, sapPairs);
+			pabpTime = runBenchmark(scene, PxBroadPhaseType::ePABP, true, nbThreads, pabpPairs);
+			printf("%7d | %15.3f | %16.3f | %d / %d\n", nbThreads, double(sapTime), double(pabpTime), sapPairs, pabpPairs);
+		}
+	}
+
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetBroadPhaseBenchmark done.\n");
+
+	return 0;
+}
@@ -0,0 +1,256 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+// ****************************************************************************
+// This snippet measures batched convex mesh cooking on a corpus of fracture
+// chunks. By default the corpus is generated by a Voronoi fracture of a box:
+// each chunk is the set of points of a dense random sampling of the box that
+// are closest to one of the fracture sites, which gives the kind of irregular
+// point clouds fracture tools send to the cooker. A corpus exported from a
+// fracture tool can be used instead (text file: for each chunk, the number of
+// points followed by the points as "x y z" lines).
+//
+// The corpus is cooked with PxCookConvexMesh() one chunk at a time, then with
+// PxCookConvexMeshes() without a dispatcher and with 1 to maxNbThreads worker
+// threads. This is done with and without PxConvexFlag::ePLANE_SHIFTING, and the
+// cooked data of the batches is checked against the one-by-one results.
+//
+// Usage: SnippetConvexBatchCooking [maxNbThreads] [corpusFile]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+static const PxU32	gNbSites			= 512;
+static const PxU32	gNbSamples			= 256*1024;
+static const PxU32	gVertexLimit		= 64;
+
+struct Chunk
+{
+	PxArray<PxVec3>	mPoints;
+};
+
+static PxArray<Chunk>	gChunks;
+
+static SnippetUtils::BasicRandom gRandom(42);
+
+static PxVec3 randomPoint(const PxVec3& extents)
+{
+	return PxVec3(gRandom.rand(-extents.x, extents.x), gRandom.rand(-extents.y, extents.y), gRandom.rand(-extents.z, extents.z));
+}
+
+// Voronoi fracture of a box, each sample goes to the chunk of its closest site.
+static void generateCorpus()
+{
+	const PxVec3 extents(4.0f, 1.0f, 2.0f);
+
+	PxArray<PxVec3> sites;
+	sites.reserve(gNbSites);
+	for(PxU32 i=0;i<gNbSites;i++)
+		sites.pushBack(randomPoint(extents));
+
+	gChunks.resize(gNbSites);
+	for(PxU32 i=0;i<gNbSamples;i++)
+	{
+		const PxVec3 p = randomPoint(extents);
+
+		PxU32 closest = 0;
+		PxReal closestDist = PX_MAX_F32;
+		for(PxU32 j=0;j<gNbSites;j++)
+		{
+			const PxReal d = (p - sites[j]).magnitudeSquared();
+			if(d < closestDist)
+			{
+				closestDist = d;
+				closest = j;
+			}
+		}
+		gChunks[closest].mPoints.pushBack(p);
+	}
+
+	// drop the degenerate chunks
+	PxU32 nb = 0;
+	for(PxU32 i=0;i<gChunks.size();i++)
+	{
+		if(gChunks[i].mPoints.size() >= 8)
+			gChunks[nb++].mPoints = gChunks[i].mPoints;
+	}
+	gChunks.resize(nb);
+}
+
+static bool loadCorpus(const char* filename)
+{
+	FILE* fp = fopen(filename, "r");
+	if(!fp)
+		return false;
+
+	unsigned int nbPoints;
+	while(fscanf(fp, "%u", &nbPoints) == 1)
+	{
+		Chunk chunk;
+		for(PxU32 i=0;i<nbPoints;i++)
+		{
+			PxVec3 p;
+			if(fscanf(fp, "%f %f %f", &p.x, &p.y, &p.z) != 3)
+			{
+				fclose(fp);
+				return false;
+			}
+			chunk.mPoints.pushBack(p);
+		}
+		gChunks.pushBack(chunk);
+	}
+	fclose(fp);
+	return gChunks.size() != 0;
+}
+
+static void setupDescs(PxArray<PxConvexMeshDesc>& descs, PxConvexFlags flags)
+{
+	descs.resize(gChunks.size());
+	for(PxU32 i=0;i<gChunks.size();i++)
+	{
+		descs[i].points.count	= gChunks[i].mPoints.size();
+		descs[i].points.stride	= sizeof(PxVec3);
+		descs[i].points.data	= gChunks[i].mPoints.begin();
+		descs[i].flags			= flags;
+		descs[i].vertexLimit	= gVertexLimit;
+	}
+}
+
+// Cooks the corpus one chunk at a time, returns the time in milliseconds.
+static PxReal cookOneByOne(const PxCookingParams& params, const PxArray<PxConvexMeshDesc>& descs, PxDefaultMemoryOutputStream* streams)
+{
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0;i<descs.size();i++)
+		PxCookConvexMesh(params, descs[i], streams[i]);
+	const PxU64 endTime = SnippetUtils::getCurrentTimeCounterValue();
+	return SnippetUtils::getElapsedTimeInMilliseconds(endTime - startTime);
+}
+
+// Cooks the corpus as one batch, returns the time in milliseconds or a negative value if the output does not match the reference.
+static PxReal cookBatch(const PxCookingParams& params, const PxArray<PxConvexMeshDesc>& descs, const PxDefaultMemoryOutputStream* reference)
+{
+	const PxU32 nb = descs.size();
+	PxDefaultMemoryOutputStream* streams = new PxDefaultMemoryOutputStream[nb];
+	PxOutputStream** streamPtrs = new PxOutputStream*[nb];
+	for(PxU32 i=0;i<nb;i++)
+		streamPtrs[i] = &streams[i];
+
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	PxCookConvexMeshes(params, nb, descs.begin(), streamPtrs, NULL);
+	const PxU64 endTime = SnippetUtils::getCurrentTimeCounterValue();
+
+	bool identical = true;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(streams[i].getSize() != reference[i].getSize() || memcmp(streams[i].getData(), reference[i].getData(), streams[i].getSize()))
+			identical = false;
+	}
+
+	delete [] streamPtrs;
+	delete [] streams;
+
+	const PxReal time = SnippetUtils::getElapsedTimeInMilliseconds(endTime - startTime);
+	return identical ? time : -1.0f;
+}
+
+static void runBenchmark(PxConvexFlags flags, const char* name, PxU32 maxNbThreads)
+{
+	PxCookingParams params = PxCookingParams(PxTolerancesScale());
+
+	PxArray<PxConvexMeshDesc> descs;
+	setupDescs(descs, flags);
+
+	PxDefaultMemoryOutputStream* reference = new PxDefaultMemoryOutputStream[descs.size()];
+	const PxReal oneByOneTime = cookOneByOne(params, descs, reference);
+
+	printf("\n%s\n", name);
+	printf("%-18s | %10.2f ms\n", "one by one", double(oneByOneTime));
+
+	const PxReal batchTime = cookBatch(params, descs, reference);
+	printf("%-18s | %10.2f ms%s\n", "batch, no threads", double(PxAbs(batchTime)), batchTime < 0.0f ? " (OUTPUT MISMATCH)" : "");
+
+	for(PxU32 nbThreads=1; nbThreads<=maxNbThreads; nbThreads*=2)
+	{
+		PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+		params.cpuDispatcher = dispatcher;
+		const PxReal time = cookBatch(params, descs, reference);
+		params.cpuDispatcher = NULL;
+		dispatcher->release();
+
+		char label[64];
+		sprintf(label, "batch, %d threads", nbThreads);
+		printf("%-18s | %10.2f ms%s\n", label, double(PxAbs(time)), time < 0.0f ? " (OUTPUT MISMATCH)" : "");
+	}
+
+	delete [] reference;
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	PxU32 maxNbThreads = PxMax(SnippetUtils::getNbPhysicalCores(), PxU32(1));
+	if(argc > 1)
+		maxNbThreads = PxU32(atoi(argv[1]));
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	if(argc > 2)
+	{
+		if(!loadCorpus(argv[2]))
+		{
+			printf("Could not load corpus %s\n", argv[2]);
+			PX_RELEASE(gFoundation);
+			return 1;
+		}
+	}
+	else
+		generateCorpus();
+
+	PxU32 nbPoints = 0;
+	for(PxU32 i=0;i<gChunks.size();i++)
+		nbPoints += gChunks[i].mPoints.size();
+	printf("%d chunks, %d points, vertex limit %d\n", gChunks.size(), nbPoints, gVertexLimit);
+
+	runBenchmark(PxConvexFlag::eCOMPUTE_CONVEX, "eCOMPUTE_CONVEX", maxNbThreads);
+	runBenchmark(PxConvexFlag::eCOMPUTE_CONVEX | PxConvexFlag::ePLANE_SHIFTING, "eCOMPUTE_CONVEX | ePLANE_SHIFTING", maxNbThreads);
+
+	gChunks.reset();
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetConvexBatchCooking done.\n");
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet shares a PxCookingCache directory between several caches, the
+// way several processes would share it.
+//
+// Two caches cook different terrain tiles and flush their index in turn. A
+// cache created afterwards must know the tiles of both. A cache with a smaller
+// budget then evicts the least recently used tiles, and the index must stay
+// within that budget after the other caches flush again. The entries still on
+// disk are finally counted by cooking all the tiles with a new cache.
+//
+// Usage: SnippetCookingCache [directory]
+// The directory must exist. Default is the current directory. The cache files
+// are removed at the end.
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "extensions/PxCookingCache.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation	= NULL;
+
+static const PxU32	gNbTiles		= 8;
+static const PxU32	gTileResolution	= 64;
+static const PxU64	gLargeBudget	= PxU64(1)<<32;
+
+struct Tile
+{
+	PxArray<PxVec3>	verts;
+	PxArray<PxU32>	indices;
+};
+
+static void createTile(Tile& tile, PxU32 index)
+{
+	SnippetUtils::BasicRandom random(index + 1);
+	for(PxU32 j=0;j<gTileResolution;j++)
+		for(PxU32 i=0;i<gTileResolution;i++)
+			tile.verts.pushBack(PxVec3(PxReal(i), random.rand(0.0f, 2.0f), PxReal(j)));
+
+	for(PxU32 j=0;j<gTileResolution-1;j++)
+		for(PxU32 i=0;i<gTileResolution-1;i++)
+		{
+			const PxU32 v = i+j*gTileResolution;
+			tile.indices.pushBack(v);	tile.indices.pushBack(v+gTileResolution);	tile.indices.pushBack(v+1);
+			tile.indices.pushBack(v+1);	tile.indices.pushBack(v+gTileResolution);	tile.indices.pushBack(v+gTileResolution+1);
+		}
+}
+
+static void cookTiles(PxCookingCache& cache, const Tile* tiles, PxU32 first, PxU32 nb)
+{
+	const PxCookingParams params((PxTolerancesScale()));
+	for(PxU32 i=first;i<first+nb;i++)
+	{
+		PxTriangleMeshDesc desc;
+		desc.points.count		= tiles[i].verts.size();
+		desc.points.stride		= sizeof(PxVec3);
+		desc.points.data		= tiles[i].verts.begin();
+		desc.triangles.count	= tiles[i].indices.size()/3;
+		desc.triangles.stride	= 3*sizeof(PxU32);
+		desc.triangles.data		= tiles[i].indices.begin();
+
+		PxDefaultMemoryOutputStream cooked;
+		cache.cookTriangleMesh(params, desc, cooked);
+	}
+}
+
+static bool check(const char* name, bool condition)
+{
+	printf("%-60s %s\n", name, condition ? "ok" : "FAILED");
+	return condition;
+}
+
+static bool runCaches(const char* directory)
+{
+	Tile tiles[gNbTiles];
+	for(PxU32 i=0;i<gNbTiles;i++)
+		createTile(tiles[i], i);
+
+	bool success = true;
+	PxCookingCacheStats stats;
+
+	// two "processes" cook half of the tiles each and flush in turn
+	PxCookingCache* cacheA = PxCreateCookingCache(directory, gLargeBudget);
+	PxCookingCache* cacheB = PxCreateCookingCache(directory, gLargeBudget);
+	cookTiles(*cacheA, tiles, 0, gNbTiles/2);
+	cookTiles(*cacheB, tiles, gNbTiles/2, gNbTiles/2);
+	cacheA->flush();
+	cacheB->flush();
+	cacheA->flush();
+
+	PxCookingCache* cacheC = PxCreateCookingCache(directory, gLargeBudget);
+	cacheC->getStats(stats);
+	success &= check("Index holds the entries of both caches", stats.nbEntries==gNbTiles);
+	const PxU64 entrySize = stats.nbEntries ? stats.sizeInBytes / stats.nbEntries : 0;
+	cacheC->release();
+
+	// a cache with a smaller budget evicts entries of both caches
+	const PxU64 smallBudget = entrySize*5;
+	PxCookingCache* cacheD = PxCreateCookingCache(directory, smallBudget);
+	cacheD->flush();
+	cacheD->getStats(stats);
+	success &= check("Small cache evicts down to its budget", stats.nbEntries==5 && stats.sizeInBytes<=smallBudget);
+
+	// the other caches drop the evicted entries when they flush, instead of writing them back
+	cacheA->flush();
+	cacheB->flush();
+	cacheD->flush();
+
+	PxCookingCache* cacheE = PxCreateCookingCache(directory, gLargeBudget);
+	cacheE->getStats(stats);
+	success &= check("Index stays within the budget after other flushes", stats.nbEntries==5 && stats.sizeInBytes<=smallBudget);
+
+	// only the entries still on disk are hits
+	cookTiles(*cacheE, tiles, 0, gNbTiles);
+	cacheE->getStats(stats);
+	success &= check("Entries of the index are the entries on disk", stats.nbHits==5 && stats.nbMisses==3 && stats.nbErrors==0);
+
+	cacheA->release();
+	cacheB->release();
+	cacheD->release();
+
+	cacheE->clear();
+	cacheE->flush();
+	cacheE->getStats(stats);
+	success &= check("Clear removes all entries", stats.nbEntries==0);
+	cacheE->release();
+
+	char path[512];
+	snprintf(path, 512, "%s/index.pxcc", directory);
+	remove(path);
+	snprintf(path, 512, "%s/index.lock", directory);
+	remove(path);
+
+	return success;
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	const char* directory = argc > 1 ? argv[1] : ".";
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	const bool success = runCaches(directory);
+
+	PX_RELEASE(gFoundation);
+	printf("SnippetCookingCache done.\n");
+	return success ? 0 : 1;
+}
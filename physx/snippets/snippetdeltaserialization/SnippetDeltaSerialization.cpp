@@ -0,0 +1,247 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet streams changes of a collection with binary delta serialization.
+// The source collection holds a material, a convex mesh and a few dynamic
+// actors with ids, and one actor without id. A manifest taken from an empty
+// collection makes the first delta contain everything. Two more deltas are
+// written after moving one actor each, and all deltas are applied in order to
+// the same base collection.
+//
+// The snippet checks that the base collection only holds the objects with ids,
+// that the mesh and material deserialized by the first delta stay resident,
+// that a delta only contains the moved actor, its shape and the actor without
+// id, and that deltas of a different PhysX version are rejected.
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "extensions/PxCollectionExt.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation	= NULL;
+static PxPhysics*				gPhysics	= NULL;
+
+static const PxU32	gNbActors		= 8;
+static const PxU32	MAX_MEMBLOCKS	= 8;
+static void*		gMemBlocks[MAX_MEMBLOCKS];
+static PxU32		gMemBlockCount	= 0;
+
+// deserialized objects live in the memory block, which has to stay allocated until they are released
+static void* createAlignedBlock(PxU32 size)
+{
+	PX_ASSERT(gMemBlockCount < MAX_MEMBLOCKS);
+	PxU8* baseAddr = static_cast<PxU8*>(malloc(size+PX_SERIAL_FILE_ALIGN-1));
+	gMemBlocks[gMemBlockCount++] = baseAddr;
+	return reinterpret_cast<void*>((size_t(baseAddr)+PX_SERIAL_FILE_ALIGN-1)&~(PX_SERIAL_FILE_ALIGN-1));
+}
+
+static PxConvexMesh* createConvexMesh()
+{
+	PxVec3 verts[16];
+	for(PxU32 i=0;i<16;i++)
+	{
+		const PxReal a = PxReal(i&7) * PxTwoPi / 8.0f;
+		verts[i] = PxVec3(PxCos(a), i<8 ? -0.5f : 0.5f, PxSin(a));
+	}
+
+	PxConvexMeshDesc desc;
+	desc.points.count	= 16;
+	desc.points.stride	= sizeof(PxVec3);
+	desc.points.data	= verts;
+	desc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+	return PxCreateConvexMesh(PxCookingParams(PxTolerancesScale()), desc);
+}
+
+// applies a delta to the base collection, releases the objects it replaced and returns the number of deserialized objects
+static PxU32 applyDelta(PxDefaultMemoryOutputStream& delta, PxSerializationRegistry& sr, PxCollection& base, PxCollection*& idless)
+{
+	void* block = createAlignedBlock(delta.getSize());
+	memcpy(block, delta.getData(), delta.getSize());
+
+	PxCollection* replaced = PxCreateCollection();
+	PxCollection* collection = PxSerialization::createCollectionFromBinaryDelta(block, sr, base, replaced);
+	if(!collection)
+	{
+		replaced->release();
+		return 0;
+	}
+
+	// the actor without id of the previous delta is superseded by the new copy
+	if(idless)
+	{
+		PxCollectionExt::releaseObjects(*idless);
+		idless->release();
+	}
+	idless = PxCreateCollection();
+	const PxU32 nb = collection->getNbObjects();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		PxBase& object = collection->getObject(i);
+		if(collection->getId(object) == PX_SERIAL_OBJECT_ID_INVALID && object.is<PxRigidActor>())
+			idless->add(object);
+	}
+
+	PxCollectionExt::releaseObjects(*replaced);
+	replaced->release();
+	collection->release();
+	return nb;
+}
+
+static bool checkPose(PxCollection& base, PxSerialObjectId id, const PxVec3& expected)
+{
+	PxBase* object = base.find(id);
+	const PxRigidDynamic* actor = object ? object->is<PxRigidDynamic>() : NULL;
+	return actor && actor->getGlobalPose().p == expected;
+}
+
+static bool runDeltas()
+{
+	PxSerializationRegistry* sr = PxSerialization::createSerializationRegistry(*gPhysics);
+
+	PxMaterial* material = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+	PxConvexMesh* mesh = createConvexMesh();
+
+	PxCollection* source = PxCreateCollection();
+	PxRigidDynamic* actors[gNbActors];
+	for(PxU32 i=0;i<gNbActors;i++)
+	{
+		actors[i] = PxCreateDynamic(*gPhysics, PxTransform(PxVec3(PxReal(i)*3.0f, 1.0f, 0.0f)), PxConvexMeshGeometry(mesh), *material, 1.0f);
+		source->add(*actors[i]);
+	}
+	PxSerialization::complete(*source, *sr);
+	PxSerialization::createSerialObjectIds(*source, PxSerialObjectId(1));
+
+	// the actor without id is added after the ids were created, with an exclusive shape of its own
+	PxRigidDynamic* idlessActor = PxCreateDynamic(*gPhysics, PxTransform(PxVec3(0.0f, 5.0f, 0.0f)), PxConvexMeshGeometry(mesh), *material, 1.0f);
+	source->add(*idlessActor);
+	PxShape* idlessShape;
+	idlessActor->getShapes(&idlessShape, 1);
+	source->add(*idlessShape);
+
+	const PxU32 nbWithId = source->getNbObjects() - 2;
+
+	PxCollection* empty = PxCreateCollection();
+	PxSerializationManifest* manifest = PxSerialization::createSerializationManifest(*empty, *sr);
+	empty->release();
+
+	PxCollection* base = PxCreateCollection();
+	PxCollection* idless = NULL;
+	bool success = true;
+
+	const PxSerialObjectId meshId = source->getId(*mesh);
+	const PxSerialObjectId materialId = source->getId(*material);
+	PxBase* residentMesh = NULL;
+	PxBase* residentMaterial = NULL;
+
+	for(PxU32 step=0; step<3; step++)
+	{
+		if(step)
+			actors[step]->setGlobalPose(PxTransform(PxVec3(PxReal(step)*3.0f, 10.0f, 0.0f)));
+
+		PxDefaultMemoryOutputStream delta;
+		if(!PxSerialization::serializeCollectionDeltaToBinary(delta, *source, *sr, *manifest))
+		{
+			printf("Delta %d: serialization failed.\n", step);
+			success = false;
+			break;
+		}
+
+		const PxU32 nbDeserialized = applyDelta(delta, *sr, *base, idless);
+		if(!step)
+		{
+			residentMesh = base->find(meshId);
+			residentMaterial = base->find(materialId);
+		}
+
+		// the moved actor and its exclusive shape, plus the actor without id and its shape
+		const PxU32 expectedNbDeserialized = step ? 4 : source->getNbObjects();
+		const bool sameResources = residentMesh && base->find(meshId) == residentMesh && base->find(materialId) == residentMaterial;
+		const bool poseOk = !step || checkPose(*base, source->getId(*actors[step]), actors[step]->getGlobalPose().p);
+		const bool ok = nbDeserialized == expectedNbDeserialized && base->getNbObjects() == nbWithId && sameResources && poseOk;
+		printf("Delta %d: %d bytes, %d objects deserialized, %d resident objects: %s\n", step, delta.getSize(), nbDeserialized, base->getNbObjects(), ok ? "ok" : "MISMATCH");
+		success &= ok;
+	}
+
+	// a delta written by a different PhysX version is rejected
+	{
+		PxDefaultMemoryOutputStream delta;
+		PxSerialization::serializeCollectionDeltaToBinary(delta, *source, *sr, *manifest, false, false);
+		void* block = createAlignedBlock(delta.getSize());
+		memcpy(block, delta.getData(), delta.getSize());
+		reinterpret_cast<PxU32*>(block)[1] ^= 0x100;
+		printf("Applying a delta with a different version, expecting an error:\n");
+		const bool rejected = PxSerialization::createCollectionFromBinaryDelta(block, *sr, *base) == NULL;
+		printf("Version mismatch: %s\n", rejected ? "ok" : "MISMATCH");
+		success &= rejected;
+	}
+
+	manifest->release();
+	if(idless)
+		idless->release();
+	base->release();
+	source->release();
+	sr->release();
+	return success;
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	PxInitExtensions(*gPhysics, NULL);
+}
+
+static void cleanupPhysics()
+{
+	PxCloseExtensions();
+	PX_RELEASE(gPhysics);	// releases all objects
+
+	// now that the objects have been released, it's safe to release the space they occupy
+	for(PxU32 i=0;i<gMemBlockCount;i++)
+		free(gMemBlocks[i]);
+	gMemBlockCount = 0;
+
+	PX_RELEASE(gFoundation);
+	printf("SnippetDeltaSerialization done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+	const bool success = runDeltas();
+	cleanupPhysics();
+	return success ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet measures how the simulation scales with the number of worker
+// threads of the default CPU dispatcher. It simulates the scene used in
+// SnippetMultiThreading (stacks of boxes on a ground plane), scaled up so that
+// there is enough work for many threads, with 1 to 64 worker threads. Each
+// configuration is run with both PxDefaultCpuDispatcherSchedulingMode values,
+// and with a dispatcher created by PxDefaultCpuDispatcherCreateTopologyAware,
+// and the average time per simulation step is printed.
+//
+// Usage: SnippetDispatcherScaling [maxNbThreads]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+#include "../snippetcommon/SnippetPrint.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32	gNbStacks		= 64;
+static const PxU32	gStackSize		= 10;
+static const PxU32	gNbWarmupSteps	= 30;
+static const PxU32	gNbTimedSteps	= 200;
+
+static void createStack(PxScene* scene, const PxTransform& t, PxU32 size, PxReal halfExtent)
+{
+	PxShape* shape = gPhysics->createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *gMaterial);
+	for(PxU32 i=0; i<size;i++)
+	{
+		for(PxU32 j=0;j<size-i;j++)
+		{
+			PxTransform localTm(PxVec3(PxReal(j*2) - PxReal(size-i), PxReal(i*2+1), 0) * halfExtent);
+			PxRigidDynamic* body = gPhysics->createRigidDynamic(t.transform(localTm));
+			body->attachShape(*shape);
+			PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+			scene->addActor(*body);
+		}
+	}
+	shape->release();
+}
+
+static PxScene* createScene(PxCpuDispatcher* dispatcher)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher	= dispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0,1,0,0), *gMaterial);
+	scene->addActor(*groundPlane);
+
+	// Stacks are laid out on a grid so that they form independent islands, like in SnippetMultiThreading.
+	const PxU32 nbStacksPerRow = 8;
+	for(PxU32 i=0;i<gNbStacks;i++)
+	{
+		const PxReal x = PxReal(i % nbStacksPerRow) * 50.0f;
+		const PxReal z = PxReal(i / nbStacksPerRow) * 10.0f;
+		createStack(scene, PxTransform(PxVec3(x, 0.0f, z)), gStackSize, 2.0f);
+	}
+	return scene;
+}
+
+// Returns the average time per simulation step, in milliseconds. The dispatcher is released.
+static PxReal runBenchmark(PxDefaultCpuDispatcher* dispatcher)
+{
+	PxScene* scene = createScene(dispatcher);
+
+	for(PxU32 i=0; i<gNbWarmupSteps; ++i)
+	{
+		scene->simulate(1.0f/60.0f);
+		scene->fetchResults(true);
+	}
+
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0; i<gNbTimedSteps; ++i)
+	{
+		scene->simulate(1.0f/60.0f);
+		scene->fetchResults(true);
+	}
+	const PxU64 endTime = SnippetUtils::getCurrentTimeCounterValue();
+
+	PX_RELEASE(scene);
+	PX_RELEASE(dispatcher);
+
+	return SnippetUtils::getElapsedTimeInMilliseconds(endTime - startTime) / PxReal(gNbTimedSteps);
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetDispatcherScaling done.\n");
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	PxU32 maxNbThreads = 64;
+	if(argc > 1)
+		maxNbThreads = PxU32(atoi(argv[1]));
+
+	initPhysics();
+
+	printf("%d stacks, %d bodies, %d physical cores\n", gNbStacks, gNbStacks*gStackSize*(gStackSize+1)/2, SnippetUtils::getNbPhysicalCores());
+	printf("threads | shared queue (ms/step) | work stealing (ms/step) | topology aware (ms/step)\n");
+
+	for(PxU32 nbThreads=1; nbThreads<=maxNbThreads; nbThreads*=2)
+	{
+		const PxDefaultCpuDispatcherWaitForWorkMode::Enum waitMode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK;
+		const PxReal sharedTime = runBenchmark(PxDefaultCpuDispatcherCreate(nbThreads, NULL, waitMode, 0, PxDefaultCpuDispatcherSchedulingMode::eSHARED_QUEUE));
+		const PxReal stealingTime = runBenchmark(PxDefaultCpuDispatcherCreate(nbThreads, NULL, waitMode, 0, PxDefaultCpuDispatcherSchedulingMode::eWORK_STEALING));
+		const PxReal topologyTime = runBenchmark(PxDefaultCpuDispatcherCreateTopologyAware(nbThreads));
+		printf("%7d | %22.3f | %23.3f | %24.3f\n", nbThreads, double(sharedTime), double(stealingTime), double(topologyTime));
+	}
+
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,307 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet compares the performance of the eHGRID broadphase to eMBP and
+// ePABP on a planet-scale scene (1M objects by default), using the standalone
+// broadphase API. Objects are grouped in clusters spread over the surface of
+// an Earth-sized sphere, plus a few large terrain-like objects, so that the
+// scene covers a huge volume while most of it is empty. eHGRID and ePABP need
+// no setup, while eMBP uses regions computed from the world bounds with
+// PxBroadPhaseExt::createRegionsFromWorldBounds. Each frame a fraction of the
+// objects move and a few objects are removed and re-added. The average time
+// per update is printed along with the number of overlapping pairs. eHGRID and
+// ePABP must report the same number of pairs. eMBP stores bounds as integers
+// with a conservative rounding, so it reports more pairs far from the origin.
+//
+// Usage: SnippetGridBroadPhaseBenchmark [nbObjects] [nbThreads]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+#include "../snippetcommon/SnippetPrint.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+static const PxReal	gPlanetRadius		= 6371000.0f;
+static const PxU32	gNbObjectsPerCluster= 1000;
+static const PxReal	gClusterSize		= 80.0f;
+static const PxU32	gNbTerrainObjects	= 64;
+static const PxU32	gNbWarmupFrames		= 5;
+static const PxU32	gNbTimedFrames		= 20;
+static const PxU32	gRemovedPerFrame	= 100;	// objects removed and re-added every other frame
+
+namespace
+{
+	class WaitTask : public PxLightCpuTask
+	{
+	public:
+		WaitTask(SnippetUtils::Sync* syncHandle) : PxLightCpuTask(), mSyncHandle(syncHandle)	{}
+
+		virtual void run()	{}
+
+		PX_INLINE void release()
+		{
+			PxLightCpuTask::release();
+			SnippetUtils::syncSet(mSyncHandle);
+		}
+
+		virtual const char* getName() const { return "WaitTask"; }
+
+	private:
+		SnippetUtils::Sync* mSyncHandle;
+	};
+
+	struct Scene
+	{
+		PxArray<PxVec3>		mCenters;
+		PxArray<PxVec3>		mExtents;
+		PxArray<PxReal>		mPhases;
+		PxBounds3			mWorldBounds;
+		PxU32				mNbMoving;
+	};
+}
+
+static PxReal rand01()
+{
+	return PxReal(rand()) / PxReal(RAND_MAX);
+}
+
+static PxVec3 randomDirection()
+{
+	PxVec3 dir;
+	do
+	{
+		dir = PxVec3(rand01()*2.0f - 1.0f, rand01()*2.0f - 1.0f, rand01()*2.0f - 1.0f);
+	}while(dir.magnitudeSquared()>1.0f || dir.magnitudeSquared()<1e-4f);
+	return dir.getNormalized();
+}
+
+static void createScene(Scene& scene, PxU32 nbObjects, PxReal movingFraction)
+{
+	srand(42);
+	scene.mCenters.resize(nbObjects);
+	scene.mExtents.resize(nbObjects);
+	scene.mPhases.resize(nbObjects);
+
+	// The first objects are small and grouped in clusters on the surface of the planet
+	const PxU32 nbSmallObjects = nbObjects - gNbTerrainObjects;
+	PxVec3 clusterCenter(0.0f);
+	for(PxU32 i=0;i<nbSmallObjects;i++)
+	{
+		if(!(i%gNbObjectsPerCluster))
+			clusterCenter = randomDirection() * gPlanetRadius;
+
+		const PxVec3 offset = PxVec3(rand01()-0.5f, rand01()-0.5f, rand01()-0.5f) * gClusterSize;
+		scene.mCenters[i] = clusterCenter + PxVec3(offset.x, offset.y*0.125f, offset.z);
+		scene.mExtents[i] = PxVec3(0.5f + rand01(), 0.5f + rand01(), 0.5f + rand01());
+		scene.mPhases[i] = rand01() * PxTwoPi;
+	}
+
+	// The last objects are large static terrain tiles
+	for(PxU32 i=nbSmallObjects;i<nbObjects;i++)
+	{
+		scene.mCenters[i] = randomDirection() * gPlanetRadius;
+		scene.mExtents[i] = PxVec3(5000.0f, 100.0f, 5000.0f);
+		scene.mPhases[i] = 0.0f;
+	}
+
+	scene.mWorldBounds = PxBounds3::empty();
+	for(PxU32 i=0;i<nbObjects;i++)
+		scene.mWorldBounds.include(PxBounds3::centerExtents(scene.mCenters[i], scene.mExtents[i]));
+	scene.mWorldBounds.fattenFast(10.0f);
+
+	scene.mNbMoving = PxU32(PxReal(nbSmallObjects) * movingFraction);
+}
+
+static PxBounds3 computeBounds(const Scene& scene, PxU32 i, PxU32 frame)
+{
+	PxVec3 center = scene.mCenters[i];
+	if(i<scene.mNbMoving)
+	{
+		const PxReal t = PxReal(frame) * 0.05f + scene.mPhases[i];
+		center += PxVec3(PxSin(t), PxCos(t*0.7f), PxSin(t*1.3f)) * 2.0f;
+	}
+	return PxBounds3::centerExtents(center, scene.mExtents[i]);
+}
+
+static void updateBroadPhase(PxAABBManager* manager, PxTaskManager* taskManager, SnippetUtils::Sync* sync, PxU32& nbPairs)
+{
+	if(taskManager)
+	{
+		SnippetUtils::syncReset(sync);
+
+		WaitTask waitTask(sync);
+		taskManager->resetDependencies();
+		taskManager->startSimulation();
+		waitTask.setContinuation(*taskManager, NULL);
+
+		manager->update(&waitTask);
+
+		waitTask.removeReference();
+		SnippetUtils::syncWait(sync);
+		taskManager->stopSimulation();
+	}
+	else
+	{
+		manager->update();
+	}
+
+	PxBroadPhaseResults results;
+	manager->fetchResults(results);
+	nbPairs += results.mNbCreatedPairs;
+	nbPairs -= results.mNbDeletedPairs;
+}
+
+// Returns the average time per update, in milliseconds. The broadphase runs single-threaded when nbThreads is 0.
+static PxReal runBenchmark(const Scene& scene, PxBroadPhaseType::Enum type, PxU32 nbThreads, PxU32& nbPairs, PxReal& addTime)
+{
+	PxDefaultCpuDispatcher* dispatcher = NULL;
+	PxTaskManager* taskManager = NULL;
+	if(nbThreads)
+	{
+		dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+		taskManager = PxTaskManager::createTaskManager(gErrorCallback, dispatcher);
+	}
+	SnippetUtils::Sync* sync = SnippetUtils::syncCreate();
+
+	PxBroadPhaseDesc bpDesc(type);
+	PxBroadPhase* bp = PxCreateBroadPhase(bpDesc);
+	PxAABBManager* manager = PxCreateAABBManager(*bp);
+
+	if(type==PxBroadPhaseType::eMBP)
+	{
+		PxBounds3 regionBounds[256];
+		const PxU32 nbRegions = PxBroadPhaseExt::createRegionsFromWorldBounds(regionBounds, scene.mWorldBounds, 16);
+		for(PxU32 i=0;i<nbRegions;i++)
+		{
+			PxBroadPhaseRegion region;
+			region.mBounds = regionBounds[i];
+			region.mUserData = NULL;
+			bp->getRegions()->addRegion(region, false, NULL, NULL);
+		}
+	}
+
+	const PxU32 nbObjects = scene.mCenters.size();
+	const PxU32 nbSmallObjects = nbObjects - gNbTerrainObjects;
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		const PxBpFilterGroup group = i<nbSmallObjects ? PxGetBroadPhaseDynamicFilterGroup(i) : PxGetBroadPhaseStaticFilterGroup();
+		manager->addObject(i, computeBounds(scene, i, 0), group);
+	}
+
+	nbPairs = 0;
+	PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	updateBroadPhase(manager, taskManager, sync, nbPairs);
+	addTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+	PxU64 time = 0;
+	for(PxU32 frame=1; frame<=gNbWarmupFrames+gNbTimedFrames; frame++)
+	{
+		// Remove a few objects on odd frames, re-add them on even frames
+		const PxU32 first = (((frame+1)/2)*gRemovedPerFrame) % (nbSmallObjects - gRemovedPerFrame);
+		const PxU32 last = first + gRemovedPerFrame;
+
+		for(PxU32 i=0;i<scene.mNbMoving;i++)
+		{
+			if(i>=first && i<last)
+				continue;
+			const PxBounds3 bounds = computeBounds(scene, i, frame);
+			manager->updateObject(i, &bounds);
+		}
+
+		for(PxU32 i=first; i<last; i++)
+		{
+			if(frame&1)
+				manager->removeObject(i);
+			else
+				manager->addObject(i, computeBounds(scene, i, frame), PxGetBroadPhaseDynamicFilterGroup(i));
+		}
+
+		startTime = SnippetUtils::getCurrentTimeCounterValue();
+		updateBroadPhase(manager, taskManager, sync, nbPairs);
+		if(frame>gNbWarmupFrames)
+			time += SnippetUtils::getCurrentTimeCounterValue() - startTime;
+	}
+
+	PX_RELEASE(manager);
+	PX_RELEASE(bp);
+	SnippetUtils::syncRelease(sync);
+	PX_RELEASE(taskManager);
+	PX_RELEASE(dispatcher);
+
+	return SnippetUtils::getElapsedTimeInMilliseconds(time) / PxReal(gNbTimedFrames);
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	PxU32 nbObjects = 1000000;
+	PxU32 nbThreads = 4;
+	if(argc > 1)
+		nbObjects = PxMax(PxU32(atoi(argv[1])), gNbTerrainObjects + gRemovedPerFrame*2);
+	if(argc > 2)
+		nbThreads = PxU32(atoi(argv[2]));
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	printf("%d objects, %d physical cores\n", nbObjects, SnippetUtils::getNbPhysicalCores());
+
+	const PxBroadPhaseType::Enum types[] = { PxBroadPhaseType::eHGRID, PxBroadPhaseType::eMBP, PxBroadPhaseType::ePABP };
+	const char* names[] = { "HGRID", "MBP", "PABP" };
+
+	const PxReal movingFractions[] = { 0.1f, 1.0f };
+	for(PxU32 m=0; m<2; m++)
+	{
+		Scene scene;
+		createScene(scene, nbObjects, movingFractions[m]);
+
+		printf("\n%d%% moving objects\n", PxU32(movingFractions[m]*100.0f));
+		printf("broadphase | first update (ms) | ms/update, no threads | ms/update, %d threads | pairs\n", nbThreads);
+
+		for(PxU32 t=0; t<3; t++)
+		{
+			PxU32 stPairs, mtPairs;
+			PxReal stAddTime, mtAddTime;
+			const PxReal stTime = runBenchmark(scene, types[t], 0, stPairs, stAddTime);
+			const PxReal mtTime = nbThreads ? runBenchmark(scene, types[t], nbThreads, mtPairs, mtAddTime) : 0.0f;
+			printf("%10s | %17.3f | %21.3f | %20.3f | %d / %d\n", names[t], double(stAddTime), double(stTime), double(mtTime), stPairs, nbThreads ? mtPairs : stPairs);
+		}
+	}
+
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetGridBroadPhaseBenchmark done.\n");
+
+	return 0;
+}
@@ -0,0 +1,263 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet measures how islands are split when connections are lost, which
+// can run on multiple threads when many islands lose connections in the same
+// frame.
+//
+// The scene contains grids of boxes connected by fixed joints. The joints are
+// released a few at a time, in a random order, so that the grids break into
+// smaller and smaller pieces. The boxes are not in contact with each other
+// until the pieces fall on the ground.
+//
+// The scene is simulated with 1, 2 and N threads. The time spent finding routes
+// between nodes and splitting islands is captured with a PxProfilerCallback,
+// along with the number of islands processed, the number of nodes visited
+// ("hops") and the number of new islands per frame. The final poses and the
+// counters are checked to be the same in all runs.
+//
+// Usage: SnippetIslandSplit [nbThreads]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32	gNbGrids		= 64;
+static const PxU32	gGridSize		= 16;
+static const PxU32	gNbFrames		= 120;
+
+// Captures the time spent in "Basic.findPathsAndBreakIslands" and the counters recorded by the island manager.
+// The zones run on several threads at the same time, hence the lock.
+class IslandSplitProfiler : public PxProfilerCallback
+{
+public:
+	IslandSplitProfiler()	{ reset();	}
+
+	void reset()
+	{
+		mTime = 0;
+		mNbIslands = mNbHops = mNbSplits = 0;
+	}
+
+	virtual void* zoneStart(const char* eventName, bool, uint64_t)
+	{
+		if(strcmp(eventName, "Basic.findPathsAndBreakIslands"))
+			return NULL;
+		return reinterpret_cast<void*>(size_t(SnippetUtils::getCurrentTimeCounterValue()));
+	}
+
+	virtual void zoneEnd(void* profilerData, const char* eventName, bool, uint64_t)
+	{
+		if(strcmp(eventName, "Basic.findPathsAndBreakIslands"))
+			return;
+		const PxU64 time = SnippetUtils::getCurrentTimeCounterValue() - PxU64(size_t(profilerData));
+		PxMutex::ScopedLock lock(mMutex);
+		mTime += time;
+	}
+
+	virtual void recordData(int32_t value, const char* valueName, uint64_t)
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		if(!strcmp(valueName, "Basic.islandSplit.nbIslands"))
+			mNbIslands += PxU64(value);
+		else if(!strcmp(valueName, "Basic.islandSplit.nbHops"))
+			mNbHops += PxU64(value);
+		else if(!strcmp(valueName, "Basic.islandSplit.nbSplits"))
+			mNbSplits += PxU64(value);
+	}
+
+	PxMutex	mMutex;
+	PxU64	mTime;
+	PxU64	mNbIslands;
+	PxU64	mNbHops;
+	PxU64	mNbSplits;
+};
+
+// created after the foundation, which the mutex needs
+static IslandSplitProfiler* gProfiler = NULL;
+
+static SnippetUtils::BasicRandom gRandom(42);
+
+struct Result
+{
+	PxReal	splitMs;
+	PxReal	totalMs;
+	PxU64	nbIslands;
+	PxU64	nbHops;
+	PxU64	nbSplits;
+};
+
+static void createGrid(PxScene* scene, const PxVec3& pos, PxArray<PxRigidDynamic*>& actors, PxArray<PxJoint*>& joints)
+{
+	// the boxes are 1.2 apart so that they do not touch each other
+	const PxReal halfExtent = 0.5f;
+	const PxReal spacing = 1.2f;
+	const PxBoxGeometry box(halfExtent, halfExtent, halfExtent);
+	const PxU32 firstActor = actors.size();
+	for(PxU32 z=0; z<gGridSize; z++)
+	{
+		for(PxU32 x=0; x<gGridSize; x++)
+		{
+			PxRigidDynamic* actor = PxCreateDynamic(*gPhysics, PxTransform(pos + PxVec3(PxReal(x), 0.0f, PxReal(z)) * spacing), box, *gMaterial, 1.0f);
+			scene->addActor(*actor);
+			actors.pushBack(actor);
+
+			if(x)
+				joints.pushBack(PxFixedJointCreate(*gPhysics, actors[actors.size()-2], PxTransform(PxVec3(spacing * 0.5f, 0.0f, 0.0f)), actor, PxTransform(PxVec3(-spacing * 0.5f, 0.0f, 0.0f))));
+			if(z)
+				joints.pushBack(PxFixedJointCreate(*gPhysics, actors[firstActor + (z-1)*gGridSize + x], PxTransform(PxVec3(0.0f, 0.0f, spacing * 0.5f)), actor, PxTransform(PxVec3(0.0f, 0.0f, -spacing * 0.5f))));
+		}
+	}
+}
+
+static Result runBenchmark(PxU32 nbThreads, PxArray<PxTransform>& poses)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+	sceneDesc.cpuDispatcher	= dispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0, 1, 0, 0), *gMaterial);
+	scene->addActor(*groundPlane);
+
+	// same scene and same joint release order in all runs
+	gRandom.setSeed(1234);
+	PxArray<PxRigidDynamic*> actors;
+	PxArray<PxJoint*> joints;
+	for(PxU32 i=0; i<gNbGrids; i++)
+		createGrid(scene, PxVec3(PxReal(i%8)*24.0f - 96.0f, 4.0f + PxReal(i%3), PxReal(i/8)*24.0f - 96.0f), actors, joints);
+
+	for(PxU32 i=joints.size(); i>1; i--)
+	{
+		const PxU32 j = gRandom.randomize() % i;
+		PxSwap(joints[i-1], joints[j]);
+	}
+	const PxU32 nbJointsPerFrame = (joints.size() + gNbFrames - 1) / gNbFrames;
+
+	gProfiler->reset();
+	PxSetProfilerCallback(gProfiler);
+
+	PxU64 time = 0;
+	PxU32 nbReleasedJoints = 0;
+	for(PxU32 frame=0; frame<gNbFrames; frame++)
+	{
+		const PxU32 nbToRelease = PxMin(nbJointsPerFrame, joints.size() - nbReleasedJoints);
+		for(PxU32 i=0; i<nbToRelease; i++)
+			joints[nbReleasedJoints++]->release();
+
+		const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		scene->simulate(1.0f/60.0f);
+		scene->fetchResults(true);
+		time += SnippetUtils::getCurrentTimeCounterValue() - startTime;
+	}
+
+	PxSetProfilerCallback(NULL);
+
+	poses.clear();
+	for(PxU32 i=0; i<actors.size(); i++)
+		poses.pushBack(actors[i]->getGlobalPose());
+
+	PX_RELEASE(scene);
+	PX_RELEASE(dispatcher);
+
+	Result result;
+	result.splitMs = SnippetUtils::getElapsedTimeInMilliseconds(gProfiler->mTime);
+	result.totalMs = SnippetUtils::getElapsedTimeInMilliseconds(time);
+	result.nbIslands = gProfiler->mNbIslands;
+	result.nbHops = gProfiler->mNbHops;
+	result.nbSplits = gProfiler->mNbSplits;
+	return result;
+}
+
+static void printResult(PxU32 nbThreads, const Result& result, bool identical)
+{
+	const double frames = double(gNbFrames);
+	printf("%7d | %10.2f | %14.3f | %9.1f | %9.1f | %9.1f%s\n", nbThreads, double(result.totalMs), double(result.splitMs),
+		double(result.nbIslands)/frames, double(result.nbHops)/frames, double(result.nbSplits)/frames, identical ? "" : " (RESULTS MISMATCH)");
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	PxU32 nbThreads = 4;
+	if(argc > 1)
+		nbThreads = PxMax(PxU32(atoi(argv[1])), 1u);
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	PxInitExtensions(*gPhysics, NULL);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+
+	{
+		IslandSplitProfiler profiler;
+		gProfiler = &profiler;
+
+		printf("\n%d grids of %dx%d boxes, %d frames\n", gNbGrids, gGridSize, gGridSize, gNbFrames);
+		printf("threads |   total ms | route-find ms  | islands/f |    hops/f |  splits/f\n");
+
+		PxArray<PxTransform> refPoses, poses;
+		const Result ref = runBenchmark(1, refPoses);
+		printResult(1, ref, true);
+
+		const PxU32 threadCounts[] = { 2, nbThreads };
+		for(PxU32 i=0; i<2; i++)
+		{
+			if(i && nbThreads == 2)
+				break;
+			const Result result = runBenchmark(threadCounts[i], poses);
+			const bool identical = result.nbIslands == ref.nbIslands && result.nbHops == ref.nbHops && result.nbSplits == ref.nbSplits
+				&& poses.size() == refPoses.size() && !memcmp(poses.begin(), refPoses.begin(), sizeof(PxTransform)*poses.size());
+			printResult(threadCounts[i], result, identical);
+		}
+		printf("route-find ms: time spent in all threads, summed over the speculative and accurate island managers\n");
+
+		gProfiler = NULL;
+	}
+
+	PX_RELEASE(gMaterial);
+	PxCloseExtensions();
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetIslandSplit done.\n");
+
+	return 0;
+}
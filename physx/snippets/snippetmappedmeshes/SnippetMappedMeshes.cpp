@@ -0,0 +1,330 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet loads terrain tiles from a memory mapped file without copying
+// their mesh data. The tiles are cooked triangle meshes and a height field.
+// Each tile is stored as a binary serialized collection in one pack file, at
+// an offset aligned to PX_SERIAL_FILE_ALIGN. The pack is mapped with
+// PxDefaultMemoryMappedFile and the collections are deserialized in place.
+//
+// The snippet compares the load time with creating the meshes from cooked
+// streams in memory, checks that the vertices and triangles of the loaded
+// meshes point into the mapping, and compares raycasts and heights against
+// the source tiles.
+//
+// Usage: SnippetMappedMeshes [nbTiles]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "extensions/PxCollectionExt.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation	= NULL;
+static PxPhysics*				gPhysics	= NULL;
+
+static const PxU32	gTileResolution	= 128;
+static const PxReal	gTileSize		= 128.0f;
+static const PxU32	gNbRays			= 1024;
+static const char*	gPackName		= "SnippetMappedMeshes.pack";
+
+static PxReal terrainHeight(PxReal x, PxReal z)
+{
+	return 4.0f*PxSin(x*0.05f) + 3.0f*PxCos(z*0.07f) + PxSin((x+z)*0.31f);
+}
+
+static PxTriangleMesh* createTile(PxU32 tile, const PxCookingParams& params, PxDefaultMemoryOutputStream& cooked)
+{
+	const PxU32 nbVerts = gTileResolution*gTileResolution;
+	const PxU32 nbTris = (gTileResolution-1)*(gTileResolution-1)*2;
+	PxVec3* verts = new PxVec3[nbVerts];
+	PxU32* indices = new PxU32[nbTris*3];
+
+	const PxReal step = gTileSize / PxReal(gTileResolution-1);
+	const PxReal x0 = PxReal(tile)*gTileSize;
+	for(PxU32 j=0;j<gTileResolution;j++)
+		for(PxU32 i=0;i<gTileResolution;i++)
+		{
+			const PxReal x = x0 + PxReal(i)*step;
+			const PxReal z = PxReal(j)*step;
+			verts[i+j*gTileResolution] = PxVec3(x, terrainHeight(x, z), z);
+		}
+
+	PxU32* t = indices;
+	for(PxU32 j=0;j<gTileResolution-1;j++)
+		for(PxU32 i=0;i<gTileResolution-1;i++)
+		{
+			const PxU32 v = i+j*gTileResolution;
+			*t++ = v;	*t++ = v+gTileResolution;	*t++ = v+1;
+			*t++ = v+1;	*t++ = v+gTileResolution;	*t++ = v+gTileResolution+1;
+		}
+
+	PxTriangleMeshDesc desc;
+	desc.points.count		= nbVerts;
+	desc.points.stride		= sizeof(PxVec3);
+	desc.points.data		= verts;
+	desc.triangles.count	= nbTris;
+	desc.triangles.stride	= 3*sizeof(PxU32);
+	desc.triangles.data		= indices;
+
+	PxTriangleMesh* mesh = NULL;
+	if(PxCookTriangleMesh(params, desc, cooked))
+	{
+		PxDefaultMemoryInputData input(cooked.getData(), cooked.getSize());
+		mesh = gPhysics->createTriangleMesh(input);
+	}
+
+	delete [] indices;
+	delete [] verts;
+	return mesh;
+}
+
+static PxHeightField* createHeightField()
+{
+	PxHeightFieldSample* samples = new PxHeightFieldSample[gTileResolution*gTileResolution];
+	for(PxU32 i=0;i<gTileResolution*gTileResolution;i++)
+	{
+		samples[i].height = PxI16(terrainHeight(PxReal(i/gTileResolution), PxReal(i%gTileResolution))*100.0f);
+		samples[i].materialIndex0 = samples[i].materialIndex1 = 0;
+	}
+
+	PxHeightFieldDesc desc;
+	desc.nbRows			= gTileResolution;
+	desc.nbColumns		= gTileResolution;
+	desc.samples.data	= samples;
+	desc.samples.stride	= sizeof(PxHeightFieldSample);
+	PxHeightField* heightField = PxCreateHeightField(desc);
+	delete [] samples;
+	return heightField;
+}
+
+static bool writeAligned(PxOutputStream& stream, PxU64& offset, const void* data, PxU32 size)
+{
+	const PxU8 padding[PX_SERIAL_FILE_ALIGN] = { 0 };
+	const PxU32 nbPadding = PxU32((PX_SERIAL_FILE_ALIGN - (offset & (PX_SERIAL_FILE_ALIGN-1))) & (PX_SERIAL_FILE_ALIGN-1));
+	if(stream.write(padding, nbPadding) != nbPadding || stream.write(data, size) != size)
+		return false;
+	offset += nbPadding + size;
+	return true;
+}
+
+// the pack starts with the number of collections and their offsets, followed by the aligned collections
+static bool writePack(const PxArray<PxBase*>& objects, PxSerializationRegistry& sr)
+{
+	PxArray<PxDefaultMemoryOutputStream*> streams;
+	PxArray<PxU64> offsets;
+	PxU64 offset = sizeof(PxU32) + objects.size()*sizeof(PxU64);
+	for(PxU32 i=0;i<objects.size();i++)
+	{
+		PxCollection* collection = PxCreateCollection();
+		collection->add(*objects[i]);
+		PxDefaultMemoryOutputStream* stream = new PxDefaultMemoryOutputStream;
+		PxSerialization::serializeCollectionToBinary(*stream, *collection, sr);
+		collection->release();
+
+		offset = (offset + PX_SERIAL_FILE_ALIGN-1) & ~PxU64(PX_SERIAL_FILE_ALIGN-1);
+		offsets.pushBack(offset);
+		offset += stream->getSize();
+		streams.pushBack(stream);
+	}
+
+	bool success = false;
+	{
+		PxDefaultFileOutputStream file(gPackName);
+		if(file.isValid())
+		{
+			const PxU32 nb = objects.size();
+			offset = sizeof(PxU32) + nb*sizeof(PxU64);
+			success = file.write(&nb, sizeof(PxU32)) == sizeof(PxU32) && file.write(offsets.begin(), nb*sizeof(PxU64)) == nb*sizeof(PxU64);
+			for(PxU32 i=0;i<nb && success;i++)
+				success = writeAligned(file, offset, streams[i]->getData(), streams[i]->getSize()) && offset == offsets[i] + streams[i]->getSize();
+		}
+	}
+
+	for(PxU32 i=0;i<streams.size();i++)
+		delete streams[i];
+	return success;
+}
+
+static bool isInside(const void* ptr, const PxDefaultMemoryMappedFile& file)
+{
+	const PxU8* start = reinterpret_cast<const PxU8*>(file.getData());
+	const PxU8* p = reinterpret_cast<const PxU8*>(ptr);
+	return p >= start && PxU64(p - start) < file.getSize();
+}
+
+static PxU32 compareMeshes(const PxTriangleMesh& a, const PxTriangleMesh& b, const PxDefaultMemoryMappedFile& file)
+{
+	PxU32 nbMismatches = 0;
+	if(!isInside(b.getVertices(), file) || !isInside(b.getTriangles(), file))
+		nbMismatches++;
+
+	const PxBounds3 bounds = a.getLocalBounds();
+	PxU32 seed = 1;
+	for(PxU32 i=0;i<gNbRays;i++)
+	{
+		seed = seed*1664525u + 1013904223u;
+		const PxReal u = PxReal(seed>>8) / PxReal(1<<24);
+		seed = seed*1664525u + 1013904223u;
+		const PxReal v = PxReal(seed>>8) / PxReal(1<<24);
+		const PxVec3 origin(bounds.minimum.x + u*(bounds.maximum.x-bounds.minimum.x), 100.0f, bounds.minimum.z + v*(bounds.maximum.z-bounds.minimum.z));
+
+		PxRaycastHit hitA, hitB;
+		const PxU32 nbA = PxGeometryQuery::raycast(origin, PxVec3(0.0f, -1.0f, 0.0f), PxTriangleMeshGeometry(const_cast<PxTriangleMesh*>(&a)), PxTransform(PxIdentity), 200.0f, PxHitFlag::eDEFAULT, 1, &hitA);
+		const PxU32 nbB = PxGeometryQuery::raycast(origin, PxVec3(0.0f, -1.0f, 0.0f), PxTriangleMeshGeometry(const_cast<PxTriangleMesh*>(&b)), PxTransform(PxIdentity), 200.0f, PxHitFlag::eDEFAULT, 1, &hitB);
+		if(nbA != nbB || (nbA && (hitA.distance != hitB.distance || hitA.faceIndex != hitB.faceIndex)))
+			nbMismatches++;
+	}
+	return nbMismatches;
+}
+
+static PxU32 compareHeightFields(const PxHeightField& a, const PxHeightField& b)
+{
+	PxU32 nbMismatches = 0;
+	for(PxU32 j=0;j<gTileResolution;j++)
+		for(PxU32 i=0;i<gTileResolution;i++)
+			if(a.getHeight(PxReal(i), PxReal(j)) != b.getHeight(PxReal(i), PxReal(j)))
+				nbMismatches++;
+	return nbMismatches;
+}
+
+static bool runPack(PxU32 nbTiles)
+{
+	const PxCookingParams params(gPhysics->getTolerancesScale());
+	PxSerializationRegistry* sr = PxSerialization::createSerializationRegistry(*gPhysics);
+
+	PxU32 nbMismatches = 0;
+	{
+		// source tiles and their cooked streams
+		PxArray<PxBase*> tiles;
+		PxArray<PxDefaultMemoryOutputStream*> cooked;
+		for(PxU32 i=0;i<nbTiles;i++)
+		{
+			cooked.pushBack(new PxDefaultMemoryOutputStream);
+			tiles.pushBack(createTile(i, params, *cooked.back()));
+		}
+		tiles.pushBack(createHeightField());
+
+		// loading from the cooked streams copies the mesh data into new allocations
+		PxU64 cookedSize = 0;
+		const PxU64 copyStart = SnippetUtils::getCurrentTimeCounterValue();
+		for(PxU32 i=0;i<nbTiles;i++)
+		{
+			PxDefaultMemoryInputData input(cooked[i]->getData(), cooked[i]->getSize());
+			gPhysics->createTriangleMesh(input)->release();
+			cookedSize += cooked[i]->getSize();
+		}
+		const PxReal copyTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - copyStart);
+
+		if(!writePack(tiles, *sr))
+		{
+			printf("Failed to write %s.\n", gPackName);
+			nbMismatches++;
+		}
+		else
+		{
+			PxDefaultMemoryMappedFile file(gPackName);
+			if(!file.isValid())
+			{
+				printf("Failed to map %s.\n", gPackName);
+				nbMismatches++;
+			}
+			else
+			{
+				PxArray<PxCollection*> collections;
+				const PxU8* data = reinterpret_cast<const PxU8*>(file.getData());
+				const PxU32 nb = *reinterpret_cast<const PxU32*>(data);
+				const PxU64* offsets = reinterpret_cast<const PxU64*>(data + sizeof(PxU32));
+
+				const PxU64 mapStart = SnippetUtils::getCurrentTimeCounterValue();
+				for(PxU32 i=0;i<nb;i++)
+					collections.pushBack(PxSerialization::createCollectionFromBinary(const_cast<PxU8*>(data) + offsets[i], *sr));
+				const PxReal mapTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - mapStart);
+
+				printf("%d tiles, %d KB cooked: cooked streams %.2f ms, mapped pack %.2f ms (%d KB)\n", nbTiles, PxU32(cookedSize/1024), double(copyTime), double(mapTime), PxU32(file.getSize()/1024));
+
+				for(PxU32 i=0;i<nb;i++)
+				{
+					PxBase& object = collections[i]->getObject(0);
+					if(i<nbTiles)
+						nbMismatches += compareMeshes(*tiles[i]->is<PxTriangleMesh>(), *object.is<PxTriangleMesh>(), file);
+					else
+						nbMismatches += compareHeightFields(*tiles[i]->is<PxHeightField>(), *object.is<PxHeightField>());
+				}
+
+				// the deserialized objects have to be released before the file is unmapped
+				for(PxU32 i=0;i<nb;i++)
+				{
+					PxCollectionExt::releaseObjects(*collections[i]);
+					collections[i]->release();
+				}
+			}
+		}
+
+		for(PxU32 i=0;i<tiles.size();i++)
+			tiles[i]->release();
+		for(PxU32 i=0;i<cooked.size();i++)
+			delete cooked[i];
+	}
+
+	remove(gPackName);
+	sr->release();
+
+	printf("Zero-copy loading: %s (%d mismatches)\n", nbMismatches ? "MISMATCH" : "ok", nbMismatches);
+	return nbMismatches == 0;
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+	printf("SnippetMappedMeshes done.\n");
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	const PxU32 nbTiles = argc > 1 ? PxU32(atoi(argv[1])) : 16;
+
+	initPhysics();
+	const bool success = runPack(nbTiles);
+	cleanupPhysics();
+	return success ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet cooks triangle meshes on CPU dispatchers with different numbers
+// of worker threads, using PxCookingParams::cpuDispatcher, and checks that the
+// cooked data is bit-identical to the data cooked without a dispatcher.
+//
+// The meshes are a regular-grid terrain, whose triangles have many identical
+// centers along each axis, and a noisy terrain. Both are cooked with the
+// default and the SAH BVH34 build strategies, and with GPU compatible data.
+// Cooking times are printed for each worker count.
+//
+// Usage: SnippetParallelCooking [maxNbThreads]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation	= NULL;
+
+static const PxU32	gGridResolution	= 129;	// two halves of 16384 triangles
+
+struct Terrain
+{
+	PxArray<PxVec3>	verts;
+	PxArray<PxU32>	indices;
+};
+
+static void createTerrain(Terrain& terrain, bool flat)
+{
+	SnippetUtils::BasicRandom random(42);
+	for(PxU32 j=0;j<gGridResolution;j++)
+		for(PxU32 i=0;i<gGridResolution;i++)
+		{
+			const PxReal height = flat ? 0.0f : random.rand(0.0f, 2.0f);
+			terrain.verts.pushBack(PxVec3(PxReal(i), height, PxReal(j)));
+		}
+
+	for(PxU32 j=0;j<gGridResolution-1;j++)
+		for(PxU32 i=0;i<gGridResolution-1;i++)
+		{
+			const PxU32 v = i+j*gGridResolution;
+			terrain.indices.pushBack(v);	terrain.indices.pushBack(v+gGridResolution);	terrain.indices.pushBack(v+1);
+			terrain.indices.pushBack(v+1);	terrain.indices.pushBack(v+gGridResolution);	terrain.indices.pushBack(v+gGridResolution+1);
+		}
+}
+
+// Returns the cooking time in milliseconds
+static PxReal cook(const Terrain& terrain, PxBVH34BuildStrategy::Enum strategy, bool gpuData, PxCpuDispatcher* dispatcher, PxDefaultMemoryOutputStream& cooked)
+{
+	PxCookingParams params((PxTolerancesScale()));
+	params.midphaseDesc.setToDefault(PxMeshMidPhase::eBVH34);
+	params.midphaseDesc.mBVH34Desc.buildStrategy = strategy;
+	params.buildGPUData = gpuData;
+	params.cpuDispatcher = dispatcher;
+
+	PxTriangleMeshDesc desc;
+	desc.points.count		= terrain.verts.size();
+	desc.points.stride		= sizeof(PxVec3);
+	desc.points.data		= terrain.verts.begin();
+	desc.triangles.count	= terrain.indices.size()/3;
+	desc.triangles.stride	= 3*sizeof(PxU32);
+	desc.triangles.data		= terrain.indices.begin();
+
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	PxCookTriangleMesh(params, desc, cooked);
+	return SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+}
+
+static bool runCooking(PxU32 maxNbThreads)
+{
+	const char* strategyNames[] = { "fast", "default", "SAH" };
+	const PxBVH34BuildStrategy::Enum strategies[] = { PxBVH34BuildStrategy::eDEFAULT, PxBVH34BuildStrategy::eSAH };
+
+	bool success = true;
+	for(PxU32 t=0;t<2;t++)
+	{
+		Terrain terrain;
+		createTerrain(terrain, t==0);
+
+		for(PxU32 s=0;s<2;s++)
+		{
+			for(PxU32 g=0;g<2;g++)
+			{
+				PxDefaultMemoryOutputStream reference;
+				const PxReal referenceMs = cook(terrain, strategies[s], g!=0, NULL, reference);
+				printf("%s terrain, %s strategy%s: no dispatcher %.2f ms", t==0 ? "Grid" : "Noisy", strategyNames[strategies[s]], g ? ", GPU data" : "", double(referenceMs));
+
+				for(PxU32 nbThreads=1;nbThreads<=maxNbThreads;nbThreads*=2)
+				{
+					PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+					PxDefaultMemoryOutputStream cooked;
+					const PxReal ms = cook(terrain, strategies[s], g!=0, dispatcher, cooked);
+					dispatcher->release();
+
+					const bool identical = cooked.getSize() == reference.getSize() && !memcmp(cooked.getData(), reference.getData(), reference.getSize());
+					printf(", %d threads %.2f ms%s", nbThreads, double(ms), identical ? "" : " (COOKED DATA MISMATCH)");
+					success &= identical;
+				}
+				printf("\n");
+			}
+		}
+	}
+	return success;
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	const PxU32 maxNbThreads = argc > 1 ? PxU32(atoi(argv[1])) : 8;
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	const bool success = runCooking(maxNbThreads);
+
+	PX_RELEASE(gFoundation);
+	printf("Cooked data bit-identical for all worker counts: %s\n", success ? "ok" : "MISMATCH");
+	printf("SnippetParallelCooking done.\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,356 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet checks and measures packet raycasts (PxScene::raycastPacket).
+//
+// The scene contains a regular-grid terrain and rocks made of triangle meshes,
+// some of them duplicated at the same pose to create equal-distance hits, plus
+// a few dynamic boxes. Lidar-like fans of rays are cast from several sensors,
+// once with raycastPacket() and once with one raycast() per ray, for closest
+// hits, any hits, and touching hits reported in a small touch buffer that
+// overflows. This is done with coherent packets (rays in lidar order) and with
+// incoherent ones (rays interleaved across sensors and directions). All
+// results must be identical, including the order of the touching hits. The
+// snippet prints the time taken by both versions.
+// ****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxScene*					gScene		= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32	gNbSensors			= 8;
+static const PxU32	gNbRaysPerSensor	= 2048;
+static const PxU32	gNbRays				= gNbSensors * gNbRaysPerSensor;
+static const PxU32	gNbTouchesPerRay	= 4;
+static const PxReal	gRayLength			= 200.0f;
+
+// Reports hits against odd actors as touching hits
+class TouchFilter : public PxQueryFilterCallback
+{
+public:
+	virtual PxQueryHitType::Enum preFilter(const PxFilterData&, const PxShape*, const PxRigidActor* actor, PxHitFlags&)
+	{
+		return (size_t(actor->userData) & 1) ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK;
+	}
+
+	virtual PxQueryHitType::Enum postFilter(const PxFilterData&, const PxQueryHit&, const PxShape*, const PxRigidActor*)
+	{
+		return PxQueryHitType::eBLOCK;
+	}
+};
+
+static PxTriangleMesh* createTerrainMesh(PxU32 nbCells, PxReal cellSize)
+{
+	const PxU32 nbVerts = (nbCells + 1) * (nbCells + 1);
+	PxArray<PxVec3> vertices(nbVerts);
+	for(PxU32 z=0; z<=nbCells; z++)
+		for(PxU32 x=0; x<=nbCells; x++)
+			vertices[z * (nbCells + 1) + x] = PxVec3(PxReal(x) * cellSize, PxSin(PxReal(x) * 0.3f) * PxCos(PxReal(z) * 0.2f), PxReal(z) * cellSize);
+
+	PxArray<PxU32> indices;
+	for(PxU32 z=0; z<nbCells; z++)
+	{
+		for(PxU32 x=0; x<nbCells; x++)
+		{
+			const PxU32 i0 = z * (nbCells + 1) + x;
+			const PxU32 i1 = i0 + 1;
+			const PxU32 i2 = i0 + nbCells + 1;
+			const PxU32 i3 = i2 + 1;
+			indices.pushBack(i0); indices.pushBack(i2); indices.pushBack(i1);
+			indices.pushBack(i1); indices.pushBack(i2); indices.pushBack(i3);
+		}
+	}
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count = vertices.size();
+	meshDesc.points.data = vertices.begin();
+	meshDesc.points.stride = sizeof(PxVec3);
+	meshDesc.triangles.count = indices.size() / 3;
+	meshDesc.triangles.data = indices.begin();
+	meshDesc.triangles.stride = 3 * sizeof(PxU32);
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	return PxCreateTriangleMesh(params, meshDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+// A rough rock: an icosphere-like mesh with perturbed vertices
+static PxTriangleMesh* createRockMesh(PxU32 seed)
+{
+	const PxU32 nbRings = 12;
+	const PxU32 nbSectors = 16;
+	PxArray<PxVec3> vertices;
+	for(PxU32 r=0; r<=nbRings; r++)
+	{
+		const PxReal theta = PxPi * PxReal(r) / PxReal(nbRings);
+		for(PxU32 s=0; s<nbSectors; s++)
+		{
+			const PxReal phi = PxTwoPi * PxReal(s) / PxReal(nbSectors);
+			const PxReal radius = 1.0f + 0.2f * PxSin(PxReal(seed + r * 7 + s * 3));
+			vertices.pushBack(PxVec3(PxSin(theta) * PxCos(phi), PxCos(theta), PxSin(theta) * PxSin(phi)) * radius);
+		}
+	}
+
+	PxArray<PxU32> indices;
+	for(PxU32 r=0; r<nbRings; r++)
+	{
+		for(PxU32 s=0; s<nbSectors; s++)
+		{
+			const PxU32 i0 = r * nbSectors + s;
+			const PxU32 i1 = r * nbSectors + (s + 1) % nbSectors;
+			const PxU32 i2 = i0 + nbSectors;
+			const PxU32 i3 = i1 + nbSectors;
+			indices.pushBack(i0); indices.pushBack(i1); indices.pushBack(i2);
+			indices.pushBack(i1); indices.pushBack(i3); indices.pushBack(i2);
+		}
+	}
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count = vertices.size();
+	meshDesc.points.data = vertices.begin();
+	meshDesc.points.stride = sizeof(PxVec3);
+	meshDesc.triangles.count = indices.size() / 3;
+	meshDesc.triangles.data = indices.begin();
+	meshDesc.triangles.stride = 3 * sizeof(PxU32);
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	return PxCreateTriangleMesh(params, meshDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+static void addActor(PxRigidActor* actor, PxU32& actorIndex)
+{
+	actor->userData = reinterpret_cast<void*>(size_t(actorIndex++));
+	gScene->addActor(*actor);
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	gDispatcher				= PxDefaultCpuDispatcherCreate(1);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	PxU32 actorIndex = 0;
+
+	// Terrain tiles, on a regular grid so that rays hit shared edges and vertices
+	PxTriangleMesh* terrain = createTerrainMesh(64, 1.0f);
+	for(PxU32 i=0; i<4; i++)
+	{
+		const PxTransform pose(PxVec3(PxReal(i & 1) * 64.0f - 64.0f, 0.0f, PxReal(i >> 1) * 64.0f - 64.0f));
+		addActor(PxCreateStatic(*gPhysics, pose, PxTriangleMeshGeometry(terrain), *gMaterial), actorIndex);
+	}
+	terrain->release();
+
+	// Rocks. One in three is duplicated at the same pose, giving hits at equal distances.
+	PxTriangleMesh* rocks[4];
+	for(PxU32 i=0; i<4; i++)
+		rocks[i] = createRockMesh(i * 13);
+	for(PxU32 i=0; i<300; i++)
+	{
+		const PxReal x = PxReal((i * 37) % 120) - 60.0f;
+		const PxReal z = PxReal((i * 53) % 120) - 60.0f;
+		const PxTransform pose(PxVec3(x, 1.5f, z), PxQuat(PxReal(i) * 0.1f, PxVec3(0.0f, 1.0f, 0.0f)));
+		const PxMeshScale scale(PxVec3(1.0f + PxReal(i % 3), 1.0f + PxReal(i % 2), 1.0f));
+		const PxTriangleMeshGeometry geom(rocks[i % 4], scale);
+		addActor(PxCreateStatic(*gPhysics, pose, geom, *gMaterial), actorIndex);
+		if(!(i % 3))
+			addActor(PxCreateStatic(*gPhysics, pose, geom, *gMaterial), actorIndex);
+	}
+	for(PxU32 i=0; i<4; i++)
+		rocks[i]->release();
+
+	// Dynamic boxes, for the dynamic pruner
+	for(PxU32 i=0; i<100; i++)
+	{
+		const PxReal x = PxReal((i * 29) % 100) - 50.0f;
+		const PxReal z = PxReal((i * 71) % 100) - 50.0f;
+		PxRigidDynamic* box = PxCreateDynamic(*gPhysics, PxTransform(PxVec3(x, 3.0f, z)), PxBoxGeometry(0.5f, 0.5f, 0.5f), *gMaterial, 1.0f);
+		box->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
+		addActor(box, actorIndex);
+	}
+
+	// PT: one step so that the pruning structures are built
+	gScene->simulate(1.0f/60.0f);
+	gScene->fetchResults(true);
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gScene);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetRaycastPacket done.\n");
+}
+
+// Lidar-like fans: each sensor sweeps its rays over 360 degrees horizontally and a few degrees vertically
+static void createRays(PxVec3* origins, PxVec3* dirs, PxReal* distances)
+{
+	const PxU32 nbRows = 16;
+	const PxU32 nbColumns = gNbRaysPerSensor / nbRows;
+	for(PxU32 s=0; s<gNbSensors; s++)
+	{
+		const PxVec3 sensor(PxReal(s % 4) * 30.0f - 45.0f, 4.0f, PxReal(s / 4) * 40.0f - 20.0f);
+		for(PxU32 i=0; i<gNbRaysPerSensor; i++)
+		{
+			const PxReal azimuth = PxTwoPi * PxReal(i / nbRows) / PxReal(nbColumns);
+			const PxReal elevation = -0.4f + 0.4f * PxReal(i % nbRows) / PxReal(nbRows);
+			const PxU32 index = s * gNbRaysPerSensor + i;
+			origins[index] = sensor;
+			dirs[index] = PxVec3(PxCos(azimuth) * PxCos(elevation), PxSin(elevation), PxSin(azimuth) * PxCos(elevation)).getNormalized();
+			distances[index] = gRayLength;
+		}
+	}
+}
+
+static bool sameHit(const PxRaycastHit& a, const PxRaycastHit& b)
+{
+	return a.actor == b.actor && a.shape == b.shape && a.faceIndex == b.faceIndex && a.flags == b.flags
+		&& !memcmp(&a.position, &b.position, sizeof(PxVec3)) && !memcmp(&a.normal, &b.normal, sizeof(PxVec3))
+		&& !memcmp(&a.distance, &b.distance, sizeof(PxReal));
+}
+
+static bool sameResults(const PxRaycastBuffer& a, const PxRaycastBuffer& b)
+{
+	if(a.hasBlock != b.hasBlock || a.nbTouches != b.nbTouches)
+		return false;
+	if(a.hasBlock && !sameHit(a.block, b.block))
+		return false;
+	for(PxU32 i=0; i<a.nbTouches; i++)
+		if(!sameHit(a.touches[i], b.touches[i]))
+			return false;
+	return true;
+}
+
+// Casts all rays with both methods, returns the number of rays whose results differ
+static PxU32 compare(const char* name, const PxVec3* origins, const PxVec3* dirs, const PxReal* distances,
+					const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, bool touches)
+{
+	PxArray<PxRaycastHit> touchBuffer0(touches ? gNbRays * gNbTouchesPerRay : 0);
+	PxArray<PxRaycastHit> touchBuffer1(touches ? gNbRays * gNbTouchesPerRay : 0);
+	PxArray<PxRaycastBuffer> buffers0(gNbRays);
+	PxArray<PxRaycastBuffer> buffers1(gNbRays);
+
+	PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0; i<gNbRays; i++)
+	{
+		if(touches)
+			buffers0[i] = PxRaycastBuffer(touchBuffer0.begin() + i * gNbTouchesPerRay, gNbTouchesPerRay);
+		gScene->raycast(origins[i], dirs[i], distances[i], buffers0[i], PxHitFlag::eDEFAULT, filterData, filterCall);
+	}
+	const PxU64 singleTime = SnippetUtils::getCurrentTimeCounterValue() - startTime;
+
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	if(touches)
+	{
+		for(PxU32 i=0; i<gNbRays; i++)
+			buffers1[i] = PxRaycastBuffer(touchBuffer1.begin() + i * gNbTouchesPerRay, gNbTouchesPerRay);
+	}
+	gScene->raycastPacket(gNbRays, origins, dirs, distances, buffers1.begin(), PxHitFlag::eDEFAULT, filterData, filterCall);
+	const PxU64 packetTime = SnippetUtils::getCurrentTimeCounterValue() - startTime;
+
+	PxU32 nbHits = 0;
+	PxU32 nbMismatches = 0;
+	for(PxU32 i=0; i<gNbRays; i++)
+	{
+		if(buffers0[i].hasAnyHits())
+			nbHits++;
+		if(!sameResults(buffers0[i], buffers1[i]))
+			nbMismatches++;
+	}
+
+	printf("  %-14s %6d rays, %6d with hits: raycast() %7.3f ms, raycastPacket() %7.3f ms, %d mismatches\n", name, gNbRays, nbHits,
+		double(SnippetUtils::getElapsedTimeInMilliseconds(singleTime)), double(SnippetUtils::getElapsedTimeInMilliseconds(packetTime)), nbMismatches);
+
+	return nbMismatches;
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+
+	PxU32 nbMismatches = 0;
+	{
+		PxArray<PxVec3> origins(gNbRays);
+		PxArray<PxVec3> dirs(gNbRays);
+		PxArray<PxReal> distances(gNbRays);
+		createRays(origins.begin(), dirs.begin(), distances.begin());
+
+		TouchFilter touchFilter;
+
+		for(PxU32 pass=0; pass<2; pass++)
+		{
+			printf(pass ? "Incoherent packets (rays from different sensors and directions):\n" : "Coherent packets (lidar order):\n");
+
+			nbMismatches += compare("closest hit", origins.begin(), dirs.begin(), distances.begin(), PxQueryFilterData(), NULL, false);
+			nbMismatches += compare("any hit", origins.begin(), dirs.begin(), distances.begin(), PxQueryFilterData(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::eANY_HIT), NULL, false);
+			nbMismatches += compare("touches", origins.begin(), dirs.begin(), distances.begin(), PxQueryFilterData(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER), &touchFilter, true);
+
+			// Interleave the rays so that each packet mixes sensors and directions. This checks that each ray still
+			// visits the scene in its own order when the rays of a packet disagree.
+			if(!pass)
+			{
+				PxArray<PxVec3> shuffledOrigins(gNbRays);
+				PxArray<PxVec3> shuffledDirs(gNbRays);
+				for(PxU32 i=0; i<gNbRays; i++)
+				{
+					const PxU32 j = (i * 2477) % gNbRays;
+					shuffledOrigins[i] = origins[j];
+					shuffledDirs[i] = dirs[j];
+				}
+				origins.swap(shuffledOrigins);
+				dirs.swap(shuffledDirs);
+			}
+		}
+	}
+
+	printf("packet results are %s\n", nbMismatches ? "DIFFERENT from raycast()" : "identical to raycast()");
+
+	cleanupPhysics();
+
+	return nbMismatches ? 1 : 0;
+}
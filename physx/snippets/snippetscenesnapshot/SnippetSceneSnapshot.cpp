@@ -0,0 +1,269 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+// ****************************************************************************
+// This snippet measures the cost of capturing and restoring scene snapshots.
+// It simulates columns of boxes, about 10000 in total, until they fall asleep,
+// and captures a full snapshot. One column out of ten is then pushed, and after
+// a few simulation steps a delta snapshot is captured against the full one.
+// The snippet measures full captures, delta captures, reproducible restores,
+// and restores of the changed bodies only. Times are printed per 10000 bodies.
+//
+// It also checks that the simulation is reproducible after a restore: the
+// scene is restored twice from the same snapshot and simulated for the same
+// number of steps, and the resulting poses are compared bitwise. One column
+// out of ten is put in an aggregate, and the snippet checks that reproducible
+// restores do not send lost touch reports for the reinserted bodies.
+//
+// Usage: SnippetSceneSnapshot [nbBodies]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+#include "../snippetcommon/SnippetPrint.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxScene*					gScene		= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32	gColumnHeight	= 4;
+static const PxU32	gNbWarmupSteps	= 300;
+static const PxU32	gNbDeltaSteps	= 10;
+static const PxU32	gNbRepeats		= 20;
+
+// Counts the lost touch reports
+class LostTouchCounter : public PxSimulationEventCallback
+{
+public:
+	LostTouchCounter() : mNbLostTouches(0)	{}
+
+	virtual void onContact(const PxContactPairHeader&, const PxContactPair* pairs, PxU32 nbPairs)
+	{
+		for(PxU32 i=0; i<nbPairs; i++)
+		{
+			if(pairs[i].events & PxPairFlag::eNOTIFY_TOUCH_LOST)
+				mNbLostTouches++;
+		}
+	}
+
+	virtual void onConstraintBreak(PxConstraintInfo*, PxU32)	{}
+	virtual void onWake(PxActor**, PxU32)						{}
+	virtual void onSleep(PxActor**, PxU32)						{}
+	virtual void onTrigger(PxTriggerPair*, PxU32)				{}
+	virtual void onAdvance(const PxRigidBody*const*, const PxTransform*, const PxU32)	{}
+
+	PxU32	mNbLostTouches;
+};
+
+static LostTouchCounter	gLostTouchCounter;
+
+static PxFilterFlags filterShader(	PxFilterObjectAttributes attributes0, PxFilterData filterData0,
+									PxFilterObjectAttributes attributes1, PxFilterData filterData1,
+									PxPairFlags& pairFlags, const void* constantBlock, PxU32 constantBlockSize)
+{
+	const PxFilterFlags filterFlags = PxDefaultSimulationFilterShader(attributes0, filterData0, attributes1, filterData1, pairFlags, constantBlock, constantBlockSize);
+	pairFlags |= PxPairFlag::eNOTIFY_TOUCH_LOST;
+	return filterFlags;
+}
+
+static void stepPhysics(PxU32 nbSteps)
+{
+	for(PxU32 i=0; i<nbSteps; ++i)
+	{
+		gScene->simulate(1.0f/60.0f);
+		gScene->fetchResults(true);
+	}
+}
+
+static void initPhysics(PxU32 nbBodies)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	gDispatcher				= PxDefaultCpuDispatcherCreate(2);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= filterShader;
+	sceneDesc.simulationEventCallback = &gLostTouchCounter;
+	sceneDesc.flags			|= PxSceneFlag::eENABLE_ENHANCED_DETERMINISM;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+	gScene->addActor(*PxCreatePlane(*gPhysics, PxPlane(0,1,0,0), *gMaterial));
+
+	// Columns of boxes, far enough apart that a column pushed over does not reach the next ones.
+	PxShape* shape = gPhysics->createShape(PxBoxGeometry(0.5f, 0.5f, 0.5f), *gMaterial);
+	const PxU32 nbColumns = (nbBodies + gColumnHeight - 1) / gColumnHeight;
+	const PxU32 nbColumnsPerRow = PxU32(PxSqrt(PxReal(nbColumns))) + 1;
+	PxU32 nbCreated = 0;
+	for(PxU32 c=0; c<nbColumns; c++)
+	{
+		const PxReal x = PxReal(c % nbColumnsPerRow) * 20.0f;
+		const PxReal z = PxReal(c / nbColumnsPerRow) * 20.0f;
+		PxAggregate* aggregate = (c % 10) == 5 ? gPhysics->createAggregate(gColumnHeight, gColumnHeight, true) : NULL;
+		for(PxU32 i=0; i<gColumnHeight && nbCreated<nbBodies; i++, nbCreated++)
+		{
+			PxRigidDynamic* body = gPhysics->createRigidDynamic(PxTransform(PxVec3(x, 0.5f + PxReal(i), z)));
+			body->attachShape(*shape);
+			PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+			if(aggregate)
+				aggregate->addActor(*body);
+			else
+				gScene->addActor(*body);
+		}
+		if(aggregate)
+			gScene->addAggregate(*aggregate);
+	}
+	shape->release();
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gScene);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetSceneSnapshot done.\n");
+}
+
+static void getBodies(PxArray<PxRigidDynamic*>& bodies)
+{
+	const PxU32 nbActors = gScene->getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+	bodies.resize(nbActors);
+	gScene->getActors(PxActorTypeFlag::eRIGID_DYNAMIC, reinterpret_cast<PxActor**>(bodies.begin()), nbActors);
+}
+
+// Pushes the top box of one column out of ten
+static void pushColumns()
+{
+	PxArray<PxRigidDynamic*> bodies;
+	getBodies(bodies);
+	for(PxU32 i=gColumnHeight-1; i<bodies.size(); i+=gColumnHeight*10)
+		bodies[i]->setLinearVelocity(PxVec3(5.0f, 0.0f, 0.0f));
+}
+
+static void getPoses(PxArray<PxTransform>& poses)
+{
+	PxArray<PxRigidDynamic*> bodies;
+	getBodies(bodies);
+	poses.resize(bodies.size());
+	for(PxU32 i=0; i<bodies.size(); i++)
+		poses[i] = bodies[i]->getGlobalPose();
+}
+
+// Returns the time in milliseconds, scaled to 10000 bodies
+static PxReal perTenThousandBodies(PxU64 elapsedTime, PxU32 nbRepeats, PxU32 nbBodies)
+{
+	return SnippetUtils::getElapsedTimeInMilliseconds(elapsedTime) / PxReal(nbRepeats) * 10000.0f / PxReal(nbBodies);
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	PxU32 nbBodies = 10000;
+	if(argc > 1)
+		nbBodies = PxU32(atoi(argv[1]));
+
+	initPhysics(nbBodies);
+	stepPhysics(gNbWarmupSteps);
+
+	PxSceneSnapshot* snapshot = gScene->createSnapshot();
+	PxSceneSnapshot* delta = gScene->createSnapshot();
+
+	// Full captures
+	PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0; i<gNbRepeats; i++)
+		snapshot->capture();
+	const PxReal fullCaptureTime = perTenThousandBodies(SnippetUtils::getCurrentTimeCounterValue() - startTime, gNbRepeats, nbBodies);
+
+	// Delta captures, after a few steps so that part of the scene has moved
+	pushColumns();
+	stepPhysics(gNbDeltaSteps);
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0; i<gNbRepeats; i++)
+		delta->capture(snapshot);
+	const PxReal deltaCaptureTime = perTenThousandBodies(SnippetUtils::getCurrentTimeCounterValue() - startTime, gNbRepeats, nbBodies);
+
+	// Reproducible restores. These reinsert all the bodies into the scene, whether they changed or not.
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0; i<gNbRepeats; i++)
+		snapshot->restore(true);
+	const PxReal reproducibleRestoreTime = perTenThousandBodies(SnippetUtils::getCurrentTimeCounterValue() - startTime, gNbRepeats, nbBodies);
+
+	// Restores of the changed bodies only, alternating between the two snapshots so that the moving bodies are written each time
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0; i<gNbRepeats; i++)
+		((i & 1) ? snapshot : delta)->restore();
+	const PxReal changedRestoreTime = perTenThousandBodies(SnippetUtils::getCurrentTimeCounterValue() - startTime, gNbRepeats, nbBodies);
+
+	printf("%d bodies, %d changed in the delta snapshot\n", nbBodies, delta->getNbStoredRigidDynamics());
+	printf("full snapshot: %d bytes, delta snapshot: %d bytes\n", snapshot->getMemoryUsage(), delta->getMemoryUsage());
+	printf("per 10000 bodies: full capture %.3f ms, delta capture %.3f ms, reproducible restore %.3f ms, restore of changed bodies %.3f ms\n",
+		double(fullCaptureTime), double(deltaCaptureTime), double(reproducibleRestoreTime), double(changedRestoreTime));
+
+	// Reproducibility: two runs from the same snapshot must give the same poses
+	{
+		PxArray<PxTransform> poses0, poses1;
+		snapshot->restore(true);
+		pushColumns();
+		stepPhysics(gNbDeltaSteps);
+		getPoses(poses0);
+		snapshot->restore(true);
+		pushColumns();
+		stepPhysics(gNbDeltaSteps);
+		getPoses(poses1);
+		const bool identical = poses0.size() == poses1.size() && !memcmp(poses0.begin(), poses1.begin(), poses0.size() * sizeof(PxTransform));
+		printf("resimulation from the snapshot is %s\n", identical ? "bit-identical" : "NOT bit-identical");
+	}
+
+	// Lost touch reports: the scene is at rest in the full snapshot, so restoring it and simulating one step must not lose any contact
+	{
+		snapshot->restore(true);
+		gLostTouchCounter.mNbLostTouches = 0;
+		stepPhysics(1);
+		printf("lost touch reports after a reproducible restore: %d\n", gLostTouchCounter.mNbLostTouches);
+	}
+
+	delta->release();
+	snapshot->release();
+
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,186 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet measures the PGS solver with and without the wide (AVX2 /
+// AVX-512) constraint batches, see PxSceneDesc::eDISABLE_WIDE_SOLVER_BATCHES.
+//
+// The scene contains pyramids of boxes (contact constraints) and chains of
+// capsules connected by spherical joints (1D constraints). The actors use a
+// large number of position iterations so that the solver dominates the frame
+// time. The scene is simulated twice, with and without wide batches, and the
+// final poses are checked to be the same in both runs.
+//
+// On CPUs without AVX2, both runs use the regular 4-wide batches.
+//
+// Usage: SnippetWideSolver [nbThreads]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32	gNbPyramids			= 16;
+static const PxU32	gPyramidSize		= 12;
+static const PxU32	gNbChains			= 64;
+static const PxU32	gChainLength		= 24;
+static const PxU32	gNbFrames			= 200;
+static const PxU32	gNbPosIterations	= 32;
+
+static SnippetUtils::BasicRandom gRandom(42);
+
+static PxRigidDynamic* createDynamic(PxScene* scene, const PxTransform& pose, const PxGeometry& geom)
+{
+	PxRigidDynamic* actor = PxCreateDynamic(*gPhysics, pose, geom, *gMaterial, 1.0f);
+	actor->setSolverIterationCounts(gNbPosIterations, 1);
+	scene->addActor(*actor);
+	return actor;
+}
+
+static void createPyramid(PxScene* scene, const PxVec3& pos, PxArray<PxRigidDynamic*>& actors)
+{
+	const PxReal halfExtent = 0.5f;
+	const PxBoxGeometry box(halfExtent, halfExtent, halfExtent);
+	for(PxU32 i=0; i<gPyramidSize; i++)
+	{
+		for(PxU32 j=0; j<gPyramidSize-i; j++)
+		{
+			const PxVec3 localPos(PxReal(j*2) - PxReal(gPyramidSize-i), PxReal(i*2+1), 0.0f);
+			actors.pushBack(createDynamic(scene, PxTransform(pos + localPos * halfExtent), box));
+		}
+	}
+}
+
+static void createChain(PxScene* scene, const PxVec3& pos, PxArray<PxRigidDynamic*>& actors)
+{
+	const PxReal halfLength = 0.3f;
+	const PxCapsuleGeometry capsule(0.1f, halfLength);
+	const PxReal separation = halfLength * 2.0f + 0.2f;
+	// the chains start horizontal, with a random direction, and swing down
+	const PxReal angle = gRandom.rand(0.0f, PxTwoPi);
+	const PxVec3 dir(PxCos(angle), 0.0f, PxSin(angle));
+	const PxQuat rot = PxShortestRotation(PxVec3(1.0f, 0.0f, 0.0f), dir);
+
+	PxRigidActor* prev = NULL;
+	for(PxU32 i=0; i<gChainLength; i++)
+	{
+		PxRigidDynamic* current = createDynamic(scene, PxTransform(pos + dir * (PxReal(i) * separation), rot), capsule);
+
+		const PxTransform localFrame0 = prev ? PxTransform(PxVec3(separation * 0.5f, 0.0f, 0.0f)) : PxTransform(pos - dir * (separation * 0.5f), rot);
+		PxSphericalJointCreate(*gPhysics, prev, localFrame0, current, PxTransform(PxVec3(-separation * 0.5f, 0.0f, 0.0f)));
+
+		actors.pushBack(current);
+		prev = current;
+	}
+}
+
+// Returns the simulation time in milliseconds
+static PxReal runBenchmark(bool wide, PxU32 nbThreads, PxArray<PxTransform>& poses)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+	sceneDesc.cpuDispatcher	= dispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	sceneDesc.solverType	= PxSolverType::ePGS;
+	if(!wide)
+		sceneDesc.flags |= PxSceneFlag::eDISABLE_WIDE_SOLVER_BATCHES;
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0, 1, 0, 0), *gMaterial);
+	scene->addActor(*groundPlane);
+
+	// same scene in both runs
+	gRandom.setSeed(1234);
+	PxArray<PxRigidDynamic*> actors;
+	for(PxU32 i=0; i<gNbPyramids; i++)
+		createPyramid(scene, PxVec3(PxReal(i%4)*16.0f - 24.0f, 0.0f, PxReal(i/4)*4.0f - 40.0f), actors);
+	for(PxU32 i=0; i<gNbChains; i++)
+		createChain(scene, PxVec3(PxReal(i%8)*8.0f - 28.0f, 20.0f, PxReal(i/8)*8.0f), actors);
+
+	PxU64 time = 0;
+	for(PxU32 frame=0; frame<gNbFrames; frame++)
+	{
+		const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		scene->simulate(1.0f/60.0f);
+		scene->fetchResults(true);
+		time += SnippetUtils::getCurrentTimeCounterValue() - startTime;
+	}
+
+	poses.clear();
+	for(PxU32 i=0; i<actors.size(); i++)
+		poses.pushBack(actors[i]->getGlobalPose());
+
+	PX_RELEASE(scene);
+	PX_RELEASE(dispatcher);
+
+	return SnippetUtils::getElapsedTimeInMilliseconds(time);
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	PxU32 nbThreads = 1;
+	if(argc > 1)
+		nbThreads = PxU32(atoi(argv[1]));
+
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	PxInitExtensions(*gPhysics, NULL);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+
+	{
+		PxArray<PxTransform> regularPoses, widePoses;
+		const PxReal regularMs = runBenchmark(false, nbThreads, regularPoses);
+		const PxReal wideMs = runBenchmark(true, nbThreads, widePoses);
+		const bool identical = regularPoses.size() == widePoses.size() && !memcmp(regularPoses.begin(), widePoses.begin(), sizeof(PxTransform)*regularPoses.size());
+
+		printf("\n%d boxes in %d pyramids, %d capsules in %d chains, %d position iterations, %d frames, %d threads\n",
+			gNbPyramids*gPyramidSize*(gPyramidSize+1)/2, gNbPyramids, gNbChains*gChainLength, gNbChains, gNbPosIterations, gNbFrames, nbThreads);
+		printf("%-12s | %10.2f ms | %8.3f ms/frame\n", "4-wide", double(regularMs), double(regularMs/PxReal(gNbFrames)));
+		printf("%-12s | %10.2f ms | %8.3f ms/frame | x%.2f%s\n", "wide", double(wideMs), double(wideMs/PxReal(gNbFrames)), double(regularMs/wideMs), identical ? "" : " (RESULTS MISMATCH)");
+	}
+
+	PX_RELEASE(gMaterial);
+	PxCloseExtensions();
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetWideSolver done.\n");
+
+	return 0;
+}
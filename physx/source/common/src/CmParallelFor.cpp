@@ -0,0 +1,152 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmParallelFor.h"
+#include "CmTask.h"
+
+using namespace physx;
+using namespace Cm;
+
+namespace
+{
+	class ParallelForTask;
+
+	// PT: shared by the calling thread and the tasks. It is ref-counted because tasks that have not started yet when all
+	// the work is done can still be sitting in the dispatcher's queues when parallelFor() returns.
+	struct ParallelForContext : public PxUserAllocated
+	{
+		ParallelForContext(ParallelForCallback callback, void* userData, PxU32 nbItems, PxU32 batchSize, PxU32 nbTasks) :
+			mCallback		(callback),
+			mUserData		(userData),
+			mNbItems		(nbItems),
+			mBatchSize		(batchSize),
+			mNbBatches		((nbItems + batchSize - 1)/batchSize),
+			mNextBatch		(0),
+			mNbDoneBatches	(0),
+			mRefCount		(PxI32(nbTasks + 1)),
+			mTasks			(NULL)
+		{
+		}
+
+		void	processBatches()
+		{
+			PxU32 nbDone = 0;
+			for(;;)
+			{
+				const PxU32 batch = PxU32(PxAtomicIncrement(&mNextBatch) - 1);
+				if(batch>=mNbBatches)
+					break;
+
+				const PxU32 start = batch * mBatchSize;
+				const PxU32 end = PxMin(start + mBatchSize, mNbItems);
+				(mCallback)(mUserData, start, end);
+				nbDone++;
+			}
+
+			if(nbDone && PxU32(PxAtomicAdd(&mNbDoneBatches, PxI32(nbDone)))==mNbBatches)
+				mDone.set();
+		}
+
+		void	releaseRef();
+
+		ParallelForCallback	mCallback;
+		void*				mUserData;
+		const PxU32			mNbItems;
+		const PxU32			mBatchSize;
+		const PxU32			mNbBatches;
+		volatile PxI32		mNextBatch;
+		volatile PxI32		mNbDoneBatches;
+		volatile PxI32		mRefCount;
+		PxSync				mDone;
+		ParallelForTask*	mTasks;
+	};
+
+	class ParallelForTask : public Cm::BaseTask, public PxUserAllocated
+	{
+	public:
+							ParallelForTask() : mContext(NULL)	{}
+
+		virtual void		runInternal()				PX_OVERRIDE	{ mContext->processBatches();	}
+		virtual const char*	getName()			const	PX_OVERRIDE	{ return "Cm.parallelFor";		}
+		virtual void		addReference()				PX_OVERRIDE	{}
+		virtual void		removeReference()			PX_OVERRIDE	{}
+		virtual int32_t		getReference()		const	PX_OVERRIDE	{ return 1;						}
+		virtual void		release()					PX_OVERRIDE	{ mContext->releaseRef();		}
+
+		ParallelForContext*	mContext;
+	};
+
+	void ParallelForContext::releaseRef()
+	{
+		if(!PxAtomicDecrement(&mRefCount))
+		{
+			PX_DELETE_ARRAY(mTasks);
+			ParallelForContext* context = this;
+			PX_DELETE(context);
+		}
+	}
+}
+
+void Cm::parallelFor(PxCpuDispatcher* dispatcher, PxU32 nbItems, PxU32 minBatchSize, ParallelForCallback callback, void* userData)
+{
+	if(!nbItems)
+		return;
+
+	minBatchSize = PxMax(minBatchSize, 1u);
+
+	const PxU32 nbWorkers = dispatcher ? dispatcher->getWorkerCount() : 0;
+	if(!nbWorkers || nbItems<minBatchSize*2)
+	{
+		(callback)(userData, 0, nbItems);
+		return;
+	}
+
+	// PT: a few batches per thread to balance the load, without going below the min batch size
+	const PxU32 nbThreads = nbWorkers + 1;
+	const PxU32 maxNbBatches = nbItems/minBatchSize;
+	const PxU32 nbBatches = PxMin(nbThreads*4, maxNbBatches);
+	const PxU32 batchSize = (nbItems + nbBatches - 1)/nbBatches;
+	const PxU32 nbTasks = PxMin(nbWorkers, nbBatches - 1);
+
+	ParallelForContext* context = PX_NEW(ParallelForContext)(callback, userData, nbItems, batchSize, nbTasks);
+	context->mTasks = PX_NEW(ParallelForTask)[nbTasks];
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		context->mTasks[i].mContext = context;
+		dispatcher->submitTask(context->mTasks[i]);
+	}
+
+	context->processBatches();
+	context->mDone.wait();
+	context->releaseRef();
+}
@@ -0,0 +1,53 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef CM_PARALLEL_FOR_H
+#define CM_PARALLEL_FOR_H
+
+#include "foundation/PxSimpleTypes.h"
+
+namespace physx
+{
+	class PxCpuDispatcher;
+
+namespace Cm
+{
+	// PT: processes the items in [start, end).
+	typedef void (*ParallelForCallback)(void* userData, PxU32 start, PxU32 end);
+
+	// PT: processes [0, nbItems) in batches of at least minBatchSize items, using the dispatcher's worker threads, and
+	// returns when all items have been processed. This is a blocking call meant for offline or one-shot work (e.g. cooking)
+	// that does not run inside the simulation's task graph. The calling thread processes batches as well, so it is safe to
+	// call this from a task running on the same dispatcher. Everything runs on the calling thread when the dispatcher is
+	// NULL or when there is not enough work to split. The callback must only write to outputs owned by its batch, so that
+	// the results do not depend on the number of threads.
+	void	parallelFor(PxCpuDispatcher* dispatcher, PxU32 nbItems, PxU32 minBatchSize, ParallelForCallback callback, void* userData);
+}
+}
+
+#endif
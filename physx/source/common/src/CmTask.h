@@ -87,12 +87,24 @@ namespace Cm
 		virtual void runInternal()=0;
 	};
 
+	// PT: optional hooks used to time the scene's pipeline stages. See Sc::PipelineTimer.
+	class TaskTimer
+	{
+	public:
+		virtual	void	taskReady(PxU32 stage)	= 0;	// a reference to the stage's task is about to be removed
+		virtual	void	taskStart(PxU32 stage)	= 0;
+		virtual	void	taskEnd(PxU32 stage)	= 0;
+		virtual	bool	isHighPriority(PxU32 stage)	const	= 0;
+	protected:
+		virtual			~TaskTimer()			{}
+	};
+
 	template <class T, void (T::*Fn)(physx::PxBaseTask*) >
 	class DelegateTask : public Cm::Task, public PxUserAllocated
 	{
 	public:
 
-		DelegateTask(PxU64 contextID, T* obj, const char* name) : Cm::Task(contextID), mObj(obj), mName(name) {}
+		DelegateTask(PxU64 contextID, T* obj, const char* name) : Cm::Task(contextID), mObj(obj), mName(name), mTimer(NULL), mTimerStage(0) {}
 
 		virtual void run()
 		{
@@ -101,7 +113,26 @@ namespace Cm
 #else
 			PX_SIMD_GUARD;
 #endif
-			(mObj->*Fn)(mCont);
+			if(mTimer)
+			{
+				mTimer->taskStart(mTimerStage);
+				(mObj->*Fn)(mCont);
+				mTimer->taskEnd(mTimerStage);
+			}
+			else
+				(mObj->*Fn)(mCont);
+		}
+
+		virtual void removeReference()	PX_OVERRIDE
+		{
+			if(mTimer)
+				mTimer->taskReady(mTimerStage);
+			Cm::Task::removeReference();
+		}
+
+		virtual bool isHighPriority() const	PX_OVERRIDE
+		{
+			return mTimer && mTimer->isHighPriority(mTimerStage);
 		}
 
 		virtual void runInternal()
@@ -116,9 +147,13 @@ namespace Cm
 
 		void setObject(T* obj) { mObj = obj; }
 
+		void setTimer(TaskTimer* timer, PxU32 stage) { mTimer = timer; mTimerStage = stage; }
+
 	private:
 		T* mObj;
 		const char* mName;
+		TaskTimer* mTimer;
+		PxU32 mTimerStage;
 	};
 
 
@@ -53,6 +53,8 @@ SET(LLAABB_SOURCE
 	${LLAABB_DIR}/src/BpBroadPhaseUpdate.cpp
 	${LLAABB_DIR}/src/BpBroadPhaseABP.cpp
 	${LLAABB_DIR}/src/BpBroadPhaseABP.h
+	${LLAABB_DIR}/src/BpBroadPhaseHGrid.cpp
+	${LLAABB_DIR}/src/BpBroadPhaseHGrid.h
 	${LLAABB_DIR}/src/BpBroadPhaseMBP.cpp
 	${LLAABB_DIR}/src/BpBroadPhaseMBP.h
 	${LLAABB_DIR}/src/BpBroadPhaseMBPCommon.h
@@ -88,6 +88,9 @@ SET(LLDYNAMICS_SOURCE
 	${LLDYNAMICS_BASE_DIR}/src/DyRigidBodyToSolverBody.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraints.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintsBlock.cpp
+	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintsBlock8.cpp
+	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintsBlock16.cpp
+	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintsBlockWide.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DySolverControl.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraint1DStep.h
 	${LLDYNAMICS_BASE_DIR}/src/DyThreadContext.cpp
@@ -114,6 +117,8 @@ SET(LLDYNAMICS_SOURCE
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraint1D.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraint1D4.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintDesc.h
+	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintsBlockWide.h
+	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintsBlockWideImpl.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintExtShared.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintsShared.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintTypes.h
@@ -95,6 +95,7 @@ SET(PHYSX_HEADERS
 	${PHYSX_ROOT_DIR}/include/PxSceneLock.h
 	${PHYSX_ROOT_DIR}/include/PxSceneQueryDesc.h
 	${PHYSX_ROOT_DIR}/include/PxSceneQuerySystem.h
+	${PHYSX_ROOT_DIR}/include/PxSceneSnapshot.h
 	${PHYSX_ROOT_DIR}/include/PxShape.h
 	${PHYSX_ROOT_DIR}/include/PxSimulationEventCallback.h
 	${PHYSX_ROOT_DIR}/include/PxSimulationStatistics.h
@@ -110,6 +111,7 @@ SET(PHYSX_HEADERS
 	${PHYSX_ROOT_DIR}/include/PxSDFBuilder.h
 	${PHYSX_ROOT_DIR}/include/PxResidual.h
 	${PHYSX_ROOT_DIR}/include/PxDirectGPUAPI.h
+	${PHYSX_ROOT_DIR}/include/PxDirectCPUAPI.h
     ${PHYSX_ROOT_DIR}/include/PxDeformableSkinning.h
 )
 
@@ -306,6 +308,10 @@ SET(PHYSX_CORE_SOURCE
 	${PX_SOURCE_DIR}/NpDebugViz.cpp
 	${PX_SOURCE_DIR}/NpDirectGPUAPI.h
 	${PX_SOURCE_DIR}/NpDirectGPUAPI.cpp
+	${PX_SOURCE_DIR}/NpDirectCPUAPI.h
+	${PX_SOURCE_DIR}/NpDirectCPUAPI.cpp
+	${PX_SOURCE_DIR}/NpSceneSnapshot.h
+	${PX_SOURCE_DIR}/NpSceneSnapshot.cpp
 )
 SOURCE_GROUP(src FILES ${PHYSX_CORE_SOURCE})
 
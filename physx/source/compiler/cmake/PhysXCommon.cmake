@@ -52,6 +52,8 @@ SET(PHYSX_COMMON_SOURCE
 	${COMMON_SRC_DIR}/CmFlushPool.h
 	${COMMON_SRC_DIR}/CmIDPool.h
 	${COMMON_SRC_DIR}/CmMatrix34.h
+	${COMMON_SRC_DIR}/CmParallelFor.h
+	${COMMON_SRC_DIR}/CmParallelFor.cpp
 	${COMMON_SRC_DIR}/CmPool.h
 	${COMMON_SRC_DIR}/CmPreallocatingPool.h
 	${COMMON_SRC_DIR}/CmPriorityQueue.h
@@ -583,6 +585,8 @@ SET(PHYSXCOMMON_GU_COOKING_SOURCE
 	${GU_SOURCE_DIR}/src/cooking/GuCookingConvexHullUtils.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingConvexHullLib.h
 	${GU_SOURCE_DIR}/src/cooking/GuCookingConvexHullLib.cpp
+	${GU_SOURCE_DIR}/src/cooking/GuCookingScratch.h
+	${GU_SOURCE_DIR}/src/cooking/GuCookingScratch.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingConvexHullBuilder.h
 	${GU_SOURCE_DIR}/src/cooking/GuCookingConvexHullBuilder.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingBigConvexDataBuilder.h
@@ -38,6 +38,8 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtBroadPhase.cpp
 	${LL_SOURCE_DIR}/ExtCollection.cpp
 	${LL_SOURCE_DIR}/ExtConvexMeshExt.cpp
+	${LL_SOURCE_DIR}/ExtCookingCache.cpp
+	${LL_SOURCE_DIR}/ExtCpuTopology.cpp
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.cpp
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.cpp
 	${LL_SOURCE_DIR}/ExtDefaultErrorCallback.cpp
@@ -64,6 +66,8 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtTriangleMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtTetrahedronMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtRemeshingExt.cpp
+	${LL_SOURCE_DIR}/ExtWorkStealingCpuDispatcher.cpp
+	${LL_SOURCE_DIR}/ExtCpuTopology.h
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.h
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.h
 	${LL_SOURCE_DIR}/ExtDefaultProfiler.h
@@ -73,6 +77,8 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtSerialization.h
 	${LL_SOURCE_DIR}/ExtSharedQueueEntryPool.h
 	${LL_SOURCE_DIR}/ExtTaskQueueHelper.h
+	${LL_SOURCE_DIR}/ExtWorkStealingCpuDispatcher.h
+	${LL_SOURCE_DIR}/ExtWorkStealingDeque.h
 	${LL_SOURCE_DIR}/ExtSampling.cpp
 	${LL_SOURCE_DIR}/ExtTetMakerExt.cpp
 	${LL_SOURCE_DIR}/ExtGjkQueryExt.cpp
@@ -172,6 +178,7 @@ SET(PHYSX_EXTENSIONS_HEADERS
 	${PHYSX_ROOT_DIR}/include/extensions/PxBroadPhaseExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCollectionExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxConvexMeshExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxCookingCache.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCudaHelpersExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultAllocator.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultCpuDispatcher.h
@@ -291,6 +298,7 @@ SOURCE_GROUP(serialization\\file FILES ${PHYSX_EXTENSIONS_SERIALIZATION_FILE_SOU
 
 SET(PHYSX_EXTENSIONS_SERIALIZATION_BINARY_SOURCE
 	${LL_SOURCE_DIR}/serialization/Binary/SnBinaryDeserialization.cpp
+	${LL_SOURCE_DIR}/serialization/Binary/SnBinaryDeltaSerialization.cpp
 	${LL_SOURCE_DIR}/serialization/Binary/SnBinarySerialization.cpp
 	${LL_SOURCE_DIR}/serialization/Binary/SnSerializationContext.cpp
 	${LL_SOURCE_DIR}/serialization/Binary/SnSerializationContext.h
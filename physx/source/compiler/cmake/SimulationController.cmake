@@ -145,6 +145,8 @@ SET(SIMULATIONCONTROLLER_SOURCE
 	${SIMULATIONCONTROLLER_BASE_DIR}/src/ScVisualize.cpp
 	${SIMULATIONCONTROLLER_BASE_DIR}/src/ScSleep.cpp
 	${SIMULATIONCONTROLLER_BASE_DIR}/src/ScPipeline.cpp
+	${SIMULATIONCONTROLLER_BASE_DIR}/src/ScPipelineTimer.cpp
+	${SIMULATIONCONTROLLER_BASE_DIR}/src/ScPipelineTimer.h
 )
 SOURCE_GROUP(src FILES ${SIMULATIONCONTROLLER_SOURCE})
 
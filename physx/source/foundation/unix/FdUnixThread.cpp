@@ -79,6 +79,7 @@ class ThreadImpl
 	pid_t tid;
 
 	uint32_t affinityMask;
+	PxThreadAffinityMask wideAffinityMask;
 	const char* name;
 };
 
@@ -140,6 +141,7 @@ PxThreadImpl::PxThreadImpl()
 	getThread(this)->fn = NULL;
 	getThread(this)->arg = NULL;
 	getThread(this)->affinityMask = 0;
+	getThread(this)->wideAffinityMask.clear();
 	getThread(this)->name = "set my name before starting me";
 }
 
@@ -153,6 +155,7 @@ PxThreadImpl::PxThreadImpl(PxThreadImpl::ExecuteFn fn, void* arg, const char* na
 	getThread(this)->fn = fn;
 	getThread(this)->arg = arg;
 	getThread(this)->affinityMask = 0;
+	getThread(this)->wideAffinityMask.clear();
 	getThread(this)->name = name;
 
 	start(0, NULL);
@@ -207,6 +210,8 @@ void PxThreadImpl::start(uint32_t stackSize, PxRunnable* runnable)
 	// apply stored affinity mask
 	if(getThread(this)->affinityMask)
 		setAffinityMask(getThread(this)->affinityMask);
+	if(!getThread(this)->wideAffinityMask.isEmpty())
+		setAffinityMask(getThread(this)->wideAffinityMask);
 
 	if (getThread(this)->name)
 		setName(getThread(this)->name);
@@ -302,6 +307,29 @@ uint32_t PxThreadImpl::setAffinityMask(uint32_t mask)
 	return uint32_t(prevMask);
 }
 
+bool PxThreadImpl::setAffinityMask(const PxThreadAffinityMask& mask)
+{
+	if(mask.isEmpty())
+		return false;
+
+	getThread(this)->wideAffinityMask = mask;
+
+	if(getThread(this)->state == ePxThreadStarted)
+	{
+#if PX_EMSCRIPTEN || PX_APPLE_FAMILY
+		// not supported
+		return false;
+#else
+		// the kernel accepts masks of any size as long as it is a multiple of sizeof(long)
+		const int32_t errSet = syscall(__NR_sched_setaffinity, getThread(this)->tid, sizeof(PxU64) * mask.getNbWords(), mask.mWords);
+		if(errSet != 0)
+			return false;
+#endif
+	}
+
+	return true;
+}
+
 void PxThreadImpl::setName(const char* name)
 {
 	getThread(this)->name = name;
@@ -57,6 +57,18 @@ static PxTime::Second getTimeSeconds()
 	return double(_tv.tv_sec) + double(_tv.tv_usec) * 0.000001;
 }
 
+PxU64 PxTime::getCurrentThreadCpuTimeInTensOfNanoSeconds()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+	struct timespec cpuTime;
+	if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime) != 0)
+		return 0;
+	return (static_cast<uint64_t>(cpuTime.tv_sec) * 100000000) + (static_cast<uint64_t>(cpuTime.tv_nsec) / 10);
+#else
+	return 0;
+#endif
+}
+
 PxTime::PxTime()
 {
 	mLastTime = getTimeSeconds();
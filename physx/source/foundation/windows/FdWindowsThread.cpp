@@ -31,6 +31,7 @@
 #include "foundation/PxAssert.h"
 #include "foundation/PxThread.h"
 #include "foundation/PxAlloca.h"
+#include "foundation/PxMemory.h"
 
 // an exception for setting the thread name in Microsoft debuggers
 #define NS_MS_VC_EXCEPTION 0x406D1388
@@ -77,6 +78,7 @@ class ThreadImpl
 	void* arg;
 
 	uint32_t affinityMask;
+	PxThreadAffinityMask wideAffinityMask;
 	const char* name;
 };
 
@@ -188,6 +190,7 @@ PxThreadImpl::PxThreadImpl()
 	getThread(this)->fn = NULL;
 	getThread(this)->arg = NULL;
 	getThread(this)->affinityMask = 0;
+	getThread(this)->wideAffinityMask.clear();
 	getThread(this)->name = NULL;
 }
 
@@ -199,6 +202,7 @@ PxThreadImpl::PxThreadImpl(ExecuteFn fn, void* arg, const char* name)
 	getThread(this)->fn = fn;
 	getThread(this)->arg = arg;
 	getThread(this)->affinityMask = 0;
+	getThread(this)->wideAffinityMask.clear();
 	getThread(this)->name = name;
 
 	start(0, NULL);
@@ -232,6 +236,8 @@ void PxThreadImpl::start(uint32_t stackSize, PxRunnable* runnable)
 	// set affinity, set name and resume
 	if(getThread(this)->affinityMask)
 		setAffinityMask(getThread(this)->affinityMask);
+	if(!getThread(this)->wideAffinityMask.isEmpty())
+		setAffinityMask(getThread(this)->wideAffinityMask);
 
 	if (getThread(this)->name)
 		setName(getThread(this)->name);
@@ -311,6 +317,34 @@ uint32_t PxThreadImpl::setAffinityMask(uint32_t mask)
 	return 0;
 }
 
+bool PxThreadImpl::setAffinityMask(const PxThreadAffinityMask& mask)
+{
+	if(mask.isEmpty())
+		return false;
+
+	// store affinity
+	getThread(this)->wideAffinityMask = mask;
+
+	// if thread already started apply immediately
+	if(getThread(this)->state == ThreadImpl::Started)
+	{
+		// a thread can only run within one processor group, use the first one of the mask
+		for(PxU32 group=0; group<PX_MAX_NB_THREAD_AFFINITY_WORDS; group++)
+		{
+			if(mask.mWords[group])
+			{
+				GROUP_AFFINITY affinity;
+				PxMemZero(&affinity, sizeof(affinity));
+				affinity.Mask = KAFFINITY(mask.mWords[group]);
+				affinity.Group = WORD(group);
+				return SetThreadGroupAffinity(getThread(this)->thread, &affinity, NULL) != 0;
+			}
+		}
+	}
+
+	return true;
+}
+
 void PxThreadImpl::setName(const char* name)
 {
 	getThread(this)->name = name;
@@ -68,6 +68,18 @@ uint64_t PxTime::getCurrentCounterValue()
 	return (uint64_t)ticks.QuadPart;
 }
 
+PxU64 PxTime::getCurrentThreadCpuTimeInTensOfNanoSeconds()
+{
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if(!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+		return 0;
+
+	// FILETIME values are in units of 100 nanoseconds
+	const uint64_t kernel = (uint64_t(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+	const uint64_t user = (uint64_t(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+	return (kernel + user) * 10;
+}
+
 PxTime::PxTime() : mTickCount(0)
 {
 	getElapsedSeconds();
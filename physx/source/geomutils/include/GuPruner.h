@@ -31,6 +31,7 @@
 
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxTransform.h"
+#include "foundation/PxBitUtils.h"
 #include "GuPrunerPayload.h"
 #include "GuPrunerTypedef.h"
 
@@ -156,6 +157,37 @@ namespace Gu
 		virtual	bool					overlap(const Gu::ShapeData& queryVolume, PrunerOverlapCallback&) const = 0;
 		virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const = 0;
 
+		/**
+		\brief	Raycasts a packet of rays.
+
+		This is equivalent to calling raycast() for each ray whose bit is set in 'activeMask', with its own distance and callback.
+		Implementations can share the traversal of their acceleration structure between the rays of the packet. The default
+		implementation simply processes the rays one by one.
+
+		\param[in]		nbRays			Number of rays in the packet, at most RAYCAST_PACKET_MAX_SIZE
+		\param[in]		origins			Ray origins
+		\param[in]		unitDirs		Normalized ray directions
+		\param[in,out]	inOutDistances	Max distance for each ray, shrunk by the callbacks as hits are found
+		\param[in]		pcbs			Per-ray callbacks
+		\param[in]		activeMask		Mask of rays to process
+
+		\return	The subset of 'activeMask' for which the query should continue, i.e. rays that were not aborted by their callback.
+		*/
+		virtual	PxU32					raycastPacket(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerRaycastCallback* const* pcbs, PxU32 activeMask) const
+		{
+			PX_ASSERT(nbRays<=RAYCAST_PACKET_MAX_SIZE);
+			PX_UNUSED(nbRays);
+			PxU32 outMask = activeMask;
+			while(activeMask)
+			{
+				const PxU32 rayIndex = PxLowestSetBit(activeMask);
+				activeMask &= activeMask - 1;
+				if(!raycast(origins[rayIndex], unitDirs[rayIndex], inOutDistances[rayIndex], *pcbs[rayIndex]))
+					outMask &= ~(1u<<rayIndex);
+			}
+			return outMask;
+		}
+
 		/**
 		\brief	Retrieves the object's payload and data associated with the handle.
 
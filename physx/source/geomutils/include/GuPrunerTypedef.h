@@ -44,6 +44,9 @@ namespace physx
 		typedef PxU32 TreeNodeIndex;
 		static const PxU32 INVALID_NODE_ID = 0xffffffff;
 
+		// PT: max number of rays in a raycast packet, see Pruner::raycastPacket
+		static const PxU32 RAYCAST_PACKET_MAX_SIZE = 16;
+
 		enum CompanionPrunerType
 		{
 			COMPANION_PRUNER_NONE,
@@ -312,6 +312,33 @@ bool AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& in
 	return again;
 }
 
+PxU32 AABBPruner::raycastPacket(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerRaycastCallback* const* pcbs, PxU32 activeMask) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+	PX_ASSERT(nbRays<=RAYCAST_PACKET_MAX_SIZE);
+
+	if(mAABBTree && activeMask)
+	{
+		RaycastPacketCallbackAdapter pcb(pcbs, mPool);
+		activeMask = AABBTreeRaycastPacket<true, AABBTree, BVHNode, RaycastPacketCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, nbRays, origins, unitDirs, inOutDistances, activeMask, pcb);
+	}
+
+	// PT: the bucket pruner only contains the few objects added since the last rebuild, so we just use per-ray queries there
+	if(activeMask && mIncrementalRebuild && mBucketPruner.getNbObjects())
+	{
+		PxU32 mask = activeMask;
+		while(mask)
+		{
+			const PxU32 rayIndex = PxLowestSetBit(mask);
+			mask &= mask - 1;
+			if(!mBucketPruner.raycast(origins[rayIndex], unitDirs[rayIndex], inOutDistances[rayIndex], *pcbs[rayIndex]))
+				activeMask &= ~(1u<<rayIndex);
+		}
+	}
+
+	return activeMask;
+}
+
 // This isn't part of the pruner virtual interface, but it is part of the public interface
 // of AABBPruner - it gets called by SqManager to force a rebuild, and requires a commit() before 
 // queries can take place
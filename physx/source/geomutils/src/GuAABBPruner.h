@@ -136,6 +136,7 @@ namespace Gu
 		// Pruner
 												DECLARE_PRUNER_API_COMMON
 		virtual			bool					isDynamic()			const		{ return mIncrementalRebuild;	}
+		virtual			PxU32					raycastPacket(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerRaycastCallback* const* pcbs, PxU32 activeMask) const;
 		//~Pruner
 
 		// DynamicPruner
@@ -33,6 +33,7 @@
 #include "GuAABBTreeBounds.h"
 #include "foundation/PxInlineArray.h"
 #include "GuAABBTreeNode.h"
+#include "foundation/PxBitUtils.h"
 
 namespace physx
 {
@@ -188,6 +189,63 @@ namespace physx
 
 		//////////////////////////////////////////////////////////////////////////
 
+		// PT: single-ray traversal of the subtree rooted at 'root'. This is the core of AABBTreeRaycast, also used by
+		// AABBTreeRaycastPacket once only one ray of the packet remains in a subtree.
+		template <const bool tInflate, const bool tHasIndices, typename Node, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
+		static PX_FORCE_INLINE bool doRaycastTraversal(	const Node* root, const Node* const nodeBase, const PxBounds3* bounds, const PxU32* indices,
+														Gu::RayAABBTest& test, PxReal& maxDist, QueryCallback& pcb)
+		{
+			PxInlineArray<const Node*, RAW_TRAVERSAL_STACK_SIZE> stack;
+			stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+			stack[0] = root;
+			PxU32 stackIndex = 1;
+
+			while(stackIndex--)
+			{
+				const Node* node = stack[stackIndex];
+				Vec3V center, extents;
+				node->getAABBCenterExtentsV2(&center, &extents);
+				if(test.check<tInflate>(center, extents))	// TODO: try timestamp ray shortening to skip this
+				{
+					while(!node->isLeaf())
+					{
+						const Node* children = node->getPos(nodeBase);
+
+						Vec3V c0, e0;
+						children[0].getAABBCenterExtentsV2(&c0, &e0);
+						const PxU32 b0 = test.check<tInflate>(c0, e0);
+
+						Vec3V c1, e1;
+						children[1].getAABBCenterExtentsV2(&c1, &e1);
+						const PxU32 b1 = test.check<tInflate>(c1, e1);
+
+						if(b0 && b1)	// if both intersect, push the one with the further center on the stack for later
+						{
+							// & 1 because FAllGrtr behavior differs across platforms
+							const PxU32 bit = FAllGrtr(V3Dot(V3Sub(c1, c0), test.mDir), FZero()) & 1;
+							stack[stackIndex++] = children + bit;
+							node = children + (1 - bit);
+							if(stackIndex == stack.capacity())
+								stack.resizeUninitialized(stack.capacity() * 2);
+						}
+						else if(b0)
+							node = children;
+						else if(b1)
+							node = children + 1;
+						else
+							goto skip_leaf_code;
+					}
+
+					if(!doLeafTest<tInflate, tHasIndices, Node>(node, test, bounds, indices, maxDist, pcb))
+						return false;
+				skip_leaf_code:;
+				}
+			}
+			return true;
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+
 		template <const bool tInflate, const bool tHasIndices, typename Tree, typename Node, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
 		class AABBTreeRaycast
 		{
@@ -197,63 +255,200 @@ namespace physx
 				const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation,
 				QueryCallback& pcb)
 			{
-				const PxBounds3* bounds = treeBounds.getBounds();
-
 				// PT: we will pass center*2 and extents*2 to the ray-box code, to save some work per-box
 				// So we initialize the test with values multiplied by 2 as well, to get correct results
 				Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, maxDist, inflation*2.0f);
 
+				const Node* const nodeBase = tree.getNodes();
+				return doRaycastTraversal<tInflate, tHasIndices, Node>(nodeBase, nodeBase, treeBounds.getBounds(), tree.getIndices(), test, maxDist, pcb);
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// PT: binds a ray index to a packet callback, for the single-ray fallback of AABBTreeRaycastPacket
+		template<typename QueryCallback>
+		struct RaycastPacketRayCallback
+		{
+			PX_FORCE_INLINE	RaycastPacketRayCallback(QueryCallback& pcb, PxU32 rayIndex) : mCallback(pcb), mRayIndex(rayIndex)	{}
+
+			PX_FORCE_INLINE bool	invoke(PxReal& distance, PxU32 primIndex)
+			{
+				return mCallback.invoke(mRayIndex, distance, primIndex);
+			}
+
+			QueryCallback&	mCallback;
+			const PxU32		mRayIndex;
+			PX_NOCOPY(RaycastPacketRayCallback)
+		};
+
+		// PT: raycasts a packet of up to RAYCAST_PACKET_MAX_SIZE rays against the tree. The packet is traversed with one
+		// SoA ray-box test per node, each ray getting its own stack mask. Each ray visits the nodes in the order it would
+		// with AABBTreeRaycast, so the callback sees the same primitives in the same order. As soon as a subtree is only
+		// touched by a single ray we switch to the regular single-ray traversal for it. The callback is called as pcb.invoke(rayIndex, distance, primIndex),
+		// with the same contract as for AABBTreeRaycast. Returns the subset of 'activeMask' whose rays were not aborted by the callback.
+		template <const bool tHasIndices, typename Tree, typename Node, typename QueryCallback>
+		class AABBTreeRaycastPacket
+		{
+		public:
+			PxU32 operator()(
+				const AABBTreeBounds& treeBounds, const Tree& tree,
+				PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* maxDists, PxU32 activeMask,
+				QueryCallback& pcb)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+
+				// PT: same times-two trick as in AABBTreeRaycast
+				RayPacketAABBTest test(nbRays, origins, unitDirs, maxDists);
+
 				PxInlineArray<const Node*, RAW_TRAVERSAL_STACK_SIZE> stack;
+				PxInlineArray<PxU32, RAW_TRAVERSAL_STACK_SIZE> stackMasks;
 				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stackMasks.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
 				const Node* const nodeBase = tree.getNodes();
 				stack[0] = nodeBase;
+				stackMasks[0] = activeMask;
 				PxU32 stackIndex = 1;
 
-				while(stackIndex--)
+				while(activeMask && stackIndex--)
 				{
 					const Node* node = stack[stackIndex];
+					PxU32 mask = stackMasks[stackIndex] & activeMask;
+					if(!mask)
+						continue;
+
 					Vec3V center, extents;
 					node->getAABBCenterExtentsV2(&center, &extents);
-					if(test.check<tInflate>(center, extents))	// TODO: try timestamp ray shortening to skip this
+					mask = test.check(center, extents, mask);
+
+					// PT: descend while at least two rays remain
+					while((mask & (mask - 1)) && !node->isLeaf())
 					{
-						while(!node->isLeaf())
-						{
-							const Node* children = node->getPos(nodeBase);
+						const Node* children = node->getPos(nodeBase);
 
-							Vec3V c0, e0;
-							children[0].getAABBCenterExtentsV2(&c0, &e0);
-							const PxU32 b0 = test.check<tInflate>(c0, e0);
+						Vec3V c0, e0;
+						children[0].getAABBCenterExtentsV2(&c0, &e0);
+						const PxU32 m0 = test.check(c0, e0, mask);
 
-							Vec3V c1, e1;
-							children[1].getAABBCenterExtentsV2(&c1, &e1);
-							const PxU32 b1 = test.check<tInflate>(c1, e1);
+						Vec3V c1, e1;
+						children[1].getAABBCenterExtentsV2(&c1, &e1);
+						const PxU32 m1 = test.check(c1, e1, mask);
 
-							if(b0 && b1)	// if both intersect, push the one with the further center on the stack for later
+						if(m0 && m1)
+						{
+							// PT: each ray visits the children in the same order as with a single-ray traversal, i.e. the one
+							// with the closer center first. Rays touching both children that see child 0 first visit it now and
+							// child 1 from the stack, the other ones visit child 1 from the stack and then child 0 from the stack.
+							// That way the leaves are visited in the same order as with raycast() for each ray.
+							const Vec3V delta = V3Sub(c1, c0);
+							PxU32 first0 = 0;
+							PxU32 both = m0 & m1;
+							while(both)
 							{
+								const PxU32 rayIndex = PxLowestSetBit(both);
+								both &= both - 1;
 								// & 1 because FAllGrtr behavior differs across platforms
-								const PxU32 bit = FAllGrtr(V3Dot(V3Sub(c1, c0), test.mDir), FZero()) & 1;
-								stack[stackIndex++] = children + bit;
-								node = children + (1 - bit);
-								if(stackIndex == stack.capacity())
-									stack.resizeUninitialized(stack.capacity() * 2);
+								first0 |= (FAllGrtr(V3Dot(delta, V3LoadU(unitDirs[rayIndex]*2.0f)), FZero()) & 1) << rayIndex;
+							}
+							const PxU32 first1 = m0 & m1 & ~first0;
+
+							if(stackIndex + 2 > stack.capacity())
+							{
+								stack.resizeUninitialized(stack.capacity() * 2);
+								stackMasks.resizeUninitialized(stackMasks.capacity() * 2);
+							}
+
+							if(first1)
+							{
+								stack[stackIndex] = children;
+								stackMasks[stackIndex++] = first1;
 							}
-							else if(b0)
+
+							const PxU32 now0 = m0 & ~first1;
+							if(now0)
+							{
+								stack[stackIndex] = children + 1;
+								stackMasks[stackIndex++] = m1;
 								node = children;
-							else if(b1)
-								node = children + 1;
+								mask = now0;
+							}
 							else
-								goto skip_leaf_code;
+							{
+								node = children + 1;
+								mask = m1;
+							}
+						}
+						else if(m0)
+						{
+							node = children;
+							mask = m0;
+						}
+						else
+						{
+							node = children + 1;
+							mask = m1;	// possibly zero
 						}
+					}
+
+					if(!mask)
+						continue;
+
+					if(!(mask & (mask - 1)))
+					{
+						// PT: the packet diverged, only one ray left in this subtree
+						const PxU32 rayIndex = PxLowestSetBit(mask);
+						Gu::RayAABBTest rayTest(origins[rayIndex]*2.0f, unitDirs[rayIndex]*2.0f, maxDists[rayIndex], PxVec3(0.0f));
+						RaycastPacketRayCallback<QueryCallback> rayCallback(pcb, rayIndex);
+						if(!doRaycastTraversal<false, tHasIndices, Node>(node, nodeBase, bounds, indices, rayTest, maxDists[rayIndex], rayCallback))
+							activeMask &= ~mask;
+						else
+							test.setDistance(rayIndex, maxDists[rayIndex]);
+						continue;
+					}
+
+					// PT: packet leaf test, see doLeafTest for the single-ray version & the reason for 'oldMaxDist'
+					PxU32 nbPrims = node->getNbPrimitives();
+					const bool doBoxTest = nbPrims > 1;
+					const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+					while(nbPrims--)
+					{
+						const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+
+						PxU32 hitMask = mask & activeMask;
+						if(doBoxTest)
+						{
+							Vec4V center_, extents_;
+							getBoundsTimesTwo(center_, extents_, bounds, primIndex);
+							hitMask = test.check(Vec3V_From_Vec4V(center_), Vec3V_From_Vec4V(extents_), hitMask);
+						}
+
+						while(hitMask)
+						{
+							const PxU32 rayIndex = PxLowestSetBit(hitMask);
+							hitMask &= hitMask - 1;
+
+							const PxReal oldMaxDist = maxDists[rayIndex];
+							PxReal md = oldMaxDist;
+							if(!pcb.invoke(rayIndex, md, primIndex))
+							{
+								activeMask &= ~(1u<<rayIndex);
+								continue;
+							}
 
-						if(!doLeafTest<tInflate, tHasIndices, Node>(node, test, bounds, tree.getIndices(), maxDist, pcb))
-							return false;
-					skip_leaf_code:;
+							if(md < oldMaxDist)
+							{
+								maxDists[rayIndex] = md;
+								test.setDistance(rayIndex, md);
+							}
+						}
 					}
 				}
-				return true;
+				return activeMask;
 			}
 		};
 
+		//////////////////////////////////////////////////////////////////////////
 
 		struct TraversalControl
 		{
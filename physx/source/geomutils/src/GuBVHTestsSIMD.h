@@ -35,6 +35,7 @@
 #include "geometry/PxSphereGeometry.h"
 #include "geometry/PxCapsuleGeometry.h"
 #include "foundation/PxVecMath.h"
+#include "GuPrunerTypedef.h"
 
 namespace physx
 {
@@ -99,6 +100,108 @@ protected:
 	RayAABBTest& operator=(const RayAABBTest&);
 };
 
+// PT: SoA version of RayAABBTest for packets of up to RAYCAST_PACKET_MAX_SIZE rays, processed 4 at a time. Each ray
+// goes through the exact same segment-vs-box test as with RayAABBTest, so a packet visits the same nodes as the
+// individual rays would. Only the raycast version is provided (no inflation).
+struct RayPacketAABBTest
+{
+	RayPacketAABBTest(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* maxDists) : mNbGroups((nbRays+3)>>2)
+	{
+		PX_ASSERT(nbRays && nbRays<=RAYCAST_PACKET_MAX_SIZE);
+		for(PxU32 i=0;i<RAYCAST_PACKET_MAX_SIZE;i++)
+		{
+			// PT: unused lanes get a degenerate ray at the origin. They are masked out anyway.
+			const PxVec3 origin = i<nbRays ? origins[i]*2.0f : PxVec3(0.0f);
+			const PxVec3 dir = i<nbRays ? unitDirs[i]*2.0f : PxVec3(0.0f);
+			for(PxU32 j=0;j<3;j++)
+			{
+				mOrigin[j][i] = origin[j];
+				mDir[j][i] = dir[j];
+				mAbsDir[j][i] = PxAbs(dir[j]);
+			}
+
+			if(i<nbRays && maxDists[i] >= PX_MAX_F32)
+			{
+				for(PxU32 j=0;j<3;j++)
+				{
+					const PxReal ext = dir[j] == 0.0f ? origin[j] : PxSign(dir[j])*PX_MAX_F32;
+					mRayMin[j][i] = PxMin(origin[j], ext);
+					mRayMax[j][i] = PxMax(origin[j], ext);
+				}
+			}
+			else
+				setDistance(i, i<nbRays ? maxDists[i] : 0.0f);
+		}
+	}
+
+	PX_FORCE_INLINE void setDistance(PxU32 rayIndex, PxReal distance)
+	{
+		for(PxU32 j=0;j<3;j++)
+		{
+			const PxReal ext = mOrigin[j][rayIndex] + mDir[j][rayIndex] * distance;
+			mRayMin[j][rayIndex] = PxMin(mOrigin[j][rayIndex], ext);
+			mRayMax[j][rayIndex] = PxMax(mOrigin[j][rayIndex], ext);
+		}
+	}
+
+	// PT: returns the subset of 'rayMask' whose rays touch the box
+	PX_FORCE_INLINE PxU32 check(const Vec3V center, const Vec3V extents, PxU32 rayMask) const
+	{
+		const Vec4V center4 = Vec4V_From_Vec3V(center);
+		const Vec4V extents4 = Vec4V_From_Vec3V(extents);
+		const Vec4V cx = V4SplatElement<0>(center4);
+		const Vec4V cy = V4SplatElement<1>(center4);
+		const Vec4V cz = V4SplatElement<2>(center4);
+		const Vec4V ex = V4SplatElement<0>(extents4);
+		const Vec4V ey = V4SplatElement<1>(extents4);
+		const Vec4V ez = V4SplatElement<2>(extents4);
+
+		PxU32 hitMask = 0;
+		for(PxU32 g=0;g<mNbGroups;g++)
+		{
+			const PxU32 offset = g*4;
+			if(!((rayMask>>offset) & 15))
+				continue;
+
+			// coordinate axes
+			BoolV mask = BAnd(V4IsGrtrOrEq(V4Add(cx, ex), V4LoadA(&mRayMin[0][offset])), V4IsGrtrOrEq(V4LoadA(&mRayMax[0][offset]), V4Sub(cx, ex)));
+			mask = BAnd(mask, BAnd(V4IsGrtrOrEq(V4Add(cy, ey), V4LoadA(&mRayMin[1][offset])), V4IsGrtrOrEq(V4LoadA(&mRayMax[1][offset]), V4Sub(cy, ey))));
+			mask = BAnd(mask, BAnd(V4IsGrtrOrEq(V4Add(cz, ez), V4LoadA(&mRayMin[2][offset])), V4IsGrtrOrEq(V4LoadA(&mRayMax[2][offset]), V4Sub(cz, ez))));
+
+			// cross axes
+			const Vec4V dx = V4LoadA(&mDir[0][offset]);
+			const Vec4V dy = V4LoadA(&mDir[1][offset]);
+			const Vec4V dz = V4LoadA(&mDir[2][offset]);
+			const Vec4V adx = V4LoadA(&mAbsDir[0][offset]);
+			const Vec4V ady = V4LoadA(&mAbsDir[1][offset]);
+			const Vec4V adz = V4LoadA(&mAbsDir[2][offset]);
+			const Vec4V ox = V4Sub(V4LoadA(&mOrigin[0][offset]), cx);
+			const Vec4V oy = V4Sub(V4LoadA(&mOrigin[1][offset]), cy);
+			const Vec4V oz = V4Sub(V4LoadA(&mOrigin[2][offset]), cz);
+
+			const Vec4V fx = V4NegMulSub(dy, ox, V4Mul(dx, oy));
+			const Vec4V fy = V4NegMulSub(dz, oy, V4Mul(dy, oz));
+			const Vec4V fz = V4NegMulSub(dx, oz, V4Mul(dz, ox));
+			const Vec4V gx = V4MulAdd(ex, ady, V4Mul(ey, adx));
+			const Vec4V gy = V4MulAdd(ey, adz, V4Mul(ez, ady));
+			const Vec4V gz = V4MulAdd(ez, adx, V4Mul(ex, adz));
+			mask = BAnd(mask, BAnd(V4IsGrtrOrEq(gx, V4Abs(fx)), BAnd(V4IsGrtrOrEq(gy, V4Abs(fy)), V4IsGrtrOrEq(gz, V4Abs(fz)))));
+
+			hitMask |= BGetBitMask(mask)<<offset;
+		}
+		return hitMask & rayMask;
+	}
+
+	PX_ALIGN(16, PxReal	mOrigin[3][RAYCAST_PACKET_MAX_SIZE]);
+	PX_ALIGN(16, PxReal	mDir[3][RAYCAST_PACKET_MAX_SIZE]);
+	PX_ALIGN(16, PxReal	mAbsDir[3][RAYCAST_PACKET_MAX_SIZE]);
+	PX_ALIGN(16, PxReal	mRayMin[3][RAYCAST_PACKET_MAX_SIZE]);
+	PX_ALIGN(16, PxReal	mRayMax[3][RAYCAST_PACKET_MAX_SIZE]);
+	const PxU32			mNbGroups;
+private:
+	RayPacketAABBTest& operator=(const RayPacketAABBTest&);
+};
+
 // probably not worth having a SIMD version of this unless the traversal passes Vec3Vs
 struct AABBAABBTest
 {
@@ -30,6 +30,7 @@
 #include "foundation/PxAllocator.h"
 #include "foundation/PxMemory.h"
 #include "GuSAH.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -40,12 +41,14 @@ static PX_FORCE_INLINE float getSurfaceArea(const PxBounds3& bounds)
 	return 2.0f * (e.x * e.y + e.x * e.z + e.y * e.z);
 }
 
-SAH_Buffers::SAH_Buffers(PxU32 nb_prims)
+SAH_Buffers::SAH_Buffers(PxU32 nb_prims, bool multiThreaded)
 {
-	mKeys = PX_ALLOCATE(float, nb_prims, "temp");
-	mCumulativeLower = PX_ALLOCATE(float, nb_prims, "temp");
-	mCumulativeUpper = PX_ALLOCATE(float, nb_prims, "temp");
+	const PxU32 nbAxes = multiThreaded ? 3 : 1;
+	mKeys = PX_ALLOCATE(float, nb_prims*nbAxes, "temp");
+	mCumulativeLower = PX_ALLOCATE(float, nb_prims*nbAxes, "temp");
+	mCumulativeUpper = PX_ALLOCATE(float, nb_prims*nbAxes, "temp");
 	mNb = nb_prims;
+	mMultiThreaded = multiThreaded;
 }
 
 SAH_Buffers::~SAH_Buffers()
@@ -55,110 +58,184 @@ SAH_Buffers::~SAH_Buffers()
 	PX_FREE(mCumulativeUpper);
 }
 
-bool SAH_Buffers::split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers)
+namespace
 {
-    PxU32 bestAxis = 0;
-    PxU32 bestIndex = 0;
-    float bestCost = PX_MAX_F32;
+	struct AxisSplit
+	{
+		float	mCost;
+		PxU32	mIndex;
+		bool	mFound;
+	};
+}
 
-	PX_ASSERT(nb<=mNb);
-	for(PxU32 axis=0;axis<3;axis++)
+// PT: finds the best split position along one axis. Ties are resolved as in a single loop over all axes, i.e. the last
+// candidate with the lowest cost wins, so that the results are the same whether the axes are processed in parallel or not.
+static void findBestSplit(AxisSplit& result, PxU32 axis, Cm::RadixSortBuffered& sorter, float* PX_RESTRICT keys, float* PX_RESTRICT cumulativeLower, float* PX_RESTRICT cumulativeUpper,
+						PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers)
+{
+	float bestCost = PX_MAX_F32;
+	result.mIndex = 0;
+	result.mFound = false;
+
+	const PxU32* sorted;
 	{
-		const PxU32* sorted;
+		for(PxU32 i=0;i<nb;i++)
 		{
-			float* keys = mKeys;
-			for(PxU32 i=0;i<nb;i++)
-			{
-				const PxU32 index = prims[i];
-				const float center = centers[index][axis];
-				keys[i] = center;
-			}
-
-			sorted = mSorters[axis].Sort(keys, nb).GetRanks();
+			const PxU32 index = prims[i];
+			const float center = centers[index][axis];
+			keys[i] = center;
 		}
 
-		float* cumulativeLower = mCumulativeLower;
-		float* cumulativeUpper = mCumulativeUpper;
+		// PT: the sorter reuses its previous ranks as a starting point when called with the same number of keys, which
+		// changes the order of tied keys depending on the previous sorts. Start from fresh ranks so that the order only
+		// depends on the input, whatever the build order of the nodes.
+		sorter.invalidateRanks();
+		sorted = sorter.Sort(keys, nb).GetRanks();
+	}
 
 /*		if(0)
-		{
-			PxBounds3 bbox = PxBounds3::empty();
+	{
+		PxBounds3 bbox = PxBounds3::empty();
 
-			for(PxU32 i=0; i<nb; i++)
-			{
-				bbox.include(bboxes[references[axis][i]]);
-				bbox.include(boxes[prims[nb-sortedIndex-1]]);
-			}
+		for(PxU32 i=0; i<nb; i++)
+		{
+			bbox.include(bboxes[references[axis][i]]);
+			bbox.include(boxes[prims[nb-sortedIndex-1]]);
+		}
 
-			
-			for (size_t i = end - 1; i > begin; --i) {
-			bbox.extend(bboxes[references[axis][i]]);
-			costs[axis][i] = bbox.half_area() * (end - i);
-			}
-			bbox = BoundingBox<Scalar>::empty();
-			auto best_split = std::pair<Scalar, size_t>(std::numeric_limits<Scalar>::max(), end);
-			for (size_t i = begin; i < end - 1; ++i) {
-			bbox.extend(bboxes[references[axis][i]]);
-			auto cost = bbox.half_area() * (i + 1 - begin) + costs[axis][i + 1];
-			if (cost < best_split.first)
-			best_split = std::make_pair(cost, i + 1);
-			}
-			return best_split;
-		}*/
+		
+		for (size_t i = end - 1; i > begin; --i) {
+		bbox.extend(bboxes[references[axis][i]]);
+		costs[axis][i] = bbox.half_area() * (end - i);
+		}
+		bbox = BoundingBox<Scalar>::empty();
+		auto best_split = std::pair<Scalar, size_t>(std::numeric_limits<Scalar>::max(), end);
+		for (size_t i = begin; i < end - 1; ++i) {
+		bbox.extend(bboxes[references[axis][i]]);
+		auto cost = bbox.half_area() * (i + 1 - begin) + costs[axis][i + 1];
+		if (cost < best_split.first)
+		best_split = std::make_pair(cost, i + 1);
+		}
+		return best_split;
+	}*/
 
-		if(1)
-		{
-			// two passes over data to calculate upper and lower bounds
-			PxBounds3 lower = PxBounds3::empty();
-			PxBounds3 upper = PxBounds3::empty();
+	if(1)
+	{
+		// two passes over data to calculate upper and lower bounds
+		PxBounds3 lower = PxBounds3::empty();
+		PxBounds3 upper = PxBounds3::empty();
 //				lower.minimum = lower.maximum = PxVec3(0.0f);
 //				upper.minimum = upper.maximum = PxVec3(0.0f);
 
 #if PX_ENABLE_ASSERTS
-			float prevLowerCenter = -PX_MAX_F32;
-			float prevUpperCenter = PX_MAX_F32;
+		float prevLowerCenter = -PX_MAX_F32;
+		float prevUpperCenter = PX_MAX_F32;
 #endif
-			for(PxU32 i=0; i<nb; ++i)
-			{
-				const PxU32 lowSortedIndex = sorted[i];
-				const PxU32 highSortedIndex = sorted[nb-i-1];
+		for(PxU32 i=0; i<nb; ++i)
+		{
+			const PxU32 lowSortedIndex = sorted[i];
+			const PxU32 highSortedIndex = sorted[nb-i-1];
 
-				//lower.Union(m_faceBounds[faces[i]]);
-					PX_ASSERT(centers[prims[lowSortedIndex]][axis]>=prevLowerCenter);
-					lower.include(boxes[prims[lowSortedIndex]]);
+			//lower.Union(m_faceBounds[faces[i]]);
+				PX_ASSERT(centers[prims[lowSortedIndex]][axis]>=prevLowerCenter);
+				lower.include(boxes[prims[lowSortedIndex]]);
 #if PX_ENABLE_ASSERTS
-					prevLowerCenter = centers[prims[lowSortedIndex]][axis];
+				prevLowerCenter = centers[prims[lowSortedIndex]][axis];
 #endif
-				//upper.Union(m_faceBounds[faces[numFaces - i - 1]]);
-					PX_ASSERT(centers[prims[highSortedIndex]][axis]<=prevUpperCenter);
-					upper.include(boxes[prims[highSortedIndex]]);
+			//upper.Union(m_faceBounds[faces[numFaces - i - 1]]);
+				PX_ASSERT(centers[prims[highSortedIndex]][axis]<=prevUpperCenter);
+				upper.include(boxes[prims[highSortedIndex]]);
 #if PX_ENABLE_ASSERTS
-					prevUpperCenter = centers[prims[highSortedIndex]][axis];
+				prevUpperCenter = centers[prims[highSortedIndex]][axis];
 #endif
 
-				cumulativeLower[i] = getSurfaceArea(lower);
-				cumulativeUpper[nb - i - 1] = getSurfaceArea(upper);
-			}
+			cumulativeLower[i] = getSurfaceArea(lower);
+			cumulativeUpper[nb - i - 1] = getSurfaceArea(upper);
+		}
 
 //			const float invTotalSA = 1.0f / cumulativeUpper[0];
 
-			// test all split positions
-			for (PxU32 i = 0; i < nb - 1; ++i)
-			{
-				const float pBelow = cumulativeLower[i];// * invTotalSA;
-				const float pAbove = cumulativeUpper[i];// * invTotalSA;
+		// test all split positions
+		for (PxU32 i = 0; i < nb - 1; ++i)
+		{
+			const float pBelow = cumulativeLower[i];// * invTotalSA;
+			const float pAbove = cumulativeUpper[i];// * invTotalSA;
 
 //				const float cost = 0.125f + (pBelow * i + pAbove * float(nb - i));
-				const float cost = (pBelow * i + pAbove * float(nb - i));
-				if(cost <= bestCost)
-				{
-					bestCost = cost;
-					bestIndex = i;
-					bestAxis = axis;
-				}
+			const float cost = (pBelow * i + pAbove * float(nb - i));
+			if(cost <= bestCost)
+			{
+				bestCost = cost;
+				result.mIndex = i;
+				result.mFound = true;
 			}
 		}
 	}
+	result.mCost = bestCost;
+}
+
+namespace
+{
+	struct ParallelSplitParams
+	{
+		SAH_Buffers*		mBuffers;
+		AxisSplit*			mResults;
+		PxU32				mNb;
+		const PxU32*		mPrims;
+		const PxBounds3*	mBoxes;
+		const PxVec3*		mCenters;
+	};
+}
+
+static void findBestSplitTask(void* userData, PxU32 start, PxU32 end)
+{
+	const ParallelSplitParams& params = *reinterpret_cast<const ParallelSplitParams*>(userData);
+	SAH_Buffers& buffers = *params.mBuffers;
+	for(PxU32 axis=start; axis<end; axis++)
+	{
+		const PxU32 offset = axis*buffers.mNb;
+		findBestSplit(params.mResults[axis], axis, buffers.mSorters[axis], buffers.mKeys + offset, buffers.mCumulativeLower + offset, buffers.mCumulativeUpper + offset,
+			params.mNb, params.mPrims, params.mBoxes, params.mCenters);
+	}
+}
+
+// PT: below this the three axes are not worth processing in parallel
+static const PxU32 gMinNbPrimsForParallelSplit = 16384;
+
+bool SAH_Buffers::split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers, PxCpuDispatcher* dispatcher)
+{
+	PX_ASSERT(nb<=mNb);
+
+	AxisSplit results[3];
+	if(dispatcher && mMultiThreaded && nb>=gMinNbPrimsForParallelSplit)
+	{
+		ParallelSplitParams params;
+		params.mBuffers	= this;
+		params.mResults	= results;
+		params.mNb		= nb;
+		params.mPrims	= prims;
+		params.mBoxes	= boxes;
+		params.mCenters	= centers;
+		Cm::parallelFor(dispatcher, 3, 1, findBestSplitTask, &params);
+	}
+	else
+	{
+		for(PxU32 axis=0;axis<3;axis++)
+			findBestSplit(results[axis], axis, mSorters[axis], mKeys, mCumulativeLower, mCumulativeUpper, nb, prims, boxes, centers);
+	}
+
+	PxU32 bestAxis = 0;
+	PxU32 bestIndex = 0;
+	float bestCost = PX_MAX_F32;
+	for(PxU32 axis=0;axis<3;axis++)
+	{
+		if(results[axis].mFound && results[axis].mCost <= bestCost)
+		{
+			bestCost = results[axis].mCost;
+			bestIndex = results[axis].mIndex;
+			bestAxis = axis;
+		}
+	}
 
 	leftCount = bestIndex + 1;
 
@@ -31,24 +31,30 @@
 
 
 #include "foundation/PxBounds3.h"
+#include "foundation/PxUserAllocated.h"
 #include "CmRadixSort.h"
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
-	struct SAH_Buffers
+	struct SAH_Buffers : public PxUserAllocated
 	{
-								SAH_Buffers(PxU32 nb_prims);
+								// PT: with multiThreaded=true each axis gets its own buffers, so that the three axes can be
+								// evaluated in parallel when a dispatcher is passed to split().
+								SAH_Buffers(PxU32 nb_prims, bool multiThreaded=false);
 								~SAH_Buffers();
 
-		bool					split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers);
+		bool					split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers, PxCpuDispatcher* dispatcher=NULL);
 
 		Cm::RadixSortBuffered	mSorters[3];
 		float*					mKeys;
 		float*					mCumulativeLower;
 		float*					mCumulativeUpper;
 		PxU32					mNb;
+		bool					mMultiThreaded;
 	};
 }
 }
@@ -31,6 +31,7 @@
 #include "foundation/PxAllocator.h"
 #include "foundation/PxBitUtils.h"
 #include "GuMeshCleaner.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -70,7 +71,86 @@ static PX_FORCE_INLINE PxU32 getHashValue(const Indices& v)
 	return c;
 }
 
-MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxF32 areaLimit)
+namespace
+{
+	struct SnapParams
+	{
+		const PxVec3*	mSrcVerts;
+		PxVec3*			mCleanVerts;
+		PxU32*			mVertexIndices;
+		PxF32			mWeldTolerance;
+	};
+
+	struct TriangleParams
+	{
+		const PxVec3*	mSrcVerts;
+		const PxU32*	mSrcIndices;
+		const PxU32*	mRemapVerts;
+		PxU32*			mIndices;
+		PxU32			mNbVerts;
+		PxF32			mLimit;
+	};
+}
+
+static void snapToGrid(void* userData, PxU32 start, PxU32 end)
+{
+	const SnapParams& params = *reinterpret_cast<const SnapParams*>(userData);
+	const PxVec3* srcVerts = params.mSrcVerts;
+	const PxF32 weldTolerance = params.mWeldTolerance;
+	for(PxU32 i=start; i<end; i++)
+	{
+		params.mVertexIndices[i] = i;
+		params.mCleanVerts[i] = PxVec3(	PxFloor(srcVerts[i].x*weldTolerance + 0.5f),
+										PxFloor(srcVerts[i].y*weldTolerance + 0.5f),
+										PxFloor(srcVerts[i].z*weldTolerance + 0.5f));
+	}
+}
+
+// PT: remaps the triangles to the cleaned vertices, at the same index in the output buffer. Rejected triangles are
+// marked with an invalid first index and compacted afterwards, so that the results do not depend on the batches.
+static void remapAndValidateTriangles(void* userData, PxU32 start, PxU32 end)
+{
+	const TriangleParams& params = *reinterpret_cast<const TriangleParams*>(userData);
+	const PxVec3* srcVerts = params.mSrcVerts;
+	const PxU32* remapVerts = params.mRemapVerts;
+	const PxU32 nbVerts = params.mNbVerts;
+	for(PxU32 i=start; i<end; i++)
+	{
+		const PxU32* srcIndices = params.mSrcIndices + i*3;
+		PxU32* indices = params.mIndices + i*3;
+		indices[0] = 0xffffffff;
+
+		PxU32 vref0 = srcIndices[0];
+		PxU32 vref1 = srcIndices[1];
+		PxU32 vref2 = srcIndices[2];
+		if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
+			continue;
+
+		// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
+		const PxVec3& p0 = srcVerts[vref0];
+		const PxVec3& p1 = srcVerts[vref1];
+		const PxVec3& p2 = srcVerts[vref2];
+
+		const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
+		if(area2<=params.mLimit)
+			continue;
+
+		vref0 = remapVerts[vref0];
+		vref1 = remapVerts[vref1];
+		vref2 = remapVerts[vref2];
+		if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+			continue;
+
+		indices[0] = vref0;
+		indices[1] = vref1;
+		indices[2] = vref2;
+	}
+}
+
+static const PxU32 gMinNbVertsPerBatch = 8192;
+static const PxU32 gMinNbTrisPerBatch = 4096;
+
+MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxF32 areaLimit, PxCpuDispatcher* dispatcher)
 {
 	PxVec3* cleanVerts = PX_ALLOCATE(PxVec3, nbVerts, "MeshCleaner");
 	PX_ASSERT(cleanVerts);
@@ -83,15 +163,12 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	if(meshWeldTolerance!=0.0f)
 	{
 		vertexIndices = PX_ALLOCATE(PxU32, nbVerts, "MeshCleaner");
-		const PxF32 weldTolerance = 1.0f / meshWeldTolerance;
-		// snap to grid
-		for(PxU32 i=0; i<nbVerts; i++)
-		{
-			vertexIndices[i] = i;
-			cleanVerts[i] = PxVec3(	PxFloor(srcVerts[i].x*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].y*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].z*weldTolerance + 0.5f));
-		}
+		SnapParams params;
+		params.mSrcVerts		= srcVerts;
+		params.mCleanVerts		= cleanVerts;
+		params.mVertexIndices	= vertexIndices;
+		params.mWeldTolerance	= 1.0f / meshWeldTolerance;
+		Cm::parallelFor(dispatcher, nbVerts, gMinNbVertsPerBatch, snapToGrid, &params);
 	}
 	else
 	{
@@ -145,35 +222,26 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	// area < areaLimit
 	// <=> ((p0 - p1).cross(p0 - p2)).magnitude() < areaLimit * 2.0
 	// <=> ((p0 - p1).cross(p0 - p2)).magnitudeSquared() < (areaLimit * 2.0)^2
-	const PxF32 limit = areaLimit * areaLimit * 4.0f;
+	{
+		TriangleParams params;
+		params.mSrcVerts	= srcVerts;
+		params.mSrcIndices	= srcIndices;
+		params.mRemapVerts	= remapVerts;
+		params.mIndices		= indices;
+		params.mNbVerts		= nbVerts;
+		params.mLimit		= areaLimit * areaLimit * 4.0f;
+		Cm::parallelFor(dispatcher, nbTris, gMinNbTrisPerBatch, remapAndValidateTriangles, &params);
+	}
 
 	PxU32 nbCleanedTris = 0;
 	for(PxU32 i=0;i<nbTris;i++)
 	{
-		PxU32 vref0 = *srcIndices++;
-		PxU32 vref1 = *srcIndices++;
-		PxU32 vref2 = *srcIndices++;
-		if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
-			continue;
-
-		// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
-		const PxVec3& p0 = srcVerts[vref0];
-		const PxVec3& p1 = srcVerts[vref1];
-		const PxVec3& p2 = srcVerts[vref2];
-
-		const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
-		if(area2<=limit)
-			continue;
-
-		vref0 = remapVerts[vref0];
-		vref1 = remapVerts[vref1];
-		vref2 = remapVerts[vref2];
-		if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+		if(indices[i*3+0]==0xffffffff)
 			continue;
 
-		indices[nbCleanedTris*3+0] = vref0;
-		indices[nbCleanedTris*3+1] = vref1;
-		indices[nbCleanedTris*3+2] = vref2;
+		indices[nbCleanedTris*3+0] = indices[i*3+0];
+		indices[nbCleanedTris*3+1] = indices[i*3+1];
+		indices[nbCleanedTris*3+2] = indices[i*3+2];
 		remapTriangles[nbCleanedTris] = i;
 		nbCleanedTris++;
 	}
@@ -29,10 +29,13 @@
 #include "GuCooking.h"
 #include "GuCookingConvexMeshBuilder.h"
 #include "GuCookingQuickHullConvexHullLib.h"
+#include "GuCookingScratch.h"
 #include "GuConvexMesh.h"
 #include "foundation/PxAlloca.h"
+#include "foundation/PxAtomic.h"
 #include "foundation/PxFPU.h"
 #include "common/PxInsertionCallback.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -130,7 +133,7 @@ static bool cookConvexMeshInternal(const PxCookingParams& params, const PxConvex
 	return true;
 }
 
-static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParams& params)
+static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParams& params, CookingScratch* scratch)
 {	
 	if(desc.flags & PxConvexFlag::eCOMPUTE_CONVEX)
 	{			
@@ -144,18 +147,16 @@ static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParam
 			desc.polygonLimit = PxMin(desc.polygonLimit, gpuMaxFacesLimit);
 		}
 
-		return PX_NEW(QuickHullConvexHullLib) (desc, params);
+		return PX_NEW(QuickHullConvexHullLib) (desc, params, scratch);
 	}
 	return NULL;
 }
 
-bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
-{	
-	PX_FPU_GUARD;
-
+static bool cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition, CookingScratch* scratch)
+{
 	// choose cooking library if needed
     PxConvexMeshDesc desc = desc_;
-	ConvexHullLib* hullLib = createHullLib(desc, params);
+	ConvexHullLib* hullLib = createHullLib(desc, params, scratch);
 
 	ConvexMeshBuilder meshBuilder(params.buildGPUData);
 	if(!cookConvexMeshInternal(params, desc, meshBuilder, hullLib, condition))
@@ -165,7 +166,7 @@ bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxCon
 	}
 
 	// save the cooked results into stream
-	if(!meshBuilder.save(stream, platformMismatch()))
+	if(!meshBuilder.save(stream, immediateCooking::platformMismatch()))
 	{		
 		if(condition)
 			*condition = PxConvexMeshCookingResult::eFAILURE;
@@ -178,13 +179,11 @@ bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxCon
 	return true;
 }
 
-PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
+static PxConvexMesh* createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition, CookingScratch* scratch)
 {
-	PX_FPU_GUARD;
-
 	// choose cooking library if needed
 	PxConvexMeshDesc desc = desc_;
-	ConvexHullLib* hullLib = createHullLib(desc, params);
+	ConvexHullLib* hullLib = createHullLib(desc, params, scratch);
 
 	// cook the mesh
 	ConvexMeshBuilder meshBuilder(params.buildGPUData);
@@ -213,6 +212,92 @@ PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params,
 	return convexMesh;
 }
 
+bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
+{
+	PX_FPU_GUARD;
+	return ::cookConvexMesh(params, desc, stream, condition, NULL);
+}
+
+PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
+{
+	PX_FPU_GUARD;
+	return ::createConvexMesh(params, desc, insertionCallback, condition, NULL);
+}
+
+namespace
+{
+	struct ConvexBatchData
+	{
+		const PxCookingParams*				mParams;
+		const PxConvexMeshDesc*				mDescs;
+		PxOutputStream* const*				mStreams;		// either streams or meshes are used
+		PxInsertionCallback*				mInsertionCallback;
+		PxConvexMesh**						mMeshes;
+		PxConvexMeshCookingResult::Enum*	mConditions;
+		volatile PxI32						mNbFailures;
+	};
+}
+
+// PT: each batch of hulls owns a scratch arena, reset between hulls, so that the temporary quickhull buffers are only
+// allocated once per batch and the worker threads do not contend on the allocator. The hulls are independent so
+// the results are the same as when cooking them one by one.
+static void cookConvexBatch(void* userData, PxU32 start, PxU32 end)
+{
+	PX_FPU_GUARD;
+
+	ConvexBatchData& data = *reinterpret_cast<ConvexBatchData*>(userData);
+	CookingScratch scratch;
+
+	for(PxU32 i=start;i<end;i++)
+	{
+		PxConvexMeshCookingResult::Enum* condition = data.mConditions ? data.mConditions + i : NULL;
+
+		bool status;
+		if(data.mMeshes)
+		{
+			data.mMeshes[i] = ::createConvexMesh(*data.mParams, data.mDescs[i], *data.mInsertionCallback, condition, &scratch);
+			status = data.mMeshes[i] != NULL;
+		}
+		else
+		{
+			status = ::cookConvexMesh(*data.mParams, data.mDescs[i], *data.mStreams[i], condition, &scratch);
+		}
+
+		if(!status)
+			PxAtomicIncrement(&data.mNbFailures);
+
+		scratch.reset();
+	}
+}
+
+bool immediateCooking::cookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions)
+{
+	ConvexBatchData data;
+	data.mParams = &params;
+	data.mDescs = descs;
+	data.mStreams = streams;
+	data.mInsertionCallback = NULL;
+	data.mMeshes = NULL;
+	data.mConditions = conditions;
+	data.mNbFailures = 0;
+	Cm::parallelFor(params.cpuDispatcher, nbMeshes, 1, cookConvexBatch, &data);
+	return data.mNbFailures == 0;
+}
+
+bool immediateCooking::createConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxInsertionCallback& insertionCallback, PxConvexMesh** meshes, PxConvexMeshCookingResult::Enum* conditions)
+{
+	ConvexBatchData data;
+	data.mParams = &params;
+	data.mDescs = descs;
+	data.mStreams = NULL;
+	data.mInsertionCallback = &insertionCallback;
+	data.mMeshes = meshes;
+	data.mConditions = conditions;
+	data.mNbFailures = 0;
+	Cm::parallelFor(params.cpuDispatcher, nbMeshes, 1, cookConvexBatch, &data);
+	return data.mNbFailures == 0;
+}
+
 bool immediateCooking::validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	ConvexMeshBuilder mesh(params.buildGPUData);
@@ -36,6 +36,7 @@
 #include "GuEdgeList.h"
 #include "cooking/PxCooking.h"
 #include "CmRadixSort.h"
+#include "CmParallelFor.h"
 
 //#define CHECK_OLD_CODE_VS_NEW_CODE
 
@@ -184,7 +185,75 @@ static PxU32 findAdjacent(const PxVec3* triVertices, const PxVec3* triNormals, c
 	return result;
 }
 
-static void buildAdjacencies(uint4* triAdjacencies, PxVec3* tempNormalsPerTri_prealloc, const PxVec3* triVertices, const IndexedTriangle32* triIndices, PxU32 nbTris)
+namespace
+{
+	struct AdjacenciesParams
+	{
+		uint4*						mTriAdjacencies;
+		PxVec3*						mNormals;
+		const PxVec3*				mTriVertices;
+		const IndexedTriangle32*	mTriIndices;
+		const EdgeTriangleData*		mEdgeTriangleData;
+		const EdgeDescData*			mEdgeToTriangle;
+		const PxU32*				mFaceByEdge;
+	};
+}
+
+static void computeTriangleNormals(void* userData, PxU32 start, PxU32 end)
+{
+	const AdjacenciesParams& params = *reinterpret_cast<const AdjacenciesParams*>(userData);
+	const PxVec3* triVertices = params.mTriVertices;
+	for(PxU32 i=start; i<end; i++)
+	{
+		const IndexedTriangle32& triIdx = params.mTriIndices[i];
+		const PxU32 vIdx0 = triIdx.mRef[0];
+		const PxU32 vIdx1 = triIdx.mRef[1];
+		const PxU32 vIdx2 = triIdx.mRef[2];
+
+		params.mNormals[i] = (triVertices[vIdx1] - triVertices[vIdx0]).cross(triVertices[vIdx2] - triVertices[vIdx0]).getNormalized();
+	}
+}
+
+static void computeTriangleAdjacencies(void* userData, PxU32 start, PxU32 end)
+{
+	const AdjacenciesParams& params = *reinterpret_cast<const AdjacenciesParams*>(userData);
+	const PxVec3* triVertices = params.mTriVertices;
+	const PxVec3* tempNormalsPerTri_prealloc = params.mNormals;
+	const IndexedTriangle32* triIndices = params.mTriIndices;
+	const EdgeDescData* edgeToTriangle = params.mEdgeToTriangle;
+	const PxU32* faceByEdge = params.mFaceByEdge;
+	for(PxU32 i=start; i<end; i++)
+	{
+		const IndexedTriangle32& triIdx = triIndices[i];
+		const PxU32 vIdx0 = triIdx.mRef[0];
+		const PxU32 vIdx1 = triIdx.mRef[1];
+		const PxU32 vIdx2 = triIdx.mRef[2];
+
+		const PxPlane triPlane(triVertices[vIdx0], tempNormalsPerTri_prealloc[i]);
+
+		const EdgeTriangleData& edgeTri = params.mEdgeTriangleData[i];
+		const EdgeDescData& edgeData0 = edgeToTriangle[edgeTri.mLink[0] & MSH_EDGE_LINK_MASK];
+		const EdgeDescData& edgeData1 = edgeToTriangle[edgeTri.mLink[1] & MSH_EDGE_LINK_MASK];
+		const EdgeDescData& edgeData2 = edgeToTriangle[edgeTri.mLink[2] & MSH_EDGE_LINK_MASK];
+
+		uint4 triAdjIdx;
+		triAdjIdx.x = findAdjacent(triVertices, tempNormalsPerTri_prealloc, triIndices, faceByEdge + edgeData0.Offset, edgeData0.Count, vIdx0, vIdx1, triPlane, i);
+		triAdjIdx.y = findAdjacent(triVertices, tempNormalsPerTri_prealloc, triIndices, faceByEdge + edgeData1.Offset, edgeData1.Count, vIdx1, vIdx2, triPlane, i);
+		triAdjIdx.z = findAdjacent(triVertices, tempNormalsPerTri_prealloc, triIndices, faceByEdge + edgeData2.Offset, edgeData2.Count, vIdx2, vIdx0, triPlane, i);
+		triAdjIdx.w = 0;
+
+#ifdef CHECK_OLD_CODE_VS_NEW_CODE
+		PX_ASSERT(params.mTriAdjacencies[i].x == triAdjIdx.x);
+		PX_ASSERT(params.mTriAdjacencies[i].y == triAdjIdx.y);
+		PX_ASSERT(params.mTriAdjacencies[i].z == triAdjIdx.z);
+#endif
+		params.mTriAdjacencies[i] = triAdjIdx;
+	}
+}
+
+static const PxU32 gMinNbTrisPerAdjacencyBatch = 4096;
+
+static void buildAdjacencies(uint4* triAdjacencies, PxVec3* tempNormalsPerTri_prealloc, const PxVec3* triVertices, const IndexedTriangle32* triIndices, PxU32 nbTris, PxCpuDispatcher* dispatcher=NULL)
 {
 #ifdef CHECK_OLD_CODE_VS_NEW_CODE
 	{
@@ -249,48 +318,20 @@ static void buildAdjacencies(uint4* triAdjacencies, PxVec3* tempNormalsPerTri_pr
 		EdgeList edgeList;
 		if(edgeList.init(create))
 		{
-			for(PxU32 i=0; i<nbTris; i++)
-			{
-				const IndexedTriangle32& triIdx = triIndices[i];
-				const PxU32 vIdx0 = triIdx.mRef[0];
-				const PxU32 vIdx1 = triIdx.mRef[1];
-				const PxU32 vIdx2 = triIdx.mRef[2];
-
-				tempNormalsPerTri_prealloc[i] = (triVertices[vIdx1] - triVertices[vIdx0]).cross(triVertices[vIdx2] - triVertices[vIdx0]).getNormalized();
-			}
-
-			const EdgeTriangleData* edgeTriangleData = edgeList.getEdgeTriangles();
-			const EdgeDescData* edgeToTriangle = edgeList.getEdgeToTriangles();
-			const PxU32* faceByEdge = edgeList.getFacesByEdges();
 			PX_ASSERT(edgeList.getNbFaces()==nbTris);
 
-			for(PxU32 i=0; i<nbTris; i++)
-			{
-				const IndexedTriangle32& triIdx = triIndices[i];
-				const PxU32 vIdx0 = triIdx.mRef[0];
-				const PxU32 vIdx1 = triIdx.mRef[1];
-				const PxU32 vIdx2 = triIdx.mRef[2];
-
-				const PxPlane triPlane(triVertices[vIdx0], tempNormalsPerTri_prealloc[i]);
-
-				const EdgeTriangleData& edgeTri = edgeTriangleData[i];
-				const EdgeDescData& edgeData0 = edgeToTriangle[edgeTri.mLink[0] & MSH_EDGE_LINK_MASK];
-				const EdgeDescData& edgeData1 = edgeToTriangle[edgeTri.mLink[1] & MSH_EDGE_LINK_MASK];
-				const EdgeDescData& edgeData2 = edgeToTriangle[edgeTri.mLink[2] & MSH_EDGE_LINK_MASK];
-
-				uint4 triAdjIdx;
-				triAdjIdx.x = findAdjacent(triVertices, tempNormalsPerTri_prealloc, triIndices, faceByEdge + edgeData0.Offset, edgeData0.Count, vIdx0, vIdx1, triPlane, i);
-				triAdjIdx.y = findAdjacent(triVertices, tempNormalsPerTri_prealloc, triIndices, faceByEdge + edgeData1.Offset, edgeData1.Count, vIdx1, vIdx2, triPlane, i);
-				triAdjIdx.z = findAdjacent(triVertices, tempNormalsPerTri_prealloc, triIndices, faceByEdge + edgeData2.Offset, edgeData2.Count, vIdx2, vIdx0, triPlane, i);
-				triAdjIdx.w = 0;
-
-#ifdef CHECK_OLD_CODE_VS_NEW_CODE
-				PX_ASSERT(triAdjacencies[i].x == triAdjIdx.x);
-				PX_ASSERT(triAdjacencies[i].y == triAdjIdx.y);
-				PX_ASSERT(triAdjacencies[i].z == triAdjIdx.z);
-#endif
-				triAdjacencies[i] = triAdjIdx;
-			}
+			AdjacenciesParams params;
+			params.mTriAdjacencies		= triAdjacencies;
+			params.mNormals				= tempNormalsPerTri_prealloc;
+			params.mTriVertices			= triVertices;
+			params.mTriIndices			= triIndices;
+			params.mEdgeTriangleData	= edgeList.getEdgeTriangles();
+			params.mEdgeToTriangle		= edgeList.getEdgeToTriangles();
+			params.mFaceByEdge			= edgeList.getFacesByEdges();
+
+			// PT: all normals must be computed before the adjacency pass reads them
+			Cm::parallelFor(dispatcher, nbTris, gMinNbTrisPerAdjacencyBatch, computeTriangleNormals, &params);
+			Cm::parallelFor(dispatcher, nbTris, gMinNbTrisPerAdjacencyBatch, computeTriangleAdjacencies, &params);
 		}
 	}
 }
@@ -39,8 +39,11 @@
 #include "foundation/PxPlane.h"
 #include "foundation/PxBounds3.h"
 #include "foundation/PxMemory.h"
+#include "foundation/PxVecMath.h"
 
 using namespace physx;
+using namespace aos;
+using namespace Gu;
 
 namespace local
 {		
@@ -61,7 +64,7 @@ namespace local
 	{
 	public:
 		MemBlock(PxU32 preallocateSize)
-			: mPreallocateSize(preallocateSize), mCurrentBlock(0), mCurrentIndex(0)
+			: mPreallocateSize(preallocateSize), mCurrentBlock(0), mCurrentIndex(0), mScratch(NULL)
 		{
 			PX_ASSERT(preallocateSize);
 			T* block = PX_ALLOCATE(T, preallocateSize, "Quickhull MemBlock");
@@ -69,15 +72,17 @@ namespace local
 		}
 
 		MemBlock()
-			: mPreallocateSize(0), mCurrentBlock(0), mCurrentIndex(0)
+			: mPreallocateSize(0), mCurrentBlock(0), mCurrentIndex(0), mScratch(NULL)
 		{
 		}
 
-		void init(PxU32 preallocateSize)
+		// PT: when a scratch arena is provided the blocks are taken from it and never freed individually
+		void init(PxU32 preallocateSize, CookingScratch* scratch = NULL)
 		{
 			PX_ASSERT(preallocateSize);
 			mPreallocateSize = preallocateSize;
-			T* block = PX_ALLOCATE(T, preallocateSize, "Quickhull MemBlock");
+			mScratch = scratch;
+			T* block = allocateScratch<T>(mScratch, preallocateSize, "Quickhull MemBlock");
 			if(useIndexing)
 			{
 				for (PxU32 i = 0; i < mPreallocateSize; i++)
@@ -93,7 +98,7 @@ namespace local
 		{
 			for (PxU32 i = 0; i < mBlocks.size(); i++)
 			{
-				PX_FREE(mBlocks[i]);
+				freeScratch(mScratch, mBlocks[i]);
 			}
 			mBlocks.clear();
 		}
@@ -102,14 +107,14 @@ namespace local
 		{
 			for (PxU32 i = 0; i < mBlocks.size(); i++)
 			{
-				PX_FREE(mBlocks[i]);
+				freeScratch(mScratch, mBlocks[i]);
 			}
 			mBlocks.clear();
 
 			mCurrentBlock = 0;
 			mCurrentIndex = 0;
 
-			init(mPreallocateSize);
+			init(mPreallocateSize, mScratch);
 		}
 
 		T* getItem(PxU32 index)
@@ -131,7 +136,7 @@ namespace local
 			}
 			else
 			{
-				T* block = PX_ALLOCATE(T, mPreallocateSize, "Quickhull MemBlock");
+				T* block = allocateScratch<T>(mScratch, mPreallocateSize, "Quickhull MemBlock");
 				mCurrentBlock++;
 				if (useIndexing)
 				{
@@ -151,6 +156,7 @@ namespace local
 		PxU32			mPreallocateSize;
 		PxU32			mCurrentBlock;
 		PxU32			mCurrentIndex;
+		CookingScratch*	mScratch;
 		PxArray<T*>	mBlocks;
 	};
 
@@ -373,7 +379,7 @@ namespace local
 		PX_NOCOPY(QuickHull)
 	public:
 
-		QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc);
+		QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc, CookingScratch* scratch = NULL);
 
 		~QuickHull();
 
@@ -471,6 +477,7 @@ namespace local
 		PxU32					mOutputNumVertices;	// num vertices of the computed hull
 		PxU32					mTerminalVertex;	// in case we failed to generate hull in a regular run we set the terminal vertex and rerun
 
+		CookingScratch*			mScratch;			// optional arena for the temporary buffers
 		QuickHullVertex*		mVerticesList;		// vertices list preallocated
 		MemBlock<QuickHullHalfEdge, false>	mFreeHalfEdges;	// free half edges
 		MemBlock<QuickHullFace, true>	mFreeFaces;			// free faces
@@ -693,8 +700,8 @@ namespace local
 
 	//////////////////////////////////////////////////////////////////////////
 
-	QuickHull::QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc)
-		: mCookingParams(params), mConvexDesc(desc), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mVerticesList(NULL), mNumHullFaces(0), mPrecomputedMinMax(false),
+	QuickHull::QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc, CookingScratch* scratch)
+		: mCookingParams(params), mConvexDesc(desc), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mScratch(scratch), mVerticesList(NULL), mNumHullFaces(0), mPrecomputedMinMax(false),
 		mTolerance(-1.0f), mPlaneTolerance(-1.0f)
 	{
 	}
@@ -729,15 +736,15 @@ namespace local
 
 		// max num vertices = numVertices
 		mMaxVertices = PxMax(PxU32(8), numVertices); // 8 is min, since we can expand to AABB during the clean vertices phase
-		mVerticesList = PX_ALLOCATE(QuickHullVertex, mMaxVertices, "QuickHullVertex");
+		mVerticesList = allocateScratch<QuickHullVertex>(mScratch, mMaxVertices, "QuickHullVertex");
 
 		// estimate the max half edges
 		PxU32 maxHalfEdges = (3 * mMaxVertices - 6) * 3;
-		mFreeHalfEdges.init(maxHalfEdges);
+		mFreeHalfEdges.init(maxHalfEdges, mScratch);
 
 		// estimate the max faces
 		PxU32 maxFaces = (2 * mMaxVertices - 4);
-		mFreeFaces.init(maxFaces*2);
+		mFreeFaces.init(maxFaces*2, mScratch);
 
 		mHullFaces.reserve(maxFaces);
 		mUnclaimedPoints.reserve(numVertices);
@@ -752,7 +759,7 @@ namespace local
 	// release internal buffers
 	void QuickHull::releaseHull()
 	{
-		PX_FREE(mVerticesList);
+		freeScratch(mScratch, mVerticesList);
 		mHullFaces.clear();
 	}
 
@@ -1820,10 +1827,10 @@ namespace local
 
 //////////////////////////////////////////////////////////////////////////
 
-QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params)
-	: ConvexHullLib(desc, params),mQuickHull(NULL), mCropedConvexHull(NULL), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
+QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, CookingScratch* scratch)
+	: ConvexHullLib(desc, params),mQuickHull(NULL), mCropedConvexHull(NULL), mScratch(scratch), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
 {
-	mQuickHull = PX_NEW(local::QuickHull)(params, desc);
+	mQuickHull = PX_NEW(local::QuickHull)(params, desc, scratch);
 	mQuickHull->preallocate(desc.points.count);
 }
 
@@ -1836,7 +1843,7 @@ QuickHullConvexHullLib::~QuickHullConvexHullLib()
 
 	PX_DELETE(mCropedConvexHull);
 
-	PX_FREE(mOutMemoryBuffer);
+	freeScratch(mScratch, mOutMemoryBuffer);
 	mFaceTranslateTable = NULL;  // memory is a part of mOutMemoryBuffer
 }
 
@@ -1856,7 +1863,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 	if ( vcount < 8 ) 
 		vcount = 8;
 
-	PxVec3* outvsource  = PX_ALLOCATE(PxVec3, vcount, "PxVec3");
+	PxVec3* outvsource  = allocateScratch<PxVec3>(mScratch, vcount, "PxVec3");
 	PxU32 outvcount;
 
 	// cleanup the vertices first
@@ -1865,7 +1872,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		if(!shiftAndcleanupVertices(mConvexMeshDesc.points.count, reinterpret_cast<const PxVec3*> (mConvexMeshDesc.points.data), mConvexMeshDesc.points.stride,
 			outvcount, outvsource))
 		{
-			PX_FREE(outvsource);
+			freeScratch(mScratch, outvsource);
 			return res;
 		}
 	}
@@ -1874,7 +1881,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		if(!cleanupVertices(mConvexMeshDesc.points.count, reinterpret_cast<const PxVec3*> (mConvexMeshDesc.points.data), mConvexMeshDesc.points.stride,
 			outvcount, outvsource))
 		{
-			PX_FREE(outvsource);
+			freeScratch(mScratch, outvsource);
 			return res;
 		}
 	}
@@ -1945,7 +1952,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		}
 	}
 
-	PX_FREE(outvsource);
+	freeScratch(mScratch, outvsource);
 	return res;
 }
 
@@ -2106,6 +2113,82 @@ bool QuickHullConvexHullLib::cleanupForSimplex(PxVec3* vertices, PxU32 vertexCou
 	return retVal;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// computes for each visible face the largest positive distance of the hull vertices to its plane.
+// PT: this is the vertices x faces loop of the plane shifting path. The visible planes are gathered in SoA form and
+// tested 4 at a time. The distance is computed in the same order as QuickHullFace::distanceToPlane so the results
+// are the same as with the scalar version.
+void QuickHullConvexHullLib::expandPlanesToVertices()
+{
+	PxU32 nbVisibleFaces = 0;
+	for(PxU32 i=0;i<mQuickHull->mHullFaces.size();i++)
+	{
+		if(mQuickHull->mHullFaces[i]->state == local::QuickHullFace::eVISIBLE)
+			nbVisibleFaces++;
+	}
+	if(!nbVisibleFaces)
+		return;
+
+	const PxU32 nbGroups = (nbVisibleFaces + 3)/4;
+	local::QuickHullFace** faces = allocateScratch<local::QuickHullFace*>(mScratch, nbGroups*4, "QuickHullFace*");
+	PxF32* planes = allocateScratch<PxF32>(mScratch, nbGroups*4*5, "expand planes");
+	PxF32* nx = planes;
+	PxF32* ny = nx + nbGroups*4;
+	PxF32* nz = ny + nbGroups*4;
+	PxF32* offset = nz + nbGroups*4;
+	PxF32* expandOffset = offset + nbGroups*4;
+
+	PxU32 nb = 0;
+	for(PxU32 i=0;i<mQuickHull->mHullFaces.size();i++)
+	{
+		local::QuickHullFace* face = mQuickHull->mHullFaces[i];
+		if(face->state == local::QuickHullFace::eVISIBLE)
+		{
+			faces[nb] = face;
+			nx[nb] = face->normal.x;
+			ny[nb] = face->normal.y;
+			nz[nb] = face->normal.z;
+			offset[nb] = face->planeOffset;
+			expandOffset[nb] = face->expandOffset;
+			nb++;
+		}
+	}
+	// padding planes never give a positive distance
+	while(nb<nbGroups*4)
+	{
+		faces[nb] = NULL;
+		nx[nb] = ny[nb] = nz[nb] = 0.0f;
+		offset[nb] = PX_MAX_F32;
+		expandOffset[nb] = -PX_MAX_F32;
+		nb++;
+	}
+
+	const Vec4V zero = V4Zero();
+	for(PxU32 g=0;g<nbGroups;g++)
+	{
+		const Vec4V nxV = V4LoadA(nx + g*4);
+		const Vec4V nyV = V4LoadA(ny + g*4);
+		const Vec4V nzV = V4LoadA(nz + g*4);
+		const Vec4V offsetV = V4LoadA(offset + g*4);
+		Vec4V expandOffsetV = V4LoadA(expandOffset + g*4);
+
+		for(PxU32 iVerts=0;iVerts<mQuickHull->mNumVertices;iVerts++)
+		{
+			const PxVec3& p = mQuickHull->mVerticesList[iVerts].point;
+			const Vec4V dot = V4Add(V4Add(V4Scale(nxV, FLoad(p.x)), V4Scale(nyV, FLoad(p.y))), V4Scale(nzV, FLoad(p.z)));
+			const Vec4V dist = V4Sub(dot, offsetV);
+			expandOffsetV = V4Sel(BAnd(V4IsGrtr(dist, zero), V4IsGrtr(dist, expandOffsetV)), dist, expandOffsetV);
+		}
+		V4StoreA(expandOffsetV, expandOffset + g*4);
+	}
+
+	for(PxU32 i=0;i<nbVisibleFaces;i++)
+		faces[i]->expandOffset = expandOffset[i];
+
+	freeScratch(mScratch, planes);
+	freeScratch(mScratch, faces);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // expand the hull with the from the limited triangles set
 // expand hull will do following steps:
@@ -2139,24 +2222,8 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHull()
 	}
 
 
-	// go over the planes now and expand them	
-	for(PxU32 iVerts=0;iVerts< mQuickHull->mNumVertices;iVerts++)
-	{
-		const local::QuickHullVertex& vertex = mQuickHull->mVerticesList[iVerts];
-
-		for (PxU32 i = 0; i < mQuickHull->mHullFaces.size(); i++)
-		{
-			local::QuickHullFace& face = *mQuickHull->mHullFaces[i];
-			if(face.state == local::QuickHullFace::eVISIBLE)
-			{				
-				const float dist = face.distanceToPlane(vertex.point);
-				if(dist > 0 && dist > face.expandOffset)
-				{
-					face.expandOffset = dist;
-				}
-			}
-		}	
-	}
+	// go over the planes now and expand them
+	expandPlanesToVertices();
 
 	// fill the expand points planes
 	for(PxU32 i=0;i<expandPoints.size();i++)
@@ -2184,7 +2251,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHull()
 	}
 
 	// construct again the hull from the new points
-	local::QuickHull* newHull = PX_NEW(local::QuickHull)(mQuickHull->mCookingParams, mQuickHull->mConvexDesc);		
+	local::QuickHull* newHull = PX_NEW(local::QuickHull)(mQuickHull->mCookingParams, mQuickHull->mConvexDesc, mScratch);		
 	newHull->preallocate(expandPoints.size());
 	newHull->parseInputVertices(vertices,expandPoints.size());
 
@@ -2255,7 +2322,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHullOBB()
 	computeOBBFromConvex(convexDesc, sides, obbTransform);
 
 	// free the memory used for the convex mesh desc
-	PX_FREE(mOutMemoryBuffer);
+	freeScratch(mScratch, mOutMemoryBuffer);
 	mFaceTranslateTable = NULL;
 
 	// crop the OBB
@@ -2417,7 +2484,7 @@ void QuickHullConvexHullLib::fillConvexMeshDescFromQuickHull(PxConvexMeshDesc& d
 	const PxU32 faceTranslationTableSize = sizeof(PxU16)*numFacesOut;
 	const PxU32 translationTableSize = sizeof(PxU32)*mQuickHull->mNumVertices;
 	const PxU32 bufferMemorySize = indicesBufferSize + verticesBufferSize + facesBufferSize + faceTranslationTableSize + translationTableSize;
-	mOutMemoryBuffer = reinterpret_cast<PxU8*>(PX_ALLOC(bufferMemorySize, "ConvexMeshDesc"));
+	mOutMemoryBuffer = allocateScratch<PxU8>(mScratch, bufferMemorySize, "ConvexMeshDesc");
 
 	PxU32* indices = reinterpret_cast<PxU32*> (mOutMemoryBuffer);
 	PxVec3* vertices = reinterpret_cast<PxVec3*> (mOutMemoryBuffer + indicesBufferSize);
@@ -2534,7 +2601,7 @@ void QuickHullConvexHullLib::fillConvexMeshDescFromCroppedHull(PxConvexMeshDesc&
 	const PxU32 facesBufferSize = sizeof(PxHullPolygon)*numPolygons;
 	const PxU32 verticesBufferSize = sizeof(PxVec3)*(numVertices + 1); // allocate additional vec3 for V4 safe load in VolumeInteration
 	const PxU32 bufferMemorySize = indicesBufferSize + verticesBufferSize + facesBufferSize;
-	mOutMemoryBuffer = reinterpret_cast<PxU8*>(PX_ALLOC(bufferMemorySize, "ConvexMeshDesc"));
+	mOutMemoryBuffer = allocateScratch<PxU8>(mScratch, bufferMemorySize, "ConvexMeshDesc");
 
 	// parse the hullOut and fill the result with vertices and polygons
 	PxU32* indicesOut = reinterpret_cast<PxU32*> (mOutMemoryBuffer);	
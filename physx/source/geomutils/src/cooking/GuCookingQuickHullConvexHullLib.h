@@ -30,6 +30,7 @@
 #define GU_COOKING_QUICKHULL_CONVEXHULLLIB_H
 
 #include "GuCookingConvexHullLib.h"
+#include "GuCookingScratch.h"
 #include "foundation/PxArray.h"
 #include "foundation/PxUserAllocated.h"
 
@@ -54,7 +55,8 @@ namespace physx
 	public:
 
 		// functions
-		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params);
+		// the optional scratch arena is used for all the temporary buffers and must outlive the lib
+		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, Gu::CookingScratch* scratch = NULL);
 
 		~QuickHullConvexHullLib();
 
@@ -74,6 +76,9 @@ namespace physx
 		// if vertex limit reached we need to expand the hull using the plane shifting
 		PxConvexMeshCookingResult::Enum expandHull();
 
+		// pushes the visible face planes out so that all the hull vertices are inside
+		void expandPlanesToVertices();
+
 		// checks for collinearity and co planarity
 		// returns true if the simplex was ok, we can reuse the computed tolerances and min/max values
 		bool cleanupForSimplex(PxVec3* vertices, PxU32 vertexCount, local::QuickHullVertex* minimumVertex, 
@@ -88,6 +93,7 @@ namespace physx
 	private:
 		local::QuickHull*		mQuickHull;		// the internal quick hull representation
 		ConvexHull*				mCropedConvexHull; //the hull cropped from OBB, used for vertex limit path
+		Gu::CookingScratch*		mScratch;		// optional arena for temporary and output buffers
 
 		PxU8*					mOutMemoryBuffer;   // memory buffer used for output data
 		PxU16*					mFaceTranslateTable; // translation table mapping output faces to internal quick hull table
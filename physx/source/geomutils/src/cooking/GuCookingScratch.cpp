@@ -0,0 +1,98 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuCookingScratch.h"
+#include "foundation/PxMath.h"
+
+using namespace physx;
+using namespace Gu;
+
+static const PxU32 gMinChunkSize = 64*1024;
+
+CookingScratch::CookingScratch() : mCurrentChunk(0), mCurrentOffset(0)
+{
+}
+
+CookingScratch::~CookingScratch()
+{
+	releaseChunks();
+}
+
+void CookingScratch::releaseChunks()
+{
+	for(PxU32 i=0;i<mChunks.size();i++)
+		PX_FREE(mChunks[i].mMemory);
+	mChunks.clear();
+}
+
+void* CookingScratch::alloc(PxU32 size)
+{
+	size = (size + 15) & ~15;
+
+	while(mCurrentChunk<mChunks.size())
+	{
+		Chunk& chunk = mChunks[mCurrentChunk];
+		if(mCurrentOffset + size <= chunk.mSize)
+		{
+			void* memory = chunk.mMemory + mCurrentOffset;
+			mCurrentOffset += size;
+			return memory;
+		}
+		mCurrentChunk++;
+		mCurrentOffset = 0;
+	}
+
+	const PxU32 lastSize = mChunks.size() ? mChunks.back().mSize : 0;
+	Chunk chunk;
+	chunk.mSize = PxMax(PxMax(size, lastSize*2), gMinChunkSize);
+	chunk.mMemory = reinterpret_cast<PxU8*>(PX_ALLOC(chunk.mSize, "CookingScratch"));
+	mChunks.pushBack(chunk);
+
+	mCurrentChunk = mChunks.size() - 1;
+	mCurrentOffset = size;
+	return chunk.mMemory;
+}
+
+void CookingScratch::reset()
+{
+	if(mChunks.size()>1)
+	{
+		PxU32 totalSize = 0;
+		for(PxU32 i=0;i<mChunks.size();i++)
+			totalSize += mChunks[i].mSize;
+
+		releaseChunks();
+
+		Chunk chunk;
+		chunk.mSize = totalSize;
+		chunk.mMemory = reinterpret_cast<PxU8*>(PX_ALLOC(totalSize, "CookingScratch"));
+		mChunks.pushBack(chunk);
+	}
+	mCurrentChunk = 0;
+	mCurrentOffset = 0;
+}
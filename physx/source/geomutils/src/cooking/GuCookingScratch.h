@@ -0,0 +1,88 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_COOKING_SCRATCH_H
+#define GU_COOKING_SCRATCH_H
+
+#include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: linear allocator for the temporary buffers of convex hull cooking. Individual allocations are never freed, the
+	// whole arena is rewound with reset() once a hull has been cooked. When several hulls are cooked one after the other on
+	// the same thread, the memory of the first hull is reused for the next ones instead of going through the allocator.
+	class CookingScratch : public PxUserAllocated
+	{
+		PX_NOCOPY(CookingScratch)
+	public:
+								CookingScratch();
+								~CookingScratch();
+
+		// returns 16-byte aligned memory, valid until the next reset()
+				void*			alloc(PxU32 size);
+
+		// makes all the memory available again. If the previous hull needed more than one chunk, the chunks are merged
+		// into a single one large enough for it.
+				void			reset();
+
+	private:
+		struct Chunk
+		{
+			PxU8*	mMemory;
+			PxU32	mSize;
+		};
+				void			releaseChunks();
+
+				PxArray<Chunk>	mChunks;
+				PxU32			mCurrentChunk;
+				PxU32			mCurrentOffset;
+	};
+
+	template<class T>
+	PX_FORCE_INLINE T* allocateScratch(CookingScratch* scratch, PxU32 nb, const char* name)
+	{
+		if(scratch)
+			return reinterpret_cast<T*>(scratch->alloc(PxU32(sizeof(T))*nb));
+		return PX_ALLOCATE(T, nb, name);
+	}
+
+	template<class T>
+	PX_FORCE_INLINE void freeScratch(CookingScratch* scratch, T*& memory)
+	{
+		if(scratch)
+			memory = NULL;
+		else
+			PX_FREE(memory);
+	}
+}
+}
+
+#endif
@@ -653,7 +653,7 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 }
 
 
-bool Gu::BuildBV32Ex(BV32Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivesPerLeaf)
+bool Gu::BuildBV32Ex(BV32Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivesPerLeaf, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbPrimitives = mesh.getNbPrimitives();
 
@@ -662,7 +662,7 @@ bool Gu::BuildBV32Ex(BV32Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32
 		GU_PROFILE_ZONE("..BuildBV32Ex_buildFromMesh")
 
 //		if (!Source.buildFromMesh(mesh, nbPrimitivesPerLeaf, BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER))
-		if (!Source.buildFromMesh(mesh, nbPrimitivesPerLeaf, BV4_SAH))
+		if (!Source.buildFromMesh(mesh, nbPrimitivesPerLeaf, BV4_SAH, dispatcher))
 			return false;
 	}
 
@@ -36,12 +36,14 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 	namespace Gu
 	{
 		class BV32Tree;
 		class SourceMeshBase;
 
-		bool BuildBV32Ex(BV32Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivesPerLeaf);
+		bool BuildBV32Ex(BV32Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivesPerLeaf, PxCpuDispatcher* dispatcher=NULL);
 
 	} // namespace Gu
 }
@@ -28,12 +28,14 @@
 
 #include "foundation/PxVec4.h"
 #include "foundation/PxMemory.h"
+#include "task/PxCpuDispatcher.h"
 #include "GuAABBTreeBuildStats.h"
 #include "GuAABBTree.h"
 #include "GuSAH.h"
 #include "GuBounds.h"
 #include "GuBV4Build.h"
 #include "GuBV4.h"
+#include "CmParallelFor.h"
 #include <stdio.h>
 
 using namespace physx;
@@ -247,7 +249,7 @@ static bool local_Subdivide(AABBTreeNode* PX_RESTRICT node, BuildStats& stats, c
 	return true;
 }
 
-static bool local_Subdivide_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats& stats, const BuildParams& params, SAH_Buffers& buffers)
+static bool local_Subdivide_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats& stats, const BuildParams& params, SAH_Buffers& buffers, PxCpuDispatcher* dispatcher)
 {
 	const PxU32* prims = node->mNodePrimitives;
 	const PxU32 nb = node->mNbPrimitives;
@@ -268,7 +270,7 @@ static bool local_Subdivide_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats& stat
 #endif
 
 	PxU32 leftCount;
-	if(!buffers.split(leftCount, nb, prims, boxes, centers))
+	if(!buffers.split(leftCount, nb, prims, boxes, centers, dispatcher))
 	{
 		// Invalid split => fallback to previous strategy
 		return local_Subdivide(node, stats, params);
@@ -316,7 +318,7 @@ static void local_BuildHierarchy(AABBTreeNode* PX_RESTRICT node, BuildStats& sta
 
 static void local_BuildHierarchy_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats& stats, const BuildParams& params, SAH_Buffers& buffers)
 {
-	if(local_Subdivide_SAH(node, stats, params, buffers))
+	if(local_Subdivide_SAH(node, stats, params, buffers, NULL))
 	{
 		AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
 		AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
@@ -325,24 +327,112 @@ static void local_BuildHierarchy_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats&
 	}
 }
 
-bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy)
+namespace
 {
-	const PxU32 nbBoxes = mesh.getNbPrimitives();
-	if(!nbBoxes)
-		return false;
-	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, (nbBoxes + 1), "BV4");	// PT: +1 to safely V4Load/V4Store the last element
-	PxVec3* centers = PX_ALLOCATE(PxVec3, (nbBoxes + 1), "BV4");		// PT: +1 to safely V4Load/V4Store the last element
+	struct PrimitiveBoxesParams
+	{
+		SourceMeshBase*	mMesh;
+		PxBounds3*		mBoxes;
+		PxVec3*			mCenters;
+	};
+
+	struct SubtreesParams
+	{
+		AABBTreeNode* const*	mRoots;
+		const PxU32*			mRegionStarts;
+		PxU32*					mNbNodes;
+		AABBTreeNode*			mPool;
+		const PxBounds3*		mBoxes;
+		const PxVec3*			mCenters;
+		const SourceMesh*		mMesh;
+		PxU32					mLimit;
+		BV4_BuildStrategy		mStrategy;
+	};
+}
+
+static void computePrimitiveBoxes(void* userData, PxU32 start, PxU32 end)
+{
+	const PrimitiveBoxesParams& params = *reinterpret_cast<const PrimitiveBoxesParams*>(userData);
+	PxBounds3* boxes = params.mBoxes;
+	PxVec3* centers = params.mCenters;
 	const FloatV halfV = FLoad(0.5f);
-	for (PxU32 i = 0; i<nbBoxes; i++)
+	// PT: the 16-byte stores below spill into the next element, which is overwritten by the next iteration. The last
+	// element of a batch is stored separately since the next one belongs to another batch, possibly already written.
+	const PxU32 last = end - 1;
+	for(PxU32 i=start; i<last; i++)
 	{
 		Vec4V minV, maxV;
-		mesh.getPrimitiveBox(i, minV, maxV);
+		params.mMesh->getPrimitiveBox(i, minV, maxV);
 
 		V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
-		V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because we allocated one more box
+		V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because the next box is written afterwards
 
 		const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
-		V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because we allocated one more PxVec3
+		V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because the next PxVec3 is written afterwards
+	}
+
+	{
+		Vec4V minV, maxV;
+		params.mMesh->getPrimitiveBox(last, minV, maxV);
+
+		PX_ALIGN_PREFIX(16) PxVec4 tmpMax PX_ALIGN_SUFFIX(16);
+		PX_ALIGN_PREFIX(16) PxVec4 tmpCenter PX_ALIGN_SUFFIX(16);
+		V4StoreU_Safe(minV, &boxes[last].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
+		V4StoreA_Safe(maxV, &tmpMax.x);
+		V4StoreA_Safe(V4Scale(V4Add(maxV, minV), halfV), &tmpCenter.x);
+		boxes[last].maximum = tmpMax.getXYZ();
+		centers[last] = tmpCenter.getXYZ();
+	}
+}
+
+// PT: builds the subtrees below the nodes produced by the serial top-level splits. Each subtree only touches its own
+// range of primitives and allocates its nodes from its own region of the pool. Since the node pointers are the only
+// link between nodes, the resulting tree is the same as the one built recursively on a single thread.
+static void buildSubtrees(void* userData, PxU32 start, PxU32 end)
+{
+	const SubtreesParams& params = *reinterpret_cast<const SubtreesParams*>(userData);
+	for(PxU32 i=start; i<end; i++)
+	{
+		AABBTreeNode* root = params.mRoots[i];
+
+		BuildStats stats;
+		const BuildParams buildParams(params.mBoxes, params.mCenters, params.mPool + params.mRegionStarts[i], params.mLimit, params.mMesh);
+		if(params.mStrategy==BV4_SAH)
+		{
+			SAH_Buffers sah(root->mNbPrimitives);
+			local_BuildHierarchy_SAH(root, stats, buildParams, sah);
+		}
+		else
+			local_BuildHierarchy(root, stats, buildParams);
+
+		params.mNbNodes[i] = stats.getCount();
+	}
+}
+
+static const PxU32 gMinNbPrimsForParallelBuild = 16384;
+static const PxU32 gMinNbPrimsPerSubtree = 2048;
+static const PxU32 gMaxNbSubtrees = 64;
+
+bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
+{
+	const PxU32 nbBoxes = mesh.getNbPrimitives();
+	if(!nbBoxes)
+		return false;
+
+	if(strategy!=BV4_SPLATTER_POINTS && strategy!=BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER && strategy!=BV4_SAH)
+		return false;
+
+	if(nbBoxes<gMinNbPrimsForParallelBuild)
+		dispatcher = NULL;
+
+	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, (nbBoxes + 1), "BV4");	// PT: +1 to safely V4Load/V4Store the last element
+	PxVec3* centers = PX_ALLOCATE(PxVec3, (nbBoxes + 1), "BV4");		// PT: +1 to safely V4Load/V4Store the last element
+	{
+		PrimitiveBoxesParams params;
+		params.mMesh	= &mesh;
+		params.mBoxes	= boxes;
+		params.mCenters	= centers;
+		Cm::parallelFor(dispatcher, nbBoxes, gMinNbPrimsPerSubtree, computePrimitiveBoxes, &params);
 	}
 
 	{
@@ -359,34 +449,102 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 		for (PxU32 i = 0; i<nbBoxes; i++)
 			mIndices[i] = i;
 
+		// PT: in the multi-threaded case the top of the tree is built first, then each subtree gets its own region
+		// of the pool. A subtree over N primitives needs at most 2*N-2 nodes below its root, so the top-level nodes
+		// are the only extra memory needed.
+		const PxU32 nbSubtrees = dispatcher ? PxMin(gMaxNbSubtrees, (dispatcher->getWorkerCount() + 1) * 4) : 0;
+		const PxU32 topRegionSize = nbSubtrees ? nbSubtrees * 2 - 1 : 0;
+
 		// Use a linear array for complete trees (since we can predict the final number of nodes) [Opcode 1.3]
 		// Allocate a pool of nodes
 		// PT: TODO: optimize memory here (TA34704)
-		mPool = PX_NEW(AABBTreeNode)[nbBoxes * 2 - 1];
+		mPool = PX_NEW(AABBTreeNode)[nbBoxes * 2 - 1 + topRegionSize];
 
 		// Setup initial node. Here we have a complete permutation of the app's primitives.
 		mPool->mNodePrimitives = mIndices;
 		mPool->mNbPrimitives = nbBoxes;
 
+		// PT: not sure what the equivalent would be for tet-meshes here
+		SourceMesh* triMesh = NULL;
+		if(strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+		{
+			if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
+				triMesh = static_cast<SourceMesh*>(&mesh);
+		}
+
 		// Build the hierarchy
-		if(strategy==BV4_SPLATTER_POINTS||strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+		if(!dispatcher)
 		{
-			// PT: not sure what the equivalent would be for tet-meshes here
-			SourceMesh* triMesh = NULL;
-			if(strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+			if(strategy==BV4_SAH)
 			{
-				if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
-					triMesh = static_cast<SourceMesh*>(&mesh);
+				SAH_Buffers sah(nbBoxes);
+				local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
 			}
-			local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
+			else
+				local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
 		}
-		else if(strategy==BV4_SAH)
+		else
 		{
-			SAH_Buffers sah(nbBoxes);
-			local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			// PT: split the largest nodes until we have enough subtrees
+			AABBTreeNode* roots[gMaxNbSubtrees];
+			PxU32 nbRoots = 1;
+			roots[0] = mPool;
+			{
+				const BuildParams topParams(boxes, centers, mPool, limit, triMesh);
+				SAH_Buffers* sah = strategy==BV4_SAH ? PX_NEW(SAH_Buffers)(nbBoxes, true) : NULL;
+				while(nbRoots<nbSubtrees)
+				{
+					PxU32 largest = 0xffffffff;
+					PxU32 largestNb = gMinNbPrimsPerSubtree;
+					for(PxU32 i=0;i<nbRoots;i++)
+					{
+						if(roots[i]->mNbPrimitives>largestNb)
+						{
+							largestNb = roots[i]->mNbPrimitives;
+							largest = i;
+						}
+					}
+					if(largest==0xffffffff)
+						break;
+
+					AABBTreeNode* node = roots[largest];
+					const bool split = sah ? local_Subdivide_SAH(node, Stats, topParams, *sah, dispatcher) : local_Subdivide(node, Stats, topParams);
+					if(split)
+					{
+						roots[largest] = const_cast<AABBTreeNode*>(node->getPos());
+						roots[nbRoots++] = const_cast<AABBTreeNode*>(node->getNeg());
+					}
+					else
+						roots[largest] = roots[--nbRoots];
+				}
+				PX_DELETE(sah);
+				PX_ASSERT(Stats.getCount()<=topRegionSize);
+			}
+
+			PxU32 regionStarts[gMaxNbSubtrees];
+			PxU32 nbNodes[gMaxNbSubtrees];
+			PxU32 regionStart = topRegionSize;
+			for(PxU32 i=0;i<nbRoots;i++)
+			{
+				regionStarts[i] = regionStart;
+				regionStart += roots[i]->mNbPrimitives * 2 - 2;
+			}
+
+			SubtreesParams params;
+			params.mRoots			= roots;
+			params.mRegionStarts	= regionStarts;
+			params.mNbNodes			= nbNodes;
+			params.mPool			= mPool;
+			params.mBoxes			= boxes;
+			params.mCenters			= centers;
+			params.mMesh			= triMesh;
+			params.mLimit			= limit;
+			params.mStrategy		= strategy;
+			Cm::parallelFor(dispatcher, nbRoots, 1, buildSubtrees, &params);
+
+			for(PxU32 i=0;i<nbRoots;i++)
+				Stats.increaseCount(nbNodes[i]);
 		}
-		else
-			return false;
 
 		// Get back total number of nodes
 		mTotalNbNodes = Stats.getCount();
@@ -1820,7 +1978,7 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 	return true;
 }
 
-bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy)
+bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	//either number of triangle or number of tetrahedron
 	const PxU32 nbPrimitives = mesh.getNbPrimitives();
@@ -1828,7 +1986,7 @@ bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, P
 	BV4_AABBTree Source;
 	{
 		GU_PROFILE_ZONE("..BuildBV4Ex_buildFromMesh")
-		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy))
+		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy, dispatcher))
 			return false;
 	}
 
@@ -106,6 +106,10 @@ struct PxvSimStats
 
 	PxU32	mNbPartitions;
 
+	PxU32	mNbCCDSweeps;
+	PxU32	mNbCCDToiHits;
+	PxU32	mNbCCDPasses;
+
 	PxU64 	mGpuDynamicsTempBufferCapacity;
 	PxU32	mGpuDynamicsRigidContactCount;
 	PxU32	mGpuDynamicsRigidPatchCount;
@@ -30,6 +30,7 @@
 #define PXC_CONTACT_CACHE_H
 
 #include "foundation/PxTransform.h"
+#include "foundation/PxMemory.h"
 #include "PxvConfig.h"
 #include "PxcContactMethodImpl.h"
 
@@ -60,6 +61,20 @@ namespace physx
 		}
 	};
 
+	// PT: poses of both shapes of a pair when its contacts were last generated. Unlike PxcLocalContactsCache this is
+	// persistent (it lives in a per-pair array next to the Gu::Cache) so that it can be used with any contact method.
+	// A zeroed key never matches a sane transform.
+	struct PxcRestingContactKey
+	{
+		PxTransform32	mTransform0;
+		PxTransform32	mTransform1;
+
+		PX_FORCE_INLINE void invalidate()
+		{
+			PxMemZero(this, sizeof(PxcRestingContactKey));
+		}
+	};
+
 }
 
 #endif  // PXC_CONTACT_CACHE_H
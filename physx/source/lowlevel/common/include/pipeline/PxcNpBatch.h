@@ -36,14 +36,16 @@ namespace physx
 	struct PxcNpWorkUnit;
 	class PxcNpThreadContext;
 	struct PxsContactManagerOutput;
+	struct PxcRestingContactKey;
 
 	namespace Gu
 	{
 		struct Cache;
 	}
 
-	void PxcDiscreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID);
-	void PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID);
+	// restingKey is optional (NULL disables the resting contact cache, see PxSceneFlag::eENABLE_RESTING_CONTACT_CACHE).
+	void PxcDiscreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxcRestingContactKey* restingKey, PxU64 contextID);
+	void PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxcRestingContactKey* restingKey, PxU64 contextID);
 }
 
 #endif
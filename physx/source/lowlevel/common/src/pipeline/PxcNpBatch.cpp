@@ -316,9 +316,36 @@ static bool finishContacts(const PxcNpWorkUnit& input, PxsContactManagerOutput&
 	return res;
 }
 
+// PT: tolerances of the resting contact cache. The reused contacts are not updated at all so these are smaller than the
+// ones used by PxcCacheLocalContacts. Positions are scaled by PxTolerancesScale::length, rotations are quaternion components
+// (1e-3 is about 0.1 degree, i.e. about the same displacement as the linear tolerance for unit-sized shapes).
+static const PxReal gRestingContactLinearTolerance = 1e-3f;
+static const PxReal gRestingContactAngularTolerance = 1e-3f;
+
+static PX_FORCE_INLINE PxReal maxComponentDelta(const PxTransform& t0, const PxTransform& t1, PxReal angularScale)
+{
+	PxReal delta =       PxAbs(t0.p.x - t1.p.x);
+	delta = PxMax(delta, PxAbs(t0.p.y - t1.p.y));
+	delta = PxMax(delta, PxAbs(t0.p.z - t1.p.z));
+	delta = PxMax(delta, PxAbs(t0.q.x - t1.q.x) * angularScale);
+	delta = PxMax(delta, PxAbs(t0.q.y - t1.q.y) * angularScale);
+	delta = PxMax(delta, PxAbs(t0.q.z - t1.q.z) * angularScale);
+	delta = PxMax(delta, PxAbs(t0.q.w - t1.q.w) * angularScale);
+	return delta;
+}
+
+// PT: we compare absolute poses (not the relative pose as in PxcCacheLocalContacts) because the reused contacts are in world space
+static PX_FORCE_INLINE bool isResting(const PxcRestingContactKey& key, const PxTransform& tm0, const PxTransform& tm1, PxReal toleranceLength)
+{
+	const PxReal linearTolerance = gRestingContactLinearTolerance * toleranceLength;
+	const PxReal angularScale = linearTolerance / gRestingContactAngularTolerance;
+	return		maxComponentDelta(tm0, key.mTransform0, angularScale) <= linearTolerance
+			&&	maxComponentDelta(tm1, key.mTransform1, angularScale) <= linearTolerance;
+}
+
 template<bool useContactCacheT>
 static PX_FORCE_INLINE bool checkContactsMustBeGenerated(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output,
-										 const PxsCachedTransform* cachedTransform0, const PxsCachedTransform* cachedTransform1,
+										 const PxsCachedTransform* cachedTransform0, const PxsCachedTransform* cachedTransform1, const PxcRestingContactKey* restingKey,
 										 const bool flip, PxGeometryType::Enum type0, PxGeometryType::Enum type1)
 {
 	PX_ASSERT(cachedTransform0->transform.isSane() && cachedTransform1->transform.isSane());
@@ -335,7 +362,10 @@ static PX_FORCE_INLINE bool checkContactsMustBeGenerated(PxcNpThreadContext& con
 		const PxU32 active0 = PxU32(body0Dynamic && !cachedTransform0->isFrozen());
 		const PxU32 active1 = PxU32(body1Dynamic && !cachedTransform1->isFrozen());
 
-		if(!(active0 || active1))
+		const bool active = active0 || active1;
+
+		// PT: pairs that did not move (enough) since their contacts were generated reuse them, like frozen pairs
+		if(!active || (restingKey && isResting(*restingKey, cachedTransform0->transform, cachedTransform1->transform, context.mNarrowPhaseParams.mToleranceLength)))
 		{
 			if(flip)
 				PxSwap(type0, type1);
@@ -345,6 +375,11 @@ static PX_FORCE_INLINE bool checkContactsMustBeGenerated(PxcNpThreadContext& con
 #if PX_ENABLE_SIM_STATS
 			if(output.nbContacts)
 				context.mNbDiscreteContactPairsWithContacts++;
+			if(active)
+			{
+				updateDiscreteContactStats(context, type0, type1);
+				context.mNbDiscreteContactPairsWithCacheHits++;
+			}
 #else
 			PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
 #endif
@@ -365,7 +400,7 @@ static PX_FORCE_INLINE bool checkContactsMustBeGenerated(PxcNpThreadContext& con
 }
 
 template<bool useLegacyCodepath>
-static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID)
+static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output, PxcRestingContactKey* restingKey, PxU64 contextID)
 {
 	PxGeometryType::Enum type0 = input.getGeomType0();
 	PxGeometryType::Enum type1 = input.getGeomType1();
@@ -375,9 +410,15 @@ static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, con
 	const PxsCachedTransform* cachedTransform0 = &context.mTransformCache->getTransformCache(input.mTransformCache0);
 	const PxsCachedTransform* cachedTransform1 = &context.mTransformCache->getTransformCache(input.mTransformCache1);
 
-	if(!checkContactsMustBeGenerated<useLegacyCodepath>(context, input, cache, output, cachedTransform0, cachedTransform1, flip, type0, type1))
+	if(!checkContactsMustBeGenerated<useLegacyCodepath>(context, input, cache, output, cachedTransform0, cachedTransform1, restingKey, flip, type0, type1))
 		return;
 
+	// PT: the key is only recorded once the contacts have been successfully written, see below
+	if(restingKey)
+		restingKey->invalidate();
+	const PxsCachedTransform* restingTransform0 = cachedTransform0;
+	const PxsCachedTransform* restingTransform1 = cachedTransform1;
+
 	PxsShapeCore* shape0 = const_cast<PxsShapeCore*>(input.getShapeCore0());
 	PxsShapeCore* shape1 = const_cast<PxsShapeCore*>(input.getShapeCore1());
 
@@ -496,17 +537,21 @@ static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, con
 	}
 
 	const bool isMeshType = type1 > PxGeometryType::eCONVEXMESH; 
-	finishContacts(input, output, context, materialInfo, isMeshType, contextID);
+	if(finishContacts(input, output, context, materialInfo, isMeshType, contextID) && restingKey)
+	{
+		restingKey->mTransform0 = restingTransform0->transform;
+		restingKey->mTransform1 = restingTransform1->transform;
+	}
 }
 
-void physx::PxcDiscreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID)
+void physx::PxcDiscreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output, PxcRestingContactKey* restingKey, PxU64 contextID)
 {
 	LOCAL_PROFILE_ZONE("PxcDiscreteNarrowPhase", contextID);
-	discreteNarrowPhase<true>(context, input, cache, output, contextID);
+	discreteNarrowPhase<true>(context, input, cache, output, restingKey, contextID);
 }
 
-void physx::PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID)
+void physx::PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWorkUnit& input, Gu::Cache& cache, PxsContactManagerOutput& output, PxcRestingContactKey* restingKey, PxU64 contextID)
 {
 	LOCAL_PROFILE_ZONE("PxcDiscreteNarrowPhasePCM", contextID);
-	discreteNarrowPhase<false>(context, input, cache, output, contextID);
+	discreteNarrowPhase<false>(context, input, cache, output, restingKey, contextID);
 }
@@ -517,12 +517,12 @@ private:
 						void					updateCCDEnd();
 
 	/**
-	\brief Spawns the update island tasks after the initial sweep estimates have been performed
+	\brief Spawns the advance tasks, batching whole islands so that each island is estimated, advanced and reported by a single task
 	\param[in] continuation The continuation task
 	*/
-						void					postCCDSweep(PxBaseTask* continuation);
+						void					createAdvanceTasks(PxBaseTask* continuation);
 	/**
-	\brief Creates contact buffers for CCD contacts. These will be sent to the user in the contact notification.
+	\brief Updates touch status for CCD contacts. The contact buffers sent to the user in the contact notification have already been created by the advance tasks.
 	\param[in] continuation The continuation task
 	*/
 						void					postCCDAdvance(PxBaseTask* continuation);
@@ -532,11 +532,9 @@ private:
 	*/
 						void					postCCDDepenetrate(PxBaseTask* continuation);
 
-		typedef Cm::DelegateTask<PxsCCDContext, &PxsCCDContext::postCCDSweep> PostCCDSweepTask;
 		typedef Cm::DelegateTask<PxsCCDContext, &PxsCCDContext::postCCDAdvance> PostCCDAdvanceTask;
 		typedef Cm::DelegateTask<PxsCCDContext, &PxsCCDContext::postCCDDepenetrate> PostCCDDepenetrateTask;
 
-		PostCCDSweepTask mPostCCDSweepTask;
 		PostCCDAdvanceTask mPostCCDAdvanceTask;
 		PostCCDDepenetrateTask mPostCCDDepenetrateTask;
 
@@ -546,6 +544,7 @@ private:
 		bool					mDisableCCDResweep;
 		PxU32					miCCDPass;
 		PxI32					mSweepTotalHits;
+		PxI32					mSweepTotalTests;
 
 		// a fraction of objects will be CCD active so PxsCCDBody is dynamic, not a member of PxsRigidBody
 		PxsCCDBodyArray mCCDBodies;
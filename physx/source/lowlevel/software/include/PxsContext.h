@@ -158,6 +158,7 @@ public:
 	PX_FORCE_INLINE	bool						getPCM()					const	{ return mPCM;														}
 	PX_FORCE_INLINE	bool						getContactCacheFlag()		const	{ return mContactCache;												}
 	PX_FORCE_INLINE	bool						getCreateAveragePoint()		const	{ return mCreateAveragePoint;										}
+	PX_FORCE_INLINE	bool						getRestingContactCache()	const	{ return mRestingContactCache;										}
 
 	// general stuff
 					void						shiftOrigin(const PxVec3& shift);
@@ -270,6 +271,7 @@ private:
 					bool						mPCM;
 					bool						mContactCache;
 					bool						mCreateAveragePoint;
+					bool						mRestingContactCache;
 
 					PxsTransformCache*			mTransformCache;
 					const PxFloatArrayPinnedSafe*	mContactDistances;
@@ -32,6 +32,7 @@
 #include "foundation/PxAssert.h"
 #include "foundation/PxBitMap.h"
 #include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
 #include "CmPriorityQueue.h"
 #include "CmBlockArray.h"
 #include "PxNodeIndex.h"
@@ -46,6 +47,7 @@ namespace IG
 #define IG_INVALID_EDGE 0xFFFFFFFFu
 #define IG_LIMIT_DIRTY_NODES 0
 #define IG_SANITY_CHECKS 0
+#define IG_PARALLEL_SPLIT_MIN_DIRTY_NODES 128	// PT: below this number of dirty nodes, findPathsAndBreakIslands() runs on a single thread
 
 typedef PxU32 IslandId;
 typedef PxU32 EdgeIndex;
@@ -293,14 +295,14 @@ struct TraversalState
 
 struct QueueElement
 {
-	TraversalState* mState;
+	PxU32 mStateIndex;	// PT: index in TraversalContext::mVisitedNodes, which can be resized during the traversal
 	PxU32 mHopCount;
 
 	QueueElement()
 	{
 	}
 
-	QueueElement(TraversalState* state, PxU32 hopCount) : mState(state), mHopCount(hopCount)
+	QueueElement(PxU32 stateIndex, PxU32 hopCount) : mStateIndex(stateIndex), mHopCount(hopCount)
 	{
 	}
 };
@@ -319,6 +321,42 @@ private:
 	NodeComparator& operator = (const NodeComparator&);
 };
 
+// PT: a new island found by IslandSim::findPathsAndBreakIslands(). Handles for new islands are only allocated afterwards,
+// in the order of the dirty nodes, so that they do not depend on how the dirty islands were distributed among threads.
+struct IslandSplit
+{
+	Island		mIsland;			// Root node, last node, nodes & edges of the new island. The active index is not used.
+	IslandId	mParentIslandId;	// The island the new island has been split from
+	PxU32		mStaticTouchCount;
+	PxU32		mDirtyNodeOrder;	// Position of the new root node in the list of processed dirty nodes
+};
+
+// PT: transient data used for traversals. There is one context per thread when dirty islands are processed in parallel.
+// A context only touches the per-node data of the islands it processes, so contexts never write to the same nodes.
+struct TraversalContext : public PxUserAllocated
+{
+	TraversalContext() : mVisitedNodes("IslandSim::mVisitedNodes"), mNbHops(0), mNbIslands(0)
+	{
+	}
+
+	Cm::PriorityQueue<QueueElement, NodeComparator>	mPriorityQueue;								//! Priority queue used for graph traversal
+	PxArray<TraversalState>							mVisitedNodes;								//! The list of nodes visited in the current traversal
+	PxBitMap										mVisitedState;								//! Indicates whether a node has been visited
+	PxArray<EdgeIndex>								mIslandSplitEdges[Edge::eEDGE_TYPE_COUNT];
+	PxArray<IslandSplit>							mIslandSplits;								//! New islands found by this context
+	PxU32											mNbHops;									//! Number of nodes visited by the traversals
+	PxU32											mNbIslands;									//! Number of dirty islands processed
+};
+
+// PT: per-frame counters for IslandSim::findPathsAndBreakIslands()
+struct IslandSplitStats
+{
+	PxU32	mNbDirtyNodes;	//! Number of dirty nodes that needed a traversal
+	PxU32	mNbIslands;		//! Number of islands containing these dirty nodes
+	PxU32	mNbSplits;		//! Number of new islands created
+	PxU32	mNbHops;		//! Number of nodes visited by the traversals
+};
+
 // PT: island-manager data used by both CPU & GPU code.
 // This is managed by external code (e.g. SimpleIslandManager) and passed as const data to IslandSim.
 class CPUExternalData
@@ -425,12 +463,23 @@ class IslandSim
 	PxArray<PxNodeIndex>							mActivatingNodes;
 	PxArray<EdgeIndex>								mDestroyedEdges;
 
-	//Temporary, transient data used for traversals. TODO - move to PxsSimpleIslandManager. Or if we keep it here, we can 
-	//process multiple island simulations in parallel
-	Cm::PriorityQueue<QueueElement, NodeComparator>	mPriorityQueue;								//! Priority queue used for graph traversal
-	PxArray<TraversalState>							mVisitedNodes;								//! The list of nodes visited in the current traversal
-	PxBitMap										mVisitedState;								//! Indicates whether a node has been visited
-	PxArray<EdgeIndex>								mIslandSplitEdges[Edge::eEDGE_TYPE_COUNT];
+	//Temporary, transient data used for traversals. One context per task processing dirty islands.
+	PxArray<TraversalContext*>						mTraversalContexts;
+	PxU32											mNbTraversalTasks;							//! Number of contexts used this frame
+
+	//Dirty nodes processed this frame, grouped per island. Each dirty island is a unit of work for findPathsAndBreakIslands().
+	struct DirtyIsland
+	{
+		IslandId	mIslandId;
+		PxU32		mStart;			//! Start index in mDirtyNodesPerIsland
+		PxU32		mNbDirtyNodes;
+	};
+	PxArray<PxU32>									mDirtyNodes;								//! Dirty nodes to process, in processing order
+	PxArray<PxU32>									mDirtyNodesPerIsland;						//! Indices in mDirtyNodes, grouped per island
+	PxArray<DirtyIsland>							mDirtyIslands;
+	PxArray<PxU32>									mIslandToDirtyIsland;						//! Per-island index in mDirtyIslands, transient
+	PxI32											mNextDirtyIsland;							//! Next dirty island to process, shared between tasks
+	IslandSplitStats								mIslandSplitStats;
 
 	PxArray<EdgeIndex>								mDeactivatingEdges[Edge::eEDGE_TYPE_COUNT];
 public:
@@ -444,7 +493,7 @@ protected:
 public:
 
 	IslandSim(const CPUExternalData& cpuData, GPUExternalData* gpuData, PxU64 contextID);
-	~IslandSim() {}
+	~IslandSim();
 
 	void addNode(bool isActive, bool isKinematic, Node::NodeType type, PxNodeIndex nodeIndex, void* object);
 
@@ -560,6 +609,18 @@ public:
 	void removeDestroyedEdges();	// PT: this is always followed by a call to processLostEdges(). Merge the two?
 	void processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation, PxU32 dirtyNodeLimit);
 
+	// PT: processLostEdges() in three parts, so that the route-finding can run on multiple threads:
+	// - processLostEdgesPart1() removes lost edges from their islands and groups dirty nodes per island. It returns the number
+	//   of calls to findPathsAndBreakIslands() to make, from 0 to maxNbTasks.
+	// - findPathsAndBreakIslands() can then run concurrently for contextIndex = 0..returned value-1.
+	// - processLostEdgesPart2() registers the new islands in dirty node order and finishes the work serially.
+	// The results do not depend on the number of tasks.
+	PxU32 processLostEdgesPart1(bool allowDeactivation, PxU32 dirtyNodeLimit, PxU32 maxNbTasks);
+	void findPathsAndBreakIslands(PxU32 contextIndex);
+	void processLostEdgesPart2(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation);
+
+	PX_FORCE_INLINE const IslandSplitStats&	getIslandSplitStats()	const	{ return mIslandSplitStats;	}
+
 private:
 	void wakeIslandsInternal(bool flag);
 
@@ -575,7 +636,7 @@ private:
 
 	void mergeIslandsInternal(Island& island0, Island& island1, IslandId islandId0, IslandId islandId1, PxNodeIndex node0, PxNodeIndex node1);
 	
-	void unwindRoute(PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id);
+	void unwindRoute(TraversalContext& context, PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id);
 
 	void activateIslandInternal(const Island& island);
 
@@ -586,9 +647,11 @@ private:
 #if IG_SANITY_CHECKS
 	bool canFindRoot(PxNodeIndex startNode, PxNodeIndex targetNode, PxArray<PxNodeIndex>* visitedNodes);
 #endif
-	bool tryFastPath(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
+	bool tryFastPath(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
+
+	bool findRoute(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
 
-	bool findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId);
+	void breakIsland(TraversalContext& context, const DirtyIsland& dirtyIsland);
 
 #if PX_DEBUG
 	bool isPathTo(PxNodeIndex startNode, PxNodeIndex targetNode)	const;
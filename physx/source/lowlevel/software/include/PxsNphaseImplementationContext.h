@@ -32,6 +32,7 @@
 #include "PxvNphaseImplementationContext.h" 
 #include "PxsContactManagerState.h"
 #include "PxcNpCache.h"
+#include "PxcContactCache.h"
 #include "foundation/PxPinnedArray.h"
 
 class PxsCMDiscreteUpdateTask;
@@ -44,6 +45,7 @@ struct PxsContactManagers : PxsContactManagerBase
 	PxArray<PxsContactManagerOutput>	mOutputContactManagers;
 	PxArray<PxsContactManager*>			mContactManagerMapping;
 	PxArray<Gu::Cache>					mCaches;
+	PxArray<PxcRestingContactKey>		mRestingKeys;	// PT: only used with PxSceneFlag::eENABLE_RESTING_CONTACT_CACHE
 
 	// PT: these buffers should be in pinned memory but may not be if pinned allocation failed.
 	PxPinnedArraySafe<const Sc::ShapeInteraction*>	mShapeInteractionsGPU;
@@ -54,6 +56,7 @@ struct PxsContactManagers : PxsContactManagerBase
 		mOutputContactManagers	("mOutputContactManagers"),
 		mContactManagerMapping	("mContactManagerMapping"),
 		mCaches					("mCaches"),
+		mRestingKeys			("mRestingKeys"),
 		mShapeInteractionsGPU	(callback),
 		mRestDistancesGPU		(callback),
 		mTorsionalPropertiesGPU	(callback)
@@ -65,6 +68,7 @@ struct PxsContactManagers : PxsContactManagerBase
 		mOutputContactManagers.forceSize_Unsafe(0);
 		mContactManagerMapping.forceSize_Unsafe(0);
 		mCaches.forceSize_Unsafe(0);
+		mRestingKeys.forceSize_Unsafe(0);
 		mShapeInteractionsGPU.forceSize_Unsafe(0);
 		mRestDistancesGPU.forceSize_Unsafe(0);
 		mTorsionalPropertiesGPU.forceSize_Unsafe(0);
@@ -83,6 +83,11 @@ namespace physx
 {
 	class PxsContactManager;
 
+namespace Cm
+{
+	class FlushPool;
+}
+
 // PT: TODO: fw declaring an Sc class here is not good
 namespace Sc
 {
@@ -98,10 +103,32 @@ namespace IG
 {
 	class SimpleIslandManager;
 
+// PT: finishes the third pass once the dirty islands have been processed on multiple threads
+class ThirdPassFinalizeTask : public Cm::Task
+{
+	SimpleIslandManager& mIslandManager;
+	IslandSim& mIslandSim;
+
+public:
+
+	ThirdPassFinalizeTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim);
+
+	virtual void runInternal();
+
+	virtual const char* getName() const
+	{
+		return "ThirdPassIslandGenFinalizeTask";
+	}
+
+private:
+	PX_NOCOPY(ThirdPassFinalizeTask)
+};
+
 class ThirdPassTask : public Cm::Task
 {
 	SimpleIslandManager& mIslandManager;
 	IslandSim& mIslandSim;
+	ThirdPassFinalizeTask mFinalizeTask;
 
 public:
 
@@ -171,6 +198,7 @@ class SimpleIslandManager : public PxUserAllocated
 	ThirdPassTask mAccurateThirdPassTask;
 
 	PostThirdPassTask mPostThirdPassTask;
+	Cm::FlushPool* mTaskPool;	// PT: for the tasks processing dirty islands in the third pass
 	PxU32 mMaxDirtyNodesPerFrame;
 
 	const PxU64	mContextID;
@@ -203,7 +231,7 @@ public:
 	void secondPassIslandGen();
 	void secondPassIslandGenPart1();
 	void secondPassIslandGenPart2();
-	void thirdPassIslandGen(PxBaseTask* continuation);
+	void thirdPassIslandGen(PxBaseTask* continuation, Cm::FlushPool& taskPool);
 
 	PX_INLINE void clearDestroyedPartitionEdges()
 	{
@@ -247,6 +275,7 @@ public:
 private:
 
 	friend class ThirdPassTask;
+	friend class ThirdPassFinalizeTask;
 	friend class PostThirdPassTask;
 
 	bool		validateDeactivations() const;
@@ -348,12 +348,12 @@ static void getLastCCDAbsPose(PxTransform32& out, const PxsCCDShape* ccdShape, c
 }
 
 PxsCCDContext::PxsCCDContext(PxsContext* context, Dy::ThresholdStream& thresholdStream, PxvNphaseImplementationContext& nPhaseContext, PxReal ccdThreshold) :
-	mPostCCDSweepTask		(context->getContextId(), this, "PxsContext.postCCDSweep"),
 	mPostCCDAdvanceTask		(context->getContextId(), this, "PxsContext.postCCDAdvance"),
 	mPostCCDDepenetrateTask	(context->getContextId(), this, "PxsContext.postCCDDepenetrate"),
 	mDisableCCDResweep		(false),
 	miCCDPass				(0),
 	mSweepTotalHits			(0),
+	mSweepTotalTests		(0),
 	mCCDThreadContext		(NULL),
 	mCCDPairsPerBatch		(0),
 	mCCDMaxPasses			(1),
@@ -927,45 +927,95 @@ struct ToiPtrCompare
 	}
 };
 
-// --------------------------------------------------------------
-/**
-\brief Class to perform a set of sweep estimate tasks
-*/
-class PxsCCDSweepTask : public Cm::Task
+static PX_FORCE_INLINE bool shouldCreateContactReports(const PxsRigidCore* rigidCore)
 {
-	PxsCCDPair**	mPairs;
-	PxU32			mNumPairs;
-	PxReal			mCCDThreshold;
-public:
-	PxsCCDSweepTask(PxU64 contextID, PxsCCDPair** pairs, PxU32 nPairs, PxReal ccdThreshold) :
-		Cm::Task(contextID), mPairs(pairs), mNumPairs(nPairs), mCCDThreshold(ccdThreshold)
-	{
-	}
+	return static_cast<const PxsBodyCore*>(rigidCore)->contactReportThreshold != PXV_CONTACT_REPORT_DISABLED;
+}
 
-	virtual void runInternal()
+static PX_FORCE_INLINE bool needsCCDContactReports(const PxcNpWorkUnit& npUnit)
+{
+	return npUnit.mFlags & PxcNpWorkUnitFlag::eOUTPUT_CONTACTS
+		|| (npUnit.mFlags & PxcNpWorkUnitFlag::eFORCE_THRESHOLD
+			&& ((npUnit.mFlags & (PxcNpWorkUnitFlag::eDYNAMIC_BODY0 | PxcNpWorkUnitFlag::eARTICULATION_BODY0) && shouldCreateContactReports(npUnit.mRigidCore0))
+		|| (npUnit.mFlags & (PxcNpWorkUnitFlag::eDYNAMIC_BODY1 | PxcNpWorkUnitFlag::eARTICULATION_BODY1)  && shouldCreateContactReports(npUnit.mRigidCore1))));
+}
+
+// PT: writes the contact stream reported to users for a CCD contact. This only touches the pair's own work unit
+// and allocates from the given thread context, so it can run in the advance tasks.
+static void writeCCDContactStream(const PxsCCDPair& p, PxcNpThreadContext* threadContext)
+{
+	PxcNpWorkUnit& npUnit = p.mCm->getWorkUnit();
+
+	const PxU32 numContacts = 1;
+	PxsMaterialInfo matInfo;
+	PxContactBuffer& buffer = threadContext->mContactBuffer;
+
+	PxContactPoint& cp = buffer.contacts[0];
+	cp.point = p.mMinToiPoint;
+	cp.normal = -p.mMinToiNormal;						//KS - discrete contact gen produces contacts pointing in the opposite direction to CCD sweeps
+	cp.internalFaceIndex1 = p.mFaceIndex;
+	cp.separation = 0.0f;
+	cp.restitution = p.mRestitution;
+	cp.dynamicFriction = p.mDynamicFriction;
+	cp.staticFriction = p.mStaticFriction;
+	cp.targetVel = PxVec3(0.0f);
+	cp.maxImpulse = PX_MAX_REAL;
+	
+	matInfo.mMaterialIndex0 = p.mMaterialIndex0;
+	matInfo.mMaterialIndex1 = p.mMaterialIndex1;
+
+	//Write contact stream for the contact. This will allocate memory for the contacts and forces
+	PxReal* contactForces;
+	//PxU8* contactStream;
+	PxU8* contactPatches;
+	PxU8* contactPoints;
+	PxU16 contactStreamSize;
+	PxU16 contactCount;
+	PxU8 nbPatches;
+	PxU8* unusedU8Ptr = NULL;
+	PxsCCDContactHeader* ccdHeader = reinterpret_cast<PxsCCDContactHeader*>(npUnit.mCCDContacts);
+	if (writeCompressedContact(buffer.contacts, numContacts, threadContext, contactCount, contactPatches,
+		contactPoints, contactStreamSize, contactForces, numContacts*sizeof(PxReal), unusedU8Ptr, NULL, threadContext->mMaterialManager,
+								((npUnit.mFlags & PxcNpWorkUnitFlag::eMODIFIABLE_CONTACT) != 0), true, &matInfo, nbPatches, sizeof(PxsCCDContactHeader),NULL, NULL,
+								false, NULL, NULL, NULL, p.mFaceIndex != PXC_CONTACT_NO_FACE_INDEX))
 	{
-		for (PxU32 j = 0; j < mNumPairs; j++)
+		PxsCCDContactHeader* newCCDHeader = reinterpret_cast<PxsCCDContactHeader*>(contactPatches);
+		newCCDHeader->contactStreamSize = PxTo16(contactStreamSize);
+		newCCDHeader->isFromPreviousPass = 0;
+
+		npUnit.mCCDContacts = contactPatches;	// put the latest stream at the head of the linked list since it needs to get accessed every CCD pass
+												// to prepare the reports
+
+		if (!ccdHeader)
+			newCCDHeader->nextStream = NULL;
+		else
 		{
-			PxsCCDPair& pair = *mPairs[j];
-			pair.sweepEstimateToi(mCCDThreshold);
-			pair.mEstimatePass = 0;
+			newCCDHeader->nextStream = ccdHeader;
+			ccdHeader->isFromPreviousPass = 1;
 		}
-	}
 
-	virtual const char *getName() const
+		//And write the force and contact count
+		PX_ASSERT(contactForces != NULL);
+		contactForces[0] = p.mAppliedForce;
+	}
+	else if (!ccdHeader)
 	{
-		return "PxsContext.CCDSweep";
+		npUnit.mCCDContacts = NULL;
+		// we do not set the status flag on failure because the pair might have written
+		// a contact stream sucessfully during discrete collision this frame.
 	}
-
-private:
-	PxsCCDSweepTask& operator=(const PxsCCDSweepTask&);
-};
+	else
+		ccdHeader->isFromPreviousPass = 1;
+}
 
 #define ENABLE_RESWEEP 1
 
 // --------------------------------------------------------------
 /**
-\brief Class to advance a set of islands
+\brief Class to sweep and advance a set of islands.
+
+Each island goes through the TOI estimates of its pairs, the advance to the earliest TOIs and the writing of the CCD contact
+streams without waiting for the other islands: islands do not share any dynamic body, so they can progress independently.
 */
 class PxsCCDAdvanceTask : public Cm::Task
 {
@@ -984,6 +1034,7 @@ class PxsCCDAdvanceTask : public Cm::Task
 	PxsCCDBody**			mIslandBodies;
 	PxU16*					mNumIslandBodies;
 	PxI32*					mSweepTotalHits;
+	PxI32*					mSweepTotalTests;
 	bool					mClipTrajectory;
 	bool					mDisableResweep;
 	
@@ -993,11 +1044,11 @@ public:
 				PxsContext* context, PxsCCDContext* ccdContext, PxReal dt, PxU32 ccdPass,
 				PxU32 firstIslandPair, PxU32 firstThreadIsland, PxU32 islandsPerThread, PxU32 totalIslands, 
 				PxsCCDBody** islandBodies, PxU16* numIslandBodies, bool clipTrajectory, bool disableResweep,
-				PxI32* sweepTotalHits)
+				PxI32* sweepTotalHits, PxI32* sweepTotalTests)
 		:	Cm::Task(context->getContextId()), mCCDPairs(pairs), mNumPairs(nPairs), mContext(context), mCCDContext(ccdContext), mDt(dt),
 			mCCDPass(ccdPass), mCCDBodies(ccdBodies), mFirstThreadIsland(firstThreadIsland), 
 			mIslandsPerThread(islandsPerThread), mTotalIslandCount(totalIslands), mFirstIslandPair(firstIslandPair),
-			mIslandBodies(islandBodies), mNumIslandBodies(numIslandBodies),	mSweepTotalHits(sweepTotalHits),
+			mIslandBodies(islandBodies), mNumIslandBodies(numIslandBodies),	mSweepTotalHits(sweepTotalHits), mSweepTotalTests(sweepTotalTests),
 			mClipTrajectory(clipTrajectory), mDisableResweep(disableResweep)
 			
 	{
@@ -1007,6 +1058,7 @@ public:
 	virtual void runInternal()
 	{
 		PxI32 sweepTotalHits = 0;
+		PxI32 sweepTotalTests = 0;
 
 		PxcNpThreadContext* threadContext = mContext->getNpThreadContext();
 
@@ -1030,6 +1082,17 @@ public:
 			while (islandEnd < mNumPairs && mCCDPairs[islandEnd]->mIslandId == iIsland) // find first index past the current island id
 				islandEnd++;
 
+			// --------------------------------------------------------------------------------------
+			// sweep estimates for the island's pairs. Other islands can still be advancing at this point, but they
+			// only move their own bodies, which are not part of this island's pairs.
+			for (PxU32 j = islandStart; j < islandEnd; j++)
+			{
+				PxsCCDPair& pair = *mCCDPairs[j];
+				pair.sweepEstimateToi(ccdThreshold);
+				pair.mEstimatePass = 0;
+			}
+			sweepTotalTests += PxI32(islandEnd - islandStart);
+
 			if (islandEnd > islandStart+1)
 				PxSort(mCCDPairs+islandStart, islandEnd-islandStart, ToiPtrCompare());
 
@@ -1066,6 +1129,7 @@ public:
 					if(pair.mToiType == PxsCCDPair::eEstimate)
 					{
 						pair.sweepFindToi(*threadContext, dt, mCCDPass, ccdThreshold);
+						sweepTotalTests++;
 
 						//Test to see if the pair is still the earliest pair.
 						if((iFront + 1) < islandEnd && mCCDPairs[iFront+1]->mMinToi < pair.mMinToi)
@@ -1225,6 +1289,7 @@ public:
 									PxReal oldToi = pair1.mMinToi;
 									verifyCCDPair(pair1);
 									PxReal toi1 = pair1.sweepEstimateToi(ccdThreshold);
+									sweepTotalTests++;
 									PX_ASSERT(pair1.mBa0); // this is because mMinToiNormal is the impact point here
 									if (toi1 < oldToi)
 									{
@@ -1264,16 +1329,37 @@ public:
 				} // if pair.minToi <= 1.0f
 			} // for iFront
 
+			// --------------------------------------------------------------------------------------
+			// contact streams for the earliest hits of the island. The rest of the contact notification
+			// (touch events, threshold stream) touches shared data and is done in postCCDAdvance.
+			for (PxU32 j = islandStart; j < islandEnd; j++)
+			{
+				const PxsCCDPair& pair = *mCCDPairs[j];
+				//The CCD pairs are ordered by TOI. If we reach a TOI > 1, we can terminate
+				if(pair.mMinToi > 1.0f)
+					break;
+
+				if(pair.mIsEarliestToiHit)
+				{
+					//Flag that we had a CCD contact
+					pair.mCm->setHadCCDContact();
+
+					if(needsCCDContactReports(pair.mCm->getWorkUnit()))
+						writeCCDContactStream(pair, threadContext);
+				}
+			}
+
 			islandStart = islandEnd;
 		} // for (PxU32 iIsland = mFirstThreadIsland; iIsland < lastIsland; iIsland++)
 
 		PxAtomicAdd(mSweepTotalHits, sweepTotalHits);
+		PxAtomicAdd(mSweepTotalTests, sweepTotalTests);
 		mContext->putNpThreadContext(threadContext);
 	}
 
 	virtual const char *getName() const
 	{
-		return "PxsContext.CCDAdvance";
+		return "PxsContext.CCDSweepAndAdvance";
 	}
 };
 }
@@ -1488,6 +1574,7 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, IG::IslandSim
 		return;
 	}
 	mSweepTotalHits = 0;
+	mSweepTotalTests = 0;
 
 	PX_ASSERT(continuation);
 	PX_ASSERT(continuation->getReference() > 0);
@@ -1786,36 +1873,30 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, IG::IslandSim
 	// setup tasks
 	mPostCCDDepenetrateTask.setContinuation(continuation);
 	mPostCCDAdvanceTask.setContinuation(&mPostCCDDepenetrateTask);
-	mPostCCDSweepTask.setContinuation(&mPostCCDAdvanceTask);
 
 	// --------------------------------------------------------------------------------------
 	// sort all pairs by islands
 	PxSort(mCCDPtrPairs.begin(), mCCDPtrPairs.size(), IslandPtrCompare());
 
 	// --------------------------------------------------------------------------------------
-	// sweep all CCD pairs
+	// sweep & advance all CCD pairs, island by island
 	const PxU32 nPairs = mCCDPtrPairs.size();
 	const PxU32 numThreads = PxMax(1u, mContext->mTaskManager->getCpuDispatcher()->getWorkerCount()); PX_ASSERT(numThreads > 0);
 	mCCDPairsPerBatch = PxMax<PxU32>((nPairs)/numThreads, 1);
 
-	for (PxU32 batchBegin = 0; batchBegin < nPairs; batchBegin += mCCDPairsPerBatch)
-	{
-		void* ptr = mContext->mTaskPool.allocate(sizeof(PxsCCDSweepTask));
-		PX_ASSERT_WITH_MESSAGE(ptr, "Failed to allocate PxsCCDSweepTask");
-		const PxU32 batchEnd = PxMin(nPairs, batchBegin + mCCDPairsPerBatch);
-		PX_ASSERT(batchEnd >= batchBegin);
-		PxsCCDSweepTask* task = PX_PLACEMENT_NEW(ptr, PxsCCDSweepTask)(mContext->getContextId(), mCCDPtrPairs.begin() + batchBegin, batchEnd - batchBegin,
-			mCCDThreshold);
-		task->setContinuation(*mContext->mTaskManager, &mPostCCDSweepTask);
-		task->removeReference();
-	}
+	createAdvanceTasks(&mPostCCDAdvanceTask);
 
-	mPostCCDSweepTask.removeReference();
 	mPostCCDAdvanceTask.removeReference();
 	mPostCCDDepenetrateTask.removeReference();
+
+#if PX_ENABLE_SIM_STATS
+	mContext->mSimStats.mNbCCDPasses++;
+#else
+	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
 }
 
-void PxsCCDContext::postCCDSweep(PxBaseTask* continuation)
+void PxsCCDContext::createAdvanceTasks(PxBaseTask* continuation)
 {
 	// --------------------------------------------------------------------------------------
 	// batch up the islands and send them over to worker threads
@@ -1844,13 +1925,13 @@ void PxsCCDContext::postCCDSweep(PxBaseTask* continuation)
 		}
 
 		void* ptr = mContext->mTaskPool.allocate(sizeof(PxsCCDAdvanceTask));
-		PX_ASSERT_WITH_MESSAGE(ptr , "Failed to allocate PxsCCDSweepTask");
+		PX_ASSERT_WITH_MESSAGE(ptr , "Failed to allocate PxsCCDAdvanceTask");
 		bool clipTrajectory = (miCCDPass == mCCDMaxPasses-1);
 		PxsCCDAdvanceTask* task = PX_PLACEMENT_NEW(ptr, PxsCCDAdvanceTask) (
 			mCCDPtrPairs.begin(), mCCDPtrPairs.size(), mCCDBodies, mContext, this, mCCDThreadContext->mDt, miCCDPass, 
 			firstIslandPair, firstIslandInBatch, lastIslandInBatch-firstIslandInBatch, islandCount, 
 			mIslandBodies.begin(), mIslandSizes.begin(), clipTrajectory, mDisableCCDResweep,
-			&mSweepTotalHits);
+			&mSweepTotalHits, &mSweepTotalTests);
 		firstIslandInBatch = lastIslandInBatch;
 		firstIslandPair += pairSum;		
 		task->setContinuation(*mContext->mTaskManager, continuation);
@@ -1858,15 +1939,11 @@ void PxsCCDContext::postCCDSweep(PxBaseTask* continuation)
 	} // for iIsland
 }
 
-static PX_FORCE_INLINE bool shouldCreateContactReports(const PxsRigidCore* rigidCore)
-{
-	return static_cast<const PxsBodyCore*>(rigidCore)->contactReportThreshold != PXV_CONTACT_REPORT_DISABLED;
-}
-
 void PxsCCDContext::postCCDAdvance(PxBaseTask* /*continuation*/)
 {	
 	// --------------------------------------------------------------------------------------
-	// contact notifications: update touch status (multi-threading this section would probably slow it down but might be worth a try)
+	// contact notifications: update touch status. This is the part touching shared data (touch event bitmaps, narrow phase
+	// registration, threshold stream), the rest has already been done per island in the advance tasks.
 	PxU32 countLost = 0, countFound = 0, countRetouch = 0;
 
 	PxU32 islandCount = mCCDIslandHistogram.size();
@@ -1885,9 +1962,6 @@ void PxsCCDContext::postCCDAdvance(PxBaseTask* /*continuation*/)
 			//If this was the earliest touch for the pair of bodies, we can notify the user about it. If not, it's a future collision that we haven't stepped to yet
 			if (p.mIsEarliestToiHit)
 			{
-				//Flag that we had a CCD contact
-				p.mCm->setHadCCDContact();
-
 				PxcNpWorkUnit& npUnit = p.mCm->getWorkUnit();
 
 				//Test/set the changed touch map
@@ -1911,78 +1985,11 @@ void PxsCCDContext::postCCDAdvance(PxBaseTask* /*continuation*/)
 					countRetouch++;
 				}
 
-				//Do we want to create reports?
-				const bool createReports =
-					npUnit.mFlags & PxcNpWorkUnitFlag::eOUTPUT_CONTACTS
-					|| (npUnit.mFlags & PxcNpWorkUnitFlag::eFORCE_THRESHOLD
-						&& ((npUnit.mFlags & (PxcNpWorkUnitFlag::eDYNAMIC_BODY0 | PxcNpWorkUnitFlag::eARTICULATION_BODY0) && shouldCreateContactReports(npUnit.mRigidCore0))
-					|| (npUnit.mFlags & (PxcNpWorkUnitFlag::eDYNAMIC_BODY1 | PxcNpWorkUnitFlag::eARTICULATION_BODY1)  && shouldCreateContactReports(npUnit.mRigidCore1))));
-
-				if(createReports)
+				//Do we want to create reports? The contact stream itself has been written by the advance task.
+				if(needsCCDContactReports(npUnit))
 				{
 					mContext->mContactManagersWithCCDTouch.growAndSet(p.mCm->getIndex());
 
-					const PxU32 numContacts = 1;
-					PxsMaterialInfo matInfo;
-					PxContactBuffer& buffer = mCCDThreadContext->mContactBuffer;
-
-					PxContactPoint& cp = buffer.contacts[0];
-					cp.point = p.mMinToiPoint;
-					cp.normal = -p.mMinToiNormal;						//KS - discrete contact gen produces contacts pointing in the opposite direction to CCD sweeps
-					cp.internalFaceIndex1 = p.mFaceIndex;
-					cp.separation = 0.0f;
-					cp.restitution = p.mRestitution;
-					cp.dynamicFriction = p.mDynamicFriction;
-					cp.staticFriction = p.mStaticFriction;
-					cp.targetVel = PxVec3(0.0f);
-					cp.maxImpulse = PX_MAX_REAL;
-					
-					matInfo.mMaterialIndex0 = p.mMaterialIndex0;
-					matInfo.mMaterialIndex1 = p.mMaterialIndex1;
-
-					//Write contact stream for the contact. This will allocate memory for the contacts and forces
-					PxReal* contactForces;
-					//PxU8* contactStream;
-					PxU8* contactPatches;
-					PxU8* contactPoints;
-					PxU16 contactStreamSize;
-					PxU16 contactCount;
-					PxU8 nbPatches;
-					PxU8* unusedU8Ptr = NULL;
-					PxsCCDContactHeader* ccdHeader = reinterpret_cast<PxsCCDContactHeader*>(npUnit.mCCDContacts);
-					if (writeCompressedContact(buffer.contacts, numContacts, mCCDThreadContext, contactCount, contactPatches,
-						contactPoints, contactStreamSize, contactForces, numContacts*sizeof(PxReal), unusedU8Ptr, NULL, mCCDThreadContext->mMaterialManager,
-												((npUnit.mFlags & PxcNpWorkUnitFlag::eMODIFIABLE_CONTACT) != 0), true, &matInfo, nbPatches, sizeof(PxsCCDContactHeader),NULL, NULL,
-												false, NULL, NULL, NULL, p.mFaceIndex != PXC_CONTACT_NO_FACE_INDEX))
-					{
-						PxsCCDContactHeader* newCCDHeader = reinterpret_cast<PxsCCDContactHeader*>(contactPatches);
-						newCCDHeader->contactStreamSize = PxTo16(contactStreamSize);
-						newCCDHeader->isFromPreviousPass = 0;
-
-						npUnit.mCCDContacts = contactPatches;	// put the latest stream at the head of the linked list since it needs to get accessed every CCD pass
-																// to prepare the reports
-
-						if (!ccdHeader)
-							newCCDHeader->nextStream = NULL;
-						else
-						{
-							newCCDHeader->nextStream = ccdHeader;
-							ccdHeader->isFromPreviousPass = 1;
-						}
-
-						//And write the force and contact count
-						PX_ASSERT(contactForces != NULL);
-						contactForces[0] = p.mAppliedForce;
-					}
-					else if (!ccdHeader)
-					{
-						npUnit.mCCDContacts = NULL;
-						// we do not set the status flag on failure because the pair might have written
-						// a contact stream sucessfully during discrete collision this frame.
-					}
-					else
-						ccdHeader->isFromPreviousPass = 1;
-
 					//If the touch event already existed, the solver would have already configured the threshold stream
 					if((npUnit.mFlags & (PxcNpWorkUnitFlag::eARTICULATION_BODY0 | PxcNpWorkUnitFlag::eARTICULATION_BODY1)) == 0 && p.mAppliedForce)
 					{
@@ -2025,6 +2032,13 @@ void PxsCCDContext::postCCDDepenetrate(PxBaseTask* /*continuation*/)
 
 	mCCDOverlaps.clear_NoDelete();
 
+#if PX_ENABLE_SIM_STATS
+	mContext->mSimStats.mNbCCDSweeps += PxU32(mSweepTotalTests);
+	mContext->mSimStats.mNbCCDToiHits += PxU32(mSweepTotalHits);
+#else
+	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
+
 	updateCCDEnd();
 
 	mContext->putNpThreadContext(mCCDThreadContext);
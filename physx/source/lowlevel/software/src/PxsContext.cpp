@@ -67,6 +67,7 @@ PxsContext::PxsContext(const PxSceneDesc& desc, PxTaskManager* taskManager, Cm::
 	mPCM							(desc.flags & PxSceneFlag::eENABLE_PCM),
 	mContactCache					(false),
 	mCreateAveragePoint				(desc.flags & PxSceneFlag::eENABLE_AVERAGE_POINT),
+	mRestingContactCache			(desc.flags & PxSceneFlag::eENABLE_RESTING_CONTACT_CACHE),
 	mContextID						(contextID)
 {
 	clearManagerTouchEvents();
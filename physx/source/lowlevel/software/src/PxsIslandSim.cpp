@@ -29,6 +29,8 @@
 #include "PxsIslandSim.h"
 #include "foundation/PxSort.h"
 #include "foundation/PxUtilities.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMemory.h"
 #include "common/PxProfileZone.h"
 
 using namespace physx;
@@ -49,7 +51,12 @@ IslandSim::IslandSim(const CPUExternalData& cpuData, GPUExternalData* gpuData, P
 #endif
 	mActivatingNodes		("IslandSim::mActivatingNodes"),
 	mDestroyedEdges			("IslandSim::mDestroyedEdges"),
-	mVisitedNodes			("IslandSim::mVisitedNodes"),
+	mNbTraversalTasks		(0),
+	mDirtyNodes				("IslandSim::mDirtyNodes"),
+	mDirtyNodesPerIsland	("IslandSim::mDirtyNodesPerIsland"),
+	mDirtyIslands			("IslandSim::mDirtyIslands"),
+	mIslandToDirtyIsland	("IslandSim::mIslandToDirtyIsland"),
+	mNextDirtyIsland		(0),
 	mCpuData				(cpuData),
 	mGpuData				(gpuData),
 	mContextId				(contextID)
@@ -59,6 +66,13 @@ IslandSim::IslandSim(const CPUExternalData& cpuData, GPUExternalData* gpuData, P
 		mInitialActiveNodeCount[i] = 0;
 		mActiveEdgeCount[i] = 0;
 	}
+	PxMemZero(&mIslandSplitStats, sizeof(IslandSplitStats));
+}
+
+IslandSim::~IslandSim()
+{
+	for(PxU32 a = 0; a < mTraversalContexts.size(); ++a)
+		PX_DELETE(mTraversalContexts[a]);
 }
 
 #if PX_ENABLE_ASSERTS
@@ -618,7 +632,7 @@ bool IslandSim::canFindRoot(PxNodeIndex startNode, PxNodeIndex targetNode, PxArr
 }
 #endif
 
-void IslandSim::unwindRoute(PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id)
+void IslandSim::unwindRoute(TraversalContext& context, PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 hopCount, IslandId id)
 {
 	//We have found either a witness *or* the root node with this traversal. In the event of finding the root node, hopCount will be 0. In the event of finding
 	//a witness, hopCount will be the hopCount that witness reported as being the distance to the root.
@@ -627,7 +641,7 @@ void IslandSim::unwindRoute(PxU32 traversalIndex, PxNodeIndex lastNode, PxU32 ho
 	PxU32 hc = hopCount+1; //Add on 1 for the hop to the witness/root node.
 	do
 	{
-		TraversalState& state = mVisitedNodes[currIndex];
+		const TraversalState& state = context.mVisitedNodes[currIndex];
 		mHopCounts[state.mNodeIndex.index()] = hc++;
 		mIslandIds[state.mNodeIndex.index()] = id;
 		mFastRoute[state.mNodeIndex.index()] = lastNode;
@@ -1026,14 +1040,17 @@ bool IslandSim::isPathTo(PxNodeIndex startNode, PxNodeIndex targetNode) const
 }
 #endif
 
-bool IslandSim::tryFastPath(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
+bool IslandSim::tryFastPath(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
 {
 	PX_UNUSED(startNode);
 	PX_UNUSED(targetNode);
 
+	PxArray<TraversalState>& visitedNodes = context.mVisitedNodes;
+	PxBitMap& visitedState = context.mVisitedState;
+
 	PxNodeIndex currentNode = startNode;
 
-	const PxU32 currentVisitedNodes = mVisitedNodes.size();
+	const PxU32 currentVisitedNodes = visitedNodes.size();
 
 	PxU32 depth = 0;
 	
@@ -1042,7 +1059,7 @@ bool IslandSim::tryFastPath(PxNodeIndex startNode, PxNodeIndex targetNode, Islan
 	{
 		//Get the fast path from this node...
 		
-		if(mVisitedState.test(currentNode.index()))
+		if(visitedState.test(currentNode.index()))
 		{
 			found = mIslandIds[currentNode.index()] != IG_INVALID_ISLAND; //Already visited and not tagged with invalid island == a witness!
 			break;
@@ -1053,44 +1070,45 @@ bool IslandSim::tryFastPath(PxNodeIndex startNode, PxNodeIndex targetNode, Islan
 			break;
 		}
 
-		mVisitedNodes.pushBack(TraversalState(currentNode, mVisitedNodes.size(), mVisitedNodes.size()-1, depth++));
+		visitedNodes.pushBack(TraversalState(currentNode, visitedNodes.size(), visitedNodes.size()-1, depth++));
+		context.mNbHops++;
 
 		PX_ASSERT(mFastRoute[currentNode.index()].index() == PX_INVALID_NODE || isPathTo(currentNode, mFastRoute[currentNode.index()]));
 
 		mIslandIds[currentNode.index()] = IG_INVALID_ISLAND;
-		mVisitedState.set(currentNode.index());
+		visitedState.set(currentNode.index());
 
 		currentNode = mFastRoute[currentNode.index()];
 	}
 	while(currentNode.index() != PX_INVALID_NODE);
 
-	for(PxU32 a = currentVisitedNodes; a < mVisitedNodes.size(); ++a)
+	for(PxU32 a = currentVisitedNodes; a < visitedNodes.size(); ++a)
 	{
-		const TraversalState& state = mVisitedNodes[a];
+		const TraversalState& state = visitedNodes[a];
 		mIslandIds[state.mNodeIndex.index()] = islandId;
 	}
 
 	if(!found)
 	{
-		for(PxU32 a = currentVisitedNodes; a < mVisitedNodes.size(); ++a)
+		for(PxU32 a = currentVisitedNodes; a < visitedNodes.size(); ++a)
 		{
-			const TraversalState& state = mVisitedNodes[a];
-			mVisitedState.reset(state.mNodeIndex.index());
+			const TraversalState& state = visitedNodes[a];
+			visitedState.reset(state.mNodeIndex.index());
 		}
 
-		mVisitedNodes.forceSize_Unsafe(currentVisitedNodes);
+		visitedNodes.forceSize_Unsafe(currentVisitedNodes);
 	}
 	return found;
 }
 
-bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
+bool IslandSim::findRoute(TraversalContext& context, PxNodeIndex startNode, PxNodeIndex targetNode, IslandId islandId)
 {
 	//Firstly, traverse the fast path and tag up witnesses. TryFastPath can fail. In that case, no witnesses are left but this node is permitted to report
 	//that it is still part of the island. Whichever node lost its fast path will be tagged as dirty and will be responsible for recovering the fast path
 	//and tagging up the visited nodes
 	if(mFastRoute[startNode.index()].index() != PX_INVALID_NODE)
 	{
-		if(tryFastPath(startNode, targetNode, islandId))
+		if(tryFastPath(context, startNode, targetNode, islandId))
 			return true;
 
 		//Try fast path can either be successful or not. If it was successful, then we had a valid fast path cached and all nodes on that fast path were tagged
@@ -1107,17 +1125,24 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 		//These are per-node counts that indicate the expected number of hops from this node to the root node. These are lazily evaluated and updated
 		//as new edges are formed or when traversals occur to re-establish islands. As a result, they may be inaccurate but they still serve the purpose
 		//of guiding our search to minimize the chances of us doing an exhaustive search to find the root node.
+		PxArray<TraversalState>& visitedNodes = context.mVisitedNodes;
+		PxBitMap& visitedState = context.mVisitedState;
+		Cm::PriorityQueue<QueueElement, NodeComparator>& priorityQueue = context.mPriorityQueue;
+
 		mIslandIds[startNode.index()] = IG_INVALID_ISLAND;
-		TraversalState* startTraversal = &mVisitedNodes.pushBack(TraversalState(startNode, mVisitedNodes.size(), PX_INVALID_NODE, 0));
-		mVisitedState.set(startNode.index());
-		QueueElement element(startTraversal, mHopCounts[startNode.index()]);
-		mPriorityQueue.push(element);
+		const PxU32 startIndex = visitedNodes.size();
+		visitedNodes.pushBack(TraversalState(startNode, startIndex, PX_INVALID_NODE, 0));
+		context.mNbHops++;
+		visitedState.set(startNode.index());
+		QueueElement element(startIndex, mHopCounts[startNode.index()]);
+		priorityQueue.push(element);
 
 		do
 		{
-			const QueueElement currentQE = mPriorityQueue.pop();
+			const QueueElement currentQE = priorityQueue.pop();
 
-			const TraversalState& currentState = *currentQE.mState;
+			// PT: copy, mVisitedNodes can be resized below
+			const TraversalState currentState = visitedNodes[currentQE.mStateIndex];
 
 			const Node& currentNode = mNodes[currentState.mNodeIndex.index()];
 
@@ -1134,11 +1159,11 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 					{
 						if(nextIndex.index() == targetNode.index())
 						{
-							unwindRoute(currentState.mCurrentIndex, nextIndex, 0, islandId);
+							unwindRoute(context, currentState.mCurrentIndex, nextIndex, 0, islandId);
 							return true;
 						}
 
-						if(mVisitedState.test(nextIndex.index()))
+						if(visitedState.test(nextIndex.index()))
 						{
 							//We already visited this node. This means that it's either in the priority queue already or we 
 							//visited in on a previous pass. If it was visited on a previous pass, then it already knows what island it's in. 
@@ -1152,17 +1177,19 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 								//because that would caused me to have been visited already because totally separate islands trigger a full traversal on 
 								//the orphaned side.
 								PX_ASSERT(visitedIslandId == islandId);
-								unwindRoute(currentState.mCurrentIndex, nextIndex, mHopCounts[nextIndex.index()], islandId);
+								unwindRoute(context, currentState.mCurrentIndex, nextIndex, mHopCounts[nextIndex.index()], islandId);
 								return true;
 							}
 						}
 						else
 						{
 							//This node has not been visited yet, so we need to push it into the stack and continue traversing
-							TraversalState* state = &mVisitedNodes.pushBack(TraversalState(nextIndex, mVisitedNodes.size(), currentState.mCurrentIndex, currentState.mDepth+1));
-							QueueElement qe(state, mHopCounts[nextIndex.index()]);
-							mPriorityQueue.push(qe);
-							mVisitedState.set(nextIndex.index());
+							const PxU32 stateIndex = visitedNodes.size();
+							visitedNodes.pushBack(TraversalState(nextIndex, stateIndex, currentState.mCurrentIndex, currentState.mDepth+1));
+							context.mNbHops++;
+							QueueElement qe(stateIndex, mHopCounts[nextIndex.index()]);
+							priorityQueue.push(qe);
+							visitedState.set(nextIndex.index());
 							PX_ASSERT(mIslandIds[nextIndex.index()] == islandId);
 							mIslandIds[nextIndex.index()] = IG_INVALID_ISLAND; //Flag as invalid island until we know whether we can find root or an island id.
 						}
@@ -1172,7 +1199,7 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 				edge = instance.mNextEdge;
 			}
 		}
-		while(mPriorityQueue.size());
+		while(priorityQueue.size());
 
 		return false;
 	}
@@ -1180,20 +1207,19 @@ bool IslandSim::findRoute(PxNodeIndex startNode, PxNodeIndex targetNode, IslandI
 
 void IslandSim::processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation, PxU32 dirtyNodeLimit)
 {
-	PX_UNUSED(dirtyNodeLimit);
 	PX_PROFILE_ZONE("Basic.processLostEdges", mContextId);
-	//At this point, all nodes and edges are activated. 
 
-	//Bit map for visited
-	mVisitedState.resizeAndClear(mNodes.size());
+	if(processLostEdgesPart1(allowDeactivation, dirtyNodeLimit, 1))
+		findPathsAndBreakIslands(0);
 
-	//Reserve space on priority queue for at least 1024 nodes. It will resize if more memory is required during traversal.
-	mPriorityQueue.reserve(1024);
+	processLostEdgesPart2(destroyedNodes, allowDeactivation, permitKinematicDeactivation);
+}
 
-	for (PxU32 i = 0; i < Edge::eEDGE_TYPE_COUNT; ++i)
-		mIslandSplitEdges[i].reserve(1024);
-	
-	mVisitedNodes.reserve(mNodes.size()); //Make sure we have enough space for all nodes!
+PxU32 IslandSim::processLostEdgesPart1(bool allowDeactivation, PxU32 dirtyNodeLimit, PxU32 maxNbTasks)
+{
+	PX_UNUSED(dirtyNodeLimit);
+	PX_PROFILE_ZONE("Basic.processLostEdgesPart1", mContextId);
+	//At this point, all nodes and edges are activated. 
 
 	const PxU32 nbDestroyedEdges = mDestroyedEdges.size();
 	PX_UNUSED(nbDestroyedEdges);
@@ -1259,278 +1285,461 @@ void IslandSim::processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, boo
 		}
 	}
 
-	if (allowDeactivation)
-	{
-		PX_PROFILE_ZONE("Basic.findPathsAndBreakIslands", mContextId);
+	PxMemZero(&mIslandSplitStats, sizeof(IslandSplitStats));
+	mNbTraversalTasks = 0;
 
-		//KS - process only this many dirty nodes, deferring future dirty nodes to subsequent frames. 
-		//This means that it may take several frames for broken edges to trigger islands to completely break but this is better
-		//than triggering large performance spikes.
+	if (!allowDeactivation)
+		return 0;
+
+	PX_PROFILE_ZONE("Basic.gatherDirtyNodes", mContextId);
+
+	//KS - process only this many dirty nodes, deferring future dirty nodes to subsequent frames. 
+	//This means that it may take several frames for broken edges to trigger islands to completely break but this is better
+	//than triggering large performance spikes.
 #if IG_LIMIT_DIRTY_NODES
-		PxBitMap::PxCircularIterator iter(mDirtyMap, mLastMapIndex);
-		const PxU32 MaxCount = dirtyNodeLimit;// +10000000;
-		PxU32 lastMapIndex = mLastMapIndex;
-		PxU32 count = 0;
+	PxBitMap::PxCircularIterator iter(mDirtyMap, mLastMapIndex);
+	const PxU32 MaxCount = dirtyNodeLimit;// +10000000;
+	PxU32 lastMapIndex = mLastMapIndex;
+	PxU32 count = 0;
 #else
-		PxBitMap::Iterator iter(mDirtyMap);
+	PxBitMap::Iterator iter(mDirtyMap);
 #endif
 
-		PxU32 dirtyIdx;
+	mDirtyNodes.forceSize_Unsafe(0);
+
+	PxU32 dirtyIdx;
 
 #if IG_LIMIT_DIRTY_NODES
-		while ((dirtyIdx = iter.getNext()) != PxBitMap::PxCircularIterator::DONE
-			&& (count++ < MaxCount)
+	while ((dirtyIdx = iter.getNext()) != PxBitMap::PxCircularIterator::DONE
+		&& (count++ < MaxCount)
 #else
-		while ((dirtyIdx = iter.getNext()) != PxBitMap::Iterator::DONE
+	while ((dirtyIdx = iter.getNext()) != PxBitMap::Iterator::DONE
 #endif
-			)
-		{
+		)
+	{
 #if IG_LIMIT_DIRTY_NODES
-			lastMapIndex = dirtyIdx + 1;
+		lastMapIndex = dirtyIdx + 1;
 #endif
-			//Process dirty nodes. Figure out if we can make our way from the dirty node to the root.
+		//Kinematic and deleted nodes do not need any work, and neither do root nodes since they can trivially reach themselves.
+		Node& dirtyNode = mNodes[dirtyIdx];
+		if (!dirtyNode.isKinematic() && !dirtyNode.isDeleted() && mIslands[mIslandIds[dirtyIdx]].mRootNode.index() != dirtyIdx)
+			mDirtyNodes.pushBack(dirtyIdx);
 
-			mPriorityQueue.clear(); //Clear the queue used for traversal
-			mVisitedNodes.forceSize_Unsafe(0); //Clear the list of nodes in this island
-			const PxNodeIndex dirtyNodeIndex(dirtyIdx);
-			Node& dirtyNode = mNodes[dirtyNodeIndex.index()];
+		dirtyNode.clearDirty();
+#if IG_LIMIT_DIRTY_NODES
+		mDirtyMap.reset(dirtyIdx);
+#endif
+	}
 
-			//Check whether this node has already been touched. If it has been touched this frame, then its island state is reliable 
-			//and we can just unclear the dirty flag on the body. If we were already visited, then the state should have already been confirmed in a 
-			//previous pass.
-			if (!dirtyNode.isKinematic() && !dirtyNode.isDeleted() && !mVisitedState.test(dirtyNodeIndex.index()))
-			{
-				//We haven't visited this node in our island repair passes yet, so we still need to process until we've hit a visited node or found
-				//our root node. Note that, as soon as we hit a visited node that has already been processed in a previous pass, we know that we can rely
-				//on its island information although the hop counts may not be optimal. It also indicates that this island was not broken immediately because
-				//otherwise, the entire new sub-island would already have been visited and this node would have already had its new island state assigned.
+#if IG_LIMIT_DIRTY_NODES
+	mLastMapIndex = lastMapIndex;
+	if (count < MaxCount)
+		mLastMapIndex = 0;
+#else
+	mDirtyMap.clear();
+#endif
 
-				//Indicate that I've been visited
+	//Group the dirty nodes per island, keeping the processing order within each island. Traversals never leave the island
+	//of the dirty node they start from, so dirty islands can be processed independently. Within an island, dirty nodes must
+	//be processed in order because a traversal relies on the state left by the previous ones.
+	const PxU32 nbDirtyNodes = mDirtyNodes.size();
+	mDirtyIslands.forceSize_Unsafe(0);
+	if (mIslandToDirtyIsland.size() < mIslands.size())
+		mIslandToDirtyIsland.resize(mIslands.size(), IG_INVALID_ISLAND);
 
-				const IslandId islandId = mIslandIds[dirtyNodeIndex.index()];
-				const Island& findIsland = mIslands[islandId];
+	for (PxU32 a = 0; a < nbDirtyNodes; ++a)
+	{
+		const IslandId islandId = mIslandIds[mDirtyNodes[a]];
+		PxU32 dirtyIslandIndex = mIslandToDirtyIsland[islandId];
+		if (dirtyIslandIndex == IG_INVALID_ISLAND)
+		{
+			dirtyIslandIndex = mDirtyIslands.size();
+			mIslandToDirtyIsland[islandId] = dirtyIslandIndex;
+			const DirtyIsland dirtyIsland = { islandId, 0, 0 };
+			mDirtyIslands.pushBack(dirtyIsland);
+		}
+		mDirtyIslands[dirtyIslandIndex].mNbDirtyNodes++;
+	}
 
-				const PxNodeIndex searchNode = findIsland.mRootNode;//The node that we're searching for!
+	const PxU32 nbDirtyIslands = mDirtyIslands.size();
+	PxU32 start = 0;
+	for (PxU32 a = 0; a < nbDirtyIslands; ++a)
+	{
+		DirtyIsland& dirtyIsland = mDirtyIslands[a];
+		dirtyIsland.mStart = start;
+		start += dirtyIsland.mNbDirtyNodes;
+		dirtyIsland.mNbDirtyNodes = 0;
+	}
 
-				if (searchNode.index() != dirtyNodeIndex.index()) //If we are the root node, we don't need to do anything!
-				{
-					if (findRoute(dirtyNodeIndex, searchNode, islandId))
-					{
-						//We found the root node so let's let every visited node know that we found its root
-						//and we can also update our hop counts because we recorded how many hops it took to reach this
-						//node
+	mDirtyNodesPerIsland.resizeUninitialized(nbDirtyNodes);
+	for (PxU32 a = 0; a < nbDirtyNodes; ++a)
+	{
+		DirtyIsland& dirtyIsland = mDirtyIslands[mIslandToDirtyIsland[mIslandIds[mDirtyNodes[a]]]];
+		mDirtyNodesPerIsland[dirtyIsland.mStart + dirtyIsland.mNbDirtyNodes++] = a;
+	}
+
+	for (PxU32 a = 0; a < nbDirtyIslands; ++a)
+		mIslandToDirtyIsland[mDirtyIslands[a].mIslandId] = IG_INVALID_ISLAND;
+
+	if (!nbDirtyIslands)
+		return 0;
+
+	const PxU32 nbTasks = nbDirtyNodes >= IG_PARALLEL_SPLIT_MIN_DIRTY_NODES ? PxClamp(maxNbTasks, 1u, nbDirtyIslands) : 1;
+
+	while (mTraversalContexts.size() < nbTasks)
+		mTraversalContexts.pushBack(PX_NEW(TraversalContext));
 
-						//We already filled in the path to the root/witness with accurate hop counts. Now we just need to fill in the estimates
-						//for the remaining nodes and re-define their islandIds. We approximate their path to the root by just routing them through
-						//the route we already found.
+	for (PxU32 a = 0; a < nbTasks; ++a)
+	{
+		TraversalContext& context = *mTraversalContexts[a];
+		context.mIslandSplits.forceSize_Unsafe(0);
+		context.mNbHops = 0;
+		context.mNbIslands = 0;
+	}
+
+	mNextDirtyIsland = 0;
+	mNbTraversalTasks = nbTasks;
+	mIslandSplitStats.mNbDirtyNodes = nbDirtyNodes;
+	mIslandSplitStats.mNbIslands = nbDirtyIslands;
+	return nbTasks;
+}
+
+void IslandSim::findPathsAndBreakIslands(PxU32 contextIndex)
+{
+	PX_PROFILE_ZONE("Basic.findPathsAndBreakIslands", mContextId);
+
+	PX_ASSERT(contextIndex < mNbTraversalTasks);
+	TraversalContext& context = *mTraversalContexts[contextIndex];
+
+	//Bit map for visited
+	context.mVisitedState.resizeAndClear(mNodes.size());
+
+	//Reserve space on priority queue for at least 1024 nodes. It will resize if more memory is required during traversal.
+	context.mPriorityQueue.reserve(1024);
 
-						//This loop works because mVisitedNodes are recorded in the order they were visited and we already filled in the critical path
-						//so the remainder of the paths will just fork from that path.
+	for (PxU32 i = 0; i < Edge::eEDGE_TYPE_COUNT; ++i)
+		context.mIslandSplitEdges[i].reserve(1024);
+
+	// PT: dirty islands are distributed dynamically. This does not affect the results, since islands are independent.
+	const PxU32 nbDirtyIslands = mDirtyIslands.size();
+	PxU32 dirtyIslandIndex;
+	while ((dirtyIslandIndex = PxU32(PxAtomicIncrement(&mNextDirtyIsland) - 1)) < nbDirtyIslands)
+	{
+		breakIsland(context, mDirtyIslands[dirtyIslandIndex]);
+		context.mNbIslands++;
+	}
+}
+
+void IslandSim::breakIsland(TraversalContext& context, const DirtyIsland& dirtyIsland)
+{
+	const IslandId islandId = dirtyIsland.mIslandId;
+	Island& oldIsland = mIslands[islandId];
+
+	const PxNodeIndex searchNode = oldIsland.mRootNode;//The node that we're searching for! Splits never take the root node away.
+
+	PxArray<TraversalState>& visitedNodes = context.mVisitedNodes;
+
+	for (PxU32 d = 0; d < dirtyIsland.mNbDirtyNodes; ++d)
+	{
+		//Process dirty nodes. Figure out if we can make our way from the dirty node to the root.
+		const PxU32 dirtyNodeOrder = mDirtyNodesPerIsland[dirtyIsland.mStart + d];
+		const PxNodeIndex dirtyNodeIndex(mDirtyNodes[dirtyNodeOrder]);
 
-						//Verify state (that we can see the root from this node)...
+		//Check whether this node has already been touched. If it has been touched this frame, then its island state is reliable 
+		//and we can just unclear the dirty flag on the body. If we were already visited, then the state should have already been confirmed in a 
+		//previous pass.
+		if (context.mVisitedState.test(dirtyNodeIndex.index()))
+			continue;
+
+		//We haven't visited this node in our island repair passes yet, so we still need to process until we've hit a visited node or found
+		//our root node. Note that, as soon as we hit a visited node that has already been processed in a previous pass, we know that we can rely
+		//on its island information although the hop counts may not be optimal. It also indicates that this island was not broken immediately because
+		//otherwise, the entire new sub-island would already have been visited and this node would have already had its new island state assigned.
+
+		PX_ASSERT(mIslandIds[dirtyNodeIndex.index()] == islandId);
+		PX_ASSERT(searchNode.index() != dirtyNodeIndex.index());
+
+		context.mPriorityQueue.clear(); //Clear the queue used for traversal
+		visitedNodes.forceSize_Unsafe(0); //Clear the list of nodes in this island
+
+		if (findRoute(context, dirtyNodeIndex, searchNode, islandId))
+		{
+			//We found the root node so let's let every visited node know that we found its root
+			//and we can also update our hop counts because we recorded how many hops it took to reach this
+			//node
+
+			//We already filled in the path to the root/witness with accurate hop counts. Now we just need to fill in the estimates
+			//for the remaining nodes and re-define their islandIds. We approximate their path to the root by just routing them through
+			//the route we already found.
+
+			//This loop works because mVisitedNodes are recorded in the order they were visited and we already filled in the critical path
+			//so the remainder of the paths will just fork from that path.
+
+			//Verify state (that we can see the root from this node)...
 
 #if IG_SANITY_CHECKS
-						PX_ASSERT(canFindRoot(dirtyNodeIndex, searchNode, NULL)); //Verify that we found the connection
+			PX_ASSERT(canFindRoot(dirtyNodeIndex, searchNode, NULL)); //Verify that we found the connection
 #endif
 
-						for (PxU32 b = 0; b < mVisitedNodes.size(); ++b)
-						{
-							TraversalState& state = mVisitedNodes[b];
-							if (mIslandIds[state.mNodeIndex.index()] == IG_INVALID_ISLAND)
-							{
-								mHopCounts[state.mNodeIndex.index()] = mHopCounts[mVisitedNodes[state.mPrevIndex].mNodeIndex.index()] + 1;
-								mFastRoute[state.mNodeIndex.index()] = mVisitedNodes[state.mPrevIndex].mNodeIndex;
-								mIslandIds[state.mNodeIndex.index()] = islandId;
-							}
-						}
-					}
-					else
-					{
-						//If I traversed and could not find the root node, then I have established a new island. In this island, I am the root node
-						//and I will point all my nodes towards me. Furthermore, I have established how many steps it took to reach all nodes in my island
+			for (PxU32 b = 0; b < visitedNodes.size(); ++b)
+			{
+				TraversalState& state = visitedNodes[b];
+				if (mIslandIds[state.mNodeIndex.index()] == IG_INVALID_ISLAND)
+				{
+					mHopCounts[state.mNodeIndex.index()] = mHopCounts[visitedNodes[state.mPrevIndex].mNodeIndex.index()] + 1;
+					mFastRoute[state.mNodeIndex.index()] = visitedNodes[state.mPrevIndex].mNodeIndex;
+					mIslandIds[state.mNodeIndex.index()] = islandId;
+				}
+			}
+		}
+		else
+		{
+			//If I traversed and could not find the root node, then I have established a new island. In this island, I am the root node
+			//and I will point all my nodes towards me. Furthermore, I have established how many steps it took to reach all nodes in my island
 
-						//OK. We need to separate the islands. We have a list of nodes that are part of the new island (mVisitedNodes) and we know that the 
-						//first node in that list is the root node.
+			//OK. We need to separate the islands. We have a list of nodes that are part of the new island (mVisitedNodes) and we know that the 
+			//first node in that list is the root node.
 
 
-						//OK, we need to remove all these actors from their current island, then add them to the new island...
+			//OK, we need to remove all these actors from their current island, then add them to the new island...
 
-						Island& oldIsland = mIslands[islandId];
-						//We can just unpick these nodes from the island because they do not contain the root node (if they did, then we wouldn't be
-						//removing this node from the island at all). The only challenge is if we need to remove the last node. In that case
-						//we need to re-establish the new last node in the island but perhaps the simplest way to do that would be to traverse
-						//the island to establish the last node again
+			//We can just unpick these nodes from the island because they do not contain the root node (if they did, then we wouldn't be
+			//removing this node from the island at all). The only challenge is if we need to remove the last node. In that case
+			//we need to re-establish the new last node in the island but perhaps the simplest way to do that would be to traverse
+			//the island to establish the last node again
 
 #if IG_SANITY_CHECKS
-						PX_ASSERT(!canFindRoot(dirtyNodeIndex, searchNode, NULL));
+			PX_ASSERT(!canFindRoot(dirtyNodeIndex, searchNode, NULL));
 #endif
 
-						PxU32 totalStaticTouchCount = 0;
-						PxU32 nodeCount[Node::eTYPE_COUNT];
-						for (PxU32 t = 0; t < Node::eTYPE_COUNT; ++t)
-						{
-							nodeCount[t] = 0;
-						}
+			PxU32 totalStaticTouchCount = 0;
+			PxU32 nodeCount[Node::eTYPE_COUNT];
+			for (PxU32 t = 0; t < Node::eTYPE_COUNT; ++t)
+			{
+				nodeCount[t] = 0;
+			}
 
-						for (PxU32 t = 0; t < Edge::eEDGE_TYPE_COUNT; ++t)
-						{
-							mIslandSplitEdges[t].forceSize_Unsafe(0);
-						}
+			for (PxU32 t = 0; t < Edge::eEDGE_TYPE_COUNT; ++t)
+			{
+				context.mIslandSplitEdges[t].forceSize_Unsafe(0);
+			}
 
-						//NodeIndex lastIndex = oldIsland.mLastNode;
+			//NodeIndex lastIndex = oldIsland.mLastNode;
 
-						//nodeCount[node.mType] = 1;
+			//nodeCount[node.mType] = 1;
 
-						for (PxU32 a = 0; a < mVisitedNodes.size(); ++a)
-						{
-							const PxNodeIndex index = mVisitedNodes[a].mNodeIndex;
-							Node& node = mNodes[index.index()];
+			for (PxU32 a = 0; a < visitedNodes.size(); ++a)
+			{
+				const PxNodeIndex index = visitedNodes[a].mNodeIndex;
+				Node& node = mNodes[index.index()];
 
-							if (node.mNextNode.index() != PX_INVALID_NODE)
-								mNodes[node.mNextNode.index()].mPrevNode = node.mPrevNode;
-							else
-								oldIsland.mLastNode = node.mPrevNode;
-							if (node.mPrevNode.index() != PX_INVALID_NODE)
-								mNodes[node.mPrevNode.index()].mNextNode = node.mNextNode;
+				if (node.mNextNode.index() != PX_INVALID_NODE)
+					mNodes[node.mNextNode.index()].mPrevNode = node.mPrevNode;
+				else
+					oldIsland.mLastNode = node.mPrevNode;
+				if (node.mPrevNode.index() != PX_INVALID_NODE)
+					mNodes[node.mPrevNode.index()].mNextNode = node.mNextNode;
 
-							nodeCount[node.mType]++;
+				nodeCount[node.mType]++;
 
-							node.mNextNode.setIndices(PX_INVALID_NODE);
-							node.mPrevNode.setIndices(PX_INVALID_NODE);
+				node.mNextNode.setIndices(PX_INVALID_NODE);
+				node.mPrevNode.setIndices(PX_INVALID_NODE);
 
-							PX_ASSERT(mNodes[oldIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
+				PX_ASSERT(mNodes[oldIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
 
-							totalStaticTouchCount += node.mStaticTouchCount;
+				totalStaticTouchCount += node.mStaticTouchCount;
 
-							EdgeInstanceIndex idx = node.mFirstEdgeIndex;
+				EdgeInstanceIndex idx = node.mFirstEdgeIndex;
 
-							while (idx != IG_INVALID_EDGE)
-							{
-								const EdgeInstance& instance = mEdgeInstances[idx];
-								const EdgeIndex edgeIndex = idx / 2;
-								const Edge& edge = mEdges[edgeIndex];
-
-								//Only split the island if we're processing the first node or if the first node is infinte-mass
-								if (!(idx & 1) || (mCpuData.mEdgeNodeIndices[idx & (~1)].index() == PX_INVALID_NODE || mNodes[mCpuData.mEdgeNodeIndices[idx & (~1)].index()].isKinematic()))
-								{
-									//We will remove this edge from the island...
-									mIslandSplitEdges[edge.mEdgeType].pushBack(edgeIndex);
-
-									removeEdgeFromIsland(oldIsland, edgeIndex);
-								}
-								idx = instance.mNextEdge;
-							}
-						}
+				while (idx != IG_INVALID_EDGE)
+				{
+					const EdgeInstance& instance = mEdgeInstances[idx];
+					const EdgeIndex edgeIndex = idx / 2;
+					const Edge& edge = mEdges[edgeIndex];
 
-						//oldIsland.mStaticTouchCount -= totalStaticTouchCount;
-						mIslandStaticTouchCount[islandId] -= totalStaticTouchCount;
+					//Only split the island if we're processing the first node or if the first node is infinte-mass
+					if (!(idx & 1) || (mCpuData.mEdgeNodeIndices[idx & (~1)].index() == PX_INVALID_NODE || mNodes[mCpuData.mEdgeNodeIndices[idx & (~1)].index()].isKinematic()))
+					{
+						//We will remove this edge from the island...
+						context.mIslandSplitEdges[edge.mEdgeType].pushBack(edgeIndex);
 
-						for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
-						{
-							PX_ASSERT(nodeCount[i] <= oldIsland.mNodeCount[i]);
-							oldIsland.mNodeCount[i] -= nodeCount[i];
-						}
+						removeEdgeFromIsland(oldIsland, edgeIndex);
+					}
+					idx = instance.mNextEdge;
+				}
+			}
 
-						//Now add all these nodes to the new island
+			//oldIsland.mStaticTouchCount -= totalStaticTouchCount;
+			mIslandStaticTouchCount[islandId] -= totalStaticTouchCount;
 
-						//(1) Create the new island...
-						const IslandId newIslandHandle = mIslandHandles.getHandle();
-						/*if(newIslandHandle == mIslands.capacity())
-						{
-						mIslands.reserve(2*mIslands.capacity() + 1);
-						}*/
-						mIslands.resize(PxMax(newIslandHandle + 1, mIslands.size()));
-						mIslandStaticTouchCount.resize(PxMax(newIslandHandle + 1, mIslandStaticTouchCount.size()));
-						Island& newIsland = mIslands[newIslandHandle];
+			for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+			{
+				PX_ASSERT(nodeCount[i] <= oldIsland.mNodeCount[i]);
+				oldIsland.mNodeCount[i] -= nodeCount[i];
+			}
 
-						if (mIslandAwake.test(islandId))
-						{
-							newIsland.mActiveIndex = mActiveIslands.size();
-							mActiveIslands.pushBack(newIslandHandle);
-							mIslandAwake.growAndSet(newIslandHandle); //Separated island, so it should be awake
-						}
-						else
-						{
-							mIslandAwake.growAndReset(newIslandHandle);
-						}
+			//Now add all these nodes to the new island
 
-						newIsland.mRootNode = dirtyNodeIndex;
-						mHopCounts[dirtyNodeIndex.index()] = 0;
-						mIslandIds[dirtyNodeIndex.index()] = newIslandHandle;
-						//newIsland.mTotalSize = mVisitedNodes.size();
+			//(1) Create the new island. Its handle is allocated later in processLostEdgesPart2(). Until then, its nodes keep
+			//the id of the old island. This is only seen by traversals of the old island, which just need a valid id on visited nodes.
+			IslandSplit& split = context.mIslandSplits.pushBack(IslandSplit());
+			split.mParentIslandId = islandId;
+			split.mDirtyNodeOrder = dirtyNodeOrder;
+			Island& newIsland = split.mIsland;
 
-						mNodes[dirtyNodeIndex.index()].mPrevNode.setIndices(PX_INVALID_NODE); //First node so doesn't have a preceding node
-						mFastRoute[dirtyNodeIndex.index()].setIndices(PX_INVALID_NODE);
+			newIsland.mRootNode = dirtyNodeIndex;
+			mHopCounts[dirtyNodeIndex.index()] = 0;
+			mIslandIds[dirtyNodeIndex.index()] = islandId;
+			//newIsland.mTotalSize = mVisitedNodes.size();
 
-						for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
-							nodeCount[i] = 0;
+			mNodes[dirtyNodeIndex.index()].mPrevNode.setIndices(PX_INVALID_NODE); //First node so doesn't have a preceding node
+			mFastRoute[dirtyNodeIndex.index()].setIndices(PX_INVALID_NODE);
 
-						nodeCount[dirtyNode.mType] = 1;
+			for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+				nodeCount[i] = 0;
 
-						for (PxU32 a = 1; a < mVisitedNodes.size(); ++a)
-						{
-							const PxNodeIndex index = mVisitedNodes[a].mNodeIndex;
-							Node& thisNode = mNodes[index.index()];
-							const PxNodeIndex prevNodeIndex = mVisitedNodes[a - 1].mNodeIndex;
-							thisNode.mPrevNode = prevNodeIndex;
-							mNodes[prevNodeIndex.index()].mNextNode = index;
-							nodeCount[thisNode.mType]++;
-							mIslandIds[index.index()] = newIslandHandle;
-							mHopCounts[index.index()] = mVisitedNodes[a].mDepth; //How many hops to root
-							mFastRoute[index.index()] = mVisitedNodes[mVisitedNodes[a].mPrevIndex].mNodeIndex;
-						}
+			nodeCount[mNodes[dirtyNodeIndex.index()].mType] = 1;
 
-						for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
-							newIsland.mNodeCount[i] = nodeCount[i];
+			for (PxU32 a = 1; a < visitedNodes.size(); ++a)
+			{
+				const PxNodeIndex index = visitedNodes[a].mNodeIndex;
+				Node& thisNode = mNodes[index.index()];
+				const PxNodeIndex prevNodeIndex = visitedNodes[a - 1].mNodeIndex;
+				thisNode.mPrevNode = prevNodeIndex;
+				mNodes[prevNodeIndex.index()].mNextNode = index;
+				nodeCount[thisNode.mType]++;
+				mIslandIds[index.index()] = islandId;
+				mHopCounts[index.index()] = visitedNodes[a].mDepth; //How many hops to root
+				mFastRoute[index.index()] = visitedNodes[visitedNodes[a].mPrevIndex].mNodeIndex;
+			}
 
-						//Last node in the island
-						const PxNodeIndex lastIndex = mVisitedNodes[mVisitedNodes.size() - 1].mNodeIndex;
-						mNodes[lastIndex.index()].mNextNode.setIndices(PX_INVALID_NODE);
-						newIsland.mLastNode = lastIndex;
-						//newIsland.mStaticTouchCount = totalStaticTouchCount;
-						mIslandStaticTouchCount[newIslandHandle] = totalStaticTouchCount;
+			for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+				newIsland.mNodeCount[i] = nodeCount[i];
 
-						PX_ASSERT(mNodes[newIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
+			//Last node in the island
+			const PxNodeIndex lastIndex = visitedNodes[visitedNodes.size() - 1].mNodeIndex;
+			mNodes[lastIndex.index()].mNextNode.setIndices(PX_INVALID_NODE);
+			newIsland.mLastNode = lastIndex;
+			//newIsland.mStaticTouchCount = totalStaticTouchCount;
+			split.mStaticTouchCount = totalStaticTouchCount;
 
-						for (PxU32 j = 0; j < IG::Edge::eEDGE_TYPE_COUNT; ++j)
-						{
-							PxArray<EdgeIndex>& splitEdges = mIslandSplitEdges[j];
-							const PxU32 splitEdgeSize = splitEdges.size();
-							if (splitEdgeSize)
-							{
-								splitEdges.pushBack(IG_INVALID_EDGE); //Push in a dummy invalid edge to complete the connectivity
-								mEdges[splitEdges[0]].mNextIslandEdge = splitEdges[1];
-								for (PxU32 a = 1; a < splitEdgeSize; ++a)
-								{
-									const EdgeIndex edgeIndex = splitEdges[a];
-									Edge& edge = mEdges[edgeIndex];
-									edge.mNextIslandEdge = splitEdges[a + 1];
-									edge.mPrevIslandEdge = splitEdges[a - 1];
-								}
-
-								newIsland.mFirstEdge[j] = splitEdges[0];
-								newIsland.mLastEdge[j] = splitEdges[splitEdgeSize - 1];
-								newIsland.mEdgeCount[j] = splitEdgeSize;
-							}
-						}
+			PX_ASSERT(mNodes[newIsland.mLastNode.index()].mNextNode.index() == PX_INVALID_NODE);
+
+			for (PxU32 j = 0; j < IG::Edge::eEDGE_TYPE_COUNT; ++j)
+			{
+				PxArray<EdgeIndex>& splitEdges = context.mIslandSplitEdges[j];
+				const PxU32 splitEdgeSize = splitEdges.size();
+				if (splitEdgeSize)
+				{
+					splitEdges.pushBack(IG_INVALID_EDGE); //Push in a dummy invalid edge to complete the connectivity
+					mEdges[splitEdges[0]].mNextIslandEdge = splitEdges[1];
+					for (PxU32 a = 1; a < splitEdgeSize; ++a)
+					{
+						const EdgeIndex edgeIndex = splitEdges[a];
+						Edge& edge = mEdges[edgeIndex];
+						edge.mNextIslandEdge = splitEdges[a + 1];
+						edge.mPrevIslandEdge = splitEdges[a - 1];
 					}
+
+					newIsland.mFirstEdge[j] = splitEdges[0];
+					newIsland.mLastEdge[j] = splitEdges[splitEdgeSize - 1];
+					newIsland.mEdgeCount[j] = splitEdgeSize;
 				}
 			}
-			dirtyNode.clearDirty();
-#if IG_LIMIT_DIRTY_NODES
-			mDirtyMap.reset(dirtyIdx);
-#endif
 		}
+	}
+}
 
-#if IG_LIMIT_DIRTY_NODES
-		mLastMapIndex = lastMapIndex;
-		if (count < MaxCount)
-			mLastMapIndex = 0;
-#else
-		mDirtyMap.clear();
-#endif
+namespace
+{
+	struct IslandSplitPtrLess
+	{
+		PX_FORCE_INLINE bool operator()(const IslandSplit* split0, const IslandSplit* split1) const
+		{
+			return split0->mDirtyNodeOrder < split1->mDirtyNodeOrder;
+		}
+	};
+}
+
+void IslandSim::processLostEdgesPart2(const PxArray<PxNodeIndex>& destroyedNodes, bool allowDeactivation, bool permitKinematicDeactivation)
+{
+	PX_PROFILE_ZONE("Basic.processLostEdgesPart2", mContextId);
+
+	if (mNbTraversalTasks)
+	{
+		PX_PROFILE_ZONE("Basic.registerIslandSplits", mContextId);
+
+		PxU32 nbSplits = 0;
+		for (PxU32 a = 0; a < mNbTraversalTasks; ++a)
+		{
+			const TraversalContext& context = *mTraversalContexts[a];
+			nbSplits += context.mIslandSplits.size();
+			mIslandSplitStats.mNbHops += context.mNbHops;
+		}
+		mIslandSplitStats.mNbSplits = nbSplits;
+
+		// PT: register the new islands in the order in which a single thread would have found them, so that island handles
+		// and the order of active islands do not depend on the number of threads.
+		PxArray<const IslandSplit*> splits;
+		splits.reserve(nbSplits);
+		for (PxU32 a = 0; a < mNbTraversalTasks; ++a)
+		{
+			const TraversalContext& context = *mTraversalContexts[a];
+			for (PxU32 b = 0; b < context.mIslandSplits.size(); ++b)
+				splits.pushBack(&context.mIslandSplits[b]);
+		}
+		// PT: even with a single context, dirty nodes have been processed island by island, so this is always needed.
+		PxSort(splits.begin(), nbSplits, IslandSplitPtrLess());
+
+		for (PxU32 a = 0; a < nbSplits; ++a)
+		{
+			const IslandSplit& split = *splits[a];
+
+			const IslandId newIslandHandle = mIslandHandles.getHandle();
+			mIslands.resize(PxMax(newIslandHandle + 1, mIslands.size()));
+			mIslandStaticTouchCount.resize(PxMax(newIslandHandle + 1, mIslandStaticTouchCount.size()));
+			Island& newIsland = mIslands[newIslandHandle];
+
+			if (mIslandAwake.test(split.mParentIslandId))
+			{
+				newIsland.mActiveIndex = mActiveIslands.size();
+				mActiveIslands.pushBack(newIslandHandle);
+				mIslandAwake.growAndSet(newIslandHandle); //Separated island, so it should be awake
+			}
+			else
+			{
+				mIslandAwake.growAndReset(newIslandHandle);
+			}
+
+			newIsland.mRootNode = split.mIsland.mRootNode;
+			newIsland.mLastNode = split.mIsland.mLastNode;
+			for (PxU32 i = 0; i < Node::eTYPE_COUNT; ++i)
+				newIsland.mNodeCount[i] = split.mIsland.mNodeCount[i];
+
+			for (PxU32 j = 0; j < IG::Edge::eEDGE_TYPE_COUNT; ++j)
+			{
+				if (split.mIsland.mEdgeCount[j])
+				{
+					newIsland.mFirstEdge[j] = split.mIsland.mFirstEdge[j];
+					newIsland.mLastEdge[j] = split.mIsland.mLastEdge[j];
+					newIsland.mEdgeCount[j] = split.mIsland.mEdgeCount[j];
+				}
+			}
+
+			mIslandStaticTouchCount[newIslandHandle] = split.mStaticTouchCount;
+
+			PxNodeIndex nodeIndex = newIsland.mRootNode;
+			while (nodeIndex.index() != PX_INVALID_NODE)
+			{
+				PX_ASSERT(mIslandIds[nodeIndex.index()] == split.mParentIslandId);
+				mIslandIds[nodeIndex.index()] = newIslandHandle;
+				nodeIndex = mNodes[nodeIndex.index()].mNextNode;
+			}
+		}
 
-		//mDirtyNodes.forceSize_Unsafe(0);
+		PX_PROFILE_VALUE(PxI32(mIslandSplitStats.mNbIslands), "Basic.islandSplit.nbIslands", mContextId);
+		PX_PROFILE_VALUE(PxI32(mIslandSplitStats.mNbHops), "Basic.islandSplit.nbHops", mContextId);
+		PX_PROFILE_VALUE(PxI32(mIslandSplitStats.mNbSplits), "Basic.islandSplit.nbSplits", mContextId);
 	}
 
 	{
@@ -59,11 +59,12 @@ public:
 	static const PxU32 BATCH_SIZE = 128;
 	//static const PxU32 BATCH_SIZE = 32;
 
-	PxsCMUpdateTask(PxsContext* context, PxReal dt, PxsContactManager** cmArray, PxsContactManagerOutput* cmOutputs, Gu::Cache* caches, PxU32 cmCount, PxContactModifyCallback* callback) :
+	PxsCMUpdateTask(PxsContext* context, PxReal dt, PxsContactManager** cmArray, PxsContactManagerOutput* cmOutputs, Gu::Cache* caches, PxcRestingContactKey* restingKeys, PxU32 cmCount, PxContactModifyCallback* callback) :
 			Cm::Task		(context->getContextId()),
 			mCmArray		(cmArray),
 			mCmOutputs		(cmOutputs),
 			mCaches			(caches),
+			mRestingKeys	(restingKeys),
 			mContext		(context),
 			mCallback		(callback),
 			mCmCount		(cmCount),
@@ -78,6 +79,7 @@ public:
 	PxsContactManager**				mCmArray;
 	PxsContactManagerOutput*		mCmOutputs;
 	Gu::Cache*						mCaches;
+	PxcRestingContactKey*			mRestingKeys;	// PT: NULL if the resting contact cache is disabled
 	PxsContext*						mContext;
 	PxContactModifyCallback*		mCallback;
 	const PxU32						mCmCount;
@@ -111,9 +113,9 @@ static const bool gUseNewTaskAllocationScheme = false;
 class PxsCMDiscreteUpdateTask : public PxsCMUpdateTask
 {
 public:
-	PxsCMDiscreteUpdateTask(PxsContext* context, PxReal dt, PxsContactManager** cms, PxsContactManagerOutput* cmOutputs, Gu::Cache* caches, PxU32 nbCms,
+	PxsCMDiscreteUpdateTask(PxsContext* context, PxReal dt, PxsContactManager** cms, PxsContactManagerOutput* cmOutputs, Gu::Cache* caches, PxcRestingContactKey* restingKeys, PxU32 nbCms,
 		PxContactModifyCallback* callback):
-	  PxsCMUpdateTask(context, dt, cms, cmOutputs, caches, nbCms, callback)
+	  PxsCMUpdateTask(context, dt, cms, cmOutputs, caches, restingKeys, nbCms, callback)
 	{}
 
 	virtual ~PxsCMDiscreteUpdateTask()
@@ -399,7 +401,7 @@ public:
 		maxPatches_ = maxPatches;
 	}
 
-	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&, PxU64)>
+	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&, PxcRestingContactKey*, PxU64)>
 	void processCms(PxcNpThreadContext* threadContext)
 	{
 		const PxU64 contextID = mContext->getContextId();
@@ -444,7 +446,7 @@ public:
 
 				Gu::Cache& cache = mCaches[i];
 
-				NarrowPhase(*threadContext, unit, cache, output, contextID);
+				NarrowPhase(*threadContext, unit, cache, output, mRestingKeys ? mRestingKeys + i : NULL, contextID);
 				
 				const PxU16 newTouch = PxTo8(output.statusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
 				
@@ -531,6 +533,8 @@ static void processContactManagers(PxsContext& context, PxsContactManagers& narr
 	taskPool.lock();
 	/*const*/ PxU32 nbCmsToProcess = narrowPhasePairs.mContactManagerMapping.size();
 
+	PxcRestingContactKey* restingKeys = context.getRestingContactCache() ? narrowPhasePairs.mRestingKeys.begin() : NULL;
+
 	// PT: TASK-CREATION TAG
 	if(!gUseNewTaskAllocationScheme)
 	{
@@ -539,7 +543,7 @@ static void processContactManagers(PxsContext& context, PxsContactManagers& narr
 			void* ptr = taskPool.allocateNotThreadSafe(sizeof(PxsCMDiscreteUpdateTask));
 			PxU32 nbToProcess = PxMin(nbCmsToProcess - a, PxsCMUpdateTask::BATCH_SIZE);
 			PxsCMDiscreteUpdateTask* task = PX_PLACEMENT_NEW(ptr, PxsCMDiscreteUpdateTask)(&context, dt, narrowPhasePairs.mContactManagerMapping.begin() + a, 
-				cmOutputs + a, narrowPhasePairs.mCaches.begin() + a, nbToProcess, modifyCallback);
+				cmOutputs + a, narrowPhasePairs.mCaches.begin() + a, restingKeys ? restingKeys + a : NULL, nbToProcess, modifyCallback);
 
 			a += nbToProcess;
 
@@ -571,7 +575,7 @@ static void processContactManagers(PxsContext& context, PxsContactManagers& narr
 
 				void* ptr = taskPool.allocateNotThreadSafe(sizeof(PxsCMDiscreteUpdateTask));
 				PxsCMDiscreteUpdateTask* task = PX_PLACEMENT_NEW(ptr, PxsCMDiscreteUpdateTask)(&context, dt, narrowPhasePairs.mContactManagerMapping.begin() + start,
-					cmOutputs + start, narrowPhasePairs.mCaches.begin() + start, nb, modifyCallback);
+					cmOutputs + start, narrowPhasePairs.mCaches.begin() + start, restingKeys ? restingKeys + start : NULL, nb, modifyCallback);
 
 				task->setContinuation(continuation);
 				task->removeReference();
@@ -674,6 +678,9 @@ void PxsNphaseImplementationContext::registerContactManager(PxsContactManager* c
 	mNewNarrowPhasePairs.mCaches.pushBack(cache);
 	mNewNarrowPhasePairs.mContactManagerMapping.pushBack(cm);
 
+	if(mContext.getRestingContactCache())
+		mNewNarrowPhasePairs.mRestingKeys.insert().invalidate();
+
 	if(mGPU)
 	{
 		mNewNarrowPhasePairs.mShapeInteractionsGPU.pushBack(shapeInteraction);
@@ -809,6 +816,7 @@ void PxsNphaseImplementationContext::appendContactManagers()
 	const PxU32 existingSize = mNarrowPhasePairs.mContactManagerMapping.size();
 	const PxU32 nbToAdd = mNewNarrowPhasePairs.mContactManagerMapping.size();
 	const PxU32 newSize = existingSize + nbToAdd;
+	const bool restingContactCache = mContext.getRestingContactCache();
 	
 	if(newSize > mNarrowPhasePairs.mContactManagerMapping.capacity())
 	{
@@ -817,6 +825,8 @@ void PxsNphaseImplementationContext::appendContactManagers()
 		mNarrowPhasePairs.mContactManagerMapping.reserve(newSz);
 		mNarrowPhasePairs.mOutputContactManagers.reserve(newSz);
 		mNarrowPhasePairs.mCaches.reserve(newSz);
+		if(restingContactCache)
+			mNarrowPhasePairs.mRestingKeys.reserve(newSz);
 		if(mGPU)
 		{
 			mNarrowPhasePairs.mShapeInteractionsGPU.reserve(newSz);
@@ -828,6 +838,8 @@ void PxsNphaseImplementationContext::appendContactManagers()
 	mNarrowPhasePairs.mContactManagerMapping.forceSize_Unsafe(newSize);
 	mNarrowPhasePairs.mOutputContactManagers.forceSize_Unsafe(newSize);
 	mNarrowPhasePairs.mCaches.forceSize_Unsafe(newSize);
+	if(restingContactCache)
+		mNarrowPhasePairs.mRestingKeys.forceSize_Unsafe(newSize);
 	if(mGPU)
 	{
 		mNarrowPhasePairs.mShapeInteractionsGPU.forceSize_Unsafe(newSize);
@@ -838,6 +850,8 @@ void PxsNphaseImplementationContext::appendContactManagers()
 	PxMemCopy(mNarrowPhasePairs.mContactManagerMapping.begin() + existingSize, mNewNarrowPhasePairs.mContactManagerMapping.begin(), sizeof(PxsContactManager*)*nbToAdd);
 	PxMemCopy(mNarrowPhasePairs.mOutputContactManagers.begin() + existingSize, mNewNarrowPhasePairs.mOutputContactManagers.begin(), sizeof(PxsContactManagerOutput)*nbToAdd);
 	PxMemCopy(mNarrowPhasePairs.mCaches.begin() + existingSize, mNewNarrowPhasePairs.mCaches.begin(), sizeof(Gu::Cache)*nbToAdd);
+	if(restingContactCache)
+		PxMemCopy(mNarrowPhasePairs.mRestingKeys.begin() + existingSize, mNewNarrowPhasePairs.mRestingKeys.begin(), sizeof(PxcRestingContactKey)*nbToAdd);
 	if(mGPU)
 	{
 		PxMemCopy(mNarrowPhasePairs.mShapeInteractionsGPU.begin() + existingSize, mNewNarrowPhasePairs.mShapeInteractionsGPU.begin(), sizeof(Sc::ShapeInteraction*)*nbToAdd);
@@ -872,6 +886,7 @@ void PxsNphaseImplementationContext::appendContactManagersFallback(PxsContactMan
 	const PxU32 existingSize = mNarrowPhasePairs.mContactManagerMapping.size();
 	const PxU32 nbToAdd = mNewNarrowPhasePairs.mContactManagerMapping.size();
 	const PxU32 newSize = existingSize + nbToAdd;
+	const bool restingContactCache = mContext.getRestingContactCache();
 	
 	if(newSize > mNarrowPhasePairs.mContactManagerMapping.capacity())
 	{
@@ -879,6 +894,8 @@ void PxsNphaseImplementationContext::appendContactManagersFallback(PxsContactMan
 
 		mNarrowPhasePairs.mContactManagerMapping.reserve(newSz);
 		mNarrowPhasePairs.mCaches.reserve(newSz);
+		if(restingContactCache)
+			mNarrowPhasePairs.mRestingKeys.reserve(newSz);
 		if(mGPU)
 		{
 			mNarrowPhasePairs.mShapeInteractionsGPU.reserve(newSz);
@@ -889,6 +906,8 @@ void PxsNphaseImplementationContext::appendContactManagersFallback(PxsContactMan
 
 	mNarrowPhasePairs.mContactManagerMapping.forceSize_Unsafe(newSize);
 	mNarrowPhasePairs.mCaches.forceSize_Unsafe(newSize);
+	if(restingContactCache)
+		mNarrowPhasePairs.mRestingKeys.forceSize_Unsafe(newSize);
 	if(mGPU)
 	{
 		mNarrowPhasePairs.mShapeInteractionsGPU.forceSize_Unsafe(newSize);
@@ -899,6 +918,8 @@ void PxsNphaseImplementationContext::appendContactManagersFallback(PxsContactMan
 	PxMemCopy(mNarrowPhasePairs.mContactManagerMapping.begin() + existingSize, mNewNarrowPhasePairs.mContactManagerMapping.begin(), sizeof(PxsContactManager*)*nbToAdd);
 	PxMemCopy(cmOutputs + existingSize, mNewNarrowPhasePairs.mOutputContactManagers.begin(), sizeof(PxsContactManagerOutput)*nbToAdd);
 	PxMemCopy(mNarrowPhasePairs.mCaches.begin() + existingSize, mNewNarrowPhasePairs.mCaches.begin(), sizeof(Gu::Cache)*nbToAdd);
+	if(restingContactCache)
+		PxMemCopy(mNarrowPhasePairs.mRestingKeys.begin() + existingSize, mNewNarrowPhasePairs.mRestingKeys.begin(), sizeof(PxcRestingContactKey)*nbToAdd);
 	if(mGPU)
 	{
 		PxMemCopy(mNarrowPhasePairs.mShapeInteractionsGPU.begin() + existingSize, mNewNarrowPhasePairs.mShapeInteractionsGPU.begin(), sizeof(Sc::ShapeInteraction*)*nbToAdd);
@@ -982,6 +1003,8 @@ void PxsNphaseImplementationContext::unregisterContactManagerInternal(PxU32 npIn
 	managers.mContactManagerMapping[index] = replaceManager;
 	managers.mCaches[index] = managers.mCaches[replaceIndex];
 	cmOutputs[index] = cmOutputs[replaceIndex];
+	if(mContext.getRestingContactCache())
+		managers.mRestingKeys[index] = managers.mRestingKeys[replaceIndex];
 	if(mGPU)
 	{
 		managers.mShapeInteractionsGPU[index] = managers.mShapeInteractionsGPU[replaceIndex];
@@ -998,6 +1021,8 @@ void PxsNphaseImplementationContext::unregisterContactManagerInternal(PxU32 npIn
 
 	managers.mContactManagerMapping.forceSize_Unsafe(replaceIndex);
 	managers.mCaches.forceSize_Unsafe(replaceIndex);
+	if(mContext.getRestingContactCache())
+		managers.mRestingKeys.forceSize_Unsafe(replaceIndex);
 	if(mGPU)
 	{
 		managers.mShapeInteractionsGPU.forceSize_Unsafe(replaceIndex);
@@ -31,6 +31,7 @@
 #include "foundation/PxSort.h"
 #include "PxsContactManager.h"
 #include "CmTask.h"
+#include "CmFlushPool.h"
 #include "DyVArticulation.h"
 
 using namespace physx;
@@ -38,7 +39,44 @@ using namespace IG;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-ThirdPassTask::ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim)
+namespace
+{
+	class BreakIslandsTask : public Cm::Task
+	{
+		PX_NOCOPY(BreakIslandsTask)
+	public:
+		BreakIslandsTask(PxU64 contextID, IslandSim& islandSim, PxU32 contextIndex) : Cm::Task(contextID), mIslandSim(islandSim), mContextIndex(contextIndex)
+		{
+		}
+
+		virtual void runInternal()
+		{
+			mIslandSim.findPathsAndBreakIslands(mContextIndex);
+		}
+
+		virtual const char* getName() const
+		{
+			return "BreakIslandsTask";
+		}
+
+		IslandSim&	mIslandSim;
+		const PxU32	mContextIndex;
+	};
+}
+
+ThirdPassFinalizeTask::ThirdPassFinalizeTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim)
+{
+}
+
+void ThirdPassFinalizeTask::runInternal()
+{
+	PX_PROFILE_ZONE("Basic.thirdPassIslandGenFinalize", mContextID);
+
+	mIslandSim.processLostEdgesPart2(mIslandManager.mDestroyedNodes, true, true);
+}
+
+ThirdPassTask::ThirdPassTask(PxU64 contextID, SimpleIslandManager& islandManager, IslandSim& islandSim) : Cm::Task(contextID), mIslandManager(islandManager), mIslandSim(islandSim),
+	mFinalizeTask(contextID, islandManager, islandSim)
 {
 }
 
@@ -47,7 +85,34 @@ void ThirdPassTask::runInternal()
 	PX_PROFILE_ZONE("Basic.thirdPassIslandGen", mContextID);
 
 	mIslandSim.removeDestroyedEdges();
-	mIslandSim.processLostEdges(mIslandManager.mDestroyedNodes, true, true, mIslandManager.mMaxDirtyNodesPerFrame);
+
+	// PT: the route-finding for different islands is independent, so it can run on multiple threads. The results do not depend
+	// on the number of tasks, see IslandSim::processLostEdgesPart1().
+	const PxU32 nbWorkers = getTaskManager()->getCpuDispatcher()->getWorkerCount();
+	const PxU32 nbTasks = mIslandSim.processLostEdgesPart1(true, mIslandManager.mMaxDirtyNodesPerFrame, PxMax(nbWorkers, 1u));
+	if(nbTasks > 1)
+	{
+		mFinalizeTask.setContinuation(mCont);
+
+		Cm::FlushPool& taskPool = *mIslandManager.mTaskPool;
+		for(PxU32 a = 1; a < nbTasks; ++a)
+		{
+			BreakIslandsTask* task = PX_PLACEMENT_NEW(taskPool.allocate(sizeof(BreakIslandsTask)), BreakIslandsTask)(mContextID, mIslandSim, a);
+			task->setContinuation(&mFinalizeTask);
+			task->removeReference();
+		}
+
+		mIslandSim.findPathsAndBreakIslands(0);
+
+		mFinalizeTask.removeReference();
+	}
+	else
+	{
+		if(nbTasks)
+			mIslandSim.findPathsAndBreakIslands(0);
+
+		mIslandSim.processLostEdgesPart2(mIslandManager.mDestroyedNodes, true, true);
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -83,6 +148,7 @@ SimpleIslandManager::SimpleIslandManager(bool useEnhancedDeterminism, bool gpu,
 	mSpeculativeThirdPassTask	(contextID, *this, mSpeculativeIslandManager),
 	mAccurateThirdPassTask		(contextID, *this, mAccurateIslandManager),
 	mPostThirdPassTask			(contextID, *this),
+	mTaskPool					(NULL),
 	mContextID					(contextID),
 	mGPU						(gpu)
 {
@@ -329,8 +395,10 @@ void SimpleIslandManager::secondPassIslandGenPart2()
 	//mDestroyedEdges.clear();
 }
 
-void SimpleIslandManager::thirdPassIslandGen(PxBaseTask* continuation)
+void SimpleIslandManager::thirdPassIslandGen(PxBaseTask* continuation, Cm::FlushPool& taskPool)
 {
+	mTaskPool = &taskPool;
+
 	mAccurateIslandManager.clearDeactivations();
 
 	mPostThirdPassTask.setContinuation(continuation);
@@ -30,6 +30,7 @@
 #define BP_AABB_MANAGER_TASKS_H
 
 #include "foundation/PxUserAllocated.h"
+#include "foundation/PxBounds3.h"
 #include "CmTask.h"
 
 namespace physx
@@ -69,6 +70,69 @@ namespace Bp
 				Aggregate**		mAggregates;
 	};
 
+	// PT: computes the bounds of a subset of a large aggregate's shapes. Several of these tasks run in parallel for the same
+	// aggregate, then an AggregateFinalizeBoundsTask merges their results.
+	class AggregateSubsetBoundsTask : public Cm::Task, public PxUserAllocated
+	{
+		PX_NOCOPY(AggregateSubsetBoundsTask)
+		public:
+								AggregateSubsetBoundsTask(PxU64 contextId) :
+									Cm::Task		(contextId),
+									mManager		(NULL),
+									mAggregate		(NULL),
+									mStart			(0),
+									mNbToGo			(0),
+									mMergedBounds	(NULL)
+								{}
+								~AggregateSubsetBoundsTask()	{}
+
+		virtual const char*		getName() const { return "AggregateSubsetBoundsTask"; }
+		virtual void			runInternal();
+
+				void			Init(AABBManager* manager, Aggregate* aggregate, PxU32 start, PxU32 nb, PxBounds3* mergedBounds)
+								{
+									mManager		= manager;
+									mAggregate		= aggregate;
+									mStart			= start;
+									mNbToGo			= nb;
+									mMergedBounds	= mergedBounds;
+								}
+		private:
+				AABBManager*	mManager;
+				Aggregate*		mAggregate;
+				PxU32			mStart;
+				PxU32			mNbToGo;
+				PxBounds3*		mMergedBounds;
+	};
+
+	// PT: merges the bounds computed by AggregateSubsetBoundsTask and refits (or rebuilds) the aggregate's tree
+	class AggregateFinalizeBoundsTask : public Cm::Task, public PxUserAllocated
+	{
+		PX_NOCOPY(AggregateFinalizeBoundsTask)
+		public:
+								AggregateFinalizeBoundsTask(PxU64 contextId) :
+									Cm::Task		(contextId),
+									mAggregate		(NULL),
+									mNbSubsets		(0),
+									mSubsetBounds	(NULL)
+								{}
+								~AggregateFinalizeBoundsTask()	{}
+
+		virtual const char*		getName() const { return "AggregateFinalizeBoundsTask"; }
+		virtual void			runInternal();
+
+				void			Init(Aggregate* aggregate, PxU32 nbSubsets, const PxBounds3* subsetBounds)
+								{
+									mAggregate		= aggregate;
+									mNbSubsets		= nbSubsets;
+									mSubsetBounds	= subsetBounds;
+								}
+		private:
+				Aggregate*			mAggregate;
+				PxU32				mNbSubsets;
+				const PxBounds3*	mSubsetBounds;
+	};
+
 	class PreBpUpdateTask : public Cm::Task, public PxUserAllocated
 	{
 		PX_NOCOPY(PreBpUpdateTask)
@@ -41,7 +41,12 @@
 #include "foundation/PxSort.h"
 #include "foundation/PxVecMath.h"
 #include "GuInternal.h"
+#include "GuAABBTree.h"
+#include "GuAABBTreeNode.h"
+#include "GuAABBTreeBounds.h"
+#include "GuAABBTreeBuildStats.h"
 #include "common/PxProfileZone.h"
+#include "foundation/PxInlineArray.h"
 
 using namespace physx;
 using namespace Bp;
@@ -49,6 +54,14 @@ using namespace Cm;
 using namespace aos;
 
 static const bool gSingleThreaded = false;
+// PT: aggregates with at least this many shapes use a persistent AABB tree instead of sorting & pruning a flat list each frame
+static const PxU32 gAggregateTreeThreshold = 128;
+// PT: max number of shapes per leaf in these trees
+static const PxU32 gAggregateTreeLeafSize = 4;
+// PT: aggregates with at least this many shapes have their bounds computed by several tasks in the multi-threaded codepath
+static const PxU32 gAggregateSplitThreshold = 2048;
+// PT: refit trees are rebuilt when their cost (sum of internal nodes' surface areas) grows past this factor of the cost after the build
+static const float gAggregateTreeRebuildFactor = 2.0f;
 #if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED)
 	#define ABP_SIMD_OVERLAP
 #endif
@@ -114,8 +127,8 @@ static PX_FORCE_INLINE bool shouldPairBeDeleted(const GroupsArrayPinnedSafe& gro
 		PX_FORCE_INLINE	PxU32							getNbAggregated()		const	{ return mAggregated.size();					}
 		PX_FORCE_INLINE	BoundsIndex						getAggregated(PxU32 i)	const	{ return mAggregated[i];						}
 		PX_FORCE_INLINE	const BoundsIndex*				getIndices()			const	{ return mAggregated.begin();					}
-		PX_FORCE_INLINE	void							addAggregated(BoundsIndex i)	{ mAggregated.pushBack(i);						}
-		PX_FORCE_INLINE	bool							removeAggregated(BoundsIndex i)	{ return mAggregated.findAndReplaceWithLast(i);	}	// PT: TODO: optimize?
+		PX_FORCE_INLINE	void							addAggregated(BoundsIndex i)	{ mAggregated.pushBack(i); mDirtyTree = true;	}
+		PX_FORCE_INLINE	bool							removeAggregated(BoundsIndex i)	{ mDirtyTree = true; return mAggregated.findAndReplaceWithLast(i);	}	// PT: TODO: optimize?
 		PX_FORCE_INLINE	const PxBounds3&				getMergedBounds()		const	{ return mBounds;								}
 
 		PX_FORCE_INLINE	void							resetDirtyState()				{ mDirtyIndex = PX_INVALID_U32;				}
@@ -131,11 +144,23 @@ static PX_FORCE_INLINE bool shouldPairBeDeleted(const GroupsArrayPinnedSafe& gro
 
 						void							allocateBounds();
 						void							computeBounds(const PxBounds3* PX_RESTRICT bounds, const float* PX_RESTRICT contactDistances) /*PX_RESTRICT*/;
+		// PT: computeBounds split in two parts, so that the bounds of large aggregates can be computed by several tasks. The first part
+		// computes the inflated bounds of a range of aggregated shapes and returns their merged bounds. The second part takes the merged
+		// bounds of all ranges and updates the tree, if any.
+						void							computeInflatedBounds(const PxBounds3* PX_RESTRICT bounds, const float* PX_RESTRICT contactDistances, PxU32 start, PxU32 nb, PxBounds3& mergedBounds);
+						void							finalizeBounds(const PxBounds3& mergedBounds);
+
+		// PT: true for large aggregates using a persistent tree (built or refit in computeBounds). Sorted bounds are not available for these.
+		PX_FORCE_INLINE	bool							hasTree()		const	{ return mTreeNodes.size()!=0;	}
+		PX_FORCE_INLINE	const Gu::BVHNode*				getTreeNodes()	const	{ return mTreeNodes.begin();	}
+		PX_FORCE_INLINE	const PxBounds3*				getTreeBounds()	const	{ return mTreeBounds.getBounds();	}
+		PX_FORCE_INLINE	const PxU32*					getTreeIndices()	const	{ return mTreeIndices;		}
 
 		PX_FORCE_INLINE	const AABB_Xi*					getBoundsX()	const	{ return mInflatedBoundsX;	}
 		PX_FORCE_INLINE	const AABB_YZ*					getBoundsYZ()	const	{ return mInflatedBoundsYZ;	}
 		PX_FORCE_INLINE	void							getSortedMinBounds()
 														{
+															PX_ASSERT(!hasTree());
 															if(mDirtySort)
 																sortBounds();
 														}
@@ -144,8 +169,15 @@ static PX_FORCE_INLINE bool shouldPairBeDeleted(const GroupsArrayPinnedSafe& gro
 						PxBounds3						mBounds;
 						PxAggregateFilterHint			mFilterHint;
 						bool							mDirtySort;
+						bool							mDirtyTree;		// PT: aggregated shapes have been added or removed since the tree was built
+						float							mTreeCost;		// PT: cost of the tree right after its last build
+						Gu::AABBTreeBounds				mTreeBounds;	// PT: inflated bounds of aggregated shapes (tree mode only), in mAggregated order
+						PxArray<Gu::BVHNode>			mTreeNodes;		// PT: tree over mTreeBounds, a few shapes per leaf
+						PxU32*							mTreeIndices;	// PT: leaf shapes, i.e. indices in mTreeBounds and mAggregated
 
 						void							sortBounds();
+						void							updateTree();
+		PX_FORCE_INLINE	void							storeInflatedBounds(PxU32 i, const Vec4V minV, const Vec4V maxV);
 						PX_NOCOPY(Aggregate)
 	};
 
@@ -671,6 +703,254 @@ StartLoop:
 
 /////
 
+// PT: tree-based versions of the above, for aggregates using a persistent tree. Leaves contain a few shapes, referenced
+// by their index in the aggregate. Overlap tests use the same inclusive bounds as the pruning kernels, so both codepaths
+// report the same pairs.
+
+typedef PxInlineArray<PxU32, 256>	TreeTraversalStack;
+
+// PT: reads 4 bytes past the bounds, which is fine for tree nodes and for Gu::AABBTreeBounds (allocated with an extra box)
+static PX_FORCE_INLINE bool treeBoundsOverlap(const PxBounds3& bounds, const Vec4V minV, const Vec4V maxV)
+{
+	const BoolV separated = BOr(V4IsGrtr(V4LoadU(&bounds.minimum.x), maxV), V4IsGrtr(minV, V4LoadU(&bounds.maximum.x)));
+	return (BGetBitMask(separated) & 7)==0;
+}
+
+static PX_FORCE_INLINE bool treeBoundsOverlap(const PxBounds3& bounds0, const PxBounds3& bounds1)
+{
+	return treeBoundsOverlap(bounds0, V4LoadU(&bounds1.minimum.x), V4LoadU(&bounds1.maximum.x));
+}
+
+static PX_FORCE_INLINE float treeNodeSize(const Gu::BVHNode& node)
+{
+	const PxVec3 extents = node.mBV.maximum - node.mBV.minimum;
+	return extents.x + extents.y + extents.z;
+}
+
+namespace
+{
+	struct TreeData
+	{
+		PX_FORCE_INLINE	TreeData(const Aggregate* aggregate) :
+			mNodes		(aggregate->getTreeNodes()),
+			mPrims		(aggregate->getTreeIndices()),
+			mBounds		(aggregate->getTreeBounds()),
+			mRemap		(aggregate->getIndices())
+		{
+		}
+
+		const Gu::BVHNode* PX_RESTRICT	mNodes;
+		const PxU32* PX_RESTRICT		mPrims;		// PT: leaf prims, i.e. indices in mBounds & mRemap
+		const PxBounds3* PX_RESTRICT	mBounds;	// PT: inflated bounds of aggregated shapes
+		const BoundsIndex* PX_RESTRICT	mRemap;		// PT: aggregated shapes
+	};
+}
+
+static PX_FORCE_INLINE void outputTreePair(	PairArray* PX_RESTRICT pairManager, const bool* PX_RESTRICT lut, const Bp::FilterGroup::Enum* PX_RESTRICT groups,
+											BoundsIndex aggIndex0, BoundsIndex aggIndex1)
+{
+	if(groupFiltering(groups[aggIndex0], groups[aggIndex1], lut))
+		pairManager->addPair(aggIndex0, aggIndex1);
+}
+
+static PX_FORCE_INLINE void testTreeLeaves(	PairArray* PX_RESTRICT pairManager, const bool* PX_RESTRICT lut, const Bp::FilterGroup::Enum* PX_RESTRICT groups,
+											const TreeData& tree0, const Gu::BVHNode& leaf0, const TreeData& tree1, const Gu::BVHNode& leaf1)
+{
+	const PxU32* PX_RESTRICT prims0 = leaf0.getPrimitives(tree0.mPrims);
+	const PxU32* PX_RESTRICT prims1 = leaf1.getPrimitives(tree1.mPrims);
+	const PxU32 nb0 = leaf0.getNbPrimitives();
+	const PxU32 nb1 = leaf1.getNbPrimitives();
+	for(PxU32 i=0;i<nb0;i++)
+	{
+		const PxBounds3& box0 = tree0.mBounds[prims0[i]];
+		const Vec4V minV = V4LoadU(&box0.minimum.x);
+		const Vec4V maxV = V4LoadU(&box0.maximum.x);
+		for(PxU32 j=0;j<nb1;j++)
+		{
+			if(treeBoundsOverlap(tree1.mBounds[prims1[j]], minV, maxV))
+				outputTreePair(pairManager, lut, groups, tree0.mRemap[prims0[i]], tree1.mRemap[prims1[j]]);
+		}
+	}
+}
+
+static PX_FORCE_INLINE void testTreeLeaf(	PairArray* PX_RESTRICT pairManager, const bool* PX_RESTRICT lut, const Bp::FilterGroup::Enum* PX_RESTRICT groups,
+											const TreeData& tree, const Gu::BVHNode& leaf)
+{
+	const PxU32* PX_RESTRICT prims = leaf.getPrimitives(tree.mPrims);
+	const PxU32 nb = leaf.getNbPrimitives();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxBounds3& box0 = tree.mBounds[prims[i]];
+		const Vec4V minV = V4LoadU(&box0.minimum.x);
+		const Vec4V maxV = V4LoadU(&box0.maximum.x);
+		for(PxU32 j=i+1;j<nb;j++)
+		{
+			if(treeBoundsOverlap(tree.mBounds[prims[j]], minV, maxV))
+				outputTreePair(pairManager, lut, groups, tree.mRemap[prims[i]], tree.mRemap[prims[j]]);
+		}
+	}
+}
+
+// PT: processes a pair of overlapping nodes, pushing their overlapping children on the stack. Each stack entry is a pair of node indices.
+static PX_FORCE_INLINE void processTreeNodes(	PairArray* PX_RESTRICT pairManager, const bool* PX_RESTRICT lut, const Bp::FilterGroup::Enum* PX_RESTRICT groups,
+												TreeTraversalStack& stack, const TreeData& tree0, PxU32 index0, const TreeData& tree1, PxU32 index1)
+{
+	const Gu::BVHNode& node0 = tree0.mNodes[index0];
+	const Gu::BVHNode& node1 = tree1.mNodes[index1];
+	const bool isLeaf0 = node0.isLeaf()!=0;
+	const bool isLeaf1 = node1.isLeaf()!=0;
+	if(isLeaf0 && isLeaf1)
+	{
+		testTreeLeaves(pairManager, lut, groups, tree0, node0, tree1, node1);
+	}
+	else if(!isLeaf0 && !isLeaf1)
+	{
+		const PxU32 pos0 = node0.getPosIndex();
+		const PxU32 pos1 = node1.getPosIndex();
+		for(PxU32 i=0;i<2;i++)
+		{
+			const PxBounds3& child0 = tree0.mNodes[pos0+i].mBV;
+			const Vec4V minV = V4LoadU(&child0.minimum.x);
+			const Vec4V maxV = V4LoadU(&child0.maximum.x);
+			for(PxU32 j=0;j<2;j++)
+			{
+				if(treeBoundsOverlap(tree1.mNodes[pos1+j].mBV, minV, maxV))
+				{
+					stack.pushBack(pos0+i);
+					stack.pushBack(pos1+j);
+				}
+			}
+		}
+	}
+	else if(isLeaf1)
+	{
+		const PxU32 pos = node0.getPosIndex();
+		if(treeBoundsOverlap(tree0.mNodes[pos].mBV, node1.mBV))
+		{
+			stack.pushBack(pos);
+			stack.pushBack(index1);
+		}
+		if(treeBoundsOverlap(tree0.mNodes[pos+1].mBV, node1.mBV))
+		{
+			stack.pushBack(pos+1);
+			stack.pushBack(index1);
+		}
+	}
+	else
+	{
+		const PxU32 pos = node1.getPosIndex();
+		if(treeBoundsOverlap(node0.mBV, tree1.mNodes[pos].mBV))
+		{
+			stack.pushBack(index0);
+			stack.pushBack(pos);
+		}
+		if(treeBoundsOverlap(node0.mBV, tree1.mNodes[pos+1].mBV))
+		{
+			stack.pushBack(index0);
+			stack.pushBack(pos+1);
+		}
+	}
+}
+
+static void doBipartiteTreeTraversal(	PairArray* PX_RESTRICT pairManager, const bool* PX_RESTRICT lut,
+										const Aggregate* PX_RESTRICT aggregate0, const Aggregate* PX_RESTRICT aggregate1, const Bp::FilterGroup::Enum* PX_RESTRICT groups)
+{
+	const TreeData tree0(aggregate0);
+	const TreeData tree1(aggregate1);
+	if(!treeBoundsOverlap(tree0.mNodes[0].mBV, tree1.mNodes[0].mBV))
+		return;
+
+	TreeTraversalStack stack;
+	stack.pushBack(0);
+	stack.pushBack(0);
+	while(stack.size())
+	{
+		const PxU32 index1 = stack.popBack();
+		const PxU32 index0 = stack.popBack();
+		processTreeNodes(pairManager, lut, groups, stack, tree0, index0, tree1, index1);
+	}
+}
+
+static void doCompleteTreeTraversal(PairArray* PX_RESTRICT pairManager, const bool* PX_RESTRICT lut,
+									const Aggregate* PX_RESTRICT aggregate, const Bp::FilterGroup::Enum* PX_RESTRICT groups)
+{
+	const TreeData tree(aggregate);
+
+	// PT: an entry (i, i) means "test node i against itself", other entries are pairs of overlapping nodes
+	TreeTraversalStack stack;
+	stack.pushBack(0);
+	stack.pushBack(0);
+	while(stack.size())
+	{
+		const PxU32 index1 = stack.popBack();
+		const PxU32 index0 = stack.popBack();
+		if(index0==index1)
+		{
+			const Gu::BVHNode& node = tree.mNodes[index0];
+			if(node.isLeaf())
+			{
+				testTreeLeaf(pairManager, lut, groups, tree, node);
+				continue;
+			}
+			const PxU32 pos = node.getPosIndex();
+			stack.pushBack(pos);	stack.pushBack(pos);
+			stack.pushBack(pos+1);	stack.pushBack(pos+1);
+			if(treeBoundsOverlap(tree.mNodes[pos].mBV, tree.mNodes[pos+1].mBV))
+			{
+				stack.pushBack(pos);
+				stack.pushBack(pos+1);
+			}
+		}
+		else
+			processTreeNodes(pairManager, lut, groups, stack, tree, index0, tree, index1);
+	}
+}
+
+// PT: a large aggregate against a small one (or a single actor): we query the tree with each shape of the small one
+static void doBoxesTreeTraversal(	PairArray* PX_RESTRICT pairManager, const bool* PX_RESTRICT lut, const Aggregate* PX_RESTRICT aggregate,
+									PxU32 nbBoxes, const BoundsIndex* PX_RESTRICT boxIndices, const PxBounds3* PX_RESTRICT bounds, const float* PX_RESTRICT contactDistances,
+									const Bp::FilterGroup::Enum* PX_RESTRICT groups)
+{
+	const TreeData tree(aggregate);
+
+	TreeTraversalStack stack;
+	for(PxU32 i=0;i<nbBoxes;i++)
+	{
+		const BoundsIndex boxIndex = boxIndices[i];
+		const PxBounds3& b = bounds[boxIndex];
+		const Vec4V offsetV = V4Load(contactDistances[boxIndex]);
+		const Vec4V minV = V4Sub(V4LoadU(&b.minimum.x), offsetV);
+		const Vec4V maxV = V4Add(V4LoadU(&b.maximum.x), offsetV);
+
+		stack.pushBack(0);
+		while(stack.size())
+		{
+			const Gu::BVHNode& node = tree.mNodes[stack.popBack()];
+			if(!treeBoundsOverlap(node.mBV, minV, maxV))
+				continue;
+
+			if(node.isLeaf())
+			{
+				const PxU32* PX_RESTRICT prims = node.getPrimitives(tree.mPrims);
+				const PxU32 nb = node.getNbPrimitives();
+				for(PxU32 j=0;j<nb;j++)
+				{
+					if(treeBoundsOverlap(tree.mBounds[prims[j]], minV, maxV))
+						outputTreePair(pairManager, lut, groups, tree.mRemap[prims[j]], boxIndex);
+				}
+			}
+			else
+			{
+				const PxU32 pos = node.getPosIndex();
+				stack.pushBack(pos);
+				stack.pushBack(pos+1);
+			}
+		}
+	}
+}
+
+/////
+
 class PersistentActorAggregatePair : public PersistentPairs
 {
 	public:
@@ -704,6 +984,10 @@ void PersistentActorAggregatePair::findOverlaps(PairArray& pairs, const PxBounds
 		mAggregate->getSortedMinBounds();
 		doBipartiteBoxPruning_Leaf(&pairs, lut, &singleActor, mAggregate, groups);
 	}
+	else if(mAggregate->hasTree())
+	{
+		doBoxesTreeTraversal(&pairs, lut, mAggregate, 1, &mActorHandle, bounds, contactDistances, groups);
+	}
 	else
 	{
 
@@ -784,8 +1068,26 @@ PersistentAggregateAggregatePair::PersistentAggregateAggregatePair(Aggregate* ag
 {
 }
 
-void PersistentAggregateAggregatePair::findOverlaps(PairArray& pairs, const PxBounds3* PX_RESTRICT /*bounds*/, const float* PX_RESTRICT /*contactDistances*/, const Bp::FilterGroup::Enum* PX_RESTRICT groups, const bool* PX_RESTRICT lut)
+void PersistentAggregateAggregatePair::findOverlaps(PairArray& pairs, const PxBounds3* PX_RESTRICT bounds, const float* PX_RESTRICT contactDistances, const Bp::FilterGroup::Enum* PX_RESTRICT groups, const bool* PX_RESTRICT lut)
 {
+	const bool hasTree0 = mAggregate0->hasTree();
+	const bool hasTree1 = mAggregate1->hasTree();
+	if(hasTree0 && hasTree1)
+	{
+		doBipartiteTreeTraversal(&pairs, lut, mAggregate0, mAggregate1, groups);
+		return;
+	}
+	if(hasTree0)
+	{
+		doBoxesTreeTraversal(&pairs, lut, mAggregate0, mAggregate1->getNbAggregated(), mAggregate1->getIndices(), bounds, contactDistances, groups);
+		return;
+	}
+	if(hasTree1)
+	{
+		doBoxesTreeTraversal(&pairs, lut, mAggregate1, mAggregate0->getNbAggregated(), mAggregate0->getIndices(), bounds, contactDistances, groups);
+		return;
+	}
+
 	mAggregate0->getSortedMinBounds();
 	mAggregate1->getSortedMinBounds();
 	doBipartiteBoxPruning_Leaf(&pairs, lut, mAggregate0, mAggregate1, groups);
@@ -825,6 +1127,12 @@ PersistentSelfCollisionPairs::PersistentSelfCollisionPairs(Aggregate* aggregate)
 
 void PersistentSelfCollisionPairs::findOverlaps(PairArray& pairs, const PxBounds3* PX_RESTRICT/*bounds*/, const float* PX_RESTRICT/*contactDistances*/, const Bp::FilterGroup::Enum* PX_RESTRICT groups, const bool* PX_RESTRICT lut)
 {
+	if(mAggregate->hasTree())
+	{
+		doCompleteTreeTraversal(&pairs, lut, mAggregate, groups);
+		return;
+	}
+
 	mAggregate->getSortedMinBounds();
 	doCompleteBoxPruning_Leaf(&pairs, lut, mAggregate, groups);
 }
@@ -837,7 +1145,10 @@ Aggregate::Aggregate(BoundsIndex index, PxAggregateFilterHint filterHint) :
 	mInflatedBoundsYZ	(NULL),
 	mAllocatedSize		(0),
 	mFilterHint			(filterHint),
-	mDirtySort			(false)
+	mDirtySort			(false),
+	mDirtyTree			(false),
+	mTreeCost			(0.0f),
+	mTreeIndices		(NULL)
 {
 	resetDirtyState();
 	const PxU32 selfCollisions = PxGetAggregateSelfCollisionBit(filterHint);
@@ -846,6 +1157,7 @@ Aggregate::Aggregate(BoundsIndex index, PxAggregateFilterHint filterHint) :
 
 Aggregate::~Aggregate()
 {
+	PX_FREE(mTreeIndices);
 	PX_FREE(mInflatedBoundsYZ);
 	PX_FREE(mInflatedBoundsX);
 
@@ -933,29 +1245,54 @@ void Aggregate::allocateBounds()
 		mAllocatedSize = size;
 		PX_FREE(mInflatedBoundsYZ);
 		PX_FREE(mInflatedBoundsX);
-		mInflatedBoundsX = PX_ALLOCATE(AABB_Xi, (size+NB_SENTINELS), "mInflatedBounds");
-		mInflatedBoundsYZ = PX_ALLOCATE(AABB_YZ, (size), "mInflatedBounds");
+		mTreeBounds.release();
+		mTreeNodes.reset();
+		PX_FREE(mTreeIndices);
+		if(size>=gAggregateTreeThreshold)
+		{
+			// PT: the tree uses regular bounds, it doesn't need the sorted/integer version
+			mTreeBounds.init(size);
+		}
+		else
+		{
+			mInflatedBoundsX = PX_ALLOCATE(AABB_Xi, (size+NB_SENTINELS), "mInflatedBounds");
+			mInflatedBoundsYZ = PX_ALLOCATE(AABB_YZ, (size), "mInflatedBounds");
+		}
 	}
 }
 
-void Aggregate::computeBounds(const PxBounds3* PX_RESTRICT bounds, const float* PX_RESTRICT contactDistances) /*PX_RESTRICT*/
+PX_FORCE_INLINE void Aggregate::storeInflatedBounds(PxU32 i, const Vec4V minV, const Vec4V maxV)
 {
-//	PX_PROFILE_ZONE("Aggregate::computeBounds",0);
+	PxBounds3* PX_RESTRICT treeBounds = mTreeBounds.getBounds();
+	if(treeBounds)
+	{
+		StoreBounds(treeBounds[i], minV, maxV);
+	}
+	else
+	{
+		PX_ALIGN(16, PxVec4) boxMin;
+		PX_ALIGN(16, PxVec4) boxMax;
+		V4StoreA(minV, &boxMin.x);
+		V4StoreA(maxV, &boxMax.x);
+		mInflatedBoundsX[i].initFromPxVec4(boxMin, boxMax);
+		mInflatedBoundsYZ[i].initFromPxVec4(boxMin, boxMax);
+	}
+}
 
-	const PxU32 size = getNbAggregated();
-	PX_ASSERT(size);
+void Aggregate::computeInflatedBounds(const PxBounds3* PX_RESTRICT bounds, const float* PX_RESTRICT contactDistances, PxU32 start, PxU32 nb, PxBounds3& mergedBounds)
+{
+	PX_ASSERT(nb);
+	PX_ASSERT(start+nb<=getNbAggregated());
+	const PxU32 end = start + nb;
 
 	// PT: TODO: delay the conversion to integers until we sort (i.e. really need) the aggregated bounds?
-	PX_ALIGN(16, PxVec4) boxMin;
-	PX_ALIGN(16, PxVec4) boxMax;
-
 	const PxU32 lookAhead = 4;
 	Vec4V minimumV;
 	Vec4V maximumV;
 	{
-		const BoundsIndex index0 = getAggregated(0);
-		const PxU32 last = PxMin(lookAhead, size-1);
-		for(PxU32 i=1;i<=last;i++)
+		const BoundsIndex index0 = getAggregated(start);
+		const PxU32 last = PxMin(start+lookAhead, end-1);
+		for(PxU32 i=start+1;i<=last;i++)
 		{
 			const BoundsIndex index = getAggregated(i);
 			PxPrefetchLine(bounds + index, 0);
@@ -965,16 +1302,13 @@ void Aggregate::computeBounds(const PxBounds3* PX_RESTRICT bounds, const float*
 		const Vec4V offsetV = V4Load(contactDistances[index0]);
 		minimumV = V4Sub(V4LoadU(&b.minimum.x), offsetV);
 		maximumV = V4Add(V4LoadU(&b.maximum.x), offsetV);
-		V4StoreA(minimumV, &boxMin.x);
-		V4StoreA(maximumV, &boxMax.x);
-		mInflatedBoundsX[0].initFromPxVec4(boxMin, boxMax);
-		mInflatedBoundsYZ[0].initFromPxVec4(boxMin, boxMax);
+		storeInflatedBounds(start, minimumV, maximumV);
 	}
 
-	for(PxU32 i=1;i<size;i++)
+	for(PxU32 i=start+1;i<end;i++)
 	{
 		const BoundsIndex index = getAggregated(i);
-		if(i+lookAhead<size)
+		if(i+lookAhead<end)
 		{
 			const BoundsIndex nextIndex = getAggregated(i+lookAhead);
 			PxPrefetchLine(bounds + nextIndex, 0);
@@ -986,28 +1320,102 @@ void Aggregate::computeBounds(const PxBounds3* PX_RESTRICT bounds, const float*
 		const Vec4V aggregatedBoundsMaxV = V4Add(V4LoadU(&b.maximum.x), offsetV);
 		minimumV = V4Min(minimumV, aggregatedBoundsMinV);
 		maximumV = V4Max(maximumV, aggregatedBoundsMaxV);
-		V4StoreA(aggregatedBoundsMinV, &boxMin.x);
-		V4StoreA(aggregatedBoundsMaxV, &boxMax.x);
-		mInflatedBoundsX[i].initFromPxVec4(boxMin, boxMax);
-		mInflatedBoundsYZ[i].initFromPxVec4(boxMin, boxMax);
+		storeInflatedBounds(i, aggregatedBoundsMinV, aggregatedBoundsMaxV);
 	}
 
-	StoreBounds(mBounds, minimumV, maximumV);
-//	StoreBounds(boundsArray.begin()[mIndex], minimumV, maximumV);
-//	boundsArray.setChangedState();
+	StoreBounds(mergedBounds, minimumV, maximumV);
+}
+
+static PX_FORCE_INLINE float getTreeNodeCost(const PxBounds3& bounds)
+{
+	const PxVec3 extents = bounds.maximum - bounds.minimum;
+	return extents.x*extents.y + extents.y*extents.z + extents.z*extents.x;
+}
 
-/*	if(0)
+void Aggregate::updateTree()
+{
+	const PxBounds3* PX_RESTRICT boxes = mTreeBounds.getBounds();
+	const PxU32 nbNodes = mTreeNodes.size();
+	if(!mDirtyTree && nbNodes)
 	{
-		const PxBounds3& previousBounds = boundsArray.getBounds(mIndex);
-		if(previousBounds.minimum==aggregateBounds.minimum && previousBounds.maximum==aggregateBounds.maximum)
+		// PT: bottom-up refit, children are always stored after their parent
+		Gu::BVHNode* PX_RESTRICT nodes = mTreeNodes.begin();
+		float cost = 0.0f;
+		PxU32 index = nbNodes;
+		while(index--)
 		{
-			// PT: same bounds as before
-			printf("SAME BOUNDS\n");
+			Gu::BVHNode& node = nodes[index];
+			if(node.isLeaf())
+			{
+				const PxU32* prims = node.getPrimitives(mTreeIndices);
+				const PxU32 nbPrims = node.getNbPrimitives();
+				node.mBV = boxes[prims[0]];
+				for(PxU32 i=1;i<nbPrims;i++)
+					node.mBV.include(boxes[prims[i]]);
+			}
+			else
+			{
+				const Gu::BVHNode* children = node.getPos(nodes);
+				node.mBV = children[0].mBV;
+				node.mBV.include(children[1].mBV);
+				cost += getTreeNodeCost(node.mBV);
+			}
 		}
-	}*/
-	for(PxU32 i=0;i<NB_SENTINELS;i++)
-		mInflatedBoundsX[size+i].initSentinel();
-	mDirtySort = true;
+
+		if(cost<=mTreeCost*gAggregateTreeRebuildFactor)
+			return;
+	}
+
+	// PT: the tree is rebuilt from scratch when aggregated shapes have been added or removed, or when refits degraded it too much
+	mDirtyTree = false;
+	{
+		Gu::AABBTreeBuildParams params(gAggregateTreeLeafSize, getNbAggregated(), &mTreeBounds);
+		Gu::NodeAllocator nodeAllocator;
+		Gu::BuildStats stats;
+		PX_FREE(mTreeIndices);
+		mTreeIndices = Gu::buildAABBTree(params, nodeAllocator, stats);
+		PX_ASSERT(mTreeIndices);
+		mTreeNodes.resize(stats.getCount());
+		Gu::flattenTree(nodeAllocator, mTreeNodes.begin());
+	}
+
+	float cost = 0.0f;
+	const PxU32 nbNewNodes = mTreeNodes.size();
+	for(PxU32 i=0;i<nbNewNodes;i++)
+	{
+		if(!mTreeNodes[i].isLeaf())
+			cost += getTreeNodeCost(mTreeNodes[i].mBV);
+	}
+	mTreeCost = cost;
+}
+
+void Aggregate::finalizeBounds(const PxBounds3& mergedBounds)
+{
+	mBounds = mergedBounds;
+
+	if(mTreeBounds.getBounds())
+	{
+		updateTree();
+	}
+	else
+	{
+		const PxU32 size = getNbAggregated();
+		for(PxU32 i=0;i<NB_SENTINELS;i++)
+			mInflatedBoundsX[size+i].initSentinel();
+		mDirtySort = true;
+	}
+}
+
+void Aggregate::computeBounds(const PxBounds3* PX_RESTRICT bounds, const float* PX_RESTRICT contactDistances) /*PX_RESTRICT*/
+{
+//	PX_PROFILE_ZONE("Aggregate::computeBounds",0);
+
+	const PxU32 size = getNbAggregated();
+	PX_ASSERT(size);
+
+	PxBounds3 mergedBounds;
+	computeInflatedBounds(bounds, contactDistances, 0, size, mergedBounds);
+	finalizeBounds(mergedBounds);
 }
 
 /////
@@ -1344,11 +1752,31 @@ void AggregateBoundsComputationTask::runInternal()
 			PxPrefetchLine(nextAggregate, 64);
 		}
 
-		(*currentAggregate)->computeBounds(boundArray.begin(), contactDistances);
+		// PT: large aggregates are processed by their own tasks, see startAggregateBoundsComputationTasks
+		if((*currentAggregate)->getNbAggregated()<gAggregateSplitThreshold)
+			(*currentAggregate)->computeBounds(boundArray.begin(), contactDistances);
 		currentAggregate++;
 	}
 }
 
+void AggregateSubsetBoundsTask::runInternal()
+{
+	const BoundsArray& boundArray = mManager->getBoundsArray();
+	const float* contactDistances = mManager->getContactDistances();
+
+	mAggregate->computeInflatedBounds(boundArray.begin(), contactDistances, mStart, mNbToGo, *mMergedBounds);
+}
+
+void AggregateFinalizeBoundsTask::runInternal()
+{
+	PxBounds3 mergedBounds = mSubsetBounds[0];
+	for(PxU32 i=1;i<mNbSubsets;i++)
+		mergedBounds.include(mSubsetBounds[i]);
+
+	// PT: TODO: the tree refit is single-threaded for now
+	mAggregate->finalizeBounds(mergedBounds);
+}
+
 void PreBpUpdateTask::runInternal()
 {
 	mManager->preBpUpdate_CPU(mNumCpuTasks);
@@ -1356,6 +1784,37 @@ void PreBpUpdateTask::runInternal()
 
 void AABBManager::startAggregateBoundsComputationTasks(PxU32 nbToGo, PxU32 numCpuTasks, Cm::FlushPool& flushPool)
 {
+	// PT: the shapes of large aggregates are split across tasks. These aggregates are then skipped by AggregateBoundsComputationTask.
+	for(PxU32 i=0;i<nbToGo;i++)
+	{
+		Aggregate* aggregate = mDirtyAggregates[i];
+		const PxU32 size = aggregate->getNbAggregated();
+		if(size<gAggregateSplitThreshold)
+			continue;
+
+		const PxU32 nbSubsets = PxMin(numCpuTasks, size);
+		PxBounds3* subsetBounds = reinterpret_cast<PxBounds3*>(flushPool.allocate(sizeof(PxBounds3)*nbSubsets));
+
+		AggregateFinalizeBoundsTask* finalizeTask = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(AggregateFinalizeBoundsTask)), AggregateFinalizeBoundsTask(mContextID));
+		finalizeTask->Init(aggregate, nbSubsets, subsetBounds);
+		finalizeTask->setContinuation(&mPreBpUpdateTask);
+
+		const PxU32 nbPerTask = size / nbSubsets;
+		PxU32 start = 0;
+		for(PxU32 j=0;j<nbSubsets;j++)
+		{
+			const PxU32 nb = j==nbSubsets-1 ? size - start : nbPerTask;
+
+			AggregateSubsetBoundsTask* T = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(AggregateSubsetBoundsTask)), AggregateSubsetBoundsTask(mContextID));
+			T->Init(this, aggregate, start, nb, subsetBounds + j);
+			start += nb;
+
+			T->setContinuation(finalizeTask);
+			T->removeReference();
+		}
+		finalizeTask->removeReference();
+	}
+
 	const PxU32 nbAggregatesPerTask = nbToGo > numCpuTasks ? nbToGo / numCpuTasks : nbToGo;
 
 	// PT: TODO: better load balancing
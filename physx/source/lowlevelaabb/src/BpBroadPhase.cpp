@@ -30,6 +30,7 @@
 #include "BpBroadPhaseSap.h"
 #include "BpBroadPhaseMBP.h"
 #include "BpBroadPhaseABP.h"
+#include "BpBroadPhaseHGrid.h"
 
 using namespace physx;
 using namespace Bp;
@@ -50,6 +51,8 @@ BroadPhase* BroadPhase::create(
 		return PX_NEW(BroadPhaseMBP)(maxNbRegions, maxNbBroadPhaseOverlaps, maxNbStaticShapes, maxNbDynamicShapes, contextID);
 	else if(bpType==PxBroadPhaseType::eSAP)
 		return PX_NEW(BroadPhaseSap)(maxNbBroadPhaseOverlaps, maxNbStaticShapes, maxNbDynamicShapes, contextID);
+	else if(bpType==PxBroadPhaseType::eHGRID)
+		return PX_NEW(BroadPhaseHGrid)(maxNbBroadPhaseOverlaps, maxNbStaticShapes, maxNbDynamicShapes, contextID);
 	else
 	{
 		PX_ASSERT(0);
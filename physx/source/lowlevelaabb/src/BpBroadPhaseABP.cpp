@@ -87,6 +87,10 @@ PT: to try:
 #endif
 #define NB_SENTINELS		6
 
+// PT: repair the previous frame's order with an insertion sort instead of radix-sorting all updated boxes
+#define ABP_COHERENT_SORT_MAX_MOVES	1	// PT: max number of moves per updated box before we fall back to the radix sort
+#define ABP_COHERENT_SORT_SLACK		256	// PT: number of moves allowed upfront, before the budget catches up
+
 //#define RECURSE_LIMIT	20000
 
 	typedef	PxU32	ABP_Index;
@@ -1016,6 +1020,7 @@ void ABP_SharedData::resize(BpHandle userID)
 						ABP_Index*			mInToOut_Updated;	// Maps boxes to mABP_Objects
 						PxU32				mNbUpdated;
 						PxU32				mMaxNbUpdated;
+						PxU32				mNbSorted;			// Number of boxes at the start of mInToOut_Updated that are sorted, i.e. not added since last prepareData()
 						DynamicBoxes		mUpdatedBoxes;
 
 						// Sleeping objects
@@ -1036,6 +1041,7 @@ BoxManager::BoxManager(FilterType::Enum type) :
 	mInToOut_Updated		(NULL),
 	mNbUpdated				(0),
 	mMaxNbUpdated			(0),
+	mNbSorted				(0),
 	mInToOut_Sleeping		(NULL),
 	mNbSleeping				(0),
 	mNbRemovedSleeping		(0)
@@ -1050,6 +1056,7 @@ BoxManager::~BoxManager()
 void BoxManager::reset()
 {
 	mMaxNbUpdated = mNbUpdated = mNbSleeping = 0;
+	mNbSorted = 0;
 	PX_FREE(mInToOut_Updated);
 	PX_FREE(mInToOut_Sleeping);
 	mUpdatedBoxes.reset();
@@ -1340,6 +1347,65 @@ static PX_FORCE_INLINE PosXType2 getNextCandidateNonSorted(PxU32 offsetNonSorted
 	return offsetNonSorted<nbToSort ? toSortDataX[offsetNonSorted].mMinX : SentinelValue2;
 }
 
+// PT: insertion sort of ranks[start, end), where ranks[i] is initialized to i. The budget is the number of moves we're allowed to make,
+// it grows by budgetPerKey for each processed key. Returns false as soon as the budget is exceeded.
+static bool insertionSort(PxU32* PX_RESTRICT ranks, const PxU32* PX_RESTRICT keys, PxU32 start, PxU32 end, PxU32 budget, PxU32 budgetPerKey)
+{
+	for(PxU32 i=start;i<end;i++)
+	{
+		const PxU32 key = keys[i];
+		PxU32 j = i;
+		while(j>start && keys[ranks[j-1]]>key)
+		{
+			ranks[j] = ranks[j-1];
+			j--;
+		}
+		ranks[j] = i;
+
+		const PxU32 nbMoves = i - j;
+		budget += budgetPerKey;
+		if(nbMoves>budget)
+			return false;
+		budget -= nbMoves;
+	}
+	return true;
+}
+
+// PT: the first nbCoherent keys belong to boxes that were in the previous frame's sorted array, and they are gathered in that order.
+// When boxes only move a little these keys are nearly sorted and an insertion sort repairs them in O(n + number of keys that crossed
+// their neighbors). The remaining keys (new or reactivated boxes) are in arbitrary order, so they're sorted separately and merged.
+// Returns NULL if the work exceeds the budget, in which case the caller falls back to the radix sort.
+static const PxU32* coherentSort(PxU32* PX_RESTRICT ranks0, PxU32* PX_RESTRICT ranks1, const PxU32* PX_RESTRICT keys, PxU32 nb, PxU32 nbCoherent)
+{
+	// PT: for the coherent part the budget grows as we go, so that we bail out early when boxes moved too much
+	if(!insertionSort(ranks0, keys, 0, nbCoherent, ABP_COHERENT_SORT_SLACK, ABP_COHERENT_SORT_MAX_MOVES))
+		return NULL;
+	if(!insertionSort(ranks0, keys, nbCoherent, nb, nb*ABP_COHERENT_SORT_MAX_MOVES, 0))
+		return NULL;
+
+	if(nbCoherent==0 || nbCoherent==nb)
+		return ranks0;
+
+	const PxU32* PX_RESTRICT run0 = ranks0;
+	const PxU32* PX_RESTRICT run1 = ranks0 + nbCoherent;
+	const PxU32* const end0 = run1;
+	const PxU32* const end1 = ranks0 + nb;
+	PxU32* PX_RESTRICT dst = ranks1;
+	while(run0!=end0 && run1!=end1)
+	{
+		// PT: take from the first run on equal keys, to be stable like the radix sort
+		if(keys[*run1]<keys[*run0])
+			*dst++ = *run1++;
+		else
+			*dst++ = *run0++;
+	}
+	while(run0!=end0)
+		*dst++ = *run0++;
+	while(run1!=end1)
+		*dst++ = *run1++;
+	return ranks1;
+}
+
 PX_COMPILE_TIME_ASSERT(sizeof(BpHandle)==sizeof(float));
 void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID)
 {
@@ -1389,6 +1455,7 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 	PxU32 nbUpdated = 0;	// PT: number of objects updated this frame
 	PxU32 nbSleeping = 0;
 	PxU32 nbRemoved = 0;	// PT: number of removed objects that were previously located in the udpated array
+	PxU32 nbCoherent = 0;	// PT: number of updated objects coming from the previous frame's sorted array
 
 	// PT: TODO: could we do the work within mInToOut_Updated?
 	// - updated objects have invalidated bounds so we don't need to preserve their order
@@ -1399,6 +1466,8 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 	for(PxU32 i=0;i<size;i++)
 	{
 		PX_ASSERT(i<mMaxNbUpdated);
+		if(i==mNbSorted)
+			nbCoherent = nbUpdated;
 		const PxU32 index = remap[i];
 		if(index==INVALID_ID)
 		{
@@ -1423,13 +1492,15 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 				// faster by merging bounds and distances inside the AABB manager.
 				const BpHandle userID = removeNewOrUpdatedMark(index);
 
-				keys[nbUpdated] = bounds[userID].minimum.x - distances[userID];
+				const float key = bounds[userID].minimum.x - distances[userID];
+				// PT: we store encoded keys, which sort like the floats but are cheaper to compare in coherentSort()
+				reinterpret_cast<PxU32*>(keys)[nbUpdated] = encodeFloat(PX_IR(key));
 
 				newOrUpdatedIDs[size - 1 - nbUpdated] = userID;
 #if PX_DEBUG
 				SIMD_AABB4 aabb;
 				computeMBPBounds_Check(aabb, bounds, distances, userID);
-				PX_ASSERT(aabb.mMinX==keys[nbUpdated]);
+				PX_ASSERT(aabb.mMinX==key);
 #endif
 				nbUpdated++;
 			}
@@ -1440,6 +1511,8 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 			}
 		}
 	}
+	if(mNbSorted>=size)
+		nbCoherent = nbUpdated;
 	PX_ASSERT(nbRemoved + nbUpdated + nbSleeping == size);
 	PX_UNUSED(nbRemoved);
 
@@ -1663,7 +1736,9 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 		const PxU32* sorted;
 		{
 			PX_PROFILE_ZONE("Sort", contextID);
-			sorted = rs.Sort(keys, nbUpdated).GetRanks();
+			sorted = coherentSort(ranks0, ranks1, reinterpret_cast<const PxU32*>(keys), nbUpdated, nbCoherent);
+			if(!sorted)
+				sorted = rs.Sort(reinterpret_cast<const PxU32*>(keys), nbUpdated, RADIX_UNSIGNED).GetRanks();
 		}
 
 		// PT:
@@ -1747,6 +1822,7 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 		PX_FREE(mInToOut_Updated);
 	}
 	mNbUpdated = mMaxNbUpdated = nbUpdated;
+	mNbSorted = nbUpdated;
 
 	if(tempBuffer)
 		memoryManager.frameFree(tempBuffer);
@@ -0,0 +1,1036 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxProfiler.h"
+#include "foundation/PxHash.h"
+#include "foundation/PxBitMap.h"
+#include "foundation/PxFPU.h"
+#include "BpBroadPhaseHGrid.h"
+#include "BpBroadPhaseShared.h"
+#include "BpFiltering.h"
+#include "common/PxProfileZone.h"
+#include "CmTask.h"
+#include "CmUtils.h"
+
+using namespace physx;
+using namespace Bp;
+
+#define HGRID_MIN_LEVEL					-32		// PT: cell size of the first level is 2^HGRID_MIN_LEVEL. Smaller objects also go there.
+#define HGRID_NB_LEVELS					161		// PT: up to cells of size 2^128, i.e. large enough for any finite float bounds
+#define HGRID_MAX_CELL_COORD			4611686018427387904.0	// PT: 2^62
+#define HGRID_MAX_NB_QUERY_TASKS		16
+#define HGRID_NB_QUERIES_PER_TASK		256
+#define HGRID_MT_MIN_NB_QUERIES			1024	// PT: don't spawn tasks below that number of added & updated objects
+#define DEFAULT_CREATED_DELETED_PAIRS_CAPACITY 1024
+
+namespace internalHGrid
+{
+	struct CellKey
+	{
+		PxI64	mX;
+		PxI64	mY;
+		PxI64	mZ;
+		PxU32	mLevel;
+		PxU32	mPad;
+	};
+
+	static PX_FORCE_INLINE PxU32 hashCellKey(const CellKey& k)
+	{
+		const PxU64 h = (PxU64(k.mX)*73856093u) ^ (PxU64(k.mY)*19349663u) ^ (PxU64(k.mZ)*83492791u) ^ (PxU64(k.mLevel)*2654435761u);
+		return PxComputeHash(h);
+	}
+
+	static PX_FORCE_INLINE bool sameCellKey(const CellKey& k0, const CellKey& k1)
+	{
+		return k0.mX==k1.mX && k0.mY==k1.mY && k0.mZ==k1.mZ && k0.mLevel==k1.mLevel;
+	}
+
+	struct Object
+	{
+		PxI64	mCell[3];		// Min cell coordinates in the object's level
+		PxU32	mFirstEntry;	// First cell entry of the object, INVALID_ID if the object is not in the grid
+		PxU16	mLevel;			// Index of the object's level
+		PxU16	mSpan;			// Bit i is set if the object covers two cells along axis i
+	};
+
+	// PT: one entry per object per covered cell. Entries of a cell form a doubly-linked list, so that removal is O(1).
+	struct Entry
+	{
+		BpHandle	mObject;
+		PxU32		mCell;
+		PxU32		mPrev;			// Previous entry in the same cell
+		PxU32		mNext;			// Next entry in the same cell
+		PxU32		mNextInObject;	// Next entry of the same object, or next free entry
+		PxU32		mSecond;		// Bit i is set if this is the object's second cell along axis i
+	};
+
+	struct Cell
+	{
+		CellKey		mKey;
+		PxU32		mHash;			// hashCellKey(mKey)
+		PxU32		mFirstEntry;	// First entry in the cell, or next free cell
+		PxU32		mIndexInLevel;	// Index in Level::mCells
+	};
+
+	// PT: open-addressing hash table from cell keys to cell indices. The hash values are stored next to the cell indices
+	// so that most lookups only touch one cache line, which matters since most lookups are for empty cells.
+	class CellHashTable
+	{
+											PX_NOCOPY(CellHashTable)
+		public:
+											CellHashTable() : mSlots(NULL), mMask(0), mNbCells(0)	{}
+											~CellHashTable()	{ PX_FREE(mSlots);	}
+
+		PX_FORCE_INLINE	PxU32				find(const CellKey& key, PxU32 hashValue, const Cell* PX_RESTRICT cells)	const
+											{
+												if(!mSlots)
+													return INVALID_ID;
+
+												PxU32 index = hashValue & mMask;
+												while(mSlots[index].mCell!=INVALID_ID)
+												{
+													if(mSlots[index].mHash==hashValue && sameCellKey(cells[mSlots[index].mCell].mKey, key))
+														return mSlots[index].mCell;
+													index = (index+1) & mMask;
+												}
+												return INVALID_ID;
+											}
+
+						void				insert(PxU32 hashValue, PxU32 cellIndex)
+											{
+												// PT: keep the load factor below 1/2 so that probe sequences stay short
+												if(2*(mNbCells+1)>mMask+1)
+													grow();
+												mNbCells++;
+												insertNoGrow(hashValue, cellIndex);
+											}
+
+						void				remove(PxU32 hashValue, PxU32 cellIndex)
+											{
+												PxU32 index = hashValue & mMask;
+												while(mSlots[index].mCell!=cellIndex)
+												{
+													PX_ASSERT(mSlots[index].mCell!=INVALID_ID);
+													index = (index+1) & mMask;
+												}
+
+												// PT: backward-shift deletion, so that we don't need tombstones
+												PxU32 next = (index+1) & mMask;
+												while(mSlots[next].mCell!=INVALID_ID)
+												{
+													const PxU32 ideal = mSlots[next].mHash & mMask;
+													if(((next - ideal) & mMask) >= ((next - index) & mMask))
+													{
+														mSlots[index] = mSlots[next];
+														index = next;
+													}
+													next = (next+1) & mMask;
+												}
+												mSlots[index].mCell = INVALID_ID;
+												mNbCells--;
+											}
+
+		private:
+						struct Slot
+						{
+							PxU32	mHash;
+							PxU32	mCell;
+						};
+
+						Slot*				mSlots;
+						PxU32				mMask;
+						PxU32				mNbCells;
+
+		PX_FORCE_INLINE	void				insertNoGrow(PxU32 hashValue, PxU32 cellIndex)
+											{
+												PxU32 index = hashValue & mMask;
+												while(mSlots[index].mCell!=INVALID_ID)
+													index = (index+1) & mMask;
+												mSlots[index].mHash = hashValue;
+												mSlots[index].mCell = cellIndex;
+											}
+
+						void				grow()
+											{
+												const PxU32 oldSize = mSlots ? mMask+1 : 0;
+												Slot* oldSlots = mSlots;
+
+												const PxU32 newSize = oldSize ? oldSize*2 : 1024;
+												mSlots = PX_ALLOCATE(Slot, newSize, "CellHashTable");
+												mMask = newSize - 1;
+												for(PxU32 i=0;i<newSize;i++)
+													mSlots[i].mCell = INVALID_ID;
+
+												for(PxU32 i=0;i<oldSize;i++)
+												{
+													if(oldSlots[i].mCell!=INVALID_ID)
+														insertNoGrow(oldSlots[i].mHash, oldSlots[i].mCell);
+												}
+												PX_FREE(oldSlots);
+											}
+	};
+
+	struct Level
+	{
+		Level() : mNbObjects(0), mNbUpdated(0)	{}
+
+		PxArray<PxU32>	mCells;		// Non-empty cells of the level
+		PxU32			mNbObjects;
+		PxU32			mNbUpdated;	// Number of added & updated objects in the level
+	};
+
+	class HGrid;
+
+	class HGridQueryTask : public Cm::Task
+	{
+		public:
+										HGridQueryTask() : Cm::Task(0), mGrid(NULL), mStart(0), mEnd(0)	{}
+
+		virtual	void					runInternal()	PX_OVERRIDE;
+		virtual	const char*				getName()		const	PX_OVERRIDE	{ return "HGridQueryTask";	}
+
+				HGrid*					mGrid;
+				PxU32					mStart;
+				PxU32					mEnd;
+				PxArray<BroadPhasePair>	mPairs;
+	};
+
+	class HGridFinalizeTask : public Cm::Task
+	{
+		public:
+										HGridFinalizeTask() : Cm::Task(0), mBP(NULL), mNbTasks(0)	{}
+
+		virtual	void					runInternal()	PX_OVERRIDE;
+		virtual	const char*				getName()		const	PX_OVERRIDE	{ return "HGridFinalizeTask";	}
+
+				BroadPhaseHGrid*		mBP;
+				PxU32					mNbTasks;
+	};
+
+	class HGridPairManager : public PairManagerData
+	{
+		public:
+				void					computeCreatedDeletedPairs(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs, const PxBitMap& updated, const PxBitMap& removed);
+	};
+
+	class HGrid : public PxUserAllocated
+	{
+		public:
+										HGrid(PxU64 contextID);
+										~HGrid();
+
+				void					setTransientData(const PxBounds3* bounds, const PxReal* contactDistances, const FilterGroup::Enum* groups, const bool* lut);
+				void					checkResize(PxU32 capacity);
+
+				void					removeObjects(const BpHandle* handles, PxU32 nb);
+				void					addObjects(const BpHandle* handles, PxU32 nb);
+				void					updateObjects(const BpHandle* handles, PxU32 nb);
+
+				PxU32					prepareQueries();
+				void					runQueries(PxU32 start, PxU32 end, PxArray<BroadPhasePair>& pairs)	const;
+				void					runQueriesST(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs);
+				void					runQueriesMT(BroadPhaseHGrid* bp, PxBaseTask* continuation);
+				void					finalize(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs, PxU32 nbTasks);
+
+				void					shiftOrigin(const PxBounds3* boundsArray, const PxReal* contactDistances);
+				void					freeBuffers();
+
+		PX_FORCE_INLINE	bool			isInGrid(BpHandle handle)	const	{ return handle<mObjects.size() && mObjects[handle].mFirstEntry!=INVALID_ID;	}
+
+		private:
+				const PxBounds3*			mBounds;
+				const PxReal*				mDistances;
+				const FilterGroup::Enum*	mGroups;
+				const bool*					mLUT;
+
+				PxArray<Object>				mObjects;	// Indexed by BpHandle
+				PxArray<Entry>				mEntries;
+				PxArray<Cell>				mCells;
+				PxU32						mFreeEntry;
+				PxU32						mFreeCell;
+				CellHashTable				mCellTable;
+				Level						mLevels[HGRID_NB_LEVELS];
+				double						mScales[HGRID_NB_LEVELS];	// 1/cell size for each level
+				PxArray<PxU32>				mOccupiedLevels;
+
+				PxArray<BpHandle>			mQueries;	// Added & updated objects
+				const BpHandle*				mRemovedHandles;
+				PxU32						mNbRemoved;
+				PxBitMap					mUpdated;	// Added, updated & removed objects
+				PxBitMap					mRemoved;
+
+				HGridPairManager			mPairManager;
+
+				HGridQueryTask				mQueryTasks[HGRID_MAX_NB_QUERY_TASKS];
+				HGridFinalizeTask			mFinalizeTask;
+
+				const PxU64					mContextID;
+
+				void						computeObjectCells(Object& object, BpHandle handle)	const;
+				void						insertObject(Object& object, BpHandle handle);
+				void						unlinkObject(Object& object);
+				void						processCell(const Cell& cell, BpHandle id0, PxU32 level0, const PxI64* minCell, const PxVec3& min0, const PxVec3& max0, PxArray<BroadPhasePair>& pairs)	const;
+	};
+}
+
+using namespace internalHGrid;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE void getInflatedBounds(PxVec3& minimum, PxVec3& maximum, const PxBounds3* PX_RESTRICT bounds, const PxReal* PX_RESTRICT distances, BpHandle handle)
+{
+	const PxVec3 d(distances[handle]);
+	minimum = bounds[handle].minimum - d;
+	maximum = bounds[handle].maximum + d;
+}
+
+// PT: returns the index of the smallest level whose cells are at least as large as the object
+static PX_FORCE_INLINE PxU32 computeLevel(const PxVec3& minimum, const PxVec3& maximum)
+{
+	const PxVec3 extents = maximum - minimum;
+	float size = PxMax(extents.x, PxMax(extents.y, extents.z));
+	if(!(size>0.0f))
+		return 0;
+
+	const PxU32 ir = PX_IR(size);
+	PxI32 exponent = PxI32((ir>>23)&0xff) - 127;
+	if(ir & 0x7fffff)
+		exponent++;
+	exponent = PxClamp(exponent, HGRID_MIN_LEVEL, HGRID_MIN_LEVEL + HGRID_NB_LEVELS - 1);
+	return PxU32(exponent - HGRID_MIN_LEVEL);
+}
+
+// PT: cell coordinates are computed in double precision. The scale is a power of two so the multiplication is exact,
+// and 64-bit coordinates don't overflow even for tiny cells far away from the origin.
+static PX_FORCE_INLINE PxI64 computeCell(float value, double scale)
+{
+	const double v = PxClamp(double(value) * scale, -HGRID_MAX_CELL_COORD, HGRID_MAX_CELL_COORD);
+	const PxI64 i = PxI64(v);
+	return double(i)>v ? i-1 : i;
+}
+
+static PX_FORCE_INLINE void computeCells(PxI64* cells, const PxVec3& p, double scale)
+{
+	cells[0] = computeCell(p.x, scale);
+	cells[1] = computeCell(p.y, scale);
+	cells[2] = computeCell(p.z, scale);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void HGridQueryTask::runInternal()
+{
+	mGrid->runQueries(mStart, mEnd, mPairs);
+}
+
+void HGridFinalizeTask::runInternal()
+{
+	mBP->mHGrid->finalize(mBP->mCreated, mBP->mDeleted, mNbTasks);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void HGridPairManager::computeCreatedDeletedPairs(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs, const PxBitMap& updated, const PxBitMap& removed)
+{
+	// PT: same as ABP_PairManager::computeCreatedDeletedPairs. Pairs that have not been found again this frame
+	// are only lost if one of their objects has been updated, otherwise they are sleeping pairs.
+	PxU32 i=0;
+	PxU32 nbActivePairs = mNbActivePairs;
+	while(i<nbActivePairs)
+	{
+		InternalPair& p = mActivePairs[i];
+
+		if(p.isNew())
+		{
+			// New pair
+			BroadPhasePair* newPair = Cm::reserveContainerMemory(createdPairs, 1);
+			newPair->mVolA = p.getId0();
+			newPair->mVolB = p.getId1();
+			p.clearNew();
+			p.clearUpdated();
+			i++;
+		}
+		else if(p.isUpdated())
+		{
+			// Persistent pair
+			p.clearUpdated();
+			i++;
+		}
+		else
+		{
+			// Lost pair
+			const PxU32 id0 = p.getId0();
+			const PxU32 id1 = p.getId1();
+			PX_ASSERT(id0!=INVALID_ID);
+			PX_ASSERT(id1!=INVALID_ID);
+
+			if(updated.boundedTest(id0) || updated.boundedTest(id1))
+			{
+				// PT: pairs involving removed objects are not reported to the client
+				if(!removed.boundedTest(id0) && !removed.boundedTest(id1))
+				{
+					BroadPhasePair* lostPair = Cm::reserveContainerMemory(deletedPairs, 1);
+					lostPair->mVolA = id0;
+					lostPair->mVolB = id1;
+				}
+
+				const PxU32 hashValue = hash(id0, id1) & mMask;
+				removePair(id0, id1, hashValue, i);
+				nbActivePairs--;
+			}
+			else i++;
+		}
+	}
+
+	shrinkMemory();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+HGrid::HGrid(PxU64 contextID) :
+	mBounds			(NULL),
+	mDistances		(NULL),
+	mGroups			(NULL),
+	mLUT			(NULL),
+	mFreeEntry		(INVALID_ID),
+	mFreeCell		(INVALID_ID),
+	mRemovedHandles	(NULL),
+	mNbRemoved		(0),
+	mContextID		(contextID)
+{
+	for(PxU32 i=0;i<HGRID_NB_LEVELS;i++)
+	{
+		const PxI32 exponent = PxI32(i) + HGRID_MIN_LEVEL;
+		double scale = 1.0;
+		for(PxI32 j=0;j<exponent;j++)
+			scale *= 0.5;
+		for(PxI32 j=exponent;j<0;j++)
+			scale *= 2.0;
+		mScales[i] = scale;
+	}
+
+	for(PxU32 i=0;i<HGRID_MAX_NB_QUERY_TASKS;i++)
+	{
+		mQueryTasks[i].setContextId(contextID);
+		mQueryTasks[i].mGrid = this;
+	}
+	mFinalizeTask.setContextId(contextID);
+}
+
+HGrid::~HGrid()
+{
+}
+
+void HGrid::setTransientData(const PxBounds3* bounds, const PxReal* contactDistances, const FilterGroup::Enum* groups, const bool* lut)
+{
+	mBounds = bounds;
+	mDistances = contactDistances;
+	mGroups = groups;
+	mLUT = lut;
+}
+
+void HGrid::checkResize(PxU32 capacity)
+{
+	const PxU32 size = mObjects.size();
+	if(capacity<=size)
+		return;
+
+	mObjects.resizeUninitialized(capacity);
+	for(PxU32 i=size;i<capacity;i++)
+		mObjects[i].mFirstEntry = INVALID_ID;
+
+	mUpdated.resize(capacity);
+	mRemoved.resize(capacity);
+}
+
+void HGrid::computeObjectCells(Object& object, BpHandle handle) const
+{
+	PxVec3 minimum, maximum;
+	getInflatedBounds(minimum, maximum, mBounds, mDistances, handle);
+
+	const PxU32 level = computeLevel(minimum, maximum);
+	const double scale = mScales[level];
+
+	PxI64 maxCell[3];
+	computeCells(object.mCell, minimum, scale);
+	computeCells(maxCell, maximum, scale);
+
+	PxU32 span = 0;
+	for(PxU32 i=0;i<3;i++)
+	{
+		// PT: the cells are at least as large as the object, so it covers at most two of them along each axis
+		PX_ASSERT(maxCell[i]-object.mCell[i]<=1);
+		if(maxCell[i]!=object.mCell[i])
+			span |= 1<<i;
+	}
+	object.mLevel = PxU16(level);
+	object.mSpan = PxU16(span);
+}
+
+void HGrid::insertObject(Object& object, BpHandle handle)
+{
+	const PxU32 level = object.mLevel;
+	const PxU32 nbX = (object.mSpan & 1) ? 2 : 1;
+	const PxU32 nbY = (object.mSpan & 2) ? 2 : 1;
+	const PxU32 nbZ = (object.mSpan & 4) ? 2 : 1;
+
+	CellKey key;
+	key.mLevel = level;
+	key.mPad = 0;
+
+	PxU32 firstEntry = INVALID_ID;
+	for(PxU32 z=0;z<nbZ;z++)
+	{
+		key.mZ = object.mCell[2] + z;
+		for(PxU32 y=0;y<nbY;y++)
+		{
+			key.mY = object.mCell[1] + y;
+			for(PxU32 x=0;x<nbX;x++)
+			{
+				key.mX = object.mCell[0] + x;
+
+				const PxU32 hashValue = hashCellKey(key);
+				PxU32 cellIndex = mCellTable.find(key, hashValue, mCells.begin());
+				if(cellIndex==INVALID_ID)
+				{
+					if(mFreeCell!=INVALID_ID)
+					{
+						cellIndex = mFreeCell;
+						mFreeCell = mCells[cellIndex].mFirstEntry;
+					}
+					else
+					{
+						cellIndex = mCells.size();
+						mCells.insert();
+					}
+
+					Cell& cell = mCells[cellIndex];
+					cell.mKey = key;
+					cell.mHash = hashValue;
+					cell.mFirstEntry = INVALID_ID;
+					cell.mIndexInLevel = mLevels[level].mCells.size();
+					mLevels[level].mCells.pushBack(cellIndex);
+					mCellTable.insert(hashValue, cellIndex);
+				}
+
+				PxU32 entryIndex;
+				if(mFreeEntry!=INVALID_ID)
+				{
+					entryIndex = mFreeEntry;
+					mFreeEntry = mEntries[entryIndex].mNextInObject;
+				}
+				else
+				{
+					entryIndex = mEntries.size();
+					mEntries.insert();
+				}
+
+				Cell& cell = mCells[cellIndex];
+				Entry& entry = mEntries[entryIndex];
+				entry.mObject = handle;
+				entry.mCell = cellIndex;
+				entry.mPrev = INVALID_ID;
+				entry.mNext = cell.mFirstEntry;
+				entry.mNextInObject = firstEntry;
+				entry.mSecond = x | (y<<1) | (z<<2);
+				if(cell.mFirstEntry!=INVALID_ID)
+					mEntries[cell.mFirstEntry].mPrev = entryIndex;
+				cell.mFirstEntry = entryIndex;
+				firstEntry = entryIndex;
+			}
+		}
+	}
+	object.mFirstEntry = firstEntry;
+	mLevels[level].mNbObjects++;
+}
+
+void HGrid::unlinkObject(Object& object)
+{
+	PxU32 entryIndex = object.mFirstEntry;
+	PX_ASSERT(entryIndex!=INVALID_ID);
+	while(entryIndex!=INVALID_ID)
+	{
+		Entry& entry = mEntries[entryIndex];
+		Cell& cell = mCells[entry.mCell];
+
+		if(entry.mPrev!=INVALID_ID)
+			mEntries[entry.mPrev].mNext = entry.mNext;
+		else
+			cell.mFirstEntry = entry.mNext;
+		if(entry.mNext!=INVALID_ID)
+			mEntries[entry.mNext].mPrev = entry.mPrev;
+
+		if(cell.mFirstEntry==INVALID_ID)
+		{
+			// PT: release empty cells, so that the grid only contains non-empty cells
+			PxArray<PxU32>& levelCells = mLevels[cell.mKey.mLevel].mCells;
+			const PxU32 lastCell = levelCells.back();
+			levelCells[cell.mIndexInLevel] = lastCell;
+			mCells[lastCell].mIndexInLevel = cell.mIndexInLevel;
+			levelCells.popBack();
+
+			mCellTable.remove(cell.mHash, entry.mCell);
+			cell.mFirstEntry = mFreeCell;
+			mFreeCell = entry.mCell;
+		}
+
+		const PxU32 nextEntry = entry.mNextInObject;
+		entry.mNextInObject = mFreeEntry;
+		mFreeEntry = entryIndex;
+		entryIndex = nextEntry;
+	}
+
+	PX_ASSERT(mLevels[object.mLevel].mNbObjects);
+	mLevels[object.mLevel].mNbObjects--;
+	object.mFirstEntry = INVALID_ID;
+}
+
+void HGrid::removeObjects(const BpHandle* handles, PxU32 nb)
+{
+	PX_PROFILE_ZONE("HGrid - removeObjects", mContextID);
+
+	mRemovedHandles = handles;
+	mNbRemoved = handles ? nb : 0;
+	if(!handles)
+		return;
+
+	while(nb--)
+	{
+		const BpHandle handle = *handles++;
+		PX_ASSERT(handle<mObjects.size());
+		unlinkObject(mObjects[handle]);
+		mUpdated.set(handle);
+		mRemoved.set(handle);
+	}
+}
+
+void HGrid::addObjects(const BpHandle* handles, PxU32 nb)
+{
+	PX_PROFILE_ZONE("HGrid - addObjects", mContextID);
+
+	mQueries.clear();
+	if(!handles)
+		return;
+
+	while(nb--)
+	{
+		const BpHandle handle = *handles++;
+		PX_ASSERT(handle<mObjects.size());
+		Object& object = mObjects[handle];
+		PX_ASSERT(object.mFirstEntry==INVALID_ID);
+		computeObjectCells(object, handle);
+		insertObject(object, handle);
+		mUpdated.set(handle);
+		mQueries.pushBack(handle);
+	}
+}
+
+void HGrid::updateObjects(const BpHandle* handles, PxU32 nb)
+{
+	PX_PROFILE_ZONE("HGrid - updateObjects", mContextID);
+
+	if(!handles)
+		return;
+
+	while(nb--)
+	{
+		const BpHandle handle = *handles++;
+		PX_ASSERT(handle<mObjects.size());
+		Object& object = mObjects[handle];
+		PX_ASSERT(object.mFirstEntry!=INVALID_ID);
+
+		// PT: the object only moves to other cells when it crosses a cell boundary or changes level
+		Object newCells;
+		computeObjectCells(newCells, handle);
+		if(		newCells.mLevel!=object.mLevel || newCells.mSpan!=object.mSpan
+			||	newCells.mCell[0]!=object.mCell[0] || newCells.mCell[1]!=object.mCell[1] || newCells.mCell[2]!=object.mCell[2])
+		{
+			unlinkObject(object);
+			object.mCell[0] = newCells.mCell[0];
+			object.mCell[1] = newCells.mCell[1];
+			object.mCell[2] = newCells.mCell[2];
+			object.mLevel = newCells.mLevel;
+			object.mSpan = newCells.mSpan;
+			insertObject(object, handle);
+		}
+		mUpdated.set(handle);
+		mQueries.pushBack(handle);
+	}
+}
+
+PxU32 HGrid::prepareQueries()
+{
+	const PxU32 nbQueries = mQueries.size();
+	for(PxU32 i=0;i<nbQueries;i++)
+		mLevels[mObjects[mQueries[i]].mLevel].mNbUpdated++;
+
+	mOccupiedLevels.clear();
+	for(PxU32 i=0;i<HGRID_NB_LEVELS;i++)
+	{
+		if(mLevels[i].mNbObjects)
+			mOccupiedLevels.pushBack(i);
+	}
+	return nbQueries;
+}
+
+void HGrid::processCell(const Cell& cell, BpHandle id0, PxU32 level0, const PxI64* minCell, const PxVec3& min0, const PxVec3& max0, PxArray<BroadPhasePair>& pairs) const
+{
+	const Entry* PX_RESTRICT entries = mEntries.begin();
+	const PxBounds3* PX_RESTRICT bounds = mBounds;
+	const FilterGroup::Enum group0 = mGroups[id0];
+	const PxU32 level1 = cell.mKey.mLevel;
+
+	// PT: objects can share several cells, the pair is only reported for the cell containing the min corner of their
+	// intersection. The query overlaps the cell so this is the case unless the cell is the object's second cell along
+	// an axis and the query started before it.
+	const PxU32 startMask = PxU32(cell.mKey.mX==minCell[0]) | (PxU32(cell.mKey.mY==minCell[1])<<1) | (PxU32(cell.mKey.mZ==minCell[2])<<2);
+
+	for(PxU32 entryIndex = cell.mFirstEntry; entryIndex!=INVALID_ID; entryIndex = entries[entryIndex].mNext)
+	{
+		const Entry& entry = entries[entryIndex];
+		if(entry.mSecond & ~startMask)
+			continue;
+
+		const BpHandle id1 = entry.mObject;
+		if(id1==id0)
+			continue;
+
+		// PT: when both objects moved, only one of them reports the pair. The other one finds it in its own queries.
+		if(mUpdated.test(id1) && (level1<level0 || (level1==level0 && id1<id0)))
+			continue;
+
+		if(!groupFiltering(group0, mGroups[id1], mLUT))
+			continue;
+
+		const PxVec3 d(mDistances[id1]);
+		const PxVec3 min1 = bounds[id1].minimum - d;
+		const PxVec3 max1 = bounds[id1].maximum + d;
+		if(		max1.x<min0.x || max0.x<min1.x
+			||	max1.y<min0.y || max0.y<min1.y
+			||	max1.z<min0.z || max0.z<min1.z)
+			continue;
+
+		pairs.pushBack(BroadPhasePair(id0, id1));
+	}
+}
+
+void HGrid::runQueries(PxU32 start, PxU32 end, PxArray<BroadPhasePair>& pairs) const
+{
+	PX_PROFILE_ZONE("HGrid - runQueries", mContextID);
+
+	const Object* PX_RESTRICT objects = mObjects.begin();
+	const Cell* PX_RESTRICT cells = mCells.begin();
+	const PxU32 nbOccupiedLevels = mOccupiedLevels.size();
+
+	for(PxU32 i=start;i<end;i++)
+	{
+		const BpHandle id0 = mQueries[i];
+		PX_ASSERT(objects[id0].mFirstEntry!=INVALID_ID);
+		const PxU32 level0 = objects[id0].mLevel;
+
+		PxVec3 min0, max0;
+		getInflatedBounds(min0, max0, mBounds, mDistances, id0);
+
+		for(PxU32 j=0;j<nbOccupiedLevels;j++)
+		{
+			const PxU32 levelIndex = mOccupiedLevels[j];
+			const Level& level = mLevels[levelIndex];
+
+			// PT: moving objects in smaller levels find the pairs themselves, so we only need to look for the static/sleeping ones
+			if(levelIndex<level0 && level.mNbUpdated==level.mNbObjects)
+				continue;
+
+			const double scale = mScales[levelIndex];
+
+			PxI64 minCell[3], maxCell[3];
+			computeCells(minCell, min0, scale);
+			computeCells(maxCell, max0, scale);
+
+			// PT: the query touches at most 2*2*2 cells of its own level and larger levels. It can touch a lot more cells in
+			// smaller levels, in which case it is cheaper to parse the level's non-empty cells than to look up each cell.
+			const PxU32 nbLevelCells = level.mCells.size();
+			const double nbCells = double(maxCell[0]-minCell[0]+1) * double(maxCell[1]-minCell[1]+1) * double(maxCell[2]-minCell[2]+1);
+			if(nbCells>double(nbLevelCells))
+			{
+				for(PxU32 k=0;k<nbLevelCells;k++)
+				{
+					const Cell& cell = cells[level.mCells[k]];
+					if(		cell.mKey.mX<minCell[0] || cell.mKey.mX>maxCell[0]
+						||	cell.mKey.mY<minCell[1] || cell.mKey.mY>maxCell[1]
+						||	cell.mKey.mZ<minCell[2] || cell.mKey.mZ>maxCell[2])
+						continue;
+					processCell(cell, id0, level0, minCell, min0, max0, pairs);
+				}
+			}
+			else
+			{
+				CellKey key;
+				key.mLevel = levelIndex;
+				key.mPad = 0;
+				for(key.mZ=minCell[2]; key.mZ<=maxCell[2]; key.mZ++)
+				{
+					for(key.mY=minCell[1]; key.mY<=maxCell[1]; key.mY++)
+					{
+						for(key.mX=minCell[0]; key.mX<=maxCell[0]; key.mX++)
+						{
+							const PxU32 cellIndex = mCellTable.find(key, hashCellKey(key), cells);
+							if(cellIndex!=INVALID_ID)
+								processCell(cells[cellIndex], id0, level0, minCell, min0, max0, pairs);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void HGrid::runQueriesST(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs)
+{
+	runQueries(0, mQueries.size(), mQueryTasks[0].mPairs);
+	finalize(createdPairs, deletedPairs, 1);
+}
+
+void HGrid::runQueriesMT(BroadPhaseHGrid* bp, PxBaseTask* continuation)
+{
+	const PxU32 nbQueries = mQueries.size();
+	const PxU32 nbTasks = PxMin(PxU32(HGRID_MAX_NB_QUERY_TASKS), (nbQueries + HGRID_NB_QUERIES_PER_TASK - 1)/HGRID_NB_QUERIES_PER_TASK);
+
+	mFinalizeTask.mBP = bp;
+	mFinalizeTask.mNbTasks = nbTasks;
+	mFinalizeTask.setContinuation(continuation);
+
+	// PT: the queries only read the grid, so they can run in parallel. Each task writes its own pairs.
+	PxU32 start = 0;
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		const PxU32 end = (nbQueries*(i+1))/nbTasks;
+		mQueryTasks[i].mStart = start;
+		mQueryTasks[i].mEnd = end;
+		mQueryTasks[i].setContinuation(&mFinalizeTask);
+		start = end;
+	}
+
+	for(PxU32 i=0;i<nbTasks;i++)
+		mQueryTasks[i].removeReference();
+	mFinalizeTask.removeReference();
+}
+
+void HGrid::finalize(PxArray<BroadPhasePair>& createdPairs, PxArray<BroadPhasePair>& deletedPairs, PxU32 nbTasks)
+{
+	PX_PROFILE_ZONE("HGrid - finalize", mContextID);
+
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		PxArray<BroadPhasePair>& pairs = mQueryTasks[i].mPairs;
+		const PxU32 nbPairs = pairs.size();
+		for(PxU32 j=0;j<nbPairs;j++)
+			mPairManager.addPairInternal(pairs[j].mVolA, pairs[j].mVolB);
+		pairs.clear();
+	}
+
+	mPairManager.computeCreatedDeletedPairs(createdPairs, deletedPairs, mUpdated, mRemoved);
+
+	// PT: reset the bits for next frame
+	const PxU32 nbQueries = mQueries.size();
+	for(PxU32 i=0;i<nbQueries;i++)
+		mUpdated.reset(mQueries[i]);
+	for(PxU32 i=0;i<mNbRemoved;i++)
+	{
+		mUpdated.reset(mRemovedHandles[i]);
+		mRemoved.reset(mRemovedHandles[i]);
+	}
+	for(PxU32 i=0;i<HGRID_NB_LEVELS;i++)
+		mLevels[i].mNbUpdated = 0;
+	mRemovedHandles = NULL;
+	mNbRemoved = 0;
+}
+
+void HGrid::shiftOrigin(const PxBounds3* boundsArray, const PxReal* contactDistances)
+{
+	// PT: cells are in world space so all objects must be re-binned. Relative positions don't change so pairs are preserved.
+	mBounds = boundsArray;
+	mDistances = contactDistances;
+
+	const PxU32 nbObjects = mObjects.size();
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		Object& object = mObjects[i];
+		if(object.mFirstEntry==INVALID_ID)
+			continue;
+		unlinkObject(object);
+		computeObjectCells(object, i);
+		insertObject(object, i);
+	}
+}
+
+void HGrid::freeBuffers()
+{
+	for(PxU32 i=0;i<HGRID_MAX_NB_QUERY_TASKS;i++)
+	{
+		PxArray<BroadPhasePair>& pairs = mQueryTasks[i].mPairs;
+		if(pairs.capacity()>DEFAULT_CREATED_DELETED_PAIRS_CAPACITY)
+			pairs.reset();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Below is the PhysX wrapper = link between AABBManager and HGrid
+
+BroadPhaseHGrid::BroadPhaseHGrid(	PxU32 maxNbBroadPhaseOverlaps,
+									PxU32 maxNbStaticShapes,
+									PxU32 maxNbDynamicShapes,
+									PxU64 contextID) :
+	mContextID	(contextID)
+{
+	PX_UNUSED(maxNbBroadPhaseOverlaps);
+
+	mHGrid = PX_NEW(HGrid)(contextID);
+	mHGrid->checkResize(maxNbStaticShapes + maxNbDynamicShapes);
+
+	mCreated.reserve(DEFAULT_CREATED_DELETED_PAIRS_CAPACITY);
+	mDeleted.reserve(DEFAULT_CREATED_DELETED_PAIRS_CAPACITY);
+}
+
+BroadPhaseHGrid::~BroadPhaseHGrid()
+{
+	PX_DELETE(mHGrid);
+}
+
+void BroadPhaseHGrid::update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, PxBaseTask* continuation)
+{
+	PX_PROFILE_ZONE("BroadPhaseHGrid - update", mContextID);
+	PX_CHECK_AND_RETURN(scratchAllocator, "BroadPhaseHGrid::update - scratchAllocator must be non-NULL \n");
+
+	mHGrid->setTransientData(updateData.getAABBs(), updateData.getContactDistance(), updateData.getGroups(), updateData.getFilter().getLUT());
+	mHGrid->checkResize(updateData.getCapacity());
+
+#if PX_CHECKED
+	if(!BroadPhaseUpdateData::isValid(updateData, *this, false, mContextID))
+	{
+		PX_CHECK_MSG(false, "Illegal BroadPhaseUpdateData \n");
+		return;
+	}
+#endif
+
+	PX_ASSERT(!mCreated.size());
+	PX_ASSERT(!mDeleted.size());
+
+	{
+		PX_PROFILE_ZONE("BroadPhaseHGrid - setUpdateData", mContextID);
+
+		mHGrid->removeObjects(updateData.getRemovedHandles(), updateData.getNumRemovedHandles());
+		mHGrid->addObjects(updateData.getCreatedHandles(), updateData.getNumCreatedHandles());
+		mHGrid->updateObjects(updateData.getUpdatedHandles(), updateData.getNumUpdatedHandles());
+	}
+
+	const PxU32 nbQueries = mHGrid->prepareQueries();
+	if(continuation && nbQueries>=HGRID_MT_MIN_NB_QUERIES)
+		mHGrid->runQueriesMT(this, continuation);
+	else
+		mHGrid->runQueriesST(mCreated, mDeleted);
+}
+
+const BroadPhasePair* BroadPhaseHGrid::getCreatedPairs(PxU32& nbCreatedPairs) const
+{
+	nbCreatedPairs = mCreated.size();
+	return mCreated.begin();
+}
+
+const BroadPhasePair* BroadPhaseHGrid::getDeletedPairs(PxU32& nbDeletedPairs) const
+{
+	nbDeletedPairs = mDeleted.size();
+	return mDeleted.begin();
+}
+
+static void freeBuffer(PxArray<BroadPhasePair>& buffer)
+{
+	const PxU32 size = buffer.size();
+	if(size>DEFAULT_CREATED_DELETED_PAIRS_CAPACITY)
+	{
+		buffer.reset();
+		buffer.reserve(DEFAULT_CREATED_DELETED_PAIRS_CAPACITY);
+	}
+	else
+	{
+		buffer.clear();
+	}
+}
+
+void BroadPhaseHGrid::freeBuffers()
+{
+	PX_PROFILE_ZONE("BroadPhaseHGrid - freeBuffers", mContextID);
+
+	mHGrid->freeBuffers();
+	freeBuffer(mCreated);
+	freeBuffer(mDeleted);
+}
+
+#if PX_CHECKED
+bool BroadPhaseHGrid::isValid(const BroadPhaseUpdateData& updateData) const
+{
+	const BpHandle* created = updateData.getCreatedHandles();
+	if(created)
+	{
+		PxU32 nbToGo = updateData.getNumCreatedHandles();
+		while(nbToGo--)
+		{
+			if(mHGrid->isInGrid(*created++))
+				return false;	// This object has been added already
+		}
+	}
+
+	const BpHandle* updated = updateData.getUpdatedHandles();
+	if(updated)
+	{
+		PxU32 nbToGo = updateData.getNumUpdatedHandles();
+		while(nbToGo--)
+		{
+			if(!mHGrid->isInGrid(*updated++))
+				return false;	// This object has been removed already, or never been added
+		}
+	}
+
+	const BpHandle* removed = updateData.getRemovedHandles();
+	if(removed)
+	{
+		PxU32 nbToGo = updateData.getNumRemovedHandles();
+		while(nbToGo--)
+		{
+			if(!mHGrid->isInGrid(*removed++))
+				return false;	// This object has been removed already, or never been added
+		}
+	}
+	return true;
+}
+#endif
+
+void BroadPhaseHGrid::shiftOrigin(const PxVec3& /*shift*/, const PxBounds3* boundsArray, const PxReal* contactDistances)
+{
+	mHGrid->shiftOrigin(boundsArray, contactDistances);
+}
@@ -46,6 +46,8 @@ namespace Bp
 #define DEFAULT_DATA_ARRAY_CAPACITY 1024
 #define DEFAULT_CREATEDDELETED_PAIR_ARRAY_CAPACITY 64
 #define DEFAULT_CREATEDDELETED1AXIS_CAPACITY 8192
+// PT: minimum number of created, removed and updated boxes for the update to be spread over the task manager
+#define SAP_MT_MIN_NB_OBJECTS 1024
 
 	template<typename T, PxU32 stackLimit>
 	class TmpMem
@@ -87,6 +89,35 @@ namespace Bp
 		T* mPtr;
 	};
 
+// PT: 2D overlap test on the two axes other than the one being sorted. The single-threaded update sorts the axes one after the
+// other and uses the current ranks of the other axes, i.e. the new ranks of the previous axes and the old ranks of the next ones.
+// When the axes are sorted in parallel we use a copy of the old ranks for the next axes, and the end point values computed from
+// the current bounds for the previous axes. Since min and max encoded values are never equal, testing these values gives the same
+// result as testing the sorted ranks.
+struct SapOverlapTest2D
+{
+	const SapBox1D*		mRanks[2];	// NULL to test the values computed from the current bounds
+	PxU32				mAxes[2];
+	const PxBounds3*	mBounds;
+	const PxReal*		mContactDistance;
+
+	PX_FORCE_INLINE bool intersect1D(const PxU32 i, const BpHandle handle0, const BpHandle handle1) const
+	{
+		const SapBox1D* PX_RESTRICT ranks = mRanks[i];
+		if(ranks)
+			return ranks[handle0].mMinMax[1] > ranks[handle1].mMinMax[0] && ranks[handle1].mMinMax[1] > ranks[handle0].mMinMax[0];
+
+		const PxU32 axis = mAxes[i];
+		return	encodeMax(mBounds[handle0], axis, mContactDistance[handle0]) > encodeMin(mBounds[handle1], axis, mContactDistance[handle1])
+			&&	encodeMax(mBounds[handle1], axis, mContactDistance[handle1]) > encodeMin(mBounds[handle0], axis, mContactDistance[handle0]);
+	}
+
+	PX_FORCE_INLINE bool intersect2D(const BpHandle handle0, const BpHandle handle1) const
+	{
+		return intersect1D(0, handle0, handle1) && intersect1D(1, handle0, handle1);
+	}
+};
+
 BroadPhaseSap::BroadPhaseSap(
 	const PxU32 maxNbBroadPhaseOverlaps,
 	const PxU32 maxNbStaticShapes,
@@ -96,7 +127,15 @@ BroadPhaseSap::BroadPhaseSap(
 	mContextID			(contextID)
 {
 	for(PxU32 i=0;i<3;i++)
+	{
 		mBatchUpdateTasks[i].setContextId(contextID);
+		mPreUpdateTasks[i].setContextId(contextID);
+		mInsertTasks[i].setContextId(contextID);
+	}
+	mRemovePairsTask.setContextId(contextID);
+	mStartSortsTask.setContextId(contextID);
+	mPostUpdateTask.setContextId(contextID);
+	mFinalizeTask.setContextId(contextID);
 
 	//Boxes
 	mBoxesSize=0;
@@ -119,8 +158,6 @@ BroadPhaseSap::BroadPhaseSap(
 	mEndPointsCapacity = mBoxesCapacity*2 + NUM_SENTINELS;
 
 	mBoxesUpdated = reinterpret_cast<PxU8*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(PxU8)*mBoxesCapacity)), "BoxesUpdated"));
-	mSortedUpdateElements = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "SortedUpdateElements"));
-	mActivityPockets = reinterpret_cast<BroadPhaseActivityPocket*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BroadPhaseActivityPocket)*mEndPointsCapacity)), "BroadPhaseActivityPocket"));
 
 	mEndPointValues[0] = reinterpret_cast<ValType*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(ValType)*(mEndPointsCapacity))), "ValType"));
 	mEndPointValues[1] = reinterpret_cast<ValType*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(ValType)*(mEndPointsCapacity))), "ValType"));
@@ -137,16 +174,15 @@ BroadPhaseSap::BroadPhaseSap(
 	setMinSentinel(mEndPointValues[2][0],mEndPointDatas[2][0]);
 	setMaxSentinel(mEndPointValues[2][1],mEndPointDatas[2][1]);
 
-	mListNext = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "NextList"));
-	mListPrev = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "PrevList"));
+	// PT: each axis gets its own sort scratch buffers so that the three axes can be sorted in parallel
+	for(PxU32 Axis=0;Axis<3;Axis++)
+		allocateSortBuffers(Axis);
 
-	for(PxU32 a = 1; a < mEndPointsCapacity; ++a)
-	{
-		mListNext[a-1] = BpHandle(a);
-		mListPrev[a] = BpHandle(a-1);
-	}
-	mListNext[mEndPointsCapacity-1] = BpHandle(mEndPointsCapacity-1);
-	mListPrev[0] = 0;
+	mOldBoxEndPts[0] = NULL;
+	mOldBoxEndPts[1] = NULL;
+	mOldBoxEndPts[2] = NULL;
+	mRemoveLimit = 0;
+	mMultiThreadedUpdate = false;
 
 	mDefaultPairsCapacity = PxMax(maxNbBroadPhaseOverlaps, PxU32(DEFAULT_CREATEDDELETED_PAIR_ARRAY_CAPACITY));
 
@@ -159,6 +195,16 @@ BroadPhaseSap::BroadPhaseSap(
 	mBatchUpdateTasks[1].setPairs(NULL, 0);
 	mBatchUpdateTasks[0].setPairs(NULL, 0);
 
+	for(PxU32 i=0;i<3;i++)
+	{
+		mPreUpdateTasks[i].set(this, SapStageWorkTask::ePRE_UPDATE, i);
+		mInsertTasks[i].set(this, SapStageWorkTask::eINSERT, i);
+	}
+	mRemovePairsTask.set(this, SapStageWorkTask::eREMOVE_PAIRS, 0);
+	mStartSortsTask.set(this, SapStageWorkTask::eSTART_SORTS, 0);
+	mPostUpdateTask.set(this, SapStageWorkTask::ePOST_UPDATE, 0);
+	mFinalizeTask.set(this, SapStageWorkTask::eFINALIZE, 0);
+
 	//Initialise data array.
 	mData = NULL;
 	mDataSize = 0;
@@ -189,11 +235,9 @@ BroadPhaseSap::~BroadPhaseSap()
 	PX_FREE(mEndPointDatas[1]);
 	PX_FREE(mEndPointDatas[2]);
 
-	PX_FREE(mListNext);
-	PX_FREE(mListPrev);
+	for(PxU32 Axis=0;Axis<3;Axis++)
+		releaseSortBuffers(Axis);
 
-	PX_FREE(mSortedUpdateElements);
-	PX_FREE(mActivityPockets);
 	PX_FREE(mBoxesUpdated);
 
 	mPairs.release();
@@ -214,6 +258,34 @@ void BroadPhaseSap::release()
 	PX_FREE_THIS;
 }
 
+void BroadPhaseSap::allocateSortBuffers(const PxU32 Axis)
+{
+	mSortedUpdateElements[Axis] = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "SortedUpdateElements"));
+	mActivityPockets[Axis] = reinterpret_cast<BroadPhaseActivityPocket*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BroadPhaseActivityPocket)*mEndPointsCapacity)), "BroadPhaseActivityPocket"));
+
+	BpHandle* listNext = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "NextList"));
+	BpHandle* listPrev = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*mEndPointsCapacity)), "PrevList"));
+
+	for(PxU32 a = 1; a < mEndPointsCapacity; ++a)
+	{
+		listNext[a-1] = BpHandle(a);
+		listPrev[a] = BpHandle(a-1);
+	}
+	listNext[mEndPointsCapacity-1] = BpHandle(mEndPointsCapacity-1);
+	listPrev[0] = 0;
+
+	mListNext[Axis] = listNext;
+	mListPrev[Axis] = listPrev;
+}
+
+void BroadPhaseSap::releaseSortBuffers(const PxU32 Axis)
+{
+	PX_FREE(mListNext[Axis]);
+	PX_FREE(mListPrev[Axis]);
+	PX_FREE(mSortedUpdateElements[Axis]);
+	PX_FREE(mActivityPockets[Axis]);
+}
+
 void BroadPhaseSap::resizeBuffers()
 {
 	const PxU32 defaultPairsCapacity = mDefaultPairsCapacity;
@@ -485,7 +557,7 @@ bool BroadPhaseSap::isValid(const BroadPhaseUpdateData& updateData) const
 }
 #endif
 
-void BroadPhaseSap::update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, PxBaseTask* /*continuation*/)
+void BroadPhaseSap::update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, PxBaseTask* continuation)
 {
 	PX_CHECK_AND_RETURN(scratchAllocator, "BroadPhaseSap::update - scratchAllocator must be non-NULL \n");
 
@@ -495,9 +567,64 @@ void BroadPhaseSap::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 
 		resizeBuffers();
 
-		update();
-		postUpdate();
+		if(continuation && (mCreatedSize + mRemovedSize + mUpdatedSize) >= SAP_MT_MIN_NB_OBJECTS)
+		{
+			updateMT(continuation);
+		}
+		else
+		{
+			update();
+			postUpdate();
+		}
+	}
+}
+
+// PT: multi-threaded version of update() + postUpdate(). The axes are processed in parallel and the results are the same as with the
+// single-threaded code (see SapOverlapTest2D). The stages are:
+// - per axis: remove end points of deleted boxes, save the ranks of axes 1 and 2 (in parallel with the removal of their pairs)
+// - per axis: sort end points of updated boxes (BroadPhaseBatchUpdateWorkTask)
+// - add/remove the found pairs to/from the pair manager, in parallel with the insertion of the created boxes' end points on each axis
+// - box pruning for created boxes and creation of the created/deleted pairs lists
+void BroadPhaseSap::updateMT(PxBaseTask* continuation)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapUpdateMT", mContextID);
+
+	//Check that the overlap pairs per axis have been reset.
+	PX_ASSERT(0==mBatchUpdateTasks[0].getPairsSize());
+	PX_ASSERT(0==mBatchUpdateTasks[1].getPairsSize());
+	PX_ASSERT(0==mBatchUpdateTasks[2].getPairsSize());
+
+	//Same box count bookkeeping as in batchRemove(), done upfront since the axes are compacted in parallel.
+	if(mRemovedSize)
+	{
+		mRemoveLimit = mBoxesSizePrev*2+NUM_SENTINELS;
+		mBoxesSize -= mRemovedSize;
+		mBoxesSizePrev = mBoxesSize - mCreatedSize;
 	}
+
+	if(mUpdatedSize)
+	{
+		mOldBoxEndPts[1] = reinterpret_cast<SapBox1D*>(mScratchAllocator->alloc(sizeof(SapBox1D)*mBoxesCapacity, true));
+		mOldBoxEndPts[2] = reinterpret_cast<SapBox1D*>(mScratchAllocator->alloc(sizeof(SapBox1D)*mBoxesCapacity, true));
+	}
+
+	mMultiThreadedUpdate = true;
+
+	mFinalizeTask.setContinuation(continuation);
+	mPostUpdateTask.setContinuation(&mFinalizeTask);
+	mStartSortsTask.setContinuation(&mPostUpdateTask);
+	for(PxU32 i=0;i<3;i++)
+		mPreUpdateTasks[i].setContinuation(&mStartSortsTask);
+	if(mRemovedSize)
+		mRemovePairsTask.setContinuation(&mStartSortsTask);
+
+	mFinalizeTask.removeReference();
+	mPostUpdateTask.removeReference();
+	mStartSortsTask.removeReference();
+	for(PxU32 i=0;i<3;i++)
+		mPreUpdateTasks[i].removeReference();
+	if(mRemovedSize)
+		mRemovePairsTask.removeReference();
 }
 
 bool BroadPhaseSap::setUpdateData(const BroadPhaseUpdateData& updateData) 
@@ -580,20 +707,6 @@ bool BroadPhaseSap::setUpdateData(const BroadPhaseUpdateData& updateData)
 		BpHandle* newEndPointDatasY = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*(newEndPointsCapacity))), "BpHandle"));
 		BpHandle* newEndPointDatasZ = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*(newEndPointsCapacity))), "BpHandle"));
 
-		PX_FREE(mListNext);
-		PX_FREE(mListPrev);
-
-		mListNext = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "NextList"));
-		mListPrev = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "Prev"));
-
-		for(PxU32 a = 1; a < newEndPointsCapacity; ++a)
-		{
-			mListNext[a-1] = BpHandle(a);
-			mListPrev[a] = BpHandle(a-1);
-		}
-		mListNext[newEndPointsCapacity-1] = BpHandle(newEndPointsCapacity-1);
-		mListPrev[0] = 0;
-
 		PxMemCopy(newEndPointValuesX, mEndPointValues[0], sizeof(ValType)*(mBoxesSize*2+NUM_SENTINELS));
 		PxMemCopy(newEndPointValuesY, mEndPointValues[1], sizeof(ValType)*(mBoxesSize*2+NUM_SENTINELS));
 		PxMemCopy(newEndPointValuesZ, mEndPointValues[2], sizeof(ValType)*(mBoxesSize*2+NUM_SENTINELS));
@@ -614,10 +727,11 @@ bool BroadPhaseSap::setUpdateData(const BroadPhaseUpdateData& updateData)
 		mEndPointDatas[2] = newEndPointDatasZ;
 		mEndPointsCapacity = newEndPointsCapacity;
 
-		PX_FREE(mSortedUpdateElements);
-		PX_FREE(mActivityPockets);
-		mSortedUpdateElements = reinterpret_cast<BpHandle*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BpHandle)*newEndPointsCapacity)), "SortedUpdateElements"));
-		mActivityPockets = reinterpret_cast<BroadPhaseActivityPocket*>(PX_ALLOC(ALIGN_SIZE_16((sizeof(BroadPhaseActivityPocket)*newEndPointsCapacity)), "BroadPhaseActivityPocket"));
+		for(PxU32 Axis=0;Axis<3;Axis++)
+		{
+			releaseSortBuffers(Axis);
+			allocateSortBuffers(Axis);
+		}
 	}
 
 	PxMemZero(mBoxesUpdated, sizeof(PxU8) * (mBoxesCapacity));	
@@ -640,6 +754,15 @@ void BroadPhaseSap::postUpdate()
 {
 	PX_PROFILE_ZONE("BroadPhase.SapPostUpdate", mContextID);
 
+	processBatchUpdatePairs();
+
+	batchCreate();
+
+	computeCreatedDeletedPairs();
+}
+
+void BroadPhaseSap::processBatchUpdatePairs()
+{
 	DataArray da(mData, mDataSize, mDataCapacity);
 
 	for(PxU32 i=0;i<3;i++)
@@ -661,9 +784,10 @@ void BroadPhaseSap::postUpdate()
 	mData = da.mData;
 	mDataSize = da.mSize;
 	mDataCapacity = da.mCapacity;
+}
 
-	batchCreate();
-
+void BroadPhaseSap::computeCreatedDeletedPairs()
+{
 	//Compute the lists of created and deleted overlap pairs.
 
 	ComputeCreatedDeletedPairsLists(
@@ -690,6 +814,110 @@ void BroadPhaseBatchUpdateWorkTask::runInternal()
 	mSap->batchUpdate(mAxis, mPairs, mPairsSize, mPairsCapacity);
 }
 
+const char* SapStageWorkTask::getName() const
+{
+	switch(mStage)
+	{
+		case ePRE_UPDATE:	return "BpBroadphaseSap.preUpdate";
+		case eREMOVE_PAIRS:	return "BpBroadphaseSap.removePairs";
+		case eSTART_SORTS:	return "BpBroadphaseSap.startSorts";
+		case ePOST_UPDATE:	return "BpBroadphaseSap.postUpdate";
+		case eINSERT:		return "BpBroadphaseSap.insertEndPoints";
+		case eFINALIZE:		return "BpBroadphaseSap.finalize";
+	}
+	return "BpBroadphaseSap";
+}
+
+void SapStageWorkTask::runInternal()
+{
+	BroadPhaseSap* sap = mSap;
+
+	switch(mStage)
+	{
+		case ePRE_UPDATE:
+		{
+			if(sap->mRemovedSize)
+				sap->batchRemoveAxis(mAxis, sap->mRemoveLimit);
+
+			if(sap->mOldBoxEndPts[mAxis])
+				PxMemCopy(sap->mOldBoxEndPts[mAxis], sap->mBoxEndPts[mAxis], sizeof(SapBox1D)*sap->mBoxesCapacity);
+		}
+		break;
+
+		case eREMOVE_PAIRS:
+			sap->removeBoxPairs();
+		break;
+
+		case eSTART_SORTS:
+		{
+			if(sap->mUpdatedSize)
+			{
+				for(PxU32 i=0;i<3;i++)
+					sap->mBatchUpdateTasks[i].setContinuation(getContinuation());
+				for(PxU32 i=0;i<3;i++)
+					sap->mBatchUpdateTasks[i].removeReference();
+			}
+		}
+		break;
+
+		case ePOST_UPDATE:
+		{
+			PX_PROFILE_ZONE("BroadPhase.SapPostUpdate", sap->mContextID);
+
+			for(PxU32 i=1;i<3;i++)
+			{
+				if(sap->mOldBoxEndPts[i])
+				{
+					sap->mScratchAllocator->free(sap->mOldBoxEndPts[i]);
+					sap->mOldBoxEndPts[i] = NULL;
+				}
+			}
+
+			//The insertion of created boxes only touches the sorted arrays, so it runs while we update the pair manager.
+			if(sap->mCreatedSize)
+			{
+				for(PxU32 i=0;i<3;i++)
+					sap->mInsertTasks[i].setContinuation(getContinuation());
+				for(PxU32 i=0;i<3;i++)
+					sap->mInsertTasks[i].removeReference();
+			}
+
+			sap->processBatchUpdatePairs();
+		}
+		break;
+
+		case eINSERT:
+			sap->insertCreatedEndPoints(mAxis);
+		break;
+
+		case eFINALIZE:
+		{
+			if(sap->mCreatedSize)
+				sap->pruneCreatedBoxes();
+
+			sap->computeCreatedDeletedPairs();
+
+			sap->mMultiThreadedUpdate = false;
+		}
+		break;
+	}
+}
+
+void BroadPhaseSap::setupOverlapTest2D(SapOverlapTest2D& test, const PxU32 Axis) const
+{
+	test.mBounds = mBoxBoundsMinMax;
+	test.mContactDistance = mContactDistance;
+	for(PxU32 i=0;i<2;i++)
+	{
+		const PxU32 otherAxis = (Axis+1+i)%3;
+		test.mAxes[i] = otherAxis;
+		if(!mMultiThreadedUpdate)
+			test.mRanks[i] = mBoxEndPts[otherAxis];
+		else
+			test.mRanks[i] = otherAxis<Axis ? NULL : mOldBoxEndPts[otherAxis];
+	}
+}
+
 void BroadPhaseSap::update()
 {
 	PX_PROFILE_ZONE("BroadPhase.SapUpdate", mContextID);
@@ -879,11 +1107,19 @@ void BroadPhaseSap::batchCreate()
 	if(!mCreatedSize)
 		return;	// Early-exit if no object has been created
 
-//	PxVec4 globalMin, globalMax;
-	{
-	//Number of newly-created boxes (still to be sorted) and number of old boxes (already sorted).
+	//Insert new boxes into sorted endpoints lists.
+	for(PxU32 Axis=0;Axis<3;Axis++)
+		insertCreatedEndPoints(Axis);
+
+	pruneCreatedBoxes();
+}
+
+void BroadPhaseSap::insertCreatedEndPoints(const PxU32 Axis)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapInsertEndPoints", mContextID);
+
+	//Number of newly-created boxes (still to be sorted).
 	const PxU32 numNewBoxes = mCreatedSize;
-	//const PxU32 numOldBoxes = mBoxesSize - mCreatedSize;
 
 	//Array of newly-created box indices.
 	const BpHandle* PX_RESTRICT created = mCreated;
@@ -891,81 +1127,57 @@ void BroadPhaseSap::batchCreate()
 	//Arrays of min and max coords for each box for each axis.
 	const PxBounds3* PX_RESTRICT minMax = mBoxBoundsMinMax;
 
-/*	{
-		PxU32 nbToGo = numNewBoxes-1;
-		const PxU32 lastBoxId = created[nbToGo];
-		const PxVec3 lastMin = minMax[lastBoxId].minimum;
-		const PxVec3 lastMax = minMax[lastBoxId].maximum;
-		PxVec4 minI(lastMin.x, lastMin.y, lastMin.z, 0.0f);
-		PxVec4 maxI(lastMax.x, lastMax.y, lastMax.z, 0.0f);
-		const Vec4V dist4 = V4Load(mContactDistance[lastBoxId]);
-		Vec4V resultMinV = V4Sub(V4LoadU(&lastMin.x), dist4);
-		Vec4V resultMaxV = V4Add(V4LoadU(&lastMax.x), dist4);
-
-		const BpHandle* src = created;
-		while(nbToGo--)
-		{
-			const PxU32 boxId = *src++;
-			const Vec4V d4 = V4Load(mContactDistance[boxId]);
-			resultMinV = V4Min(resultMinV, V4Sub(V4LoadU(&minMax[boxId].minimum.x), d4));
-			resultMaxV = V4Max(resultMaxV, V4Add(V4LoadU(&minMax[boxId].maximum.x), d4));
-		}
-		V4StoreU(resultMinV, &globalMin.x);
-		V4StoreU(resultMaxV, &globalMax.x);
-	}*/
-
-	//Insert new boxes into sorted endpoints lists.
-	{
-		const PxU32 numEndPoints = numNewBoxes*2;
-
-		TmpMem<ValType, 32> nepsv(numEndPoints), bv(numEndPoints);
-		ValType* newEPSortedValues = nepsv.getBase();
-		ValType* bufferValues = bv.getBase();
+	const PxU32 numEndPoints = numNewBoxes*2;
 
-		// PT: TODO: use the scratch allocator
-		Cm::RadixSortBuffered RS;
+	TmpMem<ValType, 32> nepsv(numEndPoints), bv(numEndPoints);
+	ValType* newEPSortedValues = nepsv.getBase();
+	ValType* bufferValues = bv.getBase();
 
-		for(PxU32 Axis=0;Axis<3;Axis++)
-		{
-			for(PxU32 i=0;i<numNewBoxes;i++)
-			{
-				const PxU32 boxIndex = PxU32(created[i]);
-				PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[0]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_REMOVED_BP_HANDLE);
-				PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[1]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_REMOVED_BP_HANDLE);
-
-//				const ValType minValue = minMax[boxIndex].getMin(Axis);
-//				const ValType maxValue = minMax[boxIndex].getMax(Axis);
-				const PxReal contactDistance = mContactDistance[boxIndex];
-				newEPSortedValues[i*2+0] = encodeMin(minMax[boxIndex], Axis, contactDistance);
-				newEPSortedValues[i*2+1] = encodeMax(minMax[boxIndex], Axis, contactDistance);
-			}
+	// PT: TODO: use the scratch allocator
+	Cm::RadixSortBuffered RS;
 
-			// Sort endpoints backwards
-			BpHandle* bufferDatas;
-			{
-				RS.invalidateRanks();	// PT: there's no coherence between axes
-				const PxU32* Sorted = RS.Sort(newEPSortedValues, numEndPoints, Cm::RADIX_UNSIGNED).GetRanks();
-				bufferDatas = RS.GetRecyclable();
+	for(PxU32 i=0;i<numNewBoxes;i++)
+	{
+		const PxU32 boxIndex = PxU32(created[i]);
+		PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[0]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_REMOVED_BP_HANDLE);
+		PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[1]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_REMOVED_BP_HANDLE);
+
+//		const ValType minValue = minMax[boxIndex].getMin(Axis);
+//		const ValType maxValue = minMax[boxIndex].getMax(Axis);
+		const PxReal contactDistance = mContactDistance[boxIndex];
+		newEPSortedValues[i*2+0] = encodeMin(minMax[boxIndex], Axis, contactDistance);
+		newEPSortedValues[i*2+1] = encodeMax(minMax[boxIndex], Axis, contactDistance);
+	}
 
-				// PT: TODO: with two passes here we could reuse the "newEPSortedValues" buffer and drop "bufferValues"
-				for(PxU32 i=0;i<numEndPoints;i++)
-				{
-					const PxU32 sortedIndex = Sorted[numEndPoints-1-i];
-					bufferValues[i] = newEPSortedValues[sortedIndex];
-					// PT: compute buffer data on-the-fly, store in recyclable buffer
-					const PxU32 boxIndex = PxU32(created[sortedIndex>>1]);
-					bufferDatas[i] = setData(boxIndex, (sortedIndex&1)!=0);
-				}
-			}
+	// Sort endpoints backwards
+	BpHandle* bufferDatas;
+	{
+		const PxU32* Sorted = RS.Sort(newEPSortedValues, numEndPoints, Cm::RADIX_UNSIGNED).GetRanks();
+		bufferDatas = RS.GetRecyclable();
 
-			InsertEndPoints(bufferValues, bufferDatas, numEndPoints, mEndPointValues[Axis], mEndPointDatas[Axis], 2*(mBoxesSize-mCreatedSize)+NUM_SENTINELS, mBoxEndPts[Axis]);
+		// PT: TODO: with two passes here we could reuse the "newEPSortedValues" buffer and drop "bufferValues"
+		for(PxU32 i=0;i<numEndPoints;i++)
+		{
+			const PxU32 sortedIndex = Sorted[numEndPoints-1-i];
+			bufferValues[i] = newEPSortedValues[sortedIndex];
+			// PT: compute buffer data on-the-fly, store in recyclable buffer
+			const PxU32 boxIndex = PxU32(created[sortedIndex>>1]);
+			bufferDatas[i] = setData(boxIndex, (sortedIndex&1)!=0);
 		}
 	}
 
+	InsertEndPoints(bufferValues, bufferDatas, numEndPoints, mEndPointValues[Axis], mEndPointDatas[Axis], 2*(mBoxesSize-mCreatedSize)+NUM_SENTINELS, mBoxEndPts[Axis]);
+}
+
+void BroadPhaseSap::pruneCreatedBoxes()
+{
+	PX_PROFILE_ZONE("BroadPhase.SapPruneCreatedBoxes", mContextID);
+
 	//Some debug tests.
 #if PX_ENABLE_ASSERTS
 	{
-		for(PxU32 i=0;i<numNewBoxes;i++)
+		const BpHandle* PX_RESTRICT created = mCreated;
+		for(PxU32 i=0;i<mCreatedSize;i++)
 		{
 			PxU32 BoxIndex = PxU32(created[i]);
 			PX_ASSERT(mBoxEndPts[0][BoxIndex].mMinMax[0]!=BP_INVALID_BP_HANDLE && mBoxEndPts[0][BoxIndex].mMinMax[0]!=PX_REMOVED_BP_HANDLE);
@@ -983,7 +1195,6 @@ void BroadPhaseSap::batchCreate()
 		}
 	}
 #endif
-	}
 
 	// Perform box-pruning
 	{
@@ -1044,77 +1255,84 @@ void BroadPhaseSap::batchRemove()
 	//pretend that the box count is the value it was when the bp was last updated.
 	//Then, at the end, we need to set the box count to the number that includes the boxes
 	//in the create list and subtract off the boxes that have been removed.
-	PxU32 currBoxesSize=mBoxesSize;
-	mBoxesSize=mBoxesSizePrev;
+	const PxU32 limit = mBoxesSizePrev*2+NUM_SENTINELS;
 
 	for(PxU32 Axis=0;Axis<3;Axis++)
+		batchRemoveAxis(Axis, limit);
+
+	removeBoxPairs();
+
+	mBoxesSize-=mRemovedSize;
+	mBoxesSizePrev=mBoxesSize-mCreatedSize;
+}
+
+void BroadPhaseSap::batchRemoveAxis(const PxU32 Axis, const PxU32 limit)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapRemoveEndPoints", mContextID);
+
+	ValType* const BaseEPValue = mEndPointValues[Axis];
+	BpHandle* const BaseEPData = mEndPointDatas[Axis];
+	PxU32 MinMinIndex = PX_MAX_U32;
+	for(PxU32 i=0;i<mRemovedSize;i++)
 	{
-		ValType* const BaseEPValue = mEndPointValues[Axis];
-		BpHandle* const BaseEPData = mEndPointDatas[Axis];
-		PxU32 MinMinIndex = PX_MAX_U32;
-		for(PxU32 i=0;i<mRemovedSize;i++)
-		{
-			PX_ASSERT(mRemoved[i]<mBoxesCapacity);
+		PX_ASSERT(mRemoved[i]<mBoxesCapacity);
 
-			const PxU32 MinIndex = mBoxEndPts[Axis][mRemoved[i]].mMinMax[0];
-			PX_ASSERT(MinIndex<mBoxesCapacity*2+2);
-			PX_ASSERT(getOwner(BaseEPData[MinIndex])==mRemoved[i]);
+		const PxU32 MinIndex = mBoxEndPts[Axis][mRemoved[i]].mMinMax[0];
+		PX_ASSERT(MinIndex<mBoxesCapacity*2+2);
+		PX_ASSERT(getOwner(BaseEPData[MinIndex])==mRemoved[i]);
 
-			const PxU32 MaxIndex = mBoxEndPts[Axis][mRemoved[i]].mMinMax[1];
-			PX_ASSERT(MaxIndex<mBoxesCapacity*2+2);
-			PX_ASSERT(getOwner(BaseEPData[MaxIndex])==mRemoved[i]);
+		const PxU32 MaxIndex = mBoxEndPts[Axis][mRemoved[i]].mMinMax[1];
+		PX_ASSERT(MaxIndex<mBoxesCapacity*2+2);
+		PX_ASSERT(getOwner(BaseEPData[MaxIndex])==mRemoved[i]);
 
-			PX_ASSERT(MinIndex<MaxIndex);
+		PX_ASSERT(MinIndex<MaxIndex);
 
-			BaseEPData[MinIndex] = PX_REMOVED_BP_HANDLE;
-			BaseEPData[MaxIndex] = PX_REMOVED_BP_HANDLE;
+		BaseEPData[MinIndex] = PX_REMOVED_BP_HANDLE;
+		BaseEPData[MaxIndex] = PX_REMOVED_BP_HANDLE;
 
-			if(MinIndex<MinMinIndex)	
-				MinMinIndex = MinIndex;
-		}
+		if(MinIndex<MinMinIndex)	
+			MinMinIndex = MinIndex;
+	}
 
-		PxU32 ReadIndex = MinMinIndex;
-		PxU32 DestIndex = MinMinIndex;
-		const PxU32 Limit = mBoxesSize*2+NUM_SENTINELS;
-		while(ReadIndex!=Limit)
+	PxU32 ReadIndex = MinMinIndex;
+	PxU32 DestIndex = MinMinIndex;
+	while(ReadIndex!=limit)
+	{
+		PxPrefetchLine(&BaseEPData[ReadIndex],128);
+		while(ReadIndex!=limit && BaseEPData[ReadIndex] == PX_REMOVED_BP_HANDLE)
 		{
 			PxPrefetchLine(&BaseEPData[ReadIndex],128);
-			while(ReadIndex!=Limit && BaseEPData[ReadIndex] == PX_REMOVED_BP_HANDLE)
-			{
-				PxPrefetchLine(&BaseEPData[ReadIndex],128);
-				ReadIndex++;
-			}
-			if(ReadIndex!=Limit)
+			ReadIndex++;
+		}
+		if(ReadIndex!=limit)
+		{
+			if(ReadIndex!=DestIndex)
 			{
-				if(ReadIndex!=DestIndex)
+				BaseEPValue[DestIndex] = BaseEPValue[ReadIndex];
+				BaseEPData[DestIndex] = BaseEPData[ReadIndex];
+				PX_ASSERT(BaseEPData[DestIndex] != PX_REMOVED_BP_HANDLE);
+				if(!isSentinel(BaseEPData[DestIndex]))
 				{
-					BaseEPValue[DestIndex] = BaseEPValue[ReadIndex];
-					BaseEPData[DestIndex] = BaseEPData[ReadIndex];
-					PX_ASSERT(BaseEPData[DestIndex] != PX_REMOVED_BP_HANDLE);
-					if(!isSentinel(BaseEPData[DestIndex]))
-					{
-						BpHandle BoxOwner = getOwner(BaseEPData[DestIndex]);
-						PX_ASSERT(BoxOwner<mBoxesCapacity);
-						mBoxEndPts[Axis][BoxOwner].mMinMax[isMax(BaseEPData[DestIndex])] = BpHandle(DestIndex);
-					}
+					BpHandle BoxOwner = getOwner(BaseEPData[DestIndex]);
+					PX_ASSERT(BoxOwner<mBoxesCapacity);
+					mBoxEndPts[Axis][BoxOwner].mMinMax[isMax(BaseEPData[DestIndex])] = BpHandle(DestIndex);
 				}
-				DestIndex++;
-				ReadIndex++;
 			}
+			DestIndex++;
+			ReadIndex++;
 		}
 	}
 
 	for(PxU32 i=0;i<mRemovedSize;i++)
 	{
 		const PxU32 handle=mRemoved[i];
-		mBoxEndPts[0][handle].mMinMax[0]=PX_REMOVED_BP_HANDLE;
-		mBoxEndPts[0][handle].mMinMax[1]=PX_REMOVED_BP_HANDLE;
-		mBoxEndPts[1][handle].mMinMax[0]=PX_REMOVED_BP_HANDLE;
-		mBoxEndPts[1][handle].mMinMax[1]=PX_REMOVED_BP_HANDLE;
-		mBoxEndPts[2][handle].mMinMax[0]=PX_REMOVED_BP_HANDLE;
-		mBoxEndPts[2][handle].mMinMax[1]=PX_REMOVED_BP_HANDLE;
+		mBoxEndPts[Axis][handle].mMinMax[0]=PX_REMOVED_BP_HANDLE;
+		mBoxEndPts[Axis][handle].mMinMax[1]=PX_REMOVED_BP_HANDLE;
 	}
+}
 
+void BroadPhaseSap::removeBoxPairs()
+{
 	const PxU32 bitmapWordCount=1+(mBoxesCapacity>>5);
 	TmpMem<PxU32, 128> bitmapWords(bitmapWordCount);
 	PxMemZero(bitmapWords.getBase(),sizeof(PxU32)*bitmapWordCount);
@@ -1128,10 +1346,6 @@ void BroadPhaseSap::batchRemove()
 		bitmap.set(Index);
 	}
 	mPairs.RemovePairs(bitmap);
-
-	mBoxesSize=currBoxesSize;
-	mBoxesSize-=mRemovedSize;
-	mBoxesSizePrev=mBoxesSize-mCreatedSize;
 }
 
 static BroadPhasePair* resizeBroadPhasePairArray(const PxU32 oldMaxNb, const PxU32 newMaxNb, PxcScratchAllocator* scratchAllocator, BroadPhasePair* elements)
@@ -1166,10 +1380,7 @@ void BroadPhaseSap::batchUpdate
 	PxU32 maxNumPairs=pairsCapacity;
 
 	const PxBounds3* PX_RESTRICT boxMinMax3D = mBoxBoundsMinMax;
-	SapBox1D* boxMinMax2D[6]={mBoxEndPts[1],mBoxEndPts[2],mBoxEndPts[2],mBoxEndPts[0],mBoxEndPts[0],mBoxEndPts[1]};
 
-	const SapBox1D* PX_RESTRICT boxMinMax0=boxMinMax2D[2*Axis+0];
-	const SapBox1D* PX_RESTRICT boxMinMax1=boxMinMax2D[2*Axis+1];
 
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE 
 	const Bp::FilterGroup::Enum* PX_RESTRICT asapBoxGroupIds=mBoxGroups;
@@ -1185,6 +1396,12 @@ void BroadPhaseSap::batchUpdate
 
 	PxU8* PX_RESTRICT updated = mBoxesUpdated;
 
+	BpHandle* PX_RESTRICT listNext = mListNext[Axis];
+	BpHandle* PX_RESTRICT listPrev = mListPrev[Axis];
+	BroadPhaseActivityPocket* PX_RESTRICT activityPockets = mActivityPockets[Axis];
+	SapOverlapTest2D overlapTest;
+	setupOverlapTest2D(overlapTest, Axis);
+
 	//KS - can we lazy create these inside the loop? Might benefit us
 
 	//There are no extents, jus the sentinels, so exit early.
@@ -1211,7 +1428,7 @@ void BroadPhaseSap::batchUpdate
 	//We'll never overlap with this sentinel but it just ensures that we don't need to branch to see if
 	//there's a pocket that we need to test against
 	
-	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = mActivityPockets;
+	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = activityPockets;
 
 	currentPocket->mEndIndex = 0;
 	currentPocket->mStartIndex = 0;
@@ -1247,7 +1464,7 @@ void BroadPhaseSap::batchUpdate
 
 			//We always iterate back through the list...
 
-			BpHandle CurrentIndex = mListPrev[ThisIndex];
+			BpHandle CurrentIndex = listPrev[ThisIndex];
 			ValType CurrentValue = BaseEPValues[CurrentIndex];
 			//PxBpHandle CurrentData = BaseEPDatas[CurrentIndex];
 
@@ -1287,8 +1504,7 @@ void BroadPhaseSap::batchUpdate
 							if(
 								BaseEPValues[id1->mMinMax[0]] < boxMax && 
 								//2D intersection test using up-to-date values
-								Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
-								            boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1])
+								overlapTest.intersect2D(handle, ownerId)
 
 	#if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
 								&& groupFiltering(group, asapBoxGroupIds[ownerId], mFilter->getLUT())
@@ -1312,7 +1528,7 @@ void BroadPhaseSap::batchUpdate
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1334,8 +1550,7 @@ void BroadPhaseSap::batchUpdate
 #if 1
 							if(
 #if BP_SAP_USE_OVERLAP_TEST_ON_REMOVES
-								Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
-								       boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1])
+								overlapTest.intersect2D(handle, ownerId)
 #endif
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
 								&& groupFiltering(group, asapBoxGroupIds[ownerId], mFilter->getLUT())
@@ -1360,7 +1575,7 @@ void BroadPhaseSap::batchUpdate
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1369,21 +1584,21 @@ void BroadPhaseSap::batchUpdate
 				//This test is unnecessary. If we entered the outer loop, we're doing the swap in here
 				{
 					//Unlink from old position and re-link to new position
-					BpHandle oldNextIndex = mListNext[ThisIndex];
-					BpHandle oldPrevIndex = mListPrev[ThisIndex];
+					BpHandle oldNextIndex = listNext[ThisIndex];
+					BpHandle oldPrevIndex = listPrev[ThisIndex];
 
-					BpHandle newNextIndex = mListNext[CurrentIndex];
+					BpHandle newNextIndex = listNext[CurrentIndex];
 					BpHandle newPrevIndex = CurrentIndex;
 					
 					//Unlink this node
-					mListNext[oldPrevIndex] = oldNextIndex;
-					mListPrev[oldNextIndex] = oldPrevIndex;
+					listNext[oldPrevIndex] = oldNextIndex;
+					listPrev[oldNextIndex] = oldPrevIndex;
 
 					//Link it to it's new place in the list
-					mListNext[ThisIndex] = newNextIndex;
-					mListPrev[ThisIndex] = newPrevIndex;
-					mListPrev[newNextIndex] = ThisIndex;
-					mListNext[newPrevIndex] = ThisIndex;
+					listNext[ThisIndex] = newNextIndex;
+					listPrev[ThisIndex] = newPrevIndex;
+					listPrev[newNextIndex] = ThisIndex;
+					listNext[newPrevIndex] = ThisIndex;
 				}
 
 				//There is a sentinel with 0 index, so we don't need
@@ -1393,7 +1608,7 @@ void BroadPhaseSap::batchUpdate
 					currentPocket--;
 				}
 				//If our start index > currentPocket->mEndIndex, then we don't overlap so create a new pocket
-				if(currentPocket == mActivityPockets || startIndex > (currentPocket->mEndIndex+1))
+				if(currentPocket == activityPockets || startIndex > (currentPocket->mEndIndex+1))
 				{
 					currentPocket++;
 					currentPocket->mStartIndex = startIndex;
@@ -1410,13 +1625,13 @@ void BroadPhaseSap::batchUpdate
 	pairsSize=numPairs;
 	pairsCapacity=maxNumPairs;
 
-	BroadPhaseActivityPocket* pocket = mActivityPockets+1;
+	BroadPhaseActivityPocket* pocket = activityPockets+1;
 
 	while(pocket <= currentPocket)
 	{
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a] = BpHandle(a);
+			listPrev[a] = BpHandle(a);
 		}
 
 		//Now copy all the data to the array, updating the remap table
@@ -1424,9 +1639,9 @@ void BroadPhaseSap::batchUpdate
 		PxU32 CurrIndex = pocket->mStartIndex-1;
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			CurrIndex = mListNext[CurrIndex];
+			CurrIndex = listNext[CurrIndex];
 			PxU32 origIndex =  CurrIndex;
-			BpHandle remappedIndex = mListPrev[origIndex];
+			BpHandle remappedIndex = listPrev[origIndex];
 
 			if(origIndex != a)
 			{
@@ -1441,9 +1656,9 @@ void BroadPhaseSap::batchUpdate
 				BaseEPValues[remappedIndex] = tmp;
 				BaseEPDatas[remappedIndex] = tmpHandle;
 
-				mListPrev[remappedIndex] = mListPrev[a];
+				listPrev[remappedIndex] = listPrev[a];
 				//Write back remap index (should be an immediate jump to original index)
-				mListPrev[mListPrev[a]] = remappedIndex;
+				listPrev[listPrev[a]] = remappedIndex;
 				asapBoxes[ownerId].mMinMax[IsMax] = BpHandle(a);
 			}
 		}
@@ -1451,13 +1666,13 @@ void BroadPhaseSap::batchUpdate
 		////Reset next and prev ptrs back
 		for(PxU32 a = pocket->mStartIndex-1; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a+1] = BpHandle(a);
-			mListNext[a] = BpHandle(a+1);
+			listPrev[a+1] = BpHandle(a);
+			listNext[a] = BpHandle(a+1);
 		}
 
 		pocket++;
 	}
-	mListPrev[0] = 0;
+	listPrev[0] = 0;
 }
 
 void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity)
@@ -1466,7 +1681,6 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 	PxU32 maxNumPairs=pairsCapacity;
 
 	const PxBounds3* PX_RESTRICT boxMinMax3D = mBoxBoundsMinMax;
-	SapBox1D* boxMinMax2D[6]={mBoxEndPts[1],mBoxEndPts[2],mBoxEndPts[2],mBoxEndPts[0],mBoxEndPts[0],mBoxEndPts[1]};
 
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE 
 	const Bp::FilterGroup::Enum* PX_RESTRICT asapBoxGroupIds=mBoxGroups;
@@ -1483,11 +1697,16 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 	ValType* const PX_RESTRICT BaseEPValues = asapEndPointValues;
 	BpHandle* const PX_RESTRICT BaseEPDatas = asapEndPointDatas;			
 
-	const SapBox1D* PX_RESTRICT boxMinMax0=boxMinMax2D[2*Axis+0];
-	const SapBox1D* PX_RESTRICT boxMinMax1=boxMinMax2D[2*Axis+1];
 
 	PxU8* PX_RESTRICT updated = mBoxesUpdated;
 
+	BpHandle* PX_RESTRICT listNext = mListNext[Axis];
+	BpHandle* PX_RESTRICT listPrev = mListPrev[Axis];
+	BroadPhaseActivityPocket* PX_RESTRICT activityPockets = mActivityPockets[Axis];
+	BpHandle* PX_RESTRICT sortedUpdateElements = mSortedUpdateElements[Axis];
+	SapOverlapTest2D overlapTest;
+	setupOverlapTest2D(overlapTest, Axis);
+
 	const PxU32 endPointSize = mBoxesSize*2 + 1;
 
 	//There are no extents, just the sentinels, so exit early.
@@ -1521,10 +1740,10 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 			BaseEPValues[Object->mMinMax[0]] = boxMin;
 			BaseEPValues[Object->mMinMax[1]] = boxMax;
 
-			mSortedUpdateElements[ind_++] = Object->mMinMax[0];
-			mSortedUpdateElements[ind_++] = Object->mMinMax[1];
+			sortedUpdateElements[ind_++] = Object->mMinMax[0];
+			sortedUpdateElements[ind_++] = Object->mMinMax[1];
 		}
-		PxSort(mSortedUpdateElements, ind_);
+		PxSort(sortedUpdateElements, ind_);
 	}
 	else
 	{
@@ -1541,7 +1760,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 				ValType ThisValue = isMax(ThisData) ? encodeMax(boxMinMax3D[owner], Axis, mContactDistance[owner])
 													: encodeMin(boxMinMax3D[owner], Axis, mContactDistance[owner]);
 				BaseEPValues[index] = ThisValue;
-				mSortedUpdateElements[ind_++] = BpHandle(index);
+				sortedUpdateElements[ind_++] = BpHandle(index);
 			}
 		}
 	}
@@ -1550,13 +1769,13 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 	
 	//We'll never overlap with this sentinel but it just ensures that we don't need to branch to see if
 	//there's a pocket that we need to test against
-	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = mActivityPockets;
+	BroadPhaseActivityPocket* PX_RESTRICT currentPocket = activityPockets;
 	currentPocket->mEndIndex = 0;
 	currentPocket->mStartIndex = 0;
 
 	for(PxU32 a = 0; a < updateCounter; ++a)
 	{
-		BpHandle ind = mSortedUpdateElements[a];
+		BpHandle ind = sortedUpdateElements[a];
 
 		BpHandle NextData;
 		BpHandle PrevData;
@@ -1584,7 +1803,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 			const ValType boxMax=encodeMax(boxMinMax3D[handle], Axis, mContactDistance[handle]);
 
 			//We always iterate back through the list...
-			BpHandle CurrentIndex = mListPrev[ThisIndex];
+			BpHandle CurrentIndex = listPrev[ThisIndex];
 			ValType CurrentValue = BaseEPValues[CurrentIndex];
 
 			if(CurrentValue > ThisValue)
@@ -1618,8 +1837,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 							if(
 								BaseEPValues[id1->mMinMax[0]] < boxMax && 
 								//2D intersection test using up-to-date values
-								Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
-								       boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1])
+								overlapTest.intersect2D(handle, ownerId)
 	#if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
 								&& groupFiltering(group, asapBoxGroupIds[ownerId], mFilter->getLUT())
 	#else
@@ -1642,7 +1860,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1664,8 +1882,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 #if 1
 							if(
 #if BP_SAP_USE_OVERLAP_TEST_ON_REMOVES
-								Intersect2D_Handle(boxMinMax0[handle].mMinMax[0], boxMinMax0[handle].mMinMax[1], boxMinMax1[handle].mMinMax[0], boxMinMax1[handle].mMinMax[1],
-								       boxMinMax0[ownerId].mMinMax[0],boxMinMax0[ownerId].mMinMax[1],boxMinMax1[ownerId].mMinMax[0],boxMinMax1[ownerId].mMinMax[1])
+								overlapTest.intersect2D(handle, ownerId)
 #endif
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
 								&& groupFiltering(group, asapBoxGroupIds[ownerId], mFilter->getLUT())
@@ -1690,7 +1907,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 						}
 	#endif
 						startIndex--;
-						CurrentIndex = mListPrev[CurrentIndex];
+						CurrentIndex = listPrev[CurrentIndex];
 						CurrentValue = BaseEPValues[CurrentIndex];
 					}
 					while(ThisValue < CurrentValue);
@@ -1699,21 +1916,21 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 				//This test is unnecessary. If we entered the outer loop, we're doing the swap in here
 				{
 					//Unlink from old position and re-link to new position
-					BpHandle oldNextIndex = mListNext[ThisIndex];
-					BpHandle oldPrevIndex = mListPrev[ThisIndex];
+					BpHandle oldNextIndex = listNext[ThisIndex];
+					BpHandle oldPrevIndex = listPrev[ThisIndex];
 
-					BpHandle newNextIndex = mListNext[CurrentIndex];
+					BpHandle newNextIndex = listNext[CurrentIndex];
 					BpHandle newPrevIndex = CurrentIndex;
 					
 					//Unlink this node
-					mListNext[oldPrevIndex] = oldNextIndex;
-					mListPrev[oldNextIndex] = oldPrevIndex;
+					listNext[oldPrevIndex] = oldNextIndex;
+					listPrev[oldNextIndex] = oldPrevIndex;
 
 					//Link it to it's new place in the list
-					mListNext[ThisIndex] = newNextIndex;
-					mListPrev[ThisIndex] = newPrevIndex;
-					mListPrev[newNextIndex] = ThisIndex;
-					mListNext[newPrevIndex] = ThisIndex;
+					listNext[ThisIndex] = newNextIndex;
+					listPrev[ThisIndex] = newPrevIndex;
+					listPrev[newNextIndex] = ThisIndex;
+					listNext[newPrevIndex] = ThisIndex;
 				}
 
 				//Loop over the activity pocket stack to make sure this set of shuffles didn't 
@@ -1724,7 +1941,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 					currentPocket--;
 				}
 				//If our start index > currentPocket->mEndIndex, then we don't overlap so create a new pocket
-				if(currentPocket == mActivityPockets || startIndex > (currentPocket->mEndIndex+1))
+				if(currentPocket == activityPockets || startIndex > (currentPocket->mEndIndex+1))
 				{
 					currentPocket++;
 					currentPocket->mStartIndex = startIndex;
@@ -1734,7 +1951,7 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 			//Get prev and next ptr...
 
 			NextData = BaseEPDatas[++ind];
-			PrevData = BaseEPDatas[mListPrev[ind]];
+			PrevData = BaseEPDatas[listPrev[ind]];
 
 		}while(!isSentinel(NextData) && !updated[getOwner(NextData)] && updated[getOwner(PrevData)]);
 		
@@ -1743,23 +1960,23 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 	pairsSize=numPairs;
 	pairsCapacity=maxNumPairs;
 
-	BroadPhaseActivityPocket* pocket = mActivityPockets+1;
+	BroadPhaseActivityPocket* pocket = activityPockets+1;
 
 	while(pocket <= currentPocket)
 	{
-		//PxU32 CurrIndex = mListPrev[pocket->mStartIndex];
+		//PxU32 CurrIndex = listPrev[pocket->mStartIndex];
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a] = BpHandle(a);
+			listPrev[a] = BpHandle(a);
 		}
 
 		//Now copy all the data to the array, updating the remap table
 		PxU32 CurrIndex = pocket->mStartIndex-1;
 		for(PxU32 a = pocket->mStartIndex; a <= pocket->mEndIndex; ++a)
 		{
-			CurrIndex = mListNext[CurrIndex];
+			CurrIndex = listNext[CurrIndex];
 			PxU32 origIndex =  CurrIndex;
-			BpHandle remappedIndex = mListPrev[origIndex];
+			BpHandle remappedIndex = listPrev[origIndex];
 
 			if(origIndex != a)
 			{
@@ -1774,9 +1991,9 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 				BaseEPValues[remappedIndex] = tmp;
 				BaseEPDatas[remappedIndex] = tmpHandle;
 
-				mListPrev[remappedIndex] = mListPrev[a];
+				listPrev[remappedIndex] = listPrev[a];
 				//Write back remap index (should be an immediate jump to original index)
-				mListPrev[mListPrev[a]] = remappedIndex;
+				listPrev[listPrev[a]] = remappedIndex;
 				asapBoxes[ownerId].mMinMax[IsMax] = BpHandle(a);
 			}
 			
@@ -1784,8 +2001,8 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 
 		for(PxU32 a = pocket->mStartIndex-1; a <= pocket->mEndIndex; ++a)
 		{
-			mListPrev[a+1] = BpHandle(a);
-			mListNext[a] = BpHandle(a+1);
+			listPrev[a+1] = BpHandle(a);
+			listNext[a] = BpHandle(a+1);
 		}
 		pocket++;
 	}
@@ -88,6 +88,44 @@ private:
 	PxU32 mPairsCapacity;
 };
 
+struct SapOverlapTest2D;
+
+// PT: stages of the multi-threaded update, except the per-axis sorts which run in BroadPhaseBatchUpdateWorkTask.
+class SapStageWorkTask: public Cm::Task
+{
+public:
+
+	enum Stage
+	{
+		ePRE_UPDATE,	// per axis: removes end points of deleted boxes, saves the ranks before sorting
+		eREMOVE_PAIRS,	// removes pairs of deleted boxes from the pair manager
+		eSTART_SORTS,	// spawns the per-axis sorts
+		ePOST_UPDATE,	// adds/removes the pairs found by the sorts, spawns the insertion of created boxes
+		eINSERT,		// per axis: inserts end points of created boxes
+		eFINALIZE		// box pruning for created boxes, computes the created/deleted pairs lists
+	};
+
+	SapStageWorkTask(PxU64 contextId=0) :
+		Cm::Task	(contextId),
+		mSap		(NULL),
+		mStage		(ePRE_UPDATE),
+		mAxis		(0xffffffff)
+	{
+	}
+
+	virtual void runInternal();
+
+	virtual const char* getName() const;
+
+	void set(class BroadPhaseSap* sap, Stage stage, const PxU32 axis) {mSap = sap; mStage = stage; mAxis = axis;}
+
+private:
+
+	class BroadPhaseSap* mSap;
+	Stage mStage;
+	PxU32 mAxis;
+};
+
 //KS - TODO, this could be reduced to U16 in smaller scenes
 struct BroadPhaseActivityPocket
 {
@@ -102,8 +140,7 @@ class BroadPhaseSap : public BroadPhase
 public:
 
 	friend class BroadPhaseBatchUpdateWorkTask;
-	friend class SapUpdateWorkTask;
-	friend class SapPostUpdateWorkTask;
+	friend class SapStageWorkTask;
 
 										BroadPhaseSap(const PxU32 maxNbBroadPhaseOverlaps, const PxU32 maxNbStaticShapes, const PxU32 maxNbDynamicShapes, PxU64 contextID);
 	virtual								~BroadPhaseSap();
@@ -149,10 +186,16 @@ private:
 			BpHandle*					mEndPointDatas[3];		//Corresponding owner id and isMin/isMax for each entry in the sorted arrays of min and max box coords.
 
 			PxU8*						mBoxesUpdated;	
-			BpHandle*					mSortedUpdateElements;	
-			BroadPhaseActivityPocket*	mActivityPockets;
-			BpHandle*					mListNext;
-			BpHandle*					mListPrev;
+	//Per-axis sort scratch buffers (needs to have mEndPointsCapacity).
+			BpHandle*					mSortedUpdateElements[3];	
+			BroadPhaseActivityPocket*	mActivityPockets[3];
+			BpHandle*					mListNext[3];
+			BpHandle*					mListPrev[3];
+
+	//Multi-threaded update.
+			SapBox1D*					mOldBoxEndPts[3];		//Ranks of axes 1 and 2 before they get sorted.
+			PxU32						mRemoveLimit;			//Number of end points per axis before the removal.
+			bool						mMultiThreadedUpdate;
 
 			PxU32						mBoxesSize;				//Number of sorted boxes + number of unsorted (new) boxes
 			PxU32						mBoxesSizePrev;			//Number of sorted boxes 
@@ -181,12 +224,24 @@ private:
 			bool						setUpdateData(const BroadPhaseUpdateData& updateData);
 			void						update();
 			void						postUpdate();
+			void						updateMT(physx::PxBaseTask* continuation);
+
+			void						allocateSortBuffers(const PxU32 Axis);
+			void						releaseSortBuffers(const PxU32 Axis);
 
 	//Batch create/remove/update.
 			void						batchCreate();
 			void						batchRemove();
 			void						batchUpdate();
 
+			void						batchRemoveAxis(const PxU32 Axis, const PxU32 limit);
+			void						removeBoxPairs();
+			void						setupOverlapTest2D(SapOverlapTest2D& test, const PxU32 Axis) const;
+			void						processBatchUpdatePairs();
+			void						insertCreatedEndPoints(const PxU32 Axis);
+			void						pruneCreatedBoxes();
+			void						computeCreatedDeletedPairs();
+
 			void						batchUpdate(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity);
 
 			void						batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity);
@@ -196,6 +251,12 @@ private:
 															bool& allNewBoxesStatics, bool& allOldBoxesStatics);
 
 			BroadPhaseBatchUpdateWorkTask mBatchUpdateTasks[3];
+			SapStageWorkTask			mPreUpdateTasks[3];
+			SapStageWorkTask			mRemovePairsTask;
+			SapStageWorkTask			mStartSortsTask;
+			SapStageWorkTask			mPostUpdateTask;
+			SapStageWorkTask			mInsertTasks[3];
+			SapStageWorkTask			mFinalizeTask;
 
 			const PxU64					mContextID;
 #if PX_DEBUG
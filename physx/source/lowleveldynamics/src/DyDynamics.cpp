@@ -43,6 +43,7 @@
 
 #include "DyConstraintPrep.h"
 #include "DyConstraintPartition.h"
+#include "DySolverConstraintsBlockWide.h"
 
 #include "CmFlushPool.h"
 #include "DyArticulationPImpl.h"
@@ -99,10 +100,12 @@ Context* createDynamicsContext(	PxcNpMemBlockPool* memBlockPool, PxcScratchAlloc
 								PxvSimStats& simStats, PxTaskManager* taskManager, PxVirtualAllocatorCallback* allocatorCallback, 
 								PxsMaterialManager* materialManager, IG::SimpleIslandManager& islandManager, PxU64 contextID,
 								bool enableStabilization, bool useEnhancedDeterminism, bool solveArticulationContactLast,
-								PxReal maxBiasCoefficient, bool frictionEveryIteration, PxReal lengthScale, bool isResidualReportingEnabled)
+								PxReal maxBiasCoefficient, bool frictionEveryIteration, PxReal lengthScale, bool isResidualReportingEnabled,
+								bool disableWideSolverBatches)
 {
 	return PX_NEW(DynamicsContext)(	memBlockPool, scratchAllocator, taskPool, simStats, taskManager, allocatorCallback, materialManager, islandManager, contextID,
-									enableStabilization, useEnhancedDeterminism, solveArticulationContactLast, maxBiasCoefficient, frictionEveryIteration, lengthScale, isResidualReportingEnabled);
+									enableStabilization, useEnhancedDeterminism, solveArticulationContactLast, maxBiasCoefficient, frictionEveryIteration, lengthScale, isResidualReportingEnabled,
+									disableWideSolverBatches);
 }
 
 void DynamicsContext::destroy()
@@ -126,9 +129,13 @@ DynamicsContext::DynamicsContext(	PxcNpMemBlockPool* memBlockPool,
 									PxReal maxBiasCoefficient,
 									bool frictionEveryIteration,
 									PxReal lengthScale,
-									bool isResidualReportingEnabled) :
+									bool isResidualReportingEnabled,
+									bool disableWideSolverBatches) :
 	DynamicsContextBase				(memBlockPool, taskPool, simStats, allocatorCallback, materialManager, islandManager, contextID, maxBiasCoefficient, lengthScale, enableStabilization, useEnhancedDeterminism, solveArticulationContactLast, isResidualReportingEnabled),
-	mSolveFrictionEveryIteration	(frictionEveryIteration)
+	mSolveFrictionEveryIteration	(frictionEveryIteration),
+	// PT: wide batches are not used when residuals are reported (the wide kernels do not compute them), or with enhanced
+	// determinism (which uses batches of 1 constraint)
+	mMaxSolverBatchWidth			((disableWideSolverBatches || isResidualReportingEnabled || useEnhancedDeterminism) ? 4 : Dy::getWideSolverBatchWidth())
 {
 	createThresholdStream(*allocatorCallback);
 	createForceChangeThresholdStream(*allocatorCallback);
@@ -1453,6 +1460,8 @@ public:
 
 		PxU32 numBatches = 0;
 
+		const PxU32 maxBatchWidth = mContext.getMaxSolverBatchWidth();
+
 		PxU32 currIndex = 0;
 		for(PxU32 a = 0; a < mThreadContext.mConstraintsPerPartition.size(); ++a)
 		{
@@ -1505,6 +1514,15 @@ public:
 				}
 			}
 			PxU32 numHeaders = numBatchesInPartition;
+
+			// PT: group the 4-wide blocks of this partition into wide batches if possible
+			if(maxBatchWidth > 4 && numHeaders > 1)
+			{
+				PxConstraintBatchHeader* partitionHeaders = mThreadContext.contactConstraintBatchHeaders + numBatches - numHeaders;
+				numHeaders = buildWideSolverBatches(partitionHeaders, numHeaders, contactDescBegin, maxBatchWidth, solverBodies, mIslandContext.mCounts.bodies);
+				numBatches -= numBatchesInPartition - numHeaders;
+			}
+
 			currIndex += mThreadContext.mConstraintsPerPartition[a];
 			mThreadContext.mConstraintsPerPartition[a] = numHeaders;
 		}
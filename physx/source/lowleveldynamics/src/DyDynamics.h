@@ -131,7 +131,8 @@ public:
 														PxReal maxBiasCoefficient,
 														bool frictionEveryIteration,
 														PxReal lengthScale,
-														bool isResidualReportingEnabled
+														bool isResidualReportingEnabled,
+														bool disableWideSolverBatches
 														);
 
 	virtual								~DynamicsContext();
@@ -149,6 +150,7 @@ public:
 					void				updatePostKinematic(IG::SimpleIslandManager& simpleIslandManager, PxBaseTask* continuation, PxBaseTask* lostTouchTask, PxU32 maxLinks);
 
 	PX_FORCE_INLINE bool				solveFrictionEveryIteration() const { return mSolveFrictionEveryIteration; }
+	PX_FORCE_INLINE PxU32				getMaxSolverBatchWidth() const { return mMaxSolverBatchWidth; }
 
 protected:
 
@@ -244,6 +246,7 @@ protected:
 
 private:
 	const bool	mSolveFrictionEveryIteration;
+	const PxU32	mMaxSolverBatchWidth;	// PT: max number of constraints per batch, see DySolverConstraintsBlockWide.h
 
 	protected:
 
@@ -36,6 +36,7 @@
 #include "DySolverConstraint1D4.h"
 #include "DyPGS.h"
 #include "DyResidualAccumulator.h"
+#include "DySolverConstraintsBlockWide.h"
 
 namespace physx
 {
@@ -1216,115 +1217,142 @@ static void writeBack1D4(const PxSolverConstraintDesc* PX_RESTRICT desc, bool re
 	}
 }
 
-void solveContactPreBlock(DY_PGS_SOLVE_METHOD_PARAMS)
+// PT: wide batches (see DySolverConstraintsBlockWide.h) are solved with a single call to the wide kernel, then
+// concluded and written back one 4-wide block at a time.
+static PX_FORCE_INLINE void solveContactBlocks(const PxSolverConstraintDesc* PX_RESTRICT desc, PxU32 constraintCount, SolverContext& cache)
 {
-	PX_UNUSED(constraintCount);
-	solveContact4_Block(desc, cache);
-}
-
-void solveContactPreBlock_Static(DY_PGS_SOLVE_METHOD_PARAMS)
-{
-	PX_UNUSED(constraintCount);
-	solveContact4_StaticBlock(desc, cache);
+#if DY_WIDE_SOLVER_BATCHES
+	if(constraintCount == 16)
+		solveContact16_Block(desc, cache);
+	else if(constraintCount == 8)
+		solveContact8_Block(desc, cache);
+	else
+#endif
+	{
+		PX_UNUSED(constraintCount);
+		PX_ASSERT(constraintCount <= 4);
+		solveContact4_Block(desc, cache);
+	}
 }
 
-void solveContactPreBlock_Conclude(DY_PGS_SOLVE_METHOD_PARAMS)
+static PX_FORCE_INLINE void solveContactStaticBlocks(const PxSolverConstraintDesc* PX_RESTRICT desc, PxU32 constraintCount, SolverContext& cache)
 {
-	PX_UNUSED(constraintCount);
-	solveContact4_Block(desc, cache);
-	concludeContact4_Block(desc, sizeof(SolverContactBatchPointDynamic4), sizeof(SolverContactFrictionDynamic4));
+#if DY_WIDE_SOLVER_BATCHES
+	if(constraintCount == 16)
+		solveContact16_StaticBlock(desc, cache);
+	else if(constraintCount == 8)
+		solveContact8_StaticBlock(desc, cache);
+	else
+#endif
+	{
+		PX_UNUSED(constraintCount);
+		PX_ASSERT(constraintCount <= 4);
+		solveContact4_StaticBlock(desc, cache);
+	}
 }
 
-void solveContactPreBlock_ConcludeStatic(DY_PGS_SOLVE_METHOD_PARAMS)
+static PX_FORCE_INLINE void solve1DBlocks(const PxSolverConstraintDesc* PX_RESTRICT desc, PxU32 constraintCount, SolverContext& cache)
 {
-	PX_UNUSED(constraintCount);
-	solveContact4_StaticBlock(desc, cache);
-	concludeContact4_Block(desc, sizeof(SolverContactBatchPointBase4), sizeof(SolverContactFrictionBase4));
+#if DY_WIDE_SOLVER_BATCHES
+	if(constraintCount == 16)
+		solve1D16_Block(desc, cache);
+	else if(constraintCount == 8)
+		solve1D8_Block(desc, cache);
+	else
+#endif
+	{
+		PX_UNUSED(constraintCount);
+		PX_ASSERT(constraintCount <= 4);
+		solve1D4_Block(desc, cache);
+	}
 }
 
-void solveContactPreBlock_WriteBack(DY_PGS_SOLVE_METHOD_PARAMS)
+static void writeBackContactBlocks(const PxSolverConstraintDesc* PX_RESTRICT desc, PxU32 constraintCount, SolverContext& cache)
 {
-	PX_UNUSED(constraintCount);
-	solveContact4_Block(desc, cache);
+	for(PxU32 i=0; i<constraintCount; i+=4)
+	{
+		const PxSolverConstraintDesc* PX_RESTRICT block = desc + i;
 
-	const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[desc[0].bodyADataIndex], 
-										&cache.solverBodyArray[desc[1].bodyADataIndex],
-										&cache.solverBodyArray[desc[2].bodyADataIndex],
-										&cache.solverBodyArray[desc[3].bodyADataIndex]};
+		const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[block[0].bodyADataIndex], 
+											&cache.solverBodyArray[block[1].bodyADataIndex],
+											&cache.solverBodyArray[block[2].bodyADataIndex],
+											&cache.solverBodyArray[block[3].bodyADataIndex]};
 
-	const PxSolverBodyData* bd1[4] = {	&cache.solverBodyArray[desc[0].bodyBDataIndex], 
-										&cache.solverBodyArray[desc[1].bodyBDataIndex],
-										&cache.solverBodyArray[desc[2].bodyBDataIndex],
-										&cache.solverBodyArray[desc[3].bodyBDataIndex]};
+		const PxSolverBodyData* bd1[4] = {	&cache.solverBodyArray[block[0].bodyBDataIndex], 
+											&cache.solverBodyArray[block[1].bodyBDataIndex],
+											&cache.solverBodyArray[block[2].bodyBDataIndex],
+											&cache.solverBodyArray[block[3].bodyBDataIndex]};
 
-	writeBackContact4_Block(desc, cache, bd0, bd1);
+		writeBackContact4_Block(block, cache, bd0, bd1);
 
-	if(cache.mThresholdStreamIndex > (cache.mThresholdStreamLength - 4))
-	{
-		//Write back to global buffer
-		PxI32 threshIndex = physx::PxAtomicAdd(cache.mSharedOutThresholdPairs, PxI32(cache.mThresholdStreamIndex)) - PxI32(cache.mThresholdStreamIndex);
-		for(PxU32 a = 0; a < cache.mThresholdStreamIndex; ++a)
+		if(cache.mThresholdStreamIndex > (cache.mThresholdStreamLength - 4))
 		{
-			cache.mSharedThresholdStream[a + threshIndex] = cache.mThresholdStream[a];
+			//Write back to global buffer
+			PxI32 threshIndex = physx::PxAtomicAdd(cache.mSharedOutThresholdPairs, PxI32(cache.mThresholdStreamIndex)) - PxI32(cache.mThresholdStreamIndex);
+			for(PxU32 a = 0; a < cache.mThresholdStreamIndex; ++a)
+			{
+				cache.mSharedThresholdStream[a + threshIndex] = cache.mThresholdStream[a];
+			}
+			cache.mThresholdStreamIndex = 0;
 		}
-		cache.mThresholdStreamIndex = 0;
 	}
 }
 
-void solveContactPreBlock_WriteBackStatic(DY_PGS_SOLVE_METHOD_PARAMS)
+void solveContactPreBlock(DY_PGS_SOLVE_METHOD_PARAMS)
 {
-	PX_UNUSED(constraintCount);
-	solveContact4_StaticBlock(desc, cache);
-	const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[desc[0].bodyADataIndex], 
-										&cache.solverBodyArray[desc[1].bodyADataIndex],
-										&cache.solverBodyArray[desc[2].bodyADataIndex],
-										&cache.solverBodyArray[desc[3].bodyADataIndex]};
+	solveContactBlocks(desc, constraintCount, cache);
+}
 
-	const PxSolverBodyData* bd1[4] = {	&cache.solverBodyArray[desc[0].bodyBDataIndex], 
-										&cache.solverBodyArray[desc[1].bodyBDataIndex],
-										&cache.solverBodyArray[desc[2].bodyBDataIndex],
-										&cache.solverBodyArray[desc[3].bodyBDataIndex]};
+void solveContactPreBlock_Static(DY_PGS_SOLVE_METHOD_PARAMS)
+{
+	solveContactStaticBlocks(desc, constraintCount, cache);
+}
 
-	writeBackContact4_Block(desc, cache, bd0, bd1);
+void solveContactPreBlock_Conclude(DY_PGS_SOLVE_METHOD_PARAMS)
+{
+	solveContactBlocks(desc, constraintCount, cache);
+	for(PxU32 i=0; i<constraintCount; i+=4)
+		concludeContact4_Block(desc + i, sizeof(SolverContactBatchPointDynamic4), sizeof(SolverContactFrictionDynamic4));
+}
 
-	if(cache.mThresholdStreamIndex > (cache.mThresholdStreamLength - 4))
-	{
-		//Write back to global buffer
-		PxI32 threshIndex = physx::PxAtomicAdd(cache.mSharedOutThresholdPairs, PxI32(cache.mThresholdStreamIndex)) - PxI32(cache.mThresholdStreamIndex);
-		for(PxU32 a = 0; a < cache.mThresholdStreamIndex; ++a)
-		{
-			cache.mSharedThresholdStream[a + threshIndex] = cache.mThresholdStream[a];
-		}
-		cache.mThresholdStreamIndex = 0;
-	}
+void solveContactPreBlock_ConcludeStatic(DY_PGS_SOLVE_METHOD_PARAMS)
+{
+	solveContactStaticBlocks(desc, constraintCount, cache);
+	for(PxU32 i=0; i<constraintCount; i+=4)
+		concludeContact4_Block(desc + i, sizeof(SolverContactBatchPointBase4), sizeof(SolverContactFrictionBase4));
 }
 
-void solve1D4_Block(DY_PGS_SOLVE_METHOD_PARAMS)
+void solveContactPreBlock_WriteBack(DY_PGS_SOLVE_METHOD_PARAMS)
 {
-	PX_UNUSED(constraintCount);
-	PX_UNUSED(cache);
+	solveContactBlocks(desc, constraintCount, cache);
+	writeBackContactBlocks(desc, constraintCount, cache);
+}
 
-	solve1D4_Block(desc, cache);
+void solveContactPreBlock_WriteBackStatic(DY_PGS_SOLVE_METHOD_PARAMS)
+{
+	solveContactStaticBlocks(desc, constraintCount, cache);
+	writeBackContactBlocks(desc, constraintCount, cache);
 }
 
-void solve1D4Block_Conclude(DY_PGS_SOLVE_METHOD_PARAMS)
+void solve1D4_Block(DY_PGS_SOLVE_METHOD_PARAMS)
 {
-	PX_UNUSED(constraintCount);
-	PX_UNUSED(cache);
+	solve1DBlocks(desc, constraintCount, cache);
+}
 
-	solve1D4_Block(desc, cache);
+void solve1D4Block_Conclude(DY_PGS_SOLVE_METHOD_PARAMS)
+{
+	solve1DBlocks(desc, constraintCount, cache);
 	bool residualAccumulationEnabled = cache.contactErrorAccumulator != NULL;
-	conclude1D4_Block(desc, residualAccumulationEnabled);
+	for(PxU32 i=0; i<constraintCount; i+=4)
+		conclude1D4_Block(desc + i, residualAccumulationEnabled);
 }
 
 void solve1D4Block_WriteBack(DY_PGS_SOLVE_METHOD_PARAMS)
 {
-	PX_UNUSED(constraintCount);
-	PX_UNUSED(cache);
-
-	solve1D4_Block(desc, cache);
+	solve1DBlocks(desc, constraintCount, cache);
 	bool residualAccumulationEnabled = cache.contactErrorAccumulator != NULL;
-	writeBack1D4(desc, residualAccumulationEnabled);
+	for(PxU32 i=0; i<constraintCount; i+=4)
+		writeBack1D4(desc + i, residualAccumulationEnabled);
 }
 
 void writeBack1D4Block(const PxSolverConstraintDesc* PX_RESTRICT desc, bool residualAccumulationEnabled)
@@ -0,0 +1,134 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "DySolverConstraintsBlockWide.h"
+
+#if DY_WIDE_SOLVER_BATCHES
+
+#include "foundation/PxVecMath.h"
+#include "DySolverBody.h"
+#include "DySolverContext.h"
+#include "DySolverConstraintDesc.h"
+#include "DySolverContact4.h"
+#include "DySolverConstraint1D4.h"
+#include "DyConstraint.h"
+#include <immintrin.h>
+
+// PT: everything below is compiled for AVX2, and only called after checking that the CPU supports it (see
+// getWideSolverBatchWidth). Multiply-adds must not be contracted to FMAs, to give the same results as the SSE2 code.
+#if PX_GCC
+	#pragma GCC push_options
+	#pragma GCC target("avx2")
+	#pragma GCC optimize("fp-contract=off")
+#elif PX_CLANG
+	#pragma clang attribute push(__attribute__((target("avx2"))), apply_to=function)
+#endif
+
+#include "DySolverConstraintsBlockWideImpl.h"
+
+namespace physx
+{
+namespace Dy
+{
+	// PT: 8 lanes, i.e. 2 blocks of 4 constraints. Operations match the SSE2 implementations of the V4xxx functions.
+	struct WideVec8
+	{
+		enum { eNB_BLOCKS = 2 };
+
+		typedef __m256	V;
+		typedef __m256	B;
+
+		static PX_FORCE_INLINE V combine(const aos::Vec4V* parts)
+		{
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(parts[0]), parts[1], 1);
+		}
+
+		static PX_FORCE_INLINE void split(const V v, aos::Vec4V* parts)
+		{
+			parts[0] = _mm256_castps256_ps128(v);
+			parts[1] = _mm256_extractf128_ps(v, 1);
+		}
+
+		static PX_FORCE_INLINE V load(const aos::Vec4V& ref, const intptr_t* offsets)
+		{
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(ref), *getWideBlockPtr(&ref, offsets[1]), 1);
+		}
+
+		static PX_FORCE_INLINE void store(const V v, aos::Vec4V& ref, const intptr_t* offsets)
+		{
+			ref = _mm256_castps256_ps128(v);
+			*getWideBlockPtr(&ref, offsets[1]) = _mm256_extractf128_ps(v, 1);
+		}
+
+		static PX_FORCE_INLINE void storeBool(const B b, aos::BoolV& ref, const intptr_t* offsets)
+		{
+			store(b, ref, offsets);
+		}
+
+		static PX_FORCE_INLINE V zero()								{ return _mm256_setzero_ps();								}
+		static PX_FORCE_INLINE V splat(PxReal f)					{ return _mm256_set1_ps(f);									}
+		static PX_FORCE_INLINE V add(const V a, const V b)			{ return _mm256_add_ps(a, b);								}
+		static PX_FORCE_INLINE V sub(const V a, const V b)			{ return _mm256_sub_ps(a, b);								}
+		static PX_FORCE_INLINE V mul(const V a, const V b)			{ return _mm256_mul_ps(a, b);								}
+		static PX_FORCE_INLINE V mulAdd(const V a, const V b, const V c)	{ return add(mul(a, b), c);							}
+		static PX_FORCE_INLINE V negMulSub(const V a, const V b, const V c)	{ return sub(c, mul(a, b));							}
+		static PX_FORCE_INLINE V neg(const V a)						{ return sub(zero(), a);									}
+		static PX_FORCE_INLINE V abs(const V a)						{ return max(a, neg(a));									}
+		static PX_FORCE_INLINE V max(const V a, const V b)			{ return _mm256_max_ps(a, b);								}
+		static PX_FORCE_INLINE V min(const V a, const V b)			{ return _mm256_min_ps(a, b);								}
+		static PX_FORCE_INLINE B isGrtr(const V a, const V b)		{ return _mm256_cmp_ps(a, b, _CMP_GT_OS);					}
+		static PX_FORCE_INLINE B bFalse()							{ return _mm256_setzero_ps();								}
+		static PX_FORCE_INLINE B bOr(const B a, const B b)			{ return _mm256_or_ps(a, b);								}
+		static PX_FORCE_INLINE V sel(const B c, const V a, const V b)	{ return _mm256_or_ps(_mm256_andnot_ps(c, b), _mm256_and_ps(c, a));	}
+	};
+
+void solveContact8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	solveContactWide_Block<WideVec8>(desc, cache);
+}
+
+void solveContact8_StaticBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	solveContactWide_StaticBlock<WideVec8>(desc, cache);
+}
+
+void solve1D8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	solve1DWide_Block<WideVec8>(desc, cache);
+}
+
+}
+}
+
+#if PX_GCC
+	#pragma GCC pop_options
+#elif PX_CLANG
+	#pragma clang attribute pop
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "DySolverConstraintsBlockWide.h"
+#include "DySolverBody.h"
+#include "DySolverConstraintDesc.h"
+#include "DySolverConstraintTypes.h"
+#include "DySolverContact4.h"
+#include "DySolverConstraint1D4.h"
+
+#if DY_WIDE_SOLVER_BATCHES && PX_VC
+	#include <intrin.h>
+#endif
+
+using namespace physx;
+using namespace Dy;
+using namespace aos;
+
+PxU32 Dy::getWideSolverBatchWidth()
+{
+#if DY_WIDE_SOLVER_BATCHES
+	#if PX_VC
+		int info[4];
+		__cpuid(info, 0);
+		if(info[0] < 7)
+			return 4;
+
+		// PT: the OS must save the YMM registers (and the ZMM and mask registers for AVX-512)
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1<<27)) != 0;
+		const bool avx = (info[2] & (1<<28)) != 0;
+		if(!osxsave || !avx)
+			return 4;
+
+		const unsigned long long xcr0 = _xgetbv(0);
+		if((xcr0 & 0x6) != 0x6)
+			return 4;
+
+		__cpuidex(info, 7, 0);
+		const bool avx2 = (info[1] & (1<<5)) != 0;
+		const bool avx512f = (info[1] & (1<<16)) != 0;
+
+		if(avx512f && (xcr0 & 0xe6) == 0xe6)
+			return 16;
+		return avx2 ? 8 : 4;
+	#else
+		// PT: these also check that the OS supports the corresponding registers
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx512f"))
+			return 16;
+		if(__builtin_cpu_supports("avx2"))
+			return 8;
+		return 4;
+	#endif
+#else
+	return 4;
+#endif
+}
+
+// PT: kinematic bodies are not part of the island's dynamic bodies and can be shared by blocks of the same partition.
+// The wide kernels read all the bodies before writing any of them, so they must not be shared.
+static PX_FORCE_INLINE bool isDynamicOrWorld(const PxSolverBody* body, PxU32 dataIndex, const PxSolverBody* bodies, PxU32 nbBodies)
+{
+	return dataIndex == 0 || (body >= bodies && body < bodies + nbBodies);
+}
+
+static bool isWideBatchCandidate(const PxConstraintBatchHeader& header, const PxSolverConstraintDesc* descs, const PxSolverBody* bodies, PxU32 nbBodies)
+{
+	if(header.stride != 4)
+		return false;
+
+	const PxU16 type = header.constraintType;
+	if(type != DY_SC_TYPE_BLOCK_RB_CONTACT && type != DY_SC_TYPE_BLOCK_STATIC_RB_CONTACT && type != DY_SC_TYPE_BLOCK_1D)
+		return false;
+
+	for(PxU32 i=0; i<4; i++)
+	{
+		const PxSolverConstraintDesc& desc = descs[header.startIndex + i];
+		if(!isDynamicOrWorld(desc.bodyA, desc.bodyADataIndex, bodies, nbBodies))
+			return false;
+		// PT: the static contact kernel does not touch bodyB
+		if(type != DY_SC_TYPE_BLOCK_STATIC_RB_CONTACT && !isDynamicOrWorld(desc.bodyB, desc.bodyBDataIndex, bodies, nbBodies))
+			return false;
+	}
+	return true;
+}
+
+// PT: the wide kernels walk the data of the first block and use the same offsets in the other blocks, so the blocks
+// must have the same patches, with the same number of rows.
+static bool haveSameLayout(const PxSolverConstraintDesc& desc0, const PxSolverConstraintDesc& desc1, PxU16 type)
+{
+	const PxU32 length = getConstraintLength(desc0);
+	if(getConstraintLength(desc1) != length)
+		return false;
+
+	if(type == DY_SC_TYPE_BLOCK_1D)
+	{
+		const SolverConstraint1DHeader4* header0 = reinterpret_cast<const SolverConstraint1DHeader4*>(desc0.constraint);
+		const SolverConstraint1DHeader4* header1 = reinterpret_cast<const SolverConstraint1DHeader4*>(desc1.constraint);
+		return header0->type == header1->type && header0->count == header1->count;
+	}
+
+	const bool isStatic = type == DY_SC_TYPE_BLOCK_STATIC_RB_CONTACT;
+	const PxU32 pointSize = isStatic ? sizeof(SolverContactBatchPointBase4) : sizeof(SolverContactBatchPointDynamic4);
+	const PxU32 frictionSize = isStatic ? sizeof(SolverContactFrictionBase4) : sizeof(SolverContactFrictionDynamic4);
+
+	PxU32 offset = 0;
+	while(offset < length)
+	{
+		const SolverContactHeader4* hdr0 = reinterpret_cast<const SolverContactHeader4*>(desc0.constraint + offset);
+		const SolverContactHeader4* hdr1 = reinterpret_cast<const SolverContactHeader4*>(desc1.constraint + offset);
+
+		const PxU32 numNormalConstr = hdr0->numNormalConstr;
+		const PxU32 numFrictionConstr = hdr0->numFrictionConstr;
+		const PxU8 hasMaxImpulse = PxU8(hdr0->flag & SolverContactHeader4::eHAS_MAX_IMPULSE);
+
+		if(hdr1->type != hdr0->type || hdr1->numNormalConstr != numNormalConstr || hdr1->numFrictionConstr != numFrictionConstr
+			|| PxU8(hdr1->flag & SolverContactHeader4::eHAS_MAX_IMPULSE) != hasMaxImpulse)
+			return false;
+
+		offset += sizeof(SolverContactHeader4);
+		offset += numNormalConstr * (sizeof(Vec4V) + pointSize);
+		if(hasMaxImpulse)
+			offset += numNormalConstr * sizeof(Vec4V);
+		if(numFrictionConstr)
+			offset += sizeof(SolverFrictionSharedData4);
+		offset += numFrictionConstr * (sizeof(Vec4V) + frictionSize);
+	}
+	return offset == length;
+}
+
+PxU32 Dy::buildWideSolverBatches(PxConstraintBatchHeader* headers, PxU32 nbHeaders, const PxSolverConstraintDesc* descs,
+								PxU32 batchWidth, const PxSolverBody* bodies, PxU32 nbBodies)
+{
+	const PxU32 maxNbBlocks = batchWidth/4;
+
+	PxU32 nbOut = 0;
+	PxU32 i = 0;
+	while(i<nbHeaders)
+	{
+		const PxConstraintBatchHeader header = headers[i];
+
+		PxU32 nbBlocks = 1;
+		if(maxNbBlocks > 1 && isWideBatchCandidate(header, descs, bodies, nbBodies))
+		{
+			const PxSolverConstraintDesc& desc0 = descs[header.startIndex];
+			while(nbBlocks < maxNbBlocks && i + nbBlocks < nbHeaders)
+			{
+				const PxConstraintBatchHeader& next = headers[i + nbBlocks];
+				if(next.constraintType != header.constraintType || next.startIndex != header.startIndex + nbBlocks*4
+					|| !isWideBatchCandidate(next, descs, bodies, nbBodies) || !haveSameLayout(desc0, descs[next.startIndex], header.constraintType))
+					break;
+				nbBlocks++;
+			}
+
+			// PT: there are only 8- and 16-wide kernels
+			if(nbBlocks == 3)
+				nbBlocks = 2;
+		}
+
+		// PT: nbOut <= i so we never overwrite a header we still need
+		headers[nbOut] = header;
+		if(nbBlocks > 1)
+			headers[nbOut].stride = PxU16(nbBlocks*4);
+		nbOut++;
+		i += nbBlocks;
+	}
+	return nbOut;
+}
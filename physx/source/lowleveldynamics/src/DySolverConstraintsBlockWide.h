@@ -0,0 +1,80 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef DY_SOLVER_CONSTRAINTS_BLOCK_WIDE_H
+#define DY_SOLVER_CONSTRAINTS_BLOCK_WIDE_H
+
+#include "foundation/PxPreprocessor.h"
+#include "foundation/PxSimpleTypes.h"
+
+// PT: wide solver batches need AVX2 / AVX-512 intrinsics, and a compiler able to target them per function.
+#if PX_INTEL_FAMILY && !PX_EMSCRIPTEN && (PX_VC || PX_GCC_FAMILY)
+	#define DY_WIDE_SOLVER_BATCHES	1
+#else
+	#define DY_WIDE_SOLVER_BATCHES	0
+#endif
+
+namespace physx
+{
+	struct PxSolverBody;
+	struct PxSolverConstraintDesc;
+	struct PxConstraintBatchHeader;
+
+	namespace Dy
+	{
+		struct SolverContext;
+
+		// PT: the PGS block solver works on batches of 4 constraints, i.e. one constraint per lane of a Vec4V. A wide
+		// batch is a header whose stride is 8 or 16, grouping 2 or 4 consecutive 4-wide blocks of the same type
+		// and layout. The blocks are prepared as usual, and only the solve kernels process them with AVX2 (8 lanes)
+		// or AVX-512 (16 lanes). Each lane runs exactly the same operations as in the 4-wide kernels, so the
+		// results are the same as when solving the blocks one after the other.
+
+		// Returns the widest batch supported by the CPU and the OS, i.e. 16, 8, or 4 when wide batches are not supported.
+		PxU32	getWideSolverBatchWidth();
+
+		// Groups consecutive 4-wide blocks of the same partition into wide batches of up to batchWidth constraints.
+		// The headers are compacted in place and the new number of headers is returned. Blocks referencing kinematic
+		// bodies are not grouped, since different blocks of a partition can share them. The dynamic bodies of the
+		// island are [bodies, bodies + nbBodies), and the world body is the one with a data index of 0.
+		PxU32	buildWideSolverBatches(PxConstraintBatchHeader* headers, PxU32 nbHeaders, const PxSolverConstraintDesc* descs,
+									PxU32 batchWidth, const PxSolverBody* bodies, PxU32 nbBodies);
+
+#if DY_WIDE_SOLVER_BATCHES
+		// PT: solve kernels for wide batches, in DySolverConstraintsBlock8.cpp and DySolverConstraintsBlock16.cpp
+		void	solveContact8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache);
+		void	solveContact8_StaticBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache);
+		void	solve1D8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache);
+		void	solveContact16_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache);
+		void	solveContact16_StaticBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache);
+		void	solve1D16_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache);
+#endif
+	}
+}
+
+#endif
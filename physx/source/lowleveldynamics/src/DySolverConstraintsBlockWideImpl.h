@@ -0,0 +1,777 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef DY_SOLVER_CONSTRAINTS_BLOCK_WIDE_IMPL_H
+#define DY_SOLVER_CONSTRAINTS_BLOCK_WIDE_IMPL_H
+
+// PT: this file contains the solve kernels for wide batches. It is included by DySolverConstraintsBlock8.cpp and
+// DySolverConstraintsBlock16.cpp, after the wide vector type has been defined, in a section of code compiled for the
+// target ISA. The kernels are the same as solveContact4_Block, solveContact4_StaticBlock and solve1D4_Block in
+// DySolverConstraintsBlock.cpp, with the same operations in the same order, and should be kept in sync with them.
+//
+// The wide vector type W provides:
+// - W::V, a vector of W::eNB_BLOCKS*4 floats, and W::B, the corresponding mask type
+// - load/store of the same Vec4V in each 4-wide block, given the offsets of the blocks from the first one
+// - combine/split between a V and W::eNB_BLOCKS Vec4Vs
+// - the same arithmetic as the V4xxx functions used by the 4-wide kernels
+
+#include "foundation/PxVecMath.h"
+#include "DySolverBody.h"
+#include "DySolverContext.h"
+#include "DySolverConstraintDesc.h"
+#include "DySolverContact4.h"
+#include "DySolverConstraint1D4.h"
+
+namespace physx
+{
+namespace Dy
+{
+	// PT: returns the address of the data at the same offset in another block
+	template<class T>
+	static PX_FORCE_INLINE T* getWideBlockPtr(T* ptr, intptr_t offset)
+	{
+		return reinterpret_cast<T*>(reinterpret_cast<intptr_t>(ptr) + offset);
+	}
+
+	template<class W>
+	struct WideBodyVelocities
+	{
+		typename W::V	linX, linY, linZ;
+		typename W::V	angX, angY, angZ;
+		// PT: the w components are not used by the solver but are written back unchanged
+		aos::Vec4V		linW[W::eNB_BLOCKS];
+		aos::Vec4V		angW[W::eNB_BLOCKS];
+	};
+
+	// PT: same as the loads and transposes at the start of the 4-wide kernels, for each block
+	template<class W>
+	static PX_FORCE_INLINE void loadWideVelocities(PxSolverBody* const* PX_RESTRICT bodies, WideBodyVelocities<W>& v)
+	{
+		using namespace aos;
+
+		Vec4V linX[W::eNB_BLOCKS], linY[W::eNB_BLOCKS], linZ[W::eNB_BLOCKS];
+		Vec4V angX[W::eNB_BLOCKS], angY[W::eNB_BLOCKS], angZ[W::eNB_BLOCKS];
+
+		for(PxU32 k=0; k<W::eNB_BLOCKS; k++)
+		{
+			PxSolverBody* const* PX_RESTRICT b = bodies + k*4;
+
+			Vec4V linVel0 = V4LoadA(&b[0]->linearVelocity.x);
+			Vec4V linVel1 = V4LoadA(&b[1]->linearVelocity.x);
+			Vec4V linVel2 = V4LoadA(&b[2]->linearVelocity.x);
+			Vec4V linVel3 = V4LoadA(&b[3]->linearVelocity.x);
+			Vec4V angState0 = V4LoadA(&b[0]->angularState.x);
+			Vec4V angState1 = V4LoadA(&b[1]->angularState.x);
+			Vec4V angState2 = V4LoadA(&b[2]->angularState.x);
+			Vec4V angState3 = V4LoadA(&b[3]->angularState.x);
+
+			PX_TRANSPOSE_44(linVel0, linVel1, linVel2, linVel3, linX[k], linY[k], linZ[k], v.linW[k]);
+			PX_TRANSPOSE_44(angState0, angState1, angState2, angState3, angX[k], angY[k], angZ[k], v.angW[k]);
+		}
+
+		v.linX = W::combine(linX);
+		v.linY = W::combine(linY);
+		v.linZ = W::combine(linZ);
+		v.angX = W::combine(angX);
+		v.angY = W::combine(angY);
+		v.angZ = W::combine(angZ);
+	}
+
+	// PT: same as the transposes and stores at the end of the 4-wide kernels. Bodies whose bit is set in skipMask are not written.
+	template<class W>
+	static PX_FORCE_INLINE void storeWideVelocities(PxSolverBody* const* PX_RESTRICT bodies, WideBodyVelocities<W>& v, PxU32 skipMask)
+	{
+		using namespace aos;
+
+		Vec4V linX[W::eNB_BLOCKS], linY[W::eNB_BLOCKS], linZ[W::eNB_BLOCKS];
+		Vec4V angX[W::eNB_BLOCKS], angY[W::eNB_BLOCKS], angZ[W::eNB_BLOCKS];
+
+		W::split(v.linX, linX);
+		W::split(v.linY, linY);
+		W::split(v.linZ, linZ);
+		W::split(v.angX, angX);
+		W::split(v.angY, angY);
+		W::split(v.angZ, angZ);
+
+		for(PxU32 k=0; k<W::eNB_BLOCKS; k++)
+		{
+			Vec4V linVel[4], angState[4];
+			PX_TRANSPOSE_44(linX[k], linY[k], linZ[k], v.linW[k], linVel[0], linVel[1], linVel[2], linVel[3]);
+			PX_TRANSPOSE_44(angX[k], angY[k], angZ[k], v.angW[k], angState[0], angState[1], angState[2], angState[3]);
+
+			for(PxU32 j=0; j<4; j++)
+			{
+				const PxU32 lane = k*4 + j;
+				if(skipMask & (1<<lane))
+					continue;
+
+				PX_ASSERT(bodies[lane]->linearVelocity.isFinite());
+				PX_ASSERT(bodies[lane]->angularState.isFinite());
+
+				V4StoreA(linVel[j], &bodies[lane]->linearVelocity.x);
+				V4StoreA(angState[j], &bodies[lane]->angularState.x);
+
+				PX_ASSERT(bodies[lane]->linearVelocity.isFinite());
+				PX_ASSERT(bodies[lane]->angularState.isFinite());
+			}
+		}
+	}
+
+	template<class W>
+	static PX_FORCE_INLINE void getWideBlockOffsets(const PxSolverConstraintDesc* PX_RESTRICT desc, intptr_t* offsets)
+	{
+		for(PxU32 k=0; k<W::eNB_BLOCKS; k++)
+			offsets[k] = reinterpret_cast<intptr_t>(desc[k*4].constraint) - reinterpret_cast<intptr_t>(desc[0].constraint);
+	}
+
+	template<class W>
+	static PX_FORCE_INLINE void prefetchWideBlocks(const PxU8* PX_RESTRICT address, const intptr_t* offsets, PxU32 nbLines)
+	{
+		for(PxU32 k=0; k<W::eNB_BLOCKS; k++)
+		{
+			const PxU8* blockAddress = getWideBlockPtr(address, offsets[k]);
+			for(PxU32 i=0; i<nbLines; i++)
+				PxPrefetchLine(blockAddress, i*64);
+		}
+	}
+
+	// PT: wide version of solveContact4_Block
+	template<class W>
+	static void solveContactWide_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+	{
+		using namespace aos;
+		typedef typename W::V V;
+		typedef typename W::B B;
+
+		// PT: wide batches are not used when residuals are reported, see buildWideSolverBatches
+		PX_ASSERT(!cache.contactErrorAccumulator);
+
+		PxSolverBody* bodies0[W::eNB_BLOCKS*4];
+		PxSolverBody* bodies1[W::eNB_BLOCKS*4];
+		PxU32 staticMask1 = 0;
+		for(PxU32 i=0; i<W::eNB_BLOCKS*4; i++)
+		{
+			bodies0[i] = desc[i].bodyA;
+			bodies1[i] = desc[i].bodyB;
+			if(desc[i].bodyBDataIndex == 0)
+				staticMask1 |= 1<<i;
+		}
+
+		intptr_t offsets[W::eNB_BLOCKS];
+		getWideBlockOffsets<W>(desc, offsets);
+
+		WideBodyVelocities<W> vel0, vel1;
+		loadWideVelocities<W>(bodies0, vel0);
+		loadWideVelocities<W>(bodies1, vel1);
+
+		V linVel0T0 = vel0.linX, linVel0T1 = vel0.linY, linVel0T2 = vel0.linZ;
+		V linVel1T0 = vel1.linX, linVel1T1 = vel1.linY, linVel1T2 = vel1.linZ;
+		V angState0T0 = vel0.angX, angState0T1 = vel0.angY, angState0T2 = vel0.angZ;
+		V angState1T0 = vel1.angX, angState1T1 = vel1.angY, angState1T2 = vel1.angZ;
+
+		const V vZero = W::zero();
+		const V vMax = W::splat(PX_MAX_REAL);
+
+		const PxU8* PX_RESTRICT last = desc[0].constraint + getConstraintLength(desc[0]);
+
+		PxU8* PX_RESTRICT currPtr = desc[0].constraint;
+
+		const PxU8* PX_RESTRICT prefetchAddress = currPtr + sizeof(SolverContactHeader4) + sizeof(SolverContactBatchPointDynamic4);
+
+		const SolverContactHeader4* PX_RESTRICT hdr = reinterpret_cast<SolverContactHeader4*>(currPtr);
+
+		const V invMassA = W::load(hdr->invMass0D0, offsets);
+		const V invMassB = W::load(hdr->invMass1D1, offsets);
+
+		const V sumInvMass = W::add(invMassA, invMassB);
+
+		while(currPtr < last)
+		{
+			hdr = reinterpret_cast<const SolverContactHeader4*>(currPtr);
+
+			PX_ASSERT(hdr->type == DY_SC_TYPE_BLOCK_RB_CONTACT);
+
+			currPtr = reinterpret_cast<PxU8*>(const_cast<SolverContactHeader4*>(hdr) + 1);
+
+			const PxU32 numNormalConstr = hdr->numNormalConstr;
+			const PxU32	numFrictionConstr = hdr->numFrictionConstr;
+
+			const bool hasMaxImpulse = (hdr->flag & SolverContactHeader4::eHAS_MAX_IMPULSE) != 0;
+
+			Vec4V* appliedForces = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V)*numNormalConstr;
+
+			SolverContactBatchPointDynamic4* PX_RESTRICT contacts = reinterpret_cast<SolverContactBatchPointDynamic4*>(currPtr);
+
+			Vec4V* maxImpulses = NULL;
+			currPtr = reinterpret_cast<PxU8*>(contacts + numNormalConstr);
+			if(hasMaxImpulse)
+			{
+				maxImpulses = reinterpret_cast<Vec4V*>(currPtr);
+				currPtr += sizeof(Vec4V) * numNormalConstr;
+			}
+
+			SolverFrictionSharedData4* PX_RESTRICT fd = reinterpret_cast<SolverFrictionSharedData4*>(currPtr);
+			if(numFrictionConstr)
+				currPtr += sizeof(SolverFrictionSharedData4);
+
+			Vec4V* frictionAppliedForce = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V)*numFrictionConstr;
+
+			const SolverContactFrictionDynamic4* PX_RESTRICT frictions = reinterpret_cast<SolverContactFrictionDynamic4*>(currPtr);
+			currPtr += numFrictionConstr * sizeof(SolverContactFrictionDynamic4);
+
+			V accumulatedNormalImpulse = vZero;
+
+			const V angD0 = W::load(hdr->angDom0, offsets);
+			const V angD1 = W::load(hdr->angDom1, offsets);
+
+			const V _normalT0 = W::load(hdr->normalX, offsets);
+			const V _normalT1 = W::load(hdr->normalY, offsets);
+			const V _normalT2 = W::load(hdr->normalZ, offsets);
+
+			V contactNormalVel1 = W::mul(linVel0T0, _normalT0);
+			V contactNormalVel3 = W::mul(linVel1T0, _normalT0);
+			contactNormalVel1 = W::mulAdd(linVel0T1, _normalT1, contactNormalVel1);
+			contactNormalVel3 = W::mulAdd(linVel1T1, _normalT1, contactNormalVel3);
+			contactNormalVel1 = W::mulAdd(linVel0T2, _normalT2, contactNormalVel1);
+			contactNormalVel3 = W::mulAdd(linVel1T2, _normalT2, contactNormalVel3);
+
+			V relVel1 = W::sub(contactNormalVel1, contactNormalVel3);
+
+			V accumDeltaF = vZero;
+
+			for(PxU32 i=0;i<numNormalConstr;i++)
+			{
+				const SolverContactBatchPointDynamic4& c = contacts[i];
+
+				prefetchWideBlocks<W>(prefetchAddress + 64, offsets, 3);
+				prefetchAddress += 192;
+
+				const V appliedForce = W::load(appliedForces[i], offsets);
+				const V maxImpulse = hasMaxImpulse ? W::load(maxImpulses[i], offsets) : vMax;
+
+				V contactNormalVel2 = W::mul(W::load(c.raXnX, offsets), angState0T0);
+				V contactNormalVel4 = W::mul(W::load(c.rbXnX, offsets), angState1T0);
+
+				contactNormalVel2 = W::mulAdd(W::load(c.raXnY, offsets), angState0T1, contactNormalVel2);
+				contactNormalVel4 = W::mulAdd(W::load(c.rbXnY, offsets), angState1T1, contactNormalVel4);
+
+				contactNormalVel2 = W::mulAdd(W::load(c.raXnZ, offsets), angState0T2, contactNormalVel2);
+				contactNormalVel4 = W::mulAdd(W::load(c.rbXnZ, offsets), angState1T2, contactNormalVel4);
+
+				const V normalVel = W::add(relVel1, W::sub(contactNormalVel2, contactNormalVel4));
+
+				const V velMultiplier = W::load(c.velMultiplier, offsets);
+				V deltaF = W::negMulSub(normalVel, velMultiplier, W::load(c.biasedErr, offsets));
+
+				deltaF = W::max(deltaF, W::neg(appliedForce));
+				const V newAppliedForce = W::min(W::mulAdd(W::load(c.impulseMultiplier, offsets), appliedForce, deltaF), maxImpulse);
+				deltaF = W::sub(newAppliedForce, appliedForce);
+
+				accumDeltaF = W::add(accumDeltaF, deltaF);
+
+				const V angDetaF0 = W::mul(deltaF, angD0);
+				const V angDetaF1 = W::mul(deltaF, angD1);
+
+				relVel1 = W::mulAdd(sumInvMass, deltaF, relVel1);
+
+				angState0T0 = W::mulAdd(W::load(c.raXnX, offsets), angDetaF0, angState0T0);
+				angState1T0 = W::negMulSub(W::load(c.rbXnX, offsets), angDetaF1, angState1T0);
+
+				angState0T1 = W::mulAdd(W::load(c.raXnY, offsets), angDetaF0, angState0T1);
+				angState1T1 = W::negMulSub(W::load(c.rbXnY, offsets), angDetaF1, angState1T1);
+
+				angState0T2 = W::mulAdd(W::load(c.raXnZ, offsets), angDetaF0, angState0T2);
+				angState1T2 = W::negMulSub(W::load(c.rbXnZ, offsets), angDetaF1, angState1T2);
+
+				W::store(newAppliedForce, appliedForces[i], offsets);
+
+				accumulatedNormalImpulse = W::add(accumulatedNormalImpulse, newAppliedForce);
+			}
+
+			const V accumDeltaF_IM0 = W::mul(accumDeltaF, invMassA);
+			const V accumDeltaF_IM1 = W::mul(accumDeltaF, invMassB);
+
+			linVel0T0 = W::mulAdd(_normalT0, accumDeltaF_IM0, linVel0T0);
+			linVel1T0 = W::negMulSub(_normalT0, accumDeltaF_IM1, linVel1T0);
+			linVel0T1 = W::mulAdd(_normalT1, accumDeltaF_IM0, linVel0T1);
+			linVel1T1 = W::negMulSub(_normalT1, accumDeltaF_IM1, linVel1T1);
+			linVel0T2 = W::mulAdd(_normalT2, accumDeltaF_IM0, linVel0T2);
+			linVel1T2 = W::negMulSub(_normalT2, accumDeltaF_IM1, linVel1T2);
+
+			if(cache.doFriction && numFrictionConstr)
+			{
+				const V staticFric = W::load(hdr->staticFriction, offsets);
+				const V dynamicFric = W::load(hdr->dynamicFriction, offsets);
+
+				const V maxFrictionImpulse = W::mul(staticFric, accumulatedNormalImpulse);
+				const V maxDynFrictionImpulse = W::mul(dynamicFric, accumulatedNormalImpulse);
+				const V negMaxDynFrictionImpulse = W::neg(maxDynFrictionImpulse);
+				B broken = W::bFalse();
+
+				if(cache.writeBackIteration)
+				{
+					for(PxU32 k=0; k<W::eNB_BLOCKS; k++)
+					{
+						const SolverFrictionSharedData4* fdk = getWideBlockPtr(fd, offsets[k]);
+						PxPrefetchLine(fdk->frictionBrokenWritebackByte[0]);
+						PxPrefetchLine(fdk->frictionBrokenWritebackByte[1]);
+						PxPrefetchLine(fdk->frictionBrokenWritebackByte[2]);
+					}
+				}
+
+				for(PxU32 i=0;i<numFrictionConstr;i++)
+				{
+					const SolverContactFrictionDynamic4& f = frictions[i];
+
+					prefetchWideBlocks<W>(prefetchAddress + 64, offsets, 4);
+					prefetchAddress += 256;
+
+					const V appliedForce = W::load(frictionAppliedForce[i], offsets);
+
+					const V normalT0 = W::load(fd->normalX[i&1], offsets);
+					const V normalT1 = W::load(fd->normalY[i&1], offsets);
+					const V normalT2 = W::load(fd->normalZ[i&1], offsets);
+
+					const V raXnX = W::load(f.raXnX, offsets);
+					const V raXnY = W::load(f.raXnY, offsets);
+					const V raXnZ = W::load(f.raXnZ, offsets);
+					const V rbXnX = W::load(f.rbXnX, offsets);
+					const V rbXnY = W::load(f.rbXnY, offsets);
+					const V rbXnZ = W::load(f.rbXnZ, offsets);
+
+					V normalVel1 = W::mul(linVel0T0, normalT0);
+					V normalVel2 = W::mul(raXnX, angState0T0);
+					V normalVel3 = W::mul(linVel1T0, normalT0);
+					V normalVel4 = W::mul(rbXnX, angState1T0);
+
+					normalVel1 = W::mulAdd(linVel0T1, normalT1, normalVel1);
+					normalVel2 = W::mulAdd(raXnY, angState0T1, normalVel2);
+					normalVel3 = W::mulAdd(linVel1T1, normalT1, normalVel3);
+					normalVel4 = W::mulAdd(rbXnY, angState1T1, normalVel4);
+
+					normalVel1 = W::mulAdd(linVel0T2, normalT2, normalVel1);
+					normalVel2 = W::mulAdd(raXnZ, angState0T2, normalVel2);
+					normalVel3 = W::mulAdd(linVel1T2, normalT2, normalVel3);
+					normalVel4 = W::mulAdd(rbXnZ, angState1T2, normalVel4);
+
+					const V normalVel_tmp2 = W::add(normalVel1, normalVel2);
+					const V normalVel_tmp1 = W::add(normalVel3, normalVel4);
+
+					const V normalVel = W::sub(normalVel_tmp2, normalVel_tmp1);
+
+					const V tmp1 = W::sub(appliedForce, W::load(f.scaledBias, offsets));
+
+					const V totalImpulse = W::negMulSub(normalVel, W::load(f.velMultiplier, offsets), tmp1);
+
+					broken = W::bOr(broken, W::isGrtr(W::abs(totalImpulse), maxFrictionImpulse));
+
+					const V newAppliedForce = W::sel(broken, W::min(maxDynFrictionImpulse, W::max(negMaxDynFrictionImpulse, totalImpulse)), totalImpulse);
+
+					const V deltaF = W::sub(newAppliedForce, appliedForce);
+
+					W::store(newAppliedForce, frictionAppliedForce[i], offsets);
+
+					const V deltaFIM0 = W::mul(deltaF, invMassA);
+					const V deltaFIM1 = W::mul(deltaF, invMassB);
+
+					const V angDetaF0 = W::mul(deltaF, angD0);
+					const V angDetaF1 = W::mul(deltaF, angD1);
+
+					linVel0T0 = W::mulAdd(normalT0, deltaFIM0, linVel0T0);
+					linVel1T0 = W::negMulSub(normalT0, deltaFIM1, linVel1T0);
+					angState0T0 = W::mulAdd(raXnX, angDetaF0, angState0T0);
+					angState1T0 = W::negMulSub(rbXnX, angDetaF1, angState1T0);
+
+					linVel0T1 = W::mulAdd(normalT1, deltaFIM0, linVel0T1);
+					linVel1T1 = W::negMulSub(normalT1, deltaFIM1, linVel1T1);
+					angState0T1 = W::mulAdd(raXnY, angDetaF0, angState0T1);
+					angState1T1 = W::negMulSub(rbXnY, angDetaF1, angState1T1);
+
+					linVel0T2 = W::mulAdd(normalT2, deltaFIM0, linVel0T2);
+					linVel1T2 = W::negMulSub(normalT2, deltaFIM1, linVel1T2);
+					angState0T2 = W::mulAdd(raXnZ, angDetaF0, angState0T2);
+					angState1T2 = W::negMulSub(rbXnZ, angDetaF1, angState1T2);
+				}
+				W::storeBool(broken, fd->broken, offsets);
+			}
+		}
+
+		vel0.linX = linVel0T0; vel0.linY = linVel0T1; vel0.linZ = linVel0T2;
+		vel1.linX = linVel1T0; vel1.linY = linVel1T1; vel1.linZ = linVel1T2;
+		vel0.angX = angState0T0; vel0.angY = angState0T1; vel0.angZ = angState0T2;
+		vel1.angX = angState1T0; vel1.angY = angState1T1; vel1.angZ = angState1T2;
+
+		storeWideVelocities<W>(bodies0, vel0, 0);
+		storeWideVelocities<W>(bodies1, vel1, staticMask1);
+	}
+
+	// PT: wide version of solveContact4_StaticBlock
+	template<class W>
+	static void solveContactWide_StaticBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+	{
+		using namespace aos;
+		typedef typename W::V V;
+		typedef typename W::B B;
+
+		PX_ASSERT(!cache.contactErrorAccumulator);
+
+		PxSolverBody* bodies0[W::eNB_BLOCKS*4];
+		for(PxU32 i=0; i<W::eNB_BLOCKS*4; i++)
+			bodies0[i] = desc[i].bodyA;
+
+		intptr_t offsets[W::eNB_BLOCKS];
+		getWideBlockOffsets<W>(desc, offsets);
+
+		const PxU8* PX_RESTRICT last = desc[0].constraint + getConstraintLength(desc[0]);
+
+		PxU8* PX_RESTRICT currPtr = desc[0].constraint;
+
+		const V vZero = W::zero();
+		const V vMax = W::splat(PX_MAX_REAL);
+
+		WideBodyVelocities<W> vel0;
+		loadWideVelocities<W>(bodies0, vel0);
+
+		V linVel0T0 = vel0.linX, linVel0T1 = vel0.linY, linVel0T2 = vel0.linZ;
+		V angState0T0 = vel0.angX, angState0T1 = vel0.angY, angState0T2 = vel0.angZ;
+
+		const PxU8* PX_RESTRICT prefetchAddress = currPtr + sizeof(SolverContactHeader4) + sizeof(SolverContactBatchPointBase4);
+
+		const SolverContactHeader4* PX_RESTRICT hdr = reinterpret_cast<SolverContactHeader4*>(currPtr);
+
+		const V invMass0 = W::load(hdr->invMass0D0, offsets);
+
+		while(currPtr < last)
+		{
+			hdr = reinterpret_cast<const SolverContactHeader4*>(currPtr);
+
+			PX_ASSERT(hdr->type == DY_SC_TYPE_BLOCK_STATIC_RB_CONTACT);
+
+			currPtr = const_cast<PxU8*>(reinterpret_cast<const PxU8*>(hdr + 1));
+
+			const PxU32 numNormalConstr = hdr->numNormalConstr;
+			const PxU32	numFrictionConstr = hdr->numFrictionConstr;
+			const bool hasMaxImpulse = (hdr->flag & SolverContactHeader4::eHAS_MAX_IMPULSE) != 0;
+
+			Vec4V* appliedForces = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V)*numNormalConstr;
+
+			SolverContactBatchPointBase4* PX_RESTRICT contacts = reinterpret_cast<SolverContactBatchPointBase4*>(currPtr);
+
+			currPtr = reinterpret_cast<PxU8*>(contacts + numNormalConstr);
+
+			Vec4V* maxImpulses = NULL;
+			if(hasMaxImpulse)
+			{
+				maxImpulses = reinterpret_cast<Vec4V*>(currPtr);
+				currPtr += sizeof(Vec4V) * numNormalConstr;
+			}
+
+			SolverFrictionSharedData4* PX_RESTRICT fd = reinterpret_cast<SolverFrictionSharedData4*>(currPtr);
+			if(numFrictionConstr)
+				currPtr += sizeof(SolverFrictionSharedData4);
+
+			Vec4V* frictionAppliedForces = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V)*numFrictionConstr;
+
+			const SolverContactFrictionBase4* PX_RESTRICT frictions = reinterpret_cast<SolverContactFrictionBase4*>(currPtr);
+			currPtr += numFrictionConstr * sizeof(SolverContactFrictionBase4);
+
+			V accumulatedNormalImpulse = vZero;
+
+			const V angD0 = W::load(hdr->angDom0, offsets);
+			const V _normalT0 = W::load(hdr->normalX, offsets);
+			const V _normalT1 = W::load(hdr->normalY, offsets);
+			const V _normalT2 = W::load(hdr->normalZ, offsets);
+
+			V contactNormalVel1 = W::mul(linVel0T0, _normalT0);
+			contactNormalVel1 = W::mulAdd(linVel0T1, _normalT1, contactNormalVel1);
+
+			contactNormalVel1 = W::mulAdd(linVel0T2, _normalT2, contactNormalVel1);
+
+			V accumDeltaF = vZero;
+
+			for(PxU32 i=0;i<numNormalConstr;i++)
+			{
+				const SolverContactBatchPointBase4& c = contacts[i];
+
+				prefetchWideBlocks<W>(prefetchAddress + 64, offsets, 3);
+				prefetchAddress += 192;
+
+				const V appliedForce = W::load(appliedForces[i], offsets);
+				const V maxImpulse = hasMaxImpulse ? W::load(maxImpulses[i], offsets) : vMax;
+
+				const V raXnX = W::load(c.raXnX, offsets);
+				const V raXnY = W::load(c.raXnY, offsets);
+				const V raXnZ = W::load(c.raXnZ, offsets);
+
+				V contactNormalVel2 = W::mulAdd(raXnX, angState0T0, contactNormalVel1);
+				contactNormalVel2 = W::mulAdd(raXnY, angState0T1, contactNormalVel2);
+				const V normalVel = W::mulAdd(raXnZ, angState0T2, contactNormalVel2);
+
+				const V _deltaF = W::max(W::negMulSub(normalVel, W::load(c.velMultiplier, offsets), W::load(c.biasedErr, offsets)), W::neg(appliedForce));
+
+				V newAppliedForce = W::mulAdd(W::load(c.impulseMultiplier, offsets), appliedForce, _deltaF);
+				newAppliedForce = W::min(newAppliedForce, maxImpulse);
+				const V deltaF = W::sub(newAppliedForce, appliedForce);
+
+				const V angDeltaF = W::mul(angD0, deltaF);
+
+				accumDeltaF = W::add(accumDeltaF, deltaF);
+
+				contactNormalVel1 = W::mulAdd(invMass0, deltaF, contactNormalVel1);
+				angState0T0 = W::mulAdd(raXnX, angDeltaF, angState0T0);
+				angState0T1 = W::mulAdd(raXnY, angDeltaF, angState0T1);
+				angState0T2 = W::mulAdd(raXnZ, angDeltaF, angState0T2);
+
+				W::store(newAppliedForce, appliedForces[i], offsets);
+
+				accumulatedNormalImpulse = W::add(accumulatedNormalImpulse, newAppliedForce);
+			}
+
+			const V deltaFInvMass0 = W::mul(accumDeltaF, invMass0);
+
+			linVel0T0 = W::mulAdd(_normalT0, deltaFInvMass0, linVel0T0);
+			linVel0T1 = W::mulAdd(_normalT1, deltaFInvMass0, linVel0T1);
+			linVel0T2 = W::mulAdd(_normalT2, deltaFInvMass0, linVel0T2);
+
+			if(cache.doFriction && numFrictionConstr)
+			{
+				const V staticFric = W::load(hdr->staticFriction, offsets);
+				const V dynamicFric = W::load(hdr->dynamicFriction, offsets);
+
+				const V maxFrictionImpulse = W::mul(staticFric, accumulatedNormalImpulse);
+				const V maxDynFrictionImpulse = W::mul(dynamicFric, accumulatedNormalImpulse);
+				const V negMaxDynFrictionImpulse = W::neg(maxDynFrictionImpulse);
+
+				B broken = W::bFalse();
+
+				if(cache.writeBackIteration)
+				{
+					for(PxU32 k=0; k<W::eNB_BLOCKS; k++)
+					{
+						const SolverFrictionSharedData4* fdk = getWideBlockPtr(fd, offsets[k]);
+						PxPrefetchLine(fdk->frictionBrokenWritebackByte[0]);
+						PxPrefetchLine(fdk->frictionBrokenWritebackByte[1]);
+						PxPrefetchLine(fdk->frictionBrokenWritebackByte[2]);
+						PxPrefetchLine(fdk->frictionBrokenWritebackByte[3]);
+					}
+				}
+
+				for(PxU32 i=0;i<numFrictionConstr;i++)
+				{
+					const SolverContactFrictionBase4& f = frictions[i];
+
+					prefetchWideBlocks<W>(prefetchAddress + 64, offsets, 3);
+					prefetchAddress += 192;
+
+					const V appliedForce = W::load(frictionAppliedForces[i], offsets);
+
+					const V normalT0 = W::load(fd->normalX[i&1], offsets);
+					const V normalT1 = W::load(fd->normalY[i&1], offsets);
+					const V normalT2 = W::load(fd->normalZ[i&1], offsets);
+
+					const V raXnX = W::load(f.raXnX, offsets);
+					const V raXnY = W::load(f.raXnY, offsets);
+					const V raXnZ = W::load(f.raXnZ, offsets);
+
+					V normalVel1 = W::mul(linVel0T0, normalT0);
+					V normalVel2 = W::mul(raXnX, angState0T0);
+
+					normalVel1 = W::mulAdd(linVel0T1, normalT1, normalVel1);
+					normalVel2 = W::mulAdd(raXnY, angState0T1, normalVel2);
+
+					normalVel1 = W::mulAdd(linVel0T2, normalT2, normalVel1);
+					normalVel2 = W::mulAdd(raXnZ, angState0T2, normalVel2);
+
+					const V normalVel = W::add(normalVel1, normalVel2);
+
+					const V tmp1 = W::sub(appliedForce, W::load(f.scaledBias, offsets));
+
+					const V totalImpulse = W::negMulSub(normalVel, W::load(f.velMultiplier, offsets), tmp1);
+
+					broken = W::bOr(broken, W::isGrtr(W::abs(totalImpulse), maxFrictionImpulse));
+
+					const V newAppliedForce = W::sel(broken, W::min(maxDynFrictionImpulse, W::max(negMaxDynFrictionImpulse, totalImpulse)), totalImpulse);
+
+					const V deltaF = W::sub(newAppliedForce, appliedForce);
+
+					const V deltaFInvMass = W::mul(invMass0, deltaF);
+					const V angDeltaF = W::mul(angD0, deltaF);
+
+					linVel0T0 = W::mulAdd(normalT0, deltaFInvMass, linVel0T0);
+					angState0T0 = W::mulAdd(raXnX, angDeltaF, angState0T0);
+
+					linVel0T1 = W::mulAdd(normalT1, deltaFInvMass, linVel0T1);
+					angState0T1 = W::mulAdd(raXnY, angDeltaF, angState0T1);
+
+					linVel0T2 = W::mulAdd(normalT2, deltaFInvMass, linVel0T2);
+					angState0T2 = W::mulAdd(raXnZ, angDeltaF, angState0T2);
+
+					W::store(newAppliedForce, frictionAppliedForces[i], offsets);
+				}
+
+				W::storeBool(broken, fd->broken, offsets);
+			}
+		}
+
+		vel0.linX = linVel0T0; vel0.linY = linVel0T1; vel0.linZ = linVel0T2;
+		vel0.angX = angState0T0; vel0.angY = angState0T1; vel0.angZ = angState0T2;
+
+		storeWideVelocities<W>(bodies0, vel0, 0);
+	}
+
+	// PT: wide version of solve1D4_Block
+	template<class W>
+	static void solve1DWide_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, const SolverContext& cache)
+	{
+		using namespace aos;
+		typedef typename W::V V;
+
+		// PT: wide batches are not used when residuals are reported, so the rows never have the residual members
+		PX_ASSERT(!cache.contactErrorAccumulator);
+		PX_UNUSED(cache);
+
+		PxSolverBody* bodies0[W::eNB_BLOCKS*4];
+		PxSolverBody* bodies1[W::eNB_BLOCKS*4];
+		for(PxU32 i=0; i<W::eNB_BLOCKS*4; i++)
+		{
+			bodies0[i] = desc[i].bodyA;
+			bodies1[i] = desc[i].bodyB;
+		}
+
+		intptr_t offsets[W::eNB_BLOCKS];
+		getWideBlockOffsets<W>(desc, offsets);
+
+		PxU8* PX_RESTRICT bPtr = desc[0].constraint;
+
+		SolverConstraint1DHeader4* PX_RESTRICT header = reinterpret_cast<SolverConstraint1DHeader4*>(bPtr);
+		PxU8* PX_RESTRICT base = reinterpret_cast<PxU8*>(header+1);
+		const PxU32 stride = sizeof(SolverConstraint1DDynamic4);
+
+		WideBodyVelocities<W> vel0, vel1;
+		loadWideVelocities<W>(bodies0, vel0);
+		loadWideVelocities<W>(bodies1, vel1);
+
+		V linVel0T0 = vel0.linX, linVel0T1 = vel0.linY, linVel0T2 = vel0.linZ;
+		V linVel1T0 = vel1.linX, linVel1T1 = vel1.linY, linVel1T2 = vel1.linZ;
+		V angState0T0 = vel0.angX, angState0T1 = vel0.angY, angState0T2 = vel0.angZ;
+		V angState1T0 = vel1.angX, angState1T1 = vel1.angY, angState1T2 = vel1.angZ;
+
+		const V invMass0D0 = W::load(header->invMass0D0, offsets);
+		const V invMass1D1 = W::load(header->invMass1D1, offsets);
+
+		const V angD0 = W::load(header->angD0, offsets);
+		const V angD1 = W::load(header->angD1, offsets);
+
+		const PxU32 maxConstraints = header->count;
+
+		for(PxU32 a = 0; a < maxConstraints; ++a)
+		{
+			SolverConstraint1DDynamic4& c = *reinterpret_cast<SolverConstraint1DDynamic4*>(base);
+			base += stride;
+
+			prefetchWideBlocks<W>(base, offsets, 5);
+
+			const V appliedForce = W::load(c.appliedForce, offsets);
+
+			const V lin0X = W::load(c.lin0X, offsets);
+			const V lin0Y = W::load(c.lin0Y, offsets);
+			const V lin0Z = W::load(c.lin0Z, offsets);
+			const V lin1X = W::load(c.lin1X, offsets);
+			const V lin1Y = W::load(c.lin1Y, offsets);
+			const V lin1Z = W::load(c.lin1Z, offsets);
+			const V ang0X = W::load(c.ang0X, offsets);
+			const V ang0Y = W::load(c.ang0Y, offsets);
+			const V ang0Z = W::load(c.ang0Z, offsets);
+			const V ang1X = W::load(c.ang1X, offsets);
+			const V ang1Y = W::load(c.ang1Y, offsets);
+			const V ang1Z = W::load(c.ang1Z, offsets);
+
+			V linProj0 = W::mul(lin0X, linVel0T0);
+			V linProj1 = W::mul(lin1X, linVel1T0);
+			V angProj0 = W::mul(ang0X, angState0T0);
+			V angProj1 = W::mul(ang1X, angState1T0);
+
+			linProj0 = W::mulAdd(lin0Y, linVel0T1, linProj0);
+			linProj1 = W::mulAdd(lin1Y, linVel1T1, linProj1);
+			angProj0 = W::mulAdd(ang0Y, angState0T1, angProj0);
+			angProj1 = W::mulAdd(ang1Y, angState1T1, angProj1);
+
+			linProj0 = W::mulAdd(lin0Z, linVel0T2, linProj0);
+			linProj1 = W::mulAdd(lin1Z, linVel1T2, linProj1);
+			angProj0 = W::mulAdd(ang0Z, angState0T2, angProj0);
+			angProj1 = W::mulAdd(ang1Z, angState1T2, angProj1);
+
+			const V projectVel0 = W::add(linProj0, angProj0);
+			const V projectVel1 = W::add(linProj1, angProj1);
+
+			const V normalVel = W::sub(projectVel0, projectVel1);
+
+			const V unclampedForce = W::mulAdd(appliedForce, W::load(c.impulseMultiplier, offsets), W::mulAdd(normalVel, W::load(c.velMultiplier, offsets), W::load(c.constant, offsets)));
+			const V clampedForce = W::max(W::load(c.minImpulse, offsets), W::min(W::load(c.maxImpulse, offsets), unclampedForce));
+			const V deltaF = W::sub(clampedForce, appliedForce);
+			W::store(clampedForce, c.appliedForce, offsets);
+
+			const V deltaFInvMass0 = W::mul(deltaF, invMass0D0);
+			const V deltaFInvMass1 = W::mul(deltaF, invMass1D1);
+
+			const V angDeltaFInvMass0 = W::mul(deltaF, angD0);
+			const V angDeltaFInvMass1 = W::mul(deltaF, angD1);
+
+			linVel0T0 = W::mulAdd(lin0X, deltaFInvMass0, linVel0T0);
+			linVel1T0 = W::negMulSub(lin1X, deltaFInvMass1, linVel1T0);
+			angState0T0 = W::mulAdd(ang0X, angDeltaFInvMass0, angState0T0);
+			angState1T0 = W::negMulSub(ang1X, angDeltaFInvMass1, angState1T0);
+
+			linVel0T1 = W::mulAdd(lin0Y, deltaFInvMass0, linVel0T1);
+			linVel1T1 = W::negMulSub(lin1Y, deltaFInvMass1, linVel1T1);
+			angState0T1 = W::mulAdd(ang0Y, angDeltaFInvMass0, angState0T1);
+			angState1T1 = W::negMulSub(ang1Y, angDeltaFInvMass1, angState1T1);
+
+			linVel0T2 = W::mulAdd(lin0Z, deltaFInvMass0, linVel0T2);
+			linVel1T2 = W::negMulSub(lin1Z, deltaFInvMass1, linVel1T2);
+			angState0T2 = W::mulAdd(ang0Z, angDeltaFInvMass0, angState0T2);
+			angState1T2 = W::negMulSub(ang1Z, angDeltaFInvMass1, angState1T2);
+		}
+
+		vel0.linX = linVel0T0; vel0.linY = linVel0T1; vel0.linZ = linVel0T2;
+		vel1.linX = linVel1T0; vel1.linY = linVel1T1; vel1.linZ = linVel1T2;
+		vel0.angX = angState0T0; vel0.angY = angState0T1; vel0.angZ = angState0T2;
+		vel1.angX = angState1T0; vel1.angY = angState1T1; vel1.angZ = angState1T2;
+
+		// PT: like solve1D4_Block we write back all the bodies, including the world body
+		storeWideVelocities<W>(bodies0, vel0, 0);
+		storeWideVelocities<W>(bodies1, vel1, 0);
+	}
+}
+}
+
+#endif
@@ -167,26 +167,29 @@ void NpArticulationReducedCoordinate::applyCache(PxArticulationCache& cache, con
 	}
 
 	if (!(getScene()->getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API))
+		applyCacheInternal(cache, flags, autowake);
+}
+
+void NpArticulationReducedCoordinate::applyCacheInternal(PxArticulationCache& cache, const PxArticulationCacheFlags flags, bool autowake)
+{
+	const bool forceWake = mCore.applyCache(cache, flags);
+
+	if (flags & (PxArticulationCacheFlag::ePOSITION | PxArticulationCacheFlag::eROOT_TRANSFORM))
 	{
-		const bool forceWake = mCore.applyCache(cache, flags);
+		const PxU32 linkCount = mArticulationLinks.size();
 
-		if (flags & (PxArticulationCacheFlag::ePOSITION | PxArticulationCacheFlag::eROOT_TRANSFORM))
+		//KS - the below code forces contact managers to be updated/cached data to be dropped and
+		//shape transforms to be updated.
+		for (PxU32 i = 0; i < linkCount; ++i)
 		{
-			const PxU32 linkCount = mArticulationLinks.size();
-
-			//KS - the below code forces contact managers to be updated/cached data to be dropped and
-			//shape transforms to be updated.
-			for (PxU32 i = 0; i < linkCount; ++i)
-			{
-				NpArticulationLink* link = mArticulationLinks[i];
-				//in the lowlevel articulation, we have already updated bodyCore's body2World
-				const PxTransform internalPose = link->getCore().getBody2World();
-				link->scSetBody2World(internalPose);
-			}
+			NpArticulationLink* link = mArticulationLinks[i];
+			//in the lowlevel articulation, we have already updated bodyCore's body2World
+			const PxTransform internalPose = link->getCore().getBody2World();
+			link->scSetBody2World(internalPose);
 		}
-
-		wakeUpInternal(forceWake, autowake);
 	}
+
+	wakeUpInternal(forceWake, autowake);
 }
 
 void NpArticulationReducedCoordinate::copyInternalStateToCache(PxArticulationCache& cache, const PxArticulationCacheFlags flags) const
@@ -193,6 +193,9 @@ namespace physx
 		void										wakeUpInternal(bool forceWakeUp, bool autowake);
 		void										autoWakeInternal();
 
+		// PT: applyCache() without the API checks, also used by the direct-CPU API
+		void										applyCacheInternal(PxArticulationCache& cache, const PxArticulationCacheFlags flags, bool autowake);
+
 		void										setGlobalPose();
 
 		PX_FORCE_INLINE	Sc::ArticulationCore&		getCore()			{ return mCore; }
@@ -0,0 +1,481 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#include "NpDirectCPUAPI.h"
+#include "NpScene.h"
+#include "NpRigidDynamic.h"
+#include "NpArticulationReducedCoordinate.h"
+#include "NpBase.h"
+#include "NpCheck.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxThread.h"
+#include "task/PxCpuDispatcher.h"
+
+using namespace physx;
+
+PX_IMPLEMENT_OUTPUT_ERROR
+
+// PT: number of elements per batch. Rigid dynamics are a handful of loads and stores each, articulations copy a full dof block.
+static const PxU32 gRigidDynamicBatchSize = 512;
+static const PxU32 gArticulationBatchSize = 16;
+
+void NpDirectCPUAPITask::run()
+{
+	mOwner->processBatches();
+}
+
+void NpDirectCPUAPITask::release()
+{
+	PxAtomicExchange(&mInFlight, 0);
+}
+
+NpDirectCPUAPI::NpDirectCPUAPI(NpScene& scene) :
+	mNpScene				(scene),
+	mJob					(NULL),
+	mNbRemainingBatches		(0),
+	mNbUnfinishedBatches	(0)
+{
+	for(PxU32 i=0;i<NP_DIRECT_CPU_API_MAX_NB_TASKS;i++)
+		mTasks[i].mOwner = this;
+}
+
+NpDirectCPUAPI::~NpDirectCPUAPI()
+{
+	// PT: tasks submitted by previous calls can still be queued in the dispatcher
+	for(PxU32 i=0;i<NP_DIRECT_CPU_API_MAX_NB_TASKS;i++)
+	{
+		while(mTasks[i].mInFlight)
+			PxThread::yield();
+	}
+}
+
+void NpDirectCPUAPI::processBatches() const
+{
+	while(1)
+	{
+		// PT: a batch is claimed on the job running at the time of the exchange, and that job cannot end before the batch is
+		// processed. So mJob is valid after a successful claim, and a task running after its own job ended helps the next one.
+		const PxI32 nbRemaining = mNbRemainingBatches;
+		if(nbRemaining <= 0)
+			break;
+
+		if(PxAtomicCompareExchange(&mNbRemainingBatches, nbRemaining - 1, nbRemaining) != nbRemaining)
+			continue;
+
+		const NpDirectCPUAPIJob& job = *mJob;
+		const PxU32 start = PxU32(nbRemaining - 1) * job.mBatchSize;
+		job.mProcess(job, start, PxMin(start + job.mBatchSize, job.mNbElements));
+
+		if(!PxAtomicDecrement(&mNbUnfinishedBatches))
+			mBatchesDone.set();
+	}
+}
+
+void NpDirectCPUAPI::runJob(const NpDirectCPUAPIJob& job) const
+{
+	const PxU32 nbBatches = (job.mNbElements + job.mBatchSize - 1) / job.mBatchSize;
+
+	// PT: the calling thread processes batches as well, so we need at most one task less than batches
+	PxCpuDispatcher* dispatcher = mNpScene.getCpuDispatcher();
+	PxU32 nbTasks = dispatcher ? PxMin(dispatcher->getWorkerCount(), PxU32(NP_DIRECT_CPU_API_MAX_NB_TASKS)) : 0;
+	nbTasks = PxMin(nbTasks, nbBatches - 1);
+
+	if(!nbTasks)
+	{
+		job.mProcess(job, 0, job.mNbElements);
+		return;
+	}
+
+	PxMutex::ScopedLock lock(mMutex);
+
+	mJob = &job;
+	mNbUnfinishedBatches = PxI32(nbBatches);
+	mBatchesDone.reset();
+	// PT: publishes the job, the exchange is a full barrier
+	PxAtomicExchange(&mNbRemainingBatches, PxI32(nbBatches));
+
+	// PT: tasks still queued by previous calls are not submitted again, they will pick up batches from this job when they run
+	for(PxU32 i=0;i<NP_DIRECT_CPU_API_MAX_NB_TASKS && nbTasks;i++)
+	{
+		if(!PxAtomicCompareExchange(&mTasks[i].mInFlight, 1, 0))
+		{
+			dispatcher->submitTask(mTasks[i]);
+			nbTasks--;
+		}
+	}
+
+	// PT: the calling thread keeps processing batches until none are left, so we only wait for the batches claimed by tasks
+	// that are already running. We never wait for queued tasks, which could be stuck behind the simulation tasks, or behind
+	// the calling thread itself when it is a worker of the dispatcher.
+	processBatches();
+
+	mBatchesDone.wait();
+	mJob = NULL;
+}
+
+static PX_FORCE_INLINE PxU32 getStride(PxU32 stride, PxU32 elementSize)
+{
+	return stride ? stride : elementSize;
+}
+
+static bool checkStride(PxU32 stride, PxU32 elementSize, const char* functionName)
+{
+	if(stride < elementSize || (stride & 3))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: stride must be a multiple of 4 and at least as large as the data type.", functionName);
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool checkRigidDynamics(const NpScene& scene, PxRigidDynamic* const* actors, PxU32 nbElements, bool needsSimulatedBody, const char* functionName)
+{
+	for(PxU32 i=0;i<nbElements;i++)
+	{
+		const NpRigidDynamic* actor = static_cast<const NpRigidDynamic*>(actors[i]);
+		if(!actor || actor->getNpScene() != &scene)
+			return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: actor %d is NULL or not part of this scene.", functionName, i);
+
+		if(needsSimulatedBody)
+		{
+			const Sc::BodyCore& core = actor->getCore();
+			if((core.getFlags() & PxRigidBodyFlag::eKINEMATIC) || core.getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION))
+				return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: actor %d must be non-kinematic and must not have PxActorFlag::eDISABLE_SIMULATION set.", functionName, i);
+		}
+	}
+	return true;
+}
+
+#if PX_CHECKED
+// PT: the values are validated before anything is written, for the same reason as the actors
+static bool checkRigidDynamicValues(const void* data, PxU32 stride, PxRigidDynamicCPUAPIWriteType::Enum dataType, PxU32 nbElements)
+{
+	const PxU8* src = reinterpret_cast<const PxU8*>(data);
+	for(PxU32 i=0;i<nbElements;i++, src += stride)
+	{
+		if(dataType == PxRigidDynamicCPUAPIWriteType::eGLOBAL_POSE)
+		{
+			if(!reinterpret_cast<const PxTransform*>(src)->isSane())
+				return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxDirectCPUAPI::setRigidDynamicData(): pose %d is not valid.", i);
+		}
+		else if(!reinterpret_cast<const PxVec3*>(src)->isFinite())
+			return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxDirectCPUAPI::setRigidDynamicData(): value %d is not valid.", i);
+	}
+	return true;
+}
+#endif
+
+static void readRigidDynamics(const NpDirectCPUAPIJob& job, PxU32 start, PxU32 end)
+{
+	PxRigidDynamic* const* actors = reinterpret_cast<PxRigidDynamic* const*>(job.mObjects);
+	PxU8* dst = reinterpret_cast<PxU8*>(job.mData) + size_t(start) * job.mStride;
+
+	switch(job.mDataType)
+	{
+		case PxRigidDynamicCPUAPIReadType::eGLOBAL_POSE:
+		{
+			for(PxU32 i=start;i<end;i++, dst += job.mStride)
+				*reinterpret_cast<PxTransform*>(dst) = static_cast<const NpRigidDynamic*>(actors[i])->getGlobalPoseFast();
+		}
+		break;
+		case PxRigidDynamicCPUAPIReadType::eLINEAR_VELOCITY:
+		{
+			for(PxU32 i=start;i<end;i++, dst += job.mStride)
+				*reinterpret_cast<PxVec3*>(dst) = static_cast<const NpRigidDynamic*>(actors[i])->getCore().getLinearVelocity();
+		}
+		break;
+		case PxRigidDynamicCPUAPIReadType::eANGULAR_VELOCITY:
+		{
+			for(PxU32 i=start;i<end;i++, dst += job.mStride)
+				*reinterpret_cast<PxVec3*>(dst) = static_cast<const NpRigidDynamic*>(actors[i])->getCore().getAngularVelocity();
+		}
+		break;
+	}
+}
+
+bool NpDirectCPUAPI::getRigidDynamicData(void* data, PxU32 stride, PxRigidDynamic* const* actors, PxRigidDynamicCPUAPIReadType::Enum dataType, PxU32 nbElements) const
+{
+	NP_READ_CHECK(&mNpScene);
+
+	if(mNpScene.isAPIReadForbidden() && !mNpScene.isCollisionPhaseActive())
+		return NP_API_READ_WRITE_ERROR_MSG("PxDirectCPUAPI::getRigidDynamicData(): not allowed while simulation is running (except during PxScene::collide()). Call will be ignored.");
+
+	if(mNpScene.getFlagsFast() & PxSceneFlag::eENABLE_DIRECT_GPU_API)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::getRigidDynamicData(): it is illegal to call this function if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled. Use PxDirectGPUAPI instead.");
+
+	if(!nbElements)
+		return true;
+
+	if(!data || !actors)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::getRigidDynamicData(): data and/or actors has to be valid pointer.");
+
+	const PxU32 elementSize = dataType == PxRigidDynamicCPUAPIReadType::eGLOBAL_POSE ? sizeof(PxTransform) : sizeof(PxVec3);
+	stride = getStride(stride, elementSize);
+	if(!checkStride(stride, elementSize, "PxDirectCPUAPI::getRigidDynamicData()"))
+		return false;
+
+#if PX_CHECKED
+	if(!checkRigidDynamics(mNpScene, actors, nbElements, false, "PxDirectCPUAPI::getRigidDynamicData()"))
+		return false;
+#endif
+
+	NpDirectCPUAPIJob job;
+	job.mProcess			= readRigidDynamics;
+	job.mData				= data;
+	job.mObjects			= actors;
+	job.mStride				= stride;
+	job.mDataType			= dataType;
+	job.mNbElements			= nbElements;
+	job.mBatchSize			= gRigidDynamicBatchSize;
+	job.mIsGpuSimEnabled	= false;
+	runJob(job);
+
+	return true;
+}
+
+bool NpDirectCPUAPI::setRigidDynamicData(const void* data, PxU32 stride, PxRigidDynamic* const* actors, PxRigidDynamicCPUAPIWriteType::Enum dataType, PxU32 nbElements, bool autowake)
+{
+	NP_WRITE_CHECK(&mNpScene);
+
+	if(mNpScene.isAPIWriteForbidden())
+		return NP_API_READ_WRITE_ERROR_MSG("PxDirectCPUAPI::setRigidDynamicData(): not allowed while simulation is running. Call will be ignored.");
+
+	if(mNpScene.getFlagsFast() & PxSceneFlag::eENABLE_DIRECT_GPU_API)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::setRigidDynamicData(): it is illegal to call this function if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled. Use PxDirectGPUAPI instead.");
+
+	if(!nbElements)
+		return true;
+
+	if(!data || !actors)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::setRigidDynamicData(): data and/or actors has to be valid pointer.");
+
+	const PxU32 elementSize = dataType == PxRigidDynamicCPUAPIWriteType::eGLOBAL_POSE ? sizeof(PxTransform) : sizeof(PxVec3);
+	stride = getStride(stride, elementSize);
+	if(!checkStride(stride, elementSize, "PxDirectCPUAPI::setRigidDynamicData()"))
+		return false;
+
+	// PT: the actor list is validated up-front in all builds, so that a bad actor does not leave the list half-applied.
+	if(!checkRigidDynamics(mNpScene, actors, nbElements, dataType != PxRigidDynamicCPUAPIWriteType::eGLOBAL_POSE, "PxDirectCPUAPI::setRigidDynamicData()"))
+		return false;
+
+#if PX_CHECKED
+	if(!checkRigidDynamicValues(data, stride, dataType, nbElements))
+		return false;
+#endif
+
+	// PT: the setters update the scene-query pruners, the body accelerations and the wake state, which are shared
+	// across the scene, so unlike reads they run on the calling thread.
+	const PxU8* src = reinterpret_cast<const PxU8*>(data);
+	switch(dataType)
+	{
+		case PxRigidDynamicCPUAPIWriteType::eGLOBAL_POSE:
+		{
+			for(PxU32 i=0;i<nbElements;i++, src += stride)
+			{
+				const PxTransform& pose = *reinterpret_cast<const PxTransform*>(src);
+				static_cast<NpRigidDynamic*>(actors[i])->setGlobalPoseInternal(pose, autowake);
+			}
+		}
+		break;
+		case PxRigidDynamicCPUAPIWriteType::eLINEAR_VELOCITY:
+		{
+			for(PxU32 i=0;i<nbElements;i++, src += stride)
+			{
+				const PxVec3& velocity = *reinterpret_cast<const PxVec3*>(src);
+				static_cast<NpRigidDynamic*>(actors[i])->setLinearVelocityInternal(velocity, autowake);
+			}
+		}
+		break;
+		case PxRigidDynamicCPUAPIWriteType::eANGULAR_VELOCITY:
+		{
+			for(PxU32 i=0;i<nbElements;i++, src += stride)
+			{
+				const PxVec3& velocity = *reinterpret_cast<const PxVec3*>(src);
+				static_cast<NpRigidDynamic*>(actors[i])->setAngularVelocityInternal(velocity, autowake);
+			}
+		}
+		break;
+		case PxRigidDynamicCPUAPIWriteType::eFORCE:
+		{
+			for(PxU32 i=0;i<nbElements;i++, src += stride)
+			{
+				const PxVec3& force = *reinterpret_cast<const PxVec3*>(src);
+				static_cast<NpRigidDynamic*>(actors[i])->setForceAndTorqueInternal(&force, NULL, autowake);
+			}
+		}
+		break;
+		case PxRigidDynamicCPUAPIWriteType::eTORQUE:
+		{
+			for(PxU32 i=0;i<nbElements;i++, src += stride)
+			{
+				const PxVec3& torque = *reinterpret_cast<const PxVec3*>(src);
+				static_cast<NpRigidDynamic*>(actors[i])->setForceAndTorqueInternal(NULL, &torque, autowake);
+			}
+		}
+		break;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef PxReal* PxArticulationCache::*	ArticulationCacheMember;
+
+static PxArticulationCacheFlag::Enum getCacheMember(PxArticulationCPUAPIReadType::Enum dataType, ArticulationCacheMember& member)
+{
+	switch(dataType)
+	{
+		case PxArticulationCPUAPIReadType::eJOINT_POSITION:			member = &PxArticulationCache::jointPosition;			return PxArticulationCacheFlag::ePOSITION;
+		case PxArticulationCPUAPIReadType::eJOINT_VELOCITY:			member = &PxArticulationCache::jointVelocity;			return PxArticulationCacheFlag::eVELOCITY;
+		case PxArticulationCPUAPIReadType::eJOINT_ACCELERATION:		member = &PxArticulationCache::jointAcceleration;		return PxArticulationCacheFlag::eACCELERATION;
+		case PxArticulationCPUAPIReadType::eJOINT_FORCE:			member = &PxArticulationCache::jointForce;				return PxArticulationCacheFlag::eFORCE;
+		case PxArticulationCPUAPIReadType::eJOINT_TARGET_POSITION:	member = &PxArticulationCache::jointTargetPositions;	return PxArticulationCacheFlag::eJOINT_TARGET_POSITIONS;
+		case PxArticulationCPUAPIReadType::eJOINT_TARGET_VELOCITY:	member = &PxArticulationCache::jointTargetVelocities;	return PxArticulationCacheFlag::eJOINT_TARGET_VELOCITIES;
+	}
+	member = NULL;
+	return PxArticulationCacheFlag::Enum(0);
+}
+
+static PxArticulationCacheFlag::Enum getCacheMember(PxArticulationCPUAPIWriteType::Enum dataType, ArticulationCacheMember& member)
+{
+	switch(dataType)
+	{
+		case PxArticulationCPUAPIWriteType::eJOINT_POSITION:		member = &PxArticulationCache::jointPosition;			return PxArticulationCacheFlag::ePOSITION;
+		case PxArticulationCPUAPIWriteType::eJOINT_VELOCITY:		member = &PxArticulationCache::jointVelocity;			return PxArticulationCacheFlag::eVELOCITY;
+		case PxArticulationCPUAPIWriteType::eJOINT_FORCE:			member = &PxArticulationCache::jointForce;				return PxArticulationCacheFlag::eFORCE;
+		case PxArticulationCPUAPIWriteType::eJOINT_TARGET_POSITION:	member = &PxArticulationCache::jointTargetPositions;	return PxArticulationCacheFlag::eJOINT_TARGET_POSITIONS;
+		case PxArticulationCPUAPIWriteType::eJOINT_TARGET_VELOCITY:	member = &PxArticulationCache::jointTargetVelocities;	return PxArticulationCacheFlag::eJOINT_TARGET_VELOCITIES;
+	}
+	member = NULL;
+	return PxArticulationCacheFlag::Enum(0);
+}
+
+// PT: validates the articulations and computes the stride. A zero stride means blocks of the largest dof count.
+static bool checkArticulations(const NpScene& scene, PxArticulationReducedCoordinate* const* articulations, PxU32 nbElements, PxU32& stride, bool validate, const char* functionName)
+{
+	PxU32 maxDofs = 0;
+	if(validate || !stride)
+	{
+		for(PxU32 i=0;i<nbElements;i++)
+		{
+			const NpArticulationReducedCoordinate* articulation = static_cast<const NpArticulationReducedCoordinate*>(articulations[i]);
+			if(validate && (!articulation || articulation->getNpScene() != &scene))
+				return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: articulation %d is NULL or not part of this scene.", functionName, i);
+
+			maxDofs = PxMax(maxDofs, articulation->getCore().getDofs());
+		}
+	}
+
+	if(!stride)
+		stride = maxDofs * sizeof(PxReal);
+
+	return checkStride(stride, maxDofs * sizeof(PxReal), functionName);
+}
+
+static void readArticulations(const NpDirectCPUAPIJob& job, PxU32 start, PxU32 end)
+{
+	PxArticulationReducedCoordinate* const* articulations = reinterpret_cast<PxArticulationReducedCoordinate* const*>(job.mObjects);
+	PxU8* dst = reinterpret_cast<PxU8*>(job.mData) + size_t(start) * job.mStride;
+
+	ArticulationCacheMember member;
+	const PxArticulationCacheFlag::Enum flag = getCacheMember(PxArticulationCPUAPIReadType::Enum(job.mDataType), member);
+
+	// PT: the articulation cache only serves as a descriptor pointing into the user buffer here
+	PxArticulationCache cache;
+	for(PxU32 i=start;i<end;i++, dst += job.mStride)
+	{
+		cache.*member = reinterpret_cast<PxReal*>(dst);
+		static_cast<const NpArticulationReducedCoordinate*>(articulations[i])->getCore().copyInternalStateToCache(cache, flag, job.mIsGpuSimEnabled);
+	}
+}
+
+bool NpDirectCPUAPI::getArticulationData(void* data, PxU32 stride, PxArticulationReducedCoordinate* const* articulations, PxArticulationCPUAPIReadType::Enum dataType, PxU32 nbElements) const
+{
+	NP_READ_CHECK(&mNpScene);
+
+	if(mNpScene.isAPIReadForbidden() && !mNpScene.isCollisionPhaseActive())
+		return NP_API_READ_WRITE_ERROR_MSG("PxDirectCPUAPI::getArticulationData(): not allowed while simulation is running (except during PxScene::collide()). Call will be ignored.");
+
+	if(mNpScene.getFlagsFast() & PxSceneFlag::eENABLE_DIRECT_GPU_API)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::getArticulationData(): it is illegal to call this function if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled. Use PxDirectGPUAPI instead.");
+
+	if(!nbElements)
+		return true;
+
+	if(!data || !articulations)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::getArticulationData(): data and/or articulations has to be valid pointer.");
+
+	if(!checkArticulations(mNpScene, articulations, nbElements, stride, PX_CHECKED, "PxDirectCPUAPI::getArticulationData()"))
+		return false;
+
+	NpDirectCPUAPIJob job;
+	job.mProcess			= readArticulations;
+	job.mData				= data;
+	job.mObjects			= articulations;
+	job.mStride				= stride;
+	job.mDataType			= dataType;
+	job.mNbElements			= nbElements;
+	job.mBatchSize			= gArticulationBatchSize;
+	job.mIsGpuSimEnabled	= mNpScene.getFlagsFast() & PxSceneFlag::eENABLE_GPU_DYNAMICS;
+	runJob(job);
+
+	return true;
+}
+
+bool NpDirectCPUAPI::setArticulationData(const void* data, PxU32 stride, PxArticulationReducedCoordinate* const* articulations, PxArticulationCPUAPIWriteType::Enum dataType, PxU32 nbElements, bool autowake)
+{
+	NP_WRITE_CHECK(&mNpScene);
+
+	if(mNpScene.isAPIWriteForbidden())
+		return NP_API_READ_WRITE_ERROR_MSG("PxDirectCPUAPI::setArticulationData(): not allowed while simulation is running. Call will be ignored.");
+
+	if(mNpScene.getFlagsFast() & PxSceneFlag::eENABLE_DIRECT_GPU_API)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::setArticulationData(): it is illegal to call this function if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled. Use PxDirectGPUAPI instead.");
+
+	if(!nbElements)
+		return true;
+
+	if(!data || !articulations)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxDirectCPUAPI::setArticulationData(): data and/or articulations has to be valid pointer.");
+
+	if(!checkArticulations(mNpScene, articulations, nbElements, stride, true, "PxDirectCPUAPI::setArticulationData()"))
+		return false;
+
+	ArticulationCacheMember member;
+	const PxArticulationCacheFlag::Enum flag = getCacheMember(dataType, member);
+
+	// PT: applying a cache updates the link poses and the wake state, so writes run on the calling thread
+	const PxU8* src = reinterpret_cast<const PxU8*>(data);
+	PxArticulationCache cache;
+	for(PxU32 i=0;i<nbElements;i++, src += stride)
+	{
+		cache.*member = const_cast<PxReal*>(reinterpret_cast<const PxReal*>(src));
+		static_cast<NpArticulationReducedCoordinate*>(articulations[i])->applyCacheInternal(cache, flag, autowake);
+	}
+	return true;
+}
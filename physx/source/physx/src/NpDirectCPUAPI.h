@@ -0,0 +1,107 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef NP_DIRECT_CPU_API_H
+#define NP_DIRECT_CPU_API_H
+
+#include "PxDirectCPUAPI.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxSync.h"
+#include "task/PxTask.h"
+
+namespace physx
+{
+
+class NpScene;
+class NpDirectCPUAPI;
+
+// PT: describes one bulk copy. The elements are processed in batches of mBatchSize, claimed through an atomic
+// counter by the calling thread and by the worker tasks, so the same job code runs serially or in parallel.
+struct NpDirectCPUAPIJob
+{
+	typedef void	(*ProcessFunction)(const NpDirectCPUAPIJob& job, PxU32 start, PxU32 end);
+
+	ProcessFunction		mProcess;
+	void*				mData;
+	const void*			mObjects;
+	PxU32				mStride;
+	PxU32				mDataType;
+	PxU32				mNbElements;
+	PxU32				mBatchSize;
+	bool				mIsGpuSimEnabled;
+};
+
+class NpDirectCPUAPITask : public PxLightCpuTask
+{
+public:
+								NpDirectCPUAPITask() : mOwner(NULL), mInFlight(0)	{}
+
+	virtual	void				run()						PX_OVERRIDE;
+	virtual	void				release()					PX_OVERRIDE;
+	virtual	const char*			getName()			const	PX_OVERRIDE	{ return "NpDirectCPUAPI.processBatches";	}
+
+			const NpDirectCPUAPI*	mOwner;
+			volatile PxI32			mInFlight;	// PT: set while the task is queued or running in the dispatcher
+};
+
+#define NP_DIRECT_CPU_API_MAX_NB_TASKS	32
+
+class NpDirectCPUAPI : public PxDirectCPUAPI, public PxUserAllocated
+{
+public:
+	NpDirectCPUAPI(NpScene& scene);
+	virtual ~NpDirectCPUAPI();
+
+	// PxDirectCPUAPI
+	virtual bool getRigidDynamicData(void* data, PxU32 stride, PxRigidDynamic* const* actors, PxRigidDynamicCPUAPIReadType::Enum dataType, PxU32 nbElements) const PX_OVERRIDE PX_FINAL;
+	virtual bool setRigidDynamicData(const void* data, PxU32 stride, PxRigidDynamic* const* actors, PxRigidDynamicCPUAPIWriteType::Enum dataType, PxU32 nbElements, bool autowake) PX_OVERRIDE PX_FINAL;
+
+	virtual bool getArticulationData(void* data, PxU32 stride, PxArticulationReducedCoordinate* const* articulations, PxArticulationCPUAPIReadType::Enum dataType, PxU32 nbElements) const PX_OVERRIDE PX_FINAL;
+	virtual bool setArticulationData(const void* data, PxU32 stride, PxArticulationReducedCoordinate* const* articulations, PxArticulationCPUAPIWriteType::Enum dataType, PxU32 nbElements, bool autowake) PX_OVERRIDE PX_FINAL;
+	//~PxDirectCPUAPI
+
+			void				processBatches()	const;
+
+	NpScene&	mNpScene;
+private:
+			void				runJob(const NpDirectCPUAPIJob& job)	const;
+
+	// PT: state of the job currently running on the dispatcher. Calls are serialized with mMutex.
+	mutable	PxMutex						mMutex;
+	mutable	PxSync						mBatchesDone;
+	mutable	NpDirectCPUAPITask			mTasks[NP_DIRECT_CPU_API_MAX_NB_TASKS];
+	mutable	const NpDirectCPUAPIJob*	mJob;
+	mutable	volatile PxI32				mNbRemainingBatches;	// PT: batches not claimed yet
+	mutable	volatile PxI32				mNbUnfinishedBatches;	// PT: batches not processed yet
+};
+
+}
+
+#endif
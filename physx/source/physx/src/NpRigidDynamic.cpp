@@ -28,6 +28,7 @@
 
 #include "NpRigidDynamic.h"
 #include "NpRigidActorTemplateInternal.h"
+#include "NpSceneSnapshot.h"
 #include "omnipvd/NpOmniPvdSetData.h"
 
 using namespace physx;
@@ -103,6 +104,13 @@ void NpRigidDynamic::setGlobalPose(const PxTransform& pose, bool autowake)
 		return;
 	}
 
+	setGlobalPoseInternal(pose, autowake);
+}
+
+void NpRigidDynamic::setGlobalPoseInternal(const PxTransform& pose, bool autowake)
+{
+	NpScene* npScene = getNpScene();
+
 	const PxTransform newPose = pose.getNormalized();	//AM: added to fix 1461 where users read and write orientations for no reason.
 	
 	const PxTransform body2World = newPose * mCore.getBody2Actor();
@@ -240,6 +248,13 @@ void NpRigidDynamic::setLinearVelocity(const PxVec3& velocity, bool autowake)
 		return;
 	}
 
+	setLinearVelocityInternal(velocity, autowake);
+}
+
+void NpRigidDynamic::setLinearVelocityInternal(const PxVec3& velocity, bool autowake)
+{
+	NpScene* npScene = getNpScene();
+
 	scSetLinearVelocity(velocity);
 
 	if(npScene && npScene->getFlagsFast() & PxSceneFlag::eENABLE_BODY_ACCELERATIONS)
@@ -268,6 +283,19 @@ void NpRigidDynamic::setAngularVelocity(const PxVec3& velocity, bool autowake)
 
 	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_EXCEPT_SPLIT_SIM(npScene, "PxRigidDynamic::setAngularVelocity() not allowed while simulation is running. Call will be ignored.")
 
+	if (npScene && (npScene->getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API) && npScene->isDirectGPUAPIInitialized())
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxRigidDynamic::setAngularVelocity(): it is illegal to call this method if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled!");
+		return;
+	}
+
+	setAngularVelocityInternal(velocity, autowake);
+}
+
+void NpRigidDynamic::setAngularVelocityInternal(const PxVec3& velocity, bool autowake)
+{
+	NpScene* npScene = getNpScene();
+
 	scSetAngularVelocity(velocity);
 
 	if(npScene && npScene->getFlagsFast() & PxSceneFlag::eENABLE_BODY_ACCELERATIONS)
@@ -282,12 +310,6 @@ void NpRigidDynamic::setAngularVelocity(const PxVec3& velocity, bool autowake)
 
 	OMNI_PVD_SET(OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, angularVelocity, *static_cast<PxRigidBody*>(this), velocity);
 
-	if (npScene && (npScene->getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API) && npScene->isDirectGPUAPIInitialized())
-	{
-		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxRigidDynamic::setAngularVelocity(): it is illegal to call this method if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled!");
-		return;
-	}
-
 	if(npScene)
 		wakeUpInternalNoKinematicTest((!velocity.isZero()), autowake);
 }
@@ -347,6 +369,69 @@ void NpRigidDynamic::setForceAndTorque(const PxVec3& force, const PxVec3& torque
 	wakeUpInternalNoKinematicTest(!force.isZero(), true);
 }
 
+void NpRigidDynamic::setForceAndTorqueInternal(const PxVec3* force, const PxVec3* torque, bool autowake)
+{
+	setSpatialForce(force, torque, PxForceMode::eFORCE);
+
+	const bool forceWakeUp = (force && !force->isZero()) || (torque && !torque->isZero());
+	wakeUpInternalNoKinematicTest(forceWakeUp, autowake);
+}
+
+void NpRigidDynamic::getSnapshotState(NpRigidDynamicState& state) const
+{
+	const PxsBodyCore& core = mCore.getCore();
+	state.body2World		= core.body2World;
+	state.wakeCounter		= core.wakeCounter;
+	state.linearVelocity	= core.linearVelocity;
+	state.angularVelocity	= core.angularVelocity;
+	state.isSleeping		= PxU32(mCore.isSleeping());
+	state.pad				= 0;
+	mCore.getSleepFilters(state.sleepLinVelAcc, state.sleepAngVelAcc, state.freezeCount, state.accelScale);
+}
+
+void NpRigidDynamic::setSnapshotState(const NpRigidDynamicState& state, bool teleport)
+{
+	NpScene* npScene = getNpScene();
+	PX_ASSERT(npScene);
+
+	// PT: setting the pose discards the contact caches of the body, so we skip it when the body did not move
+	if(teleport || isBitwiseDifferent(&state.body2World, &mCore.getBody2World(), sizeof(PxTransform)))
+	{
+		scSetBody2World(state.body2World);
+
+		OMNI_PVD_WRITE_SCOPE_BEGIN(pvdWriter, pvdRegData)
+		OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidActor, globalPose, *static_cast<PxRigidActor*>(this), state.body2World * mCore.getBody2Actor().getInverse());
+		OMNI_PVD_WRITE_SCOPE_END
+
+		mShapeManager.markActorForSQUpdate(npScene->getSQAPI(), *this);
+
+		if(mShapeManager.getPruningStructure())
+		{
+			outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxSceneSnapshot::restore: Actor is part of a pruning structure, pruning structure is now invalid!");
+			mShapeManager.getPruningStructure()->invalidate(this);
+		}
+	}
+
+	if(mCore.getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION))
+		return;
+
+	// PT: the sleep state goes first since putting a body to sleep clears its velocities
+	if(!(mCore.getFlags() & PxRigidBodyFlag::eKINEMATIC))
+	{
+		if(state.isSleeping)
+		{
+			if(!mCore.isSleeping())
+				scPutToSleepInternal();
+		}
+		else
+			scWakeUpInternal(state.wakeCounter);
+	}
+
+	scSetLinearVelocity(state.linearVelocity);
+	scSetAngularVelocity(state.angularVelocity);
+	mCore.setSleepFilters(state.sleepLinVelAcc, state.sleepAngVelAcc, state.freezeCount, state.accelScale);
+}
+
 void NpRigidDynamic::addTorque(const PxVec3& torque, PxForceMode::Enum mode, bool autowake)
 {
 	NpScene* npScene = getNpScene();
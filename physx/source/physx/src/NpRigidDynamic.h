@@ -36,6 +36,8 @@ namespace physx
 {
 typedef NpRigidBodyTemplate<PxRigidDynamic> NpRigidDynamicT;
 
+struct NpRigidDynamicState;
+
 class NpRigidDynamic : public NpRigidDynamicT
 {
 public:
@@ -127,6 +129,16 @@ public:
 	PX_FORCE_INLINE void			wakeUpInternal();
 					void			wakeUpInternalNoKinematicTest(bool forceWakeUp, bool autowake);
 
+	// PT: versions of the setters without the API checks, used by the public functions and by the direct-CPU API
+					void			setGlobalPoseInternal(const PxTransform& pose, bool autowake);
+					void			setLinearVelocityInternal(const PxVec3& velocity, bool autowake);
+					void			setAngularVelocityInternal(const PxVec3& velocity, bool autowake);
+					void			setForceAndTorqueInternal(const PxVec3* force, const PxVec3* torque, bool autowake);
+
+	// PT: complete body state, used by scene snapshots
+					void			getSnapshotState(NpRigidDynamicState& state)	const;
+					void			setSnapshotState(const NpRigidDynamicState& state, bool teleport);
+
 	static PX_FORCE_INLINE size_t	getCoreOffset()				{ return PX_OFFSET_OF_RT(NpRigidDynamic, mCore);			}
 	static PX_FORCE_INLINE size_t	getNpShapeManagerOffset()	{ return PX_OFFSET_OF_RT(NpRigidDynamic, mShapeManager);	}
 
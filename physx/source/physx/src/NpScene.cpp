@@ -32,6 +32,7 @@
 #include "NpArticulationReducedCoordinate.h"
 #include "NpArticulationTendon.h"
 #include "NpAggregate.h"
+#include "NpSceneSnapshot.h"
 #include "PxConstraint.h"
 #include "PxSceneDesc.h"
 #include "PxDirectGPUAPI.h"
@@ -171,6 +172,7 @@ NpScene::NpScene(const PxSceneDesc& desc, NpPhysics& physics) :
 	mCorruptedState				(false),
 	mScene						(desc, getContextId()),
 	mDirectGPUAPI				(NULL),
+	mDirectCPUAPI				(NULL),
 #if PX_SUPPORT_PVD
 	mScenePvdClient				(*this),
 #endif
@@ -269,6 +271,7 @@ NpScene::~NpScene()
 	mScene.release();
 
 	PX_DELETE(mDirectGPUAPI);
+	PX_DELETE(mDirectCPUAPI);
 
 	// unlock the lock taken in release(), must unlock before 
 	// mRWLock is destroyed otherwise behavior is undefined
@@ -1946,14 +1949,21 @@ void NpScene::removeAggregate(PxAggregate& aggregate, bool wakeOnLostTouch)
 	if(!removeFromSceneCheck(this, aggregate.getScene(), "PxScene::removeAggregate(): Aggregate"))
 		return;
 
-	NpAggregate& np = static_cast<NpAggregate&>(aggregate);
-	if(np.getScene()!=this)
+	if(aggregate.getScene()!=this)
 		return;
 
+	removeAggregateInternal(aggregate, wakeOnLostTouch, false);
+}
+
+void NpScene::removeAggregateInternal(PxAggregate& aggregate, bool wakeOnLostTouch, bool reverseOrder)
+{
+	NpAggregate& np = static_cast<NpAggregate&>(aggregate);
+	PX_ASSERT(np.getScene()==this);
+
 	const PxU32 nb = np.getCurrentSizeFast();
 	for(PxU32 j=0;j<nb;j++)
 	{
-		PxActor* a = np.getActorFast(j);
+		PxActor* a = np.getActorFast(reverseOrder ? nb - 1 - j : j);
 		PX_ASSERT(a);
 
 		if (a->getType() != PxActorType::eARTICULATION_LINK)
@@ -2324,6 +2334,23 @@ void NpScene::getSimulationStatistics(PxSimulationStatistics& s) const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void NpScene::getPipelineStatistics(PxPipelineStatistics& s) const
+{
+	NP_READ_CHECK(this);
+
+	if (getSimulationStage() == Sc::SimulationStage::eCOMPLETE)
+	{
+		mScene.getPipelineStatistics(s);
+	}
+	else
+	{
+		//will be reading data that is getting written during the sim, hence, avoid call while simulation is running.
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::getPipelineStatistics() not allowed while simulation is running. Call will be ignored.");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 PxClientID NpScene::createClient()
 {
 	NP_WRITE_CHECK(this);
@@ -2828,6 +2855,8 @@ bool NpScene::simulateOrCollide(PxReal elapsedTime, PxBaseTask* completionTask,
 	
 		PX_CHECK_AND_RETURN_VAL((scratchBlockSize&16383) == 0, "PxScene::simulate: scratch block size must be a multiple of 16K", false);
 	
+		mScene.beginPipelineStep();
+
 #if PX_SUPPORT_PVD		
 		//signal the frame is starting.	
 		mScenePvdClient.frameStart(elapsedTime);
@@ -3754,6 +3783,25 @@ PxDirectGPUAPI& NpScene::getDirectGPUAPI()
 #endif
 }
 
+PxDirectCPUAPI& NpScene::getDirectCPUAPI()
+{
+	if (!mDirectCPUAPI)
+		mDirectCPUAPI = PX_NEW(NpDirectCPUAPI)(*this);
+
+	return *mDirectCPUAPI;
+}
+
+PxSceneSnapshot* NpScene::createSnapshot()
+{
+	if(getFlagsFast() & (PxSceneFlag::eENABLE_GPU_DYNAMICS | PxSceneFlag::eENABLE_DIRECT_GPU_API))
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::createSnapshot(): snapshots are not supported with PxSceneFlag::eENABLE_GPU_DYNAMICS or PxSceneFlag::eENABLE_DIRECT_GPU_API.");
+		return NULL;
+	}
+
+	return PX_NEW(NpSceneSnapshot)(*this);
+}
+
 PxsSimulationController* NpScene::getSimulationController()
 {
 	return mScene.getSimulationController();
@@ -49,6 +49,7 @@
 #include "NpSceneAccessor.h"
 #include "NpPruningStructure.h"
 #include "NpDirectGPUAPI.h"
+#include "NpDirectCPUAPI.h"
 
 #if PX_SUPPORT_PVD
 	#include "PxPhysics.h"
@@ -211,6 +212,7 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 
 	// Run
 	virtual			void							getSimulationStatistics(PxSimulationStatistics& s) const	PX_OVERRIDE PX_FINAL;
+	virtual			void							getPipelineStatistics(PxPipelineStatistics& s) const	PX_OVERRIDE PX_FINAL;
 	virtual			PxSceneResidual					getSolverResidual() const PX_OVERRIDE PX_FINAL { return mScene.getSolverResidual(); }
 
 	// Multiclient 
@@ -324,6 +326,8 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			PxSolverType::Enum				getSolverType()	const	PX_OVERRIDE PX_FINAL;
 
 	virtual 		PxDirectGPUAPI&					getDirectGPUAPI()	PX_OVERRIDE	PX_FINAL;
+	virtual			PxDirectCPUAPI&					getDirectCPUAPI()	PX_OVERRIDE	PX_FINAL;
+	virtual			PxSceneSnapshot*				createSnapshot()	PX_OVERRIDE	PX_FINAL;
 
 	// NpSceneAccessor
 	virtual			PxsSimulationController*		getSimulationController()	PX_OVERRIDE PX_FINAL;
@@ -348,6 +352,12 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
 
+	virtual			PxU32							raycastPacket(
+														PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,	// Ray data
+														PxRaycastBuffer* hitBuffers, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
+
 	virtual			bool							sweep(
 														const PxGeometry& geometry, const PxTransform& pose,	// GeomObject data
 														const PxVec3& unitDir, const PxReal distance,	// Ray data
@@ -393,6 +403,8 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 
 					bool							addArticulationInternal(PxArticulationReducedCoordinate&);
 					void							removeArticulationInternal(PxArticulationReducedCoordinate&, bool wakeOnLostTouch, bool removeFromAggregate);
+					// PT: reverseOrder removes the objects of the aggregate in reverse order, so that they get the same internal handles back when the aggregate is added again
+					void							removeAggregateInternal(PxAggregate& aggregate, bool wakeOnLostTouch, bool reverseOrder);
 	// materials
 					void							addMaterial(const NpMaterial& mat);
 					void							updateMaterial(const NpMaterial& mat);
@@ -500,6 +512,11 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	PX_FORCE_INLINE	Sc::Scene&						getScScene()								{ return mScene;					}
 
 	PX_FORCE_INLINE	PxSceneFlags					getFlagsFast()						const	{ return mScene.getFlags();			}
+	PX_FORCE_INLINE	const PxArray<NpRigidDynamic*>&	getRigidDynamicsFast()				const	{ return mRigidDynamics;			}
+	PX_FORCE_INLINE	PxArticulationReducedCoordinate*const*	getArticulationsFast()		const	{ return mArticulations.getEntries();	}
+	PX_FORCE_INLINE	PxU32							getNbArticulationsFast()			const	{ return mArticulations.size();		}
+	PX_FORCE_INLINE	PxAggregate*const*				getAggregatesFast()					const	{ return mAggregates.getEntries();	}
+	PX_FORCE_INLINE	PxU32							getNbAggregatesFast()				const	{ return mAggregates.size();		}
 	PX_FORCE_INLINE PxReal							getWakeCounterResetValueInternal()	const	{ return mWakeCounterResetValue;	}
 
 	PX_FORCE_INLINE bool							isDirectGPUAPIInitialized()				 	{ return mScene.isDirectGPUAPIInitialized(); }
@@ -746,6 +763,7 @@ private:
 					PxArray<MaterialEvent>		mScenePBDMaterialBuffer;
 					Sc::Scene					mScene;
 					NpDirectGPUAPI*				mDirectGPUAPI;
+					NpDirectCPUAPI*				mDirectCPUAPI;
 #if PX_SUPPORT_PVD
 					Vd::PvdSceneClient			mScenePvdClient;
 #endif
@@ -225,6 +225,8 @@ void NpScene::fetchResultsPostContactCallbacks()
 
 	mPhysicsDone.reset();				// allow Physics to run again
 	mCollisionDone.reset();
+
+	mScene.endPipelineStep();
 }
 
 bool NpScene::fetchResults(bool block, PxU32* errorState)
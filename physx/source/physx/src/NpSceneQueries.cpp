@@ -384,6 +384,14 @@ namespace
 			return mQueries._raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
 		}
 
+		virtual		PxU32				raycastPacket(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+														PxRaycastBuffer* hitBuffers, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const
+		{
+			return mQueries._raycastPacket(nbRays, origins, unitDirs, distances, hitBuffers, hitFlags, filterData, filterCall, flags);
+		}
+
 		virtual		bool				sweep(	const PxGeometry& geometry, const PxTransform& pose,
 												const PxVec3& unitDir, const PxReal distance,
 												PxSweepCallback& hitCall, PxHitFlags hitFlags,
@@ -544,6 +552,15 @@ bool NpScene::raycast(
 	return mNpSQ.mSQ->raycast(origin, unitDir, distance, hits, hitFlags, filterData, filterCall, cache, flags);
 }
 
+PxU32 NpScene::raycastPacket(
+	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+	PxRaycastBuffer* hitBuffers, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	PxGeometryQueryFlags flags) const
+{
+	NP_READ_CHECK(this);
+	return mNpSQ.mSQ->raycastPacket(nbRays, origins, unitDirs, distances, hitBuffers, hitFlags, filterData, filterCall, flags);
+}
+
 bool NpScene::overlap(
 	const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hits,
 	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
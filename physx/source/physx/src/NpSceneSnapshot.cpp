@@ -0,0 +1,434 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#include "NpSceneSnapshot.h"
+#include "NpScene.h"
+#include "NpRigidDynamic.h"
+#include "NpArticulationReducedCoordinate.h"
+#include "NpArticulationLink.h"
+#include "NpBase.h"
+#include "NpCheck.h"
+#include "foundation/PxHashSet.h"
+
+using namespace physx;
+
+PX_IMPLEMENT_OUTPUT_ERROR
+
+NpSceneSnapshot::NpSceneSnapshot(NpScene& scene) :
+	mScene				(scene),
+	mBase				(NULL),
+	mIsCaptured			(false),
+	mCaptureCount		(0),
+	mBaseCaptureCount	(0)
+{
+}
+
+void NpSceneSnapshot::release()
+{
+	PX_DELETE_THIS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE PxU32 getArticulationStateSize(const NpArticulationReducedCoordinate& articulation)
+{
+	return NP_ARTICULATION_STATE_HEADER_SIZE + articulation.getCore().getDofs() * 2;
+}
+
+static void getArticulationState(const NpArticulationReducedCoordinate& articulation, PxReal* state)
+{
+	const Sc::ArticulationCore& core = articulation.getCore();
+
+	const PxsBodyCore& rootCore = articulation.getLinks()[0]->getCore().getCore();
+	PxMemCopy(state, &rootCore.body2World, sizeof(PxTransform));
+	PxMemCopy(state + 7, &rootCore.linearVelocity, sizeof(PxVec3));
+	PxMemCopy(state + 10, &rootCore.angularVelocity, sizeof(PxVec3));
+	state[13] = core.getWakeCounter();
+	state[14] = core.isSleeping() ? 1.0f : 0.0f;
+
+	PxArticulationCache cache;
+	cache.jointPosition = state + NP_ARTICULATION_STATE_HEADER_SIZE;
+	cache.jointVelocity = cache.jointPosition + core.getDofs();
+	core.copyInternalStateToCache(cache, PxArticulationCacheFlag::ePOSITION | PxArticulationCacheFlag::eVELOCITY, false);
+}
+
+static void setArticulationState(NpArticulationReducedCoordinate& articulation, const PxReal* state)
+{
+	// PT: the root pose is written to the root link directly, since going through the cache would
+	// convert it to an actor pose and back. Applying the joint positions then updates the other links.
+	PxTransform rootPose;
+	PxMemCopy(&rootPose, state, sizeof(PxTransform));
+	NpArticulationLink* const* links = articulation.getLinks();
+	links[0]->scSetBody2World(rootPose);
+
+	PxArticulationRootLinkData rootLinkData;
+	PxMemCopy(&rootLinkData.worldLinVel, state + 7, sizeof(PxVec3));
+	PxMemCopy(&rootLinkData.worldAngVel, state + 10, sizeof(PxVec3));
+
+	PxArticulationCache cache;
+	cache.rootLinkData = &rootLinkData;
+	cache.jointPosition = const_cast<PxReal*>(state + NP_ARTICULATION_STATE_HEADER_SIZE);
+	cache.jointVelocity = cache.jointPosition + articulation.getCore().getDofs();
+	articulation.applyCacheInternal(cache, PxArticulationCacheFlag::ePOSITION | PxArticulationCacheFlag::eVELOCITY | PxArticulationCacheFlag::eROOT_VELOCITIES, false);
+
+	const PxU32 nbLinks = articulation.getNbLinks();
+	if(state[14] != 0.0f)
+	{
+		for(PxU32 i=0;i<nbLinks;i++)
+			links[i]->scPutToSleepInternal();
+		articulation.getCore().putToSleep();
+	}
+	else
+	{
+		const PxReal wakeCounter = state[13];
+		for(PxU32 i=0;i<nbLinks;i++)
+			links[i]->scWakeUpInternal(wakeCounter);
+		articulation.scWakeUpInternal(wakeCounter);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// PT: the objects are usually in the same order as when the snapshot was captured, so they are compared bitwise first. Reproducible
+// restores of scenes with aggregates change that order, in which case we check that the scene contains all the recorded objects.
+// The recorded pointers are not dereferenced, since the objects may have been released.
+static bool containsSameObjects(const void* const* sceneObjects, const void* const* recordedObjects, PxU32 nbObjects)
+{
+	if(!isBitwiseDifferent(sceneObjects, recordedObjects, nbObjects * sizeof(void*)))
+		return true;
+
+	PxHashSet<const void*> objects;
+	objects.reserve(nbObjects);
+	for(PxU32 i=0;i<nbObjects;i++)
+		objects.insert(sceneObjects[i]);
+
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		if(!objects.contains(recordedObjects[i]))
+			return false;
+	}
+	return true;
+}
+
+bool NpSceneSnapshot::checkObjects(const char* functionName) const
+{
+	PX_ASSERT(!mBase);
+
+	const PxArray<NpRigidDynamic*>& bodies = mScene.getRigidDynamicsFast();
+	const PxU32 nbBodies = bodies.size();
+	const PxU32 nbArticulations = mScene.getNbArticulationsFast();
+	const PxU32 nbAggregates = mScene.getNbAggregatesFast();
+	bool isValid = nbBodies == mBodies.size() && nbArticulations == mArticulations.size() && nbAggregates == mAggregates.size();
+	if(isValid)
+		isValid = containsSameObjects(reinterpret_cast<const void* const*>(bodies.begin()), reinterpret_cast<const void* const*>(mBodies.begin()), nbBodies);
+	if(isValid)
+		isValid = containsSameObjects(reinterpret_cast<const void* const*>(mScene.getArticulationsFast()), reinterpret_cast<const void* const*>(mArticulations.begin()), nbArticulations);
+	if(isValid)
+		isValid = containsSameObjects(reinterpret_cast<const void* const*>(mScene.getAggregatesFast()), reinterpret_cast<const void* const*>(mAggregates.begin()), nbAggregates);
+
+	if(!isValid)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "%s: rigid dynamics, articulations or aggregates have been added to or removed from the scene since the full snapshot was captured.", functionName);
+	return true;
+}
+
+// PT: the contact pairs, the island graph edges and the broadphase pairs of the recorded objects depend on the history of the
+// scene, and they decide the order in which the solver processes the constraints. Taking the objects out of the scene and adding
+// them back in a fixed order recreates all of them from scratch, so the next simulation steps only depend on the restored state.
+// Objects in aggregates are reinserted with their aggregate. The lost touch reports of the released pairs are not sent, since
+// the objects are back in the scene before the next simulation step.
+void NpSceneSnapshot::reinsertObjects() const
+{
+	PX_ASSERT(!mBase);
+
+	const PxU32 nbBodies = mBodies.size();
+	const PxU32 nbArticulations = mArticulations.size();
+	const PxU32 nbAggregates = mAggregates.size();
+
+	mScene.getScScene().setRemovalReportsEnabled(false);
+
+	// PT: objects are removed in reverse order, so that they get their internal handles back when added again
+	for(PxU32 i=nbAggregates;i--;)
+		mScene.removeAggregateInternal(*mAggregates[i], false, true);
+	for(PxU32 i=nbArticulations;i--;)
+	{
+		if(!mArticulations[i]->getAggregate())
+			mScene.removeArticulationInternal(*mArticulations[i], false, false);
+	}
+	for(PxU32 i=nbBodies;i--;)
+	{
+		if(!mBodies[i]->getAggregate())
+			mScene.removeActorInternal(*mBodies[i], false, false);
+	}
+
+	mScene.getScScene().setRemovalReportsEnabled(true);
+
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		if(!mBodies[i]->getAggregate())
+			mScene.addActorInternal(*mBodies[i], NULL);
+	}
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		if(!mArticulations[i]->getAggregate())
+			mScene.addArticulationInternal(*mArticulations[i]);
+	}
+	for(PxU32 i=0;i<nbAggregates;i++)
+		mScene.addAggregate(*mAggregates[i]);
+
+	PX_ASSERT(checkObjects("PxSceneSnapshot::restore()"));
+}
+
+void NpSceneSnapshot::captureFull()
+{
+	const PxArray<NpRigidDynamic*>& bodies = mScene.getRigidDynamicsFast();
+	const PxU32 nbBodies = bodies.size();
+
+	mBodies.resizeUninitialized(nbBodies);
+	PxMemCopy(mBodies.begin(), bodies.begin(), nbBodies * sizeof(NpRigidDynamic*));
+
+	mBodyStates.resizeUninitialized(nbBodies);
+	for(PxU32 i=0;i<nbBodies;i++)
+		bodies[i]->getSnapshotState(mBodyStates[i]);
+	mBodyIndices.clear();
+
+	const PxU32 nbArticulations = mScene.getNbArticulationsFast();
+	PxArticulationReducedCoordinate* const* articulations = mScene.getArticulationsFast();
+
+	mArticulations.resizeUninitialized(nbArticulations);
+	PxMemCopy(mArticulations.begin(), articulations, nbArticulations * sizeof(PxArticulationReducedCoordinate*));
+
+	const PxU32 nbAggregates = mScene.getNbAggregatesFast();
+	mAggregates.resizeUninitialized(nbAggregates);
+	PxMemCopy(mAggregates.begin(), mScene.getAggregatesFast(), nbAggregates * sizeof(PxAggregate*));
+
+	mArticulationOffsets.resizeUninitialized(nbArticulations + 1);
+	PxU32 offset = 0;
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		mArticulationOffsets[i] = offset;
+		offset += getArticulationStateSize(*static_cast<NpArticulationReducedCoordinate*>(articulations[i]));
+	}
+	mArticulationOffsets[nbArticulations] = offset;
+
+	mArticulationStates.resizeUninitialized(offset);
+	for(PxU32 i=0;i<nbArticulations;i++)
+		getArticulationState(*static_cast<NpArticulationReducedCoordinate*>(articulations[i]), mArticulationStates.begin() + mArticulationOffsets[i]);
+	mArticulationIndices.clear();
+}
+
+void NpSceneSnapshot::captureDelta()
+{
+	PX_ASSERT(mBase);
+
+	// PT: delta snapshots use the object lists of their base
+	mBodies.clear();
+	mArticulations.clear();
+	mAggregates.clear();
+	mArticulationOffsets.clear();
+
+	mBodyStates.clear();
+	mBodyIndices.clear();
+	const PxU32 nbBodies = mBase->mBodies.size();
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		NpRigidDynamicState state;
+		mBase->mBodies[i]->getSnapshotState(state);
+		if(isBitwiseDifferent(&state, &mBase->mBodyStates[i], sizeof(NpRigidDynamicState)))
+		{
+			mBodyStates.pushBack(state);
+			mBodyIndices.pushBack(i);
+		}
+	}
+
+	mArticulationStates.clear();
+	mArticulationIndices.clear();
+	const PxU32 nbArticulations = mBase->mArticulations.size();
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		const PxU32 offset = mBase->mArticulationOffsets[i];
+		const PxU32 size = mBase->mArticulationOffsets[i+1] - offset;
+		mArticulationScratch.resizeUninitialized(size);
+		getArticulationState(*static_cast<NpArticulationReducedCoordinate*>(mBase->mArticulations[i]), mArticulationScratch.begin());
+		if(isBitwiseDifferent(mArticulationScratch.begin(), mBase->mArticulationStates.begin() + offset, size * sizeof(PxReal)))
+		{
+			const PxU32 start = mArticulationStates.size();
+			mArticulationStates.resizeUninitialized(start + size);
+			PxMemCopy(mArticulationStates.begin() + start, mArticulationScratch.begin(), size * sizeof(PxReal));
+			mArticulationIndices.pushBack(i);
+		}
+	}
+}
+
+bool NpSceneSnapshot::capture(const PxSceneSnapshot* baseSnapshot)
+{
+	NP_READ_CHECK(&mScene);
+
+	if(mScene.isAPIWriteForbidden())
+		return NP_API_READ_WRITE_ERROR_MSG("PxSceneSnapshot::capture(): not allowed while simulation is running. Call will be ignored.");
+
+	const NpSceneSnapshot* base = static_cast<const NpSceneSnapshot*>(baseSnapshot);
+	if(base)
+	{
+		if(base == this)
+			return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxSceneSnapshot::capture(): a snapshot cannot be its own base.");
+
+		if(&base->mScene != &mScene)
+			return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxSceneSnapshot::capture(): the base snapshot belongs to another scene.");
+
+		if(base->mBase || !base->mIsCaptured)
+			return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxSceneSnapshot::capture(): the base must be a captured full snapshot.");
+
+		if(!base->checkObjects("PxSceneSnapshot::capture()"))
+			return false;
+	}
+
+	// PT: deltas captured against the previous content of this snapshot are invalidated by the new capture
+	mCaptureCount++;
+	mBase = base;
+	mIsCaptured = true;
+
+	if(base)
+	{
+		mBaseCaptureCount = base->mCaptureCount;
+		captureDelta();
+	}
+	else
+		captureFull();
+
+	return true;
+}
+
+bool NpSceneSnapshot::restore(bool reproducible)
+{
+	NP_WRITE_CHECK(&mScene);
+
+	if(mScene.isAPIWriteForbidden())
+		return NP_API_READ_WRITE_ERROR_MSG("PxSceneSnapshot::restore(): not allowed while simulation is running. Call will be ignored.");
+
+	if(!mIsCaptured)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxSceneSnapshot::restore(): the snapshot has not been captured.");
+
+	if(mBase && mBase->mCaptureCount != mBaseCaptureCount)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxSceneSnapshot::restore(): the base snapshot has been captured again since this delta was captured.");
+
+	const NpSceneSnapshot& full = mBase ? *mBase : *this;
+	if(!full.checkObjects("PxSceneSnapshot::restore()"))
+		return false;
+
+	if(reproducible)
+		full.reinsertObjects();
+
+	// PT: for delta snapshots the stored records are sorted by index, the others come from the base
+	{
+		const PxU32 nbBodies = full.mBodies.size();
+		const PxU32 nbStored = mBodyIndices.size();
+		PxU32 stored = 0;
+		for(PxU32 i=0;i<nbBodies;i++)
+		{
+			const NpRigidDynamicState* state;
+			if(stored<nbStored && mBodyIndices[stored]==i)
+				state = &mBodyStates[stored++];
+			else
+				state = &full.mBodyStates[i];
+
+			NpRigidDynamic* body = full.mBodies[i];
+			if(!reproducible)
+			{
+				NpRigidDynamicState current;
+				body->getSnapshotState(current);
+				if(!isBitwiseDifferent(&current, state, sizeof(NpRigidDynamicState)))
+					continue;
+			}
+			body->setSnapshotState(*state, reproducible);
+		}
+	}
+
+	{
+		const PxU32 nbArticulations = full.mArticulations.size();
+		const PxU32 nbStored = mArticulationIndices.size();
+		PxU32 stored = 0;
+		PxU32 storedOffset = 0;
+		for(PxU32 i=0;i<nbArticulations;i++)
+		{
+			const PxU32 size = full.mArticulationOffsets[i+1] - full.mArticulationOffsets[i];
+
+			const PxReal* state;
+			if(stored<nbStored && mArticulationIndices[stored]==i)
+			{
+				state = mArticulationStates.begin() + storedOffset;
+				storedOffset += size;
+				stored++;
+			}
+			else
+				state = full.mArticulationStates.begin() + full.mArticulationOffsets[i];
+
+			NpArticulationReducedCoordinate* articulation = static_cast<NpArticulationReducedCoordinate*>(full.mArticulations[i]);
+			if(!reproducible)
+			{
+				mArticulationScratch.resizeUninitialized(size);
+				getArticulationState(*articulation, mArticulationScratch.begin());
+				if(!isBitwiseDifferent(mArticulationScratch.begin(), state, size * sizeof(PxReal)))
+					continue;
+			}
+			setArticulationState(*articulation, state);
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxU32 NpSceneSnapshot::getNbRigidDynamics() const
+{
+	return (mBase ? mBase : this)->mBodies.size();
+}
+
+PxU32 NpSceneSnapshot::getNbArticulations() const
+{
+	return (mBase ? mBase : this)->mArticulations.size();
+}
+
+PxU32 NpSceneSnapshot::getNbStoredArticulations() const
+{
+	return mBase ? mArticulationIndices.size() : mArticulations.size();
+}
+
+PxU32 NpSceneSnapshot::getMemoryUsage() const
+{
+	return sizeof(NpSceneSnapshot)
+		+ mBodies.capacity() * sizeof(NpRigidDynamic*)
+		+ mArticulations.capacity() * sizeof(PxArticulationReducedCoordinate*)
+		+ mAggregates.capacity() * sizeof(PxAggregate*)
+		+ mArticulationOffsets.capacity() * sizeof(PxU32)
+		+ mBodyStates.capacity() * sizeof(NpRigidDynamicState)
+		+ mBodyIndices.capacity() * sizeof(PxU32)
+		+ mArticulationStates.capacity() * sizeof(PxReal)
+		+ mArticulationIndices.capacity() * sizeof(PxU32)
+		+ mArticulationScratch.capacity() * sizeof(PxReal);
+}
@@ -0,0 +1,129 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef NP_SCENE_SNAPSHOT_H
+#define NP_SCENE_SNAPSHOT_H
+
+#include "PxSceneSnapshot.h"
+#include "foundation/PxTransform.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
+
+namespace physx
+{
+
+class NpScene;
+class NpRigidDynamic;
+class PxArticulationReducedCoordinate;
+class PxAggregate;
+
+// PT: complete state of a rigid dynamic. Snapshots compare these records bitwise, so the padding must stay zeroed.
+struct NpRigidDynamicState
+{
+	PxTransform	body2World;			//28
+	PxReal		wakeCounter;		//32
+	PxVec3		linearVelocity;		//44
+	PxReal		freezeCount;		//48
+	PxVec3		angularVelocity;	//60
+	PxReal		accelScale;			//64
+	PxVec3		sleepLinVelAcc;		//76
+	PxU32		isSleeping;			//80
+	PxVec3		sleepAngVelAcc;		//92
+	PxU32		pad;				//96
+};
+PX_COMPILE_TIME_ASSERT(sizeof(NpRigidDynamicState) == 96);
+
+// PT: snapshots compare states bitwise, so that restoring is exact even for -0.0f or NaNs. Sizes are multiples of 4.
+PX_FORCE_INLINE bool isBitwiseDifferent(const void* a, const void* b, PxU32 nbBytes)
+{
+	const PxU32* wordsA = reinterpret_cast<const PxU32*>(a);
+	const PxU32* wordsB = reinterpret_cast<const PxU32*>(b);
+	const PxU32 nbWords = nbBytes/sizeof(PxU32);
+	for(PxU32 i=0;i<nbWords;i++)
+	{
+		if(wordsA[i]!=wordsB[i])
+			return true;
+	}
+	return false;
+}
+
+// PT: articulation records are stored as PxReals: root body pose (7), root linear and angular velocities (3+3),
+// wake counter, sleep state, then the joint positions and the joint velocities (dofs each).
+#define NP_ARTICULATION_STATE_HEADER_SIZE	15
+
+class NpSceneSnapshot : public PxSceneSnapshot, public PxUserAllocated
+{
+public:
+										NpSceneSnapshot(NpScene& scene);
+	virtual								~NpSceneSnapshot()	{}
+
+	// PxSceneSnapshot
+	virtual	bool						capture(const PxSceneSnapshot* base)	PX_OVERRIDE	PX_FINAL;
+	virtual	bool						restore(bool reproducible)				PX_OVERRIDE	PX_FINAL;
+	virtual	const PxSceneSnapshot*		getBase()						const	PX_OVERRIDE	PX_FINAL	{ return mBase;	}
+	virtual	PxU32						getNbRigidDynamics()			const	PX_OVERRIDE	PX_FINAL;
+	virtual	PxU32						getNbStoredRigidDynamics()		const	PX_OVERRIDE	PX_FINAL	{ return mBodyStates.size();	}
+	virtual	PxU32						getNbArticulations()			const	PX_OVERRIDE	PX_FINAL;
+	virtual	PxU32						getNbStoredArticulations()		const	PX_OVERRIDE	PX_FINAL;
+	virtual	PxU32						getMemoryUsage()				const	PX_OVERRIDE	PX_FINAL;
+	virtual	void						release()								PX_OVERRIDE	PX_FINAL;
+	//~PxSceneSnapshot
+
+private:
+			bool						checkObjects(const char* functionName)	const;
+			void						reinsertObjects()						const;
+			void						captureFull();
+			void						captureDelta();
+
+			NpScene&					mScene;
+			const NpSceneSnapshot*		mBase;			// NULL for full snapshots
+			bool						mIsCaptured;
+			PxU32						mCaptureCount;	// incremented by each capture, so that deltas can detect a recaptured base
+			PxU32						mBaseCaptureCount;
+
+			// PT: objects covered by the snapshot, in scene order. Only used by full snapshots.
+			PxArray<NpRigidDynamic*>					mBodies;
+			PxArray<PxArticulationReducedCoordinate*>	mArticulations;
+			PxArray<PxAggregate*>						mAggregates;			// PT: reinserted as a whole by reproducible restores
+			PxArray<PxU32>								mArticulationOffsets;	// offsets of the records in mArticulationStates, plus the end offset
+
+			// PT: full snapshots store one record per object. Delta snapshots store the records of the changed objects,
+			// with their indices in the base snapshot.
+			PxArray<NpRigidDynamicState>				mBodyStates;
+			PxArray<PxU32>								mBodyIndices;
+			PxArray<PxReal>								mArticulationStates;
+			PxArray<PxU32>								mArticulationIndices;
+
+			// PT: scratch buffer for the current state of an articulation
+			PxArray<PxReal>								mArticulationScratch;
+};
+
+}
+
+#endif
@@ -51,6 +51,10 @@ OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eENABLE_ENHANCED_DETERMINISM)
 OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eENABLE_FRICTION_EVERY_ITERATION)
 OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eENABLE_DIRECT_GPU_API)
 OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eSOLVE_ARTICULATION_CONTACT_LAST)
+OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eENABLE_PIPELINE_STATISTICS)
+OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eENABLE_CRITICAL_PATH_SCHEDULING)
+OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eENABLE_RESTING_CONTACT_CACHE)
+OMNI_PVD_ENUM_VALUE		(PxSceneFlag, eDISABLE_WIDE_SOLVER_BATCHES)
 
 OMNI_PVD_ENUM_END		(PxSceneFlag)
 
@@ -129,6 +133,7 @@ OMNI_PVD_ENUM_VALUE		(PxBroadPhaseType, eSAP)
 OMNI_PVD_ENUM_VALUE		(PxBroadPhaseType, eMBP)
 OMNI_PVD_ENUM_VALUE		(PxBroadPhaseType, eABP)
 OMNI_PVD_ENUM_VALUE		(PxBroadPhaseType, eGPU)
+OMNI_PVD_ENUM_VALUE		(PxBroadPhaseType, eHGRID)
 OMNI_PVD_ENUM_END		(PxBroadPhaseType)
 
 OMNI_PVD_ENUM_BEGIN		(PxSolverType)
@@ -88,6 +88,16 @@ PxConvexMesh* PxCreateConvexMesh(const PxCookingParams& params, const PxConvexMe
 	return immediateCooking::createConvexMesh(params, desc, insertionCallback, condition);
 }
 
+bool PxCookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::cookConvexMeshes(params, nbMeshes, descs, streams, conditions);
+}
+
+bool PxCreateConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxInsertionCallback& insertionCallback, PxConvexMesh** meshes, PxConvexMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::createConvexMeshes(params, nbMeshes, descs, insertionCallback, meshes, conditions);
+}
+
 bool PxValidateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	return immediateCooking::validateConvexMesh(params, desc);
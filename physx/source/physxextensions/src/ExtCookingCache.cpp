@@ -0,0 +1,865 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxHashMap.h"
+#include "foundation/PxHashSet.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxString.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxUtilities.h"
+#include "foundation/PxPhysicsVersion.h"
+#include "extensions/PxCookingCache.h"
+#include "extensions/PxDefaultStreams.h"
+#include "cooking/PxConvexMeshDesc.h"
+#include "cooking/PxTriangleMeshDesc.h"
+#include "geometry/PxConvexMesh.h"
+#include "PxPhysics.h"
+
+#include "SnFile.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace physx;
+
+namespace
+{
+	// Bump this when the layout of the entry or index files changes, or when the key computation changes.
+	const PxU32 gCacheVersion = 1;
+	const PxU32 gEntryMagic = PxU32('P') | (PxU32('X')<<8) | (PxU32('C')<<16) | (PxU32('E')<<24);
+	const PxU32 gIndexMagic = PxU32('P') | (PxU32('X')<<8) | (PxU32('C')<<16) | (PxU32('I')<<24);
+	const PxU32 gMaxPathLength = 512;
+	const PxU32 gMaxDirectoryLength = gMaxPathLength - 64;
+
+	struct CacheKey
+	{
+		PxU64	mHash0;
+		PxU64	mHash1;
+	};
+
+	struct CacheKeyHash
+	{
+		PX_FORCE_INLINE PxU32 operator()(const CacheKey& key)	const	{ return PxComputeHash(key.mHash0);	}
+		PX_FORCE_INLINE bool equal(const CacheKey& key0, const CacheKey& key1)	const	{ return key0.mHash0==key1.mHash0 && key0.mHash1==key1.mHash1;	}
+	};
+
+	// Header of an entry file, followed by the cooked data
+	struct EntryHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU64	mHash0;
+		PxU64	mHash1;
+		PxU64	mDataHash;
+		PxU32	mDataSize;
+		PxU32	mCondition;
+	};
+
+	// Header of the index file, followed by mNbEntries IndexEntry
+	struct IndexHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mNbEntries;
+		PxU32	mPad;
+		PxU64	mUseCounter;
+	};
+
+	struct IndexEntry
+	{
+		PxU64	mHash0;
+		PxU64	mHash1;
+		PxU64	mSize;
+		PxU64	mLastUse;
+	};
+
+	PX_FORCE_INLINE PxU64 finalMix(PxU64 k)
+	{
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdULL;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53ULL;
+		k ^= k >> 33;
+		return k;
+	}
+
+	// 128-bit streaming hash made of two independent lanes over 8-byte words. The result does not depend on how the
+	// input is split into addBytes() calls.
+	class ContentHasher
+	{
+	public:
+		ContentHasher() : mHash0(0x9e3779b97f4a7c15ULL), mHash1(0xc2b2ae3d27d4eb4fULL), mPending(0), mNbPending(0), mLength(0)	{}
+
+		void addBytes(const void* data, PxU32 size)
+		{
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			mLength += size;
+
+			while(size && mNbPending)
+			{
+				mPending |= PxU64(*bytes++) << (mNbPending*8);
+				size--;
+				if(++mNbPending==8)
+				{
+					addWord(mPending);
+					mPending = 0;
+					mNbPending = 0;
+				}
+			}
+
+			while(size>=8)
+			{
+				PxU64 word;
+				PxMemCopy(&word, bytes, 8);
+				addWord(word);
+				bytes += 8;
+				size -= 8;
+			}
+
+			while(size--)
+				mPending |= PxU64(*bytes++) << (mNbPending++*8);
+		}
+
+		template<class T>
+		PX_FORCE_INLINE void add(T value)
+		{
+			addBytes(&value, sizeof(T));
+		}
+
+		void addBoundedData(const void* data, PxU32 count, PxU32 stride, PxU32 elementSize)
+		{
+			add(count);
+			add(PxU8(data ? 1 : 0));
+			if(!data)
+				return;
+
+			if(!stride)
+				stride = elementSize;
+
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			if(stride==elementSize && PxU64(count)*elementSize<0x80000000)
+			{
+				addBytes(bytes, count*elementSize);
+			}
+			else
+			{
+				for(PxU32 i=0;i<count;i++)
+					addBytes(bytes + size_t(i)*stride, elementSize);
+			}
+		}
+
+		CacheKey finalize()
+		{
+			if(mNbPending)
+				addWord(mPending);
+			addWord(mLength);
+
+			CacheKey key;
+			key.mHash0 = finalMix(mHash0);
+			key.mHash1 = finalMix(mHash1);
+			return key;
+		}
+
+	private:
+		PX_FORCE_INLINE void addWord(PxU64 k)
+		{
+			const PxU64 m = 0xc6a4a7935bd1e995ULL;
+			k *= m;
+			k ^= k >> 47;
+			k *= m;
+
+			mHash0 ^= k;
+			mHash0 *= m;
+
+			mHash1 ^= (k << 31) | (k >> 33);
+			mHash1 = mHash1 * 0x9fb21c651e98df25ULL + 0x165667b19e3779f9ULL;
+		}
+
+		PxU64	mHash0;
+		PxU64	mHash1;
+		PxU64	mPending;
+		PxU32	mNbPending;
+		PxU64	mLength;
+	};
+
+	PxU64 computeDataHash(const void* data, PxU32 size)
+	{
+		ContentHasher hasher;
+		hasher.addBytes(data, size);
+		return hasher.finalize().mHash0;
+	}
+
+	// Everything that changes the cooked data goes into the key, except the CPU dispatcher which does not.
+	void hashCookingParams(ContentHasher& hasher, PxU32 meshType, const PxCookingParams& params)
+	{
+		hasher.add(gCacheVersion);
+		hasher.add(PxU32(PX_PHYSICS_VERSION));
+		hasher.add(PxU8(PxLittleEndian()));
+		hasher.add(PxU32(sizeof(void*)));
+		hasher.add(meshType);
+
+		hasher.add(params.areaTestEpsilon);
+		hasher.add(params.planeTolerance);
+		hasher.add(PxU32(params.convexMeshCookingType));
+		hasher.add(PxU8(params.suppressTriangleMeshRemapTable));
+		hasher.add(PxU8(params.buildTriangleAdjacencies));
+		hasher.add(PxU8(params.buildGPUData));
+		hasher.add(params.scale.length);
+		hasher.add(params.scale.speed);
+		hasher.add(PxU32(params.meshPreprocessParams));
+		hasher.add(params.meshWeldTolerance);
+		hasher.add(params.meshAreaMinLimit);
+		hasher.add(params.meshEdgeLengthMaxLimit);
+		hasher.add(params.gaussMapLimit);
+		hasher.add(params.maxWeightRatioInTet);
+
+		const PxMeshMidPhase::Enum midphase = params.midphaseDesc.getType();
+		hasher.add(PxU32(midphase));
+		if(midphase==PxMeshMidPhase::eBVH33)
+		{
+			hasher.add(params.midphaseDesc.mBVH33Desc.meshSizePerformanceTradeOff);
+			hasher.add(PxU32(params.midphaseDesc.mBVH33Desc.meshCookingHint));
+		}
+		else if(midphase==PxMeshMidPhase::eBVH34)
+		{
+			hasher.add(params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf);
+			hasher.add(PxU32(params.midphaseDesc.mBVH34Desc.buildStrategy));
+			hasher.add(PxU8(params.midphaseDesc.mBVH34Desc.quantized));
+		}
+	}
+
+	CacheKey computeKey(const PxCookingParams& params, const PxConvexMeshDesc& desc)
+	{
+		ContentHasher hasher;
+		hashCookingParams(hasher, 0, params);
+
+		hasher.add(PxU32(desc.flags));
+		hasher.add(desc.vertexLimit);
+		hasher.add(desc.polygonLimit);
+		hasher.add(desc.quantizedCount);
+		hasher.addBoundedData(desc.points.data, desc.points.count, desc.points.stride, sizeof(PxVec3));
+		hasher.addBoundedData(desc.polygons.data, desc.polygons.count, desc.polygons.stride, sizeof(PxHullPolygon));
+		const PxU32 indexSize = (desc.flags & PxConvexFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+		hasher.addBoundedData(desc.indices.data, desc.indices.count, desc.indices.stride, indexSize);
+		return hasher.finalize();
+	}
+
+	CacheKey computeKey(const PxCookingParams& params, const PxTriangleMeshDesc& desc)
+	{
+		ContentHasher hasher;
+		hashCookingParams(hasher, 1, params);
+
+		hasher.add(PxU32(desc.flags));
+		hasher.addBoundedData(desc.points.data, desc.points.count, desc.points.stride, sizeof(PxVec3));
+		const PxU32 triangleSize = (desc.flags & PxMeshFlag::e16_BIT_INDICES) ? sizeof(PxU16)*3 : sizeof(PxU32)*3;
+		hasher.addBoundedData(desc.triangles.data, desc.triangles.count, desc.triangles.stride, triangleSize);
+		// There is one material index per triangle, materialIndices.count is not used by the cooking code
+		hasher.addBoundedData(desc.materialIndices.data, desc.triangles.count, desc.materialIndices.stride, sizeof(PxMaterialTableIndex));
+		return hasher.finalize();
+	}
+
+	typedef bool (*CookCallback)(const PxCookingParams& params, const void* desc, PxOutputStream& stream, PxU32& condition);
+
+	bool cookConvexCallback(const PxCookingParams& params, const void* desc, PxOutputStream& stream, PxU32& condition)
+	{
+		PxConvexMeshCookingResult::Enum result = PxConvexMeshCookingResult::eSUCCESS;
+		const bool status = PxCookConvexMesh(params, *reinterpret_cast<const PxConvexMeshDesc*>(desc), stream, &result);
+		condition = PxU32(result);
+		return status;
+	}
+
+	bool cookTriangleCallback(const PxCookingParams& params, const void* desc, PxOutputStream& stream, PxU32& condition)
+	{
+		PxTriangleMeshCookingResult::Enum result = PxTriangleMeshCookingResult::eSUCCESS;
+		const bool status = PxCookTriangleMesh(params, *reinterpret_cast<const PxTriangleMeshDesc*>(desc), stream, &result);
+		condition = PxU32(result);
+		return status;
+	}
+
+	// Cooked data read from an entry file
+	struct CachedData
+	{
+		CachedData() : mData(NULL), mSize(0), mCondition(0)	{}
+		~CachedData()	{ PX_FREE(mData);	}
+
+		PxU8*	mData;
+		PxU32	mSize;
+		PxU32	mCondition;
+	};
+
+	class CookingCache : public PxCookingCache, public PxUserAllocated
+	{
+	public:
+										CookingCache(const char* directory, PxU64 maxSizeInBytes);
+		virtual							~CookingCache();
+
+		// PxCookingCache
+		virtual	bool					cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	PxConvexMesh*			createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxPhysics& physics, PxConvexMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	bool					cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	PxTriangleMesh*			createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxPhysics& physics, PxTriangleMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	void					getStats(PxCookingCacheStats& stats)	const	PX_OVERRIDE;
+		virtual	void					resetStats()	PX_OVERRIDE;
+		virtual	bool					flush()	PX_OVERRIDE;
+		virtual	void					clear()	PX_OVERRIDE;
+		virtual	void					release()	PX_OVERRIDE;
+		//~PxCookingCache
+
+				void					loadIndex();
+
+	private:
+		struct Entry
+		{
+			PxU64	mSize;
+			PxU64	mLastUse;
+			bool	mSynced;	// the entry was in the index on disk the last time this cache read or wrote it
+		};
+		typedef PxHashMap<CacheKey, Entry, CacheKeyHash>	EntryMap;
+		typedef PxHashSet<CacheKey, CacheKeyHash>			KeySet;
+
+				bool					cook(const CacheKey& key, const PxCookingParams& params, const void* desc, CookCallback callback, PxOutputStream& stream, PxU32& condition);
+				bool					readEntry(const CacheKey& key, CachedData& data, bool& corrupted)	const;
+				bool					writeEntry(const CacheKey& key, const PxU8* data, PxU32 size, PxU32 condition);
+				void					updateEntry(const CacheKey& key, PxU64 size, PxArray<CacheKey>& victims);
+				void					evictEntries(PxArray<CacheKey>& victims);
+				bool					readIndex(PxArray<IndexEntry>& entries, PxU64& useCounter)	const;
+				void					mergeIndex(const PxArray<IndexEntry>& entries, PxU64 useCounter, PxArray<CacheKey>& victims);
+				void					removeFiles(const PxArray<CacheKey>& keys)	const;
+				void					getEntryPath(char* path, PxU64 hash0, PxU64 hash1)	const;
+				void					getTempPath(char* path, const char* name);
+				void					getIndexPath(char* path)	const;
+				void					getLockPath(char* path)	const;
+
+		mutable	PxMutex					mMutex;
+				EntryMap				mEntries;
+				KeySet					mRemoved;	// entries removed by this cache since it last read or wrote the index
+				PxCookingCacheStats		mStats;
+				PxU64					mUseCounter;
+				PxU64					mMaxSize;
+				volatile PxI32			mTempCounter;
+				char					mDirectory[gMaxPathLength];
+	};
+}
+
+CookingCache::CookingCache(const char* directory, PxU64 maxSizeInBytes) :
+	mUseCounter		(0),
+	mMaxSize		(maxSizeInBytes),
+	mTempCounter	(0)
+{
+	PxMemZero(&mStats, sizeof(PxCookingCacheStats));
+
+	Pxstrlcpy(mDirectory, gMaxPathLength, directory);
+	PxU32 length = PxU32(strlen(mDirectory));
+	while(length>1 && (mDirectory[length-1]=='/' || mDirectory[length-1]=='\\'))
+		mDirectory[--length] = 0;
+}
+
+CookingCache::~CookingCache()
+{
+}
+
+void CookingCache::release()
+{
+	flush();
+	PX_DELETE_THIS;
+}
+
+void CookingCache::getEntryPath(char* path, PxU64 hash0, PxU64 hash1) const
+{
+	Pxsnprintf(path, gMaxPathLength, "%s/%016llx%016llx.pxcc", mDirectory, static_cast<unsigned long long>(hash0), static_cast<unsigned long long>(hash1));
+}
+
+void CookingCache::getTempPath(char* path, const char* name)
+{
+	// The name must be unique among the threads of this process and among the processes sharing the directory, so that
+	// concurrent writers never write to the same file. Files are then renamed to their final name in one go.
+	const PxU64 time = PxTime::getCurrentCounterValue();
+	const PxU32 counter = PxU32(PxAtomicIncrement(&mTempCounter));
+	Pxsnprintf(path, gMaxPathLength, "%s/%s.%llx.%x.%llx.tmp", mDirectory, name, static_cast<unsigned long long>(size_t(this)), counter, static_cast<unsigned long long>(time));
+}
+
+void CookingCache::getIndexPath(char* path) const
+{
+	Pxsnprintf(path, gMaxPathLength, "%s/index.pxcc", mDirectory);
+}
+
+void CookingCache::getLockPath(char* path) const
+{
+	Pxsnprintf(path, gMaxPathLength, "%s/index.lock", mDirectory);
+}
+
+static bool renameFile(const char* from, const char* to)
+{
+	if(::rename(from, to)==0)
+		return true;
+
+	// Some platforms refuse to replace an existing file
+	::remove(to);
+	if(::rename(from, to)==0)
+		return true;
+
+	::remove(from);
+	return false;
+}
+
+bool CookingCache::readIndex(PxArray<IndexEntry>& entries, PxU64& useCounter) const
+{
+	char path[gMaxPathLength];
+	getIndexPath(path);
+
+	FILE* fp = NULL;
+	if(sn::fopen_s(&fp, path, "rb"))
+		return false;
+
+	IndexHeader header;
+	const bool status = fread(&header, sizeof(IndexHeader), 1, fp)==1 && header.mMagic==gIndexMagic && header.mVersion==gCacheVersion;
+	if(status)
+	{
+		useCounter = header.mUseCounter;
+		for(PxU32 i=0;i<header.mNbEntries;i++)
+		{
+			IndexEntry entry;
+			if(fread(&entry, sizeof(IndexEntry), 1, fp)!=1)
+				break;
+			entries.pushBack(entry);
+		}
+	}
+	fclose(fp);
+	return status;
+}
+
+// Must be called with the mutex locked. Merges the index read from disk into the entries of this cache. The index is
+// shared by all the processes using the directory, so:
+// - entries of the index this cache does not know were added by other processes, and are adopted unless this cache
+//   removed them since it last synced with the index,
+// - synced entries missing from the index were removed by other processes, and are dropped.
+// The merged entries are then trimmed to the size budget.
+void CookingCache::mergeIndex(const PxArray<IndexEntry>& entries, PxU64 useCounter, PxArray<CacheKey>& victims)
+{
+	KeySet onDisk;
+	for(PxU32 i=0;i<entries.size();i++)
+	{
+		CacheKey key;
+		key.mHash0 = entries[i].mHash0;
+		key.mHash1 = entries[i].mHash1;
+		onDisk.insert(key);
+		if(mRemoved.contains(key))
+			continue;
+
+		const bool known = mEntries.find(key)!=NULL;
+		Entry& entry = mEntries[key];
+		if(known)
+		{
+			entry.mLastUse = PxMax(entry.mLastUse, entries[i].mLastUse);
+		}
+		else
+		{
+			entry.mSize		= entries[i].mSize;
+			entry.mLastUse	= entries[i].mLastUse;
+		}
+	}
+
+	PxArray<CacheKey> dropped;
+	for(EntryMap::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+	{
+		if(it->second.mSynced && !onDisk.contains(it->first))
+			dropped.pushBack(it->first);
+	}
+	for(PxU32 i=0;i<dropped.size();i++)
+		mEntries.erase(dropped[i]);
+
+	mStats.sizeInBytes = 0;
+	for(EntryMap::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+	{
+		it->second.mSynced = true;
+		mStats.sizeInBytes += it->second.mSize;
+	}
+	mRemoved.clear();
+	mUseCounter = PxMax(mUseCounter, useCounter);
+
+	// the victims are removed before the index is written, so they do not need to be tracked in mRemoved
+	evictEntries(victims);
+}
+
+void CookingCache::loadIndex()
+{
+	PxArray<IndexEntry> entries;
+	PxU64 useCounter = 0;
+	if(!readIndex(entries, useCounter))
+		return;
+
+	PxArray<CacheKey> victims;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		mergeIndex(entries, useCounter, victims);
+		// entries evicted here are still in the index on disk until the next flush
+		for(PxU32 i=0;i<victims.size();i++)
+			mRemoved.insert(victims[i]);
+	}
+	removeFiles(victims);
+}
+
+bool CookingCache::flush()
+{
+	// The index is read, merged and written under a file lock, so that concurrent flushes of several processes do not
+	// drop each other's entries.
+	char lockPath[gMaxPathLength];
+	getLockPath(lockPath);
+	void* fileLock = sn::lockFile(lockPath);
+	if(!fileLock)
+		return false;
+
+	PxArray<IndexEntry> diskEntries;
+	PxU64 diskUseCounter = 0;
+	readIndex(diskEntries, diskUseCounter);
+
+	PxArray<CacheKey> victims;
+	PxArray<IndexEntry> entries;
+	IndexHeader header;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		mergeIndex(diskEntries, diskUseCounter, victims);
+
+		entries.reserve(mEntries.size());
+		for(EntryMap::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+		{
+			IndexEntry entry;
+			entry.mHash0	= it->first.mHash0;
+			entry.mHash1	= it->first.mHash1;
+			entry.mSize		= it->second.mSize;
+			entry.mLastUse	= it->second.mLastUse;
+			entries.pushBack(entry);
+		}
+		header.mUseCounter = mUseCounter;
+	}
+	removeFiles(victims);
+
+	header.mMagic		= gIndexMagic;
+	header.mVersion		= gCacheVersion;
+	header.mNbEntries	= entries.size();
+	header.mPad			= 0;
+
+	char tempPath[gMaxPathLength];
+	getTempPath(tempPath, "index");
+
+	bool status = false;
+	FILE* fp = NULL;
+	if(!sn::fopen_s(&fp, tempPath, "wb"))
+	{
+		status = fwrite(&header, sizeof(IndexHeader), 1, fp)==1;
+		if(status && entries.size())
+			status = fwrite(entries.begin(), sizeof(IndexEntry), entries.size(), fp)==entries.size();
+		status &= fclose(fp)==0;
+
+		if(status)
+		{
+			char path[gMaxPathLength];
+			getIndexPath(path);
+			status = renameFile(tempPath, path);
+		}
+		else
+			::remove(tempPath);
+	}
+
+	sn::unlockFile(fileLock);
+	return status;
+}
+
+bool CookingCache::readEntry(const CacheKey& key, CachedData& data, bool& corrupted) const
+{
+	corrupted = false;
+
+	char path[gMaxPathLength];
+	getEntryPath(path, key.mHash0, key.mHash1);
+
+	FILE* fp = NULL;
+	if(sn::fopen_s(&fp, path, "rb"))
+		return false;
+
+	// the data size is checked against the size of the file before allocating, in case the header is corrupted
+	const long fileSize = fseek(fp, 0, SEEK_END)==0 ? ftell(fp) : -1;
+	EntryHeader header;
+	bool status = fileSize>0 && fseek(fp, 0, SEEK_SET)==0 && fread(&header, sizeof(EntryHeader), 1, fp)==1;
+	status = status && header.mMagic==gEntryMagic && header.mVersion==gCacheVersion && header.mHash0==key.mHash0 && header.mHash1==key.mHash1 && header.mDataSize;
+	status = status && PxU64(fileSize)==sizeof(EntryHeader) + PxU64(header.mDataSize);
+	if(status)
+	{
+		data.mData = PX_ALLOCATE(PxU8, header.mDataSize, "CookingCache");
+		data.mSize = header.mDataSize;
+		data.mCondition = header.mCondition;
+		status = fread(data.mData, 1, header.mDataSize, fp)==header.mDataSize;
+		status = status && computeDataHash(data.mData, data.mSize)==header.mDataHash;
+	}
+	fclose(fp);
+
+	corrupted = !status;
+	return status;
+}
+
+bool CookingCache::writeEntry(const CacheKey& key, const PxU8* data, PxU32 size, PxU32 condition)
+{
+	char name[64];
+	Pxsnprintf(name, 64, "%016llx%016llx", static_cast<unsigned long long>(key.mHash0), static_cast<unsigned long long>(key.mHash1));
+	char tempPath[gMaxPathLength];
+	getTempPath(tempPath, name);
+
+	FILE* fp = NULL;
+	if(sn::fopen_s(&fp, tempPath, "wb"))
+		return false;
+
+	EntryHeader header;
+	header.mMagic		= gEntryMagic;
+	header.mVersion		= gCacheVersion;
+	header.mHash0		= key.mHash0;
+	header.mHash1		= key.mHash1;
+	header.mDataHash	= computeDataHash(data, size);
+	header.mDataSize	= size;
+	header.mCondition	= condition;
+
+	bool status = fwrite(&header, sizeof(EntryHeader), 1, fp)==1;
+	status = status && fwrite(data, 1, size, fp)==size;
+	status &= fclose(fp)==0;
+	if(!status)
+	{
+		::remove(tempPath);
+		return false;
+	}
+
+	char path[gMaxPathLength];
+	getEntryPath(path, key.mHash0, key.mHash1);
+	return renameFile(tempPath, path);
+}
+
+// Must be called with the mutex locked. Adds the entry or marks it as most recently used, then picks the least recently used
+// entries to remove until the cache fits its budget. The files of the victims are removed by the caller, outside of the lock.
+void CookingCache::updateEntry(const CacheKey& key, PxU64 size, PxArray<CacheKey>& victims)
+{
+	const EntryMap::Entry* existing = mEntries.find(key);
+	if(existing)
+		mStats.sizeInBytes -= existing->second.mSize;
+	else
+		mEntries[key].mSynced = false;
+	mRemoved.erase(key);
+
+	Entry& entry = mEntries[key];
+	entry.mSize		= size;
+	entry.mLastUse	= ++mUseCounter;
+	mStats.sizeInBytes += size;
+
+	const PxU32 nbVictims = victims.size();
+	evictEntries(victims);
+	for(PxU32 i=nbVictims;i<victims.size();i++)
+		mRemoved.insert(victims[i]);
+}
+
+// Must be called with the mutex locked.
+void CookingCache::evictEntries(PxArray<CacheKey>& victims)
+{
+	while(mStats.sizeInBytes>mMaxSize && mEntries.size())
+	{
+		const EntryMap::Entry* oldest = NULL;
+		for(EntryMap::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+		{
+			if(!oldest || it->second.mLastUse<oldest->second.mLastUse)
+				oldest = &*it;
+		}
+
+		const CacheKey victim = oldest->first;
+		victims.pushBack(victim);
+
+		mStats.sizeInBytes -= oldest->second.mSize;
+		mStats.nbEvictions++;
+		mEntries.erase(victim);
+	}
+}
+
+void CookingCache::removeFiles(const PxArray<CacheKey>& keys) const
+{
+	char path[gMaxPathLength];
+	for(PxU32 i=0;i<keys.size();i++)
+	{
+		getEntryPath(path, keys[i].mHash0, keys[i].mHash1);
+		::remove(path);
+	}
+}
+
+bool CookingCache::cook(const CacheKey& key, const PxCookingParams& params, const void* desc, CookCallback callback, PxOutputStream& stream, PxU32& condition)
+{
+	PxArray<CacheKey> victims;
+
+	// The entry file is read even when the index does not know about it, since another process may have written it.
+	CachedData cached;
+	bool corrupted;
+	if(readEntry(key, cached, corrupted))
+	{
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			mStats.nbHits++;
+			updateEntry(key, cached.mSize + sizeof(EntryHeader), victims);
+		}
+		removeFiles(victims);
+
+		condition = cached.mCondition;
+		return stream.write(cached.mData, cached.mSize)==cached.mSize;
+	}
+
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		mStats.nbMisses++;
+		if(corrupted)
+			mStats.nbErrors++;
+	}
+
+	PxDefaultMemoryOutputStream cooked;
+	if(!callback(params, desc, cooked, condition))
+		return false;
+
+	// A corrupted entry is simply replaced by the new one
+	const bool stored = writeEntry(key, cooked.getData(), cooked.getSize(), condition);
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		if(stored)
+		{
+			mStats.nbStores++;
+			updateEntry(key, cooked.getSize() + sizeof(EntryHeader), victims);
+		}
+		else
+			mStats.nbErrors++;
+	}
+	removeFiles(victims);
+
+	return stream.write(cooked.getData(), cooked.getSize())==cooked.getSize();
+}
+
+bool CookingCache::cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
+{
+	if(desc.sdfDesc)
+	{
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			mStats.nbUncached++;
+		}
+		return PxCookConvexMesh(params, desc, stream, condition);
+	}
+
+	PxU32 result = PxConvexMeshCookingResult::eSUCCESS;
+	const bool status = cook(computeKey(params, desc), params, &desc, cookConvexCallback, stream, result);
+	if(condition)
+		*condition = PxConvexMeshCookingResult::Enum(result);
+	return status;
+}
+
+PxConvexMesh* CookingCache::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxPhysics& physics, PxConvexMeshCookingResult::Enum* condition)
+{
+	PxDefaultMemoryOutputStream stream;
+	if(!cookConvexMesh(params, desc, stream, condition))
+		return NULL;
+
+	PxDefaultMemoryInputData input(stream.getData(), stream.getSize());
+	return physics.createConvexMesh(input);
+}
+
+bool CookingCache::cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)
+{
+	if(desc.sdfDesc)
+	{
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			mStats.nbUncached++;
+		}
+		return PxCookTriangleMesh(params, desc, stream, condition);
+	}
+
+	PxU32 result = PxTriangleMeshCookingResult::eSUCCESS;
+	const bool status = cook(computeKey(params, desc), params, &desc, cookTriangleCallback, stream, result);
+	if(condition)
+		*condition = PxTriangleMeshCookingResult::Enum(result);
+	return status;
+}
+
+PxTriangleMesh* CookingCache::createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxPhysics& physics, PxTriangleMeshCookingResult::Enum* condition)
+{
+	PxDefaultMemoryOutputStream stream;
+	if(!cookTriangleMesh(params, desc, stream, condition))
+		return NULL;
+
+	PxDefaultMemoryInputData input(stream.getData(), stream.getSize());
+	return physics.createTriangleMesh(input);
+}
+
+void CookingCache::getStats(PxCookingCacheStats& stats) const
+{
+	PxMutex::ScopedLock lock(mMutex);
+	stats = mStats;
+	stats.nbEntries = mEntries.size();
+}
+
+void CookingCache::resetStats()
+{
+	PxMutex::ScopedLock lock(mMutex);
+	mStats.nbHits		= 0;
+	mStats.nbMisses		= 0;
+	mStats.nbUncached	= 0;
+	mStats.nbStores		= 0;
+	mStats.nbEvictions	= 0;
+	mStats.nbErrors		= 0;
+}
+
+void CookingCache::clear()
+{
+	PxArray<CacheKey> keys;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		keys.reserve(mEntries.size());
+		for(EntryMap::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+		{
+			keys.pushBack(it->first);
+			mRemoved.insert(it->first);
+		}
+		mEntries.clear();
+		mStats.sizeInBytes = 0;
+	}
+	removeFiles(keys);
+}
+
+PxCookingCache* physx::PxCreateCookingCache(const char* directory, PxU64 maxSizeInBytes)
+{
+	if(!directory || !directory[0] || strlen(directory)>=gMaxDirectoryLength)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateCookingCache: invalid directory.");
+		return NULL;
+	}
+
+	CookingCache* cache = PX_NEW(CookingCache)(directory, maxSizeInBytes);
+	cache->loadIndex();
+	return cache;
+}
@@ -0,0 +1,290 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "ExtCpuTopology.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxString.h"
+
+#if PX_LINUX
+#include <stdio.h>
+#endif
+
+using namespace physx;
+using namespace Ext;
+
+#define EXT_MAX_NB_PROCESSORS	(PX_MAX_NB_THREAD_AFFINITY_WORDS*64)
+
+#if PX_LINUX
+// Linux exposes CPU topology using /sys/devices/system/cpu and /sys/devices/system/node
+// https://www.kernel.org/doc/Documentation/cputopology.txt
+
+static const char* parseNumber(const char* p, PxU32& value)
+{
+	value = 0;
+	while(*p >= '0' && *p <= '9')
+		value = value * 10 + PxU32(*p++ - '0');
+	return p;
+}
+
+// Reads a list of processors or nodes in the sysfs format, e.g. "0-3,8-11".
+static bool readList(const char* path, PxThreadAffinityMask& mask)
+{
+	mask.clear();
+
+	FILE* f = fopen(path, "r");
+	if(!f)
+		return false;
+
+	char buffer[4096];
+	const bool ok = fgets(buffer, sizeof(buffer), f) != NULL;
+	fclose(f);
+	if(!ok)
+		return false;
+
+	const char* p = buffer;
+	while(*p >= '0' && *p <= '9')
+	{
+		PxU32 first, last;
+		p = parseNumber(p, first);
+		last = first;
+		if(*p == '-')
+			p = parseNumber(p + 1, last);
+
+		for(PxU32 i=first; i<=last && i<EXT_MAX_NB_PROCESSORS; i++)
+			mask.set(i);
+
+		if(*p != ',')
+			break;
+		p++;
+	}
+	return !mask.isEmpty();
+}
+
+static bool readProcessorList(PxU32 processor, const char* file, PxThreadAffinityMask& mask)
+{
+	char path[256];
+	Pxsnprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/%s", processor, file);
+	return readList(path, mask);
+}
+
+static PX_FORCE_INLINE void intersect(PxThreadAffinityMask& dst, const PxThreadAffinityMask& src)
+{
+	for(PxU32 i=0; i<PX_MAX_NB_THREAD_AFFINITY_WORDS; i++)
+		dst.mWords[i] &= src.mWords[i];
+}
+
+namespace
+{
+	struct ClusterSortPredicate
+	{
+		bool operator()(const CpuCluster& a, const CpuCluster& b) const
+		{
+			if(a.mNode != b.mNode)
+				return a.mNode < b.mNode;
+			return a.mProcessors.getFirst() < b.mProcessors.getFirst();
+		}
+	};
+}
+#endif
+
+CpuTopology::CpuTopology() : mNbNodes(0)
+{
+}
+
+void CpuTopology::setDefault()
+{
+	mClusters.clear();
+
+	const PxU32 nbCores = PxMax<PxU32>(PxThread::getNbPhysicalCores(), 1);
+
+	CpuCluster cluster;
+	cluster.mNode = 0;
+	cluster.mNbCores = nbCores;
+	cluster.mNbProcessors = nbCores;
+	mClusters.pushBack(cluster);
+
+	mNbNodes = 1;
+}
+
+bool CpuTopology::detect()
+{
+#if PX_LINUX
+	mClusters.clear();
+	mNbNodes = 0;
+
+	PxThreadAffinityMask online;
+	if(!readList("/sys/devices/system/cpu/online", online))
+	{
+		setDefault();
+		return false;
+	}
+
+	// NUMA node of each processor. Machines without NUMA support have no node directory, everything is on node 0.
+	PxArray<PxU32> nodeOfProcessor(EXT_MAX_NB_PROCESSORS, 0);
+	PxArray<PxU32> nodeRemap(EXT_MAX_NB_PROCESSORS, 0xffffffff);
+	PxThreadAffinityMask nodes;
+	if(readList("/sys/devices/system/node/online", nodes))
+	{
+		for(PxU32 node=0; node<EXT_MAX_NB_PROCESSORS; node++)
+		{
+			if(!nodes.test(node))
+				continue;
+
+			char path[256];
+			Pxsnprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+			PxThreadAffinityMask nodeProcessors;
+			if(!readList(path, nodeProcessors))
+				continue;	// Memory-only node
+
+			for(PxU32 i=0; i<EXT_MAX_NB_PROCESSORS; i++)
+			{
+				if(nodeProcessors.test(i))
+					nodeOfProcessor[i] = node;
+			}
+		}
+	}
+
+	PxThreadAffinityMask assigned;
+	for(PxU32 processor=0; processor<EXT_MAX_NB_PROCESSORS; processor++)
+	{
+		if(!online.test(processor) || assigned.test(processor))
+			continue;
+
+		// Processors sharing the last-level cache. Fall back to the whole package if there is no L3.
+		PxThreadAffinityMask shared;
+		if(!readProcessorList(processor, "cache/index3/shared_cpu_list", shared))
+		{
+			if(!readProcessorList(processor, "topology/core_siblings_list", shared))
+				shared.set(processor);
+		}
+		intersect(shared, online);
+
+		const PxU32 node = nodeOfProcessor[processor];
+
+		CpuCluster cluster;
+		cluster.mNbCores = 0;
+		cluster.mNbProcessors = 0;
+
+		// Remap node indices so that they are contiguous
+		if(nodeRemap[node] == 0xffffffff)
+			nodeRemap[node] = mNbNodes++;
+		cluster.mNode = nodeRemap[node];
+
+		for(PxU32 i=processor; i<EXT_MAX_NB_PROCESSORS; i++)
+		{
+			if(!shared.test(i) || assigned.test(i) || nodeOfProcessor[i] != node)
+				continue;
+
+			cluster.mProcessors.set(i);
+			assigned.set(i);
+			cluster.mNbProcessors++;
+		}
+
+		// Count physical cores. The first SMT sibling of each core within the cluster represents the core.
+		for(PxU32 i=processor; i<EXT_MAX_NB_PROCESSORS; i++)
+		{
+			if(!cluster.mProcessors.test(i))
+				continue;
+
+			PxThreadAffinityMask siblings;
+			if(readProcessorList(i, "topology/thread_siblings_list", siblings))
+				intersect(siblings, cluster.mProcessors);
+
+			if(siblings.isEmpty() || siblings.getFirst() == i)
+				cluster.mNbCores++;
+		}
+
+		mClusters.pushBack(cluster);
+	}
+
+	if(!mClusters.size())
+	{
+		setDefault();
+		return false;
+	}
+
+	PxSort(mClusters.begin(), mClusters.size(), ClusterSortPredicate());
+	return true;
+#else
+	setDefault();
+	return false;
+#endif
+}
+
+PxU32 CpuTopology::findCluster(PxU32 processorIndex) const
+{
+	const PxU32 nbClusters = mClusters.size();
+	for(PxU32 i=0; i<nbClusters; i++)
+	{
+		if(mClusters[i].mProcessors.test(processorIndex))
+			return i;
+	}
+	return 0;
+}
+
+void Ext::computeWorkerPlacements(const CpuTopology& topology, PxU32 numThreads, const PxThreadAffinityMask* affinityMasks, WorkerPlacement* placements)
+{
+	if(affinityMasks)
+	{
+		for(PxU32 i=0; i<numThreads; i++)
+		{
+			const PxU32 cluster = topology.findCluster(affinityMasks[i].getFirst());
+			placements[i].mAffinity = affinityMasks[i];
+			placements[i].mGroup = cluster;
+			placements[i].mNode = topology.getCluster(cluster).mNode;
+		}
+		return;
+	}
+
+	const PxU32 nbClusters = topology.getNbClusters();
+	PxU32 worker = 0;
+	for(PxU32 pass=0; worker<numThreads; pass++)
+	{
+		for(PxU32 c=0; c<nbClusters && worker<numThreads; c++)
+		{
+			const CpuCluster& cluster = topology.getCluster(c);
+
+			PxU32 capacity;
+			if(pass == 0)
+				capacity = cluster.mNbCores;
+			else if(pass == 1)
+				capacity = cluster.mNbProcessors - cluster.mNbCores;
+			else
+				capacity = PxMax<PxU32>(cluster.mNbProcessors, 1);	// Oversubscribed
+
+			for(PxU32 j=0; j<capacity && worker<numThreads; j++)
+			{
+				placements[worker].mAffinity = cluster.mProcessors;
+				placements[worker].mGroup = c;
+				placements[worker].mNode = cluster.mNode;
+				worker++;
+			}
+		}
+	}
+}
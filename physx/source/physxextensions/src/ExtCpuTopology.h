@@ -0,0 +1,91 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef EXT_CPU_TOPOLOGY_H
+#define EXT_CPU_TOPOLOGY_H
+
+#include "foundation/PxArray.h"
+#include "foundation/PxThread.h"
+
+namespace physx
+{
+namespace Ext
+{
+	// PT: a group of logical processors sharing a last-level cache, on a single NUMA node.
+	struct CpuCluster
+	{
+		PxThreadAffinityMask	mProcessors;	// Logical processors of the cluster
+		PxU32					mNode;			// NUMA node of the cluster
+		PxU32					mNbCores;		// Number of physical cores
+		PxU32					mNbProcessors;	// Number of logical processors
+	};
+
+	// PT: CPU topology of the machine. Clusters are sorted by NUMA node, then by first logical processor.
+	class CpuTopology
+	{
+	public:
+									CpuTopology();
+
+		// Reads the topology from the OS. Returns false if it could not be read, in which case the topology contains
+		// a single cluster on node 0, with empty processor masks and getNbPhysicalCores() cores.
+						bool		detect();
+
+						// Returns the index of the cluster containing the given logical processor, or 0 if not found.
+						PxU32		findCluster(PxU32 processorIndex)	const;
+
+		PX_FORCE_INLINE	PxU32		getNbClusters()	const	{ return mClusters.size();	}
+		PX_FORCE_INLINE	PxU32		getNbNodes()	const	{ return mNbNodes;			}
+
+		PX_FORCE_INLINE	const CpuCluster&	getCluster(PxU32 i)	const	{ return mClusters[i];	}
+
+	private:
+						void		setDefault();
+
+						PxArray<CpuCluster>	mClusters;
+						PxU32		mNbNodes;
+	};
+
+	// PT: where a worker thread of the dispatcher runs. Workers of the same group share a parking mask and steal from
+	// each other first, then from workers of the same node.
+	struct WorkerPlacement
+	{
+		PxThreadAffinityMask	mAffinity;	// Empty for no pinning
+		PxU32					mGroup;
+		PxU32					mNode;
+	};
+
+	// Distributes workers over the clusters of the topology, filling the clusters of the first NUMA node before moving to
+	// the next one: one worker per physical core first, then one per remaining SMT thread, then round-robin. Each worker
+	// is pinned to all processors of its cluster. If affinityMasks is not NULL, these masks are used as-is and each worker
+	// goes to the cluster containing the first processor of its mask.
+	void computeWorkerPlacements(const CpuTopology& topology, PxU32 numThreads, const PxThreadAffinityMask* affinityMasks, WorkerPlacement* placements);
+
+} // namespace Ext
+}
+
+#endif
@@ -29,15 +29,36 @@
 #include "ExtDefaultCpuDispatcher.h"
 #include "ExtCpuWorkerThread.h"
 #include "ExtTaskQueueHelper.h"
+#include "ExtWorkStealingCpuDispatcher.h"
+#include "ExtCpuTopology.h"
 #include "foundation/PxString.h"
 
 using namespace physx;
 
-PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount)
+PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount, PxDefaultCpuDispatcherSchedulingMode::Enum schedulingMode)
 {
+	if(PxDefaultCpuDispatcherSchedulingMode::eWORK_STEALING == schedulingMode)
+		return PX_NEW(Ext::WorkStealingCpuDispatcher)(numThreads, affinityMasks, NULL, mode, yieldProcessorCount);
+
 	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks, mode, yieldProcessorCount);
 }
 
+PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreateTopologyAware(PxU32 numThreads, const PxThreadAffinityMask* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount)
+{
+	Ext::CpuTopology topology;
+	topology.detect();
+
+	Ext::WorkerPlacement* placements = numThreads ? PX_ALLOCATE(Ext::WorkerPlacement, numThreads, "WorkerPlacements") : NULL;
+	for(PxU32 i=0; i<numThreads; i++)
+		PX_PLACEMENT_NEW(placements + i, Ext::WorkerPlacement)();
+	Ext::computeWorkerPlacements(topology, numThreads, affinityMasks, placements);
+
+	PxDefaultCpuDispatcher* dispatcher = PX_NEW(Ext::WorkStealingCpuDispatcher)(numThreads, NULL, placements, mode, yieldProcessorCount);
+
+	PX_FREE(placements);
+	return dispatcher;
+}
+
 #if !PX_SWITCH
 void Ext::DefaultCpuDispatcher::getAffinityMasks(PxU32* affinityMasks, PxU32 threadCount)
 {
@@ -199,3 +199,31 @@ bool PxDefaultFileInputData::isValid() const
 {
 	return mFile != NULL;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxDefaultMemoryMappedFile::PxDefaultMemoryMappedFile(const char* filename) : mSize(0)
+{
+	mData = sn::mapFile(filename, mSize);
+}
+
+PxDefaultMemoryMappedFile::~PxDefaultMemoryMappedFile()
+{
+	if(mData)
+		sn::unmapFile(mData, mSize);
+}
+
+void* PxDefaultMemoryMappedFile::getData() const
+{
+	return mData;
+}
+
+PxU64 PxDefaultMemoryMappedFile::getSize() const
+{
+	return mSize;
+}
+
+bool PxDefaultMemoryMappedFile::isValid() const
+{
+	return mData != NULL;
+}
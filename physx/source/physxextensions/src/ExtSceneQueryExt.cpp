@@ -31,6 +31,10 @@
 #include "foundation/PxAllocatorCallback.h"
 #include "CmUtils.h"
 #include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxMath.h"
+#include "task/PxTask.h"
 
 using namespace physx;
 
@@ -251,11 +255,63 @@ struct NpOverflowBuffer : PxHitBuffer<HitType>
 };
 
 
+class ExtBatchQuery;
+
+namespace
+{
+	// PT: runs a range of queries of one type for ExtBatchQuery::execute(PxBaseTask*, PxU32), or copies their results
+	// to the user buffers once the touch buffer ranges have been assigned
+	class ExtBatchQueryChunkTask : public PxLightCpuTask
+	{
+	public:
+		ExtBatchQueryChunkTask() : mOwner(NULL), mType(0), mChunk(0), mBegin(0), mEnd(0), mCopy(false)	{}
+
+		virtual void run();
+
+		virtual const char* getName() const
+		{
+			return mCopy ? "ExtBatchQuery.copyChunk" : "ExtBatchQuery.executeChunk";
+		}
+
+		ExtBatchQuery*	mOwner;
+		PxU32			mType;
+		PxU32			mChunk;
+		PxU32			mBegin;
+		PxU32			mEnd;
+		bool			mCopy;
+	};
+
+	// PT: serial steps of ExtBatchQuery::execute(PxBaseTask*, PxU32). They only walk the queries, the queries
+	// themselves are run by the chunk tasks.
+	class ExtBatchQueryStepTask : public PxLightCpuTask
+	{
+	public:
+		ExtBatchQueryStepTask() : mOwner(NULL), mFinalize(false)	{}
+
+		virtual void run();
+
+		virtual const char* getName() const
+		{
+			return mFinalize ? "ExtBatchQuery.finalize" : "ExtBatchQuery.assignTouches";
+		}
+
+		ExtBatchQuery*	mOwner;
+		bool			mFinalize;
+	};
+}
+
 class ExtBatchQuery : public PxBatchQueryExt
 {
 	PX_NOCOPY(ExtBatchQuery)
 public:
 
+	enum QueryType
+	{
+		eRAYCAST,
+		eSWEEP,
+		eOVERLAP
+	};
+
 	ExtBatchQuery(
 		const PxScene& scene,
 		PxQueryFilterCallback* queryFilterCallback,
@@ -287,6 +343,16 @@ public:
 
 	virtual void execute();
 
+	virtual void execute(PxBaseTask* continuation, PxU32 maxNbQueriesPerTask);
+
+	void executeChunk(PxU32 type, PxU32 chunk, PxU32 begin, PxU32 end);
+
+	void copyChunk(PxU32 type, PxU32 chunk, PxU32 begin, PxU32 end);
+
+	void assignTouches(PxBaseTask* continuation);
+
+	void finalize();
+
 private:
 
 	template<typename HitType, typename QueryType> struct Query
@@ -299,6 +365,24 @@ private:
 
 		PxU32 mBufferTide;
 
+		// PT: results of the parallel path. The chunk tasks write the touches of their queries back to back in their own
+		// scratch buffer, so the scratch memory only grows with the number of touches actually found.
+		struct ScratchResult
+		{
+			HitType block;
+			PxU32 requestedTouches;		// maxNbTouches passed to addQuery()
+			PxU32 touchOffset;			// in the scratch buffer of the chunk
+			PxU32 touchCapacity;		// capacity the query has been run with
+			PxU32 nbTouches;
+			PxU32 expectedNbTouches;	// for a query run again with a smaller capacity
+			bool hasBlock;
+			bool overflow;
+			bool runAgain;
+			bool noTouchesRemaining;
+		};
+		PxArray<ScratchResult> mScratchResults;
+		PxArray<PxArray<HitType> > mChunkTouches;
+
 		Query()
 			: mBuffers(NULL),
 			mQueries(NULL),
@@ -375,53 +459,194 @@ private:
 				query.cache);
 		}
 
+		// Assigns the next range of the touch buffer to query i. Returns true if there was nothing left to assign.
+		bool reserveTouches(const PxU32 i, const PxU32 touchesTide)
+		{
+			PX_ASSERT(0xffffffff == mBuffers[i].nbTouches);
+			PX_ASSERT(0xffffffff != mBuffers[i].maxNbTouches);
+			PX_ASSERT(!mBuffers[i].touches);
+
+			bool noTouchesRemaining = false;
+			if (mBuffers[i].maxNbTouches > 0)
+			{
+				if (touchesTide >= mMaxNbTouches)
+				{
+					//No resources left.
+					mBuffers[i].maxNbTouches = 0;
+					mBuffers[i].touches = NULL;
+					noTouchesRemaining = true;
+				}
+				else if ((touchesTide + mBuffers[i].maxNbTouches) > mMaxNbTouches)
+				{
+					//Some resources left but not enough to match requested number.
+					//This might be enough but it depends on the number of hits generated by the query.
+					mBuffers[i].maxNbTouches = mMaxNbTouches - touchesTide;
+					mBuffers[i].touches = mTouches + touchesTide;
+				}
+				else
+				{
+					//Enough resources left to match request.
+					mBuffers[i].touches = mTouches + touchesTide;
+				}
+			}
+			return noTouchesRemaining;
+		}
+
+		void setOverflow(const PxU32 i, const bool overflow)
+		{
+			if(overflow)
+			{
+				mBuffers[i].maxNbTouches = 0xffffffff;
+			}
+		}
+
+		void runQuery(const PxScene& scene, PxQueryFilterCallback* qfcb, const PxU32 i, const bool noTouchesRemaining)
+		{
+			bool overflow = false;
+			{
+				PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(mBuffers[i].touches, mBuffers[i].maxNbTouches);
+				performQuery(scene, mQueries[i], overflowBuffer, qfcb);
+				overflow = overflowBuffer.overflow || noTouchesRemaining;
+				mBuffers[i].hasBlock = overflowBuffer.hasBlock;
+				mBuffers[i].block = overflowBuffer.block;
+				mBuffers[i].nbTouches = overflowBuffer.nbTouches;
+			}
+			setOverflow(i, overflow);
+		}
+
 		void execute(const PxScene& scene, PxQueryFilterCallback* qfcb)
 		{
 			PxU32 touchesTide = 0;
 			for (PxU32 i = 0; i < mBufferTide; i++)
 			{
-				PX_ASSERT(0xffffffff == mBuffers[i].nbTouches);
-				PX_ASSERT(0xffffffff != mBuffers[i].maxNbTouches);
-				PX_ASSERT(!mBuffers[i].touches);
+				const bool noTouchesRemaining = reserveTouches(i, touchesTide);
+				runQuery(scene, qfcb, i, noTouchesRemaining);
+				touchesTide += mBuffers[i].nbTouches;
+			}
 
-				bool noTouchesRemaining = false;
-				if (mBuffers[i].maxNbTouches > 0)
-				{
-					if (touchesTide >= mMaxNbTouches)
-					{
-						//No resources left.
-						mBuffers[i].maxNbTouches = 0;
-						mBuffers[i].touches = NULL;
-						noTouchesRemaining = true;
-					}
-					else if ((touchesTide + mBuffers[i].maxNbTouches) > mMaxNbTouches)
-					{
-						//Some resources left but not enough to match requested number.
-						//This might be enough but it depends on the number of hits generated by the query.
-						mBuffers[i].maxNbTouches = mMaxNbTouches - touchesTide;
-						mBuffers[i].touches = mTouches + touchesTide;
-					}
-					else
-					{
-						//Enough resources left to match request.
-						mBuffers[i].touches = mTouches + touchesTide;
-					}
-				}
+			mBufferTide = 0;
+		}
+
+		// Parallel path, step 1: resets the scratch buffers of the chunks.
+		void prepareScratch(const PxU32 nbChunks)
+		{
+			mScratchResults.resizeUninitialized(mBufferTide);
 
-				bool overflow = false;
+			if (mChunkTouches.size() < nbChunks)
+				mChunkTouches.resize(nbChunks);
+			for (PxU32 i = 0; i < nbChunks; i++)
+				mChunkTouches[i].clear();
+		}
+
+		// Parallel path, step 2: runs queries [begin, end) of a chunk. Only writes to the scratch data of this chunk. Each query
+		// gets the capacity the serial path would give it if all previous queries had found no touches.
+		void executeScratch(const PxScene& scene, PxQueryFilterCallback* qfcb, const PxU32 chunk, const PxU32 begin, const PxU32 end)
+		{
+			PxArray<HitType>& chunkTouches = mChunkTouches[chunk];
+			for (PxU32 i = begin; i < end; i++)
+			{
+				ScratchResult& result = mScratchResults[i];
+				result.requestedTouches = mBuffers[i].maxNbTouches;
+				result.touchOffset = chunkTouches.size();
+				result.touchCapacity = PxMin(mBuffers[i].maxNbTouches, mMaxNbTouches);
+
+				const PxU32 needed = result.touchOffset + result.touchCapacity;
+				if (needed > chunkTouches.capacity())
+					chunkTouches.reserve(PxMax(needed, chunkTouches.capacity() * 2));
+				HitType* touches = result.touchCapacity ? chunkTouches.begin() + result.touchOffset : NULL;
+
+				PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(touches, result.touchCapacity);
+				performQuery(scene, mQueries[i], overflowBuffer, qfcb);
+				result.overflow = overflowBuffer.overflow;
+				result.hasBlock = overflowBuffer.hasBlock;
+				result.block = overflowBuffer.block;
+				result.nbTouches = overflowBuffer.nbTouches;
+
+				chunkTouches.resizeUninitialized(result.touchOffset + result.nbTouches);
+			}
+		}
+
+		// Parallel path, step 3: assigns the touch buffer ranges in query order as the serial path does. No query is run
+		// here. A query that gets less touch capacity than it ran with (the touch buffer ran out) must be run again by the
+		// copy step, the results with a smaller capacity can differ. It is assumed to fill its capacity unless it found fewer
+		// touches without overflowing, finalizeScratch() fixes things up if it did not.
+		void assignScratchTouches()
+		{
+			PxU32 touchesTide = 0;
+			for (PxU32 i = 0; i < mBufferTide; i++)
+			{
+				ScratchResult& result = mScratchResults[i];
+				result.noTouchesRemaining = reserveTouches(i, touchesTide);
+
+				const PxU32 capacity = mBuffers[i].maxNbTouches;
+				result.runAgain = capacity != result.touchCapacity;
+				result.expectedNbTouches = result.runAgain ? (result.overflow ? capacity : PxMin(result.nbTouches, capacity)) : result.nbTouches;
+				touchesTide += result.expectedNbTouches;
+			}
+		}
+
+		// Parallel path, step 4: copies the results of queries [begin, end) of a chunk to the ranges assigned in step 3, or
+		// runs the queries again with the capacity of these ranges.
+		void copyScratch(const PxScene& scene, PxQueryFilterCallback* qfcb, const PxU32 chunk, const PxU32 begin, const PxU32 end)
+		{
+			PxArray<HitType>& chunkTouches = mChunkTouches[chunk];
+			for (PxU32 i = begin; i < end; i++)
+			{
+				const ScratchResult& result = mScratchResults[i];
+				if (result.runAgain)
 				{
-					PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(mBuffers[i].touches, mBuffers[i].maxNbTouches);
-					performQuery(scene, mQueries[i], overflowBuffer, qfcb);
-					overflow = overflowBuffer.overflow || noTouchesRemaining;
-					mBuffers[i].hasBlock = overflowBuffer.hasBlock;
-					mBuffers[i].block = overflowBuffer.block;
-					mBuffers[i].nbTouches = overflowBuffer.nbTouches;
+					// PT: a query can write to its whole range before its touches are clipped, and that range can overlap the
+					// ones of the following queries handled by other tasks. So it runs after the scratch touches of the chunk
+					// and only the touches it keeps are copied.
+					const PxU32 capacity = mBuffers[i].maxNbTouches;
+					const PxU32 nbChunkTouches = chunkTouches.size();
+					if (nbChunkTouches + capacity > chunkTouches.capacity())
+						chunkTouches.reserve(nbChunkTouches + capacity);
+
+					HitType* touches = mBuffers[i].touches;
+					mBuffers[i].touches = capacity ? chunkTouches.begin() + nbChunkTouches : NULL;
+					runQuery(scene, qfcb, i, result.noTouchesRemaining);
+					if (mBuffers[i].nbTouches)
+						PxMemCopy(touches, mBuffers[i].touches, sizeof(HitType)*mBuffers[i].nbTouches);
+					mBuffers[i].touches = touches;
 				}
-
-				if(overflow)
+				else
 				{
-					mBuffers[i].maxNbTouches = 0xffffffff;
+					if (result.nbTouches)
+						PxMemCopy(mBuffers[i].touches, chunkTouches.begin() + result.touchOffset, sizeof(HitType)*result.nbTouches);
+					mBuffers[i].hasBlock = result.hasBlock;
+					mBuffers[i].block = result.block;
+					mBuffers[i].nbTouches = result.nbTouches;
+					setOverflow(i, result.overflow || result.noTouchesRemaining);
 				}
+			}
+		}
+
+		// Parallel path, step 5: a query run again in step 4 can find fewer touches than step 3 assumed. The ranges of the
+		// following queries are then not the ones the serial path would give them, so they are assigned and run again here.
+		// This only happens when the touch buffer runs out.
+		void finalizeScratch(const PxScene& scene, PxQueryFilterCallback* qfcb)
+		{
+			PxU32 touchesTide = 0;
+			PxU32 i = 0;
+			while (i < mBufferTide)
+			{
+				const bool mismatch = mBuffers[i].nbTouches != mScratchResults[i].expectedNbTouches;
+				touchesTide += mBuffers[i].nbTouches;
+				i++;
+				if (mismatch)
+					break;
+			}
+
+			for (; i < mBufferTide; i++)
+			{
+				mBuffers[i].touches = NULL;
+				mBuffers[i].maxNbTouches = mScratchResults[i].requestedTouches;
+				mBuffers[i].hasBlock = false;
+				mBuffers[i].nbTouches = 0xffffffff;
+
+				const bool noTouchesRemaining = reserveTouches(i, touchesTide);
+				runQuery(scene, qfcb, i, noTouchesRemaining);
 				touchesTide += mBuffers[i].nbTouches;
 			}
 
@@ -435,8 +660,30 @@ private:
 	Query<PxRaycastHit, Raycast> mRaycasts;
 	Query<PxSweepHit, Sweep> mSweeps;
 	Query<PxOverlapHit, Overlap> mOverlaps;
+
+	PxArray<ExtBatchQueryChunkTask> mChunkTasks;
+	PxArray<ExtBatchQueryChunkTask> mCopyTasks;
+	PxU32 mNbChunks;
+	ExtBatchQueryStepTask mAssignTask;
+	ExtBatchQueryStepTask mFinalizeTask;
 };
 
+void ExtBatchQueryChunkTask::run()
+{
+	if (mCopy)
+		mOwner->copyChunk(mType, mChunk, mBegin, mEnd);
+	else
+		mOwner->executeChunk(mType, mChunk, mBegin, mEnd);
+}
+
+void ExtBatchQueryStepTask::run()
+{
+	if (mFinalize)
+		mOwner->finalize();
+	else
+		mOwner->assignTouches(getContinuation());
+}
+
 template<typename HitType>
 class ExtBatchQueryDesc
 {
@@ -632,7 +879,8 @@ ExtBatchQuery::ExtBatchQuery
  PxSweepBuffer* sweepBuffers, Sweep* sweepQueries, const PxU32 maxNbSweeps, PxSweepHit* sweepTouches, const PxU32 maxNbSweepTouches,
  PxOverlapBuffer* overlapBuffers, Overlap* overlapQueries, const PxU32 maxNbOverlaps, PxOverlapHit* overlapTouches, const PxU32 maxNbOverlapTouches)
 	: mScene(scene),
-	  mQueryFilterCallback(queryFilterCallback)
+	  mQueryFilterCallback(queryFilterCallback),
+	  mNbChunks(0)
 {
 	typedef Query<PxRaycastHit, Raycast> QueryRaycast;
 	typedef Query<PxSweepHit, Sweep> QuerySweep;
@@ -644,6 +892,7 @@ ExtBatchQuery::ExtBatchQuery
 
 void ExtBatchQuery::release()
 {
+	this->~ExtBatchQuery();
 	PxGetAllocatorCallback()->deallocate(this);
 }
 
@@ -694,3 +943,123 @@ void ExtBatchQuery::execute()
 	mSweeps.execute(mScene, mQueryFilterCallback);
 	mOverlaps.execute(mScene, mQueryFilterCallback);
 }
+
+void ExtBatchQuery::execute(PxBaseTask* continuation, PxU32 maxNbQueriesPerTask)
+{
+	if (!continuation)
+	{
+		execute();
+		return;
+	}
+
+	PX_CHECK_AND_RETURN(continuation->getTaskManager(), "PxBatchQueryExt::execute - continuation must have a task manager. Queries discarded.");
+
+	if (!maxNbQueriesPerTask)
+		maxNbQueriesPerTask = 1;
+
+	const PxU32 nbQueries[3] = { mRaycasts.mBufferTide, mSweeps.mBufferTide, mOverlaps.mBufferTide };
+
+	PxU32 nbChunks[3];
+	mNbChunks = 0;
+	for (PxU32 type = 0; type < 3; type++)
+	{
+		nbChunks[type] = (nbQueries[type] + maxNbQueriesPerTask - 1) / maxNbQueriesPerTask;
+		mNbChunks += nbChunks[type];
+	}
+
+	mRaycasts.prepareScratch(nbChunks[eRAYCAST]);
+	mSweeps.prepareScratch(nbChunks[eSWEEP]);
+	mOverlaps.prepareScratch(nbChunks[eOVERLAP]);
+
+	// PT: the tasks must not move once submitted, so the arrays are only resized here
+	if (mChunkTasks.size() < mNbChunks)
+	{
+		mChunkTasks.resize(mNbChunks);
+		mCopyTasks.resize(mNbChunks);
+	}
+
+	mFinalizeTask.mOwner = this;
+	mFinalizeTask.mFinalize = true;
+	mFinalizeTask.setContinuation(continuation);
+
+	mAssignTask.mOwner = this;
+	mAssignTask.mFinalize = false;
+	mAssignTask.setContinuation(&mFinalizeTask);
+
+	PxU32 chunk = 0;
+	for (PxU32 type = 0; type < 3; type++)
+	{
+		for (PxU32 i = 0; i < nbChunks[type]; i++)
+		{
+			const PxU32 begin = i * maxNbQueriesPerTask;
+			const PxU32 end = PxMin(begin + maxNbQueriesPerTask, nbQueries[type]);
+
+			ExtBatchQueryChunkTask& task = mChunkTasks[chunk];
+			task.mOwner = this;
+			task.mType = type;
+			task.mChunk = i;
+			task.mBegin = begin;
+			task.mEnd = end;
+			task.mCopy = false;
+			task.setContinuation(&mAssignTask);
+
+			// PT: the copy tasks are submitted by the assign task
+			ExtBatchQueryChunkTask& copyTask = mCopyTasks[chunk];
+			copyTask.mOwner = this;
+			copyTask.mType = type;
+			copyTask.mChunk = i;
+			copyTask.mBegin = begin;
+			copyTask.mEnd = end;
+			copyTask.mCopy = true;
+			chunk++;
+		}
+	}
+	PX_ASSERT(chunk == mNbChunks);
+
+	// PT: all continuations are set before the first task is released, so the assign task cannot run early
+	for (PxU32 i = 0; i < mNbChunks; i++)
+		mChunkTasks[i].removeReference();
+
+	mAssignTask.removeReference();
+	mFinalizeTask.removeReference();
+}
+
+void ExtBatchQuery::executeChunk(PxU32 type, PxU32 chunk, PxU32 begin, PxU32 end)
+{
+	if (type == eRAYCAST)
+		mRaycasts.executeScratch(mScene, mQueryFilterCallback, chunk, begin, end);
+	else if (type == eSWEEP)
+		mSweeps.executeScratch(mScene, mQueryFilterCallback, chunk, begin, end);
+	else
+		mOverlaps.executeScratch(mScene, mQueryFilterCallback, chunk, begin, end);
+}
+
+void ExtBatchQuery::copyChunk(PxU32 type, PxU32 chunk, PxU32 begin, PxU32 end)
+{
+	if (type == eRAYCAST)
+		mRaycasts.copyScratch(mScene, mQueryFilterCallback, chunk, begin, end);
+	else if (type == eSWEEP)
+		mSweeps.copyScratch(mScene, mQueryFilterCallback, chunk, begin, end);
+	else
+		mOverlaps.copyScratch(mScene, mQueryFilterCallback, chunk, begin, end);
+}
+
+void ExtBatchQuery::assignTouches(PxBaseTask* continuation)
+{
+	mRaycasts.assignScratchTouches();
+	mSweeps.assignScratchTouches();
+	mOverlaps.assignScratchTouches();
+
+	for (PxU32 i = 0; i < mNbChunks; i++)
+		mCopyTasks[i].setContinuation(continuation);
+
+	for (PxU32 i = 0; i < mNbChunks; i++)
+		mCopyTasks[i].removeReference();
+}
+
+void ExtBatchQuery::finalize()
+{
+	mRaycasts.finalizeScratch(mScene, mQueryFilterCallback);
+	mSweeps.finalizeScratch(mScene, mQueryFilterCallback);
+	mOverlaps.finalizeScratch(mScene, mQueryFilterCallback);
+}
@@ -0,0 +1,433 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "ExtWorkStealingCpuDispatcher.h"
+#include "ExtDefaultCpuDispatcher.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxString.h"
+
+using namespace physx;
+
+Ext::WorkStealingWorkerThread::WorkStealingWorkerThread() : mOwner(NULL), mIndex(0), mGroup(0), mGroupBegin(0), mGroupEnd(0), mNodeBegin(0), mNodeEnd(0), mRandomState(1)
+{
+}
+
+Ext::WorkStealingWorkerThread::~WorkStealingWorkerThread()
+{
+}
+
+void Ext::WorkStealingWorkerThread::execute()
+{
+	// PT: this is how submitTask() finds the deque of the calling thread
+	PxTlsSet(mOwner->getTlsIndex(), this);
+
+	const PxDefaultCpuDispatcherWaitForWorkMode::Enum ownerWaitForWorkMode = mOwner->getWaitForWorkMode();
+
+	while(!quitIsSignalled())
+	{
+		PxBaseTask* task = mOwner->fetchNextTask(*this);
+
+		if(!task)
+		{
+			if(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == ownerWaitForWorkMode)
+			{
+				PxThread::yield();
+			}
+			else if(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == ownerWaitForWorkMode)
+			{
+				const PxU32 pauseCounter = mOwner->getYieldProcessorCount();
+				for(PxU32 j = 0; j < pauseCounter; j++)
+					PxThread::yieldProcesor();
+			}
+			else
+			{
+				PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == ownerWaitForWorkMode);
+				task = mOwner->park(*this);
+			}
+		}
+
+		if(task)
+		{
+			mOwner->runTask(*task);
+			task->release();
+		}
+	}
+
+	PxTlsSet(mOwner->getTlsIndex(), NULL);
+
+	quit();
+}
+
+namespace
+{
+	struct PlacementSortPredicate
+	{
+		PlacementSortPredicate(const Ext::WorkerPlacement* placements) : mPlacements(placements)	{}
+
+		bool operator()(PxU32 a, PxU32 b) const
+		{
+			const Ext::WorkerPlacement& pa = mPlacements[a];
+			const Ext::WorkerPlacement& pb = mPlacements[b];
+			if(pa.mNode != pb.mNode)
+				return pa.mNode < pb.mNode;
+			if(pa.mGroup != pb.mGroup)
+				return pa.mGroup < pb.mGroup;
+			return a < b;
+		}
+
+		const Ext::WorkerPlacement*	mPlacements;
+	};
+}
+
+Ext::WorkStealingCpuDispatcher::WorkStealingCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, const WorkerPlacement* placements, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount) :
+	mParkedMasks	(NULL),
+	mParkedGroups	(0),
+	mGroupStarts	(NULL),
+	mNumThreads		(numThreads),
+	mNbGroups		(0),
+	mTlsIndex		(PxTlsAlloc()),
+	mShuttingDown	(false),
+#if PX_PROFILE
+	mRunProfiled	(true),
+#else
+	mRunProfiled	(false),
+#endif
+	mWaitForWorkMode		(mode),
+	mYieldProcessorCount	(yieldProcessorCount)
+{
+	PX_CHECK_MSG((((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode) && (mYieldProcessorCount > 0)) ||
+					(((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode) || (PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)) && (0 == mYieldProcessorCount))), "Illegal yield processor count for chosen execute mode");
+
+	const PxU32 maxNbThreads = EXT_WORK_STEALING_MAX_NB_GROUPS * EXT_WORK_STEALING_MAX_GROUP_SIZE;
+	if(numThreads > maxNbThreads)
+	{
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxDefaultCpuDispatcherCreate: number of worker threads clamped to %d in work-stealing mode.", maxNbThreads);
+		numThreads = mNumThreads = maxNbThreads;
+	}
+
+	// PT: order workers by node, then by group, so that groups and nodes are contiguous ranges of workers
+	PxU32* order = PX_ALLOCATE(PxU32, numThreads, "WorkerOrder");
+	PxU32* groups = PX_ALLOCATE(PxU32, numThreads, "WorkerGroups");
+	PxU32* nodes = PX_ALLOCATE(PxU32, numThreads, "WorkerNodes");
+	for(PxU32 i = 0; i < numThreads; ++i)
+		order[i] = i;
+	if(placements && numThreads)
+		PxSort(order, numThreads, PlacementSortPredicate(placements));
+
+	// PT: renumber groups, splitting the ones that do not fit in a parking mask
+	{
+		PxU32 prevGroup = 0xffffffff;
+		PxU32 groupSize = 0;
+		for(PxU32 i = 0; i < numThreads; ++i)
+		{
+			const PxU32 group = placements ? placements[order[i]].mGroup : i / EXT_WORK_STEALING_MIN_GROUP_SIZE;
+			nodes[i] = placements ? placements[order[i]].mNode : 0;
+
+			if(!i || group != prevGroup || nodes[i] != nodes[i-1] || groupSize == EXT_WORK_STEALING_MAX_GROUP_SIZE)
+			{
+				mNbGroups++;
+				groupSize = 0;
+			}
+			groups[i] = mNbGroups - 1;
+			prevGroup = group;
+			groupSize++;
+		}
+
+		if(mNbGroups > EXT_WORK_STEALING_MAX_NB_GROUPS)
+		{
+			// PT: too many groups for the summary mask, fall back to evenly sized groups. These can straddle nodes.
+			const PxU32 groupSize2 = (numThreads + EXT_WORK_STEALING_MAX_NB_GROUPS - 1) / EXT_WORK_STEALING_MAX_NB_GROUPS;
+			for(PxU32 i = 0; i < numThreads; ++i)
+				groups[i] = i / groupSize2;
+			mNbGroups = (numThreads + groupSize2 - 1) / groupSize2;
+		}
+	}
+
+	if(mNbGroups)
+	{
+		mParkedMasks = PX_ALLOCATE(PxI64, mNbGroups, "ParkedMasks");
+		mGroupStarts = PX_ALLOCATE(PxU32, mNbGroups + 1, "GroupStarts");
+		for(PxU32 i = 0; i < mNbGroups; ++i)
+			mParkedMasks[i] = 0;
+		for(PxU32 i = 0; i < numThreads; ++i)
+		{
+			if(!i || groups[i] != groups[i-1])
+				mGroupStarts[groups[i]] = i;
+		}
+		mGroupStarts[mNbGroups] = numThreads;
+	}
+
+	PxU32* defaultAffinityMasks = NULL;
+
+	if(!affinityMasks && !placements)
+	{
+		defaultAffinityMasks = PX_ALLOCATE(PxU32, numThreads, "ThreadAffinityMasks");
+		DefaultCpuDispatcher::getAffinityMasks(defaultAffinityMasks, numThreads);
+		affinityMasks = defaultAffinityMasks;
+	}
+
+	// initialize threads first, then start
+
+	mWorkerThreads = PX_ALLOCATE(WorkStealingWorkerThread, numThreads, "WorkStealingWorkerThread");
+	const PxU32 nameLength = 32;
+	mThreadNames = PX_ALLOCATE(PxU8, nameLength * numThreads, "CpuWorkerThreadName");
+
+	if(mWorkerThreads)
+	{
+		PxU32 nodeBegin = 0;
+		for(PxU32 i = 0; i < numThreads; ++i)
+		{
+			if(i && nodes[i] != nodes[i-1])
+				nodeBegin = i;
+			PxU32 nodeEnd = i + 1;
+			while(nodeEnd < numThreads && nodes[nodeEnd] == nodes[i])
+				nodeEnd++;
+
+			PX_PLACEMENT_NEW(mWorkerThreads+i, WorkStealingWorkerThread)();
+			mWorkerThreads[i].initialize(this, i, groups[i]);
+			mWorkerThreads[i].setNeighbors(mGroupStarts[groups[i]], mGroupStarts[groups[i] + 1], nodeBegin, nodeEnd);
+		}
+
+		for(PxU32 i = 0; i < numThreads; ++i)
+		{
+			if(mThreadNames)
+			{
+				char* threadName = reinterpret_cast<char*>(mThreadNames + (i*nameLength));
+				Pxsnprintf(threadName, nameLength, "PxWorker%02d", i);
+				mWorkerThreads[i].setName(threadName);
+			}
+
+			if(placements)
+			{
+				const PxThreadAffinityMask& affinity = placements[order[i]].mAffinity;
+				if(!affinity.isEmpty())
+					mWorkerThreads[i].setAffinityMask(affinity);
+			}
+			else
+				mWorkerThreads[i].setAffinityMask(affinityMasks[i]);
+			mWorkerThreads[i].start(PxThread::getDefaultStackSize());
+		}
+	}
+	else
+	{
+		mNumThreads = 0;
+	}
+
+	PX_FREE(defaultAffinityMasks);
+	PX_FREE(nodes);
+	PX_FREE(groups);
+	PX_FREE(order);
+}
+
+Ext::WorkStealingCpuDispatcher::~WorkStealingCpuDispatcher()
+{
+	mShuttingDown = true;
+
+	for(PxU32 i = 0; i < mNumThreads; ++i)
+		mWorkerThreads[i].signalQuit();
+
+	// PT: parked threads check mShuttingDown after resetting their sync, so setting it here cannot be missed
+	PxMemoryBarrier();
+	for(PxU32 i = 0; i < mNumThreads; ++i)
+		mWorkerThreads[i].mWake.set();
+
+	for(PxU32 i = 0; i < mNumThreads; ++i)
+		mWorkerThreads[i].waitForQuit();
+
+	for(PxU32 i = 0; i < mNumThreads; ++i)
+		mWorkerThreads[i].~WorkStealingWorkerThread();
+
+	PX_FREE(mWorkerThreads);
+	PX_FREE(mThreadNames);
+	PX_FREE(mGroupStarts);
+	PxI64* parkedMasks = const_cast<PxI64*>(mParkedMasks);
+	PX_FREE(parkedMasks);
+
+	PxTlsFree(mTlsIndex);
+}
+
+void Ext::WorkStealingCpuDispatcher::release()
+{
+	PX_DELETE_THIS;
+}
+
+void Ext::WorkStealingCpuDispatcher::submitTask(PxBaseTask& task)
+{
+	if(!mNumThreads)
+	{
+		// no worker threads, run directly
+		runTask(task);
+		task.release();
+		return;
+	}
+
+	// PT: NULL for threads that are not workers of this dispatcher (e.g. the thread calling PxScene::simulate)
+	WorkStealingWorkerThread* worker = reinterpret_cast<WorkStealingWorkerThread*>(PxTlsGet(mTlsIndex));
+
+	// PT: high priority tasks go to the shared list so that all workers see them first
+	if(!worker || task.isHighPriority() || !worker->mDeque.push(task))
+		mHelper.tryAcceptJobToQueue(task);
+
+	if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
+		wakeOne(worker ? worker->getGroup() : 0);
+	else
+		PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode || PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode);
+}
+
+PxBaseTask* Ext::WorkStealingCpuDispatcher::fetchNextTask(WorkStealingWorkerThread& worker)
+{
+	// PT: high priority tasks first, they only live in the shared list
+	PxBaseTask* task = mHelper.fetchTask<true>();
+	if(task)
+		return task;
+
+	// PT: then our own deque, LIFO for cache locality
+	task = worker.mDeque.pop();
+	if(task)
+		return task;
+
+	// PT: then tasks submitted from non-worker threads or overflowing deques
+	task = mHelper.fetchTask<false>();
+	if(task)
+		return task;
+
+	return stealTask(worker);
+}
+
+PxBaseTask* Ext::WorkStealingCpuDispatcher::stealTask(WorkStealingWorkerThread& thief)
+{
+	if(mNumThreads < 2)
+		return NULL;
+
+	// PT: closest victims first: our own group, then our own node, then everybody else
+	const PxU32 thiefIndex = thief.getIndex();
+	PxBaseTask* task = stealTask(thief, thief.getGroupBegin(), thief.getGroupEnd(), thiefIndex, thiefIndex + 1);
+	if(!task)
+		task = stealTask(thief, thief.getNodeBegin(), thief.getNodeEnd(), thief.getGroupBegin(), thief.getGroupEnd());
+	if(!task)
+		task = stealTask(thief, 0, mNumThreads, thief.getNodeBegin(), thief.getNodeEnd());
+	return task;
+}
+
+PxBaseTask* Ext::WorkStealingCpuDispatcher::stealTask(WorkStealingWorkerThread& thief, PxU32 begin, PxU32 end, PxU32 excludeBegin, PxU32 excludeEnd)
+{
+	const PxU32 nbVictims = end - begin;
+	if(nbVictims <= excludeEnd - excludeBegin)
+		return NULL;
+
+	// PT: start from a random victim so that thieves do not all hammer the same deque
+	PxU32 victim = begin + thief.random() % nbVictims;
+	for(PxU32 i=0; i<nbVictims; i++)
+	{
+		if(victim < excludeBegin || victim >= excludeEnd)
+		{
+			PxBaseTask* task = mWorkerThreads[victim].mDeque.steal();
+			if(task)
+				return task;
+		}
+		if(++victim == end)
+			victim = begin;
+	}
+	return NULL;
+}
+
+bool Ext::WorkStealingCpuDispatcher::hasStealableTask() const
+{
+	const PxU32 nbThreads = mNumThreads;
+	for(PxU32 i=0; i<nbThreads; i++)
+	{
+		if(!mWorkerThreads[i].mDeque.isEmpty())
+			return true;
+	}
+	return false;
+}
+
+PxBaseTask* Ext::WorkStealingCpuDispatcher::park(WorkStealingWorkerThread& worker)
+{
+	PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode);
+
+	const PxU32 group = worker.getGroup();
+	const PxI64 bit = PxI64(1) << (worker.getIndex() - mGroupStarts[group]);
+
+	worker.mWake.reset();
+
+	// PT: advertise ourselves as parked, then look for work one last time. A submit that happened before the
+	// masks were updated is caught by the fetch below, a submit that happens after sees our bit and wakes us.
+	PxAtomicOr(&mParkedMasks[group], bit);
+	PxAtomicOr(&mParkedGroups, PxI64(1) << group);
+
+	PxBaseTask* task = fetchNextTask(worker);
+
+	// PT: a failed steal does not mean the deques are empty, another thief may just have won the race
+	if(task || hasStealableTask() || mShuttingDown)
+	{
+		PxAtomicAnd(&mParkedMasks[group], ~bit);
+		return task;
+	}
+
+	worker.mWake.wait();
+	return NULL;
+}
+
+void Ext::WorkStealingCpuDispatcher::wakeOne(PxU32 preferredGroup)
+{
+	// PT: the submitted task must be visible before we read the parked state (pairs with the atomics in park())
+	PxMemoryBarrier();
+
+	PxI64 groups = mParkedGroups;
+	while(groups)
+	{
+		const PxI64 preferredBit = PxI64(1) << preferredGroup;
+		const PxU32 group = (groups & preferredBit) ? preferredGroup : PxLowestSetBit(PxU64(groups));
+
+		for(;;)
+		{
+			const PxI64 mask = mParkedMasks[group];
+			if(!mask)
+				break;
+
+			const PxU32 index = PxLowestSetBit(PxU64(mask));
+			const PxI64 newMask = mask & ~(PxI64(1) << index);
+			if(PxAtomicCompareExchange(&mParkedMasks[group], newMask, mask) == mask)
+			{
+				mWorkerThreads[mGroupStarts[group] + index].mWake.set();
+				return;
+			}
+		}
+
+		// PT: nobody is parked in this group anymore. Clear its summary bit, then re-check the group in case
+		// a worker parked in the meantime, so that its summary bit is never lost.
+		const PxI64 groupBit = PxI64(1) << group;
+		PxAtomicAnd(&mParkedGroups, ~groupBit);
+		if(mParkedMasks[group])
+			PxAtomicOr(&mParkedGroups, groupBit);
+
+		groups = mParkedGroups;
+	}
+}
@@ -0,0 +1,195 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef EXT_WORK_STEALING_CPU_DISPATCHER_H
+#define EXT_WORK_STEALING_CPU_DISPATCHER_H
+
+#include "common/PxProfileZone.h"
+#include "task/PxTask.h"
+#include "extensions/PxDefaultCpuDispatcher.h"
+
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxThread.h"
+#include "ExtTaskQueueHelper.h"
+#include "ExtWorkStealingDeque.h"
+#include "ExtCpuTopology.h"
+
+namespace physx
+{
+
+#define EXT_WORK_STEALING_MIN_GROUP_SIZE	8	// Minimum number of workers per parking group, when no placement is given
+#define EXT_WORK_STEALING_MAX_GROUP_SIZE	64	// One bit per worker in a group parking mask
+#define EXT_WORK_STEALING_MAX_NB_GROUPS		64	// One bit per group in the parking summary mask
+
+namespace Ext
+{
+	class WorkStealingCpuDispatcher;
+
+#if PX_VC
+#pragma warning(push)
+#pragma warning(disable:4324)	// Padding was added at the end of a structure because of a __declspec(align) value.
+#endif							// Because of the SList member I assume
+
+	class WorkStealingWorkerThread : public PxThread
+	{
+	public:
+												WorkStealingWorkerThread();
+												~WorkStealingWorkerThread();
+
+		PX_FORCE_INLINE	void					initialize(WorkStealingCpuDispatcher* ownerDispatcher, PxU32 index, PxU32 group)
+												{
+													mOwner = ownerDispatcher;
+													mIndex = index;
+													mGroup = group;
+													mRandomState = index + 1;
+												}
+
+		// PT: workers are sorted so that the workers of a group, and of a node, form contiguous ranges
+		PX_FORCE_INLINE	void					setNeighbors(PxU32 groupBegin, PxU32 groupEnd, PxU32 nodeBegin, PxU32 nodeEnd)
+												{
+													mGroupBegin = groupBegin;
+													mGroupEnd = groupEnd;
+													mNodeBegin = nodeBegin;
+													mNodeEnd = nodeEnd;
+												}
+
+		PX_FORCE_INLINE	PxU32					getIndex()		const	{ return mIndex;		}
+		PX_FORCE_INLINE	PxU32					getGroup()		const	{ return mGroup;		}
+		PX_FORCE_INLINE	PxU32					getGroupBegin()	const	{ return mGroupBegin;	}
+		PX_FORCE_INLINE	PxU32					getGroupEnd()	const	{ return mGroupEnd;		}
+		PX_FORCE_INLINE	PxU32					getNodeBegin()	const	{ return mNodeBegin;	}
+		PX_FORCE_INLINE	PxU32					getNodeEnd()	const	{ return mNodeEnd;		}
+
+		// PT: xorshift32, only used to pick steal victims
+		PX_FORCE_INLINE	PxU32					random()
+												{
+													PxU32 x = mRandomState;
+													x ^= x << 13;
+													x ^= x >> 17;
+													x ^= x << 5;
+													mRandomState = x;
+													return x;
+												}
+
+						void					execute();
+
+						WorkStealingDeque		mDeque;
+						PxSync					mWake;
+	protected:
+						WorkStealingCpuDispatcher*	mOwner;
+						PxU32					mIndex;
+						PxU32					mGroup;
+						PxU32					mGroupBegin;
+						PxU32					mGroupEnd;
+						PxU32					mNodeBegin;
+						PxU32					mNodeEnd;
+						PxU32					mRandomState;
+	};
+
+	// PT: dispatcher for PxDefaultCpuDispatcherSchedulingMode::eWORK_STEALING.
+	//
+	// Each worker owns a WorkStealingDeque. Tasks submitted from a worker thread (which is the common case, since most
+	// PhysX tasks are spawned by other tasks) go to that worker's deque. The submitting worker is found through TLS.
+	// Tasks submitted from other threads, high priority tasks and deque overflows go to a shared TaskQueueHelper.
+	//
+	// In eWAIT_FOR_WORK mode idle workers park on their own PxSync. Parked workers are tracked in a two-level hierarchy:
+	// one 64-bit mask per group of workers, plus one summary mask with a bit per group that may contain parked workers.
+	// A submit wakes a single parked worker, preferably from the submitter's own group, instead of broadcasting a
+	// signal to all threads.
+	//
+	// Groups and NUMA nodes come from an optional array of WorkerPlacement. Without it, workers are split into groups of
+	// EXT_WORK_STEALING_MIN_GROUP_SIZE consecutive threads on a single node. Thieves try victims of their own group first,
+	// then of their own node, then all other workers, so that a task preferably runs close to where it was submitted.
+	class WorkStealingCpuDispatcher : public PxDefaultCpuDispatcher, public PxUserAllocated
+	{
+																		PX_NOCOPY(WorkStealingCpuDispatcher)
+	private:
+																		~WorkStealingCpuDispatcher();
+	public:
+																		WorkStealingCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, const WorkerPlacement* placements, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount);
+
+		// PxCpuDispatcher
+		virtual			void											submitTask(PxBaseTask& task)		PX_OVERRIDE;
+		virtual			PxU32											getWorkerCount()	const			PX_OVERRIDE	{ return mNumThreads;			}
+		//~PxCpuDispatcher
+
+		// PxDefaultCpuDispatcher
+		virtual			void											release()							PX_OVERRIDE;
+		virtual			void											setRunProfiled(bool runProfiled)	PX_OVERRIDE	{ mRunProfiled = runProfiled;	}
+		virtual			bool											getRunProfiled()	const			PX_OVERRIDE	{ return mRunProfiled;			}
+		//~PxDefaultCpuDispatcher
+
+						PxBaseTask*										fetchNextTask(WorkStealingWorkerThread& worker);
+						PxBaseTask*										park(WorkStealingWorkerThread& worker);
+
+		PX_FORCE_INLINE	void											runTask(PxBaseTask& task)
+																		{
+																			if(mRunProfiled)
+																			{
+																				PX_PROFILE_ZONE(task.getName(), task.getContextId());
+																				task.run();
+																			}
+																			else
+																				task.run();
+																		}
+
+		PX_FORCE_INLINE	PxU32											getTlsIndex()				const	{ return mTlsIndex;				}
+		PX_FORCE_INLINE	PxDefaultCpuDispatcherWaitForWorkMode::Enum		getWaitForWorkMode()		const	{ return mWaitForWorkMode;		}
+		PX_FORCE_INLINE	PxU32											getYieldProcessorCount()	const	{ return mYieldProcessorCount;	}
+		PX_FORCE_INLINE	bool											isShuttingDown()			const	{ return mShuttingDown;			}
+
+	protected:
+						PxBaseTask*										stealTask(WorkStealingWorkerThread& thief);
+						PxBaseTask*										stealTask(WorkStealingWorkerThread& thief, PxU32 begin, PxU32 end, PxU32 excludeBegin, PxU32 excludeEnd);
+						bool											hasStealableTask()	const;
+						void											wakeOne(PxU32 preferredGroup);
+
+						WorkStealingWorkerThread*						mWorkerThreads;
+						TaskQueueHelper									mHelper;
+						volatile PxI64*									mParkedMasks;	// One mask per group, bit i set if worker (mGroupStarts[group] + i) is parked
+						volatile PxI64									mParkedGroups;	// Bit g set if group g may contain parked workers
+						PxU32*											mGroupStarts;	// Index of the first worker of each group, plus one terminal entry
+						PxU8*											mThreadNames;
+						PxU32											mNumThreads;
+						PxU32											mNbGroups;
+						PxU32											mTlsIndex;
+						volatile bool									mShuttingDown;
+						bool											mRunProfiled;
+		const			PxDefaultCpuDispatcherWaitForWorkMode::Enum		mWaitForWorkMode;
+		const			PxU32											mYieldProcessorCount;
+	};
+
+#if PX_VC
+#pragma warning(pop)
+#endif
+
+} // namespace Ext
+}
+
+#endif
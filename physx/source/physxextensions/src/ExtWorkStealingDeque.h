@@ -0,0 +1,141 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef EXT_WORK_STEALING_DEQUE_H
+#define EXT_WORK_STEALING_DEQUE_H
+
+#include "foundation/PxAllocator.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxIntrinsics.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxTask.h"
+
+namespace physx
+{
+
+#define EXT_WORK_STEALING_DEQUE_SIZE	1024	// Must be a power of two
+
+namespace Ext
+{
+	// PT: fixed-capacity Chase-Lev deque (see "Dynamic Circular Work-Stealing Deque", Chase & Lev 2005, and
+	// "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013).
+	//
+	// The owner thread pushes and pops at the bottom, any other thread steals from the top. Only the last
+	// remaining element is contended between the owner and the thieves, and that case is arbitrated with a
+	// single CAS on the top index. The buffer does not grow: push() fails when the deque is full and the
+	// caller is expected to fall back to a shared queue. This avoids having to reclaim old buffers that a
+	// concurrent thief could still be reading from.
+	//
+	// Indices are 64-bit so that they never wrap around in practice.
+	class WorkStealingDeque : public PxUserAllocated
+	{
+		PX_NOCOPY(WorkStealingDeque)
+	public:
+		WorkStealingDeque() : mTop(0), mBottom(0)
+		{
+			for(PxU32 i=0; i<EXT_WORK_STEALING_DEQUE_SIZE; i++)
+				mTasks[i] = NULL;
+		}
+
+		// Owner thread only.
+		PX_FORCE_INLINE	bool	push(PxBaseTask& task)
+		{
+			const PxI64 b = mBottom;
+			const PxI64 t = mTop;
+			if(b - t >= EXT_WORK_STEALING_DEQUE_SIZE)
+				return false;
+
+			mTasks[b & (EXT_WORK_STEALING_DEQUE_SIZE-1)] = &task;
+			// PT: the task must be visible before the new bottom
+			PxMemoryBarrier();
+			mBottom = b + 1;
+			return true;
+		}
+
+		// Owner thread only.
+		PX_FORCE_INLINE	PxBaseTask*	pop()
+		{
+			const PxI64 b = mBottom - 1;
+			mBottom = b;
+			// PT: the new bottom must be visible to thieves before we read the top
+			PxMemoryBarrier();
+			const PxI64 t = mTop;
+
+			if(t > b)
+			{
+				// PT: deque was empty
+				mBottom = b + 1;
+				return NULL;
+			}
+
+			PxBaseTask* task = mTasks[b & (EXT_WORK_STEALING_DEQUE_SIZE-1)];
+			if(t == b)
+			{
+				// PT: last element, race against thieves
+				if(PxAtomicCompareExchange(&mTop, t + 1, t) != t)
+					task = NULL;
+				mBottom = b + 1;
+			}
+			return task;
+		}
+
+		// Any thread. Returns NULL if the deque is empty or if another thread won the race for the top element.
+		PX_FORCE_INLINE	PxBaseTask*	steal()
+		{
+			const PxI64 t = mTop;
+			PxMemoryBarrier();
+			const PxI64 b = mBottom;
+			if(t >= b)
+				return NULL;
+
+			PxBaseTask* task = mTasks[t & (EXT_WORK_STEALING_DEQUE_SIZE-1)];
+			if(PxAtomicCompareExchange(&mTop, t + 1, t) != t)
+				return NULL;
+			return task;
+		}
+
+		// Any thread. Approximate, only used as a hint.
+		PX_FORCE_INLINE	bool	isEmpty()	const
+		{
+			return mBottom <= mTop;
+		}
+
+	private:
+		// PT: top and bottom are written by different threads, keep them on separate cache lines
+		volatile PxI64			mTop;
+		PxU8					mPad0[128 - sizeof(PxI64)];
+		volatile PxI64			mBottom;
+		PxU8					mPad1[128 - sizeof(PxI64)];
+		PxBaseTask* volatile	mTasks[EXT_WORK_STEALING_DEQUE_SIZE];
+	};
+
+} // namespace Ext
+
+}
+
+#endif
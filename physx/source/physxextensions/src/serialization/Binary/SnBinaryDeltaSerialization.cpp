@@ -0,0 +1,396 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "common/PxSerializer.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxPhysicsVersion.h"
+#include "extensions/PxSerialization.h"
+#include "PxAggregate.h"
+#include "PxShape.h"
+#include "serialization/SnSerialUtils.h"
+#include "CmCollection.h"
+
+using namespace physx;
+using namespace Cm;
+using namespace Sn;
+
+//------------------------------------------------------------------------------------
+//// Binary Serialized delta, format documentation
+//------------------------------------------------------------------------------------
+// header SEDB
+// PX_PHYSICS_VERSION
+// PxU32 nbRemovedIds
+// PxU32 reserved
+// (PxSerialObjectId id)*nbRemovedIds
+// alignment to PX_SERIAL_FILE_ALIGN
+// binary serialized collection of the written objects, see SnBinarySerialization.cpp
+//------------------------------------------------------------------------------------
+
+namespace
+{
+	const PxU32 gDeltaHeaderTag = PX_MAKE_FOURCC('S','E','D','B');
+
+	class SerializationManifest : public PxSerializationManifest, public PxUserAllocated
+	{
+	public:
+		virtual	PxU32	getNbObjects()	const	PX_OVERRIDE	{ return mHashes.size();	}
+
+		virtual	bool	getContentHash(PxSerialObjectId id, PxU64& hash)	const	PX_OVERRIDE
+		{
+			const HashMap::Entry* e = mHashes.find(id);
+			if(!e)
+				return false;
+			hash = e->second;
+			return true;
+		}
+
+		virtual	void	release()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+
+		typedef PxHashMap<PxSerialObjectId, PxU64> HashMap;
+		HashMap	mHashes;
+	};
+
+	// Serialization context computing a FNV-1a hash of the exported object data instead of writing it.
+	class ContentHashStream : public PxSerializationContext
+	{
+	public:
+		ContentHashStream(const PxCollection& collection) : mCollection(collection), mHash(14695981039346656037ull), mSize(0) {}
+
+		virtual void	writeData(const void* buffer, PxU32 size)	PX_OVERRIDE
+		{
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(buffer);
+			for(PxU32 i=0;i<size;i++)
+				mHash = (mHash ^ bytes[i]) * 1099511628211ull;
+			mSize += size;
+		}
+
+		virtual void	alignData(PxU32 alignment)	PX_OVERRIDE
+		{
+			if(!alignment)
+				return;
+
+			const PxU8 zero = 0;
+			PxU32 bytesToPad = getPadding(mSize, alignment);
+			while(bytesToPad--)
+				writeData(&zero, 1);
+		}
+
+		virtual void	registerReference(PxBase&, PxU32, size_t)	PX_OVERRIDE
+		{
+			PxGetFoundation().error(physx::PxErrorCode::eINVALID_OPERATION, PX_FL, 
+					"Cannot register references during exportData, exportExtraData.");
+		}
+
+		virtual const PxCollection& getCollection() const	PX_OVERRIDE
+		{
+			return mCollection;
+		}
+
+		virtual void	writeName(const char* name)	PX_OVERRIDE
+		{
+			const PxU32 len = name ? PxU32(strlen(name)) + 1 : 0;
+			writeData(&len, sizeof(len));
+			if(len) writeData(name, len);
+		}
+
+		PxU64	getHash()	const	{ return mHash;	}
+
+	private:
+		ContentHashStream& operator=(const ContentHashStream&);
+		const PxCollection& mCollection;
+		PxU64 mHash;
+		PxU32 mSize;
+	};
+
+	PxU64 computeContentHash(PxBase& object, const PxSerializer& serializer, const PxCollection& collection)
+	{
+		ContentHashStream stream(collection);
+		serializer.exportData(object, stream);
+		stream.alignData(PX_SERIAL_ALIGN);
+		serializer.exportExtraData(object, stream);
+		return stream.getHash();
+	}
+
+	bool computeContentHashes(PxArray<PxU64>& hashes, const Collection& collection, PxSerializationRegistry& sr, const char* caller)
+	{
+		const PxU32 nb = collection.internalGetNbObjects();
+		hashes.resize(nb);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxBase* s = collection.internalGetObject(i);
+			const PxSerializer* serializer = sr.getSerializer(s->getConcreteType());
+			if(!serializer)
+				return PxGetFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, PX_FL, 
+					"%s: No serializer registered for concrete type %d.", caller, s->getConcreteType());
+			hashes[i] = computeContentHash(*s, *serializer, collection);
+		}
+		return true;
+	}
+
+	// Owned objects store references back to their owner (articulation links and joints) or are attached
+	// by their owner on deserialization (exclusive shapes, aggregated actors), so an owner and the objects
+	// it owns can only be written together.
+	bool isOwnedReference(PxBase& owner, PxBase& required, PxSerializationRegistry& sr)
+	{
+		const PxSerializer* serializer = sr.getSerializer(required.getConcreteType());
+		if(serializer && serializer->isSubordinate())
+			return true;
+
+		const PxShape* shape = required.is<PxShape>();
+		if(shape && shape->isExclusive())
+			return true;
+
+		return owner.is<PxAggregate>() != NULL;
+	}
+
+	struct Dependency
+	{
+		PxU32	owner;
+		PxU32	required;
+		bool	owned;
+	};
+
+	struct DependencyCallback : public PxProcessPxBaseCallback
+	{
+		DependencyCallback(const Collection& c, PxSerializationRegistry& r, PxArray<Dependency>& d) : collection(c), sr(r), dependencies(d), owner(NULL), ownerIndex(0) {}
+
+		virtual void process(PxBase& base)	PX_OVERRIDE
+		{
+			const Collection::ObjectToIdMap::Entry* e = collection.mObjects.find(&base);
+			if(!e)
+				return;
+
+			Dependency d;
+			d.owner = ownerIndex;
+			d.required = PxU32(e - collection.internalGetObjects());
+			d.owned = isOwnedReference(*owner, base, sr);
+			dependencies.pushBack(d);
+		}
+
+		const Collection& collection;
+		PxSerializationRegistry& sr;
+		PxArray<Dependency>& dependencies;
+		PxBase* owner;
+		PxU32 ownerIndex;
+		PX_NOCOPY(DependencyCallback)
+	};
+
+	void writeDeltaHeader(PxOutputStream& outputStream, const PxArray<PxSerialObjectId>& removedIds)
+	{
+		const PxU32 header[4] = { gDeltaHeaderTag, PX_PHYSICS_VERSION, removedIds.size(), 0 };
+		PxU32 size = outputStream.write(header, sizeof(header));
+		size += outputStream.write(removedIds.begin(), removedIds.size()*sizeof(PxSerialObjectId));
+
+		// the collection data that follows has to start on a file aligned address
+		const PxU8 padding[PX_SERIAL_FILE_ALIGN] = { 0 };
+		outputStream.write(padding, getPadding(size, PX_SERIAL_FILE_ALIGN));
+	}
+}
+
+PxSerializationManifest* PxSerialization::createSerializationManifest(PxCollection& pxCollection, PxSerializationRegistry& sr)
+{
+	const Collection& collection = static_cast<Collection&>(pxCollection);
+
+	PxArray<PxU64> hashes;
+	if(!computeContentHashes(hashes, collection, sr, "PxSerialization::createSerializationManifest"))
+		return NULL;
+
+	SerializationManifest* manifest = PX_NEW(SerializationManifest);
+	const PxU32 nb = collection.internalGetNbObjects();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxSerialObjectId id = collection.internalGetObjects()[i].second;
+		if(id != PX_SERIAL_OBJECT_ID_INVALID)
+			manifest->mHashes[id] = hashes[i];
+	}
+	return manifest;
+}
+
+bool PxSerialization::serializeCollectionDeltaToBinary(PxOutputStream& outputStream, PxCollection& pxCollection, PxSerializationRegistry& sr, PxSerializationManifest& pxManifest, bool exportNames, bool updateManifest)
+{
+	const Collection& collection = static_cast<Collection&>(pxCollection);
+	SerializationManifest& manifest = static_cast<SerializationManifest&>(pxManifest);
+	const PxU32 nb = collection.internalGetNbObjects();
+
+	PxArray<PxU64> hashes;
+	if(!computeContentHashes(hashes, collection, sr, "PxSerialization::serializeCollectionDeltaToBinary"))
+		return false;
+
+	// objects without id, unknown to the manifest or with a changed content hash are written
+	PxArray<bool> written(nb);
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxSerialObjectId id = collection.internalGetObjects()[i].second;
+		PxU64 hash;
+		written[i] = id == PX_SERIAL_OBJECT_ID_INVALID || !manifest.getContentHash(id, hash) || hash != hashes[i];
+	}
+
+	// an object referencing a written object has to be written as well, so that the resident version keeps
+	// pointing to the resident version of its references. Owned objects are written along with their owner.
+	{
+		PxArray<Dependency> dependencies;
+		DependencyCallback callback(collection, sr, dependencies);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			callback.owner = collection.internalGetObject(i);
+			callback.ownerIndex = i;
+			sr.getSerializer(callback.owner->getConcreteType())->requiresObjects(*callback.owner, callback);
+		}
+
+		bool propagated = true;
+		while(propagated)
+		{
+			propagated = false;
+			for(PxU32 i=0;i<dependencies.size();i++)
+			{
+				const Dependency& d = dependencies[i];
+				if(written[d.required] && !written[d.owner])
+				{
+					written[d.owner] = true;
+					propagated = true;
+				}
+				if(d.owned && written[d.owner] && !written[d.required])
+				{
+					written[d.required] = true;
+					propagated = true;
+				}
+			}
+		}
+	}
+
+	PxArray<PxSerialObjectId> removedIds;
+	for(SerializationManifest::HashMap::Iterator iter = manifest.mHashes.getIterator(); !iter.done(); ++iter)
+	{
+		if(!collection.find(iter->first))
+			removedIds.pushBack(iter->first);
+	}
+
+	PxCollection* writtenObjects = PxCreateCollection();
+	PxCollection* residentObjects = PxCreateCollection();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const Collection::ObjectToIdMap::Entry& e = collection.internalGetObjects()[i];
+		if(written[i])
+			writtenObjects->add(*e.first, e.second);
+		else
+			residentObjects->add(*e.first, e.second);
+	}
+
+	bool success = PxSerialization::isSerializable(*writtenObjects, sr, residentObjects);
+	if(success)
+	{
+		writeDeltaHeader(outputStream, removedIds);
+		success = PxSerialization::serializeCollectionToBinary(outputStream, *writtenObjects, sr, residentObjects, exportNames);
+	}
+
+	writtenObjects->release();
+	residentObjects->release();
+
+	if(success && updateManifest)
+	{
+		for(PxU32 i=0;i<removedIds.size();i++)
+			manifest.mHashes.erase(removedIds[i]);
+
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxSerialObjectId id = collection.internalGetObjects()[i].second;
+			if(id != PX_SERIAL_OBJECT_ID_INVALID)
+				manifest.mHashes[id] = hashes[i];
+		}
+	}
+
+	return success;
+}
+
+PxCollection* PxSerialization::createCollectionFromBinaryDelta(void* memBlock, PxSerializationRegistry& sr, PxCollection& base, PxCollection* replacedObjects)
+{
+	if(size_t(memBlock) & (PX_SERIAL_FILE_ALIGN-1))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "Buffer must be 128-bytes aligned.");
+		return NULL;
+	}
+
+	PxU8* address = reinterpret_cast<PxU8*>(memBlock);
+	const PxU32* header = reinterpret_cast<const PxU32*>(address);
+	if(header[0] != gDeltaHeaderTag)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, 
+			"Buffer contains data with wrong header indicating invalid binary delta data.");
+		return NULL;
+	}
+
+	if(header[1] != PX_PHYSICS_VERSION)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, 
+			"Buffer contains binary delta data of PhysX version 0x%x and is incompatible with this PhysX sdk (0x%x).", header[1], PX_PHYSICS_VERSION);
+		return NULL;
+	}
+
+	const PxU32 nbRemovedIds = header[2];
+	const PxSerialObjectId* removedIds = reinterpret_cast<const PxSerialObjectId*>(address + 4*sizeof(PxU32));
+	const PxU32 headerSize = 4*sizeof(PxU32) + nbRemovedIds*sizeof(PxSerialObjectId);
+	address += headerSize + getPadding(headerSize, PX_SERIAL_FILE_ALIGN);
+
+	// objects the delta does not contain are imported from the resident base collection
+	PxCollection* collection = PxSerialization::createCollectionFromBinary(address, sr, &base);
+	if(!collection)
+		return NULL;
+
+	for(PxU32 i=0;i<nbRemovedIds;i++)
+	{
+		PxBase* removed = base.find(removedIds[i]);
+		if(removed)
+		{
+			base.remove(*removed);
+			if(replacedObjects)
+				replacedObjects->add(*removed);
+		}
+	}
+
+	// objects without id are written with every delta and can not be referenced by later deltas, so only
+	// objects with an id become resident
+	const PxU32 nb = collection->getNbObjects();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		PxBase& object = collection->getObject(i);
+		const PxSerialObjectId id = collection->getId(object);
+		if(id == PX_SERIAL_OBJECT_ID_INVALID)
+			continue;
+
+		PxBase* replaced = base.find(id);
+		if(replaced)
+		{
+			base.remove(*replaced);
+			if(replacedObjects)
+				replacedObjects->add(*replaced);
+		}
+		base.add(object, id);
+	}
+
+	return collection;
+}
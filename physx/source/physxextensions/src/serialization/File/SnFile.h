@@ -34,6 +34,7 @@
 
 #if PX_WINDOWS_FAMILY
 
+#include "foundation/windows/PxWindowsInclude.h"
 #include <stdio.h>
 
 namespace physx
@@ -53,12 +54,74 @@ PX_INLINE PxI32 fopen_s(FILE** file, const char* name, const char* mode)
 	return i == MAX_LEN ? -1 : ::fopen_s(file, buf, mode);
 };
 
+// maps a file copy-on-write, returns NULL on failure
+PX_INLINE void* mapFile(const char* name, PxU64& size)
+{
+	HANDLE file = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	void* data = NULL;
+	LARGE_INTEGER fileSize;
+	// the whole file is mapped, so it has to fit into the address space
+	if(GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && PxU64(fileSize.QuadPart) <= PxU64(size_t(-1)))
+	{
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+		if(mapping)
+		{
+			data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+			if(data)
+				size = PxU64(fileSize.QuadPart);
+			// the view keeps the mapping alive
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+	return data;
+}
+
+PX_INLINE void unmapFile(void* data, PxU64)
+{
+	UnmapViewOfFile(data);
+}
+
+// opens or creates a lock file and locks it exclusively, waiting for other processes to unlock it. Returns NULL on failure.
+PX_INLINE void* lockFile(const char* name)
+{
+	HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	OVERLAPPED overlapped = {};
+	if(!LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped))
+	{
+		CloseHandle(file);
+		return NULL;
+	}
+	return file;
+}
+
+PX_INLINE void unlockFile(void* lock)
+{
+	OVERLAPPED overlapped = {};
+	UnlockFileEx(lock, 0, 1, 0, &overlapped);
+	CloseHandle(lock);
+}
+
 } // namespace sn
 } // namespace physx
 
 #elif PX_UNIX_FAMILY || PX_SWITCH
 
 #include <stdio.h>
+#if PX_UNIX_FAMILY
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace physx
 {
@@ -74,6 +137,84 @@ PX_INLINE PxI32 fopen_s(FILE** file, const char* name, const char* mode)
 	}
 	return -1;
 }
+
+// maps a file copy-on-write, returns NULL on failure
+PX_INLINE void* mapFile(const char* name, PxU64& size)
+{
+#if PX_UNIX_FAMILY
+	const int fd = ::open(name, O_RDONLY);
+	if(fd < 0)
+		return NULL;
+
+	void* data = NULL;
+	struct stat st;
+	// the whole file is mapped, so it has to fit into the address space
+	if(::fstat(fd, &st) == 0 && st.st_size > 0 && PxU64(st.st_size) <= PxU64(size_t(-1)))
+	{
+		data = ::mmap(NULL, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED)
+			data = NULL;
+		else
+			size = PxU64(st.st_size);
+	}
+	// the mapping stays valid after closing the descriptor
+	::close(fd);
+	return data;
+#else
+	PX_UNUSED(name);
+	PX_UNUSED(size);
+	return NULL;
+#endif
+}
+
+PX_INLINE void unmapFile(void* data, PxU64 size)
+{
+#if PX_UNIX_FAMILY
+	::munmap(data, size_t(size));
+#else
+	PX_UNUSED(data);
+	PX_UNUSED(size);
+#endif
+}
+
+// opens or creates a lock file and locks it exclusively, waiting for other processes to unlock it. Returns NULL on failure.
+PX_INLINE void* lockFile(const char* name)
+{
+#if PX_UNIX_FAMILY
+	const int fd = ::open(name, O_RDWR | O_CREAT, 0666);
+	if(fd < 0)
+		return NULL;
+
+	int result;
+	do
+	{
+		result = ::flock(fd, LOCK_EX);
+	} while(result != 0 && errno == EINTR);
+
+	if(result != 0)
+	{
+		::close(fd);
+		return NULL;
+	}
+	// offset by one so that descriptor 0 is not returned as NULL
+	return reinterpret_cast<void*>(size_t(fd) + 1);
+#else
+	// single process platforms, no locking needed
+	PX_UNUSED(name);
+	return reinterpret_cast<void*>(size_t(1));
+#endif
+}
+
+PX_INLINE void unlockFile(void* lock)
+{
+#if PX_UNIX_FAMILY
+	const int fd = int(size_t(lock) - 1);
+	::flock(fd, LOCK_UN);
+	::close(fd);
+#else
+	PX_UNUSED(lock);
+#endif
+}
 } // namespace sn
 } // namespace physx
 #else
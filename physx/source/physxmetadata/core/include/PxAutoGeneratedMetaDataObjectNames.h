@@ -495,6 +495,9 @@ PxSimulationStatistics_NbLostPairs,
 PxSimulationStatistics_NbNewTouches,
 PxSimulationStatistics_NbLostTouches,
 PxSimulationStatistics_NbPartitions,
+PxSimulationStatistics_NbCCDSweeps,
+PxSimulationStatistics_NbCCDToiHits,
+PxSimulationStatistics_NbCCDPasses,
 PxSimulationStatistics_GpuMemParticles,
 PxSimulationStatistics_GpuMemDeformableSurfaces,
 PxSimulationStatistics_GpuMemDeformableVolumes,
@@ -2570,6 +2570,7 @@ template<> struct PxEnumTraits< physx::PxVisualizationParameter::Enum > { PxEnum
 		{ "eABP", static_cast<PxU32>( physx::PxBroadPhaseType::eABP ) },
 		{ "ePABP", static_cast<PxU32>( physx::PxBroadPhaseType::ePABP ) },
 		{ "eGPU", static_cast<PxU32>( physx::PxBroadPhaseType::eGPU ) },
+		{ "eHGRID", static_cast<PxU32>( physx::PxBroadPhaseType::eHGRID ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxBroadPhaseType::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -3903,6 +3904,9 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxU32 NbNewTouches;
 		PxU32 NbLostTouches;
 		PxU32 NbPartitions;
+		PxU32 NbCCDSweeps;
+		PxU32 NbCCDToiHits;
+		PxU32 NbCCDPasses;
 		PxU64 GpuMemParticles;
 		PxU64 GpuMemDeformableSurfaces;
 		PxU64 GpuMemDeformableVolumes;
@@ -3953,6 +3957,9 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbNewTouches, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbLostTouches, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbPartitions, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbCCDSweeps, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbCCDToiHits, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbCCDPasses, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, GpuMemParticles, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, GpuMemDeformableSurfaces, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, GpuMemDeformableVolumes, PxSimulationStatisticsGeneratedValues)
@@ -4005,6 +4012,9 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbNewTouches, PxSimulationStatistics, PxU32, PxU32 > NbNewTouches;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbLostTouches, PxSimulationStatistics, PxU32, PxU32 > NbLostTouches;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbPartitions, PxSimulationStatistics, PxU32, PxU32 > NbPartitions;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbCCDSweeps, PxSimulationStatistics, PxU32, PxU32 > NbCCDSweeps;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbCCDToiHits, PxSimulationStatistics, PxU32, PxU32 > NbCCDToiHits;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbCCDPasses, PxSimulationStatistics, PxU32, PxU32 > NbCCDPasses;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_GpuMemParticles, PxSimulationStatistics, PxU64, PxU64 > GpuMemParticles;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_GpuMemDeformableSurfaces, PxSimulationStatistics, PxU64, PxU64 > GpuMemDeformableSurfaces;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_GpuMemDeformableVolumes, PxSimulationStatistics, PxU64, PxU64 > GpuMemDeformableVolumes;
@@ -4052,7 +4062,7 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			PX_UNUSED(inStartIndex);
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 48; }
+		static PxU32 instancePropertyCount() { return 51; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount(); }
 		template<typename TOperator>
 		PxU32 visitInstanceProperties( TOperator inOperator, PxU32 inStartIndex = 0 ) const
@@ -4079,35 +4089,38 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			inOperator( NbNewTouches, inStartIndex + 17 );; 
 			inOperator( NbLostTouches, inStartIndex + 18 );; 
 			inOperator( NbPartitions, inStartIndex + 19 );; 
-			inOperator( GpuMemParticles, inStartIndex + 20 );; 
-			inOperator( GpuMemDeformableSurfaces, inStartIndex + 21 );; 
-			inOperator( GpuMemDeformableVolumes, inStartIndex + 22 );; 
-			inOperator( GpuMemSoftBodies, inStartIndex + 23 );; 
-			inOperator( GpuMemHeap, inStartIndex + 24 );; 
-			inOperator( GpuMemHeapBroadPhase, inStartIndex + 25 );; 
-			inOperator( GpuMemHeapNarrowPhase, inStartIndex + 26 );; 
-			inOperator( GpuMemHeapSolver, inStartIndex + 27 );; 
-			inOperator( GpuMemHeapArticulation, inStartIndex + 28 );; 
-			inOperator( GpuMemHeapSimulation, inStartIndex + 29 );; 
-			inOperator( GpuMemHeapSimulationArticulation, inStartIndex + 30 );; 
-			inOperator( GpuMemHeapSimulationParticles, inStartIndex + 31 );; 
-			inOperator( GpuMemHeapSimulationDeformableSurface, inStartIndex + 32 );; 
-			inOperator( GpuMemHeapSimulationDeformableVolume, inStartIndex + 33 );; 
-			inOperator( GpuMemHeapSimulationSoftBody, inStartIndex + 34 );; 
-			inOperator( GpuMemHeapParticles, inStartIndex + 35 );; 
-			inOperator( GpuMemHeapDeformableSurfaces, inStartIndex + 36 );; 
-			inOperator( GpuMemHeapDeformableVolumes, inStartIndex + 37 );; 
-			inOperator( GpuMemHeapSoftBodies, inStartIndex + 38 );; 
-			inOperator( GpuMemHeapOther, inStartIndex + 39 );; 
-			inOperator( GpuDynamicsMemoryConfigStatistics, inStartIndex + 40 );; 
-			inOperator( NbBroadPhaseAdds, inStartIndex + 41 );; 
-			inOperator( NbBroadPhaseRemoves, inStartIndex + 42 );; 
-			inOperator( NbDiscreteContactPairs, inStartIndex + 43 );; 
-			inOperator( NbModifiedContactPairs, inStartIndex + 44 );; 
-			inOperator( NbCCDPairs, inStartIndex + 45 );; 
-			inOperator( NbTriggerPairs, inStartIndex + 46 );; 
-			inOperator( NbShapes, inStartIndex + 47 );; 
-			return 48 + inStartIndex;
+			inOperator( NbCCDSweeps, inStartIndex + 20 );; 
+			inOperator( NbCCDToiHits, inStartIndex + 21 );; 
+			inOperator( NbCCDPasses, inStartIndex + 22 );; 
+			inOperator( GpuMemParticles, inStartIndex + 23 );; 
+			inOperator( GpuMemDeformableSurfaces, inStartIndex + 24 );; 
+			inOperator( GpuMemDeformableVolumes, inStartIndex + 25 );; 
+			inOperator( GpuMemSoftBodies, inStartIndex + 26 );; 
+			inOperator( GpuMemHeap, inStartIndex + 27 );; 
+			inOperator( GpuMemHeapBroadPhase, inStartIndex + 28 );; 
+			inOperator( GpuMemHeapNarrowPhase, inStartIndex + 29 );; 
+			inOperator( GpuMemHeapSolver, inStartIndex + 30 );; 
+			inOperator( GpuMemHeapArticulation, inStartIndex + 31 );; 
+			inOperator( GpuMemHeapSimulation, inStartIndex + 32 );; 
+			inOperator( GpuMemHeapSimulationArticulation, inStartIndex + 33 );; 
+			inOperator( GpuMemHeapSimulationParticles, inStartIndex + 34 );; 
+			inOperator( GpuMemHeapSimulationDeformableSurface, inStartIndex + 35 );; 
+			inOperator( GpuMemHeapSimulationDeformableVolume, inStartIndex + 36 );; 
+			inOperator( GpuMemHeapSimulationSoftBody, inStartIndex + 37 );; 
+			inOperator( GpuMemHeapParticles, inStartIndex + 38 );; 
+			inOperator( GpuMemHeapDeformableSurfaces, inStartIndex + 39 );; 
+			inOperator( GpuMemHeapDeformableVolumes, inStartIndex + 40 );; 
+			inOperator( GpuMemHeapSoftBodies, inStartIndex + 41 );; 
+			inOperator( GpuMemHeapOther, inStartIndex + 42 );; 
+			inOperator( GpuDynamicsMemoryConfigStatistics, inStartIndex + 43 );; 
+			inOperator( NbBroadPhaseAdds, inStartIndex + 44 );; 
+			inOperator( NbBroadPhaseRemoves, inStartIndex + 45 );; 
+			inOperator( NbDiscreteContactPairs, inStartIndex + 46 );; 
+			inOperator( NbModifiedContactPairs, inStartIndex + 47 );; 
+			inOperator( NbCCDPairs, inStartIndex + 48 );; 
+			inOperator( NbTriggerPairs, inStartIndex + 49 );; 
+			inOperator( NbShapes, inStartIndex + 50 );; 
+			return 51 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSimulationStatistics>
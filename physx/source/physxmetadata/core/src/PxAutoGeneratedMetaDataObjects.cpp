@@ -1678,6 +1678,12 @@ inline PxU32 getPxSimulationStatisticsNbLostTouches( const PxSimulationStatistic
 inline void setPxSimulationStatisticsNbLostTouches( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbLostTouches = inData; }
 inline PxU32 getPxSimulationStatisticsNbPartitions( const PxSimulationStatistics* inOwner ) { return inOwner->nbPartitions; }
 inline void setPxSimulationStatisticsNbPartitions( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbPartitions = inData; }
+inline PxU32 getPxSimulationStatisticsNbCCDSweeps( const PxSimulationStatistics* inOwner ) { return inOwner->nbCCDSweeps; }
+inline void setPxSimulationStatisticsNbCCDSweeps( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbCCDSweeps = inData; }
+inline PxU32 getPxSimulationStatisticsNbCCDToiHits( const PxSimulationStatistics* inOwner ) { return inOwner->nbCCDToiHits; }
+inline void setPxSimulationStatisticsNbCCDToiHits( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbCCDToiHits = inData; }
+inline PxU32 getPxSimulationStatisticsNbCCDPasses( const PxSimulationStatistics* inOwner ) { return inOwner->nbCCDPasses; }
+inline void setPxSimulationStatisticsNbCCDPasses( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbCCDPasses = inData; }
 inline PxU64 getPxSimulationStatisticsGpuMemParticles( const PxSimulationStatistics* inOwner ) { return inOwner->gpuMemParticles; }
 inline void setPxSimulationStatisticsGpuMemParticles( PxSimulationStatistics* inOwner, PxU64 inData) { inOwner->gpuMemParticles = inData; }
 inline PxU64 getPxSimulationStatisticsGpuMemDeformableSurfaces( const PxSimulationStatistics* inOwner ) { return inOwner->gpuMemDeformableSurfaces; }
@@ -1745,6 +1751,9 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedInfo::PxSimulationStatisticsGen
 	, NbNewTouches( "NbNewTouches", setPxSimulationStatisticsNbNewTouches, getPxSimulationStatisticsNbNewTouches )
 	, NbLostTouches( "NbLostTouches", setPxSimulationStatisticsNbLostTouches, getPxSimulationStatisticsNbLostTouches )
 	, NbPartitions( "NbPartitions", setPxSimulationStatisticsNbPartitions, getPxSimulationStatisticsNbPartitions )
+	, NbCCDSweeps( "NbCCDSweeps", setPxSimulationStatisticsNbCCDSweeps, getPxSimulationStatisticsNbCCDSweeps )
+	, NbCCDToiHits( "NbCCDToiHits", setPxSimulationStatisticsNbCCDToiHits, getPxSimulationStatisticsNbCCDToiHits )
+	, NbCCDPasses( "NbCCDPasses", setPxSimulationStatisticsNbCCDPasses, getPxSimulationStatisticsNbCCDPasses )
 	, GpuMemParticles( "GpuMemParticles", setPxSimulationStatisticsGpuMemParticles, getPxSimulationStatisticsGpuMemParticles )
 	, GpuMemDeformableSurfaces( "GpuMemDeformableSurfaces", setPxSimulationStatisticsGpuMemDeformableSurfaces, getPxSimulationStatisticsGpuMemDeformableSurfaces )
 	, GpuMemDeformableVolumes( "GpuMemDeformableVolumes", setPxSimulationStatisticsGpuMemDeformableVolumes, getPxSimulationStatisticsGpuMemDeformableVolumes )
@@ -1790,6 +1799,9 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedValues::PxSimulationStatisticsG
 		,NbNewTouches( inSource->nbNewTouches )
 		,NbLostTouches( inSource->nbLostTouches )
 		,NbPartitions( inSource->nbPartitions )
+		,NbCCDSweeps( inSource->nbCCDSweeps )
+		,NbCCDToiHits( inSource->nbCCDToiHits )
+		,NbCCDPasses( inSource->nbCCDPasses )
 		,GpuMemParticles( inSource->gpuMemParticles )
 		,GpuMemDeformableSurfaces( inSource->gpuMemDeformableSurfaces )
 		,GpuMemDeformableVolumes( inSource->gpuMemDeformableVolumes )
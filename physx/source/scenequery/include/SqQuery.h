@@ -105,6 +105,12 @@ namespace Sq
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const;
 
+						PxU32						_raycastPacket(
+														PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,	// Ray data
+														PxRaycastBuffer* hitBuffers, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
+
 						bool						_sweep(
 														const PxGeometry& geometry, const PxTransform& pose,	// GeomObject data
 														const PxVec3& unitDir, const PxReal distance,			// Ray data
@@ -48,6 +48,7 @@ using namespace Sq;
 #include "geometry/PxTriangleMeshGeometry.h"
 
 #include "PxQueryFiltering.h"
+#include "foundation/PxBitUtils.h"
 
 using namespace physx;
 using namespace Sq;
@@ -938,6 +939,122 @@ bool SceneQueries::_raycast(
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// PT: per-ray state for packet raycasts. This mirrors the locals of multiQuery, in the same construction
+	// (and thus destruction) order, so that each ray of a packet reports its results exactly like _raycast.
+	struct RaycastPacketRay
+	{
+		RaycastPacketRay(	const SceneQueries& sq, const PxVec3& origin, const PxVec3& unitDir, PxReal distance, bool anyHit,
+							PxRaycastCallback& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+			mInput				(origin, unitDir, distance),
+#if PX_SUPPORT_PVD
+			mPvdCapture			(&sq, mInput, filterData, hits),
+#endif
+			mCallbacksOnReturn	(hits),
+			mCallback			(sq, mInput, anyHit, hits, hitFlags, filterData, filterCall, distance)
+		{
+			hits.hasBlock = false;
+			hits.nbTouches = 0;
+		}
+
+		MultiQueryInput							mInput;
+#if PX_SUPPORT_PVD
+		CapturePvdOnReturn<PxRaycastHit>		mPvdCapture;
+#endif
+		IssueCallbacksOnReturn<PxRaycastHit>	mCallbacksOnReturn;
+		MultiQueryCallback<PxRaycastHit>		mCallback;
+
+		PX_NOCOPY(RaycastPacketRay)
+	};
+}
+
+PxU32 SceneQueries::_raycastPacket(
+	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+	PxRaycastBuffer* hitBuffers, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.raycastPacket", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(!nbRays || (origins && unitDirs && distances && hitBuffers), "NpSceneQueries::raycastPacket: NULL ray data or hit buffers.", 0);
+#if PX_CHECKED
+	for(PxU32 i=0; i<nbRays; i++)
+	{
+		PX_CHECK_AND_RETURN_VAL(origins[i].isFinite(), "NpSceneQueries::raycastPacket pose is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(unitDirs[i].isFinite(), "NpSceneQueries::raycastPacket input check: unitDir is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(unitDirs[i].isNormalized(), "NpSceneQueries::raycastPacket input check: direction must be normalized", 0);
+		PX_CHECK_AND_RETURN_VAL(distances[i] > 0.0f, "NpSceneQueries::raycastPacket input check: distance cannot be negative or zero", 0);
+	}
+#endif
+
+	// PT: see multiQuery
+	const_cast<SceneQueries*>(this)->mSQManager.flushUpdates();
+
+	const bool anyHit = (filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+
+	const Pruner* staticPruner = mSQManager.getPruner(PruningIndex::eSTATIC);
+	const Pruner* dynamicPruner = mSQManager.getPruner(PruningIndex::eDYNAMIC);
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+
+	const PxU32 doStatics = staticPruner && (filterData.flags & PxQueryFlag::eSTATIC);
+	const PxU32 doDynamics = dynamicPruner && (filterData.flags & PxQueryFlag::eDYNAMIC);
+
+	const PxCompoundPrunerQueryFlags compoundPrunerQueryFlags = convertFlags(filterData.flags);
+
+	PxU32 nbHitRays = 0;
+	for(PxU32 base=0; base<nbRays; base+=RAYCAST_PACKET_MAX_SIZE)
+	{
+		const PxU32 nb = PxMin(nbRays - base, RAYCAST_PACKET_MAX_SIZE);
+		const PxVec3* packetOrigins = origins + base;
+		const PxVec3* packetDirs = unitDirs + base;
+
+		PX_ALIGN(16, PxU8 rayBuffer[RAYCAST_PACKET_MAX_SIZE*sizeof(RaycastPacketRay)]);
+		RaycastPacketRay* rays = reinterpret_cast<RaycastPacketRay*>(rayBuffer);
+		PrunerRaycastCallback* pcbs[RAYCAST_PACKET_MAX_SIZE];
+		PxReal shrunkDistances[RAYCAST_PACKET_MAX_SIZE];
+		for(PxU32 i=0; i<nb; i++)
+		{
+			PX_PLACEMENT_NEW(rays + i, RaycastPacketRay)(*this, packetOrigins[i], packetDirs[i], distances[base + i], anyHit, hitBuffers[base + i], hitFlags, filterData, filterCall);
+			pcbs[i] = &rays[i].mCallback;
+			shrunkDistances[i] = rays[i].mCallback.mShrunkDistance;
+		}
+
+		const PxU32 packetMask = (1u<<nb) - 1;
+		PxU32 activeMask = doStatics ? staticPruner->raycastPacket(nb, packetOrigins, packetDirs, shrunkDistances, pcbs, packetMask) : packetMask;
+
+		// PT: like in multiQuery, rays aborted by the static pruner keep their 'again' status
+		const PxU32 staticAbortedMask = packetMask & ~activeMask;
+
+		if(doDynamics && activeMask)
+			activeMask = dynamicPruner->raycastPacket(nb, packetOrigins, packetDirs, shrunkDistances, pcbs, activeMask);
+
+		if(compoundPruner && activeMask)
+		{
+			PxU32 mask = activeMask;
+			while(mask)
+			{
+				const PxU32 i = PxLowestSetBit(mask);
+				mask &= mask - 1;
+				if(!compoundPruner->raycast(packetOrigins[i], packetDirs[i], shrunkDistances[i], rays[i].mCallback, compoundPrunerQueryFlags))
+					activeMask &= ~(1u<<i);
+			}
+		}
+
+		for(PxU32 i=0; i<nb; i++)
+		{
+			rays[i].mCallbacksOnReturn.again = ((activeMask | staticAbortedMask)>>i) & 1;	// update the status to avoid duplicate processTouches()
+			rays[i].~RaycastPacketRay();
+
+			if(hitBuffers[base + i].hasAnyHits())
+				nbHitRays++;
+		}
+	}
+	return nbHitRays;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 bool SceneQueries::_overlap(
 	const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hits,
 	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -166,6 +166,10 @@ namespace Sc
 
 						PxIntBool			isFrozen()							const;
 
+						// PT: sleep and freeze filters of the low-level body. Used to save and restore the complete body state.
+						void				getSleepFilters(PxVec3& linVelAcc, PxVec3& angVelAcc, PxReal& freezeCount, PxReal& accelScale)	const;
+						void				setSleepFilters(const PxVec3& linVelAcc, const PxVec3& angVelAcc, PxReal freezeCount, PxReal accelScale);
+
 		static PX_FORCE_INLINE BodyCore&	getCore(PxsBodyCore& core)
 		{ 
 			return *reinterpret_cast<BodyCore*>(reinterpret_cast<PxU8*>(&core) - getCoreOffset());
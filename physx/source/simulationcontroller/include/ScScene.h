@@ -166,6 +166,7 @@ namespace Sc
 	class DeformableVolumeSim;
 	class ParticleSystemSim;
 	class SimStats;
+	class PipelineTimer;
 	struct SimStateData;
 
 	struct BatchInsertionState
@@ -451,6 +452,11 @@ namespace Sc
 	PX_FORCE_INLINE	SimStats&					getStatsInternal() { return *mStats; }
 // PX_ENABLE_SIM_STATS
 
+					// PxSceneFlag::eENABLE_PIPELINE_STATISTICS
+					void						beginPipelineStep();
+					void						endPipelineStep();
+					void						getPipelineStatistics(PxPipelineStatistics& stats) const;
+
 					void						buildActiveActors();
 					void						buildActiveAndFrozenActors();
 					PxActor**					getActiveActors(PxU32& nbActorsOut);
@@ -568,6 +574,7 @@ namespace Sc
 		PX_FORCE_INLINE	PxU32						getReportShapePairTimeStamp()			const	{ return mReportShapePairTimeStamp;		}
 
 		PX_FORCE_INLINE	NPhaseCore*					getNPhaseCore()							const	{ return mNPhaseCore;					}
+						void						setRemovalReportsEnabled(bool enabled);
 
 						void						checkConstraintBreakage();
 						void						collectSolverResidual();
@@ -805,6 +812,7 @@ namespace Sc
 						PxSimulationEventCallback*	mSimulationEventCallback;
 
 					SimStats*					mStats;
+					PipelineTimer*				mPipelineTimer;
 					PxU32						mInternalFlags;	// PT: combination of ::SceneInternalFlag, looks like only 2 bits are needed
 					PxSceneFlags				mPublicFlags;	// Copy of PxSceneDesc::flags, of type PxSceneFlag
 
@@ -908,6 +916,9 @@ namespace Sc
 					void						updateContactDistances(PxBaseTask* continuation);
 					void						updateDirtyShapes(PxBaseTask* continuation);
 
+					void						setPipelineTimer(PipelineTimer* timer);
+					void						setCCDPipelineTimer(PipelineTimer* timer);
+
 					Cm::DelegateTask<Scene, &Scene::secondPassNarrowPhase>		mSecondPassNarrowPhase;
 					Cm::DelegateTask<Scene, &Scene::postNarrowPhase>			mPostNarrowPhase;
 					Cm::DelegateTask<Scene, &Scene::finalizationPhase>			mFinalizationPhase;
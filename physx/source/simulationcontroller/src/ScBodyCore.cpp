@@ -553,6 +553,38 @@ PxIntBool Sc::BodyCore::isFrozen() const
 	return getSim()->isFrozen();
 }
 
+void Sc::BodyCore::getSleepFilters(PxVec3& linVelAcc, PxVec3& angVelAcc, PxReal& freezeCount, PxReal& accelScale) const
+{
+	const BodySim* sim = getSim();
+	if(sim)
+	{
+		const PxsRigidBody& llBody = sim->getLowLevelBody();
+		linVelAcc = llBody.mSleepLinVelAcc;
+		angVelAcc = llBody.mSleepAngVelAcc;
+		freezeCount = llBody.mFreezeCount;
+		accelScale = llBody.mAccelScale;
+	}
+	else
+	{
+		linVelAcc = angVelAcc = PxVec3(0.0f);
+		freezeCount = 0.0f;
+		accelScale = 1.0f;
+	}
+}
+
+void Sc::BodyCore::setSleepFilters(const PxVec3& linVelAcc, const PxVec3& angVelAcc, PxReal freezeCount, PxReal accelScale)
+{
+	BodySim* sim = getSim();
+	if(sim)
+	{
+		PxsRigidBody& llBody = sim->getLowLevelBody();
+		llBody.mSleepLinVelAcc = linVelAcc;
+		llBody.mSleepAngVelAcc = angVelAcc;
+		llBody.mFreezeCount = freezeCount;
+		llBody.mAccelScale = accelScale;
+	}
+}
+
 void Sc::BodyCore::setSolverIterationCounts(PxU16 c)	
 { 
 	mCore.solverIterationCounts = c;	
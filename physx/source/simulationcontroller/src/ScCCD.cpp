@@ -401,6 +401,9 @@ void Sc::Scene::updateCCDMultiPass(PxBaseTask* parentContinuation)
 				mCCDBroadPhase.pushBack(Cm::DelegateTask<Sc::Scene, &Sc::Scene::ccdBroadPhase>(mContextId, this, "ScScene.ccdBroadPhase"));
 				mCCDBroadPhaseAABB.pushBack(Cm::DelegateTask<Sc::Scene, &Sc::Scene::ccdBroadPhaseAABB>(mContextId, this, "ScScene.ccdBroadPhaseAABB"));
 			}
+
+			if(mPipelineTimer)
+				setCCDPipelineTimer(mPipelineTimer);
 		}
 
 		//reset thread context in a place we know all tasks possibly accessing it, are in sync with. (see US6664)
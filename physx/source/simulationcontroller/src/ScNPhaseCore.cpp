@@ -55,7 +55,8 @@ NPhaseCore::NPhaseCore(Scene& scene, const PxSceneDesc& sceneDesc) :
 	mTriggerInteractionPool						("triggerInteractionPool"),
 	mActorPairContactReportDataPool				("actorPairContactReportPool"),
 	mInteractionMarkerPool						("interactionMarkerPool"),
-	mConcludeTriggerInteractionProcessingTask	(scene.getContextId(), this, "ScNPhaseCore.concludeTriggerInteractionProcessing")
+	mConcludeTriggerInteractionProcessingTask	(scene.getContextId(), this, "ScNPhaseCore.concludeTriggerInteractionProcessing"),
+	mRemovalReportsEnabled						(true)
 {
 }
 
@@ -967,8 +968,9 @@ void NPhaseCore::releaseElementPair(ElementSimInteraction* pair, PxU32 flags, El
 				if (findTriggerContacts(tri, true, (removedElement != NULL),
 										triggerPair, triggerPairExtra, 
 										const_cast<SimStats::TriggerPairCountsNonVolatile&>(mOwnerScene.getStatsInternal().numTriggerPairs), 
-										transformCache))
+										transformCache)
 										// cast away volatile-ness (this is fine since the method does not run in parallel)
+					&& (mRemovalReportsEnabled || !removedElement))
 				{
 					mOwnerScene.getTriggerBufferAPI().pushBack(triggerPair);
 					mOwnerScene.getTriggerBufferExtraData().pushBack(triggerPairExtra);
@@ -1006,7 +1008,7 @@ void NPhaseCore::lostTouchReports(ShapeInteraction* si, PxU32 flags, ElementSim*
 
 	if(si->hasTouch())
 	{
-		if(si->isReportPair())
+		if(si->isReportPair() && (mRemovalReportsEnabled || !removedElement))
 			si->sendLostTouchReport((removedElement != NULL), ccdPass, outputs);
 
 		if(aPair)
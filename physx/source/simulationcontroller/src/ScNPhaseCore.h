@@ -311,6 +311,10 @@ namespace Sc
 		PX_FORCE_INLINE	void lockReports()		{ mReportAllocLock.lock();		}
 		PX_FORCE_INLINE	void unlockReports()	{ mReportAllocLock.unlock();	}
 
+		// PT: when disabled, pairs released because one of their objects is removed from the scene do not send lost touch reports
+		// (contacts or triggers). Used by scene snapshots, which take objects out of the scene and add them back immediately.
+		PX_FORCE_INLINE	void setRemovalReportsEnabled(bool enabled)	{ mRemovalReportsEnabled = enabled;	}
+
 	private:
 		void callPairLost(const ShapeSimBase& s0, const ShapeSimBase& s1, bool objVolumeRemoved);
 
@@ -374,6 +378,8 @@ namespace Sc
 		PxMutex										mBufferAllocLock;
 		PxMutex										mReportAllocLock;
 
+		bool										mRemovalReportsEnabled;
+
 		friend class Sc::Scene;
 		friend class Sc::ShapeInteraction;
 	};
@@ -1503,9 +1503,9 @@ void Sc::Scene::releaseConstraints(bool endOfScene)
 {
 	PX_ASSERT(mLLContext);
 
-	if(mEnableStabilization)
+	if(mEnableStabilization || mLLContext->getRestingContactCache())
 	{
-		//If stabilization is enabled, we're caching contacts for next frame
+		//If stabilization or the resting contact cache is enabled, we're caching contacts for next frame
 		if(!endOfScene)
 		{
 			//So we only clear memory (flip buffers) when not at the end-of-scene.
@@ -2377,7 +2377,7 @@ void Sc::Scene::destroyManagers(PxBaseTask*)
 
 	mPostThirdPassIslandGenTask.setContinuation(mProcessLostContactsTask3.getContinuation());
 
-	mSimpleIslandManager->thirdPassIslandGen(&mPostThirdPassIslandGenTask);
+	mSimpleIslandManager->thirdPassIslandGen(&mPostThirdPassIslandGenTask, *getFlushPool());
 
 	PxU32 destroyedOverlapCount;
 	const AABBOverlap* PX_RESTRICT p = mAABBManager->getDestroyedOverlaps(ElementType::eSHAPE, destroyedOverlapCount);
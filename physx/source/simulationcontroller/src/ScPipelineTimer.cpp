@@ -0,0 +1,252 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "ScPipelineTimer.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxString.h"
+
+using namespace physx;
+using namespace Sc;
+
+PX_COMPILE_TIME_ASSERT(SC_PIPELINE_TIMER_MAX_NB_STAGES < (1<<SC_PIPELINE_TIMER_SOURCE_BITS));
+
+static PX_FORCE_INLINE PxI64 packPath(PxI64 path, PxU32 source)
+{
+	return (path << SC_PIPELINE_TIMER_SOURCE_BITS) | PxI64(source);
+}
+
+static PX_FORCE_INLINE PxI64 getPath(PxI64 packed)
+{
+	return packed >> SC_PIPELINE_TIMER_SOURCE_BITS;
+}
+
+static PX_FORCE_INLINE PxU32 getSource(PxI64 packed)
+{
+	return PxU32(packed & ((1<<SC_PIPELINE_TIMER_SOURCE_BITS) - 1));
+}
+
+PipelineTimer::PipelineTimer() :
+	mNbStages		(0),
+	mCurrentStageTls(PxTlsAlloc()),
+	mLastStageTls	(PxTlsAlloc()),
+	mStep			(0),
+	mStepStart		(0),
+	mCriticalPath	(0),
+	mSimulationEnd	(0),
+	mPrioritize		(false)
+{
+	PxMemZero(mStages, sizeof(mStages));
+}
+
+PipelineTimer::~PipelineTimer()
+{
+	PxTlsFree(mLastStageTls);
+	PxTlsFree(mCurrentStageTls);
+}
+
+PxU32 PipelineTimer::registerStage(const char* name)
+{
+	PxMutex::ScopedLock lock(mRegisterLock);
+
+	const PxU32 nbStages = PxU32(mNbStages);
+	for(PxU32 i=0; i<nbStages; i++)
+	{
+		if(mStages[i].mName == name || !Pxstrcmp(mStages[i].mName, name))
+			return i;
+	}
+
+	// PT: the stages are a fixed set of scene tasks, running out of slots means the limit needs bumping. Merge the
+	// extra tasks into the last stage rather than failing.
+	PX_ASSERT(nbStages < SC_PIPELINE_TIMER_MAX_NB_STAGES);
+	if(nbStages == SC_PIPELINE_TIMER_MAX_NB_STAGES)
+		return nbStages - 1;
+
+	Stage& stage = mStages[nbStages];
+	PxMemZero(&stage, sizeof(Stage));
+	stage.mName = name;
+	stage.mStep = mStep - 1;	// PT: nothing written for the current step yet
+
+	// PT: make sure the stage is fully written before other threads can see it
+	PxMemoryBarrier();
+	mNbStages = PxI32(nbStages + 1);
+	return nbStages;
+}
+
+PX_FORCE_INLINE PxI64 PipelineTimer::getTime() const
+{
+	return PxI64(PxTime::getCurrentCounterValue() - mStepStart);
+}
+
+PxI64 PipelineTimer::getPackedPathTime(PxI64 now) const
+{
+	const Stage* current = static_cast<const Stage*>(PxTlsGet(mCurrentStageTls));
+	if(current)
+		return packPath(current->mStartPath + now - current->mStartTime, PxU32(current - mStages) + 1);
+
+	const Stage* last = static_cast<const Stage*>(PxTlsGet(mLastStageTls));
+	if(last && last->mStep == mStep)
+		return packPath(last->mEndPath + now - last->mEndTime, PxU32(last - mStages) + 1);
+
+	return packPath(now, 0);
+}
+
+void PipelineTimer::beginStep()
+{
+	mStep++;
+	mStepStart = PxTime::getCurrentCounterValue();
+	mCriticalPath = 0;
+	mSimulationEnd = 0;
+
+	const PxU32 nbStages = PxU32(mNbStages);
+	for(PxU32 i=0; i<nbStages; i++)
+	{
+		Stage& stage = mStages[i];
+		stage.mReadyTime = 0;
+		stage.mReadyPath = 0;
+		stage.mWallTime = 0;
+		stage.mCpuTime = 0;
+		stage.mQueueTime = 0;
+		stage.mNbExecutions = 0;
+		stage.mNbDependencies = 0;
+	}
+
+	// PT: the user thread itself can run stages (e.g. with a dispatcher that has no worker threads)
+	PxTlsSet(mCurrentStageTls, NULL);
+	PxTlsSet(mLastStageTls, NULL);
+}
+
+void PipelineTimer::taskReady(PxU32 index)
+{
+	Stage& stage = mStages[index];
+	const PxI64 now = getTime();
+	PxAtomicMax(&stage.mReadyTime, now);
+	PxAtomicMax(&stage.mReadyPath, getPackedPathTime(now));
+	PxAtomicIncrement(&stage.mNbDependencies);
+}
+
+void PipelineTimer::taskStart(PxU32 index)
+{
+	Stage& stage = mStages[index];
+	const PxI64 now = getTime();
+
+	// PT: ready time/path are complete here, all references have been removed
+	const PxI64 readyTime = stage.mReadyTime;
+	const PxI64 readyPath = stage.mReadyPath;
+	stage.mReadyTime = 0;
+	stage.mReadyPath = 0;
+
+	stage.mStartTime = now;
+	stage.mStartPath = getPath(readyPath);
+	stage.mStartSource = getSource(readyPath);
+	stage.mStartCpuTime = PxI64(PxTime::getCurrentThreadCpuTimeInTensOfNanoSeconds());
+	if(now > readyTime)
+		PxAtomicAdd(&stage.mQueueTime, now - readyTime);
+
+	stage.mCaller = static_cast<Stage*>(PxTlsGet(mCurrentStageTls));
+	PxTlsSet(mCurrentStageTls, &stage);
+}
+
+void PipelineTimer::taskEnd(PxU32 index)
+{
+	Stage& stage = mStages[index];
+	const PxI64 now = getTime();
+	const PxI64 cpuTime = PxI64(PxTime::getCurrentThreadCpuTimeInTensOfNanoSeconds()) - stage.mStartCpuTime;
+
+	stage.mEndTime = now;
+	stage.mEndPath = stage.mStartPath + now - stage.mStartTime;
+	stage.mStep = mStep;
+
+	PxAtomicAdd(&stage.mWallTime, now - stage.mStartTime);
+	PxAtomicAdd(&stage.mCpuTime, cpuTime);
+	PxAtomicIncrement(&stage.mNbExecutions);
+	PxAtomicMax(&mCriticalPath, packPath(stage.mEndPath, index + 1));
+	PxAtomicMax(&mSimulationEnd, now);
+
+	PxTlsSet(mCurrentStageTls, stage.mCaller);
+	PxTlsSet(mLastStageTls, &stage);
+}
+
+void PipelineTimer::endStep()
+{
+	const PxI64 totalTime = getTime();
+	const PxCounterFrequencyToTensOfNanos& freq = PxTime::getBootCounterFrequency();
+	const PxReal toSeconds = 1.0f / PxReal(PxTime::sNumTensOfNanoSecondsInASecond);
+
+	const PxU32 nbStages = PxU32(mNbStages);
+	for(PxU32 i=0; i<nbStages; i++)
+		mStages[i].mCritical = false;
+
+	// PT: walk the critical path back from the stage that ends it. The CCD passes reuse the same stages so the
+	// sources can loop, stop at the first stage already visited.
+	PxU32 source = getSource(mCriticalPath);
+	while(source)
+	{
+		Stage& stage = mStages[source - 1];
+		if(stage.mCritical || stage.mStep != mStep)
+			break;
+		stage.mCritical = true;
+		source = stage.mStartSource;
+	}
+
+	PxU32 nbOutput = 0;
+	for(PxU32 i=0; i<nbStages; i++)
+	{
+		Stage& stage = mStages[i];
+		stage.mCriticalHistory = ((stage.mCriticalHistory << 1) | PxU32(stage.mCritical)) & SC_PIPELINE_TIMER_HISTORY_MASK;
+
+		if(!stage.mNbExecutions && !stage.mNbDependencies)
+			continue;
+
+		PxPipelineStageStatistics& out = mOutput[nbOutput++];
+		out.name			= stage.mName;
+		out.wallTime		= PxReal(freq.toTensOfNanos(PxU64(stage.mWallTime))) * toSeconds;
+		out.cpuTime			= PxReal(stage.mCpuTime) * toSeconds;
+		out.queueTime		= PxReal(freq.toTensOfNanos(PxU64(stage.mQueueTime))) * toSeconds;
+		out.nbExecutions	= PxU32(stage.mNbExecutions);
+		out.nbDependencies	= PxU32(stage.mNbDependencies);
+		out.critical		= stage.mCritical;
+	}
+
+	mOutputStats.stages				= mOutput;
+	mOutputStats.nbStages			= nbOutput;
+	mOutputStats.simulationTime		= PxReal(freq.toTensOfNanos(PxU64(mSimulationEnd))) * toSeconds;
+	mOutputStats.totalTime			= PxReal(freq.toTensOfNanos(PxU64(totalTime))) * toSeconds;
+	mOutputStats.criticalPathTime	= PxReal(freq.toTensOfNanos(PxU64(getPath(mCriticalPath)))) * toSeconds;
+}
+
+bool PipelineTimer::isHighPriority(PxU32 index) const
+{
+	return mPrioritize && mStages[index].mCriticalHistory;
+}
+
+void PipelineTimer::getStatistics(PxPipelineStatistics& stats) const
+{
+	stats = mOutputStats;
+}
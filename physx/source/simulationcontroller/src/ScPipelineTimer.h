@@ -0,0 +1,133 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef SC_PIPELINE_TIMER_H
+#define SC_PIPELINE_TIMER_H
+
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxMutex.h"
+#include "PxPipelineStatistics.h"
+#include "CmTask.h"
+
+#define SC_PIPELINE_TIMER_MAX_NB_STAGES	128
+#define SC_PIPELINE_TIMER_SOURCE_BITS	8		// bits used to pack a stage index (+1) with a path time
+#define SC_PIPELINE_TIMER_HISTORY_MASK	0xf		// a stage is prioritized if it was on the critical path in one of the last 4 steps
+
+namespace physx
+{
+namespace Sc
+{
+	/*
+	Description: gathers the per-stage timings reported by PxScene::getPipelineStatistics().
+
+	The scene's pipeline stages are the Cm::DelegateTask members of Sc::Scene. When PxSceneFlag::eENABLE_PIPELINE_STATISTICS
+	is raised each of them gets a pointer to this timer and calls taskReady() each time one of its references is removed, and
+	taskStart()/taskEnd() around its run() function.
+
+	The critical path is tracked as a "path time" per stage, i.e. the time at which the stage would have been ready/done
+	if queued tasks had always found an idle worker. A stage inherits the path time of the work that made it ready:
+	- the stage currently running on the calling thread if any (the stage spawned it),
+	- otherwise the last stage that ended on the calling thread (it is the stage's continuation, or the calling thread is
+	running work that was spawned by that stage),
+	- otherwise the elapsed time since the start of the step, i.e. everything so far is assumed to be on the path.
+	The path time is then advanced by the time spent running the stage, but not by the time it spent queued.
+
+	Each path time is stored along with the stage it comes from, so the critical path can be walked back when the step
+	ends. With PxSceneFlag::eENABLE_CRITICAL_PATH_SCHEDULING the stages found on it in recent steps report themselves as
+	high priority tasks, which the CPU dispatcher runs ahead of the other queued work.
+
+	Stage times are accumulated in counter ticks and converted when the step ends.
+	*/
+	class PipelineTimer : public Cm::TaskTimer, public PxUserAllocated
+	{
+		PX_NOCOPY(PipelineTimer)
+	public:
+										PipelineTimer();
+										~PipelineTimer();
+
+		// Returns the stage index to pass to Cm::DelegateTask::setTimer(). Tasks with the same name share a stage.
+		// Thread-safe, can be called while the simulation is running.
+						PxU32			registerStage(const char* name);
+
+						void			beginStep();		// called on the user thread by simulate() or collide()
+						void			endStep();			// called on the user thread at the end of fetchResults()
+						void			getStatistics(PxPipelineStatistics& stats)	const;
+
+		PX_FORCE_INLINE	void			setPrioritization(bool prioritize)	{ mPrioritize = prioritize;	}
+
+		// Cm::TaskTimer
+		virtual			void			taskReady(PxU32 stage)	PX_OVERRIDE;
+		virtual			void			taskStart(PxU32 stage)	PX_OVERRIDE;
+		virtual			void			taskEnd(PxU32 stage)	PX_OVERRIDE;
+		virtual			bool			isHighPriority(PxU32 stage)	const	PX_OVERRIDE;
+		//~Cm::TaskTimer
+	private:
+		struct Stage
+		{
+			const char*		mName;
+			Stage*			mCaller;			// stage running on the thread when this one started, for tasks executed inline by the dispatcher
+			volatile PxI64	mReadyTime;			// time of the last reference removal
+			volatile PxI64	mReadyPath;			// packed path time and source of the work that made the stage ready (max over all references)
+			PxI64			mStartTime;
+			PxI64			mStartPath;
+			PxU32			mStartSource;		// index+1 of the stage the path comes from, 0 if none
+			PxI64			mStartCpuTime;
+			PxI64			mEndTime;
+			PxI64			mEndPath;
+			PxU32			mStep;				// step in which mEndTime/mEndPath have been written
+			PxU32			mCriticalHistory;	// one bit per recent step, set if the stage was on its critical path
+			bool			mCritical;			// on the critical path of the last step
+
+			// accumulated over the step
+			volatile PxI64	mWallTime;
+			volatile PxI64	mCpuTime;
+			volatile PxI64	mQueueTime;
+			volatile PxI32	mNbExecutions;
+			volatile PxI32	mNbDependencies;
+		};
+
+		PX_FORCE_INLINE	PxI64			getTime()	const;
+						PxI64			getPackedPathTime(PxI64 now)	const;
+
+						Stage			mStages[SC_PIPELINE_TIMER_MAX_NB_STAGES];
+						PxPipelineStageStatistics	mOutput[SC_PIPELINE_TIMER_MAX_NB_STAGES];
+						PxPipelineStatistics		mOutputStats;
+		volatile		PxI32			mNbStages;
+						PxMutex			mRegisterLock;
+						PxU32			mCurrentStageTls;	// stage running on the calling thread
+						PxU32			mLastStageTls;		// last stage that ended on the calling thread
+						PxU32			mStep;
+						PxU64			mStepStart;
+		volatile		PxI64			mCriticalPath;		// packed path time and index+1 of the stage ending the critical path
+		volatile		PxI64			mSimulationEnd;
+						bool			mPrioritize;
+	};
+}
+}
+
+#endif
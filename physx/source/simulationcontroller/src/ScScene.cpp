@@ -41,6 +41,7 @@
 #include "ScConstraintInteraction.h"
 #include "ScTriggerInteraction.h"
 #include "ScSimStats.h"
+#include "ScPipelineTimer.h"
 #include "PxvGlobals.h"
 #include "PxsCCD.h"
 #include "ScSimulationController.h"
@@ -751,6 +752,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 		mActiveInteractionCount[i] = 0;
 
 	mStats						= PX_NEW(SimStats);
+	mPipelineTimer				= NULL;
 	mConstraintIDTracker		= PX_NEW(ObjectIDTracker);
 	mActorIDTracker				= PX_NEW(ObjectIDTracker);
 	mElementIDPool				= PX_NEW(ObjectIDTracker);
@@ -889,7 +891,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 				mLLContext->getTaskPool(), mLLContext->getSimStats(), &mLLContext->getTaskManager(), allocatorCallback, &getMaterialManager(),
 				*mSimpleIslandManager, contextID, mEnableStabilization, useEnhancedDeterminism, desc.flags & PxSceneFlag::eSOLVE_ARTICULATION_CONTACT_LAST, desc.maxBiasCoefficient,
 				desc.flags & PxSceneFlag::eENABLE_FRICTION_EVERY_ITERATION, desc.getTolerancesScale().length,
-				desc.flags & PxSceneFlag::eENABLE_SOLVER_RESIDUAL_REPORTING);
+				desc.flags & PxSceneFlag::eENABLE_SOLVER_RESIDUAL_REPORTING, desc.flags & PxSceneFlag::eDISABLE_WIDE_SOLVER_BATCHES);
 		}
 		else
 		{
@@ -1126,6 +1128,7 @@ void Sc::Scene::release()
 	PX_DELETE(mActorIDTracker);
 	PX_DELETE(mConstraintIDTracker);
 	PX_DELETE(mStats);
+	PX_DELETE(mPipelineTimer);
 
 	Bp::BroadPhase* broadPhase = mAABBManager->getBroadPhase();
 	mAABBManager->destroy();
@@ -1163,6 +1166,11 @@ PxSceneResidual Sc::Scene::getSolverResidual()	const
 	return mResidual;
 }
 
+void Sc::Scene::setRemovalReportsEnabled(bool enabled)
+{
+	mNPhaseCore->setRemovalReportsEnabled(enabled);
+}
+
 void Sc::Scene::preAllocate(PxU32 nbStatics, PxU32 nbBodies, PxU32 nbStaticShapes, PxU32 nbDynamicShapes)
 {
 	// PT: TODO: this is only used for my addActors benchmark for now. Pre-allocate more arrays here.
@@ -2194,6 +2202,116 @@ void Sc::Scene::postCallbacksPreSync()
 	releaseConstraints(true); //release constraint blocks at the end of the frame, so user can retrieve the blocks
 }
 
+template<class TaskT>
+static PX_FORCE_INLINE void setTaskTimer(TaskT& task, Sc::PipelineTimer* timer)
+{
+	task.setTimer(timer, timer ? timer->registerStage(task.getName()) : 0);
+}
+
+template<class TaskT>
+static PX_FORCE_INLINE void setTaskTimers(PxArray<TaskT>& tasks, Sc::PipelineTimer* timer)
+{
+	const PxU32 nbTasks = tasks.size();
+	for(PxU32 i=0; i<nbTasks; i++)
+		setTaskTimer(tasks[i], timer);
+}
+
+void Sc::Scene::setCCDPipelineTimer(PipelineTimer* timer)
+{
+	setTaskTimers(mUpdateCCDSinglePass, timer);
+	setTaskTimers(mUpdateCCDSinglePass2, timer);
+	setTaskTimers(mUpdateCCDSinglePass3, timer);
+	setTaskTimers(mCCDBroadPhaseAABB, timer);
+	setTaskTimers(mCCDBroadPhase, timer);
+	setTaskTimers(mPostCCDPass, timer);
+}
+
+void Sc::Scene::setPipelineTimer(PipelineTimer* timer)
+{
+	// PT: the DelegateFanoutTask stages (updateBoundsAndShapes, postBroadPhase3) are not timed
+	setTaskTimer(mCollideStep, timer);
+	setTaskTimer(mAdvanceStep, timer);
+	setTaskTimer(mBpFirstPass, timer);
+	setTaskTimer(mBpSecondPass, timer);
+	setTaskTimer(mBpUpdate, timer);
+	setTaskTimer(mPreIntegrate, timer);
+	setTaskTimer(mBroadPhase, timer);
+	setTaskTimer(mPostBroadPhase, timer);
+	setTaskTimer(mPostBroadPhaseCont, timer);
+	setTaskTimer(mPostBroadPhase2, timer);
+	setTaskTimer(mPreallocateContactManagers, timer);
+	setTaskTimer(mIslandInsertion, timer);
+	setTaskTimer(mRegisterContactManagers, timer);
+	setTaskTimer(mRegisterInteractions, timer);
+	setTaskTimer(mRegisterSceneInteractions, timer);
+	setTaskTimer(mRigidBodyNarrowPhase, timer);
+	setTaskTimer(mRigidBodyNPhaseUnlock, timer);
+	setTaskTimer(mPreRigidBodyNarrowPhase, timer);
+	setTaskTimer(mSetEdgesConnectedTask, timer);
+	setTaskTimer(mIslandGen, timer);
+#if !USE_SPLIT_SECOND_PASS_ISLAND_GEN
+	setTaskTimer(mPostIslandGen, timer);
+#endif
+	setTaskTimer(mPostThirdPassIslandGenTask, timer);
+	setTaskTimer(mProcessNPLostTouchEvents, timer);
+	setTaskTimer(mProcessNarrowPhaseLostTouchTasks, timer);
+	setTaskTimer(mUnregisterInteractionsTask, timer);
+	setTaskTimer(mLostTouchReportsTask, timer);
+	setTaskTimer(mDestroyManagersTask, timer);
+	setTaskTimer(mProcessLostContactsTask, timer);
+	setTaskTimer(mProcessLostContactsTask2, timer);
+	setTaskTimer(mProcessLostContactsTask3, timer);
+	setTaskTimer(mSecondPassNarrowPhase, timer);
+	setTaskTimer(mPostNarrowPhase, timer);
+	setTaskTimer(mUpdateDynamics, timer);
+	setTaskTimer(mUpdateDynamicsPostPartitioning, timer);
+	setTaskTimer(mSolver, timer);
+	setTaskTimer(mPostSolver, timer);
+	setTaskTimer(mAfterIntegration, timer);
+	setTaskTimer(mUpdateBodies, timer);
+	setTaskTimer(mUpdateShapes, timer);
+	setTaskTimer(mUpdateSimulationController, timer);
+	setTaskTimer(mUpdateCCDMultiPass, timer);
+	setTaskTimer(mFinalizationPhase, timer);
+	setCCDPipelineTimer(timer);
+}
+
+void Sc::Scene::beginPipelineStep()
+{
+	const bool prioritize = mPublicFlags & PxSceneFlag::eENABLE_CRITICAL_PATH_SCHEDULING;
+	const bool enabled = prioritize || (mPublicFlags & PxSceneFlag::eENABLE_PIPELINE_STATISTICS);
+	if(enabled && !mPipelineTimer)
+	{
+		mPipelineTimer = PX_NEW(PipelineTimer);
+		setPipelineTimer(mPipelineTimer);
+	}
+	else if(!enabled && mPipelineTimer)
+	{
+		setPipelineTimer(NULL);
+		PX_DELETE(mPipelineTimer);
+	}
+
+	if(mPipelineTimer)
+	{
+		mPipelineTimer->setPrioritization(prioritize);
+		mPipelineTimer->beginStep();
+	}
+}
+
+void Sc::Scene::endPipelineStep()
+{
+	if(mPipelineTimer)
+		mPipelineTimer->endStep();
+}
+
+void Sc::Scene::getPipelineStatistics(PxPipelineStatistics& stats) const
+{
+	if(mPipelineTimer)
+		mPipelineTimer->getStatistics(stats);
+	else
+		stats = PxPipelineStatistics();
+}
+
 void Sc::Scene::getStats(PxSimulationStatistics& s) const
 {
 	mStats->readOut(s, mLLContext->getSimStats());
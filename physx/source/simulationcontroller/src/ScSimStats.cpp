@@ -132,6 +132,9 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.nbNewTouches = simStats.mNbNewTouches;
 	s.nbLostTouches = simStats.mNbLostTouches;
 	s.nbPartitions = simStats.mNbPartitions;
+	s.nbCCDSweeps = simStats.mNbCCDSweeps;
+	s.nbCCDToiHits = simStats.mNbCCDToiHits;
+	s.nbCCDPasses = simStats.mNbCCDPasses;
 
 	s.gpuDynamicsMemoryConfigStatistics.tempBufferCapacity = simStats.mGpuDynamicsTempBufferCapacity;
 	s.gpuDynamicsMemoryConfigStatistics.rigidContactCount = simStats.mGpuDynamicsRigidContactCount;